@@ -12,14 +12,84 @@
 
 #include <string.h>
 
+#include <vector>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
 
-AudioFrame::AudioFrame() {
-  // Visual Studio doesn't like this in the class definition.
-  static_assert(sizeof(data_) == kMaxDataSizeBytes, "kMaxDataSizeBytes");
+namespace {
+
+// The buffer sizes, in samples, that frames are given. 10 ms of 48 kHz stereo
+// fits in 1024 samples, so the largest size is rarely needed but for frames
+// written through mutable_data().
+constexpr size_t kBufferSizes[] = {256, 512, 1024, 2048,
+                                   AudioFrame::kMaxDataSizeSamples};
+constexpr size_t kNumBufferSizes = sizeof(kBufferSizes) / sizeof(size_t);
+// Bounds the memory kept by the pool after a burst of frames.
+constexpr size_t kMaxPooledBuffersPerSize = 64;
+
+// Keeps the buffers of deleted frames for new ones, per size.
+class BufferPool {
+ public:
+  static BufferPool* Get() {
+    static BufferPool* const pool = new BufferPool();
+    return pool;
+  }
+
+  // Returns a buffer of the smallest size that holds |num_samples|, and
+  // writes that size to |capacity|.
+  int16_t* Allocate(size_t num_samples, size_t* capacity) {
+    const size_t index = SizeIndex(num_samples);
+    *capacity = kBufferSizes[index];
+    {
+      rtc::CritScope lock(&crit_);
+      std::vector<int16_t*>& free_buffers = free_buffers_[index];
+      if (!free_buffers.empty()) {
+        int16_t* buffer = free_buffers.back();
+        free_buffers.pop_back();
+        return buffer;
+      }
+    }
+    return new int16_t[*capacity];
+  }
+
+  void Free(int16_t* buffer, size_t capacity) {
+    const size_t index = SizeIndex(capacity);
+    RTC_DCHECK_EQ(kBufferSizes[index], capacity);
+    {
+      rtc::CritScope lock(&crit_);
+      std::vector<int16_t*>& free_buffers = free_buffers_[index];
+      if (free_buffers.size() < kMaxPooledBuffersPerSize) {
+        free_buffers.push_back(buffer);
+        return;
+      }
+    }
+    delete[] buffer;
+  }
+
+ private:
+  static size_t SizeIndex(size_t num_samples) {
+    RTC_CHECK_LE(num_samples, AudioFrame::kMaxDataSizeSamples);
+    size_t index = 0;
+    while (kBufferSizes[index] < num_samples)
+      ++index;
+    return index;
+  }
+
+  rtc::CriticalSection crit_;
+  std::vector<int16_t*> free_buffers_[kNumBufferSizes] RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace
+
+AudioFrame::AudioFrame() = default;
+
+AudioFrame::~AudioFrame() {
+  if (data_)
+    BufferPool::Get()->Free(data_, data_capacity_);
 }
 
 void AudioFrame::Reset() {
@@ -41,6 +111,7 @@ void AudioFrame::ResetWithoutMuting() {
   vad_activity_ = kVadUnknown;
   profile_timestamp_ms_ = 0;
   packet_infos_ = RtpPacketInfos();
+  has_sample_levels_ = false;
 }
 
 void AudioFrame::UpdateFrame(uint32_t timestamp,
@@ -61,9 +132,12 @@ void AudioFrame::UpdateFrame(uint32_t timestamp,
     RTC_DCHECK_EQ(num_channels, ChannelLayoutToChannelCount(channel_layout_));
   }
 
+  has_sample_levels_ = false;
+
   const size_t length = samples_per_channel * num_channels;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (data != nullptr) {
+    EnsureCapacity(length);
     memcpy(data_, data, sizeof(int16_t) * length);
     muted_ = false;
   } else {
@@ -86,10 +160,13 @@ void AudioFrame::CopyFrom(const AudioFrame& src) {
   vad_activity_ = src.vad_activity_;
   num_channels_ = src.num_channels_;
   channel_layout_ = src.channel_layout_;
+  sample_levels_ = src.sample_levels_;
+  has_sample_levels_ = src.has_sample_levels_;
 
   const size_t length = samples_per_channel_ * num_channels_;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (!src.muted()) {
+    EnsureCapacity(length);
     memcpy(data_, src.data(), sizeof(int16_t) * length);
     muted_ = false;
   }
@@ -114,6 +191,8 @@ const int16_t* AudioFrame::data() const {
 // TODO(henrik.lundin) Can we skip zeroing the buffer?
 // See https://bugs.chromium.org/p/webrtc/issues/detail?id=5647.
 int16_t* AudioFrame::mutable_data() {
+  has_sample_levels_ = false;
+  EnsureCapacity(kMaxDataSizeSamples);
   if (muted_) {
     memset(data_, 0, kMaxDataSizeBytes);
     muted_ = false;
@@ -123,12 +202,28 @@ int16_t* AudioFrame::mutable_data() {
 
 void AudioFrame::Mute() {
   muted_ = true;
+  has_sample_levels_ = false;
 }
 
 bool AudioFrame::muted() const {
   return muted_;
 }
 
+void AudioFrame::EnsureCapacity(size_t num_samples) {
+  // Empty frames get a buffer too, so that data() of an unmuted frame is never
+  // null.
+  if (data_ && num_samples <= data_capacity_)
+    return;
+  size_t capacity = 0;
+  int16_t* data = BufferPool::Get()->Allocate(num_samples, &capacity);
+  if (data_) {
+    memcpy(data, data_, sizeof(int16_t) * data_capacity_);
+    BufferPool::Get()->Free(data_, data_capacity_);
+  }
+  data_ = data;
+  data_capacity_ = capacity;
+}
+
 // static
 const int16_t* AudioFrame::empty_data() {
   static int16_t* null_data = new int16_t[kMaxDataSizeSamples]();
@@ -24,6 +24,13 @@ namespace webrtc {
  * allows for adding and subtracting frames while keeping track of the resulting
  * states.
  *
+ * The samples are stored in a buffer taken from a process-wide pool when the
+ * frame is first unmuted, instead of inline, so that muted frames are small
+ * and frames created per packet or per stream reuse their storage. Frames
+ * filled by UpdateFrame() or CopyFrom() get a buffer sized to the samples, and
+ * mutable_data() grows it to max_16bit_samples(), since callers may write the
+ * samples before setting their number.
+ *
  * Notes
  * - This is a de-facto api, not designed for external use. The AudioFrame class
  *   is in need of overhaul or even replacement, and anyone depending on it
@@ -56,7 +63,16 @@ class AudioFrame {
     kUndefined = 4
   };
 
+  // Statistics of the samples of all channels.
+  struct SampleLevels {
+    // Largest absolute sample value, limited to 32767.
+    int16_t abs_max = 0;
+    // Sum of the squared sample values.
+    float sum_square = 0.f;
+  };
+
   AudioFrame();
+  ~AudioFrame();
 
   // Resets all members to their default state.
   void Reset();
@@ -98,6 +114,19 @@ class AudioFrame {
   // Frame is muted by default.
   bool muted() const;
 
+  // Levels of the samples, as set by the producer of the frame, so that
+  // several consumers can share one pass over the samples. Returns null if no
+  // levels have been set, or if the samples may have been modified since, i.e.
+  // after a call to mutable_data(), Mute() or any of the update methods.
+  // CopyFrom() copies the levels.
+  const SampleLevels* sample_levels() const {
+    return has_sample_levels_ ? &sample_levels_ : nullptr;
+  }
+  void set_sample_levels(const SampleLevels& sample_levels) {
+    sample_levels_ = sample_levels;
+    has_sample_levels_ = true;
+  }
+
   size_t max_16bit_samples() const { return kMaxDataSizeSamples; }
   size_t samples_per_channel() const { return samples_per_channel_; }
   size_t num_channels() const { return num_channels_; }
@@ -147,8 +176,16 @@ class AudioFrame {
   // buffer per translation unit is to wrap a static in an inline function.
   static const int16_t* empty_data();
 
-  int16_t data_[kMaxDataSizeSamples];
+  // Makes |data_| hold at least |num_samples|, keeping its samples if it has
+  // to be replaced.
+  void EnsureCapacity(size_t num_samples);
+
+  // Null until the frame is first unmuted.
+  int16_t* data_ = nullptr;
+  size_t data_capacity_ = 0;
   bool muted_ = true;
+  SampleLevels sample_levels_;
+  bool has_sample_levels_ = false;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioFrame);
 };
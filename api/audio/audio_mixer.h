@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -41,6 +42,11 @@ class AudioMixer : public rtc::RefCountInterface {
     virtual AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
                                                  AudioFrame* audio_frame) = 0;
 
+    // Called instead of GetAudioFrameWithInfo() when the mixer doesn't need
+    // the next 10 ms of audio from this source. Lets the source advance
+    // without producing audio, e.g. without decoding.
+    virtual void SkipAudioFrame() {}
+
     // A way for a mixer implementation to distinguish participants.
     virtual int Ssrc() const = 0;
 
@@ -48,6 +54,14 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // Returns the audio level of the latest received audio in -dBov, as
+    // signaled in the RTP audio level header extension (RFC 6464), i.e. 0 is
+    // the loudest and 127 is silence. Lets a mixer select sources without
+    // asking them for audio. Returns absl::nullopt if the level is unknown.
+    virtual absl::optional<int> GetLatestReceivedAudioLevel() const {
+      return absl::nullopt;
+    }
+
     virtual ~Source() {}
   };
 
@@ -79,6 +79,11 @@ struct RTC_EXPORT EchoCanceller3Config {
     bool conservative_initial_phase = false;
     bool enable_shadow_filter_output_usage = true;
     bool use_linear_filter = true;
+    // Adapts a single pair of linear filters, on the first capture channel,
+    // and uses it for all capture channels. Saves the memory and most of the
+    // CPU of the per-channel filters when the capture channels are strongly
+    // correlated, e.g. closely spaced microphones.
+    bool share_filters_across_capture_channels = false;
   } filter;
 
   struct Erle {
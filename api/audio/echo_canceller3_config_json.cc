@@ -191,6 +191,8 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
     ReadParam(section, "enable_shadow_filter_output_usage",
               &cfg.filter.enable_shadow_filter_output_usage);
     ReadParam(section, "use_linear_filter", &cfg.filter.use_linear_filter);
+    ReadParam(section, "share_filters_across_capture_channels",
+              &cfg.filter.share_filters_across_capture_channels);
   }
 
   if (rtc::GetValueFromJsonObject(aec3_root, "erle", &section)) {
@@ -407,7 +409,11 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
   ost << "\"conservative_initial_phase\": "
       << (config.filter.conservative_initial_phase ? "true" : "false") << ",";
   ost << "\"enable_shadow_filter_output_usage\": "
-      << (config.filter.enable_shadow_filter_output_usage ? "true" : "false");
+      << (config.filter.enable_shadow_filter_output_usage ? "true" : "false")
+      << ",";
+  ost << "\"share_filters_across_capture_channels\": "
+      << (config.filter.share_filters_across_capture_channels ? "true"
+                                                               : "false");
 
   ost << "},";
 
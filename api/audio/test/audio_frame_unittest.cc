@@ -133,4 +133,85 @@ TEST(AudioFrameTest, CopyFrom) {
   EXPECT_EQ(0, memcmp(frame2.data(), frame1.data(), sizeof(samples)));
 }
 
+TEST(AudioFrameTest, CopyFromLargerFrame) {
+  AudioFrame frame1;
+  AudioFrame frame2;
+
+  int16_t samples[kNumChannels5_1 * kSamplesPerChannel];
+  for (size_t i = 0; i < kNumChannels5_1 * kSamplesPerChannel; ++i) {
+    samples[i] = static_cast<int16_t>(i);
+  }
+  frame1.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                     AudioFrame::kPLC, AudioFrame::kVadActive,
+                     kNumChannelsMono);
+  frame2.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                     AudioFrame::kPLC, AudioFrame::kVadActive,
+                     kNumChannels5_1);
+  frame1.CopyFrom(frame2);
+  EXPECT_EQ(0, memcmp(samples, frame1.data(), sizeof(samples)));
+}
+
+TEST(AudioFrameTest, MutableDataKeepsSamplesAndHoldsMaxSamples) {
+  AudioFrame frame;
+  int16_t samples[kNumChannelsMono * kSamplesPerChannel];
+  for (size_t i = 0; i < kSamplesPerChannel; ++i) {
+    samples[i] = static_cast<int16_t>(i);
+  }
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kPLC, AudioFrame::kVadActive,
+                    kNumChannelsMono);
+  int16_t* frame_data = frame.mutable_data();
+  EXPECT_EQ(0, memcmp(samples, frame_data, sizeof(samples)));
+  for (size_t i = 0; i < frame.max_16bit_samples(); i++) {
+    frame_data[i] = 17;
+  }
+  EXPECT_TRUE(AllSamplesAre(17, frame));
+}
+
+TEST(AudioFrameTest, SampleLevelsAreInvalidatedByModifications) {
+  AudioFrame frame;
+  EXPECT_EQ(nullptr, frame.sample_levels());
+
+  AudioFrame::SampleLevels levels;
+  levels.abs_max = 17;
+  levels.sum_square = 289.f;
+  frame.set_sample_levels(levels);
+  ASSERT_NE(nullptr, frame.sample_levels());
+  EXPECT_EQ(17, frame.sample_levels()->abs_max);
+  EXPECT_EQ(289.f, frame.sample_levels()->sum_square);
+  frame.data();
+  EXPECT_NE(nullptr, frame.sample_levels());
+  frame.mutable_data();
+  EXPECT_EQ(nullptr, frame.sample_levels());
+
+  frame.set_sample_levels(levels);
+  frame.Mute();
+  EXPECT_EQ(nullptr, frame.sample_levels());
+
+  frame.set_sample_levels(levels);
+  frame.UpdateFrame(kTimestamp, nullptr /* data */, kSamplesPerChannel,
+                    kSampleRateHz, AudioFrame::kPLC, AudioFrame::kVadActive,
+                    kNumChannelsMono);
+  EXPECT_EQ(nullptr, frame.sample_levels());
+
+  frame.set_sample_levels(levels);
+  frame.Reset();
+  EXPECT_EQ(nullptr, frame.sample_levels());
+}
+
+TEST(AudioFrameTest, CopyFromCopiesSampleLevels) {
+  AudioFrame frame1;
+  AudioFrame frame2;
+  AudioFrame::SampleLevels levels;
+  levels.abs_max = 17;
+  frame2.set_sample_levels(levels);
+  frame1.CopyFrom(frame2);
+  ASSERT_NE(nullptr, frame1.sample_levels());
+  EXPECT_EQ(17, frame1.sample_levels()->abs_max);
+
+  frame2.Reset();
+  frame1.CopyFrom(frame2);
+  EXPECT_EQ(nullptr, frame1.sample_levels());
+}
+
 }  // namespace webrtc
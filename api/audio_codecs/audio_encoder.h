@@ -59,6 +59,10 @@ struct ANAStats {
   // The uplink packet loss fractions as set by the ANA FEC controller. If this
   // value is not set, it indicates that the ANA FEC controller is not active.
   absl::optional<float> uplink_packet_loss_fraction;
+  // Number of times ANA changed the bitrate, frame length, FEC, DTX or number
+  // of channels of the encoder in the last minute. If this value is not set,
+  // it indicates that the encoder does not report it.
+  absl::optional<uint32_t> reconfigurations_per_minute;
 };
 
 // This is the interface class for encoders in AudioCoding module. Each codec
@@ -58,7 +58,8 @@ class FrameDecryptorInterface : public rtc::RefCountInterface {
   // bytes you wrote to in the frame buffer. kOk must be returned if successful,
   // kRecoverable should be returned if the failure was due to something other
   // than a decryption failure. kFailedToDecrypt should be returned in all other
-  // cases.
+  // cases. The frame buffer may start at the same address as the encrypted
+  // frame, in which case the frame must be decrypted in place.
   virtual Result Decrypt(cricket::MediaType media_type,
                          const std::vector<uint32_t>& csrcs,
                          rtc::ArrayView<const uint8_t> additional_data,
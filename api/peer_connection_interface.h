@@ -116,6 +116,7 @@
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_placement.h"
 
 namespace rtc {
 class Thread;
@@ -1301,6 +1302,11 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // Applied to the network and worker threads if they are created by the
+  // factory, e.g. to keep each factory of a server on one NUMA node. Threads
+  // created by them inherit it on Linux. Task queues created on other threads
+  // can be placed with CreatePlacedTaskQueueFactory().
+  rtc::ThreadPlacement thread_placement;
   std::unique_ptr<TaskQueueFactory> task_queue_factory;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
   std::unique_ptr<CallFactoryInterface> call_factory;
@@ -1359,6 +1365,15 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
 
     // Sets crypto related options, e.g. enabled cipher suites.
     CryptoOptions crypto_options = CryptoOptions::NoGcm();
+
+    // If positive, PeerConnections created without a certificate generator
+    // or certificate take their certificate from a pool of up to this many
+    // certificates, which is refilled in the background. This avoids waiting
+    // for key generation before the first offer or answer can be created.
+    int certificate_pool_size = 0;
+
+    // Pooled certificates are replaced with new ones after this long.
+    int64_t certificate_pool_max_age_ms = 60 * 60 * 1000;
   };
 
   // Set the options to be used for subsequently created PeerConnections.
@@ -20,6 +20,7 @@ SynchronousMethodCall::~SynchronousMethodCall() = default;
 
 void SynchronousMethodCall::Invoke(const rtc::Location& posted_from,
                                    rtc::Thread* t) {
+  rtc::Thread::CountSynchronousCall(t);
   if (t->IsCurrent()) {
     proxy_->OnMessage(nullptr);
   } else {
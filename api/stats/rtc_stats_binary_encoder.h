@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_STATS_RTC_STATS_BINARY_ENCODER_H_
+#define API_STATS_RTC_STATS_BINARY_ENCODER_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include "api/stats/rtc_stats_report.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Encodes |RTCStatsReport|s into a compact, columnar binary format, as a
+// cheaper alternative to |RTCStatsReport::ToJson| for exporting stats.
+//
+// The encoder is stateful: the schema of a stats type, i.e. its type name and
+// the names and types of its members, is only emitted the first time the type
+// is encoded. Later reports refer to it by index, so a decoder has to see all
+// reports produced by the same encoder, in order. Call |Reset| to emit all
+// schemas again, e.g. when starting a new output stream.
+//
+// Integers are encoded as varints (signed ones zigzag-encoded first), doubles
+// as 8 bytes little endian, bools as one byte and strings as a varint length
+// followed by the characters. A sequence is its varint length followed by its
+// elements. An encoded report is:
+//
+//   varint  format version (kFormatVersion)
+//   varint  report timestamp in microseconds, signed
+//   varint  number of new schemas, each being:
+//     string  stats type
+//     varint  number of members, each being:
+//       string  member name
+//       byte    RTCStatsMemberInterface::Type
+//   varint  number of stats groups, one for each type in the report:
+//     varint  schema index, in order of emission
+//     varint  number of stats N
+//     N x string           stats id
+//     N x zigzag varint    stats timestamp relative to the report timestamp
+//     for each member of the schema:
+//       ceil(N / 8) bytes  bitmap of which stats have the member defined
+//       values of the stats that have the member defined
+class RTC_EXPORT RTCStatsBinaryEncoder {
+ public:
+  static const uint64_t kFormatVersion = 1;
+
+  RTCStatsBinaryEncoder();
+  ~RTCStatsBinaryEncoder();
+
+  std::string Encode(const RTCStatsReport& report);
+
+  // Forgets the schemas emitted so far.
+  void Reset();
+
+ private:
+  std::map<std::string, size_t> schema_indices_;
+};
+
+}  // namespace webrtc
+
+#endif  // API_STATS_RTC_STATS_BINARY_ENCODER_H_
@@ -62,6 +62,11 @@ class RTC_EXPORT RTCStatsReport : public rtc::RefCountInterface {
   explicit RTCStatsReport(int64_t timestamp_us);
   RTCStatsReport(const RTCStatsReport& other) = delete;
   rtc::scoped_refptr<RTCStatsReport> Copy() const;
+  // Like Copy(), but only copies the stats objects that are not in |previous|
+  // or whose members differ from those in |previous|. This is cheaper to
+  // process for callers that poll stats and only care about what changed.
+  rtc::scoped_refptr<RTCStatsReport> CopyChangedSince(
+      const RTCStatsReport& previous) const;
 
   int64_t timestamp_us() const { return timestamp_us_; }
   void AddStats(std::unique_ptr<const RTCStats> stats);
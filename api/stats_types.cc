@@ -12,6 +12,8 @@
 
 #include <string.h>
 
+#include <utility>
+
 #include "absl/algorithm/container.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
@@ -735,46 +737,74 @@ const char* StatsReport::TypeToString() const {
 
 void StatsReport::AddString(StatsReport::StatsValueName name,
                             const std::string& value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kString))
+    *slot->value_.string_ = value;
+  else
+    slot = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddString(StatsReport::StatsValueName name,
                             const char* value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kStaticString))
+    slot->value_.static_string_ = value;
+  else
+    slot = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddInt64(StatsReport::StatsValueName name, int64_t value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value, Value::kInt64));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kInt64))
+    slot->value_.int64_ = value;
+  else
+    slot = ValuePtr(new Value(name, value, Value::kInt64));
 }
 
 void StatsReport::AddInt(StatsReport::StatsValueName name, int value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == static_cast<int64_t>(value)))
-    values_[name] = ValuePtr(new Value(name, value, Value::kInt));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == static_cast<int64_t>(value))
+    return;
+  if (CanUpdateInPlace(slot, Value::kInt))
+    slot->value_.int_ = value;
+  else
+    slot = ValuePtr(new Value(name, value, Value::kInt));
 }
 
 void StatsReport::AddFloat(StatsReport::StatsValueName name, float value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kFloat))
+    slot->value_.float_ = value;
+  else
+    slot = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddBoolean(StatsReport::StatsValueName name, bool value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kBool))
+    slot->value_.bool_ = value;
+  else
+    slot = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddId(StatsReport::StatsValueName name, const Id& value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
-    values_[name] = ValuePtr(new Value(name, value));
+  ValuePtr& slot = GetValueSlot(name);
+  if (slot && *slot == value)
+    return;
+  if (CanUpdateInPlace(slot, Value::kId))
+    *slot->value_.id_ = value;
+  else
+    slot = ValuePtr(new Value(name, value));
 }
 
 const StatsReport::Value* StatsReport::FindValue(StatsValueName name) const {
@@ -782,6 +812,28 @@ const StatsReport::Value* StatsReport::FindValue(StatsValueName name) const {
   return it == values_.end() ? nullptr : it->second.get();
 }
 
+void StatsReport::ResetValues() {
+  removed_values_.clear();
+  removed_values_.swap(values_);
+}
+
+StatsReport::ValuePtr& StatsReport::GetValueSlot(StatsValueName name) {
+  ValuePtr& slot = values_[name];
+  if (!slot && !removed_values_.empty()) {
+    Values::iterator it = removed_values_.find(name);
+    if (it != removed_values_.end()) {
+      slot = std::move(it->second);
+      removed_values_.erase(it);
+    }
+  }
+  return slot;
+}
+
+// static
+bool StatsReport::CanUpdateInPlace(const ValuePtr& value, Value::Type type) {
+  return value && value->type() == type && value->HasOneRef();
+}
+
 StatsCollection::StatsCollection() {}
 
 StatsCollection::~StatsCollection() {
@@ -826,9 +878,11 @@ StatsReport* StatsCollection::ReplaceOrAddNew(const StatsReport::Id& id) {
       list_,
       [&id](const StatsReport* r) -> bool { return r->id()->Equals(id); });
   if (it != end()) {
-    StatsReport* report = new StatsReport((*it)->id());
-    delete *it;
-    *it = report;
+    // Reused rather than recreated, so that its values can be updated in
+    // place.
+    StatsReport* report = *it;
+    report->ResetValues();
+    report->set_timestamp(0.0);
     return report;
   }
   return InsertNew(id);
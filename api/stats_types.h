@@ -344,6 +344,15 @@ class RTC_EXPORT StatsReport {
     const StatsValueName name;
 
    private:
+    friend class StatsReport;
+
+    // True if no copy of a Values map shares this value, so that it can be
+    // changed in place.
+    bool HasOneRef() const {
+      RTC_DCHECK_RUN_ON(&thread_checker_);
+      return ref_count_ == 1;
+    }
+
     rtc::ThreadChecker thread_checker_;
     mutable int ref_count_ RTC_GUARDED_BY(thread_checker_) = 0;
 
@@ -391,6 +400,9 @@ class RTC_EXPORT StatsReport {
 
   const char* TypeToString() const;
 
+  // The Add* methods update the value of |name| in place where they can, so
+  // that reports that are filled in on every poll don't allocate new values.
+  // Values held by a copy of values() are never changed.
   void AddString(StatsValueName name, const std::string& value);
   void AddString(StatsValueName name, const char* value);
   void AddInt64(StatsValueName name, int64_t value);
@@ -401,13 +413,26 @@ class RTC_EXPORT StatsReport {
 
   const Value* FindValue(StatsValueName name) const;
 
+  // Removes all values, e.g. before the report is filled in again. Their
+  // storage is reused by the Add* methods that follow.
+  void ResetValues();
+
  private:
+  // Returns the entry of |name| in |values_|, which is null if the report has
+  // no such value. Takes back the value removed by ResetValues() if there is
+  // one.
+  ValuePtr& GetValueSlot(StatsValueName name);
+  // True if |value| has type |type| and can be changed in place.
+  static bool CanUpdateInPlace(const ValuePtr& value, Value::Type type);
+
   // The unique identifier for this object.
   // This is used as a key for this report in ordered containers,
   // so it must never be changed.
   const Id id_;
   double timestamp_;  // Time since 1970-01-01T00:00:00Z in milliseconds.
   Values values_;
+  // Values removed by ResetValues() that have not been set again.
+  Values removed_values_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(StatsReport);
 };
@@ -11,6 +11,7 @@
 #define API_TASK_QUEUE_TASK_QUEUE_BASE_H_
 
 #include <memory>
+#include <utility>
 
 #include "api/task_queue/queued_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -23,6 +24,16 @@ namespace webrtc {
 // known task queue, use IsCurrent().
 class RTC_LOCKABLE TaskQueueBase {
  public:
+  enum class DelayPrecision {
+    // The task may run a little late, up to the timer slack of the
+    // implementation, so that it shares a wake up with other delayed tasks,
+    // e.g. for periodic statistics.
+    kLow,
+    // The task runs as close to its time as the implementation allows, e.g.
+    // for pacing.
+    kHigh,
+  };
+
   // Starts destruction of the task queue.
   // On return ensures no task are running and no new tasks are able to start
   // on the task queue.
@@ -48,9 +59,30 @@ class RTC_LOCKABLE TaskQueueBase {
   // the call is made. The precision should be considered as "best effort"
   // and in some cases, such as on Windows when all high precision timers have
   // been used up, can be off by as much as 15 millseconds.
+  // Implementations that coalesce timers may run the task up to their timer
+  // slack late.
   virtual void PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                uint32_t milliseconds) = 0;
 
+  // Same as PostDelayedTask(), but the task is not run late to coalesce wake
+  // ups. Implementations without timer slack need not override it.
+  virtual void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                            uint32_t milliseconds) {
+    PostDelayedTask(std::move(task), milliseconds);
+  }
+
+  // Calls PostDelayedTask() or PostDelayedHighPrecisionTask() according to
+  // |precision|.
+  void PostDelayedTaskWithPrecision(DelayPrecision precision,
+                                    std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) {
+    if (precision == DelayPrecision::kHigh) {
+      PostDelayedHighPrecisionTask(std::move(task), milliseconds);
+    } else {
+      PostDelayedTask(std::move(task), milliseconds);
+    }
+  }
+
   // Returns the task queue that is running the current thread.
   // Returns nullptr if this thread is not associated with any task queue.
   static TaskQueueBase* Current();
@@ -9,6 +9,8 @@
  */
 #include "api/task_queue/task_queue_test.h"
 
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "rtc_base/event.h"
@@ -269,5 +271,37 @@ TEST_P(TaskQueueTest, PostTwoWithSharedUnprotectedState) {
   EXPECT_TRUE(done.Wait(1000));
 }
 
+// Posts from several queues at once, so that tasks are posted both while the
+// queue is running tasks and while it waits. The tasks posted from one queue
+// must run in the order they were posted.
+TEST_P(TaskQueueTest, PostFromManyQueuesKeepsOrderPerQueue) {
+  std::unique_ptr<webrtc::TaskQueueFactory> factory = GetParam()();
+  static constexpr int kSenderCount = 4;
+  static constexpr int kTasksPerSender = 10000;
+  auto queue = CreateTaskQueue(factory, "PostFromManyQueues");
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> senders;
+  for (int i = 0; i < kSenderCount; ++i)
+    senders.push_back(CreateTaskQueue(factory, "Sender"));
+
+  // Only accessed on |queue|.
+  std::vector<int> next_task(kSenderCount, 0);
+  int tasks_run = 0;
+  bool in_order = true;
+  rtc::Event done;
+  for (int sender = 0; sender < kSenderCount; ++sender) {
+    senders[sender]->PostTask(ToQueuedTask([&, sender] {
+      for (int i = 0; i < kTasksPerSender; ++i) {
+        queue->PostTask(ToQueuedTask([&, sender, i] {
+          in_order &= next_task[sender]++ == i;
+          if (++tasks_run == kSenderCount * kTasksPerSender)
+            done.Set();
+        }));
+      }
+    }));
+  }
+  EXPECT_TRUE(done.Wait(60000));
+  EXPECT_TRUE(in_order);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -103,6 +103,10 @@ class VideoCodecTestFixture {
     // Force the encoder and decoder to use a single core for processing.
     bool use_single_core = false;
 
+    // If non-zero, the number of cores the encoder and decoder may use. Takes
+    // precedence over |use_single_core|.
+    size_t num_cores = 0;
+
     // Should cpu usage be measured?
     // If set to true, the encoding will run in real-time.
     bool measure_cpu = false;
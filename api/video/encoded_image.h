@@ -158,6 +158,12 @@ class RTC_EXPORT EncodedImage {
     buffer_ = nullptr;
   }
 
+  // Returns null if the image data is not owned by reference counted storage,
+  // i.e. was set with set_buffer.
+  rtc::scoped_refptr<EncodedImageBufferInterface> GetEncodedData() const {
+    return buffer_ ? nullptr : encoded_data_;
+  }
+
   // TODO(nisse): Delete, provide only read-only access to the buffer.
   uint8_t* data() {
     return buffer_ ? buffer_
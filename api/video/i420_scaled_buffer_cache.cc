@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/i420_scaled_buffer_cache.h"
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// static
+rtc::scoped_refptr<I420ScaledBufferCache> I420ScaledBufferCache::Create(
+    rtc::scoped_refptr<VideoFrameBuffer> source) {
+  return new rtc::RefCountedObject<I420ScaledBufferCache>(std::move(source));
+}
+
+I420ScaledBufferCache::I420ScaledBufferCache(
+    rtc::scoped_refptr<VideoFrameBuffer> source)
+    : source_(std::move(source)) {
+  RTC_DCHECK(source_);
+  RTC_DCHECK_NE(source_->type(), VideoFrameBuffer::Type::kNative);
+}
+
+I420ScaledBufferCache::~I420ScaledBufferCache() = default;
+
+rtc::scoped_refptr<I420BufferInterface> I420ScaledBufferCache::GetScaledI420(
+    int width,
+    int height) {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+  rtc::CritScope lock(&crit_);
+  if (levels_.empty()) {
+    levels_.push_back(source_->ToI420());
+    // The conversion fails e.g. if the frame can't be mapped.
+    if (!levels_[0]) {
+      levels_.clear();
+      return nullptr;
+    }
+  }
+
+  // Find the smallest level to scale from, which is the source if the
+  // resolution is larger than all levels in either dimension.
+  const I420BufferInterface* scale_from = levels_[0].get();
+  for (const rtc::scoped_refptr<I420BufferInterface>& level : levels_) {
+    if (level->width() == width && level->height() == height)
+      return level;
+    if (level->width() >= width && level->height() >= height &&
+        level->width() * level->height() <
+            scale_from->width() * scale_from->height()) {
+      scale_from = level.get();
+    }
+  }
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(width, height);
+  scaled->ScaleFrom(*scale_from);
+  levels_.push_back(scaled);
+  return scaled;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_I420_SCALED_BUFFER_CACHE_H_
+#define API_VIDEO_I420_SCALED_BUFFER_CACHE_H_
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/scaled_buffer_cache.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// A ScaledBufferCache that keeps every resolution asked for as a level of a
+// pyramid. A new resolution is scaled from the smallest level that is at least
+// as large, rather than from the source, so a chain of simulcast streams
+// costs about as much as scaling each from the one above it. |source| must
+// not be a native buffer.
+class RTC_EXPORT I420ScaledBufferCache : public ScaledBufferCache {
+ public:
+  static rtc::scoped_refptr<I420ScaledBufferCache> Create(
+      rtc::scoped_refptr<VideoFrameBuffer> source);
+
+  rtc::scoped_refptr<I420BufferInterface> GetScaledI420(int width,
+                                                        int height) override;
+
+ protected:
+  explicit I420ScaledBufferCache(rtc::scoped_refptr<VideoFrameBuffer> source);
+  ~I420ScaledBufferCache() override;
+
+ private:
+  rtc::CriticalSection crit_;
+  const rtc::scoped_refptr<VideoFrameBuffer> source_;
+  // The source converted to I420, followed by the scaled buffers in the order
+  // they were created.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> levels_
+      RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_I420_SCALED_BUFFER_CACHE_H_
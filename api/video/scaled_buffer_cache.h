@@ -0,0 +1,38 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_SCALED_BUFFER_CACHE_H_
+#define API_VIDEO_SCALED_BUFFER_CACHE_H_
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/ref_count.h"
+
+namespace webrtc {
+
+// Scaled versions of a frame buffer, computed on demand and shared by the
+// copies of a VideoFrame, so that every consumer that needs a given
+// resolution, e.g. the streams of a simulcast encoder, reuses the same
+// scaled buffer. See I420ScaledBufferCache for the implementation.
+class ScaledBufferCache : public rtc::RefCountInterface {
+ public:
+  // Returns the buffer scaled to |width|x|height|, scaling it on the first
+  // call for that resolution. Can be called from any thread.
+  virtual rtc::scoped_refptr<I420BufferInterface> GetScaledI420(
+      int width,
+      int height) = 0;
+
+ protected:
+  ~ScaledBufferCache() override {}
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_SCALED_BUFFER_CACHE_H_
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/i420_scaled_buffer_cache.h"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<I420Buffer> CreateSource() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(1280, 720);
+  I420Buffer::SetBlack(buffer);
+  return buffer;
+}
+
+}  // namespace
+
+TEST(I420ScaledBufferCacheTest, ReturnsSameBufferForSameResolution) {
+  rtc::scoped_refptr<I420Buffer> source = CreateSource();
+  rtc::scoped_refptr<I420ScaledBufferCache> cache =
+      I420ScaledBufferCache::Create(source);
+
+  rtc::scoped_refptr<I420BufferInterface> scaled =
+      cache->GetScaledI420(640, 360);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(640, scaled->width());
+  EXPECT_EQ(360, scaled->height());
+  EXPECT_EQ(scaled, cache->GetScaledI420(640, 360));
+
+  rtc::scoped_refptr<I420BufferInterface> smaller =
+      cache->GetScaledI420(320, 180);
+  EXPECT_EQ(320, smaller->width());
+  EXPECT_EQ(180, smaller->height());
+  EXPECT_NE(scaled, smaller);
+  EXPECT_EQ(scaled, cache->GetScaledI420(640, 360));
+}
+
+TEST(I420ScaledBufferCacheTest, SourceResolutionReturnsSource) {
+  rtc::scoped_refptr<I420Buffer> source = CreateSource();
+  rtc::scoped_refptr<I420ScaledBufferCache> cache =
+      I420ScaledBufferCache::Create(source);
+  EXPECT_EQ(source.get(), cache->GetScaledI420(1280, 720).get());
+}
+
+TEST(I420ScaledBufferCacheTest, ScalesBlackToBlack) {
+  rtc::scoped_refptr<I420ScaledBufferCache> cache =
+      I420ScaledBufferCache::Create(CreateSource());
+  // 320x180 is scaled from the 640x360 level.
+  cache->GetScaledI420(640, 360);
+  rtc::scoped_refptr<I420BufferInterface> scaled =
+      cache->GetScaledI420(320, 180);
+  EXPECT_EQ(0, scaled->DataY()[0]);
+  EXPECT_EQ(128, scaled->DataU()[0]);
+  EXPECT_EQ(128, scaled->DataV()[0]);
+}
+
+TEST(I420ScaledBufferCacheTest, SharedByFrameCopiesUntilBufferChanges) {
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(CreateSource())
+                         .set_timestamp_us(0)
+                         .build();
+  EXPECT_FALSE(frame.scaled_buffer_cache());
+  frame.set_scaled_buffer_cache(
+      I420ScaledBufferCache::Create(frame.video_frame_buffer()));
+
+  VideoFrame copy(frame);
+  EXPECT_EQ(frame.scaled_buffer_cache(), copy.scaled_buffer_cache());
+
+  copy.set_video_frame_buffer(CreateSource());
+  EXPECT_FALSE(copy.scaled_buffer_cache());
+  EXPECT_TRUE(frame.scaled_buffer_cache());
+}
+
+}  // namespace webrtc
@@ -210,6 +210,7 @@ void VideoFrame::set_video_frame_buffer(
     const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   RTC_CHECK(buffer);
   video_frame_buffer_ = buffer;
+  scaled_buffer_cache_ = nullptr;
 }
 
 int64_t VideoFrame::render_time_ms() const {
@@ -20,6 +20,7 @@
 #include "api/scoped_refptr.h"
 #include "api/video/color_space.h"
 #include "api/video/hdr_metadata.h"
+#include "api/video/scaled_buffer_cache.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "rtc_base/checks.h"
@@ -163,9 +164,19 @@ class RTC_EXPORT VideoFrame {
   // initialized VideoFrame.
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> video_frame_buffer() const;
 
+  // Also clears the scaled buffer cache, which belongs to the old buffer.
   void set_video_frame_buffer(
       const rtc::scoped_refptr<VideoFrameBuffer>& buffer);
 
+  // Scaled versions of video_frame_buffer(), shared by all copies of the
+  // frame. Might be null, in which case consumers scale the buffer themselves.
+  const rtc::scoped_refptr<ScaledBufferCache>& scaled_buffer_cache() const {
+    return scaled_buffer_cache_;
+  }
+  void set_scaled_buffer_cache(rtc::scoped_refptr<ScaledBufferCache> cache) {
+    scaled_buffer_cache_ = std::move(cache);
+  }
+
   // TODO(nisse): Deprecated.
   // Return true if the frame is stored in a texture.
   bool is_texture() const {
@@ -218,6 +229,7 @@ class RTC_EXPORT VideoFrame {
   // MediaStreamTrack, in order to implement getContributingSources(). See:
   // https://w3c.github.io/webrtc-pc/#dom-rtcrtpreceiver-getcontributingsources
   RtpPacketInfos packet_infos_;
+  rtc::scoped_refptr<ScaledBufferCache> scaled_buffer_cache_;
 };
 
 }  // namespace webrtc
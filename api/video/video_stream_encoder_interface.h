@@ -46,6 +46,12 @@ class VideoStreamEncoderInterface : public rtc::VideoSinkInterface<VideoFrame> {
         std::vector<VideoStream> streams,
         VideoEncoderConfig::ContentType content_type,
         int min_transmit_bitrate_bps) = 0;
+
+    // Called before and after VideoEncoder::Encode() of each input frame, so
+    // that the layers that the encoder delivers from within it can be sent
+    // as one batch.
+    virtual void OnSuperframeStarted() {}
+    virtual void OnSuperframeEnded() {}
   };
 
   // Sets the source that will provide video frames to the VideoStreamEncoder's
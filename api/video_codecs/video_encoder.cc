@@ -97,6 +97,8 @@ constexpr VideoEncoder::ScalingSettings::KOff
     VideoEncoder::ScalingSettings::kOff;
 // static
 constexpr uint8_t VideoEncoder::EncoderInfo::kMaxFramerateFraction;
+// static
+constexpr size_t VideoEncoder::EncoderInfo::kMaxPreferredPixelFormats;
 
 VideoEncoder::EncoderInfo::EncoderInfo()
     : scaling_settings(VideoEncoder::ScalingSettings::kOff),
@@ -108,7 +110,8 @@ VideoEncoder::EncoderInfo::EncoderInfo()
       fps_allocation{absl::InlinedVector<uint8_t, kMaxTemporalStreams>(
           1,
           kMaxFramerateFraction)},
-      supports_simulcast(false) {}
+      supports_simulcast(false),
+      preferred_pixel_formats{VideoFrameBuffer::Type::kI420} {}
 
 VideoEncoder::EncoderInfo::EncoderInfo(const EncoderInfo&) = default;
 
@@ -147,6 +147,7 @@ class RTC_EXPORT VideoEncoder {
   struct EncoderInfo {
     static constexpr uint8_t kMaxFramerateFraction =
         std::numeric_limits<uint8_t>::max();
+    static constexpr size_t kMaxPreferredPixelFormats = 5;
 
     EncoderInfo();
     EncoderInfo(const EncoderInfo&);
@@ -223,6 +224,13 @@ class RTC_EXPORT VideoEncoder {
     // in such case the encoder should return
     // WEBRTC_VIDEO_CODEC_ERR_SIMULCAST_PARAMETERS_NOT_SUPPORTED.
     bool supports_simulcast;
+
+    // The pixel formats, in order of preference, that the encoder encodes
+    // without converting them first. A source that can produce several
+    // formats should pick the first one it can. Frames in other formats are
+    // converted with VideoFrameBuffer::ToI420(). Defaults to I420 only.
+    absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+        preferred_pixel_formats;
   };
 
   struct RateControlParameters {
@@ -53,13 +53,16 @@ double AudioLevel::TotalDuration() const {
 }
 
 void AudioLevel::ComputeLevel(const AudioFrame& audioFrame, double duration) {
-  // Check speech level (works for 2 channels as well)
+  // Check speech level (works for 2 channels as well). Reuse the levels
+  // computed by the capture path, if the frame has them.
+  const AudioFrame::SampleLevels* levels = audioFrame.sample_levels();
   int16_t abs_value =
-      audioFrame.muted()
-          ? 0
-          : WebRtcSpl_MaxAbsValueW16(
-                audioFrame.data(),
-                audioFrame.samples_per_channel_ * audioFrame.num_channels_);
+      levels ? levels->abs_max
+             : audioFrame.muted()
+                   ? 0
+                   : WebRtcSpl_MaxAbsValueW16(audioFrame.data(),
+                                              audioFrame.samples_per_channel_ *
+                                                  audioFrame.num_channels_);
 
   // Protect member access using a lock since this method is called on a
   // dedicated audio thread in the RecordedDataIsAvailable() callback.
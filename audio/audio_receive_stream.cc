@@ -10,6 +10,8 @@
 
 #include "audio/audio_receive_stream.h"
 
+#include <stdio.h>
+
 #include <string>
 #include <utility>
 
@@ -28,6 +30,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -66,6 +69,30 @@ std::string AudioReceiveStream::Config::ToString() const {
 
 namespace internal {
 namespace {
+
+constexpr char kDecodeAheadFieldTrial[] = "WebRTC-Audio-DecodeAhead";
+constexpr int kDefaultDecodeAheadFrames = 2;
+constexpr int kMaxDecodeAheadFrames = 5;
+
+// Returns the number of 10ms frames to decode ahead of the mixer, or 0 if the
+// field trial is disabled.
+size_t GetDecodeAheadFrames() {
+  if (!webrtc::field_trial::IsEnabled(kDecodeAheadFieldTrial))
+    return 0;
+  const std::string field_trial_string =
+      webrtc::field_trial::FindFullName(kDecodeAheadFieldTrial);
+  int num_frames = kDefaultDecodeAheadFrames;
+  if (sscanf(field_trial_string.c_str(), "Enabled-%d", &num_frames) == 1 &&
+      num_frames > 0 && num_frames <= kMaxDecodeAheadFrames) {
+    return num_frames;
+  }
+  if (field_trial_string != "Enabled") {
+    RTC_LOG(LS_WARNING) << "Invalid parameter for " << kDecodeAheadFieldTrial
+                        << ", using default.";
+  }
+  return kDefaultDecodeAheadFrames;
+}
+
 std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
     Clock* clock,
     webrtc::AudioState* audio_state,
@@ -88,6 +115,7 @@ std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
 
 AudioReceiveStream::AudioReceiveStream(
     Clock* clock,
+    TaskQueueFactory* task_queue_factory,
     RtpStreamReceiverControllerInterface* receiver_controller,
     PacketRouter* packet_router,
     ProcessThread* module_process_thread,
@@ -95,6 +123,7 @@ AudioReceiveStream::AudioReceiveStream(
     const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
     webrtc::RtcEventLog* event_log)
     : AudioReceiveStream(clock,
+                         task_queue_factory,
                          receiver_controller,
                          packet_router,
                          config,
@@ -108,6 +137,7 @@ AudioReceiveStream::AudioReceiveStream(
 
 AudioReceiveStream::AudioReceiveStream(
     Clock* clock,
+    TaskQueueFactory* task_queue_factory,
     RtpStreamReceiverControllerInterface* receiver_controller,
     PacketRouter* packet_router,
     const webrtc::AudioReceiveStream::Config& config,
@@ -116,12 +146,15 @@ AudioReceiveStream::AudioReceiveStream(
     std::unique_ptr<voe::ChannelReceiveInterface> channel_receive)
     : audio_state_(audio_state),
       channel_receive_(std::move(channel_receive)),
-      source_tracker_(clock) {
+      source_tracker_(clock),
+      task_queue_factory_(task_queue_factory),
+      decode_ahead_frames_(GetDecodeAheadFrames()) {
   RTC_LOG(LS_INFO) << "AudioReceiveStream: " << config.rtp.remote_ssrc;
   RTC_DCHECK(config.decoder_factory);
   RTC_DCHECK(config.rtcp_send_transport);
   RTC_DCHECK(audio_state_);
   RTC_DCHECK(channel_receive_);
+  RTC_DCHECK(task_queue_factory_);
 
   module_process_thread_checker_.Detach();
 
@@ -161,6 +194,10 @@ void AudioReceiveStream::Start() {
   }
   channel_receive_->StartPlayout();
   playing_ = true;
+  if (decode_ahead_frames_ > 0) {
+    decode_ahead_buffer_ = std::make_unique<DecodeAheadBuffer>(
+        task_queue_factory_, channel_receive_.get(), decode_ahead_frames_);
+  }
   audio_state()->AddReceivingStream(this);
 }
 
@@ -172,6 +209,8 @@ void AudioReceiveStream::Stop() {
   channel_receive_->StopPlayout();
   playing_ = false;
   audio_state()->RemoveReceivingStream(this);
+  // No longer pulled by the mixer, so the buffer can go.
+  decode_ahead_buffer_.reset();
 }
 
 webrtc::AudioReceiveStream::Stats AudioReceiveStream::GetStats() const {
@@ -279,21 +318,39 @@ AudioMixer::Source::AudioFrameInfo AudioReceiveStream::GetAudioFrameWithInfo(
     int sample_rate_hz,
     AudioFrame* audio_frame) {
   AudioMixer::Source::AudioFrameInfo audio_frame_info =
-      channel_receive_->GetAudioFrameWithInfo(sample_rate_hz, audio_frame);
+      decode_ahead_buffer_
+          ? decode_ahead_buffer_->GetAudioFrameWithInfo(sample_rate_hz,
+                                                        audio_frame)
+          : channel_receive_->GetAudioFrameWithInfo(sample_rate_hz,
+                                                    audio_frame);
   if (audio_frame_info != AudioMixer::Source::AudioFrameInfo::kError) {
     source_tracker_.OnFrameDelivered(audio_frame->packet_infos_);
   }
   return audio_frame_info;
 }
 
+void AudioReceiveStream::SkipAudioFrame() {
+  if (decode_ahead_buffer_) {
+    decode_ahead_buffer_->SkipAudioFrame();
+    return;
+  }
+  channel_receive_->SkipAudioFrame();
+}
+
 int AudioReceiveStream::Ssrc() const {
   return config_.rtp.remote_ssrc;
 }
 
 int AudioReceiveStream::PreferredSampleRate() const {
+  if (decode_ahead_buffer_)
+    return decode_ahead_buffer_->PreferredSampleRate();
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStream::GetLatestReceivedAudioLevel() const {
+  return channel_receive_->GetLatestReceivedAudioLevel();
+}
+
 int AudioReceiveStream::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return config_.rtp.remote_ssrc;
@@ -16,7 +16,9 @@
 
 #include "api/audio/audio_mixer.h"
 #include "api/rtp_headers.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "audio/audio_state.h"
+#include "audio/decode_ahead_buffer.h"
 #include "call/audio_receive_stream.h"
 #include "call/syncable.h"
 #include "modules/rtp_rtcp/source/source_tracker.h"
@@ -44,6 +46,7 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                  public Syncable {
  public:
   AudioReceiveStream(Clock* clock,
+                     TaskQueueFactory* task_queue_factory,
                      RtpStreamReceiverControllerInterface* receiver_controller,
                      PacketRouter* packet_router,
                      ProcessThread* module_process_thread,
@@ -53,6 +56,7 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
   // For unit tests, which need to supply a mock channel receive.
   AudioReceiveStream(
       Clock* clock,
+      TaskQueueFactory* task_queue_factory,
       RtpStreamReceiverControllerInterface* receiver_controller,
       PacketRouter* packet_router,
       const webrtc::AudioReceiveStream::Config& config,
@@ -81,8 +85,10 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
   // AudioMixer::Source
   AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
                                        AudioFrame* audio_frame) override;
+  void SkipAudioFrame() override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> GetLatestReceivedAudioLevel() const override;
 
   // Syncable
   int id() const override;
@@ -112,6 +118,13 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
 
   bool playing_ RTC_GUARDED_BY(worker_thread_checker_) = false;
 
+  // With the WebRTC-Audio-DecodeAhead field trial, audio is decoded ahead of
+  // the mixer on a task queue while the stream is playing. The buffer is only
+  // replaced while the stream isn't added to the mixer.
+  TaskQueueFactory* const task_queue_factory_;
+  const size_t decode_ahead_frames_;
+  std::unique_ptr<DecodeAheadBuffer> decode_ahead_buffer_;
+
   std::unique_ptr<RtpStreamReceiverInterface> rtp_stream_receiver_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(AudioReceiveStream);
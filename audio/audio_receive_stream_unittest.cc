@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/test/mock_audio_mixer.h"
 #include "api/test/mock_frame_decryptor.h"
 #include "audio/conversion.h"
@@ -115,8 +116,9 @@ struct ConfigHelper {
   std::unique_ptr<internal::AudioReceiveStream> CreateAudioReceiveStream() {
     return std::unique_ptr<internal::AudioReceiveStream>(
         new internal::AudioReceiveStream(
-            Clock::GetRealTimeClock(), &rtp_stream_receiver_controller_,
-            &packet_router_, stream_config_, audio_state_, &event_log_,
+            Clock::GetRealTimeClock(), task_queue_factory_.get(),
+            &rtp_stream_receiver_controller_, &packet_router_, stream_config_,
+            audio_state_, &event_log_,
             std::unique_ptr<voe::ChannelReceiveInterface>(channel_receive_)));
   }
 
@@ -148,6 +150,8 @@ struct ConfigHelper {
   }
 
  private:
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_ =
+      CreateDefaultTaskQueueFactory();
   PacketRouter packet_router_;
   MockRtcEventLog event_log_;
   rtc::scoped_refptr<AudioState> audio_state_;
@@ -18,6 +18,7 @@
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_processing/include/mock_audio_processing.h"
 #include "rtc_base/ref_counted_object.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -185,6 +186,53 @@ TEST(AudioStateTest, RecordedAudioArrivesAtMultipleStreams) {
   audio_state->RemoveSendingStream(&stream_2);
 }
 
+TEST(AudioStateTest, RecordedAudioIsConvertedByApmWithFieldTrial) {
+  ScopedFieldTrials field_trials("WebRTC-Audio-ConvertCaptureInApm/Enabled/");
+  ConfigHelper helper;
+  rtc::scoped_refptr<internal::AudioState> audio_state(
+      new rtc::RefCountedObject<internal::AudioState>(helper.config()));
+
+  MockAudioSendStream stream;
+  audio_state->AddSendingStream(&stream, 8000, 2);
+
+  EXPECT_CALL(
+      stream,
+      SendAudioDataForMock(::testing::AllOf(
+          ::testing::Field(&AudioFrame::sample_rate_hz_, ::testing::Eq(8000)),
+          ::testing::Field(&AudioFrame::num_channels_, ::testing::Eq(2u)))));
+  MockAudioProcessing* ap =
+      static_cast<MockAudioProcessing*>(audio_state->audio_processing());
+  // The captured audio is passed to the APM as is, instead of resampled first.
+  EXPECT_CALL(*ap, ProcessStream(::testing::_)).Times(0);
+  EXPECT_CALL(
+      *ap,
+      ProcessStream(
+          ::testing::AllOf(
+              ::testing::Field(&AudioFrame::sample_rate_hz_,
+                               ::testing::Eq(16000)),
+              ::testing::Field(&AudioFrame::num_channels_, ::testing::Eq(2u))),
+          ::testing::AllOf(
+              ::testing::Field(&AudioFrame::sample_rate_hz_,
+                               ::testing::Eq(8000)),
+              ::testing::Field(&AudioFrame::num_channels_,
+                               ::testing::Eq(2u)))))
+      .WillOnce(::testing::Invoke(
+          [](const AudioFrame& input_frame, AudioFrame* output_frame) {
+            output_frame->samples_per_channel_ = 80;
+            return AudioProcessing::kNoError;
+          }));
+
+  constexpr int kSampleRate = 16000;
+  constexpr size_t kNumChannels = 2;
+  auto audio_data = Create10msTestData(kSampleRate, kNumChannels);
+  uint32_t new_mic_level = 667;
+  audio_state->audio_transport()->RecordedDataIsAvailable(
+      &audio_data[0], kSampleRate / 100, kNumChannels * 2, kNumChannels,
+      kSampleRate, 0, 0, 0, false, new_mic_level);
+
+  audio_state->RemoveSendingStream(&stream);
+}
+
 TEST(AudioStateTest, EnableChannelSwap) {
   constexpr int kSampleRate = 16000;
   constexpr size_t kNumChannels = 2;
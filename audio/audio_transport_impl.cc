@@ -18,6 +18,7 @@
 #include "audio/utility/audio_frame_operations.h"
 #include "call/audio_send_stream.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -43,16 +44,21 @@ void InitializeCaptureFrame(int input_sample_rate,
   audio_frame->num_channels_ = std::min(input_num_channels, send_num_channels);
 }
 
+// Processes |audio_frame| in-place, or |input_frame| into |audio_frame| if
+// set.
 void ProcessCaptureFrame(uint32_t delay_ms,
                          bool key_pressed,
                          bool swap_stereo_channels,
                          AudioProcessing* audio_processing,
+                         const AudioFrame* input_frame,
                          AudioFrame* audio_frame) {
   RTC_DCHECK(audio_processing);
   RTC_DCHECK(audio_frame);
   audio_processing->set_stream_delay_ms(delay_ms);
   audio_processing->set_stream_key_pressed(key_pressed);
-  int error = audio_processing->ProcessStream(audio_frame);
+  int error = input_frame
+                  ? audio_processing->ProcessStream(*input_frame, audio_frame)
+                  : audio_processing->ProcessStream(audio_frame);
   RTC_DCHECK_EQ(0, error) << "ProcessStream() error: " << error;
   if (swap_stereo_channels) {
     AudioFrameOperations::SwapStereoChannels(audio_frame);
@@ -81,7 +87,10 @@ int Resample(const AudioFrame& frame,
 
 AudioTransportImpl::AudioTransportImpl(AudioMixer* mixer,
                                        AudioProcessing* audio_processing)
-    : audio_processing_(audio_processing), mixer_(mixer) {
+    : audio_processing_(audio_processing),
+      convert_capture_in_apm_(
+          field_trial::IsEnabled("WebRTC-Audio-ConvertCaptureInApm")),
+      mixer_(mixer) {
   RTC_DCHECK(mixer);
   RTC_DCHECK(audio_processing);
 }
@@ -124,12 +133,26 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
   std::unique_ptr<AudioFrame> audio_frame(new AudioFrame());
   InitializeCaptureFrame(sample_rate, send_sample_rate_hz, number_of_channels,
                          send_num_channels, audio_frame.get());
-  voe::RemixAndResample(static_cast<const int16_t*>(audio_data),
-                        number_of_frames, number_of_channels, sample_rate,
-                        &capture_resampler_, audio_frame.get());
-  ProcessCaptureFrame(audio_delay_milliseconds, key_pressed,
-                      swap_stereo_channels, audio_processing_,
-                      audio_frame.get());
+  if (convert_capture_in_apm_ &&
+      (static_cast<int>(sample_rate) != audio_frame->sample_rate_hz_ ||
+       number_of_channels != audio_frame->num_channels_)) {
+    // Saves the int16 resampling and the conversions to and from float that
+    // come with it.
+    capture_input_frame_.UpdateFrame(
+        0, static_cast<const int16_t*>(audio_data), number_of_frames,
+        sample_rate, AudioFrame::kUndefined, AudioFrame::kVadUnknown,
+        number_of_channels);
+    ProcessCaptureFrame(audio_delay_milliseconds, key_pressed,
+                        swap_stereo_channels, audio_processing_,
+                        &capture_input_frame_, audio_frame.get());
+  } else {
+    voe::RemixAndResample(static_cast<const int16_t*>(audio_data),
+                          number_of_frames, number_of_channels, sample_rate,
+                          &capture_resampler_, audio_frame.get());
+    ProcessCaptureFrame(audio_delay_milliseconds, key_pressed,
+                        swap_stereo_channels, audio_processing_, nullptr,
+                        audio_frame.get());
+  }
 
   // Typing detection (utilizes the APM/VAD decision). We let the VAD determine
   // if we're using this feature or not.
@@ -142,8 +165,16 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
     }
   }
 
+  // Compute the sample levels once, for the audio level stats and the RTP
+  // audio level indication of all sending streams.
+  audio_frame->set_sample_levels(
+      AudioFrameOperations::ComputeSampleLevels(*audio_frame));
+
   // Copy frame and push to each sending stream. The copy is required since an
-  // encoding task will be posted internally to each stream.
+  // encoding task will be posted internally to each stream, which then writes
+  // its own RTP timestamp and mute ramp into the frame. CopyFrom() only copies
+  // the samples in use, and skips them for muted frames, which is cheap next
+  // to encoding the frame.
   {
     rtc::CritScope lock(&capture_lock_);
     typing_noise_detected_ = typing_detected;
@@ -79,6 +79,11 @@ class AudioTransportImpl : public AudioTransport {
   bool swap_stereo_channels_ RTC_GUARDED_BY(capture_lock_) = false;
   PushResampler<int16_t> capture_resampler_;
   TypingDetection typing_detection_;
+  // If set, captured audio that needs resampling or downmixing is converted
+  // to the send format by |audio_processing_|, from |capture_input_frame_|,
+  // instead of by |capture_resampler_|.
+  const bool convert_capture_in_apm_;
+  AudioFrame capture_input_frame_;
 
   // Render side.
   rtc::scoped_refptr<AudioMixer> mixer_;
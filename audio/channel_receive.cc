@@ -161,8 +161,12 @@ class ChannelReceive : public ChannelReceiveInterface,
       int sample_rate_hz,
       AudioFrame* audio_frame) override;
 
+  void SkipAudioFrame() override;
+
   int PreferredSampleRate() const override;
 
+  absl::optional<int> GetLatestReceivedAudioLevel() const override;
+
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
   void SetAssociatedSendChannel(const ChannelSendInterface* channel) override;
@@ -230,6 +234,12 @@ class ChannelReceive : public ChannelReceiveInterface,
   absl::optional<int64_t> last_received_rtp_system_time_ms_
       RTC_GUARDED_BY(&sync_info_lock_);
 
+  // Audio level of the latest received packet, updated on the network or
+  // worker thread and queried on the audio thread.
+  rtc::CriticalSection audio_level_lock_;
+  absl::optional<int> latest_received_audio_level_
+      RTC_GUARDED_BY(&audio_level_lock_);
+
   // The AcmReceiver is thread safe, using its own lock.
   acm2::AcmReceiver acm_receiver_;
   AudioSinkInterface* audio_sink_ = nullptr;
@@ -432,6 +442,11 @@ AudioMixer::Source::AudioFrameInfo ChannelReceive::GetAudioFrameWithInfo(
                : AudioMixer::Source::AudioFrameInfo::kNormal;
 }
 
+void ChannelReceive::SkipAudioFrame() {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  acm_receiver_.SkipAudio();
+}
+
 int ChannelReceive::PreferredSampleRate() const {
   RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
   // Return the bigger of playout and receive frequency in the ACM.
@@ -439,6 +454,11 @@ int ChannelReceive::PreferredSampleRate() const {
                   acm_receiver_.last_output_sample_rate_hz());
 }
 
+absl::optional<int> ChannelReceive::GetLatestReceivedAudioLevel() const {
+  rtc::CritScope cs(&audio_level_lock_);
+  return latest_received_audio_level_;
+}
+
 ChannelReceive::ChannelReceive(
     Clock* clock,
     ProcessThread* module_process_thread,
@@ -587,6 +607,15 @@ void ChannelReceive::OnRtpPacket(const RtpPacketReceived& packet) {
   RTPHeader header;
   packet_copy.GetHeader(&header);
 
+  {
+    rtc::CritScope cs(&audio_level_lock_);
+    if (header.extension.hasAudioLevel) {
+      latest_received_audio_level_ = header.extension.audioLevel;
+    } else {
+      latest_received_audio_level_ = absl::nullopt;
+    }
+  }
+
   ReceivePacket(packet_copy.data(), packet_copy.size(), header);
 }
 
@@ -127,8 +127,14 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
       int sample_rate_hz,
       AudioFrame* audio_frame) = 0;
 
+  virtual void SkipAudioFrame() = 0;
+
   virtual int PreferredSampleRate() const = 0;
 
+  // Returns the audio level signaled in the latest received RTP packet, if
+  // any. See AudioMixer::Source::GetLatestReceivedAudioLevel.
+  virtual absl::optional<int> GetLatestReceivedAudioLevel() const = 0;
+
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
   virtual void SetAssociatedSendChannel(
@@ -278,6 +278,8 @@ class ChannelSend : public ChannelSendInterface,
   // E2EE Audio Frame Encryption
   rtc::scoped_refptr<FrameEncryptorInterface> frame_encryptor_
       RTC_GUARDED_BY(encoder_queue_);
+  // Output of |frame_encryptor_|, kept to reuse its allocation between frames.
+  rtc::Buffer encrypted_audio_payload_ RTC_GUARDED_BY(encoder_queue_);
   // E2EE Frame Encryption Options
   const webrtc::CryptoOptions crypto_options_;
 
@@ -457,8 +459,6 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
   }
 
   // E2EE Custom Audio Frame Encryption (This is optional).
-  // Keep this buffer around for the lifetime of the send call.
-  rtc::Buffer encrypted_audio_payload;
   // We don't invoke encryptor if payload is empty, which means we are to send
   // DTMF, or the encoder entered DTX.
   // TODO(minyue): see whether DTMF packets should be encrypted or not. In
@@ -469,13 +469,13 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
       // Allocate a buffer to hold the maximum possible encrypted payload.
       size_t max_ciphertext_size = frame_encryptor_->GetMaxCiphertextByteSize(
           cricket::MEDIA_TYPE_AUDIO, payload.size());
-      encrypted_audio_payload.SetSize(max_ciphertext_size);
+      encrypted_audio_payload_.SetSize(max_ciphertext_size);
 
       // Encrypt the audio payload into the buffer.
       size_t bytes_written = 0;
       int encrypt_status = frame_encryptor_->Encrypt(
           cricket::MEDIA_TYPE_AUDIO, _rtpRtcpModule->SSRC(),
-          /*additional_data=*/nullptr, payload, encrypted_audio_payload,
+          /*additional_data=*/nullptr, payload, encrypted_audio_payload_,
           &bytes_written);
       if (encrypt_status != 0) {
         RTC_DLOG(LS_ERROR)
@@ -484,9 +484,9 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
         return -1;
       }
       // Resize the buffer to the exact number of bytes actually used.
-      encrypted_audio_payload.SetSize(bytes_written);
+      encrypted_audio_payload_.SetSize(bytes_written);
       // Rewrite the payloadData and size to the new encrypted payload.
-      payload = encrypted_audio_payload;
+      payload = encrypted_audio_payload_;
     } else if (crypto_options_.sframe.require_frame_encryption) {
       RTC_DLOG(LS_ERROR) << "Channel::SendData() failed sending audio payload: "
                          << "A frame encryptor is required but one is not set.";
@@ -1050,8 +1050,13 @@ void ChannelSend::ProcessAndEncodeAudio(
           size_t length =
               audio_frame->samples_per_channel_ * audio_frame->num_channels_;
           RTC_CHECK_LE(length, AudioFrame::kMaxDataSizeBytes);
+          const AudioFrame::SampleLevels* levels =
+              audio_frame->sample_levels();
           if (is_muted && previous_frame_muted_) {
             rms_level_.AnalyzeMuted(length);
+          } else if (levels) {
+            // Unmodified since the capture path computed the levels.
+            rms_level_.AnalyzeSumSquare(levels->sum_square, length);
           } else {
             rms_level_.Analyze(
                 rtc::ArrayView<const int16_t>(audio_frame->data(), length));
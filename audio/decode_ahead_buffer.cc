@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/decode_ahead_buffer.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+
+namespace webrtc {
+
+DecodeAheadBuffer::DecodeAheadBuffer(
+    TaskQueueFactory* task_queue_factory,
+    voe::ChannelReceiveInterface* channel_receive,
+    size_t num_frames)
+    : channel_receive_(channel_receive),
+      num_frames_(num_frames),
+      sample_rate_hz_(0),
+      preferred_sample_rate_hz_(channel_receive->PreferredSampleRate()),
+      queue_(num_frames),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "AudioDecodeAhead",
+          TaskQueueFactory::Priority::HIGH)) {
+  RTC_DCHECK_GT(num_frames_, 0);
+  consumer_frame_.frame = std::make_unique<AudioFrame>();
+  producer_frame_.frame = std::make_unique<AudioFrame>();
+}
+
+DecodeAheadBuffer::~DecodeAheadBuffer() = default;
+
+AudioMixer::Source::AudioFrameInfo DecodeAheadBuffer::GetAudioFrameWithInfo(
+    int sample_rate_hz,
+    AudioFrame* audio_frame) {
+  if (!PopFrame(sample_rate_hz)) {
+    audio_frame->sample_rate_hz_ = sample_rate_hz;
+    audio_frame->samples_per_channel_ =
+        rtc::CheckedDivExact(sample_rate_hz, 100);
+    if (audio_frame->num_channels_ == 0)
+      audio_frame->num_channels_ = 1;
+    audio_frame->Mute();
+    return AudioMixer::Source::AudioFrameInfo::kMuted;
+  }
+  audio_frame->CopyFrom(*consumer_frame_.frame);
+  return consumer_frame_.info;
+}
+
+void DecodeAheadBuffer::SkipAudioFrame() {
+  // The frame has already been decoded, so there is nothing left to save.
+  PopFrame(sample_rate_hz_.load(std::memory_order_relaxed));
+}
+
+int DecodeAheadBuffer::PreferredSampleRate() const {
+  return preferred_sample_rate_hz_.load(std::memory_order_relaxed);
+}
+
+bool DecodeAheadBuffer::PopFrame(int sample_rate_hz) {
+  sample_rate_hz_.store(sample_rate_hz, std::memory_order_relaxed);
+  bool popped = false;
+  if (queue_.Remove(&consumer_frame_)) {
+    --num_pending_frames_;
+    popped = consumer_frame_.frame->sample_rate_hz_ == sample_rate_hz;
+  }
+  if (!popped)
+    ++num_underruns_;
+  while (num_pending_frames_ < num_frames_) {
+    ++num_pending_frames_;
+    task_queue_.PostTask([this] { DecodeFrame(); });
+  }
+  return popped;
+}
+
+void DecodeAheadBuffer::DecodeFrame() {
+  RTC_DCHECK_RUN_ON(&task_queue_);
+  // Only the first |num_frames_| inserts get an empty slot without a frame.
+  if (!producer_frame_.frame)
+    producer_frame_.frame = std::make_unique<AudioFrame>();
+  producer_frame_.info = channel_receive_->GetAudioFrameWithInfo(
+      sample_rate_hz_.load(std::memory_order_relaxed),
+      producer_frame_.frame.get());
+  preferred_sample_rate_hz_.store(channel_receive_->PreferredSampleRate(),
+                                  std::memory_order_relaxed);
+  // Can't fail, since no more than |num_frames_| are requested at a time.
+  bool inserted = queue_.Insert(&producer_frame_);
+  RTC_DCHECK(inserted);
+}
+
+}  // namespace webrtc
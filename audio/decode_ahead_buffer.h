@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_DECODE_AHEAD_BUFFER_H_
+#define AUDIO_DECODE_AHEAD_BUFFER_H_
+
+#include <atomic>
+#include <memory>
+
+#include "api/audio/audio_frame.h"
+#include "api/audio/audio_mixer.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "audio/channel_receive.h"
+#include "rtc_base/swap_queue.h"
+#include "rtc_base/task_queue.h"
+
+namespace webrtc {
+
+// Decodes the audio of a ChannelReceive on its own task queue, a fixed number
+// of 10ms frames ahead of the audio mixer, so that the decoding and NetEq
+// processing of several receive streams run in parallel instead of serialized
+// on the playout thread.
+//
+// Each pull by the mixer takes the oldest decoded frame and requests a new one,
+// keeping |num_frames| frames queued or being decoded. If the next frame isn't
+// ready yet, a muted frame is returned and counted as an underrun. Frames are
+// decoded at the sample rate of the latest pull; frames decoded at a
+// different rate are dropped.
+//
+// Frames are passed between the threads through a preallocated SwapQueue, so
+// no memory is allocated once the first |num_frames| frames have been decoded.
+class DecodeAheadBuffer {
+ public:
+  // |channel_receive| must outlive this object, and must not be used for
+  // decoding by anyone else while it exists.
+  DecodeAheadBuffer(TaskQueueFactory* task_queue_factory,
+                    voe::ChannelReceiveInterface* channel_receive,
+                    size_t num_frames);
+  ~DecodeAheadBuffer();
+
+  // These replace the methods with the same names of |channel_receive| and
+  // must be called serialized, usually on the playout thread.
+  AudioMixer::Source::AudioFrameInfo GetAudioFrameWithInfo(
+      int sample_rate_hz,
+      AudioFrame* audio_frame);
+  void SkipAudioFrame();
+  int PreferredSampleRate() const;
+
+  // Number of pulls for which no decoded frame was available.
+  size_t num_underruns() const { return num_underruns_; }
+
+ private:
+  struct DecodedFrame {
+    std::unique_ptr<AudioFrame> frame;
+    AudioMixer::Source::AudioFrameInfo info =
+        AudioMixer::Source::AudioFrameInfo::kError;
+  };
+
+  // Returns the next decoded frame in |consumer_frame_|, or false if there is
+  // none. Requests new frames so that |num_frames_| are pending again.
+  bool PopFrame(int sample_rate_hz);
+  // Runs on |task_queue_|.
+  void DecodeFrame();
+
+  voe::ChannelReceiveInterface* const channel_receive_;
+  const size_t num_frames_;
+
+  // Sample rate requested by the latest pull.
+  std::atomic<int> sample_rate_hz_;
+  // PreferredSampleRate() of |channel_receive_|, updated after each decoded
+  // frame.
+  std::atomic<int> preferred_sample_rate_hz_;
+
+  SwapQueue<DecodedFrame> queue_;
+
+  // Only used on the pulling thread.
+  DecodedFrame consumer_frame_;
+  // Number of frames queued in |queue_| or requested from |task_queue_|.
+  size_t num_pending_frames_ = 0;
+  size_t num_underruns_ = 0;
+
+  // Only used on |task_queue_|.
+  DecodedFrame producer_frame_;
+
+  // Declared last, so that it's destroyed, and pending decode tasks dropped,
+  // before the members above.
+  rtc::TaskQueue task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_DECODE_AHEAD_BUFFER_H_
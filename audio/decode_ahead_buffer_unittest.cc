@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/decode_ahead_buffer.h"
+
+#include <atomic>
+#include <memory>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "audio/mock_voe_channel_proxy.h"
+#include "rtc_base/event.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPer10ms = kSampleRateHz / 100;
+constexpr size_t kNumFrames = 2;
+constexpr int kWaitForDecodeMs = 1000;
+
+class DecodeAheadBufferTest : public ::testing::Test {
+ protected:
+  DecodeAheadBufferTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()) {
+    ON_CALL(channel_receive_, PreferredSampleRate())
+        .WillByDefault(Return(kSampleRateHz));
+    // Each decoded frame gets the next timestamp.
+    ON_CALL(channel_receive_, GetAudioFrameWithInfo(_, _))
+        .WillByDefault(Invoke([this](int sample_rate_hz, AudioFrame* frame) {
+          frame->UpdateFrame(num_decoded_frames_ * kSamplesPer10ms, nullptr,
+                             sample_rate_hz / 100, sample_rate_hz,
+                             AudioFrame::kNormalSpeech, AudioFrame::kVadActive);
+          ++num_decoded_frames_;
+          decoded_.Set();
+          return AudioMixer::Source::AudioFrameInfo::kNormal;
+        }));
+  }
+
+  // Waits until |num_frames| frames have been decoded in total.
+  void WaitForDecodedFrames(uint32_t num_frames) {
+    while (num_decoded_frames_ < num_frames)
+      ASSERT_TRUE(decoded_.Wait(kWaitForDecodeMs));
+  }
+
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  NiceMock<test::MockChannelReceive> channel_receive_;
+  rtc::Event decoded_;
+  std::atomic<uint32_t> num_decoded_frames_{0};
+};
+
+TEST_F(DecodeAheadBufferTest, DeliversFramesInOrderAfterPriming) {
+  DecodeAheadBuffer buffer(task_queue_factory_.get(), &channel_receive_,
+                           kNumFrames);
+  AudioFrame frame;
+  // Nothing has been decoded before the first pull.
+  EXPECT_EQ(AudioMixer::Source::AudioFrameInfo::kMuted,
+            buffer.GetAudioFrameWithInfo(kSampleRateHz, &frame));
+  EXPECT_TRUE(frame.muted());
+  EXPECT_EQ(kSampleRateHz, frame.sample_rate_hz_);
+  EXPECT_EQ(kSamplesPer10ms, frame.samples_per_channel_);
+  EXPECT_EQ(1u, buffer.num_underruns());
+
+  WaitForDecodedFrames(kNumFrames);
+  for (uint32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(AudioMixer::Source::AudioFrameInfo::kNormal,
+              buffer.GetAudioFrameWithInfo(kSampleRateHz, &frame));
+    EXPECT_EQ(i * kSamplesPer10ms, frame.timestamp_);
+    WaitForDecodedFrames(kNumFrames + i + 1);
+  }
+  EXPECT_EQ(1u, buffer.num_underruns());
+  EXPECT_EQ(kSampleRateHz, buffer.PreferredSampleRate());
+}
+
+TEST_F(DecodeAheadBufferTest, SkipConsumesAFrame) {
+  DecodeAheadBuffer buffer(task_queue_factory_.get(), &channel_receive_,
+                           kNumFrames);
+  AudioFrame frame;
+  buffer.GetAudioFrameWithInfo(kSampleRateHz, &frame);
+  WaitForDecodedFrames(kNumFrames);
+
+  buffer.SkipAudioFrame();
+  WaitForDecodedFrames(kNumFrames + 1);
+  EXPECT_EQ(AudioMixer::Source::AudioFrameInfo::kNormal,
+            buffer.GetAudioFrameWithInfo(kSampleRateHz, &frame));
+  EXPECT_EQ(kSamplesPer10ms, frame.timestamp_);
+}
+
+TEST_F(DecodeAheadBufferTest, DropsFramesDecodedAtAnotherSampleRate) {
+  DecodeAheadBuffer buffer(task_queue_factory_.get(), &channel_receive_,
+                           kNumFrames);
+  AudioFrame frame;
+  buffer.GetAudioFrameWithInfo(kSampleRateHz, &frame);
+  WaitForDecodedFrames(kNumFrames);
+
+  // The queued frames have the old sample rate.
+  constexpr int kNewSampleRateHz = 16000;
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(AudioMixer::Source::AudioFrameInfo::kMuted,
+              buffer.GetAudioFrameWithInfo(kNewSampleRateHz, &frame));
+    EXPECT_EQ(kNewSampleRateHz, frame.sample_rate_hz_);
+    WaitForDecodedFrames(kNumFrames + i + 1);
+  }
+  EXPECT_EQ(AudioMixer::Source::AudioFrameInfo::kNormal,
+            buffer.GetAudioFrameWithInfo(kNewSampleRateHz, &frame));
+  EXPECT_EQ(kNewSampleRateHz, frame.sample_rate_hz_);
+  EXPECT_EQ(1 + kNumFrames, buffer.num_underruns());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -46,7 +46,9 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
   MOCK_METHOD2(GetAudioFrameWithInfo,
                AudioMixer::Source::AudioFrameInfo(int sample_rate_hz,
                                                   AudioFrame* audio_frame));
+  MOCK_METHOD0(SkipAudioFrame, void());
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
+  MOCK_CONST_METHOD0(GetLatestReceivedAudioLevel, absl::optional<int>());
   MOCK_METHOD1(SetAssociatedSendChannel,
                void(const voe::ChannelSendInterface* send_channel));
   MOCK_CONST_METHOD0(GetPlayoutTimestamp, uint32_t());
@@ -10,6 +10,8 @@
 
 #include "audio/remix_resample.h"
 
+#include <string.h>
+
 #include "api/audio/audio_frame.h"
 #include "audio/utility/audio_frame_operations.h"
 #include "common_audio/resampler/include/push_resampler.h"
@@ -39,21 +41,29 @@ void RemixAndResample(const int16_t* src_data,
   const int16_t* audio_ptr = src_data;
   size_t audio_ptr_num_channels = num_channels;
   int16_t downmixed_audio[AudioFrame::kMaxDataSizeSamples];
+  // Without resampling, the audio is downmixed or copied straight into
+  // |dst_frame|, instead of through |downmixed_audio| and the resampler.
+  const bool resample = sample_rate_hz != dst_frame->sample_rate_hz_;
 
   // Downmix before resampling.
   if (num_channels > dst_frame->num_channels_) {
-    RTC_DCHECK(num_channels == 2 || num_channels == 4)
+    RTC_DCHECK(num_channels == 2 || num_channels == 4 || num_channels == 6 ||
+               num_channels == 8)
         << "num_channels: " << num_channels;
     RTC_DCHECK(dst_frame->num_channels_ == 1 || dst_frame->num_channels_ == 2)
         << "dst_frame->num_channels_: " << dst_frame->num_channels_;
 
+    int16_t* downmix_dst =
+        resample ? downmixed_audio : dst_frame->mutable_data();
     AudioFrameOperations::DownmixChannels(
         src_data, num_channels, samples_per_channel, dst_frame->num_channels_,
-        downmixed_audio);
-    audio_ptr = downmixed_audio;
+        downmix_dst);
+    audio_ptr = downmix_dst;
     audio_ptr_num_channels = dst_frame->num_channels_;
   }
 
+  // The resampler is kept initialized also when it isn't used, so that it is
+  // reset when resampling starts again.
   if (resampler->InitializeIfNeeded(sample_rate_hz, dst_frame->sample_rate_hz_,
                                     audio_ptr_num_channels) == -1) {
     FATAL() << "InitializeIfNeeded failed: sample_rate_hz = " << sample_rate_hz
@@ -61,20 +71,29 @@ void RemixAndResample(const int16_t* src_data,
             << ", audio_ptr_num_channels = " << audio_ptr_num_channels;
   }
 
-  // TODO(yujo): for muted input frames, don't resample. Either 1) allow
-  // resampler to return output length without doing the resample, so we know
-  // how much to zero here; or 2) make resampler accept a hint that the input is
-  // zeroed.
   const size_t src_length = samples_per_channel * audio_ptr_num_channels;
-  int out_length =
-      resampler->Resample(audio_ptr, src_length, dst_frame->mutable_data(),
-                          AudioFrame::kMaxDataSizeSamples);
-  if (out_length == -1) {
-    FATAL() << "Resample failed: audio_ptr = " << audio_ptr
-            << ", src_length = " << src_length
-            << ", dst_frame->mutable_data() = " << dst_frame->mutable_data();
+  if (!resample) {
+    RTC_CHECK_LE(src_length, AudioFrame::kMaxDataSizeSamples);
+    if (audio_ptr != dst_frame->data()) {
+      memcpy(dst_frame->mutable_data(), audio_ptr,
+             src_length * sizeof(*audio_ptr));
+    }
+    dst_frame->samples_per_channel_ = samples_per_channel;
+  } else {
+    // TODO(yujo): for muted input frames, don't resample. Either 1) allow
+    // resampler to return output length without doing the resample, so we
+    // know how much to zero here; or 2) make resampler accept a hint that the
+    // input is zeroed.
+    int out_length =
+        resampler->Resample(audio_ptr, src_length, dst_frame->mutable_data(),
+                            AudioFrame::kMaxDataSizeSamples);
+    if (out_length == -1) {
+      FATAL() << "Resample failed: audio_ptr = " << audio_ptr
+              << ", src_length = " << src_length
+              << ", dst_frame->mutable_data() = " << dst_frame->mutable_data();
+    }
+    dst_frame->samples_per_channel_ = out_length / audio_ptr_num_channels;
   }
-  dst_frame->samples_per_channel_ = out_length / audio_ptr_num_channels;
 
   // Upmix after resampling.
   if (num_channels == 1 && dst_frame->num_channels_ == 2) {
@@ -12,6 +12,7 @@
 
 #include <cmath>
 
+#include "audio/utility/audio_frame_operations.h"
 #include "common_audio/resampler/include/push_resampler.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
@@ -272,6 +273,34 @@ TEST_F(UtilityTest, RemixAndResampleSucceeds) {
   }
 }
 
+TEST_F(UtilityTest, RemixAndResampleSurroundSucceeds) {
+  for (size_t src_channels : {6, 8}) {
+    for (size_t dst_channels : {1, 2}) {
+      src_frame_.Mute();
+      src_frame_.num_channels_ = src_channels;
+      src_frame_.sample_rate_hz_ = 48000;
+      src_frame_.samples_per_channel_ = 480;
+      int16_t* src_data = src_frame_.mutable_data();
+      for (size_t i = 0; i < 480 * src_channels; ++i)
+        src_data[i] = static_cast<int16_t>((i % 97) * 50 - 2000);
+
+      // Without resampling the result is exactly the downmix.
+      golden_frame_.CopyFrom(src_frame_);
+      AudioFrameOperations::DownmixChannels(dst_channels, &golden_frame_);
+      dst_frame_.Mute();
+      dst_frame_.num_channels_ = dst_channels;
+      dst_frame_.sample_rate_hz_ = 48000;
+      RemixAndResample(src_frame_, &resampler_, &dst_frame_);
+      VerifyFramesAreEqual(golden_frame_, dst_frame_);
+
+      dst_frame_.sample_rate_hz_ = 16000;
+      RemixAndResample(src_frame_, &resampler_, &dst_frame_);
+      EXPECT_EQ(dst_channels, dst_frame_.num_channels_);
+      EXPECT_EQ(160u, dst_frame_.samples_per_channel_);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace voe
 }  // namespace webrtc
@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Benchmarks the per-stream voice engine components, APM, NetEq and Opus,
+// with the same metric: the CPU time to process one 10 ms frame of audio. Each
+// benchmark runs with one stream, and with several streams interleaved on one
+// thread, which models a server packing streams onto a core and includes the
+// cost of their state not staying in the caches. Besides the time per frame,
+// the number of real-time streams that one core can process is reported, for
+// sizing hardware.
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/opus/audio_decoder_opus.h"
+#include "api/audio_codecs/opus/audio_encoder_opus.h"
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_coding/neteq/tools/audio_loop.h"
+#include "modules/audio_coding/neteq/tools/audio_sink.h"
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_packet_source_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+// Longest Opus packet, 120 ms.
+constexpr size_t kMaxOpusPacketSamples = 12 * kSamplesPer10Ms;
+constexpr int kNumWarmupFrames = 100;
+constexpr int kNumMeasuredFrames = 1000;
+constexpr int kStreamsPerCore[] = {1, 8};
+
+// Runs |process_frame| for each of |num_streams| streams in turn, and reports
+// the mean and standard deviation of the time per stream and frame.
+// |process_frame| returns false when the stream has no more frames.
+void RunAndReport(const std::string& measurement,
+                  const std::string& modifier,
+                  int num_streams,
+                  std::function<bool(int stream)> process_frame) {
+  std::vector<double> frame_times_ns;
+  frame_times_ns.reserve(kNumMeasuredFrames);
+  bool finished = false;
+  for (int frame = 0;
+       frame < kNumWarmupFrames + kNumMeasuredFrames && !finished; ++frame) {
+    const int64_t start_time_ns = rtc::TimeNanos();
+    for (int stream = 0; stream < num_streams && !finished; ++stream) {
+      finished = !process_frame(stream);
+    }
+    if (frame >= kNumWarmupFrames && !finished) {
+      frame_times_ns.push_back(
+          static_cast<double>(rtc::TimeNanos() - start_time_ns) / num_streams);
+    }
+  }
+  ASSERT_FALSE(frame_times_ns.empty());
+
+  double mean_ns = 0.0;
+  for (double time_ns : frame_times_ns)
+    mean_ns += time_ns;
+  mean_ns /= frame_times_ns.size();
+  double variance = 0.0;
+  for (double time_ns : frame_times_ns)
+    variance += (time_ns - mean_ns) * (time_ns - mean_ns);
+  variance /= frame_times_ns.size();
+
+  const std::string trace = std::to_string(num_streams) + "_streams";
+  test::PrintResultMeanAndError(measurement, modifier, trace, mean_ns,
+                                std::sqrt(variance), "ns_per_10ms_frame", true,
+                                test::ImproveDirection::kSmallerIsBetter);
+  test::PrintResult(measurement, modifier + "_realtime_streams_per_core", trace,
+                    rtc::kNumNanosecsPerMillisec * 10 / mean_ns, "streams",
+                    false, test::ImproveDirection::kBiggerIsBetter);
+}
+
+std::unique_ptr<test::AudioLoop> CreateSpeechLoop() {
+  auto audio_loop = std::make_unique<test::AudioLoop>();
+  RTC_CHECK(audio_loop->Init(
+      test::ResourcePath("audio_coding/speech_mono_32_48kHz", "pcm"),
+      kSampleRateHz * 10, kSamplesPer10Ms));
+  return audio_loop;
+}
+
+struct ApmStream {
+  std::unique_ptr<AudioProcessing> apm;
+  std::unique_ptr<test::AudioLoop> audio;
+  AudioFrame capture_frame;
+  AudioFrame render_frame;
+};
+
+void FillFrame(test::AudioLoop* audio, AudioFrame* frame) {
+  rtc::ArrayView<const int16_t> block = audio->GetNextBlock();
+  frame->UpdateFrame(0, block.data(), kSamplesPer10Ms, kSampleRateHz,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadUnknown, 1);
+}
+
+void RunApmBenchmark(const std::string& name,
+                     const AudioProcessing::Config& config) {
+  for (int num_streams : kStreamsPerCore) {
+    std::vector<ApmStream> streams(num_streams);
+    for (ApmStream& stream : streams) {
+      stream.apm.reset(AudioProcessingBuilder().Create());
+      stream.apm->ApplyConfig(config);
+      stream.audio = CreateSpeechLoop();
+    }
+    RunAndReport("apm", name, num_streams, [&streams](int i) {
+      ApmStream& stream = streams[i];
+      // The speech is used both as the far-end and as the near-end signal.
+      FillFrame(stream.audio.get(), &stream.render_frame);
+      FillFrame(stream.audio.get(), &stream.capture_frame);
+      EXPECT_EQ(AudioProcessing::kNoError,
+                stream.apm->ProcessReverseStream(&stream.render_frame));
+      stream.apm->set_stream_delay_ms(0);
+      EXPECT_EQ(AudioProcessing::kNoError,
+                stream.apm->ProcessStream(&stream.capture_frame));
+      return true;
+    });
+  }
+}
+
+void RunOpusBenchmark(int complexity) {
+  const std::string modifier = "_complexity_" + std::to_string(complexity);
+  for (int num_streams : kStreamsPerCore) {
+    struct OpusStream {
+      std::unique_ptr<AudioEncoder> encoder;
+      std::unique_ptr<AudioDecoder> decoder;
+      std::unique_ptr<test::AudioLoop> audio;
+      rtc::Buffer encoded;
+      uint32_t rtp_timestamp = 0;
+      int16_t decoded[kMaxOpusPacketSamples];
+    };
+    std::vector<OpusStream> streams(num_streams);
+    for (OpusStream& stream : streams) {
+      AudioEncoderOpusConfig config;
+      config.complexity = complexity;
+      config.low_rate_complexity = complexity;
+      stream.encoder = AudioEncoderOpus::MakeAudioEncoder(config, 111);
+      stream.decoder =
+          AudioDecoderOpus::MakeAudioDecoder(AudioDecoderOpus::Config());
+      stream.audio = CreateSpeechLoop();
+    }
+    // Encoding and decoding one 10 ms frame; the encoder outputs a packet every
+    // |config.frame_size_ms|, which is then decoded.
+    RunAndReport("opus_encode_decode", modifier, num_streams,
+                 [&streams](int i) {
+                   OpusStream& stream = streams[i];
+                   stream.encoded.Clear();
+                   stream.encoder->Encode(stream.rtp_timestamp,
+                                          stream.audio->GetNextBlock(),
+                                          &stream.encoded);
+                   stream.rtp_timestamp += kSamplesPer10Ms;
+                   if (!stream.encoded.empty()) {
+                     AudioDecoder::SpeechType speech_type;
+                     EXPECT_GT(stream.decoder->Decode(
+                                   stream.encoded.data(), stream.encoded.size(),
+                                   kSampleRateHz, sizeof(stream.decoded),
+                                   stream.decoded, &speech_type),
+                               0);
+                   }
+                   return true;
+                 });
+  }
+}
+
+void RunNetEqBenchmark(const std::string& name, const std::string& rtp_file) {
+  const test::NetEqPacketSourceInput::RtpHeaderExtensionMap rtp_ext_map = {
+      {1, kRtpExtensionAudioLevel},
+      {3, kRtpExtensionAbsoluteSendTime},
+      {5, kRtpExtensionTransportSequenceNumber},
+      {7, kRtpExtensionVideoContentType},
+      {8, kRtpExtensionVideoTiming}};
+  for (int num_streams : kStreamsPerCore) {
+    std::vector<std::unique_ptr<test::NetEqTest>> streams;
+    for (int i = 0; i < num_streams; ++i) {
+      std::unique_ptr<test::NetEqInput> input(
+          new test::NetEqRtpDumpInput(test::ResourcePath(rtp_file, "rtp"),
+                                      rtp_ext_map, absl::nullopt));
+      streams.push_back(std::make_unique<test::NetEqTest>(
+          NetEq::Config(), CreateBuiltinAudioDecoderFactory(),
+          test::NetEqTest::StandardDecoderMap(), nullptr, std::move(input),
+          std::make_unique<test::VoidAudioSink>(),
+          test::NetEqTest::Callbacks()));
+    }
+    // Each step inserts the packets that arrived in the trace since the last
+    // step, and pulls 10 ms of audio. Reading the trace file is included.
+    RunAndReport("neteq", name, num_streams, [&streams](int i) {
+      return !streams[i]->RunToNextGetAudio().is_simulation_finished;
+    });
+  }
+}
+
+}  // namespace
+
+TEST(VoiceEnginePerfTest, ApmEchoCanceller3) {
+  AudioProcessing::Config config;
+  config.echo_canceller.enabled = true;
+  RunApmBenchmark("_aec3", config);
+}
+
+TEST(VoiceEnginePerfTest, ApmClientDefault) {
+  AudioProcessing::Config config;
+  config.high_pass_filter.enabled = true;
+  config.echo_canceller.enabled = true;
+  config.noise_suppression.enabled = true;
+  config.gain_controller1.enabled = true;
+  config.gain_controller1.mode =
+      AudioProcessing::Config::GainController1::kAdaptiveDigital;
+  RunApmBenchmark("_client_default", config);
+}
+
+TEST(VoiceEnginePerfTest, ApmMobile) {
+  AudioProcessing::Config config;
+  config.high_pass_filter.enabled = true;
+  config.echo_canceller.enabled = true;
+  config.echo_canceller.mobile_mode = true;
+  config.noise_suppression.enabled = true;
+  config.gain_controller1.enabled = true;
+  config.gain_controller1.mode =
+      AudioProcessing::Config::GainController1::kFixedDigital;
+  RunApmBenchmark("_mobile", config);
+}
+
+TEST(VoiceEnginePerfTest, ApmNoiseSuppressionAndAgc2) {
+  AudioProcessing::Config config;
+  config.noise_suppression.enabled = true;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  RunApmBenchmark("_ns_agc2", config);
+}
+
+TEST(VoiceEnginePerfTest, Opus) {
+  for (int complexity : {0, 5, 9, 10}) {
+    RunOpusBenchmark(complexity);
+  }
+}
+
+TEST(VoiceEnginePerfTest, NetEqOpusTrace) {
+  RunNetEqBenchmark("_opus", "audio_coding/neteq_opus");
+}
+
+TEST(VoiceEnginePerfTest, NetEqOpusDtxTrace) {
+  RunNetEqBenchmark("_opus_dtx", "audio_coding/neteq_opus_dtx");
+}
+
+}  // namespace webrtc
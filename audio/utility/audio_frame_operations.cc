@@ -10,6 +10,7 @@
 
 #include "audio/utility/audio_frame_operations.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <algorithm>
@@ -19,6 +20,13 @@
 #include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -27,6 +35,76 @@ namespace {
 const size_t kMuteFadeFrames = 128;
 const float kMuteFadeInc = 1.0f / kMuteFadeFrames;
 
+// Weights of the input channels in the left and right output channel, in Q14.
+// These are the ChannelMixingMatrix weights for mixing each layout to
+// CHANNEL_LAYOUT_STEREO. The corresponding LFE, center, side and back channels
+// are mixed with ChannelMixer::kHalfPower.
+constexpr int kQ14One = 1 << 14;
+constexpr int kQ14HalfPower = 11585;
+// CHANNEL_LAYOUT_5_1: FL, FR, FC, LFE, SL, SR.
+constexpr int16_t k5_1ToStereoWeights[2][6] = {
+    {kQ14One, 0, kQ14HalfPower, kQ14HalfPower, kQ14HalfPower, 0},
+    {0, kQ14One, kQ14HalfPower, kQ14HalfPower, 0, kQ14HalfPower}};
+// CHANNEL_LAYOUT_7_1: FL, FR, FC, LFE, SL, SR, BL, BR.
+constexpr int16_t k7_1ToStereoWeights[2][8] = {
+    {kQ14One, 0, kQ14HalfPower, kQ14HalfPower, kQ14HalfPower, 0, kQ14HalfPower,
+     0},
+    {0, kQ14One, kQ14HalfPower, kQ14HalfPower, 0, kQ14HalfPower, 0,
+     kQ14HalfPower}};
+
+// Mixes |kNumChannels| interleaved channels to stereo with |weights|, or to
+// mono as the average of the stereo channels. The sums can't overflow, since
+// the weights of an output channel add up to less than 4 in Q14. Can be done
+// in-place, since the input samples of a frame are read before its output
+// samples are written.
+template <size_t kNumChannels>
+void DownmixWithWeights(const int16_t* src_audio,
+                        size_t samples_per_channel,
+                        const int16_t (&weights)[2][kNumChannels],
+                        size_t dst_channels,
+                        int16_t* dst_audio) {
+  RTC_DCHECK(dst_channels == 1 || dst_channels == 2);
+  constexpr int32_t kRounding = 1 << 13;
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    const int16_t* frame = &src_audio[i * kNumChannels];
+    int32_t left = 0;
+    int32_t right = 0;
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      left += weights[0][ch] * frame[ch];
+      right += weights[1][ch] * frame[ch];
+    }
+    if (dst_channels == 1) {
+      dst_audio[i] = rtc::saturated_cast<int16_t>(
+          ((left >> 1) + (right >> 1) + kRounding) >> 14);
+    } else {
+      dst_audio[2 * i] = rtc::saturated_cast<int16_t>((left + kRounding) >> 14);
+      dst_audio[2 * i + 1] =
+          rtc::saturated_cast<int16_t>((right + kRounding) >> 14);
+    }
+  }
+}
+
+// Returns true if |src_channels| to |dst_channels| is mixed by DownmixSurround.
+bool IsSurroundDownmix(size_t src_channels, size_t dst_channels) {
+  return (src_channels == 6 || src_channels == 8) &&
+         (dst_channels == 1 || dst_channels == 2);
+}
+
+void DownmixSurround(const int16_t* src_audio,
+                     size_t src_channels,
+                     size_t samples_per_channel,
+                     size_t dst_channels,
+                     int16_t* dst_audio) {
+  if (src_channels == 6) {
+    DownmixWithWeights(src_audio, samples_per_channel, k5_1ToStereoWeights,
+                       dst_channels, dst_audio);
+  } else {
+    RTC_DCHECK_EQ(src_channels, 8);
+    DownmixWithWeights(src_audio, samples_per_channel, k7_1ToStereoWeights,
+                       dst_channels, dst_audio);
+  }
+}
+
 }  // namespace
 
 void AudioFrameOperations::Add(const AudioFrame& frame_to_add,
@@ -91,7 +169,33 @@ int AudioFrameOperations::StereoToMono(AudioFrame* frame) {
 void AudioFrameOperations::QuadToStereo(const int16_t* src_audio,
                                         size_t samples_per_channel,
                                         int16_t* dst_audio) {
-  for (size_t i = 0; i < samples_per_channel; i++) {
+  size_t i = 0;
+  // The sums of adjacent samples make up the interleaved stereo output. A full
+  // vector of input is loaded before any output is written, which keeps the
+  // operation in-place.
+#if defined(WEBRTC_HAS_NEON)
+  for (; i + 4 <= samples_per_channel; i += 4) {
+    const int32x4_t sums_low = vpaddlq_s16(vld1q_s16(&src_audio[4 * i]));
+    const int32x4_t sums_high = vpaddlq_s16(vld1q_s16(&src_audio[4 * i + 8]));
+    vst1q_s16(&dst_audio[2 * i], vcombine_s16(vshrn_n_s32(sums_low, 1),
+                                              vshrn_n_s32(sums_high, 1)));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  const __m128i ones = _mm_set1_epi16(1);
+  for (; i + 4 <= samples_per_channel; i += 4) {
+    const __m128i sums_low = _mm_madd_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src_audio[4 * i])),
+        ones);
+    const __m128i sums_high = _mm_madd_epi16(
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&src_audio[4 * i + 8])),
+        ones);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst_audio[2 * i]),
+                     _mm_packs_epi32(_mm_srai_epi32(sums_low, 1),
+                                     _mm_srai_epi32(sums_high, 1)));
+  }
+#endif
+  for (; i < samples_per_channel; i++) {
     dst_audio[i * 2] =
         (static_cast<int32_t>(src_audio[4 * i]) + src_audio[4 * i + 1]) >> 1;
     dst_audio[i * 2 + 1] =
@@ -122,7 +226,11 @@ void AudioFrameOperations::DownmixChannels(const int16_t* src_audio,
                                            size_t samples_per_channel,
                                            size_t dst_channels,
                                            int16_t* dst_audio) {
-  if (src_channels > 1 && dst_channels == 1) {
+  if (IsSurroundDownmix(src_channels, dst_channels)) {
+    DownmixSurround(src_audio, src_channels, samples_per_channel, dst_channels,
+                    dst_audio);
+    return;
+  } else if (src_channels > 1 && dst_channels == 1) {
     DownmixInterleavedToMono(src_audio, samples_per_channel, src_channels,
                              dst_audio);
     return;
@@ -139,7 +247,14 @@ void AudioFrameOperations::DownmixChannels(size_t dst_channels,
                                            AudioFrame* frame) {
   RTC_DCHECK_LE(frame->samples_per_channel_ * frame->num_channels_,
                 AudioFrame::kMaxDataSizeSamples);
-  if (frame->num_channels_ > 1 && dst_channels == 1) {
+  if (IsSurroundDownmix(frame->num_channels_, dst_channels)) {
+    if (!frame->muted()) {
+      DownmixSurround(frame->data(), frame->num_channels_,
+                      frame->samples_per_channel_, dst_channels,
+                      frame->mutable_data());
+    }
+    frame->num_channels_ = dst_channels;
+  } else if (frame->num_channels_ > 1 && dst_channels == 1) {
     if (!frame->muted()) {
       DownmixInterleavedToMono(frame->data(), frame->samples_per_channel_,
                                frame->num_channels_, frame->mutable_data());
@@ -179,6 +294,26 @@ void AudioFrameOperations::UpmixChannels(size_t target_number_of_channels,
   frame->num_channels_ = target_number_of_channels;
 }
 
+AudioFrame::SampleLevels AudioFrameOperations::ComputeSampleLevels(
+    const AudioFrame& frame) {
+  AudioFrame::SampleLevels levels;
+  if (frame.muted()) {
+    return levels;
+  }
+  const int16_t* frame_data = frame.data();
+  int abs_max = 0;
+  float sum_square = 0.f;
+  for (size_t i = 0; i < frame.samples_per_channel_ * frame.num_channels_;
+       ++i) {
+    const int sample = frame_data[i];
+    abs_max = std::max(abs_max, std::abs(sample));
+    sum_square += sample * sample;
+  }
+  levels.abs_max = static_cast<int16_t>(std::min(abs_max, 32767));
+  levels.sum_square = sum_square;
+  return levels;
+}
+
 void AudioFrameOperations::SwapStereoChannels(AudioFrame* frame) {
   RTC_DCHECK(frame);
   if (frame->num_channels_ != 2 || frame->muted()) {
@@ -57,7 +57,9 @@ class AudioFrameOperations {
   // Downmixes |src_channels| |src_audio| to |dst_channels| |dst_audio|.
   // This is an in-place operation, meaning |src_audio| and |dst_audio|
   // may point to the same buffer. Supported channel combinations are
-  // Stereo to Mono, Quad to Mono, and Quad to Stereo.
+  // N channels to Mono, Quad to Stereo, and 5.1 or 7.1 to Stereo. 5.1 and 7.1
+  // are mixed with the weights ChannelMixer uses for CHANNEL_LAYOUT_5_1 and
+  // CHANNEL_LAYOUT_7_1, and to Mono as the average of that stereo mix.
   static void DownmixChannels(const int16_t* src_audio,
                               size_t src_channels,
                               size_t samples_per_channel,
@@ -66,7 +68,7 @@ class AudioFrameOperations {
 
   // |frame.num_channels_| will be updated. This version checks that
   // |num_channels_| and |dst_channels| are valid and performs relevant downmix.
-  // Supported channel combinations are N channels to Mono, and Quad to Stereo.
+  // Supported channel combinations are the same as above.
   static void DownmixChannels(size_t dst_channels, AudioFrame* frame);
 
   // |frame.num_channels_| will be updated. This version checks that
@@ -76,6 +78,11 @@ class AudioFrameOperations {
   static void UpmixChannels(size_t target_number_of_channels,
                             AudioFrame* frame);
 
+  // Computes the levels of the samples of |frame| in one pass, for
+  // AudioFrame::set_sample_levels(). The sum of squares is accumulated like in
+  // RmsLevel::Analyze(), so that it can be used in its place.
+  static AudioFrame::SampleLevels ComputeSampleLevels(const AudioFrame& frame);
+
   // Swap the left and right channels of |frame|. Fails silently if |frame| is
   // not stereo.
   static void SwapStereoChannels(AudioFrame* frame);
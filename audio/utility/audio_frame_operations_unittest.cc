@@ -10,6 +10,7 @@
 
 #include "audio/utility/audio_frame_operations.h"
 
+#include "audio/utility/channel_mixer.h"
 #include "rtc_base/checks.h"
 #include "test/gtest.h"
 
@@ -298,6 +299,109 @@ TEST_F(AudioFrameOperationsTest, QuadToStereoDoesNotWrapAround) {
   VerifyFramesAreEqual(stereo_frame, frame_);
 }
 
+TEST_F(AudioFrameOperationsTest, QuadToStereoMatchesScalarDownmix) {
+  // Not a multiple of the vector size, so that there is a tail of frames.
+  frame_.samples_per_channel_ = 317;
+  frame_.num_channels_ = 4;
+  int16_t* frame_data = frame_.mutable_data();
+  for (size_t i = 0; i < frame_.samples_per_channel_ * 4; ++i)
+    frame_data[i] = static_cast<int16_t>(i * 211 - 32000);
+
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = frame_.samples_per_channel_;
+  stereo_frame.num_channels_ = 2;
+  int16_t* stereo_data = stereo_frame.mutable_data();
+  for (size_t i = 0; i < frame_.samples_per_channel_ * 2; ++i) {
+    stereo_data[i] = (static_cast<int32_t>(frame_data[2 * i]) +
+                      frame_data[2 * i + 1]) >>
+                     1;
+  }
+
+  EXPECT_EQ(0, AudioFrameOperations::QuadToStereo(&frame_));
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+// Fills each channel of |frame| with a different, alternating signal.
+void SetSurroundFrameData(size_t num_channels, AudioFrame* frame) {
+  frame->num_channels_ = num_channels;
+  int16_t* frame_data = frame->mutable_data();
+  for (size_t i = 0; i < frame->samples_per_channel_; ++i) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      const int16_t value = static_cast<int16_t>(1000 * (ch + 1) + i);
+      frame_data[i * num_channels + ch] = i % 2 == 0 ? value : -value;
+    }
+  }
+}
+
+void VerifySurroundToStereoMatchesChannelMixer(size_t num_channels,
+                                               ChannelLayout layout) {
+  AudioFrame frame;
+  frame.samples_per_channel_ = 320;
+  SetSurroundFrameData(num_channels, &frame);
+  AudioFrame mixer_frame;
+  mixer_frame.CopyFrom(frame);
+  mixer_frame.channel_layout_ = layout;
+  ChannelMixer mixer(layout, CHANNEL_LAYOUT_STEREO);
+  mixer.Transform(&mixer_frame);
+
+  AudioFrameOperations::DownmixChannels(2, &frame);
+  EXPECT_EQ(2u, frame.num_channels_);
+  // The fixed-point weights may round differently.
+  for (size_t i = 0; i < frame.samples_per_channel_ * 2; ++i)
+    EXPECT_NEAR(mixer_frame.data()[i], frame.data()[i], 1);
+}
+
+TEST_F(AudioFrameOperationsTest, FiveOneToStereoMatchesChannelMixer) {
+  VerifySurroundToStereoMatchesChannelMixer(6, CHANNEL_LAYOUT_5_1);
+}
+
+TEST_F(AudioFrameOperationsTest, SevenOneToStereoMatchesChannelMixer) {
+  VerifySurroundToStereoMatchesChannelMixer(8, CHANNEL_LAYOUT_7_1);
+}
+
+TEST_F(AudioFrameOperationsTest, SurroundToMonoIsAverageOfStereoDownmix) {
+  for (size_t num_channels : {6, 8}) {
+    SetSurroundFrameData(num_channels, &frame_);
+    AudioFrame stereo_frame;
+    stereo_frame.CopyFrom(frame_);
+    AudioFrameOperations::DownmixChannels(2, &stereo_frame);
+
+    AudioFrame mono_frame;
+    mono_frame.samples_per_channel_ = frame_.samples_per_channel_;
+    mono_frame.num_channels_ = 1;
+    AudioFrameOperations::DownmixChannels(frame_.data(), num_channels,
+                                          frame_.samples_per_channel_, 1,
+                                          mono_frame.mutable_data());
+    for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+      const int average = (stereo_frame.data()[2 * i] +
+                           stereo_frame.data()[2 * i + 1]) / 2;
+      EXPECT_NEAR(average, mono_frame.data()[i], 1);
+    }
+  }
+}
+
+TEST_F(AudioFrameOperationsTest, SurroundToStereoSaturates) {
+  for (size_t num_channels : {6, 8}) {
+    frame_.num_channels_ = num_channels;
+    SetFrameData(-32768, &frame_);
+    AudioFrameOperations::DownmixChannels(2, &frame_);
+
+    AudioFrame stereo_frame;
+    stereo_frame.samples_per_channel_ = frame_.samples_per_channel_;
+    stereo_frame.num_channels_ = 2;
+    SetFrameData(-32768, &stereo_frame);
+    VerifyFramesAreEqual(stereo_frame, frame_);
+  }
+}
+
+TEST_F(AudioFrameOperationsTest, SurroundToStereoMuted) {
+  frame_.num_channels_ = 8;
+  ASSERT_TRUE(frame_.muted());
+  AudioFrameOperations::DownmixChannels(2, &frame_);
+  EXPECT_EQ(2u, frame_.num_channels_);
+  EXPECT_TRUE(frame_.muted());
+}
+
 TEST_F(AudioFrameOperationsTest, SwapStereoChannelsSucceedsOnStereo) {
   SetFrameData(0, 1, &frame_);
 
@@ -616,5 +720,26 @@ TEST_F(AudioFrameOperationsTest, AddingTwoFramesProducesTheirSum) {
   VerifyFramesAreEqual(frame_, frame_to_add_to);
 }
 
+TEST_F(AudioFrameOperationsTest, ComputeSampleLevels) {
+  SetFrameData(-32768, 1000, &frame_);
+  AudioFrame::SampleLevels levels =
+      AudioFrameOperations::ComputeSampleLevels(frame_);
+  EXPECT_EQ(32767, levels.abs_max);
+  float sum_square = 0.f;
+  for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+    sum_square += -32768 * -32768;
+    sum_square += 1000 * 1000;
+  }
+  EXPECT_EQ(sum_square, levels.sum_square);
+}
+
+TEST_F(AudioFrameOperationsTest, ComputeSampleLevelsMuted) {
+  ASSERT_TRUE(frame_.muted());
+  AudioFrame::SampleLevels levels =
+      AudioFrameOperations::ComputeSampleLevels(frame_);
+  EXPECT_EQ(0, levels.abs_max);
+  EXPECT_EQ(0.f, levels.sum_square);
+}
+
 }  // namespace
 }  // namespace webrtc
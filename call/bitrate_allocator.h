@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/call/bitrate_allocation.h"
 #include "api/transport/network_types.h"
 #include "rtc_base/synchronization/sequence_checker.h"
@@ -86,6 +87,8 @@ struct AllocatableTrack {
   MediaStreamAllocationConfig config;
   int64_t allocated_bitrate_bps;
   double media_ratio;  // Part of the total bitrate used for media [0.0, 1.0].
+  // The update last passed to |observer|, unset when reconfigured.
+  absl::optional<BitrateAllocationUpdate> last_update;
 
   uint32_t LastAllocatedBitrate() const;
   // The minimum bitrate required by this observer, including
@@ -149,6 +152,7 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   static uint8_t GetTransmissionMaxBitrateMultiplier();
 
   SequenceChecker sequenced_checker_;
+  const bool skip_unchanged_updates_;
   LimitObserver* const limit_observer_ RTC_GUARDED_BY(&sequenced_checker_);
   // Stored in a list to keep track of the insertion order.
   std::vector<AllocatableTrack> allocatable_tracks_
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "system_wrappers/include/clock.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -64,6 +65,7 @@ class TestBitrateObserver : public BitrateAllocatorObserver {
   }
 
   uint32_t OnBitrateUpdated(BitrateAllocationUpdate update) override {
+    ++num_updates_;
     last_bitrate_bps_ = update.target_bitrate.bps();
     last_fraction_loss_ =
         rtc::dchecked_cast<uint8_t>(update.packet_loss_ratio * 256);
@@ -76,6 +78,7 @@ class TestBitrateObserver : public BitrateAllocatorObserver {
   int64_t last_rtt_ms_;
   int last_probing_interval_ms_;
   double protection_ratio_;
+  int num_updates_ = 0;
 };
 
 constexpr int64_t kDefaultProbingIntervalMs = 3000;
@@ -1030,4 +1033,44 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+TEST(BitrateAllocatorSkipUnchangedUpdatesTest,
+     OnlyUpdatesObserversWithChangedAllocation) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Bwe-SkipUnchangedAllocations/Enabled/");
+  NiceMock<MockLimitObserver> limit_observer;
+  BitrateAllocator allocator(&limit_observer);
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1000000, 0, 0, kDefaultProbingIntervalMs));
+  TestBitrateObserver observer_low;
+  TestBitrateObserver observer_high;
+  allocator.AddObserver(&observer_low, {10000, 100000, 0, 0, false, 1.0});
+  allocator.AddObserver(&observer_high, {10000, 2000000, 0, 0, false, 1.0});
+  EXPECT_EQ(100000u, observer_low.last_bitrate_bps_);
+  EXPECT_EQ(900000u, observer_high.last_bitrate_bps_);
+  const int low_updates = observer_low.num_updates_;
+  const int high_updates = observer_high.num_updates_;
+
+  // Only the observer that is not at its max bitrate gets more.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1200000, 0, 0, kDefaultProbingIntervalMs));
+  EXPECT_EQ(low_updates, observer_low.num_updates_);
+  EXPECT_EQ(high_updates + 1, observer_high.num_updates_);
+  EXPECT_EQ(1100000u, observer_high.last_bitrate_bps_);
+
+  // A new round trip time is passed to all observers.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(1200000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(low_updates + 1, observer_low.num_updates_);
+  EXPECT_EQ(high_updates + 2, observer_high.num_updates_);
+  EXPECT_EQ(50, observer_low.last_rtt_ms_);
+
+  // A reconfigured observer is always updated.
+  allocator.AddObserver(&observer_low, {10000, 100000, 0, 0, false, 2.0});
+  EXPECT_EQ(low_updates + 2, observer_low.num_updates_);
+  EXPECT_EQ(high_updates + 2, observer_high.num_updates_);
+
+  allocator.RemoveObserver(&observer_low);
+  allocator.RemoveObserver(&observer_high);
+}
+
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -59,6 +60,7 @@
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "video/call_stats.h"
+#include "video/decode_thread_pool.h"
 #include "video/send_delay_stats.h"
 #include "video/stats_counter.h"
 #include "video/video_receive_stream.h"
@@ -67,6 +69,10 @@
 namespace webrtc {
 
 namespace {
+// Rendering a frame is mostly handing it to a sink, so a couple of threads are
+// enough to meet the render times of many streams.
+constexpr int kNumVideoRenderThreads = 2;
+
 bool SendPeriodicFeedback(const std::vector<RtpExtension>& extensions) {
   for (const auto& extension : extensions) {
     if (extension.uri == RtpExtension::kTransportSequenceNumberV2Uri)
@@ -244,8 +250,8 @@ class Call final : public webrtc::Call,
       RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
   void NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                 MediaType media_type)
-      RTC_SHARED_LOCKS_REQUIRED(receive_crit_);
+                                 MediaType media_type,
+                                 bool use_send_side_bwe);
 
   void UpdateSendHistograms(Timestamp first_sent_packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&bitrate_crit_);
@@ -263,6 +269,14 @@ class Call final : public webrtc::Call,
   TaskQueueFactory* const task_queue_factory_;
 
   const int num_cpu_cores_;
+  // Runs the decoding of all video receive streams, instead of a thread per
+  // stream. Created with the first stream, if enabled by field trial.
+  std::unique_ptr<DecodeThreadPool> decode_thread_pool_
+      RTC_GUARDED_BY(configuration_sequence_checker_);
+  // Runs the render smoothing of all video receive streams. Created with the
+  // first stream, if enabled by field trial.
+  std::unique_ptr<DecodeThreadPool> render_thread_pool_
+      RTC_GUARDED_BY(configuration_sequence_checker_);
   const std::unique_ptr<ProcessThread> module_process_thread_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
@@ -316,8 +330,11 @@ class Call final : public webrtc::Call,
     // send side BWE are negotiated.
     const bool use_send_side_bwe;
   };
-  std::map<uint32_t, ReceiveRtpConfig> receive_rtp_config_
-      RTC_GUARDED_BY(receive_crit_);
+  // Only used on the sequence that delivers the packets and creates and
+  // destroys the receive streams, so the packet path looks up the config
+  // without taking |receive_crit_|.
+  std::unordered_map<uint32_t, ReceiveRtpConfig> receive_rtp_config_
+      RTC_GUARDED_BY(configuration_sequence_checker_);
 
   std::unique_ptr<RWLockWrapper> send_crit_;
   // Audio and Video send streams are owned by the client that creates them.
@@ -683,8 +700,9 @@ webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
   event_log_->Log(std::make_unique<RtcEventAudioReceiveStreamConfig>(
       CreateRtcLogStreamConfig(config)));
   AudioReceiveStream* receive_stream = new AudioReceiveStream(
-      clock_, &audio_receiver_controller_, transport_send_ptr_->packet_router(),
-      module_process_thread_.get(), config, config_.audio_state, event_log_);
+      clock_, task_queue_factory_, &audio_receiver_controller_,
+      transport_send_ptr_->packet_router(), module_process_thread_.get(),
+      config, config_.audio_state, event_log_);
   {
     WriteLockScoped write_lock(*receive_crit_);
     receive_rtp_config_.emplace(config.rtp.remote_ssrc,
@@ -835,10 +853,21 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
 
   RegisterRateObserver();
 
+  if (!decode_thread_pool_ &&
+      field_trial::IsEnabled("WebRTC-Video-SharedDecodeThreads")) {
+    decode_thread_pool_ = std::make_unique<DecodeThreadPool>(num_cpu_cores_);
+  }
+  if (!render_thread_pool_ &&
+      field_trial::IsEnabled("WebRTC-Video-SharedRenderThreads")) {
+    render_thread_pool_ = std::make_unique<DecodeThreadPool>(
+        kNumVideoRenderThreads, "RenderThread");
+  }
+
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
       task_queue_factory_, &video_receiver_controller_, num_cpu_cores_,
       transport_send_ptr_->packet_router(), std::move(configuration),
-      module_process_thread_.get(), call_stats_.get(), clock_);
+      module_process_thread_.get(), call_stats_.get(), clock_,
+      decode_thread_pool_.get(), render_thread_pool_.get());
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
@@ -1217,6 +1246,7 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
                                                 rtc::CopyOnWriteBuffer packet,
                                                 int64_t packet_time_us) {
   TRACE_EVENT0("webrtc", "Call::DeliverRtp");
+  RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
 
   RtpPacketReceived parsed_packet;
   if (!parsed_packet.Parse(std::move(packet)))
@@ -1242,23 +1272,21 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   RTC_DCHECK(media_type == MediaType::AUDIO || media_type == MediaType::VIDEO ||
              is_keep_alive_packet);
 
-  ReadLockScoped read_lock(*receive_crit_);
   auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
   if (it == receive_rtp_config_.end()) {
     RTC_LOG(LS_ERROR) << "receive_rtp_config_ lookup failed for ssrc "
                       << parsed_packet.Ssrc();
-    // Destruction of the receive stream, including deregistering from the
-    // RtpDemuxer, is not protected by the |receive_crit_| lock. But
-    // deregistering in the |receive_rtp_config_| map is protected by that lock.
-    // So by not passing the packet on to demuxing in this case, we prevent
-    // incoming packets to be passed on via the demuxer to a receive stream
-    // which is being torned down.
+    // The receive stream is removed from |receive_rtp_config_| before it is
+    // torn down, on this sequence. So by not passing the packet on to
+    // demuxing in this case, we prevent incoming packets to be passed on via
+    // the demuxer to a receive stream which is being torn down.
     return DELIVERY_UNKNOWN_SSRC;
   }
 
   parsed_packet.IdentifyExtensions(it->second.extensions);
 
-  NotifyBweOfReceivedPacket(parsed_packet, media_type);
+  NotifyBweOfReceivedPacket(parsed_packet, media_type,
+                            it->second.use_send_side_bwe);
 
   // RateCounters expect input parameter as int, save it as int,
   // instead of converting each time it is passed to RateCounter::Add below.
@@ -1306,23 +1334,20 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
 }
 
 void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
+  // Called by the FlexfecReceiveStream while it handles a packet from
+  // DeliverRtp().
+  RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
   RtpPacketReceived parsed_packet;
   if (!parsed_packet.Parse(packet, length))
     return;
 
   parsed_packet.set_recovered(true);
 
-  ReadLockScoped read_lock(*receive_crit_);
   auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
   if (it == receive_rtp_config_.end()) {
     RTC_LOG(LS_ERROR) << "receive_rtp_config_ lookup failed for ssrc "
                       << parsed_packet.Ssrc();
-    // Destruction of the receive stream, including deregistering from the
-    // RtpDemuxer, is not protected by the |receive_crit_| lock. But
-    // deregistering in the |receive_rtp_config_| map is protected by that lock.
-    // So by not passing the packet on to demuxing in this case, we prevent
-    // incoming packets to be passed on via the demuxer to a receive stream
-    // which is being torn down.
+    // See DeliverRtp().
     return;
   }
   parsed_packet.IdentifyExtensions(it->second.extensions);
@@ -1333,11 +1358,8 @@ void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
 }
 
 void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                     MediaType media_type) {
-  auto it = receive_rtp_config_.find(packet.Ssrc());
-  bool use_send_side_bwe =
-      (it != receive_rtp_config_.end()) && it->second.use_send_side_bwe;
-
+                                     MediaType media_type,
+                                     bool use_send_side_bwe) {
   RTPHeader header;
   packet.GetHeader(&header);
 
@@ -10,6 +10,8 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <string.h>
+
 #include "call/rtp_packet_sink_interface.h"
 #include "call/rtp_rtcp_demuxer_helper.h"
 #include "call/ssrc_binding_observer.h"
@@ -20,6 +22,27 @@
 #include "rtc_base/strings/string_builder.h"
 
 namespace webrtc {
+namespace {
+
+// Returns the value of a string header extension with the same rules as
+// BaseRtpStringExtension::Parse, without copying it. Returns an empty view if
+// the extension is absent or malformed.
+template <typename Extension>
+rtc::ArrayView<const uint8_t> GetStringExtensionView(
+    const RtpPacketReceived& packet) {
+  rtc::ArrayView<const uint8_t> data = packet.GetRawExtension<Extension>();
+  if (data.empty() || data[0] == 0)
+    return rtc::ArrayView<const uint8_t>();
+  return data.subview(
+      0, strnlen(reinterpret_cast<const char*>(data.data()), data.size()));
+}
+
+bool StringEquals(rtc::ArrayView<const uint8_t> view, const std::string& str) {
+  return view.size() == str.size() &&
+         memcmp(view.data(), str.data(), view.size()) == 0;
+}
+
+}  // namespace
 
 RtpDemuxerCriteria::RtpDemuxerCriteria() = default;
 RtpDemuxerCriteria::~RtpDemuxerCriteria() = default;
@@ -91,6 +114,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  resolved_sink_cache_.Clear();
 
   return true;
 }
@@ -168,11 +192,21 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  resolved_sink_cache_.Clear();
   return num_removed > 0;
 }
 
+void RtpDemuxer::set_use_mid(bool use_mid) {
+  use_mid_ = use_mid;
+  resolved_sink_cache_.Clear();
+}
+
 bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
-  RtpPacketSinkInterface* sink = ResolveSink(packet);
+  RtpPacketSinkInterface* sink = LookupCachedSink(packet);
+  if (sink == nullptr) {
+    sink = ResolveSink(packet);
+    UpdateCachedSink(packet.Ssrc(), sink);
+  }
   if (sink != nullptr) {
     sink->OnRtpPacket(packet);
     return true;
@@ -180,6 +214,48 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
   return false;
 }
 
+RtpPacketSinkInterface* RtpDemuxer::LookupCachedSink(
+    const RtpPacketReceived& packet) {
+  const ResolvedSinkCache::Entry* entry =
+      resolved_sink_cache_.Find(packet.Ssrc());
+  if (entry == nullptr || entry->sink == nullptr) {
+    return nullptr;
+  }
+  // A packet without MID or RSID is resolved with the latched values, which
+  // are the ones the cached entry was resolved with.
+  if (use_mid_) {
+    rtc::ArrayView<const uint8_t> mid = GetStringExtensionView<RtpMid>(packet);
+    if (!mid.empty() && !StringEquals(mid, entry->mid)) {
+      return nullptr;
+    }
+  }
+  rtc::ArrayView<const uint8_t> rsid =
+      GetStringExtensionView<RepairedRtpStreamId>(packet);
+  if (rsid.empty()) {
+    rsid = GetStringExtensionView<RtpStreamId>(packet);
+  }
+  if (!rsid.empty() && !StringEquals(rsid, entry->rsid)) {
+    return nullptr;
+  }
+  return entry->sink;
+}
+
+void RtpDemuxer::UpdateCachedSink(uint32_t ssrc, RtpPacketSinkInterface* sink) {
+  // Only streams whose SSRC ended up bound to the sink resolve the same way
+  // for every following packet; anything else keeps using ResolveSink.
+  const auto binding = sink_by_ssrc_.find(ssrc);
+  if (sink == nullptr || binding == sink_by_ssrc_.end() ||
+      binding->second != sink) {
+    resolved_sink_cache_.Invalidate(ssrc);
+    return;
+  }
+  const auto mid = mid_by_ssrc_.find(ssrc);
+  const auto rsid = rsid_by_ssrc_.find(ssrc);
+  resolved_sink_cache_.Set(
+      ssrc, sink, mid != mid_by_ssrc_.end() ? mid->second : std::string(),
+      rsid != rsid_by_ssrc_.end() ? rsid->second : std::string());
+}
+
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
   // See the BUNDLE spec for high level reference to this algorithm:
@@ -379,6 +455,82 @@ bool RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
   return false;
 }
 
+RtpDemuxer::ResolvedSinkCache::ResolvedSinkCache() = default;
+RtpDemuxer::ResolvedSinkCache::~ResolvedSinkCache() = default;
+
+const RtpDemuxer::ResolvedSinkCache::Entry*
+RtpDemuxer::ResolvedSinkCache::Find(uint32_t ssrc) const {
+  if (entries_.empty()) {
+    return nullptr;
+  }
+  const Entry& entry = entries_[FindSlot(ssrc)];
+  return entry.in_use ? &entry : nullptr;
+}
+
+void RtpDemuxer::ResolvedSinkCache::Set(uint32_t ssrc,
+                                        RtpPacketSinkInterface* sink,
+                                        const std::string& mid,
+                                        const std::string& rsid) {
+  if (entries_.empty() || 2 * (size_ + 1) > entries_.size()) {
+    if (size_ >= static_cast<size_t>(kMaxSsrcBindings) && !Find(ssrc)) {
+      return;
+    }
+    Grow();
+  }
+  Entry& entry = entries_[FindSlot(ssrc)];
+  if (!entry.in_use) {
+    entry.in_use = true;
+    entry.ssrc = ssrc;
+    ++size_;
+  }
+  entry.sink = sink;
+  entry.mid = mid;
+  entry.rsid = rsid;
+}
+
+void RtpDemuxer::ResolvedSinkCache::Invalidate(uint32_t ssrc) {
+  if (entries_.empty()) {
+    return;
+  }
+  Entry& entry = entries_[FindSlot(ssrc)];
+  if (entry.in_use) {
+    entry.sink = nullptr;
+  }
+}
+
+void RtpDemuxer::ResolvedSinkCache::Clear() {
+  if (size_ == 0) {
+    return;
+  }
+  for (Entry& entry : entries_) {
+    entry.in_use = false;
+    entry.sink = nullptr;
+  }
+  size_ = 0;
+}
+
+size_t RtpDemuxer::ResolvedSinkCache::FindSlot(uint32_t ssrc) const {
+  RTC_DCHECK(!entries_.empty());
+  const size_t mask = entries_.size() - 1;
+  // Fibonacci hashing spreads sequential SSRCs across the table.
+  size_t slot = (ssrc * 2654435769u) >> 8 & mask;
+  while (entries_[slot].in_use && entries_[slot].ssrc != ssrc) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void RtpDemuxer::ResolvedSinkCache::Grow() {
+  std::vector<Entry> old_entries = std::move(entries_);
+  entries_ = std::vector<Entry>(old_entries.empty() ? 16
+                                                    : 2 * old_entries.size());
+  for (Entry& old_entry : old_entries) {
+    if (old_entry.in_use) {
+      entries_[FindSlot(old_entry.ssrc)] = std::move(old_entry);
+    }
+  }
+}
+
 void RtpDemuxer::RegisterSsrcBindingObserver(SsrcBindingObserver* observer) {
   RTC_DCHECK(observer);
   RTC_DCHECK(!ContainerHasKey(ssrc_binding_observers_, observer));
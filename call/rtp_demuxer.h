@@ -143,9 +143,55 @@ class RtpDemuxer {
 
   // Configure whether to look at the MID header extension when demuxing
   // incoming RTP packets. By default this is enabled.
-  void set_use_mid(bool use_mid) { use_mid_ = use_mid; }
+  void set_use_mid(bool use_mid);
 
  private:
+  // Open-addressing hash table, keyed on SSRC, that remembers the sink a
+  // stream was resolved to together with the MID and RSID used for that
+  // resolution. Packets of an established stream are then routed with one
+  // probe instead of walking the string-keyed maps. Entries are invalidated
+  // rather than erased, and the whole table is cleared whenever the sink
+  // configuration changes.
+  class ResolvedSinkCache {
+   public:
+    struct Entry {
+      uint32_t ssrc = 0;
+      bool in_use = false;
+      // Null if the entry has been invalidated.
+      RtpPacketSinkInterface* sink = nullptr;
+      std::string mid;
+      std::string rsid;
+    };
+
+    ResolvedSinkCache();
+    ~ResolvedSinkCache();
+
+    // Returns the entry for |ssrc|, or null if there is none.
+    const Entry* Find(uint32_t ssrc) const;
+    // Inserts or updates the entry for |ssrc|. Entries are dropped silently
+    // once kMaxSsrcBindings SSRCs are cached.
+    void Set(uint32_t ssrc,
+             RtpPacketSinkInterface* sink,
+             const std::string& mid,
+             const std::string& rsid);
+    void Invalidate(uint32_t ssrc);
+    void Clear();
+
+   private:
+    size_t FindSlot(uint32_t ssrc) const;
+    void Grow();
+
+    // Size is zero or a power of two, and at most half of the slots are used.
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+  };
+
+  // Returns the cached sink for the packet's SSRC if the MID and RSID carried
+  // by the packet, if any, match the ones the cached resolution used.
+  RtpPacketSinkInterface* LookupCachedSink(const RtpPacketReceived& packet);
+  // Records the result of running ResolveSink on a packet.
+  void UpdateCachedSink(uint32_t ssrc, RtpPacketSinkInterface* sink);
+
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
@@ -206,6 +252,8 @@ class RtpDemuxer {
   // resolved by this object.
   std::vector<SsrcBindingObserver*> ssrc_binding_observers_;
 
+  ResolvedSinkCache resolved_sink_cache_;
+
   bool use_mid_ = true;
 };
 
@@ -1458,6 +1458,71 @@ TEST_F(RtpDemuxerTest,
   demuxer_.OnRtpPacket(*packet);
 }
 
+TEST_F(RtpDemuxerTest, CachedSsrcRoutingFollowsMidChange) {
+  constexpr uint32_t ssrc = 101;
+  MockRtpPacketSink sink_a;
+  MockRtpPacketSink sink_b;
+  AddSinkOnlyMid("a", &sink_a);
+  AddSinkOnlyMid("b", &sink_b);
+
+  InSequence sequence;
+  EXPECT_CALL(sink_a, OnRtpPacket(_)).Times(2);
+  EXPECT_CALL(sink_b, OnRtpPacket(_)).Times(2);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "a")));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+  // The SSRC moves to another MID; the cached resolution must not be used.
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "b")));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+}
+
+TEST_F(RtpDemuxerTest, CachedSsrcRoutingDropsPacketWithUnknownMid) {
+  constexpr uint32_t ssrc = 101;
+  NiceMock<MockRtpPacketSink> sink;
+  AddSinkOnlyMid("a", &sink);
+
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "a")));
+  EXPECT_FALSE(demuxer_.OnRtpPacket(*CreatePacketWithSsrcMid(ssrc, "x")));
+}
+
+TEST_F(RtpDemuxerTest, CachedSsrcRoutingFollowsRsidChange) {
+  constexpr uint32_t ssrc = 101;
+  MockRtpPacketSink sink_a;
+  MockRtpPacketSink sink_b;
+  AddSinkBothMidRsid("m", "a", &sink_a);
+  AddSinkBothMidRsid("m", "b", &sink_b);
+
+  InSequence sequence;
+  EXPECT_CALL(sink_a, OnRtpPacket(_)).Times(2);
+  EXPECT_CALL(sink_b, OnRtpPacket(_)).Times(1);
+  EXPECT_TRUE(
+      demuxer_.OnRtpPacket(*CreatePacketWithSsrcMidRsid(ssrc, "m", "a")));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+  EXPECT_TRUE(
+      demuxer_.OnRtpPacket(*CreatePacketWithSsrcMidRsid(ssrc, "m", "b")));
+}
+
+TEST_F(RtpDemuxerTest, CachedSsrcRoutingUpdatedWhenSinkAdded) {
+  constexpr uint32_t ssrc = 101;
+  MockRtpPacketSink payload_type_sink;
+  MockRtpPacketSink ssrc_sink;
+  RtpDemuxerCriteria criteria;
+  criteria.payload_types = {30};
+  AddSink(criteria, &payload_type_sink);
+
+  auto packet = CreatePacketWithSsrc(ssrc);
+  packet->SetPayloadType(30);
+  EXPECT_CALL(payload_type_sink, OnRtpPacket(_)).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+
+  // Removing the sink that the SSRC was latched to must drop the cached route.
+  RemoveSink(&payload_type_sink);
+  EXPECT_FALSE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+
+  AddSinkOnlySsrc(ssrc, &ssrc_sink);
+  EXPECT_CALL(ssrc_sink, OnRtpPacket(_)).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(ssrc)));
+}
+
 TEST_F(RtpDemuxerTest, MaliciousPeerCannotCauseMemoryOveruse) {
   const std::string mid = "v";
 
@@ -11,6 +11,7 @@
 #include "call/rtp_video_sender.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +31,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread_types.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
@@ -50,6 +52,10 @@ RtpStreamSender::~RtpStreamSender() = default;
 
 namespace {
 static const int kMinSendSidePacketHistorySize = 600;
+// Field trial which hands the packets of all simulcast layers of a frame to
+// the pacer at once, see RtpVideoSender::OnSuperframeStarted().
+const char kBatchSuperframePacketsFieldTrial[] =
+    "WebRTC-Video-BatchSuperframePackets";
 // We don't do MTU discovery, so assume that we have the standard ethernet MTU.
 static const size_t kPathMTU = 1500;
 
@@ -125,6 +131,7 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
     Transport* send_transport,
     RtcpBandwidthObserver* bandwidth_callback,
     RtpTransportControllerSendInterface* transport,
+    RtpPacketSender* packet_sender,
     FlexfecSender* flexfec_sender,
     RtcEventLog* event_log,
     RateLimiter* retransmission_rate_limiter,
@@ -149,7 +156,7 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
   configuration.rtt_stats = observers.rtcp_rtt_stats;
   configuration.rtcp_packet_type_counter_observer =
       observers.rtcp_type_observer;
-  configuration.paced_sender = transport->packet_sender();
+  configuration.paced_sender = packet_sender;
   configuration.send_bitrate_observer = observers.bitrate_observer;
   configuration.send_side_delay_observer = observers.send_delay_observer;
   configuration.send_packet_observer = observers.send_packet_observer;
@@ -293,6 +300,57 @@ absl::optional<VideoCodecType> GetVideoCodecType(const RtpConfig& config) {
 }
 }  // namespace
 
+// Holds the packets that are enqueued on the thread of an open superframe, and
+// hands them to |packet_sender_| in one call when it ends. Packets enqueued on
+// other threads are passed on right away.
+class RtpVideoSender::SuperframePacketSender : public RtpPacketSender {
+ public:
+  explicit SuperframePacketSender(RtpPacketSender* packet_sender)
+      : packet_sender_(packet_sender) {
+    RTC_DCHECK(packet_sender_);
+  }
+
+  void Start() {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(!started_);
+    started_ = true;
+    thread_ = rtc::CurrentThreadRef();
+  }
+
+  void End() {
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    {
+      rtc::CritScope lock(&crit_);
+      RTC_DCHECK(started_);
+      started_ = false;
+      packets.swap(packets_);
+    }
+    if (!packets.empty())
+      packet_sender_->EnqueuePackets(std::move(packets));
+  }
+
+  void EnqueuePackets(
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets) override {
+    {
+      rtc::CritScope lock(&crit_);
+      if (started_ && rtc::IsThreadRefEqual(thread_, rtc::CurrentThreadRef())) {
+        packets_.insert(packets_.end(),
+                        std::make_move_iterator(packets.begin()),
+                        std::make_move_iterator(packets.end()));
+        return;
+      }
+    }
+    packet_sender_->EnqueuePackets(std::move(packets));
+  }
+
+ private:
+  RtpPacketSender* const packet_sender_;
+  rtc::CriticalSection crit_;
+  bool started_ RTC_GUARDED_BY(crit_) = false;
+  rtc::PlatformThreadRef thread_ RTC_GUARDED_BY(crit_);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets_ RTC_GUARDED_BY(crit_);
+};
+
 RtpVideoSender::RtpVideoSender(
     Clock* clock,
     std::map<uint32_t, RtpState> suspended_ssrcs,
@@ -318,6 +376,11 @@ RtpVideoSender::RtpVideoSender(
       suspended_ssrcs_(std::move(suspended_ssrcs)),
       flexfec_sender_(
           MaybeCreateFlexfecSender(clock, rtp_config, suspended_ssrcs_)),
+      superframe_packet_sender_(
+          webrtc::field_trial::IsEnabled(kBatchSuperframePacketsFieldTrial)
+              ? std::make_unique<SuperframePacketSender>(
+                    transport->packet_sender())
+              : nullptr),
       fec_controller_(std::move(fec_controller)),
       fec_allowed_(true),
       rtp_streams_(CreateRtpStreamSenders(clock,
@@ -327,6 +390,9 @@ RtpVideoSender::RtpVideoSender(
                                           send_transport,
                                           transport->GetBandwidthObserver(),
                                           transport,
+                                          superframe_packet_sender_
+                                              ? superframe_packet_sender_.get()
+                                              : transport->packet_sender(),
                                           flexfec_sender_.get(),
                                           event_log,
                                           retransmission_limiter,
@@ -527,6 +593,16 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
   return Result(Result::OK, rtp_timestamp);
 }
 
+void RtpVideoSender::OnSuperframeStarted() {
+  if (superframe_packet_sender_)
+    superframe_packet_sender_->Start();
+}
+
+void RtpVideoSender::OnSuperframeEnded() {
+  if (superframe_packet_sender_)
+    superframe_packet_sender_->End();
+}
+
 void RtpVideoSender::OnBitrateAllocationUpdated(
     const VideoBitrateAllocation& bitrate) {
   rtc::CritScope lock(&crit_);
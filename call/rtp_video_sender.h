@@ -129,6 +129,13 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       const CodecSpecificInfo* codec_specific_info,
       const RTPFragmentationHeader* fragmentation) override;
 
+  // With the "WebRTC-Video-BatchSuperframePackets" field trial, the packets
+  // of all layers sent between these calls are handed to the pacer at once
+  // when the superframe ends. Packets sent on other threads in the meantime,
+  // e.g. retransmissions, are not held back.
+  void OnSuperframeStarted() override;
+  void OnSuperframeEnded() override;
+
   void OnBitrateAllocationUpdated(
       const VideoBitrateAllocation& bitrate) override;
 
@@ -153,6 +160,8 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       const std::vector<PacketFeedback>& packet_feedback_vector) override;
 
  private:
+  class SuperframePacketSender;
+
   void UpdateModuleSendingState() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
   void ConfigureProtection();
   void ConfigureSsrcs();
@@ -175,6 +184,9 @@ class RtpVideoSender : public RtpVideoSenderInterface,
   std::map<uint32_t, RtpState> suspended_ssrcs_;
 
   std::unique_ptr<FlexfecSender> flexfec_sender_;
+  // Null unless superframes are batched. Must outlive |rtp_streams_|, whose
+  // RTP modules send through it.
+  const std::unique_ptr<SuperframePacketSender> superframe_packet_sender_;
 
   const std::unique_ptr<FecController> fec_controller_;
   bool fec_allowed_ RTC_GUARDED_BY(crit_);
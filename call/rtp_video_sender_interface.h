@@ -48,6 +48,13 @@ class RtpVideoSenderInterface : public EncodedImageCallback,
 
   virtual void DeliverRtcp(const uint8_t* packet, size_t length) = 0;
 
+  // Called before and after the layers of one input frame, e.g. its simulcast
+  // encodings, are passed to OnEncodedImage() on the calling thread. The
+  // packets of all layers may be held until the superframe ends and then be
+  // handed to the pacer at once.
+  virtual void OnSuperframeStarted() = 0;
+  virtual void OnSuperframeEnded() = 0;
+
   virtual void OnBitrateAllocationUpdated(
       const VideoBitrateAllocation& bitrate) = 0;
   virtual void OnBitrateUpdated(BitrateAllocationUpdate update,
@@ -626,6 +626,67 @@ TEST(RtpVideoSenderTest, EarlyRetransmits) {
   ASSERT_TRUE(event.Wait(kTimeoutMs));
 }
 
+TEST(RtpVideoSenderTest, HoldsPacketsUntilSuperframeEnds) {
+  test::ScopedFieldTrials trials(
+      "WebRTC-Video-BatchSuperframePackets/Enabled/");
+  const int64_t kTimeoutMs = 500;
+  const int64_t kHoldTimeMs = 100;
+
+  RtpVideoSenderTestFixture test({kSsrc1, kSsrc2}, {kRtxSsrc1, kRtxSsrc2},
+                                 kPayloadType, {});
+  test.router()->SetActive(true);
+
+  const uint8_t kPayload[1] = {'a'};
+  EncodedImage encoded_image;
+  encoded_image.SetTimestamp(1);
+  encoded_image.capture_time_ms_ = 2;
+  encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+  encoded_image.SetEncodedData(
+      EncodedImageBuffer::Create(kPayload, sizeof(kPayload)));
+
+  CodecSpecificInfo codec_specific;
+  codec_specific.codecType = VideoCodecType::kVideoCodecGeneric;
+
+  rtc::CriticalSection crit;
+  std::vector<uint32_t> sent_ssrcs;
+  rtc::Event first_packet_sent;
+  rtc::Event all_packets_sent;
+  EXPECT_CALL(test.transport(), SendRtp)
+      .Times(2)
+      .WillRepeatedly(
+          [&](const uint8_t* packet, size_t length, const PacketOptions&) {
+            RtpPacket rtp_packet;
+            EXPECT_TRUE(rtp_packet.Parse(packet, length));
+            rtc::CritScope lock(&crit);
+            sent_ssrcs.push_back(rtp_packet.Ssrc());
+            first_packet_sent.Set();
+            if (sent_ssrcs.size() == 2)
+              all_packets_sent.Set();
+            return true;
+          });
+
+  test.router()->OnSuperframeStarted();
+  encoded_image.SetSpatialIndex(0);
+  EXPECT_EQ(test.router()
+                ->OnEncodedImage(encoded_image, &codec_specific, nullptr)
+                .error,
+            EncodedImageCallback::Result::OK);
+  test.clock().AdvanceTimeMilliseconds(33);
+  EXPECT_FALSE(first_packet_sent.Wait(kHoldTimeMs));
+
+  encoded_image.SetSpatialIndex(1);
+  EXPECT_EQ(test.router()
+                ->OnEncodedImage(encoded_image, &codec_specific, nullptr)
+                .error,
+            EncodedImageCallback::Result::OK);
+  test.router()->OnSuperframeEnded();
+  test.clock().AdvanceTimeMilliseconds(33);
+  ASSERT_TRUE(all_packets_sent.Wait(kTimeoutMs));
+
+  rtc::CritScope lock(&crit);
+  EXPECT_THAT(sent_ssrcs, ::testing::UnorderedElementsAre(kSsrc1, kSsrc2));
+}
+
 TEST(RtpVideoSenderTest, CanSetZeroBitrateWithOverhead) {
   test::ScopedFieldTrials trials("WebRTC-SendSideBwe-WithOverhead/Enabled/");
   RtpVideoSenderTestFixture test({kSsrc1}, {kRtxSsrc1}, kPayloadType, {});
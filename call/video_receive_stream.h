@@ -25,6 +25,7 @@
 #include "api/transport/media/media_transport_config.h"
 #include "api/transport/media/media_transport_interface.h"
 #include "api/transport/rtp/rtp_source.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -38,9 +39,23 @@ namespace webrtc {
 
 class RtpPacketSinkInterface;
 class VideoDecoderFactory;
+struct CodecSpecificInfo;
 
 class VideoReceiveStream {
  public:
+  // Receives the complete frames of the stream, in decoding order, before
+  // they are decoded. Used for relaying them to another stream with
+  // VideoSendStream::SendEncodedImage(), without decoding and re-encoding.
+  class EncodedFrameSink {
+   public:
+    virtual void OnEncodedFrame(
+        const EncodedImage& encoded_image,
+        const CodecSpecificInfo& codec_specific_info) = 0;
+
+   protected:
+    virtual ~EncodedFrameSink() = default;
+  };
+
   // TODO(mflodman) Move all these settings to VideoDecoder and move the
   // declaration to common_types.h.
   struct Decoder {
@@ -277,6 +292,15 @@ class VideoReceiveStream {
   virtual void SetFrameDecryptor(
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor) = 0;
 
+  // Sets the sink for the encoded frames, or stops delivering them if null.
+  // The sink is called on the decoding thread. The frames are decoded and
+  // rendered as usual.
+  virtual void SetEncodedFrameSink(EncodedFrameSink* sink) = 0;
+
+  // Requests a key frame from the remote sender, e.g. when the receiver of
+  // the relayed frames needs one.
+  virtual void GenerateKeyFrame() = 0;
+
  protected:
   virtual ~VideoReceiveStream() {}
 };
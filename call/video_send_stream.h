@@ -22,6 +22,7 @@
 #include "api/crypto/crypto_options.h"
 #include "api/rtp_parameters.h"
 #include "api/transport/media/media_transport_interface.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -37,9 +38,20 @@
 namespace webrtc {
 
 class FrameEncryptorInterface;
+struct CodecSpecificInfo;
 
 class VideoSendStream {
  public:
+  // Notified when a remote receiver requests a key frame, so that it can be
+  // requested from the source of the frames given to SendEncodedImage().
+  class KeyFrameRequestObserver {
+   public:
+    virtual void OnKeyFrameRequested() = 0;
+
+   protected:
+    virtual ~KeyFrameRequestObserver() = default;
+  };
+
   struct StreamStats {
     StreamStats();
     ~StreamStats();
@@ -166,6 +178,9 @@ class VideoSendStream {
     // Per PeerConnection cryptography options.
     CryptoOptions crypto_options;
 
+    // Notified of key frame requests, in addition to the encoder.
+    KeyFrameRequestObserver* key_frame_request_observer = nullptr;
+
    private:
     // Access to the copy constructor is private to force use of the Copy()
     // method for those exceptional cases where we do use it.
@@ -200,6 +215,14 @@ class VideoSendStream {
 
   virtual Stats GetStats() = 0;
 
+  // Sends an already encoded frame, e.g. one relayed from a
+  // VideoReceiveStream::EncodedFrameSink, instead of encoding frames from a
+  // source. The frames must be of the configured codec. May be called on any
+  // thread, but not while the stream is being destroyed.
+  virtual void SendEncodedImage(
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo& codec_specific_info) = 0;
+
  protected:
   virtual ~VideoSendStream() {}
 };
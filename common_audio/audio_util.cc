@@ -10,8 +10,68 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 
+namespace {
+
+// Averages each pair of adjacent samples of |interleaved|. Like the generic
+// downmix, the average is rounded toward zero.
+void DownmixStereoToMono(const int16_t* interleaved,
+                         size_t num_frames,
+                         int16_t* deinterleaved) {
+  size_t i = 0;
+#if defined(WEBRTC_HAS_NEON)
+  for (; i + 8 <= num_frames; i += 8) {
+    int32x4_t sums_low = vpaddlq_s16(vld1q_s16(&interleaved[2 * i]));
+    int32x4_t sums_high = vpaddlq_s16(vld1q_s16(&interleaved[2 * i + 8]));
+    // Adding the sign bit before the shift rounds negative sums toward zero.
+    sums_low = vshrq_n_s32(
+        vaddq_s32(sums_low, vreinterpretq_s32_u32(vshrq_n_u32(
+                                vreinterpretq_u32_s32(sums_low), 31))),
+        1);
+    sums_high = vshrq_n_s32(
+        vaddq_s32(sums_high, vreinterpretq_s32_u32(vshrq_n_u32(
+                                 vreinterpretq_u32_s32(sums_high), 31))),
+        1);
+    vst1q_s16(&deinterleaved[i],
+              vcombine_s16(vmovn_s32(sums_low), vmovn_s32(sums_high)));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  const __m128i ones = _mm_set1_epi16(1);
+  for (; i + 8 <= num_frames; i += 8) {
+    __m128i sums_low = _mm_madd_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&interleaved[2 * i])),
+        ones);
+    __m128i sums_high = _mm_madd_epi16(
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&interleaved[2 * i + 8])),
+        ones);
+    // Adding the sign bit before the shift rounds negative sums toward zero.
+    sums_low = _mm_srai_epi32(
+        _mm_add_epi32(sums_low, _mm_srli_epi32(sums_low, 31)), 1);
+    sums_high = _mm_srai_epi32(
+        _mm_add_epi32(sums_high, _mm_srli_epi32(sums_high, 31)), 1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&deinterleaved[i]),
+                     _mm_packs_epi32(sums_low, sums_high));
+  }
+#endif
+  for (; i < num_frames; ++i) {
+    deinterleaved[i] = (static_cast<int32_t>(interleaved[2 * i]) +
+                        interleaved[2 * i + 1]) /
+                       2;
+  }
+}
+
+}  // namespace
+
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatToS16(src[i]);
@@ -47,6 +107,10 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
                                        int num_channels,
                                        int16_t* deinterleaved) {
+  if (num_channels == 2) {
+    DownmixStereoToMono(interleaved, num_frames, deinterleaved);
+    return;
+  }
   DownmixInterleavedToMonoImpl<int16_t, int32_t>(interleaved, num_frames,
                                                  num_channels, deinterleaved);
 }
@@ -194,6 +194,32 @@ TEST(AudioUtilTest, DownmixInterleavedToMono) {
   }
 }
 
+// The stereo downmix has a vectorized implementation, which must match the
+// generic one, also for the frames after the last full vector and in-place.
+TEST(AudioUtilTest, DownmixInterleavedStereoToMonoMatchesGenericDownmix) {
+  const size_t kNumFrames = 19;
+  const int kNumChannels = 2;
+  int16_t interleaved[kNumChannels * kNumFrames];
+  for (size_t i = 0; i < kNumChannels * kNumFrames; ++i) {
+    // Includes odd negative sums and the extremes of the range.
+    interleaved[i] = i % 3 == 0 ? -32768 + static_cast<int16_t>(i)
+                                : (i % 3 == 1 ? 32767 : -7);
+  }
+  int16_t expected[kNumFrames];
+  DownmixInterleavedToMonoImpl<int16_t, int32_t>(interleaved, kNumFrames,
+                                                 kNumChannels, expected);
+
+  int16_t deinterleaved[kNumFrames];
+  DownmixInterleavedToMono(interleaved, kNumFrames, kNumChannels,
+                           deinterleaved);
+  EXPECT_THAT(deinterleaved, ElementsAreArray(expected));
+
+  DownmixInterleavedToMono(interleaved, kNumFrames, kNumChannels,
+                           interleaved);
+  for (size_t i = 0; i < kNumFrames; ++i)
+    EXPECT_EQ(expected[i], interleaved[i]);
+}
+
 TEST(AudioUtilTest, DownmixToMonoTest) {
   {
     const size_t kNumFrames = 4;
@@ -16,9 +16,12 @@
 
 namespace webrtc {
 
+class PolyphaseResampler;
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
+// Wraps PushSincResampler to provide stereo support. With the
+// "WebRTC-Audio-PolyphaseResampler" field trial, ratios supported by
+// PolyphaseResampler use it instead.
 // TODO(ajm): add support for an arbitrary number of channels.
 template <typename T>
 class PushResampler {
@@ -42,7 +45,9 @@ class PushResampler {
   size_t num_channels_;
 
   struct ChannelResampler {
+    // Exactly one of these is set.
     std::unique_ptr<PushSincResampler> resampler;
+    std::unique_ptr<PolyphaseResampler> polyphase_resampler;
     std::vector<T> source;
     std::vector<T> destination;
   };
@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// MSVC++ requires this to be set before any other includes to get M_PI.
+#define _USE_MATH_DEFINES
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "common_audio/include/audio_util.h"
+#include "common_audio/resampler/sinc_resampler.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kKernelSize = SincResampler::kKernelSize;
+
+// Returns the dot product of |input| and |kernel|, both |kKernelSize| long.
+// |kernel| must be 16-byte aligned.
+float DotProduct(const float* input, const float* kernel) {
+#if defined(WEBRTC_HAS_NEON)
+  float32x4_t sums = vdupq_n_f32(0.f);
+  for (size_t i = 0; i < kKernelSize; i += 4) {
+    sums = vmlaq_f32(sums, vld1q_f32(input + i), vld1q_f32(kernel + i));
+  }
+  float32x2_t sum = vadd_f32(vget_high_f32(sums), vget_low_f32(sums));
+  return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  __m128 sums = _mm_setzero_ps();
+  for (size_t i = 0; i < kKernelSize; i += 4) {
+    sums = _mm_add_ps(
+        sums, _mm_mul_ps(_mm_loadu_ps(input + i), _mm_load_ps(kernel + i)));
+  }
+  sums = _mm_add_ps(_mm_movehl_ps(sums, sums), sums);
+  float result;
+  _mm_store_ss(&result, _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1)));
+  return result;
+#else
+  float sum = 0.f;
+  for (size_t i = 0; i < kKernelSize; ++i) {
+    sum += input[i] * kernel[i];
+  }
+  return sum;
+#endif
+}
+
+size_t GreatestCommonDivisor(size_t a, size_t b) {
+  while (b != 0) {
+    size_t remainder = a % b;
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+
+// Same as the kernel cutoff of SincResampler.
+double SincScaleFactor(double io_ratio) {
+  return 0.9 * (io_ratio > 1.0 ? 1.0 / io_ratio : 1.0);
+}
+
+}  // namespace
+
+const size_t PolyphaseResampler::kMaxPhases;
+
+bool PolyphaseResampler::IsSupported(size_t source_frames,
+                                     size_t destination_frames) {
+  if (source_frames == 0 || destination_frames == 0) {
+    return false;
+  }
+  const size_t num_phases =
+      destination_frames /
+      GreatestCommonDivisor(source_frames, destination_frames);
+  return num_phases <= kMaxPhases;
+}
+
+PolyphaseResampler::PolyphaseResampler(size_t source_frames,
+                                       size_t destination_frames)
+    : source_frames_(source_frames),
+      destination_frames_(destination_frames),
+      kernels_(static_cast<float*>(
+          AlignedMalloc(sizeof(float) * kMaxPhases * kKernelSize, 16))),
+      float_buffer_(new float[destination_frames]) {
+  RTC_DCHECK(IsSupported(source_frames, destination_frames));
+  const size_t gcd = GreatestCommonDivisor(source_frames, destination_frames);
+  num_phases_ = destination_frames / gcd;
+  decimation_ = source_frames / gcd;
+
+  // PushSincResampler primes SincResampler with as many output samples as fit
+  // in its first block of |source_frames| - kKernelSize / 2 samples, which
+  // adds the remainder of that block to its delay of kKernelSize / 2. Match it
+  // so that the two can be used interchangeably. The remainder is less than
+  // |decimation_| / |num_phases_| samples.
+  const size_t extra_delay =
+      ((source_frames_ - kKernelSize / 2) * num_phases_) % decimation_;
+  history_size_ = kKernelSize + (extra_delay + num_phases_ - 1) / num_phases_;
+  first_position_ = (history_size_ - kKernelSize) * num_phases_ - extra_delay;
+  input_buffer_.reset(static_cast<float*>(AlignedMalloc(
+      sizeof(float) * (history_size_ + source_frames_), 16)));
+  memset(input_buffer_.get(), 0,
+         sizeof(float) * (history_size_ + source_frames_));
+
+  // Blackman window parameters, as in SincResampler.
+  static const double kAlpha = 0.16;
+  static const double kA0 = 0.5 * (1.0 - kAlpha);
+  static const double kA1 = 0.5;
+  static const double kA2 = 0.5 * kAlpha;
+  const double sinc_scale_factor =
+      SincScaleFactor(static_cast<double>(decimation_) / num_phases_);
+  for (size_t phase = 0; phase < num_phases_; ++phase) {
+    const double subsample_offset = static_cast<double>(phase) / num_phases_;
+    for (size_t i = 0; i < kKernelSize; ++i) {
+      const double pre_sinc =
+          M_PI * (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
+                  subsample_offset);
+      const double x = (i - subsample_offset) / kKernelSize;
+      const double window =
+          kA0 - kA1 * cos(2.0 * M_PI * x) + kA2 * cos(4.0 * M_PI * x);
+      kernels_[phase * kKernelSize + i] = static_cast<float>(
+          window * ((pre_sinc == 0)
+                        ? sinc_scale_factor
+                        : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+    }
+  }
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+size_t PolyphaseResampler::Resample(const int16_t* source,
+                                    size_t source_frames,
+                                    int16_t* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  float* input = &input_buffer_[history_size_];
+  for (size_t i = 0; i < source_frames; ++i) {
+    input[i] = source[i];
+  }
+  Filter(float_buffer_.get());
+  FloatS16ToS16(float_buffer_.get(), destination_frames_, destination);
+  return destination_frames_;
+}
+
+size_t PolyphaseResampler::Resample(const float* source,
+                                    size_t source_frames,
+                                    float* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  memcpy(&input_buffer_[history_size_], source, sizeof(float) * source_frames);
+  Filter(destination);
+  return destination_frames_;
+}
+
+void PolyphaseResampler::Filter(float* destination) {
+  // Output sample n is taken at input position (|first_position_| + n *
+  // |decimation_|) / |num_phases_|. The integer part of the position selects
+  // where the kernel starts in |input_buffer_| and the fractional part selects
+  // the kernel.
+  size_t position = first_position_ / num_phases_;
+  size_t phase = first_position_ % num_phases_;
+  for (size_t n = 0; n < destination_frames_; ++n) {
+    destination[n] =
+        DotProduct(&input_buffer_[position], &kernels_[phase * kKernelSize]);
+    phase += decimation_;
+    position += phase / num_phases_;
+    phase %= num_phases_;
+  }
+  RTC_DCHECK_EQ(position * num_phases_ + phase,
+                source_frames_ * num_phases_ + first_position_);
+  // Keep the last |history_size_| samples for the next block.
+  memmove(&input_buffer_[0], &input_buffer_[source_frames_],
+          sizeof(float) * history_size_);
+}
+
+}  // namespace webrtc
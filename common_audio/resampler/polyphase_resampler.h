@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+namespace webrtc {
+
+// A push-based resampler for rational ratios L / M with few phases L, e.g.
+// 48 kHz <-> 16 kHz (L = 1 or 3) or 48 kHz <-> 32 kHz (L = 2 or 3). It uses
+// the same windowed sinc kernel and delay as PushSincResampler, but since the
+// sub-sample offsets of the output samples repeat with a period of L, it
+// precomputes the L kernels it needs instead of interpolating between two
+// kernels for each output sample. That halves the work per output sample and
+// makes the output slightly more accurate.
+class PolyphaseResampler {
+ public:
+  // The largest number of phases L that is supported.
+  static const size_t kMaxPhases = 8;
+
+  // Returns true if the ratio between |source_frames| and |destination_frames|
+  // is supported.
+  static bool IsSupported(size_t source_frames, size_t destination_frames);
+
+  // Provide the size of the source and destination blocks in samples. These
+  // must correspond to the same time duration (typically 10 ms) as the sample
+  // ratio is inferred from them.
+  PolyphaseResampler(size_t source_frames, size_t destination_frames);
+  ~PolyphaseResampler();
+
+  // Perform the resampling. |source_frames| must always equal the
+  // |source_frames| provided at construction. |destination_capacity| must be
+  // at least as large as |destination_frames|. Returns the number of samples
+  // provided in destination, which always equals |destination_frames|.
+  size_t Resample(const int16_t* source,
+                  size_t source_frames,
+                  int16_t* destination,
+                  size_t destination_capacity);
+  size_t Resample(const float* source,
+                  size_t source_frames,
+                  float* destination,
+                  size_t destination_capacity);
+
+ private:
+  // Filters the input buffer into |destination_frames_| samples.
+  void Filter(float* destination);
+
+  const size_t source_frames_;
+  const size_t destination_frames_;
+  // The ratio is |num_phases_| / |decimation_| in reduced form.
+  size_t num_phases_;
+  size_t decimation_;
+  // The number of samples of the previous block that are kept.
+  size_t history_size_;
+  // Where the first output sample of a block is taken, in units of 1 /
+  // |num_phases_| samples from the start of |input_buffer_|.
+  size_t first_position_;
+
+  // |num_phases_| kernels back-to-back, kernel p being delayed by p /
+  // |num_phases_| samples.
+  std::unique_ptr<float[], AlignedFreeDeleter> kernels_;
+
+  // The last |history_size_| samples of the previous block, followed by the
+  // current block.
+  std::unique_ptr<float[], AlignedFreeDeleter> input_buffer_;
+
+  // The float output of the int16_t Resample().
+  std::unique_ptr<float[]> float_buffer_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PolyphaseResampler);
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// MSVC++ requires this to be set before any other includes to get M_PI.
+#define _USE_MATH_DEFINES
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <cmath>
+#include <vector>
+
+#include "common_audio/resampler/include/push_resampler.h"
+#include "common_audio/resampler/push_sinc_resampler.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumBlocks = 20;
+
+// Fills |block| with block |block_index| of a 1 kHz sine at |sample_rate_hz|.
+void GenerateSine(int sample_rate_hz,
+                  int block_index,
+                  std::vector<float>* block) {
+  for (size_t i = 0; i < block->size(); ++i) {
+    const size_t n = block_index * block->size() + i;
+    (*block)[i] = 10000.f * std::sin(2 * M_PI * 1000 * n / sample_rate_hz);
+  }
+}
+
+}  // namespace
+
+TEST(PolyphaseResamplerTest, IsSupported) {
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(480, 160));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(160, 480));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(480, 320));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(320, 480));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(80, 480));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(441, 480));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 441));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(0, 480));
+}
+
+class PolyphaseResamplerTest
+    : public ::testing::TestWithParam<::testing::tuple<int, int>> {};
+
+// The output should match that of PushSincResampler, which uses the same
+// kernel and has the same delay but interpolates between kernels.
+TEST_P(PolyphaseResamplerTest, MatchesPushSincResampler) {
+  const int input_rate = ::testing::get<0>(GetParam());
+  const int output_rate = ::testing::get<1>(GetParam());
+  const size_t input_block_size = input_rate / 100;
+  const size_t output_block_size = output_rate / 100;
+  ASSERT_TRUE(
+      PolyphaseResampler::IsSupported(input_block_size, output_block_size));
+
+  PolyphaseResampler resampler(input_block_size, output_block_size);
+  PushSincResampler sinc_resampler(input_block_size, output_block_size);
+  std::vector<float> input(input_block_size);
+  std::vector<float> output(output_block_size);
+  std::vector<float> sinc_output(output_block_size);
+  double error_energy = 0;
+  double signal_energy = 0;
+  for (int block = 0; block < kNumBlocks; ++block) {
+    GenerateSine(input_rate, block, &input);
+    EXPECT_EQ(output_block_size,
+              resampler.Resample(input.data(), input_block_size, output.data(),
+                                 output_block_size));
+    sinc_resampler.Resample(input.data(), input_block_size, sinc_output.data(),
+                            output_block_size);
+    // Skip the first blocks, where the delay lines are filled.
+    if (block < 2)
+      continue;
+    for (size_t i = 0; i < output_block_size; ++i) {
+      const double error = output[i] - sinc_output[i];
+      error_energy += error * error;
+      signal_energy += sinc_output[i] * sinc_output[i];
+    }
+  }
+  ASSERT_GT(signal_energy, 0);
+  EXPECT_GT(10 * std::log10(signal_energy / (error_energy + 1e-10)), 60);
+}
+
+TEST_P(PolyphaseResamplerTest, Int16MatchesFloat) {
+  const size_t input_block_size = ::testing::get<0>(GetParam()) / 100;
+  const size_t output_block_size = ::testing::get<1>(GetParam()) / 100;
+  PolyphaseResampler float_resampler(input_block_size, output_block_size);
+  PolyphaseResampler int16_resampler(input_block_size, output_block_size);
+  std::vector<float> input(input_block_size);
+  std::vector<int16_t> int16_input(input_block_size);
+  std::vector<float> output(output_block_size);
+  std::vector<int16_t> int16_output(output_block_size);
+  for (int block = 0; block < kNumBlocks; ++block) {
+    GenerateSine(::testing::get<0>(GetParam()), block, &input);
+    for (size_t i = 0; i < input_block_size; ++i) {
+      input[i] = std::round(input[i]);
+      int16_input[i] = static_cast<int16_t>(input[i]);
+    }
+    float_resampler.Resample(input.data(), input_block_size, output.data(),
+                             output_block_size);
+    int16_resampler.Resample(int16_input.data(), input_block_size,
+                             int16_output.data(), output_block_size);
+    for (size_t i = 0; i < output_block_size; ++i) {
+      EXPECT_NEAR(output[i], int16_output[i], 0.5f);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(PolyphaseResamplerTest,
+                         PolyphaseResamplerTest,
+                         ::testing::Values(::testing::make_tuple(48000, 16000),
+                                           ::testing::make_tuple(16000, 48000),
+                                           ::testing::make_tuple(48000, 32000),
+                                           ::testing::make_tuple(32000, 48000),
+                                           ::testing::make_tuple(32000, 16000),
+                                           ::testing::make_tuple(8000, 48000)));
+
+TEST(PolyphaseResamplerTest, UsedByPushResamplerWithFieldTrial) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-PolyphaseResampler/Enabled/");
+  PushResampler<float> push_resampler;
+  ASSERT_EQ(0, push_resampler.InitializeIfNeeded(48000, 16000, 1));
+  PolyphaseResampler resampler(480, 160);
+  std::vector<float> input(480);
+  std::vector<float> output(160);
+  std::vector<float> expected_output(160);
+  for (int block = 0; block < kNumBlocks; ++block) {
+    GenerateSine(48000, block, &input);
+    EXPECT_EQ(160, push_resampler.Resample(input.data(), input.size(),
+                                           output.data(), output.size()));
+    resampler.Resample(input.data(), input.size(), expected_output.data(),
+                       expected_output.size());
+    EXPECT_EQ(expected_output, output);
+  }
+}
+
+}  // namespace webrtc
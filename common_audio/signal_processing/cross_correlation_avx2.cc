@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// AVX2 version of WebRtcSpl_CrossCorrelation(), bit-exact with the C version.
+// The products are computed in 32 bits from their low and high 16-bit halves
+// and shifted one by one before they are added, like in the C version.
+void WebRtcSpl_CrossCorrelationAvx2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  const size_t vector_limit = dim_seq - dim_seq % 16;
+  for (size_t i = 0; i < dim_cross_correlation; ++i) {
+    __m256i sum = _mm256_setzero_si256();
+    size_t j = 0;
+    for (; j < vector_limit; j += 16) {
+      const __m256i x =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&seq1[j]));
+      const __m256i y =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&seq2[j]));
+      const __m256i low = _mm256_mullo_epi16(x, y);
+      const __m256i high = _mm256_mulhi_epi16(x, y);
+      const __m256i products_0 = _mm256_unpacklo_epi16(low, high);
+      const __m256i products_1 = _mm256_unpackhi_epi16(low, high);
+      sum = _mm256_add_epi32(sum, _mm256_sra_epi32(products_0, shift));
+      sum = _mm256_add_epi32(sum, _mm256_sra_epi32(products_1, shift));
+    }
+    __m128i sum_128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                    _mm256_extracti128_si256(sum, 1));
+    sum_128 = _mm_add_epi32(sum_128, _mm_unpackhi_epi64(sum_128, sum_128));
+    sum_128 = _mm_add_epi32(sum_128, _mm_srli_si128(sum_128, 4));
+    int32_t corr = _mm_cvtsi128_si32(sum_128);
+    for (; j < dim_seq; ++j) {
+      corr += (seq1[j] * seq2[j]) >> right_shifts;
+    }
+    seq2 += step_seq2;
+    *cross_correlation++ = corr;
+  }
+}
@@ -11,11 +11,22 @@
 #include "common_audio/signal_processing/dot_product_with_scale.h"
 
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       const int16_t* vector2,
                                       size_t length,
                                       int scaling) {
+#if defined(WEBRTC_HAS_NEON)
+  return WebRtcSpl_DotProductWithScaleNeon(vector1, vector2, length, scaling);
+#else
+#if defined(WEBRTC_HAS_AVX2)
+  static const bool use_avx2 = WebRtc_GetCPUInfo(kAVX2) != 0;
+  if (use_avx2) {
+    return WebRtcSpl_DotProductWithScaleAvx2(vector1, vector2, length,
+                                             scaling);
+  }
+#endif
   int64_t sum = 0;
   size_t i = 0;
 
@@ -31,4 +42,5 @@ int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
   }
 
   return rtc::saturated_cast<int32_t>(sum);
+#endif
 }
@@ -34,6 +34,19 @@ int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       size_t length,
                                       int scaling);
 
+#if defined(WEBRTC_HAS_NEON)
+int32_t WebRtcSpl_DotProductWithScaleNeon(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling);
+#endif
+#if defined(WEBRTC_HAS_AVX2)
+int32_t WebRtcSpl_DotProductWithScaleAvx2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling);
+#endif
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
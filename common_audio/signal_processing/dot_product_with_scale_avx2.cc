@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+// Bit-exact with the generic version. The shifted products are accumulated in
+// 64 bits, since two of them may overflow 32 bits.
+int32_t WebRtcSpl_DotProductWithScaleAvx2(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  const size_t vector_limit = length - length % 16;
+  __m256i sum_0 = _mm256_setzero_si256();
+  __m256i sum_1 = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i < vector_limit; i += 16) {
+    const __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&vector1[i]));
+    const __m256i y =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&vector2[i]));
+    const __m256i low = _mm256_mullo_epi16(x, y);
+    const __m256i high = _mm256_mulhi_epi16(x, y);
+    const __m256i products_0 =
+        _mm256_sra_epi32(_mm256_unpacklo_epi16(low, high), shift);
+    const __m256i products_1 =
+        _mm256_sra_epi32(_mm256_unpackhi_epi16(low, high), shift);
+    sum_0 = _mm256_add_epi64(
+        sum_0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(products_0)));
+    sum_1 = _mm256_add_epi64(
+        sum_1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(products_0, 1)));
+    sum_0 = _mm256_add_epi64(
+        sum_0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(products_1)));
+    sum_1 = _mm256_add_epi64(
+        sum_1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(products_1, 1)));
+  }
+  const __m256i sum_256 = _mm256_add_epi64(sum_0, sum_1);
+  __m128i sum_128 = _mm_add_epi64(_mm256_castsi256_si128(sum_256),
+                                  _mm256_extracti128_si256(sum_256, 1));
+  sum_128 = _mm_add_epi64(sum_128, _mm_unpackhi_epi64(sum_128, sum_128));
+  int64_t sum = _mm_cvtsi128_si64(sum_128);
+  for (; i < length; ++i) {
+    sum += (vector1[i] * vector2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(sum);
+}
@@ -0,0 +1,44 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+// Bit-exact with the generic version, unlike the dot product used by
+// WebRtcSpl_CrossCorrelationNeon(), since each product is shifted before it
+// is accumulated.
+int32_t WebRtcSpl_DotProductWithScaleNeon(const int16_t* vector1,
+                                          const int16_t* vector2,
+                                          size_t length,
+                                          int scaling) {
+  const int32x4_t shift = vdupq_n_s32(-scaling);
+  const size_t vector_limit = length - length % 8;
+  int64x2_t sum_0 = vdupq_n_s64(0);
+  int64x2_t sum_1 = vdupq_n_s64(0);
+  size_t i = 0;
+  for (; i < vector_limit; i += 8) {
+    const int16x8_t x = vld1q_s16(&vector1[i]);
+    const int16x8_t y = vld1q_s16(&vector2[i]);
+    const int32x4_t products_0 =
+        vshlq_s32(vmull_s16(vget_low_s16(x), vget_low_s16(y)), shift);
+    const int32x4_t products_1 =
+        vshlq_s32(vmull_s16(vget_high_s16(x), vget_high_s16(y)), shift);
+    sum_0 = vpadalq_s32(sum_0, products_0);
+    sum_1 = vpadalq_s32(sum_1, products_1);
+  }
+  const int64x2_t sum_2 = vaddq_s64(sum_0, sum_1);
+  int64_t sum = vgetq_lane_s64(sum_2, 0) + vgetq_lane_s64(sum_2, 1);
+  for (; i < length; ++i) {
+    sum += (vector1[i] * vector2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(sum);
+}
@@ -11,7 +11,10 @@
 #include <algorithm>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -503,6 +506,82 @@ TEST(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_HAS_AVX2)
+// Tests that the AVX2 versions are bit-exact with the generic ones, also when
+// the sums wrap around, for lengths that are not multiples of the vector size.
+TEST(SplTest, CrossCorrelationAvx2IsBitExact) {
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    return;
+  }
+  webrtc::Random random(42);
+  int16_t seq1[100];
+  int16_t seq2[200];
+  for (int16_t& x : seq1)
+    x = static_cast<int16_t>(random.Rand(-32768, 32767));
+  for (int16_t& x : seq2)
+    x = static_cast<int16_t>(random.Rand(-32768, 32767));
+
+  const size_t kCrossCorrelationDimension = 40;
+  for (size_t dim_seq : {1, 15, 16, 17, 60, 100}) {
+    for (int right_shifts : {0, 3, 14}) {
+      for (int step : {-1, 1, 2}) {
+        // Start in the middle of |seq2| to allow negative steps.
+        const int16_t* seq2_start = &seq2[kCrossCorrelationDimension * 2];
+        int32_t expected[kCrossCorrelationDimension];
+        int32_t actual[kCrossCorrelationDimension];
+        WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, dim_seq,
+                                    kCrossCorrelationDimension, right_shifts,
+                                    step);
+        WebRtcSpl_CrossCorrelationAvx2(actual, seq1, seq2_start, dim_seq,
+                                       kCrossCorrelationDimension,
+                                       right_shifts, step);
+        for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+          EXPECT_EQ(expected[i], actual[i]) << "dim_seq: " << dim_seq
+                                            << ", right_shifts: "
+                                            << right_shifts << ", step: "
+                                            << step << ", i: " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SplTest, DotProductWithScaleAvx2IsBitExact) {
+  if (!WebRtc_GetCPUInfo(kAVX2)) {
+    return;
+  }
+  webrtc::Random random(42);
+  int16_t vector1[1000];
+  int16_t vector2[1000];
+  int16_t loudest[1000];
+  std::fill(loudest, loudest + 1000, WEBRTC_SPL_WORD16_MIN);
+  for (size_t i = 0; i < 1000; ++i) {
+    vector1[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+    vector2[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+  }
+  // The generic version, computed here since WebRtcSpl_DotProductWithScale()
+  // dispatches to the AVX2 version.
+  auto dot_product = [](const int16_t* x, const int16_t* y, size_t length,
+                        int scaling) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < length; ++i)
+      sum += (x[i] * y[i]) >> scaling;
+    return rtc::saturated_cast<int32_t>(sum);
+  };
+  for (size_t length : {0, 1, 15, 16, 17, 240, 1000}) {
+    for (int scaling : {0, 5, 14}) {
+      EXPECT_EQ(dot_product(vector1, vector2, length, scaling),
+                WebRtcSpl_DotProductWithScaleAvx2(vector1, vector2, length,
+                                                  scaling));
+      // The energy of the loudest signal may saturate.
+      EXPECT_EQ(dot_product(loudest, loudest, length, scaling),
+                WebRtcSpl_DotProductWithScaleAvx2(loudest, loudest, length,
+                                                  scaling));
+    }
+  }
+}
+#endif
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
@@ -11,6 +11,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -21,6 +22,9 @@
 namespace {
 
 const int kMaxAbsQpDeltaValue = 51;
+// Slice headers of real streams are a few tens of bytes, so unescaping this
+// much of a slice is normally enough to parse its header.
+const size_t kSliceHeaderMaxUnescapedSize = 256;
 const int kMinQpValue = 0;
 const int kMaxQpValue = 51;
 
@@ -46,14 +50,27 @@ H264BitstreamParser::Result H264BitstreamParser::ParseNonParameterSetNalu(
   if (!sps_ || !pps_)
     return kInvalidStream;
 
+  // Only the slice header is needed, so avoid unescaping the whole slice
+  // unless the header turns out to be longer than expected.
+  const size_t header_length =
+      std::min(source_length, kSliceHeaderMaxUnescapedSize);
+  Result result = ParseSliceHeader(source, header_length, nalu_type);
+  if (result == kInvalidStream && header_length < source_length)
+    result = ParseSliceHeader(source, source_length, nalu_type);
+  return result;
+}
+
+H264BitstreamParser::Result H264BitstreamParser::ParseSliceHeader(
+    const uint8_t* source,
+    size_t header_length,
+    uint8_t nalu_type) {
   last_slice_qp_delta_ = absl::nullopt;
-  const std::vector<uint8_t> slice_rbsp =
-      H264::ParseRbsp(source, source_length);
-  if (slice_rbsp.size() < H264::kNaluTypeSize)
+  H264::ParseRbsp(source, header_length, &slice_rbsp_);
+  if (slice_rbsp_.size() < H264::kNaluTypeSize)
     return kInvalidStream;
 
-  rtc::BitBuffer slice_reader(slice_rbsp.data() + H264::kNaluTypeSize,
-                              slice_rbsp.size() - H264::kNaluTypeSize);
+  rtc::BitBuffer slice_reader(slice_rbsp_.data() + H264::kNaluTypeSize,
+                              slice_rbsp_.size() - H264::kNaluTypeSize);
   // Check to see if this is an IDR slice, which has an extra field to parse
   // out.
   bool is_idr = (source[0] & 0x0F) == H264::NaluType::kIdr;
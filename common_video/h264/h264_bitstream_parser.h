@@ -13,6 +13,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/video_codecs/bitstream_parser.h"
 #include "common_video/h264/pps_parser.h"
@@ -49,6 +51,10 @@ class H264BitstreamParser : public BitstreamParser {
   Result ParseNonParameterSetNalu(const uint8_t* source,
                                   size_t source_length,
                                   uint8_t nalu_type);
+  // Parses the slice header from the first |header_length| bytes of the NALU.
+  Result ParseSliceHeader(const uint8_t* source,
+                          size_t header_length,
+                          uint8_t nalu_type);
 
   // SPS/PPS state, updated when parsing new SPS/PPS, used to parse slices.
   absl::optional<SpsParser::SpsState> sps_;
@@ -56,6 +62,9 @@ class H264BitstreamParser : public BitstreamParser {
 
   // Last parsed slice QP.
   absl::optional<int32_t> last_slice_qp_delta_;
+
+  // Unescaped slice header, kept to reuse its allocation.
+  std::vector<uint8_t> slice_rbsp_;
 };
 
 }  // namespace webrtc
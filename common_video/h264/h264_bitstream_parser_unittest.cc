@@ -10,6 +10,9 @@
 
 #include "common_video/h264/h264_bitstream_parser.h"
 
+#include <iterator>
+#include <vector>
+
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -71,6 +74,22 @@ TEST(H264BitstreamParserTest, ReportsLastSliceQpForImageSlices) {
   EXPECT_EQ(37, qp);
 }
 
+TEST(H264BitstreamParserTest, ReportsLastSliceQpForLongImageSlices) {
+  H264BitstreamParser h264_parser;
+  h264_parser.ParseBitstream(kH264BitstreamChunk, sizeof(kH264BitstreamChunk));
+
+  // An image slice with a long payload, including emulation bytes.
+  std::vector<uint8_t> slice(std::begin(kH264BitstreamNextImageSliceChunk),
+                             std::end(kH264BitstreamNextImageSliceChunk));
+  for (int i = 0; i < 1000; ++i) {
+    slice.insert(slice.end(), {0x00, 0x00, 0x03, 0x01, 0xab});
+  }
+  h264_parser.ParseBitstream(slice.data(), slice.size());
+  int qp;
+  ASSERT_TRUE(h264_parser.GetLastSliceQp(&qp));
+  EXPECT_EQ(37, qp);
+}
+
 TEST(H264BitstreamParserTest, ReportsLastSliceQpForCABACImageSlices) {
   H264BitstreamParser h264_parser;
   h264_parser.ParseBitstream(kH264BitstreamChunkCabac,
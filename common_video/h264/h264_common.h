@@ -80,6 +80,8 @@ NaluType ParseNaluType(uint8_t data);
 
 // Parse the given data and remove any emulation byte escaping.
 std::vector<uint8_t> ParseRbsp(const uint8_t* data, size_t length);
+// Same as above, but replaces the contents of |rbsp|, reusing its capacity.
+void ParseRbsp(const uint8_t* data, size_t length, std::vector<uint8_t>* rbsp);
 
 // Write the given data to the destination buffer, inserting and emulation
 // bytes in order to escape any data the could be interpreted as a start
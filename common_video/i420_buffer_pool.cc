@@ -11,22 +11,229 @@
 #include "common_video/include/i420_buffer_pool.h"
 
 #include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+// The key of a bucket: width, height and the three strides.
+using BucketKey = std::tuple<int, int, int, int, int>;
+
+class I420BufferPool::PooledI420Buffer : public I420Buffer {
+ public:
+  PooledI420Buffer(rtc::scoped_refptr<Storage> storage,
+                   int64_t generation,
+                   int width,
+                   int height,
+                   int stride_y,
+                   int stride_u,
+                   int stride_v)
+      : I420Buffer(width, height, stride_y, stride_u, stride_v),
+        storage_(std::move(storage)),
+        generation_(generation) {}
+  ~PooledI420Buffer() override = default;
+
+  void AddRef() const override { ref_count_.IncRef(); }
+  // Returns the buffer to the pool instead of deleting it.
+  rtc::RefCountReleaseStatus Release() const override;
+
+  int64_t generation() const { return generation_; }
+  BucketKey key() const {
+    return BucketKey(width(), height(), StrideY(), StrideU(), StrideV());
+  }
+  size_t size_bytes() const {
+    return static_cast<size_t>(StrideY()) * height() +
+           static_cast<size_t>(StrideU() + StrideV()) * ChromaHeight();
+  }
+
+ private:
+  const rtc::scoped_refptr<Storage> storage_;
+  const int64_t generation_;
+  mutable webrtc_impl::RefCounter ref_count_{0};
+};
+
+class I420BufferPool::Storage : public rtc::RefCountInterface {
+ public:
+  Storage(bool zero_initialize,
+          size_t max_number_of_buffers,
+          size_t max_idle_bytes)
+      : zero_initialize_(zero_initialize),
+        max_number_of_buffers_(max_number_of_buffers),
+        max_idle_bytes_(max_idle_bytes) {}
+
+  ~Storage() override { RTC_DCHECK(buckets_.empty()); }
+
+  rtc::scoped_refptr<I420Buffer> CreateBuffer(int width,
+                                              int height,
+                                              int stride_y,
+                                              int stride_u,
+                                              int stride_v) {
+    rtc::scoped_refptr<I420Buffer> buffer;
+    {
+      rtc::CritScope lock(&crit_);
+      ++stats_.num_requests;
+      Bucket& bucket =
+          buckets_[BucketKey(width, height, stride_y, stride_u, stride_v)];
+      bucket.last_request = stats_.num_requests;
+      if (!bucket.idle.empty()) {
+        PooledI420Buffer* idle = bucket.idle.back();
+        bucket.idle.pop_back();
+        stats_.idle_bytes -= idle->size_bytes();
+        ++stats_.num_reused;
+        return idle;
+      }
+      if (bucket.num_buffers >= max_number_of_buffers_)
+        return nullptr;
+      ++bucket.num_buffers;
+      ++stats_.num_buffers;
+      // Allocating outside the lock would be cheaper for other threads, but
+      // it's rare compared to the reuse of idle buffers.
+      buffer = new PooledI420Buffer(this, generation_, width, height, stride_y,
+                                    stride_u, stride_v);
+    }
+    if (zero_initialize_)
+      buffer->InitializeData();
+    return buffer;
+  }
+
+  void Return(PooledI420Buffer* buffer) {
+    std::vector<PooledI420Buffer*> evicted;
+    {
+      rtc::CritScope lock(&crit_);
+      if (buffer->generation() == generation_) {
+        buckets_[buffer->key()].idle.push_back(buffer);
+        stats_.idle_bytes += buffer->size_bytes();
+        while (stats_.idle_bytes > max_idle_bytes_) {
+          RTC_CHECK(EvictLeastRecentlyRequested(&evicted));
+        }
+      } else {
+        evicted.push_back(buffer);
+      }
+    }
+    // The buffers hold references to the storage, so this may delete it.
+    Delete(evicted);
+  }
+
+  // Not named Release(), which would hide rtc::RefCountInterface::Release().
+  void Clear() {
+    std::vector<PooledI420Buffer*> evicted;
+    {
+      rtc::CritScope lock(&crit_);
+      for (auto& key_and_bucket : buckets_) {
+        std::vector<PooledI420Buffer*>& idle = key_and_bucket.second.idle;
+        evicted.insert(evicted.end(), idle.begin(), idle.end());
+      }
+      buckets_.clear();
+      // The buffers in use are no longer part of the pool.
+      ++generation_;
+      stats_.num_buffers = 0;
+      stats_.idle_bytes = 0;
+    }
+    Delete(evicted);
+  }
+
+  Stats GetStats() const {
+    rtc::CritScope lock(&crit_);
+    return stats_;
+  }
+
+ private:
+  struct Bucket {
+    std::vector<PooledI420Buffer*> idle;
+    // Buffers of this resolution owned by the pool, in use or idle.
+    size_t num_buffers = 0;
+    int64_t last_request = 0;
+  };
+
+  // Removes an idle buffer from the bucket that was least recently asked for.
+  // Returns false if there are no idle buffers.
+  bool EvictLeastRecentlyRequested(std::vector<PooledI420Buffer*>* evicted)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_) {
+    auto oldest = buckets_.end();
+    for (auto it = buckets_.begin(); it != buckets_.end(); ++it) {
+      if (!it->second.idle.empty() &&
+          (oldest == buckets_.end() ||
+           it->second.last_request < oldest->second.last_request)) {
+        oldest = it;
+      }
+    }
+    if (oldest == buckets_.end())
+      return false;
+    PooledI420Buffer* buffer = oldest->second.idle.back();
+    oldest->second.idle.pop_back();
+    if (--oldest->second.num_buffers == 0)
+      buckets_.erase(oldest);
+    stats_.idle_bytes -= buffer->size_bytes();
+    --stats_.num_buffers;
+    evicted->push_back(buffer);
+    return true;
+  }
+
+  static void Delete(const std::vector<PooledI420Buffer*>& buffers) {
+    for (PooledI420Buffer* buffer : buffers)
+      delete buffer;
+  }
+
+  const bool zero_initialize_;
+  const size_t max_number_of_buffers_;
+  const size_t max_idle_bytes_;
+  rtc::CriticalSection crit_;
+  // Incremented by Clear(), so that buffers created before are deleted
+  // rather than returned.
+  int64_t generation_ RTC_GUARDED_BY(crit_) = 0;
+  std::map<BucketKey, Bucket> buckets_ RTC_GUARDED_BY(crit_);
+  Stats stats_ RTC_GUARDED_BY(crit_);
+};
+
+rtc::RefCountReleaseStatus I420BufferPool::PooledI420Buffer::Release() const {
+  const auto status = ref_count_.DecRef();
+  if (status == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+    // Keep the storage alive while returning to it, since this may be the
+    // last reference.
+    rtc::scoped_refptr<Storage> storage = storage_;
+    storage->Return(const_cast<PooledI420Buffer*>(this));
+  }
+  return status;
+}
+
+constexpr size_t I420BufferPool::kDefaultMaxIdleBytes;
+
 I420BufferPool::I420BufferPool() : I420BufferPool(false) {}
 I420BufferPool::I420BufferPool(bool zero_initialize)
     : I420BufferPool(zero_initialize, std::numeric_limits<size_t>::max()) {}
 I420BufferPool::I420BufferPool(bool zero_initialize,
                                size_t max_number_of_buffers)
-    : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
-I420BufferPool::~I420BufferPool() = default;
+    : I420BufferPool(zero_initialize,
+                     max_number_of_buffers,
+                     kDefaultMaxIdleBytes) {}
+I420BufferPool::I420BufferPool(bool zero_initialize,
+                               size_t max_number_of_buffers,
+                               size_t max_idle_bytes)
+    : storage_(new rtc::RefCountedObject<Storage>(zero_initialize,
+                                                  max_number_of_buffers,
+                                                  max_idle_bytes)) {}
+
+I420BufferPool::~I420BufferPool() {
+  Release();
+}
+
+// static
+I420BufferPool* I420BufferPool::Shared() {
+  static I420BufferPool* const pool = new I420BufferPool();
+  return pool;
+}
 
 void I420BufferPool::Release() {
-  buffers_.clear();
+  storage_->Clear();
 }
 
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
@@ -40,37 +247,11 @@ rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int stride_y,
                                                             int stride_u,
                                                             int stride_v) {
-  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    const auto& buffer = *it;
-    if (buffer->width() != width || buffer->height() != height ||
-        buffer->StrideY() != stride_y || buffer->StrideU() != stride_u ||
-        buffer->StrideV() != stride_v) {
-      it = buffers_.erase(it);
-    } else {
-      ++it;
-    }
-  }
-  // Look for a free buffer.
-  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
-    // If the buffer is in use, the ref count will be >= 2, one from the list we
-    // are looping over and one from the application. If the ref count is 1,
-    // then the list we are looping over holds the only reference and it's safe
-    // to reuse.
-    if (buffer->HasOneRef())
-      return buffer;
-  }
+  return storage_->CreateBuffer(width, height, stride_y, stride_u, stride_v);
+}
 
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
-  // Allocate new buffer.
-  rtc::scoped_refptr<PooledI420Buffer> buffer =
-      new PooledI420Buffer(width, height, stride_y, stride_u, stride_v);
-  if (zero_initialize_)
-    buffer->InitializeData();
-  buffers_.push_back(buffer);
-  return buffer;
+I420BufferPool::Stats I420BufferPool::GetStats() const {
+  return storage_->GetStats();
 }
 
 }  // namespace webrtc
@@ -13,9 +13,15 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <memory>
+#include <vector>
+
 #include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -114,4 +120,77 @@ TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
 }
 
+TEST(TestI420BufferPool, ReusesSeveralResolutions) {
+  I420BufferPool pool;
+  auto small_buffer = pool.CreateBuffer(16, 16);
+  auto large_buffer = pool.CreateBuffer(32, 32);
+  const uint8_t* small_y_ptr = small_buffer->DataY();
+  const uint8_t* large_y_ptr = large_buffer->DataY();
+  small_buffer = nullptr;
+  large_buffer = nullptr;
+
+  EXPECT_EQ(small_y_ptr, pool.CreateBuffer(16, 16)->DataY());
+  EXPECT_EQ(large_y_ptr, pool.CreateBuffer(32, 32)->DataY());
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(4, stats.num_requests);
+  EXPECT_EQ(2, stats.num_reused);
+  EXPECT_EQ(2u, stats.num_buffers);
+}
+
+TEST(TestI420BufferPool, FreesLeastRecentlyRequestedAboveMaxIdleBytes) {
+  // Room for one idle 16x16 buffer.
+  I420BufferPool pool(false, 10, 16 * 16 + 2 * 8 * 8);
+  auto small_buffer = pool.CreateBuffer(16, 16);
+  auto large_buffer = pool.CreateBuffer(32, 32);
+  small_buffer = nullptr;
+  EXPECT_EQ(16u * 16 + 2 * 8 * 8, pool.GetStats().idle_bytes);
+  // The 32x32 buffer doesn't fit, and evicts the 16x16 one, which was
+  // requested before it, and then itself.
+  large_buffer = nullptr;
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(0u, stats.idle_bytes);
+  EXPECT_EQ(0u, stats.num_buffers);
+}
+
+TEST(TestI420BufferPool, MaxNumberOfBuffersIsPerResolution) {
+  I420BufferPool pool(false, 1);
+  auto buffer1 = pool.CreateBuffer(16, 16);
+  auto buffer2 = pool.CreateBuffer(32, 32);
+  EXPECT_NE(nullptr, buffer2.get());
+  EXPECT_EQ(nullptr, pool.CreateBuffer(32, 32).get());
+  EXPECT_EQ(2u, pool.GetStats().num_buffers);
+}
+
+TEST(TestI420BufferPool, BufferInUseIsFreedAfterRelease) {
+  I420BufferPool pool;
+  auto buffer = pool.CreateBuffer(16, 16);
+  pool.Release();
+  buffer = nullptr;
+  EXPECT_EQ(0u, pool.GetStats().num_buffers);
+  EXPECT_EQ(0u, pool.GetStats().idle_bytes);
+}
+
+TEST(TestI420BufferPool, BuffersCanBeReleasedOnAnotherThread) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  rtc::TaskQueue task_queue(
+      task_queue_factory->CreateTaskQueue("ReleaseBuffers",
+                                          TaskQueueFactory::Priority::NORMAL));
+  I420BufferPool pool;
+  for (int i = 0; i < 100; ++i) {
+    rtc::scoped_refptr<I420Buffer> buffer = pool.CreateBuffer(16, 16);
+    rtc::Event released;
+    task_queue.PostTask([&buffer, &released] {
+      buffer = nullptr;
+      released.Set();
+    });
+    // Create buffers while the other one is released.
+    pool.CreateBuffer(32, 32);
+    released.Wait(rtc::Event::kForever);
+  }
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(200, stats.num_requests);
+  EXPECT_LE(stats.num_buffers, 3u);
+}
+
 }  // namespace webrtc
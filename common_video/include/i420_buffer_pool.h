@@ -12,33 +12,51 @@
 #define COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 
 #include <stddef.h>
-
-#include <list>
+#include <stdint.h>
 
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
-#include "rtc_base/race_checker.h"
-#include "rtc_base/ref_counted_object.h"
 
 namespace webrtc {
 
-// Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
+// Buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
-// Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
-// are created. This is to prevent memory leaks where frames are not returned.
+// by subsequent calls to CreateBuffer. Buffers are kept per resolution and
+// stride, so a pool serves several resolutions at once, e.g. the streams of a
+// simulcast encoder. Idle buffers beyond |max_idle_bytes| are freed, starting
+// with the resolution that was least recently asked for.
+// The pool can be used from any thread, and the buffers can be released on
+// any thread.
 class I420BufferPool {
  public:
+  // Idle memory kept by default, about ten 1080p frames.
+  static constexpr size_t kDefaultMaxIdleBytes = 32 * 1024 * 1024;
+
+  struct Stats {
+    // Calls to CreateBuffer, and how many of them reused an idle buffer.
+    int64_t num_requests = 0;
+    int64_t num_reused = 0;
+    // Buffers currently owned by the pool, in use or idle.
+    size_t num_buffers = 0;
+    size_t idle_bytes = 0;
+  };
+
   I420BufferPool();
   explicit I420BufferPool(bool zero_initialize);
   I420BufferPool(bool zero_initialze, size_t max_number_of_buffers);
+  I420BufferPool(bool zero_initialze,
+                 size_t max_number_of_buffers,
+                 size_t max_idle_bytes);
   ~I420BufferPool();
 
+  // A process-wide pool, for scalers and other users that don't need a limit
+  // of their own.
+  static I420BufferPool* Shared();
+
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
-  // and there are less than |max_number_of_buffers| pending, a buffer is
-  // created. Returns null otherwise.
+  // and there are less than |max_number_of_buffers| pending of the same
+  // resolution, a buffer is created. Returns null otherwise.
   rtc::scoped_refptr<I420Buffer> CreateBuffer(int width, int height);
 
   // Returns a buffer from the pool with the explicitly specified stride.
@@ -48,25 +66,18 @@ class I420BufferPool {
                                               int stride_u,
                                               int stride_v);
 
-  // Clears buffers_ and detaches the thread checker so that it can be reused
-  // later from another thread.
+  // Frees the idle buffers. Buffers in use are freed when they are released,
+  // rather than returned to the pool.
   void Release();
 
+  Stats GetStats() const;
+
  private:
-  // Explicitly use a RefCountedObject to get access to HasOneRef,
-  // needed by the pool to check exclusive access.
-  using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
-
-  rtc::RaceChecker race_checker_;
-  std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
-  // If true, newly allocated buffers are zero-initialized. Note that recycled
-  // buffers are not zero'd before reuse. This is required of buffers used by
-  // FFmpeg according to http://crbug.com/390941, which only requires it for the
-  // initial allocation (as shown by FFmpeg's own buffer allocation code). It
-  // has to do with "Use-of-uninitialized-value" on "Linux_msan_chrome".
-  const bool zero_initialize_;
-  // Max number of buffers this pool can have pending.
-  const size_t max_number_of_buffers_;
+  class PooledI420Buffer;
+  // The state shared by the pool and its buffers, which may outlive it.
+  class Storage;
+
+  const rtc::scoped_refptr<Storage> storage_;
 };
 
 }  // namespace webrtc
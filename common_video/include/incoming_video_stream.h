@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <memory>
+
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -28,6 +31,12 @@ class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
   IncomingVideoStream(TaskQueueFactory* task_queue_factory,
                       int32_t delay_ms,
                       rtc::VideoSinkInterface<VideoFrame>* callback);
+  // Smooths the rendering on |render_queue| instead of on a task queue of its
+  // own, e.g. one that runs on a thread pool shared with other streams.
+  IncomingVideoStream(
+      std::unique_ptr<TaskQueueBase, TaskQueueDeleter> render_queue,
+      int32_t delay_ms,
+      rtc::VideoSinkInterface<VideoFrame>* callback);
   ~IncomingVideoStream() override;
 
  private:
@@ -24,11 +24,19 @@ IncomingVideoStream::IncomingVideoStream(
     TaskQueueFactory* task_queue_factory,
     int32_t delay_ms,
     rtc::VideoSinkInterface<VideoFrame>* callback)
+    : IncomingVideoStream(
+          task_queue_factory->CreateTaskQueue("IncomingVideoStream",
+                                              TaskQueueFactory::Priority::HIGH),
+          delay_ms,
+          callback) {}
+
+IncomingVideoStream::IncomingVideoStream(
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> render_queue,
+    int32_t delay_ms,
+    rtc::VideoSinkInterface<VideoFrame>* callback)
     : render_buffers_(delay_ms),
       callback_(callback),
-      incoming_render_queue_(task_queue_factory->CreateTaskQueue(
-          "IncomingVideoStream",
-          TaskQueueFactory::Priority::HIGH)) {}
+      incoming_render_queue_(std::move(render_queue)) {}
 
 IncomingVideoStream::~IncomingVideoStream() {
   RTC_DCHECK(main_thread_checker_.IsCurrent());
@@ -26,6 +26,8 @@
 
 namespace webrtc {
 
+class I420BufferPool;
+
 enum class VideoType {
   kUnknown,
   kI420,
@@ -97,6 +99,13 @@ rtc::scoped_refptr<I420BufferInterface> ScaleVideoFrameBuffer(
     int dst_width,
     int dst_height);
 
+// Like |buffer->ToI420()|, but an NV12 buffer is converted into a buffer from
+// |pool| instead of a newly allocated one, unless the pool is out of buffers.
+// Returns null if the conversion fails.
+rtc::scoped_refptr<I420BufferInterface> ConvertToI420(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    I420BufferPool* pool);
+
 double I420SSE(const I420BufferInterface& ref_buffer,
                const I420BufferInterface& test_buffer);
 
@@ -13,6 +13,7 @@
 #include <cstdint>
 
 #include "api/video/i420_buffer.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/checks.h"
@@ -211,6 +212,27 @@ rtc::scoped_refptr<I420BufferInterface> ScaleVideoFrameBuffer(
   return scaled_buffer;
 }
 
+rtc::scoped_refptr<I420BufferInterface> ConvertToI420(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    I420BufferPool* pool) {
+  if (buffer->type() != VideoFrameBuffer::Type::kNV12)
+    return buffer->ToI420();
+  const NV12BufferInterface* nv12 = buffer->GetNV12();
+  rtc::scoped_refptr<I420Buffer> i420 =
+      pool->CreateBuffer(nv12->width(), nv12->height());
+  if (!i420)
+    return buffer->ToI420();
+  if (libyuv::NV12ToI420(nv12->DataY(), nv12->StrideY(), nv12->DataUV(),
+                         nv12->StrideUV(), i420->MutableDataY(),
+                         i420->StrideY(), i420->MutableDataU(),
+                         i420->StrideU(), i420->MutableDataV(),
+                         i420->StrideV(), nv12->width(),
+                         nv12->height()) != 0) {
+    return nullptr;
+  }
+  return i420;
+}
+
 double I420SSE(const I420BufferInterface& ref_buffer,
                const I420BufferInterface& test_buffer) {
   RTC_DCHECK_EQ(ref_buffer.width(), test_buffer.width());
@@ -15,6 +15,7 @@
 
 #include "api/video/i010_buffer.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/time_utils.h"
 #include "test/fake_texture_frame.h"
@@ -518,4 +519,19 @@ INSTANTIATE_TEST_SUITE_P(
                        ::testing::Values(VideoFrameBuffer::Type::kI420,
                                          VideoFrameBuffer::Type::kI010)));
 
+TEST(TestNV12Buffer, ConvertsToAndFromI420) {
+  rtc::scoped_refptr<PlanarYuvBuffer> i420 =
+      CreateGradient(VideoFrameBuffer::Type::kI420, 640, 480);
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Copy(*i420->GetI420());
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, nv12->type());
+  EXPECT_EQ(640, nv12->width());
+  EXPECT_EQ(480, nv12->height());
+  EXPECT_EQ(320, nv12->ChromaWidth());
+  EXPECT_EQ(240, nv12->ChromaHeight());
+  EXPECT_EQ(nv12.get(), nv12->GetNV12());
+  // Interleaving the chroma planes is lossless.
+  EXPECT_TRUE(test::FrameBufsEqual(i420, nv12->ToI420()));
+  EXPECT_TRUE(test::FrameBufsEqual(i420, NV12Buffer::Copy(*nv12)->ToI420()));
+}
+
 }  // namespace webrtc
@@ -17,7 +17,6 @@
 
 #include "absl/memory/memory.h"
 #include "logging/rtc_event_log/encoder/var_int.h"
-#include "rtc_base/bit_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/logging.h"
@@ -106,13 +105,17 @@ constexpr bool kDefaultSignedDeltas = false;
 constexpr bool kDefaultValuesOptional = false;
 constexpr uint64_t kDefaultValueWidthBits = 64;
 
-// Wrap BitBufferWriter and extend its functionality by (1) keeping track of
-// the number of bits written and (2) owning its buffer.
+// Writes bits, higher bits before lower bits, into a buffer it owns,
+// producing the same bitstream as rtc::BitBufferWriter would. Rather than
+// merging every write into the buffer byte by byte, the bits are packed in a
+// 64-bit word that is stored once it's full.
 class BitWriter final {
  public:
   explicit BitWriter(size_t byte_count)
-      : buffer_(byte_count, '\0'),
-        bit_writer_(reinterpret_cast<uint8_t*>(&buffer_[0]), buffer_.size()),
+      : buffer_(byte_count + sizeof(uint64_t), '\0'),
+        word_(0),
+        word_bits_(0),
+        stored_bytes_(0),
         written_bits_(0),
         valid_(true) {
     RTC_DCHECK_GT(byte_count, 0);
@@ -120,9 +123,29 @@ class BitWriter final {
 
   void WriteBits(uint64_t val, size_t bit_count) {
     RTC_DCHECK(valid_);
-    const bool success = bit_writer_.WriteBits(val, bit_count);
-    RTC_DCHECK(success);
+    RTC_DCHECK_GT(bit_count, 0);
+    RTC_DCHECK_LE(bit_count, 64);
+    RTC_DCHECK_LE(BitsToBytes(written_bits_ + bit_count),
+                  buffer_.size() - sizeof(uint64_t));
+    if (bit_count < 64) {
+      val &= (uint64_t{1} << bit_count) - 1;
+    }
     written_bits_ += bit_count;
+
+    const size_t free_bits = 64 - word_bits_;
+    if (bit_count < free_bits) {
+      word_ = (word_ << bit_count) | val;
+      word_bits_ += bit_count;
+      return;
+    }
+
+    // Fill up the word, store it, and keep the rest of |val| for the next one.
+    const size_t remaining_bits = bit_count - free_bits;
+    const uint64_t word =
+        free_bits == 64 ? val : (word_ << free_bits) | (val >> remaining_bits);
+    StoreWord(word);
+    word_ = remaining_bits == 0 ? 0 : val;
+    word_bits_ = remaining_bits;
   }
 
   void WriteBits(const std::string& input) {
@@ -138,6 +161,9 @@ class BitWriter final {
     RTC_DCHECK(valid_);
     valid_ = false;
 
+    if (word_bits_ > 0) {
+      StoreWord(word_ << (64 - word_bits_));
+    }
     buffer_.resize(BitsToBytes(written_bits_));
     written_bits_ = 0;
 
@@ -147,8 +173,22 @@ class BitWriter final {
   }
 
  private:
+  // Stores |word| after the previously stored words. The buffer has room for
+  // a whole word past |byte_count|, so the last, partial word can be stored
+  // this way too.
+  void StoreWord(uint64_t word) {
+    RTC_DCHECK_LE(stored_bytes_ + sizeof(uint64_t), buffer_.size());
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      buffer_[stored_bytes_ + i] = static_cast<char>(word >> (56 - 8 * i));
+    }
+    stored_bytes_ += sizeof(uint64_t);
+  }
+
   std::string buffer_;
-  rtc::BitBufferWriter bit_writer_;
+  // The lowest |word_bits_| bits of |word_| are written, but not yet stored.
+  uint64_t word_;
+  size_t word_bits_;
+  size_t stored_bytes_;
   // Note: Counting bits instead of bytes wraps around earlier than it has to,
   // which means the maximum length is lower than it could be. We don't expect
   // to go anywhere near the limit, though, so this is good enough.
@@ -158,6 +198,80 @@ class BitWriter final {
   RTC_DISALLOW_COPY_AND_ASSIGN(BitWriter);
 };
 
+// Reads bits, higher bits before lower bits, like rtc::BitBuffer, but keeps
+// up to 64 bits of the input in a word, so that most reads are just shifts.
+// Does not own the buffer it reads.
+class BitReader final {
+ public:
+  BitReader(const uint8_t* bytes, size_t byte_count)
+      : bytes_(bytes), remaining_bytes_(byte_count), word_(0), word_bits_(0) {}
+
+  // Returns false, without consuming anything, if fewer than |bit_count| bits
+  // remain.
+  bool ReadBits(uint64_t* val, size_t bit_count) {
+    RTC_DCHECK(val);
+    RTC_DCHECK_GT(bit_count, 0);
+    RTC_DCHECK_LE(bit_count, 64);
+    if (bit_count > word_bits_ + 8 * remaining_bytes_) {
+      return false;
+    }
+    // At least 57 bits are available after refilling, so wider reads are done
+    // in two parts.
+    if (bit_count > 56) {
+      uint64_t lower_bits;
+      ReadAvailableBits(val, bit_count - 32);
+      ReadAvailableBits(&lower_bits, 32);
+      *val = (*val << 32) | lower_bits;
+      return true;
+    }
+    ReadAvailableBits(val, bit_count);
+    return true;
+  }
+
+ private:
+  void ReadAvailableBits(uint64_t* val, size_t bit_count) {
+    if (word_bits_ < bit_count) {
+      Refill();
+    }
+    RTC_DCHECK_LE(bit_count, word_bits_);
+    // The unread bits are kept in the highest bits of |word_|.
+    *val = word_ >> (64 - bit_count);
+    word_ <<= bit_count;
+    word_bits_ -= bit_count;
+  }
+
+  void Refill() {
+    RTC_DCHECK_LT(word_bits_, 64);
+    if (remaining_bytes_ >= sizeof(uint64_t)) {
+      // Load the next 8 bytes, and consume as many of them as fit whole.
+      // The bits of the next, partially loaded byte are loaded again by the
+      // next refill, at the same position, so they may be left in |word_|.
+      uint64_t next_word = 0;
+      for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        next_word |= static_cast<uint64_t>(bytes_[i]) << (56 - 8 * i);
+      }
+      word_ |= next_word >> word_bits_;
+      const size_t consumed_bytes = (63 - word_bits_) / 8;
+      bytes_ += consumed_bytes;
+      remaining_bytes_ -= consumed_bytes;
+      word_bits_ += 8 * consumed_bytes;
+      return;
+    }
+    while (word_bits_ <= 56 && remaining_bytes_ > 0) {
+      word_ |= static_cast<uint64_t>(*bytes_++) << (56 - word_bits_);
+      word_bits_ += 8;
+      --remaining_bytes_;
+    }
+  }
+
+  const uint8_t* bytes_;
+  size_t remaining_bytes_;
+  uint64_t word_;
+  size_t word_bits_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BitReader);
+};
+
 // Parameters for fixed-size delta-encoding/decoding.
 // These are tailored for the sequence which will be encoded (e.g. widths).
 class FixedLengthEncodingParameters final {
@@ -636,7 +750,7 @@ class FixedLengthDeltaDecoder final {
   // Therefore, it was deemed acceptable that |reader| does not own the buffer
   // it reads, meaning the lifetime of |this| must not exceed the lifetime
   // of |reader|'s underlying buffer.
-  FixedLengthDeltaDecoder(std::unique_ptr<rtc::BitBuffer> reader,
+  FixedLengthDeltaDecoder(std::unique_ptr<BitReader> reader,
                           const FixedLengthEncodingParameters& params,
                           absl::optional<uint64_t> base,
                           size_t num_of_deltas);
@@ -666,7 +780,7 @@ class FixedLengthDeltaDecoder final {
 
   // Reader of the input stream to be decoded. Does not own that buffer.
   // See comment above ctor for details.
-  const std::unique_ptr<rtc::BitBuffer> reader_;
+  const std::unique_ptr<BitReader> reader_;
 
   // The parameters according to which encoding will be done (width of
   // fields, whether signed deltas should be used, etc.)
@@ -688,10 +802,10 @@ bool FixedLengthDeltaDecoder::IsSuitableDecoderFor(const std::string& input) {
     return false;
   }
 
-  rtc::BitBuffer reader(reinterpret_cast<const uint8_t*>(&input[0]),
-                        kBitsInHeaderForEncodingType);
+  BitReader reader(reinterpret_cast<const uint8_t*>(&input[0]),
+                   input.length());
 
-  uint32_t encoding_type_bits;
+  uint64_t encoding_type_bits;
   const bool result =
       reader.ReadBits(&encoding_type_bits, kBitsInHeaderForEncodingType);
   RTC_DCHECK(result);
@@ -723,11 +837,11 @@ std::unique_ptr<FixedLengthDeltaDecoder> FixedLengthDeltaDecoder::Create(
     return nullptr;
   }
 
-  auto reader = std::make_unique<rtc::BitBuffer>(
+  auto reader = std::make_unique<BitReader>(
       reinterpret_cast<const uint8_t*>(&input[0]), input.length());
 
   // Encoding type
-  uint32_t encoding_type_bits;
+  uint64_t encoding_type_bits;
   const bool result =
       reader->ReadBits(&encoding_type_bits, kBitsInHeaderForEncodingType);
   RTC_DCHECK(result);
@@ -739,7 +853,7 @@ std::unique_ptr<FixedLengthDeltaDecoder> FixedLengthDeltaDecoder::Create(
     return nullptr;
   }
 
-  uint32_t read_buffer;
+  uint64_t read_buffer;
 
   // delta_width_bits
   if (!reader->ReadBits(&read_buffer, kBitsInHeaderForDeltaWidthBits)) {
@@ -795,7 +909,7 @@ std::unique_ptr<FixedLengthDeltaDecoder> FixedLengthDeltaDecoder::Create(
 }
 
 FixedLengthDeltaDecoder::FixedLengthDeltaDecoder(
-    std::unique_ptr<rtc::BitBuffer> reader,
+    std::unique_ptr<BitReader> reader,
     const FixedLengthEncodingParameters& params,
     absl::optional<uint64_t> base,
     size_t num_of_deltas)
@@ -809,10 +923,11 @@ FixedLengthDeltaDecoder::FixedLengthDeltaDecoder(
 std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
   RTC_DCHECK(reader_);
 
-  std::vector<bool> existing_values(num_of_deltas_);
+  std::vector<bool> existing_values;
   if (params_.values_optional()) {
+    existing_values.resize(num_of_deltas_);
     for (size_t i = 0; i < num_of_deltas_; ++i) {
-      uint32_t exists;
+      uint64_t exists;
       if (!reader_->ReadBits(&exists, 1u)) {
         RTC_LOG(LS_WARNING) << "Failed to read existence-indicating bit.";
         return std::vector<absl::optional<uint64_t>>();
@@ -820,16 +935,13 @@ std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
       RTC_DCHECK_LE(exists, 1u);
       existing_values[i] = (exists == 1);
     }
-  } else {
-    std::fill(existing_values.begin(), existing_values.end(), true);
   }
 
   absl::optional<uint64_t> previous = base_;
   std::vector<absl::optional<uint64_t>> values(num_of_deltas_);
 
   for (size_t i = 0; i < num_of_deltas_; ++i) {
-    if (!existing_values[i]) {
-      RTC_DCHECK(params_.values_optional());
+    if (params_.values_optional() && !existing_values[i]) {
       continue;
     }
 
@@ -859,41 +971,30 @@ std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
 
 bool FixedLengthDeltaDecoder::ParseVarInt(uint64_t* output) {
   RTC_DCHECK(reader_);
-  return DecodeVarInt(reader_.get(), output) != 0;
-}
-
-bool FixedLengthDeltaDecoder::ParseDelta(uint64_t* delta) {
-  RTC_DCHECK(reader_);
-
-  // BitBuffer and BitBufferWriter read/write higher bits before lower bits.
 
-  const size_t lower_bit_count =
-      std::min<uint64_t>(params_.delta_width_bits(), 32u);
-  const size_t higher_bit_count = (params_.delta_width_bits() <= 32u)
-                                      ? 0
-                                      : params_.delta_width_bits() - 32u;
-
-  uint32_t lower_bits;
-  uint32_t higher_bits;
-
-  if (higher_bit_count > 0) {
-    if (!reader_->ReadBits(&higher_bits, higher_bit_count)) {
-      RTC_LOG(LS_WARNING) << "Failed to read higher half of delta.";
+  uint64_t decoded = 0;
+  for (size_t i = 0; i < kMaxVarIntLengthBytes; ++i) {
+    uint64_t byte;
+    if (!reader_->ReadBits(&byte, 8)) {
       return false;
     }
-  } else {
-    higher_bits = 0;
+    decoded += (byte & 0x7f) << static_cast<uint64_t>(7 * i);
+    if (!(byte & 0x80)) {
+      *output = decoded;
+      return true;
+    }
   }
 
-  if (!reader_->ReadBits(&lower_bits, lower_bit_count)) {
-    RTC_LOG(LS_WARNING) << "Failed to read lower half of delta.";
-    return false;
-  }
+  return false;
+}
 
-  const uint64_t lower_bits_64 = static_cast<uint64_t>(lower_bits);
-  const uint64_t higher_bits_64 = static_cast<uint64_t>(higher_bits);
+bool FixedLengthDeltaDecoder::ParseDelta(uint64_t* delta) {
+  RTC_DCHECK(reader_);
 
-  *delta = (higher_bits_64 << 32) | lower_bits_64;
+  if (!reader_->ReadBits(delta, params_.delta_width_bits())) {
+    RTC_LOG(LS_WARNING) << "Failed to read delta.";
+    return false;
+  }
   return true;
 }
 
@@ -11,6 +11,7 @@
 #include <deque>
 #include <limits>
 #include <memory>
+#include <sstream>  // no-presubmit-check TODO(webrtc:8982)
 #include <string>
 #include <tuple>
 
@@ -218,6 +219,38 @@ TEST_P(RtcEventLogEncoderTest, RtcEventAlrState) {
   }
 }
 
+TEST_P(RtcEventLogEncoderTest, ParseStreamInChunks) {
+  std::vector<std::unique_ptr<RtcEventAlrState>> events(event_count_);
+  std::string encoded;
+  for (size_t i = 0; i < event_count_; ++i) {
+    events[i] = gen_.NewAlrState();
+    history_.clear();
+    history_.push_back(events[i]->Copy());
+    // Encode the events one by one so that each one is a separate message.
+    encoded += encoder_->EncodeBatch(history_.begin(), history_.end());
+  }
+
+  std::vector<LoggedAlrStateEvent> alr_state_events;
+  size_t num_chunks = 0;
+  std::istringstream stream(encoded);  // no-presubmit-check TODO(webrtc:8982)
+  ASSERT_TRUE(parsed_log_.ParseStreamInChunks(
+      stream, /*chunk_size_bytes=*/1, [&](const ParsedRtcEventLog& chunk) {
+        ++num_chunks;
+        // A chunk contains at least one message, hence at most one event.
+        EXPECT_LE(chunk.alr_state_events().size(), 1u);
+        alr_state_events.insert(alr_state_events.end(),
+                                chunk.alr_state_events().begin(),
+                                chunk.alr_state_events().end());
+        return true;
+      }));
+  // One chunk per event, and one for the end of the log.
+  EXPECT_EQ(num_chunks, event_count_ + 1);
+  ASSERT_EQ(alr_state_events.size(), event_count_);
+  for (size_t i = 0; i < event_count_; ++i) {
+    verifier_.VerifyLoggedAlrStateEvent(*events[i], alr_state_events[i]);
+  }
+}
+
 TEST_P(RtcEventLogEncoderTest, RtcEventRouteChange) {
   if (!new_encoding_) {
     return;
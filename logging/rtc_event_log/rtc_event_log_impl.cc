@@ -35,6 +35,10 @@ constexpr size_t kMaxEventsInHistory = 10000;
 // The config-history is supposed to be unbounded, but needs to have some bound
 // to prevent an attack via unreasonable memory use.
 constexpr size_t kMaxEventsInConfigHistory = 1000;
+// Bounds the memory used by events that the task queue hasn't processed yet,
+// e.g. because it is busy writing the output. Configuration events are never
+// dropped.
+constexpr size_t kMaxPendingEvents = kMaxEventsInHistory;
 
 std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
     RtcEventLog::EncodingType type) {
@@ -56,7 +60,8 @@ std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
 
 RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
                                  TaskQueueFactory* task_queue_factory)
-    : event_encoder_(CreateEncoder(encoding_type)),
+    : num_dropped_events_(0),
+      event_encoder_(CreateEncoder(encoding_type)),
       num_config_events_written_(0),
       last_output_ms_(rtc::TimeMillis()),
       output_scheduled_(false),
@@ -143,13 +148,45 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
 
+  {
+    rtc::CritScope lock(&pending_events_lock_);
+    if (pending_events_.size() >= kMaxPendingEvents &&
+        !event->IsConfigEvent()) {
+      ++num_dropped_events_;
+      return;
+    }
+    pending_events_.push_back(std::move(event));
+    // Otherwise a task that will process the event is already posted.
+    if (pending_events_.size() > 1)
+      return;
+  }
+
   // Binding to |this| is safe because |this| outlives the |task_queue_|.
-  task_queue_->PostTask([this, event = std::move(event)]() mutable {
+  task_queue_->PostTask([this] {
     RTC_DCHECK_RUN_ON(task_queue_.get());
+    ProcessPendingEvents();
+  });
+}
+
+void RtcEventLogImpl::ProcessPendingEvents() {
+  std::vector<std::unique_ptr<RtcEvent>> events;
+  size_t num_dropped_events;
+  {
+    rtc::CritScope lock(&pending_events_lock_);
+    events.swap(pending_events_);
+    num_dropped_events = num_dropped_events_;
+    num_dropped_events_ = 0;
+  }
+  if (num_dropped_events > 0) {
+    RTC_LOG(LS_WARNING) << "Dropped " << num_dropped_events
+                        << " RTC events since the event log fell behind.";
+  }
+
+  for (std::unique_ptr<RtcEvent>& event : events) {
     LogToMemory(std::move(event));
     if (event_output_)
       ScheduleOutput();
-  });
+  }
 }
 
 void RtcEventLogImpl::ScheduleOutput() {
@@ -16,6 +16,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/rtc_event_log/rtc_event.h"
@@ -23,6 +24,7 @@
 #include "api/rtc_event_log_output.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
@@ -48,6 +50,8 @@ class RtcEventLogImpl final : public RtcEventLog {
   void Log(std::unique_ptr<RtcEvent> event) override;
 
  private:
+  // Moves the events buffered by Log() to the history.
+  void ProcessPendingEvents() RTC_RUN_ON(task_queue_);
   void LogToMemory(std::unique_ptr<RtcEvent> event) RTC_RUN_ON(task_queue_);
   void LogEventsFromMemoryToOutput() RTC_RUN_ON(task_queue_);
 
@@ -62,6 +66,15 @@ class RtcEventLogImpl final : public RtcEventLog {
 
   void ScheduleOutput() RTC_RUN_ON(task_queue_);
 
+  // Events logged since the last ProcessPendingEvents() task. Log() only posts
+  // a task when this goes from empty to non-empty, so that events logged in a
+  // burst are processed in one task instead of one task per event.
+  rtc::CriticalSection pending_events_lock_;
+  std::vector<std::unique_ptr<RtcEvent>> pending_events_
+      RTC_GUARDED_BY(pending_events_lock_);
+  // Non-configuration events dropped because |pending_events_| was full.
+  size_t num_dropped_events_ RTC_GUARDED_BY(pending_events_lock_);
+
   // History containing all past configuration events.
   std::deque<std::unique_ptr<RtcEvent>> config_history_
       RTC_GUARDED_BY(*task_queue_);
@@ -975,6 +975,21 @@ void ParsedRtcEventLog::Clear() {
   outgoing_video_ssrcs_.clear();
   outgoing_audio_ssrcs_.clear();
 
+  ClearEvents();
+
+  audio_recv_configs_.clear();
+  audio_send_configs_.clear();
+  video_recv_configs_.clear();
+  video_send_configs_.clear();
+
+  memset(last_incoming_rtcp_packet_, 0, IP_PACKET_SIZE);
+  last_incoming_rtcp_packet_length_ = 0;
+
+  incoming_rtp_extensions_maps_.clear();
+  outgoing_rtp_extensions_maps_.clear();
+}
+
+void ParsedRtcEventLog::ClearEvents() {
   incoming_rtp_packets_map_.clear();
   outgoing_rtp_packets_map_.clear();
   incoming_rtp_packets_by_ssrc_.clear();
@@ -989,10 +1004,16 @@ void ParsedRtcEventLog::Clear() {
   outgoing_rr_.clear();
   incoming_sr_.clear();
   outgoing_sr_.clear();
+  incoming_xr_.clear();
+  outgoing_xr_.clear();
   incoming_nack_.clear();
   outgoing_nack_.clear();
   incoming_remb_.clear();
   outgoing_remb_.clear();
+  incoming_fir_.clear();
+  outgoing_fir_.clear();
+  incoming_pli_.clear();
+  outgoing_pli_.clear();
   incoming_transport_feedback_.clear();
   outgoing_transport_feedback_.clear();
   incoming_loss_notification_.clear();
@@ -1012,19 +1033,14 @@ void ParsedRtcEventLog::Clear() {
   alr_state_events_.clear();
   ice_candidate_pair_configs_.clear();
   ice_candidate_pair_events_.clear();
-  audio_recv_configs_.clear();
-  audio_send_configs_.clear();
-  video_recv_configs_.clear();
-  video_send_configs_.clear();
-
-  memset(last_incoming_rtcp_packet_, 0, IP_PACKET_SIZE);
-  last_incoming_rtcp_packet_length_ = 0;
+  generic_packets_received_.clear();
+  generic_packets_sent_.clear();
+  generic_acks_received_.clear();
+  route_change_events_.clear();
+  remote_estimate_events_.clear();
 
   first_timestamp_ = std::numeric_limits<int64_t>::max();
   last_timestamp_ = std::numeric_limits<int64_t>::min();
-
-  incoming_rtp_extensions_maps_.clear();
-  outgoing_rtp_extensions_maps_.clear();
 }
 
 bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
@@ -1047,8 +1063,24 @@ bool ParsedRtcEventLog::ParseString(const std::string& s) {
 bool ParsedRtcEventLog::ParseStream(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
   Clear();
-  bool success = ParseStreamInternal(stream);
+  bool success = ParseStreamInternal(stream, 0, nullptr);
+  OrganizeParsedEvents();
+  return success;
+}
+
+bool ParsedRtcEventLog::ParseStreamInChunks(
+    std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
+    size_t chunk_size_bytes,
+    const std::function<bool(const ParsedRtcEventLog&)>& callback) {
+  Clear();
+  if (!ParseStreamInternal(stream, chunk_size_bytes, &callback))
+    return false;
+  // Deliver the last, possibly smaller, chunk.
+  OrganizeParsedEvents();
+  return callback(*this);
+}
 
+void ParsedRtcEventLog::OrganizeParsedEvents() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1156,14 +1188,15 @@ bool ParsedRtcEventLog::ParseStream(
   StoreFirstAndLastTimestamp(generic_packets_sent_);
   StoreFirstAndLastTimestamp(generic_packets_received_);
   StoreFirstAndLastTimestamp(generic_acks_received_);
-
-  return success;
 }
 
 bool ParsedRtcEventLog::ParseStreamInternal(
-    std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
+    std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
+    size_t chunk_size_bytes,
+    const std::function<bool(const ParsedRtcEventLog&)>* chunk_callback) {
   constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
   std::vector<char> buffer(0xFFFF);
+  size_t chunk_bytes_read = 0;
 
   RTC_DCHECK(stream.good());
 
@@ -1238,6 +1271,15 @@ bool ParsedRtcEventLog::ParseStreamInternal(
       }
       StoreParsedNewFormatEvent(event_stream);
     }
+
+    chunk_bytes_read += buffer_size;
+    if (chunk_callback && chunk_bytes_read >= chunk_size_bytes) {
+      OrganizeParsedEvents();
+      if (!(*chunk_callback)(*this))
+        return false;
+      ClearEvents();
+      chunk_bytes_read = 0;
+    }
   }
   return true;
 }
@@ -10,6 +10,7 @@
 #ifndef LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_PARSER_H_
 #define LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_PARSER_H_
 
+#include <functional>
 #include <iterator>
 #include <map>
 #include <set>
@@ -310,6 +311,20 @@ class ParsedRtcEventLog {
   bool ParseStream(
       std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
 
+  // Reads an RtcEventLog from an istream in chunks, so that logs that are too
+  // large to be held in memory can be processed. Whenever at least
+  // |chunk_size_bytes| of the log have been read, and at the end of the log,
+  // |callback| is called with this object holding the events of that chunk,
+  // organized as after ParseStream(). The events are cleared before the next
+  // chunk is read. Stream configurations and header extension maps are kept
+  // for the whole log, since they are needed to interpret later events.
+  // Returns true if the log was parsed successfully and |callback| returned
+  // true for every chunk; parsing stops early if it returns false.
+  bool ParseStreamInChunks(
+      std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
+      size_t chunk_size_bytes,
+      const std::function<bool(const ParsedRtcEventLog&)>& callback);
+
   MediaType GetMediaType(uint32_t ssrc, PacketDirection direction) const;
 
   // Configured SSRCs.
@@ -567,8 +582,19 @@ class ParsedRtcEventLog {
   std::vector<InferredRouteChangeEvent> GetRouteChanges() const;
 
  private:
+  // Calls |chunk_callback|, if set, whenever |chunk_size_bytes| of the log
+  // have been read, as described for ParseStreamInChunks().
   bool ParseStreamInternal(
-      std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
+      std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
+      size_t chunk_size_bytes,
+      const std::function<bool(const ParsedRtcEventLog&)>* chunk_callback);
+
+  // Clears the parsed events, but not the stream configurations and state
+  // needed to parse further events.
+  void ClearEvents();
+  // Builds the per-SSRC packet lists, RTCP convenience wrappers and first and
+  // last timestamps from the events parsed since the last ClearEvents().
+  void OrganizeParsedEvents();
 
   void StoreParsedLegacyEvent(const rtclog::Event& event);
 
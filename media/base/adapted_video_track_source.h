@@ -68,6 +68,13 @@ class RTC_EXPORT AdaptedVideoTrackSource
 
   cricket::VideoAdapter* video_adapter() { return &video_adapter_; }
 
+  // Called with the combined wants of the sinks whenever a sink is added,
+  // updated or removed. Sources that can change their capture size or rate,
+  // e.g. by reconfiguring a device, can override this to avoid producing
+  // frames that are only downscaled or dropped. Overrides must call this
+  // implementation, which configures the video adapter.
+  virtual void OnSinkWantsChanged(const rtc::VideoSinkWants& wants);
+
  private:
   // Implements rtc::VideoSourceInterface.
   void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
@@ -77,8 +84,6 @@ class RTC_EXPORT AdaptedVideoTrackSource
   // Part of VideoTrackSourceInterface.
   bool GetStats(Stats* stats) override;
 
-  void OnSinkWantsChanged(const rtc::VideoSinkWants& wants);
-
   cricket::VideoAdapter video_adapter_;
 
   rtc::CriticalSection stats_crit_;
@@ -10,6 +10,9 @@
 
 #include "media/base/video_broadcaster.h"
 
+#include <algorithm>
+#include <deque>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -17,10 +20,101 @@
 #include "api/video/video_rotation.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
+// Frames waiting to be delivered to one sink, on a task queue of its own.
+class VideoBroadcaster::AsyncSinkQueue {
+ public:
+  AsyncSinkQueue(VideoSinkInterface<webrtc::VideoFrame>* sink,
+                 webrtc::TaskQueueFactory* task_queue_factory,
+                 size_t max_queued_frames)
+      : sink_(sink),
+        max_queued_frames_(max_queued_frames),
+        task_queue_(task_queue_factory->CreateTaskQueue(
+            "VideoSinkDelivery",
+            webrtc::TaskQueueFactory::Priority::NORMAL)) {}
+
+  void OnFrame(const webrtc::VideoFrame& frame) {
+    {
+      rtc::CritScope cs(&crit_);
+      if (frames_.size() >= max_queued_frames_) {
+        if (stats_.frames_dropped == 0)
+          RTC_LOG(LS_WARNING) << "Video sink is too slow, dropping frames.";
+        frames_.pop_front();
+        ++stats_.frames_dropped;
+        // The update rect of the dropped frame is lost.
+        needs_full_update_ = true;
+      }
+      frames_.push_back(frame);
+      if (delivery_pending_)
+        return;
+      delivery_pending_ = true;
+    }
+    task_queue_.PostTask([this] { DeliverQueuedFrames(); });
+  }
+
+  void OnDiscardedFrame() {
+    task_queue_.PostTask([this] { sink_->OnDiscardedFrame(); });
+  }
+
+  SinkDeliveryStats stats() const {
+    rtc::CritScope cs(&crit_);
+    return stats_;
+  }
+
+ private:
+  void DeliverQueuedFrames() {
+    while (true) {
+      absl::optional<webrtc::VideoFrame> frame;
+      {
+        rtc::CritScope cs(&crit_);
+        if (frames_.empty()) {
+          delivery_pending_ = false;
+          return;
+        }
+        frame = std::move(frames_.front());
+        frames_.pop_front();
+        if (needs_full_update_) {
+          frame->set_update_rect(webrtc::VideoFrame::UpdateRect{
+              0, 0, frame->width(), frame->height()});
+          needs_full_update_ = false;
+        }
+      }
+      const int64_t start_time_us = rtc::TimeMicros();
+      sink_->OnFrame(*frame);
+      const int64_t delivery_time_us = rtc::TimeMicros() - start_time_us;
+      rtc::CritScope cs(&crit_);
+      ++stats_.frames_delivered;
+      stats_.max_delivery_time_us =
+          std::max(stats_.max_delivery_time_us, delivery_time_us);
+    }
+  }
+
+  VideoSinkInterface<webrtc::VideoFrame>* const sink_;
+  const size_t max_queued_frames_;
+  rtc::CriticalSection crit_;
+  std::deque<webrtc::VideoFrame> frames_ RTC_GUARDED_BY(crit_);
+  bool delivery_pending_ RTC_GUARDED_BY(crit_) = false;
+  bool needs_full_update_ RTC_GUARDED_BY(crit_) = false;
+  SinkDeliveryStats stats_ RTC_GUARDED_BY(crit_);
+  // Declared last, so that it is destroyed, and its pending tasks with it,
+  // before the members they use.
+  rtc::TaskQueue task_queue_;
+};
+
 VideoBroadcaster::VideoBroadcaster() = default;
+
+VideoBroadcaster::VideoBroadcaster(webrtc::TaskQueueFactory* task_queue_factory,
+                                   size_t max_queued_frames)
+    : task_queue_factory_(task_queue_factory),
+      max_queued_frames_(max_queued_frames) {
+  RTC_DCHECK(task_queue_factory_);
+  RTC_DCHECK_GT(max_queued_frames_, 0);
+}
+
 VideoBroadcaster::~VideoBroadcaster() = default;
 
 void VideoBroadcaster::AddOrUpdateSink(
@@ -31,6 +125,10 @@ void VideoBroadcaster::AddOrUpdateSink(
   if (!FindSinkPair(sink)) {
     // |Sink| is a new sink, which didn't receive previous frame.
     previous_frame_sent_to_all_sinks_ = false;
+    if (task_queue_factory_) {
+      async_sink_queues_[sink] = std::make_unique<AsyncSinkQueue>(
+          sink, task_queue_factory_, max_queued_frames_);
+    }
   }
   VideoSourceBase::AddOrUpdateSink(sink, wants);
   UpdateWants();
@@ -39,9 +137,21 @@ void VideoBroadcaster::AddOrUpdateSink(
 void VideoBroadcaster::RemoveSink(
     VideoSinkInterface<webrtc::VideoFrame>* sink) {
   RTC_DCHECK(sink != nullptr);
-  rtc::CritScope cs(&sinks_and_wants_lock_);
-  VideoSourceBase::RemoveSink(sink);
-  UpdateWants();
+  std::unique_ptr<AsyncSinkQueue> async_sink_queue;
+  {
+    rtc::CritScope cs(&sinks_and_wants_lock_);
+    VideoSourceBase::RemoveSink(sink);
+    UpdateWants();
+    auto it = async_sink_queues_.find(sink);
+    if (it != async_sink_queues_.end()) {
+      async_sink_queue = std::move(it->second);
+      async_sink_queues_.erase(it);
+    }
+  }
+  // Waits for a frame being delivered to |sink|, and drops the frames still
+  // waiting. Done without holding the lock, in case the sink calls back into
+  // the broadcaster.
+  async_sink_queue = nullptr;
 }
 
 bool VideoBroadcaster::frame_wanted() const {
@@ -65,7 +175,7 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
       // with rotation still pending. Protect sinks that don't expect any
       // pending rotation.
       RTC_LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
-      sink_pair.sink->OnDiscardedFrame();
+      DeliverDiscardedFrame(sink_pair.sink);
       current_frame_was_discarded = true;
       continue;
     }
@@ -78,26 +188,37 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
               .set_timestamp_us(frame.timestamp_us())
               .set_id(frame.id())
               .build();
-      sink_pair.sink->OnFrame(black_frame);
+      DeliverFrame(sink_pair.sink, black_frame);
     } else if (!previous_frame_sent_to_all_sinks_) {
       // Since last frame was not sent to some sinks, full update is needed.
       webrtc::VideoFrame copy = frame;
       copy.set_update_rect(
           webrtc::VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      sink_pair.sink->OnFrame(copy);
+      DeliverFrame(sink_pair.sink, copy);
     } else {
-      sink_pair.sink->OnFrame(frame);
+      DeliverFrame(sink_pair.sink, frame);
     }
   }
   previous_frame_sent_to_all_sinks_ = !current_frame_was_discarded;
 }
 
 void VideoBroadcaster::OnDiscardedFrame() {
+  rtc::CritScope cs(&sinks_and_wants_lock_);
   for (auto& sink_pair : sink_pairs()) {
-    sink_pair.sink->OnDiscardedFrame();
+    DeliverDiscardedFrame(sink_pair.sink);
   }
 }
 
+absl::optional<VideoBroadcaster::SinkDeliveryStats>
+VideoBroadcaster::GetSinkDeliveryStats(
+    const VideoSinkInterface<webrtc::VideoFrame>* sink) const {
+  rtc::CritScope cs(&sinks_and_wants_lock_);
+  auto it = async_sink_queues_.find(sink);
+  if (it == async_sink_queues_.end())
+    return absl::nullopt;
+  return it->second->stats();
+}
+
 void VideoBroadcaster::UpdateWants() {
   VideoSinkWants wants;
   wants.rotation_applied = false;
@@ -132,6 +253,27 @@ void VideoBroadcaster::UpdateWants() {
   current_wants_ = wants;
 }
 
+void VideoBroadcaster::DeliverFrame(
+    VideoSinkInterface<webrtc::VideoFrame>* sink,
+    const webrtc::VideoFrame& frame) {
+  if (!task_queue_factory_) {
+    sink->OnFrame(frame);
+    return;
+  }
+  RTC_DCHECK(async_sink_queues_.count(sink));
+  async_sink_queues_[sink]->OnFrame(frame);
+}
+
+void VideoBroadcaster::DeliverDiscardedFrame(
+    VideoSinkInterface<webrtc::VideoFrame>* sink) {
+  if (!task_queue_factory_) {
+    sink->OnDiscardedFrame();
+    return;
+  }
+  RTC_DCHECK(async_sink_queues_.count(sink));
+  async_sink_queues_[sink]->OnDiscardedFrame();
+}
+
 const rtc::scoped_refptr<webrtc::VideoFrameBuffer>&
 VideoBroadcaster::GetBlackFrameBuffer(int width, int height) {
   if (!black_frame_buffer_ || black_frame_buffer_->width() != width ||
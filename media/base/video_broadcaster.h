@@ -11,7 +11,12 @@
 #ifndef MEDIA_BASE_VIDEO_BROADCASTER_H_
 #define MEDIA_BASE_VIDEO_BROADCASTER_H_
 
+#include <map>
+#include <memory>
+
+#include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_source_interface.h"
 #include "media/base/video_source_base.h"
@@ -29,7 +34,22 @@ namespace rtc {
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<webrtc::VideoFrame> {
  public:
+  struct SinkDeliveryStats {
+    int frames_delivered = 0;
+    // Frames dropped because the sink did not keep up.
+    int frames_dropped = 0;
+    // The longest time the sink has spent in a call to OnFrame.
+    int64_t max_delivery_time_us = 0;
+  };
+
   VideoBroadcaster();
+  // Delivers frames asynchronously instead of on the thread calling OnFrame.
+  // Each sink gets a task queue of its own, created by |task_queue_factory|,
+  // and at most |max_queued_frames| frames waiting for it. When a sink falls
+  // behind, its oldest waiting frame is dropped, so that a slow sink delays
+  // neither the source nor the other sinks.
+  VideoBroadcaster(webrtc::TaskQueueFactory* task_queue_factory,
+                   size_t max_queued_frames);
   ~VideoBroadcaster() override;
   void AddOrUpdateSink(VideoSinkInterface<webrtc::VideoFrame>* sink,
                        const VideoSinkWants& wants) override;
@@ -50,6 +70,11 @@ class VideoBroadcaster : public VideoSourceBase,
 
   void OnDiscardedFrame() override;
 
+  // Returns the delivery stats of |sink|, or nothing if frames are delivered
+  // synchronously or |sink| has not been added.
+  absl::optional<SinkDeliveryStats> GetSinkDeliveryStats(
+      const VideoSinkInterface<webrtc::VideoFrame>* sink) const;
+
  protected:
   void UpdateWants() RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
   const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& GetBlackFrameBuffer(
@@ -62,6 +87,22 @@ class VideoBroadcaster : public VideoSourceBase,
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
   bool previous_frame_sent_to_all_sinks_ RTC_GUARDED_BY(sinks_and_wants_lock_) =
       true;
+
+ private:
+  class AsyncSinkQueue;
+
+  void DeliverFrame(VideoSinkInterface<webrtc::VideoFrame>* sink,
+                    const webrtc::VideoFrame& frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+  void DeliverDiscardedFrame(VideoSinkInterface<webrtc::VideoFrame>* sink)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+
+  webrtc::TaskQueueFactory* const task_queue_factory_ = nullptr;
+  const size_t max_queued_frames_ = 0;
+  // One queue per sink when delivering asynchronously, otherwise empty.
+  std::map<const VideoSinkInterface<webrtc::VideoFrame>*,
+           std::unique_ptr<AsyncSinkQueue>>
+      async_sink_queues_ RTC_GUARDED_BY(sinks_and_wants_lock_);
 };
 
 }  // namespace rtc
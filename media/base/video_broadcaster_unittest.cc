@@ -11,12 +11,17 @@
 #include "media/base/video_broadcaster.h"
 
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_rotation.h"
 #include "media/base/fake_video_renderer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "test/gtest.h"
 
 using cricket::FakeVideoRenderer;
@@ -205,3 +210,117 @@ TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   EXPECT_TRUE(sink2.black_frame());
   EXPECT_EQ(30, sink2.timestamp_us());
 }
+
+namespace {
+
+constexpr int kTimeoutMs = 5000;
+
+webrtc::VideoFrame CreateFrame(int64_t timestamp_us) {
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer);
+  return webrtc::VideoFrame::Builder()
+      .set_video_frame_buffer(buffer)
+      .set_rotation(webrtc::kVideoRotation_0)
+      .set_timestamp_us(timestamp_us)
+      .build();
+}
+
+// Blocks in OnFrame until unblocked.
+class BlockingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    {
+      rtc::CritScope cs(&crit_);
+      frames_.push_back(frame);
+    }
+    frame_entered_.Set();
+    unblock_.Wait(rtc::Event::kForever);
+  }
+
+  bool WaitForFrame() { return frame_entered_.Wait(kTimeoutMs); }
+  void Unblock() { unblock_.Set(); }
+
+  std::vector<webrtc::VideoFrame> frames() const {
+    rtc::CritScope cs(&crit_);
+    return frames_;
+  }
+
+ private:
+  rtc::Event frame_entered_;
+  rtc::Event unblock_{/*manual_reset=*/true, /*initially_signaled=*/false};
+  rtc::CriticalSection crit_;
+  std::vector<webrtc::VideoFrame> frames_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace
+
+TEST(VideoBroadcasterTest, AsyncDeliveryDeliversFramesToAllSinks) {
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
+      webrtc::CreateDefaultTaskQueueFactory();
+  VideoBroadcaster broadcaster(task_queue_factory.get(), 1);
+  FakeVideoRenderer sink1;
+  FakeVideoRenderer sink2;
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&sink2, rtc::VideoSinkWants());
+
+  broadcaster.OnFrame(CreateFrame(10));
+  EXPECT_TRUE(sink1.WaitForRenderedFrame(kTimeoutMs));
+  EXPECT_TRUE(sink2.WaitForRenderedFrame(kTimeoutMs));
+  EXPECT_EQ(10, sink1.timestamp_us());
+  EXPECT_EQ(10, sink2.timestamp_us());
+
+  broadcaster.RemoveSink(&sink1);
+  EXPECT_FALSE(broadcaster.GetSinkDeliveryStats(&sink1));
+  ASSERT_TRUE(broadcaster.GetSinkDeliveryStats(&sink2));
+  EXPECT_EQ(0, broadcaster.GetSinkDeliveryStats(&sink2)->frames_dropped);
+  broadcaster.RemoveSink(&sink2);
+}
+
+TEST(VideoBroadcasterTest, NoDeliveryStatsForSynchronousDelivery) {
+  VideoBroadcaster broadcaster;
+  FakeVideoRenderer sink;
+  broadcaster.AddOrUpdateSink(&sink, rtc::VideoSinkWants());
+  EXPECT_FALSE(broadcaster.GetSinkDeliveryStats(&sink));
+}
+
+TEST(VideoBroadcasterTest, AsyncDeliveryDropsOldestFramesForSlowSink) {
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
+      webrtc::CreateDefaultTaskQueueFactory();
+  VideoBroadcaster broadcaster(task_queue_factory.get(), 1);
+  BlockingSink slow_sink;
+  FakeVideoRenderer fast_sink;
+  broadcaster.AddOrUpdateSink(&slow_sink, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&fast_sink, rtc::VideoSinkWants());
+
+  broadcaster.OnFrame(CreateFrame(1));
+  ASSERT_TRUE(slow_sink.WaitForFrame());
+
+  // The slow sink is blocked on the first frame. The second frame is
+  // dropped from its queue to make room for the third.
+  broadcaster.OnFrame(CreateFrame(2));
+  webrtc::VideoFrame frame3 = CreateFrame(3);
+  frame3.set_update_rect(webrtc::VideoFrame::UpdateRect{0, 0, 10, 10});
+  broadcaster.OnFrame(frame3);
+  EXPECT_EQ(1, broadcaster.GetSinkDeliveryStats(&slow_sink)->frames_dropped);
+  EXPECT_EQ(0, broadcaster.GetSinkDeliveryStats(&fast_sink)->frames_dropped);
+
+  // The fast sink is not held up by the slow one.
+  for (int i = 0; i < 3 && fast_sink.num_rendered_frames() < 3; ++i)
+    EXPECT_TRUE(fast_sink.WaitForRenderedFrame(kTimeoutMs));
+  EXPECT_EQ(3, fast_sink.num_rendered_frames());
+  EXPECT_EQ(3, fast_sink.timestamp_us());
+
+  slow_sink.Unblock();
+  ASSERT_TRUE(slow_sink.WaitForFrame());
+  broadcaster.RemoveSink(&slow_sink);
+  std::vector<webrtc::VideoFrame> frames = slow_sink.frames();
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_EQ(1, frames[0].timestamp_us());
+  EXPECT_EQ(3, frames[1].timestamp_us());
+  // The update rect of the dropped frame is lost, so the next frame is a full
+  // update.
+  EXPECT_EQ(100, frames[1].update_rect().width);
+  EXPECT_EQ(50, frames[1].update_rect().height);
+  broadcaster.RemoveSink(&fast_sink);
+}
@@ -14,22 +14,28 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/i420_scaled_buffer_cache.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "api/video_codecs/video_encoder_software_fallback_wrapper.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
@@ -149,7 +155,9 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       encoded_complete_callback_(nullptr),
       experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()),
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
-                                    .Vp8BoostBaseLayerQuality()) {
+                                    .Vp8BoostBaseLayerQuality()),
+      parallel_encoding_(field_trial::IsEnabled(
+          "WebRTC-SimulcastEncoderAdapter-ParallelEncoding")) {
   RTC_DCHECK(primary_factory);
   encoder_info_.implementation_name = "SimulcastEncoderAdapter";
 
@@ -353,6 +361,8 @@ int SimulcastEncoderAdapter::InitEncode(
             encoder_impl_info.is_hardware_accelerated;
         encoder_info_.has_internal_source =
             encoder_impl_info.has_internal_source;
+        encoder_info_.preferred_pixel_formats =
+            encoder_impl_info.preferred_pixel_formats;
       } else {
         encoder_info_.implementation_name += ", ";
         encoder_info_.implementation_name +=
@@ -376,6 +386,17 @@ int SimulcastEncoderAdapter::InitEncode(
         // Has internal source only if all encoders have it.
         encoder_info_.has_internal_source &=
             encoder_impl_info.has_internal_source;
+
+        // Pixel formats that all encoders take.
+        encoder_info_.preferred_pixel_formats.erase(
+            std::remove_if(
+                encoder_info_.preferred_pixel_formats.begin(),
+                encoder_info_.preferred_pixel_formats.end(),
+                [&encoder_impl_info](VideoFrameBuffer::Type type) {
+                  return !absl::c_linear_search(
+                      encoder_impl_info.preferred_pixel_formats, type);
+                }),
+            encoder_info_.preferred_pixel_formats.end());
       }
       encoder_info_.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
     }
@@ -424,74 +445,163 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  const VideoFrameType frame_type = send_key_frame
+                                        ? VideoFrameType::kVideoFrameKey
+                                        : VideoFrameType::kVideoFrameDelta;
+  std::vector<size_t> stream_indices;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream) {
       continue;
     }
-
-    std::vector<VideoFrameType> stream_frame_types;
     if (send_key_frame) {
-      stream_frame_types.push_back(VideoFrameType::kVideoFrameKey);
       streaminfos_[stream_idx].key_frame_request = false;
-    } else {
-      stream_frame_types.push_back(VideoFrameType::kVideoFrameDelta);
     }
+    stream_indices.push_back(stream_idx);
+  }
 
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->type() ==
-            VideoFrameBuffer::Type::kNative) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(input_image,
-                                                         &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          input_image.video_frame_buffer()->ToI420();
-      libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
-                        src_buffer->DataU(), src_buffer->StrideU(),
-                        src_buffer->DataV(), src_buffer->StrideV(), src_width,
-                        src_height, dst_buffer->MutableDataY(),
-                        dst_buffer->StrideY(), dst_buffer->MutableDataU(),
-                        dst_buffer->StrideU(), dst_buffer->MutableDataV(),
-                        dst_buffer->StrideV(), dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret =
-          streaminfos_[stream_idx].encoder->Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+  // Scale from a pyramid shared by the streams, and by the rest of the
+  // pipeline if the frame came with one.
+  absl::optional<VideoFrame> frame_with_cache;
+  if (!input_image.scaled_buffer_cache() && stream_indices.size() > 1 &&
+      input_image.video_frame_buffer()->type() !=
+          VideoFrameBuffer::Type::kNative) {
+    frame_with_cache.emplace(input_image);
+    frame_with_cache->set_scaled_buffer_cache(
+        I420ScaledBufferCache::Create(input_image.video_frame_buffer()));
+  }
+  const VideoFrame& frame = frame_with_cache ? *frame_with_cache : input_image;
+
+  if (parallel_encoding_ && stream_indices.size() > 1) {
+    return EncodeStreamsInParallel(stream_indices, frame, frame_type);
+  }
+  for (size_t stream_idx : stream_indices) {
+    int ret = EncodeStream(stream_idx, frame, frame_type);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int SimulcastEncoderAdapter::EncodeStream(size_t stream_idx,
+                                          const VideoFrame& input_image,
+                                          VideoFrameType frame_type) {
+  std::vector<VideoFrameType> stream_frame_types(1, frame_type);
+  int src_width = input_image.width();
+  int src_height = input_image.height();
+  int dst_width = streaminfos_[stream_idx].width;
+  int dst_height = streaminfos_[stream_idx].height;
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, pass the image on
+  // directly. Otherwise, we'll scale it to match what the encoder expects
+  // (below).
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if ((dst_width == src_width && dst_height == src_height) ||
+      input_image.video_frame_buffer()->type() ==
+          VideoFrameBuffer::Type::kNative) {
+    return streaminfos_[stream_idx].encoder->Encode(input_image,
+                                                    &stream_frame_types);
+  }
+
+  rtc::scoped_refptr<I420BufferInterface> dst_buffer;
+  if (input_image.scaled_buffer_cache()) {
+    dst_buffer =
+        input_image.scaled_buffer_cache()->GetScaledI420(dst_width, dst_height);
+    if (!dst_buffer) {
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+  } else {
+    rtc::scoped_refptr<I420Buffer> scaled_buffer =
+        I420BufferPool::Shared()->CreateBuffer(dst_width, dst_height);
+    rtc::scoped_refptr<I420BufferInterface> src_buffer =
+        input_image.video_frame_buffer()->ToI420();
+    libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
+                      src_buffer->DataU(), src_buffer->StrideU(),
+                      src_buffer->DataV(), src_buffer->StrideV(), src_width,
+                      src_height, scaled_buffer->MutableDataY(),
+                      scaled_buffer->StrideY(), scaled_buffer->MutableDataU(),
+                      scaled_buffer->StrideU(), scaled_buffer->MutableDataV(),
+                      scaled_buffer->StrideV(), dst_width, dst_height,
+                      libyuv::kFilterBilinear);
+    dst_buffer = scaled_buffer;
+  }
+
+  // UpdateRect is not propagated to lower simulcast layers currently.
+  // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+  VideoFrame frame(input_image);
+  frame.set_video_frame_buffer(dst_buffer);
+  frame.set_rotation(webrtc::kVideoRotation_0);
+  frame.set_update_rect(
+      VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+  return streaminfos_[stream_idx].encoder->Encode(frame, &stream_frame_types);
+}
+
+int SimulcastEncoderAdapter::EncodeStreamsInParallel(
+    const std::vector<size_t>& stream_indices,
+    const VideoFrame& input_image,
+    VideoFrameType frame_type) {
+  if (!task_queue_factory_) {
+    task_queue_factory_ = CreateDefaultTaskQueueFactory();
+  }
+  while (stream_encode_queues_.size() + 1 < streaminfos_.size()) {
+    stream_encode_queues_.push_back(
+        std::make_unique<rtc::TaskQueue>(task_queue_factory_->CreateTaskQueue(
+            "SimulcastEncode", TaskQueueFactory::Priority::HIGH)));
+  }
+
+  {
+    rtc::CritScope lock(&pending_images_crit_);
+    collect_encoded_images_ = true;
+  }
+  // The highest stream, which is usually the most expensive one, is encoded
+  // on this queue while the others are encoded on their own queues.
+  std::vector<int> results(stream_indices.size(), WEBRTC_VIDEO_CODEC_OK);
+  std::atomic<size_t> num_pending(stream_indices.size() - 1);
+  rtc::Event done;
+  for (size_t i = 0; i + 1 < stream_indices.size(); ++i) {
+    stream_encode_queues_[i]->PostTask([this, &stream_indices, &input_image,
+                                        frame_type, &results, &num_pending,
+                                        &done, i] {
+      results[i] = EncodeStream(stream_indices[i], input_image, frame_type);
+      if (--num_pending == 0)
+        done.Set();
+    });
+  }
+  results.back() = EncodeStream(stream_indices.back(), input_image, frame_type);
+  done.Wait(rtc::Event::kForever);
+
+  std::vector<PendingEncodedImage> pending_images;
+  {
+    rtc::CritScope lock(&pending_images_crit_);
+    collect_encoded_images_ = false;
+    pending_images.swap(pending_images_);
+  }
+  std::stable_sort(
+      pending_images.begin(), pending_images.end(),
+      [](const PendingEncodedImage& a, const PendingEncodedImage& b) {
+        return a.stream_idx < b.stream_idx;
+      });
+  for (const PendingEncodedImage& pending : pending_images) {
+    DeliverEncodedImage(pending.stream_idx, pending.encoded_image,
+                        &pending.codec_specific_info,
+                        pending.fragmentation.get());
+  }
+
+  for (int ret : results) {
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -589,6 +699,33 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
     const EncodedImage& encodedImage,
     const CodecSpecificInfo* codecSpecificInfo,
     const RTPFragmentationHeader* fragmentation) {
+  {
+    rtc::CritScope lock(&pending_images_crit_);
+    if (collect_encoded_images_) {
+      // The image is delivered when all streams are encoded. Its buffer is
+      // owned by the encoder, and stays valid until the next frame.
+      PendingEncodedImage pending;
+      pending.stream_idx = stream_idx;
+      pending.encoded_image = encodedImage;
+      pending.codec_specific_info = *codecSpecificInfo;
+      if (fragmentation) {
+        pending.fragmentation = std::make_unique<RTPFragmentationHeader>();
+        pending.fragmentation->CopyFrom(*fragmentation);
+      }
+      pending_images_.push_back(std::move(pending));
+      return EncodedImageCallback::Result(EncodedImageCallback::Result::OK,
+                                          encodedImage.Timestamp());
+    }
+  }
+  return DeliverEncodedImage(stream_idx, encodedImage, codecSpecificInfo,
+                             fragmentation);
+}
+
+EncodedImageCallback::Result SimulcastEncoderAdapter::DeliverEncodedImage(
+    size_t stream_idx,
+    const EncodedImage& encodedImage,
+    const CodecSpecificInfo* codecSpecificInfo,
+    const RTPFragmentationHeader* fragmentation) {
   EncodedImage stream_image(encodedImage);
   CodecSpecificInfo stream_codec_specific = *codecSpecificInfo;
 
@@ -20,12 +20,17 @@
 
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
+#include "modules/include/module_common_types.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomic_ops.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -36,6 +41,12 @@ class VideoEncoderFactory;
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+//
+// With the field trial "WebRTC-SimulcastEncoderAdapter-ParallelEncoding", the
+// streams of a frame are scaled and encoded concurrently, the highest one on
+// the encoder task queue and the others on a task queue per stream. Encode()
+// waits for all of them, and then delivers the encoded images in stream order
+// on the encoder task queue.
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
   // TODO(bugs.webrtc.org/11000): Remove when downstream usage is gone.
@@ -95,6 +106,15 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     bool send_stream;
   };
 
+  // An image encoded while the streams are encoded in parallel, delivered
+  // once all of them are done.
+  struct PendingEncodedImage {
+    size_t stream_idx;
+    EncodedImage encoded_image;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
   enum class StreamResolution {
     OTHER,
     HIGHEST,
@@ -110,6 +130,22 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   bool Initialized() const;
 
+  // Scales |input_image| to the resolution of the stream if needed, and
+  // encodes it.
+  int EncodeStream(size_t stream_idx,
+                   const VideoFrame& input_image,
+                   VideoFrameType frame_type);
+  // Encodes the streams in |stream_indices| concurrently. Returns the error of
+  // the first stream that failed, if any.
+  int EncodeStreamsInParallel(const std::vector<size_t>& stream_indices,
+                              const VideoFrame& input_image,
+                              VideoFrameType frame_type);
+  EncodedImageCallback::Result DeliverEncodedImage(
+      size_t stream_idx,
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo* codec_specific_info,
+      const RTPFragmentationHeader* fragmentation);
+
   void DestroyStoredEncoders();
 
   volatile int inited_;  // Accessed atomically.
@@ -130,6 +166,16 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
   const bool boost_base_layer_quality_;
+
+  const bool parallel_encoding_;
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  // Created on demand, one per stream that isn't encoded on the encoder task
+  // queue.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> stream_encode_queues_;
+  rtc::CriticalSection pending_images_crit_;
+  bool collect_encoded_images_ RTC_GUARDED_BY(pending_images_crit_) = false;
+  std::vector<PendingEncodedImage> pending_images_
+      RTC_GUARDED_BY(pending_images_crit_);
 };
 
 }  // namespace webrtc
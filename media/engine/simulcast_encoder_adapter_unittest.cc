@@ -27,6 +27,7 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -970,6 +971,69 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingDeliversStreamsInOrder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  // The adapter reads the field trial when created.
+  adapter_->Release();
+  helper_ = std::make_unique<TestSimulcastEncoderAdapterFakeHelper>(
+      use_fallback_factory_);
+  adapter_.reset(helper_->CreateMockEncoderAdapter());
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(1200, 30)),
+      30.0));
+
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_CALL(*encoder, Encode(_, _))
+        .WillOnce(::testing::Invoke(
+            [encoder](const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+              EXPECT_EQ(encoder->codec().width, frame.width());
+              EXPECT_EQ(VideoFrameType::kVideoFrameKey, frame_types->at(0));
+              encoder->SendEncodedImage(frame.width(), frame.height());
+              return WEBRTC_VIDEO_CODEC_OK;
+            }));
+  }
+  std::vector<int> simulcast_indices;
+  EncodedImageCallback* const test_callback = this;
+  class RecordingCallback : public EncodedImageCallback {
+   public:
+    RecordingCallback(EncodedImageCallback* callback, std::vector<int>* indices)
+        : callback_(callback), indices_(indices) {}
+    Result OnEncodedImage(
+        const EncodedImage& encoded_image,
+        const CodecSpecificInfo* codec_specific_info,
+        const RTPFragmentationHeader* fragmentation) override {
+      indices_->push_back(encoded_image.SpatialIndex().value_or(-1));
+      return callback_->OnEncodedImage(encoded_image, codec_specific_info,
+                                       fragmentation);
+    }
+
+   private:
+    EncodedImageCallback* const callback_;
+    std::vector<int>* const indices_;
+  } recording_callback(test_callback, &simulcast_indices);
+  adapter_->RegisterEncodeCompleteCallback(&recording_callback);
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), simulcast_indices);
+  adapter_->Release();
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1381,8 +1381,7 @@ bool WebRtcVideoChannel::RemoveRecvStream(uint32_t ssrc) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   RTC_LOG(LS_INFO) << "RemoveRecvStream: " << ssrc;
 
-  std::map<uint32_t, WebRtcVideoReceiveStream*>::iterator stream =
-      receive_streams_.find(ssrc);
+  auto stream = receive_streams_.find(ssrc);
   if (stream == receive_streams_.end()) {
     RTC_LOG(LS_ERROR) << "Stream not found for ssrc: " << ssrc;
     return false;
@@ -1410,8 +1409,7 @@ bool WebRtcVideoChannel::SetSink(
     return true;
   }
 
-  std::map<uint32_t, WebRtcVideoReceiveStream*>::iterator it =
-      receive_streams_.find(ssrc);
+  auto it = receive_streams_.find(ssrc);
   if (it == receive_streams_.end()) {
     return false;
   }
@@ -1455,21 +1453,19 @@ bool WebRtcVideoChannel::GetStats(VideoMediaInfo* info) {
 
 void WebRtcVideoChannel::FillSenderStats(VideoMediaInfo* video_media_info,
                                          bool log_stats) {
-  for (std::map<uint32_t, WebRtcVideoSendStream*>::iterator it =
-           send_streams_.begin();
-       it != send_streams_.end(); ++it) {
+  video_media_info->senders.reserve(send_streams_.size());
+  for (const auto& kv : send_streams_) {
     video_media_info->senders.push_back(
-        it->second->GetVideoSenderInfo(log_stats));
+        kv.second->GetVideoSenderInfo(log_stats));
   }
 }
 
 void WebRtcVideoChannel::FillReceiverStats(VideoMediaInfo* video_media_info,
                                            bool log_stats) {
-  for (std::map<uint32_t, WebRtcVideoReceiveStream*>::iterator it =
-           receive_streams_.begin();
-       it != receive_streams_.end(); ++it) {
+  video_media_info->receivers.reserve(receive_streams_.size());
+  for (const auto& kv : receive_streams_) {
     video_media_info->receivers.push_back(
-        it->second->GetVideoReceiverInfo(log_stats));
+        kv.second->GetVideoReceiverInfo(log_stats));
   }
 }
 
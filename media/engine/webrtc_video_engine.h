@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -523,7 +524,9 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   // Using primary-ssrc (first ssrc) as key.
   std::map<uint32_t, WebRtcVideoSendStream*> send_streams_
       RTC_GUARDED_BY(thread_checker_);
-  std::map<uint32_t, WebRtcVideoReceiveStream*> receive_streams_
+  // Looked up by SSRC for every unsignaled packet and stream operation, and
+  // can have hundreds of entries on a bundled connection to an SFU.
+  std::unordered_map<uint32_t, WebRtcVideoReceiveStream*> receive_streams_
       RTC_GUARDED_BY(thread_checker_);
   std::set<uint32_t> send_ssrcs_ RTC_GUARDED_BY(thread_checker_);
   std::set<uint32_t> receive_ssrcs_ RTC_GUARDED_BY(thread_checker_);
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1695,16 +1696,19 @@ TEST_F(WebRtcVideoChannelBaseTest, GetStatsMultipleRecvStreams) {
   EXPECT_EQ(kVideoWidth, GetSenderStats(0).send_frame_width);
   EXPECT_EQ(kVideoHeight, GetSenderStats(0).send_frame_height);
 
+  // Receive streams are reported in no particular order.
   ASSERT_EQ(2U, info.receivers.size());
+  std::set<uint32_t> receiver_ssrcs;
   for (size_t i = 0; i < info.receivers.size(); ++i) {
-    EXPECT_EQ(1U, GetReceiverStats(i).ssrcs().size());
-    EXPECT_EQ(i + 1, GetReceiverStats(i).ssrcs()[0]);
+    ASSERT_EQ(1U, GetReceiverStats(i).ssrcs().size());
+    receiver_ssrcs.insert(GetReceiverStats(i).ssrcs()[0]);
     EXPECT_EQ_WAIT(NumRtpBytes() - kRtpHeaderSize * NumRtpPackets(),
                    GetReceiverStats(i).payload_bytes_rcvd, kTimeout);
     EXPECT_EQ_WAIT(NumRtpPackets(), GetReceiverStats(i).packets_rcvd, kTimeout);
     EXPECT_EQ_WAIT(kVideoWidth, GetReceiverStats(i).frame_width, kTimeout);
     EXPECT_EQ_WAIT(kVideoHeight, GetReceiverStats(i).frame_height, kTimeout);
   }
+  EXPECT_EQ(std::set<uint32_t>({1, 2}), receiver_ssrcs);
 }
 
 // Test that stats work properly for a conf call with multiple send streams.
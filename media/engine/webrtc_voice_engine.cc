@@ -44,6 +44,7 @@
 #include "rtc_base/strings/audio_format_to_string.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/third_party/base64/base64.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
@@ -200,7 +201,9 @@ WebRtcVoiceEngine::WebRtcVoiceEngine(
       encoder_factory_(encoder_factory),
       decoder_factory_(decoder_factory),
       audio_mixer_(audio_mixer),
-      apm_(audio_processing) {
+      apm_(audio_processing),
+      defer_audio_device_init_(
+          webrtc::field_trial::IsEnabled("WebRTC-Audio-DeferAdmInit")) {
   // This may be called from any thread, so detach thread checkers.
   worker_thread_checker_.Detach();
   signal_thread_checker_.Detach();
@@ -218,10 +221,13 @@ WebRtcVoiceEngine::~WebRtcVoiceEngine() {
     StopAecDump();
 
     // Stop AudioDevice.
-    adm()->StopPlayout();
-    adm()->StopRecording();
+    if (audio_device_initialized_) {
+      adm()->StopPlayout();
+      adm()->StopRecording();
+    }
     adm()->RegisterAudioCallback(nullptr);
-    adm()->Terminate();
+    if (audio_device_initialized_)
+      adm()->Terminate();
   }
 }
 
@@ -255,7 +261,6 @@ void WebRtcVoiceEngine::Init() {
   }
 #endif  // WEBRTC_INCLUDE_INTERNAL_AUDIO_DEVICE
   RTC_CHECK(adm());
-  webrtc::adm_helpers::Init(adm());
   webrtc::apm_helpers::Init(apm());
 
   // Set up AudioState.
@@ -274,6 +279,25 @@ void WebRtcVoiceEngine::Init() {
   // Connect the ADM to our audio path.
   adm()->RegisterAudioCallback(audio_state()->audio_transport());
 
+  initialized_ = true;
+
+  // Data channel only and receive only applications may never create an audio
+  // channel, so do not open the audio devices until one is created.
+  if (defer_audio_device_init_) {
+    RTC_LOG(LS_INFO) << "Audio device initialization is deferred.";
+  } else {
+    InitAudioDevice();
+  }
+}
+
+void WebRtcVoiceEngine::InitAudioDevice() {
+  RTC_DCHECK(worker_thread_checker_.IsCurrent());
+  RTC_DCHECK(initialized_);
+  RTC_DCHECK(!audio_device_initialized_);
+  const int64_t start_time_ms = rtc::TimeMillis();
+  webrtc::adm_helpers::Init(adm());
+  audio_device_initialized_ = true;
+
   // Set default engine options.
   {
     AudioOptions options;
@@ -293,8 +317,8 @@ void WebRtcVoiceEngine::Init() {
     bool error = ApplyOptions(options);
     RTC_DCHECK(error);
   }
-
-  initialized_ = true;
+  RTC_LOG(LS_INFO) << "Audio device initialized in "
+                   << rtc::TimeMillis() - start_time_ms << " ms.";
 }
 
 rtc::scoped_refptr<webrtc::AudioState> WebRtcVoiceEngine::GetAudioState()
@@ -309,6 +333,8 @@ VoiceMediaChannel* WebRtcVoiceEngine::CreateMediaChannel(
     const AudioOptions& options,
     const webrtc::CryptoOptions& crypto_options) {
   RTC_DCHECK(worker_thread_checker_.IsCurrent());
+  if (!audio_device_initialized_)
+    InitAudioDevice();
   return new WebRtcVoiceMediaChannel(this, config, options, crypto_options,
                                      call);
 }
@@ -2166,6 +2192,7 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
 
   // Get SSRC and stats for each sender.
   RTC_DCHECK_EQ(info->senders.size(), 0U);
+  info->senders.reserve(send_streams_.size());
   for (const auto& stream : send_streams_) {
     webrtc::AudioSendStream::Stats stats =
         stream.second->GetStats(recv_streams_.size() > 0);
@@ -2178,7 +2205,7 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     sinfo.retransmitted_packets_sent = stats.retransmitted_packets_sent;
     sinfo.packets_lost = stats.packets_lost;
     sinfo.fraction_lost = stats.fraction_lost;
-    sinfo.codec_name = stats.codec_name;
+    sinfo.codec_name = std::move(stats.codec_name);
     sinfo.codec_payload_type = stats.codec_payload_type;
     sinfo.jitter_ms = stats.jitter_ms;
     sinfo.rtt_ms = stats.rtt_ms;
@@ -2189,11 +2216,12 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     sinfo.ana_statistics = stats.ana_statistics;
     sinfo.apm_statistics = stats.apm_statistics;
     sinfo.report_block_datas = std::move(stats.report_block_datas);
-    info->senders.push_back(sinfo);
+    info->senders.push_back(std::move(sinfo));
   }
 
   // Get SSRC and stats for each receiver.
   RTC_DCHECK_EQ(info->receivers.size(), 0U);
+  info->receivers.reserve(recv_streams_.size());
   for (const auto& stream : recv_streams_) {
     uint32_t ssrc = stream.first;
     // When SSRCs are unsignaled, there's only one audio MediaStreamTrack, but
@@ -2221,7 +2249,7 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     rinfo.fec_packets_received = stats.fec_packets_received;
     rinfo.fec_packets_discarded = stats.fec_packets_discarded;
     rinfo.packets_lost = stats.packets_lost;
-    rinfo.codec_name = stats.codec_name;
+    rinfo.codec_name = std::move(stats.codec_name);
     rinfo.codec_payload_type = stats.codec_payload_type;
     rinfo.jitter_ms = stats.jitter_ms;
     rinfo.jitter_buffer_ms = stats.jitter_buffer_ms;
@@ -2265,7 +2293,7 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     rinfo.interruption_count = stats.interruption_count;
     rinfo.total_interruption_duration_ms = stats.total_interruption_duration_ms;
 
-    info->receivers.push_back(rinfo);
+    info->receivers.push_back(std::move(rinfo));
   }
 
   // Get codec info
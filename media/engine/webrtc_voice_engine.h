@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "api/audio_codecs/audio_encoder_factory.h"
@@ -88,6 +89,11 @@ class WebRtcVoiceEngine final : public VoiceEngineInterface {
   // easily at any time.
   bool ApplyOptions(const AudioOptions& options);
 
+  // Initializes the audio devices and applies the default options. Done in
+  // Init, or when the first media channel is created if that is deferred by
+  // the WebRTC-Audio-DeferAdmInit field trial.
+  void InitAudioDevice();
+
   int CreateVoEChannel();
 
   webrtc::TaskQueueFactory* const task_queue_factory_;
@@ -117,6 +123,8 @@ class WebRtcVoiceEngine final : public VoiceEngineInterface {
   std::vector<WebRtcVoiceMediaChannel*> channels_;
   bool is_dumping_aec_ = false;
   bool initialized_ = false;
+  const bool defer_audio_device_init_;
+  bool audio_device_initialized_ = false;
 
   // Cache experimental_ns and apply in case they are missing in the audio
   // options. We need to do this because SetExtraOptions() will revert to
@@ -302,7 +310,7 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   std::string mid_;
 
   class WebRtcAudioReceiveStream;
-  std::map<uint32_t, WebRtcAudioReceiveStream*> recv_streams_;
+  std::unordered_map<uint32_t, WebRtcAudioReceiveStream*> recv_streams_;
   std::vector<webrtc::RtpExtension> recv_rtp_extensions_;
 
   absl::optional<webrtc::AudioSendStream::Config::SendCodecSpec>
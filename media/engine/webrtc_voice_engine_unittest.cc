@@ -3496,6 +3496,45 @@ TEST(WebRtcVoiceEngineTest, StartupShutdownWithExternalADM) {
   }
 }
 
+// Tests that the audio devices are not initialized until there is an audio
+// channel, with the WebRTC-Audio-DeferAdmInit field trial.
+TEST(WebRtcVoiceEngineTest, DefersAudioDeviceInitToFirstChannel) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-DeferAdmInit/Enabled/");
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
+      webrtc::CreateDefaultTaskQueueFactory();
+  ::testing::NiceMock<webrtc::test::MockAudioDeviceModule> adm;
+  rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+      webrtc::AudioProcessingBuilder().Create();
+  cricket::WebRtcVoiceEngine engine(
+      task_queue_factory.get(), &adm,
+      webrtc::MockAudioEncoderFactory::CreateUnusedFactory(),
+      webrtc::MockAudioDecoderFactory::CreateUnusedFactory(), nullptr, apm);
+  EXPECT_CALL(adm, Init()).Times(0);
+  engine.Init();
+  ::testing::Mock::VerifyAndClearExpectations(&adm);
+
+  webrtc::RtcEventLogNull event_log;
+  webrtc::Call::Config call_config(&event_log);
+  call_config.task_queue_factory = task_queue_factory.get();
+  auto call = absl::WrapUnique(webrtc::Call::Create(call_config));
+  EXPECT_CALL(adm, Init()).WillOnce(Return(0));
+  std::unique_ptr<cricket::VoiceMediaChannel> channel(
+      engine.CreateMediaChannel(call.get(), cricket::MediaConfig(),
+                                cricket::AudioOptions(),
+                                webrtc::CryptoOptions()));
+  EXPECT_TRUE(channel);
+  ::testing::Mock::VerifyAndClearExpectations(&adm);
+
+  // Only the first channel initializes the audio devices.
+  EXPECT_CALL(adm, Init()).Times(0);
+  std::unique_ptr<cricket::VoiceMediaChannel> second_channel(
+      engine.CreateMediaChannel(call.get(), cricket::MediaConfig(),
+                                cricket::AudioOptions(),
+                                webrtc::CryptoOptions()));
+  EXPECT_TRUE(second_channel);
+}
+
 // Verify the payload id of common audio codecs, including CN, ISAC, and G722.
 TEST(WebRtcVoiceEngineTest, HasCorrectPayloadTypeMapping) {
   std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
@@ -289,10 +289,16 @@ class SctpTransport::UsrSctpWrapper {
                         << "; set_df: " << rtc::ToHex(set_df);
 
     VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
+    // Packets of sends and of received packets are produced on the network
+    // thread and can be sent right away. Only the packets usrsctp sends from
+    // its timer thread, e.g. retransmissions, need to be posted.
+    if (transport->network_thread_->IsCurrent()) {
+      transport->SendPacketFromSctpToNetwork(static_cast<const char*>(data),
+                                             length);
+      return 0;
+    }
     // Note: We have to copy the data; the caller will delete it.
     rtc::CopyOnWriteBuffer buf(reinterpret_cast<uint8_t*>(data), length);
-    // TODO(deadbeef): Why do we need an AsyncInvoke here? We're already on the
-    // right thread and don't need to unwind the stack.
     transport->invoker_.AsyncInvoke<void>(
         RTC_FROM_HERE, transport->network_thread_,
         rtc::Bind(&SctpTransport::OnPacketFromSctpToNetwork, transport, buf));
@@ -338,11 +344,9 @@ class SctpTransport::UsrSctpWrapper {
         // A message with a new sid, but haven't seen the EOR for the
         // previous message. Deliver the previous partial message to avoid
         // merging messages from different sid's.
-        transport->invoker_.AsyncInvoke<void>(
-            RTC_FROM_HERE, transport->network_thread_,
-            rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                      transport, transport->partial_incoming_message_,
-                      transport->partial_params_, transport->partial_flags_));
+        transport->QueueInboundMessage(transport->partial_incoming_message_,
+                                       transport->partial_params_,
+                                       transport->partial_flags_);
 
         transport->partial_incoming_message_.Clear();
       }
@@ -371,13 +375,10 @@ class SctpTransport::UsrSctpWrapper {
         RTC_LOG(LS_WARNING) << "Chunking SCTP message without the EOR bit set.";
       }
 
-      // The ownership of the packet transfers to |invoker_|. Using
+      // The ownership of the packet transfers to the queue. Using
       // CopyOnWriteBuffer is the most convenient way to do this.
-      transport->invoker_.AsyncInvoke<void>(
-          RTC_FROM_HERE, transport->network_thread_,
-          rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                    transport, transport->partial_incoming_message_, params,
-                    flags));
+      transport->QueueInboundMessage(transport->partial_incoming_message_,
+                                     params, flags);
 
       transport->partial_incoming_message_.Clear();
     }
@@ -1002,11 +1003,16 @@ sockaddr_conn SctpTransport::GetSctpSockAddr(int port) {
 
 void SctpTransport::OnPacketFromSctpToNetwork(
     const rtc::CopyOnWriteBuffer& buffer) {
+  SendPacketFromSctpToNetwork(buffer.data<char>(), buffer.size());
+}
+
+void SctpTransport::SendPacketFromSctpToNetwork(const char* data,
+                                                size_t length) {
   RTC_DCHECK_RUN_ON(network_thread_);
-  if (buffer.size() > (kSctpMtu)) {
+  if (length > (kSctpMtu)) {
     RTC_LOG(LS_ERROR) << debug_name_ << "->OnPacketFromSctpToNetwork(...): "
                       << "SCTP seems to have made a packet that is bigger "
-                      << "than its official MTU: " << buffer.size()
+                      << "than its official MTU: " << length
                       << " vs max of " << kSctpMtu;
   }
   TRACE_EVENT0("webrtc", "SctpTransport::OnPacketFromSctpToNetwork");
@@ -1018,8 +1024,39 @@ void SctpTransport::OnPacketFromSctpToNetwork(
   }
 
   // Bon voyage.
-  transport_->SendPacket(buffer.data<char>(), buffer.size(),
-                         rtc::PacketOptions(), PF_NORMAL);
+  transport_->SendPacket(data, length, rtc::PacketOptions(), PF_NORMAL);
+}
+
+void SctpTransport::QueueInboundMessage(const rtc::CopyOnWriteBuffer& buffer,
+                                        const ReceiveDataParams& params,
+                                        int flags) {
+  bool was_empty;
+  {
+    rtc::CritScope cs(&inbound_messages_crit_);
+    was_empty = inbound_messages_.empty();
+    inbound_messages_.push_back({buffer, params, flags});
+  }
+  // A single packet from the network often holds several messages, and more
+  // may follow before the network thread gets to them, so they're all
+  // delivered by one task.
+  if (was_empty) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, network_thread_,
+        rtc::Bind(&SctpTransport::DeliverInboundMessages, this));
+  }
+}
+
+void SctpTransport::DeliverInboundMessages() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<InboundMessage> messages;
+  {
+    rtc::CritScope cs(&inbound_messages_crit_);
+    messages.swap(inbound_messages_);
+  }
+  for (const InboundMessage& message : messages) {
+    OnInboundPacketFromSctpToTransport(message.buffer, message.params,
+                                       message.flags);
+  }
 }
 
 void SctpTransport::OnInboundPacketFromSctpToTransport(
@@ -24,8 +24,10 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 // For SendDataParams/ReceiveDataParams.
 #include "media/base/media_channel.h"
 #include "media/sctp/sctp_transport_internal.h"
@@ -49,18 +51,22 @@ struct SctpInboundPacket;
 //  2.  usrsctp_sendv(data)
 // [network thread returns; sctp thread then calls the following]
 //  3.  OnSctpOutboundPacket(wrapped_data)
-// [sctp thread returns having async invoked on the network thread]
-//  4.  SctpTransport::OnPacketFromSctpToNetwork(wrapped_data)
+// [on the network thread, continues synchronously; on the sctp thread,
+//  returns having async invoked on the network thread]
+//  4.  SctpTransport::SendPacketFromSctpToNetwork(wrapped_data)
 //  5.  DtlsTransport::SendPacket(wrapped_data)
 //  6.  ... across network ... a packet is sent back ...
 //  7.  SctpTransport::OnPacketReceived(wrapped_data)
 //  8.  usrsctp_conninput(wrapped_data)
 // [network thread returns; sctp thread then calls the following]
 //  9.  OnSctpInboundData(data)
-// [sctp thread returns having async invoked on the network thread]
-//  10. SctpTransport::OnInboundPacketFromSctpToTransport(inboundpacket)
-//  11. SctpTransport::OnDataFromSctpToTransport(data)
-//  12. SctpTransport::SignalDataReceived(data)
+//  10. SctpTransport::QueueInboundMessage(data)
+// [returns having async invoked on the network thread, once for all
+//  messages received in a burst]
+//  11. SctpTransport::DeliverInboundMessages()
+//  12. SctpTransport::OnInboundPacketFromSctpToTransport(inboundpacket)
+//  13. SctpTransport::OnDataFromSctpToTransport(data)
+//  14. SctpTransport::SignalDataReceived(data)
 // [from the same thread, methods registered/connected to
 //  SctpTransport are called with the recieved data]
 class SctpTransport : public SctpTransportInternal,
@@ -171,7 +177,15 @@ class SctpTransport : public SctpTransportInternal,
 
   // Called using |invoker_| to send packet on the network.
   void OnPacketFromSctpToNetwork(const rtc::CopyOnWriteBuffer& buffer);
-  // Called using |invoker_| to decide what to do with the packet.
+  void SendPacketFromSctpToNetwork(const char* data, size_t length);
+  // Called from usrsctp callbacks, possibly on a usrsctp thread, with a
+  // complete or chunked message. Messages are delivered in order, by
+  // DeliverInboundMessages() on the network thread.
+  void QueueInboundMessage(const rtc::CopyOnWriteBuffer& buffer,
+                           const ReceiveDataParams& params,
+                           int flags);
+  void DeliverInboundMessages();
+  // Called by DeliverInboundMessages() to decide what to do with the packet.
   // The |flags| parameter is used by SCTP to distinguish notification packets
   // from other types of packets.
   void OnInboundPacketFromSctpToTransport(const rtc::CopyOnWriteBuffer& buffer,
@@ -192,6 +206,16 @@ class SctpTransport : public SctpTransportInternal,
   // Underlying DTLS transport.
   rtc::PacketTransportInternal* transport_ = nullptr;
 
+  struct InboundMessage {
+    rtc::CopyOnWriteBuffer buffer;
+    ReceiveDataParams params;
+    int flags;
+  };
+  // Messages from usrsctp that are yet to be delivered on the network thread.
+  rtc::CriticalSection inbound_messages_crit_;
+  std::vector<InboundMessage> inbound_messages_
+      RTC_GUARDED_BY(inbound_messages_crit_);
+
   // Track the data received from usrsctp between callbacks until the EOR bit
   // arrives.
   rtc::CopyOnWriteBuffer partial_incoming_message_;
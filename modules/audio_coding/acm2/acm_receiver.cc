@@ -191,6 +191,11 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   return 0;
 }
 
+void AcmReceiver::SkipAudio() {
+  rtc::CritScope lock(&crit_sect_);
+  neteq_->SkipAudio();
+}
+
 void AcmReceiver::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   neteq_->SetCodecs(codecs);
 }
@@ -81,6 +81,11 @@ class AcmReceiver {
   //
   int GetAudio(int desired_freq_hz, AudioFrame* audio_frame, bool* muted);
 
+  //
+  // Advances NetEq by 10 ms without decoding, see NetEq::SkipAudio().
+  //
+  void SkipAudio();
+
   // Replace the current set of decoders with the specified set.
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs);
 
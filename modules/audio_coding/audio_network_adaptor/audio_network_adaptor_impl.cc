@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,16 @@ namespace {
 constexpr int kEventLogMinBitrateChangeBps = 5000;
 constexpr float kEventLogMinBitrateChangeFraction = 0.25;
 constexpr float kEventLogMinPacketLossChangeFraction = 0.5;
+
+template <typename T>
+bool ChangedBy(const absl::optional<T>& previous,
+               const absl::optional<T>& current,
+               double min_change) {
+  if (previous.has_value() != current.has_value())
+    return true;
+  return previous && std::abs(static_cast<double>(*current) -
+                              static_cast<double>(*previous)) > min_change;
+}
 }  // namespace
 
 AudioNetworkAdaptorImpl::Config::Config() : event_log(nullptr) {}
@@ -47,8 +58,15 @@ AudioNetworkAdaptorImpl::AudioNetworkAdaptorImpl(
                                    kEventLogMinBitrateChangeBps,
                                    kEventLogMinBitrateChangeFraction,
                                    kEventLogMinPacketLossChangeFraction)
-              : nullptr) {
+              : nullptr),
+      change_driven_evaluation_("Enabled"),
+      min_bitrate_change_fraction_("bitrate_change", 0.05),
+      min_packet_loss_change_("loss_change", 0.01) {
   RTC_DCHECK(controller_manager_);
+  ParseFieldTrial({&change_driven_evaluation_, &min_bitrate_change_fraction_,
+                   &min_packet_loss_change_},
+                  field_trial::FindFullName(
+                      "WebRTC-Audio-AnaChangeDrivenEvaluation"));
 }
 
 AudioNetworkAdaptorImpl::~AudioNetworkAdaptorImpl() = default;
@@ -113,6 +131,16 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
 }
 
 AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
+  // The controllers are deterministic in the metrics they have been given, but
+  // some of them, like the frame length controller, move one step per
+  // decision. Skipping decisions on unchanged metrics therefore changes how
+  // fast they converge, which is why this is opt-in.
+  if (change_driven_evaluation_ && prev_config_ &&
+      !MetricsChangedSinceLastEvaluation()) {
+    return *prev_config_;
+  }
+  evaluated_metrics_ = last_metrics_;
+
   AudioEncoderRuntimeConfig config;
   for (auto& controller :
        controller_manager_->GetSortedControllers(last_metrics_))
@@ -180,4 +208,25 @@ void AudioNetworkAdaptorImpl::UpdateNetworkMetrics(
     controller->UpdateNetworkMetrics(network_metrics);
 }
 
+bool AudioNetworkAdaptorImpl::MetricsChangedSinceLastEvaluation() const {
+  auto bitrate_changed = [this](const absl::optional<int>& previous,
+                                const absl::optional<int>& current) {
+    return ChangedBy(previous, current,
+                     previous ? min_bitrate_change_fraction_ * *previous : 0);
+  };
+  return bitrate_changed(evaluated_metrics_.uplink_bandwidth_bps,
+                         last_metrics_.uplink_bandwidth_bps) ||
+         bitrate_changed(evaluated_metrics_.target_audio_bitrate_bps,
+                         last_metrics_.target_audio_bitrate_bps) ||
+         ChangedBy(evaluated_metrics_.uplink_packet_loss_fraction,
+                   last_metrics_.uplink_packet_loss_fraction,
+                   min_packet_loss_change_) ||
+         ChangedBy(evaluated_metrics_.uplink_recoverable_packet_loss_fraction,
+                   last_metrics_.uplink_recoverable_packet_loss_fraction,
+                   min_packet_loss_change_) ||
+         evaluated_metrics_.rtt_ms != last_metrics_.rtt_ms ||
+         evaluated_metrics_.overhead_bytes_per_packet !=
+             last_metrics_.overhead_bytes_per_packet;
+}
+
 }  // namespace webrtc
@@ -22,6 +22,7 @@
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 
 namespace webrtc {
 
@@ -70,6 +71,10 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void UpdateNetworkMetrics(const Controller::NetworkMetrics& network_metrics);
 
+  // Returns true if |last_metrics_| differ enough from |evaluated_metrics_| to
+  // run the controllers again in change-driven evaluation mode.
+  bool MetricsChangedSinceLastEvaluation() const;
+
   const Config config_;
 
   std::unique_ptr<ControllerManager> controller_manager_;
@@ -80,6 +85,16 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   Controller::NetworkMetrics last_metrics_;
 
+  // In change-driven evaluation mode, enabled by the
+  // "WebRTC-Audio-AnaChangeDrivenEvaluation" field trial, the controllers are
+  // only run when the network metrics have changed by more than the thresholds
+  // below since the last evaluation, and the previous config is returned
+  // otherwise.
+  FieldTrialFlag change_driven_evaluation_;
+  FieldTrialParameter<double> min_bitrate_change_fraction_;
+  FieldTrialParameter<double> min_packet_loss_change_;
+  Controller::NetworkMetrics evaluated_metrics_;
+
   absl::optional<AudioEncoderRuntimeConfig> prev_config_;
 
   ANAStats stats_;
@@ -26,6 +26,8 @@
 namespace webrtc {
 
 using ::testing::_;
+using ::testing::DoAll;
+using ::testing::InvokeWithoutArgs;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::SetArgPointee;
@@ -323,4 +325,38 @@ TEST(AudioNetworkAdaptorImplTest, TestANAStats) {
   EXPECT_EQ(ana_stats.uplink_packet_loss_fraction, 0.1f);
 }
 
+TEST(AudioNetworkAdaptorImplTest,
+     ChangeDrivenEvaluationSkipsControllersOnUnchangedMetrics) {
+  test::ScopedFieldTrials override_field_trials(
+      "WebRTC-Audio-AnaChangeDrivenEvaluation/Enabled,bitrate_change:0.1/");
+  auto states = CreateAudioNetworkAdaptor();
+  AudioEncoderRuntimeConfig config;
+  config.bitrate_bps = 32000;
+  int num_decisions = 0;
+  EXPECT_CALL(*states.mock_controllers[0], MakeDecision(_))
+      .WillRepeatedly(DoAll(SetArgPointee<0>(config),
+                            InvokeWithoutArgs([&] { ++num_decisions; })));
+
+  states.audio_network_adaptor->SetUplinkBandwidth(50000);
+  EXPECT_THAT(states.audio_network_adaptor->GetEncoderRuntimeConfig(),
+              EncoderRuntimeConfigIs(config));
+  EXPECT_EQ(num_decisions, 1);
+
+  // A change within the threshold reuses the previous config.
+  states.audio_network_adaptor->SetUplinkBandwidth(54000);
+  EXPECT_THAT(states.audio_network_adaptor->GetEncoderRuntimeConfig(),
+              EncoderRuntimeConfigIs(config));
+  EXPECT_EQ(num_decisions, 1);
+
+  // Changes add up until they are beyond the threshold.
+  states.audio_network_adaptor->SetUplinkBandwidth(56000);
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  EXPECT_EQ(num_decisions, 2);
+
+  // A metric that was not known before counts as changed.
+  states.audio_network_adaptor->SetRtt(100);
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  EXPECT_EQ(num_decisions, 3);
+}
+
 }  // namespace webrtc
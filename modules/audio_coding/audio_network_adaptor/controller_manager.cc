@@ -10,9 +10,12 @@
 
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
@@ -395,6 +398,14 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
           config_.min_reordering_squared_distance)
     return sorted_controllers_;
 
+  if (last_sorted_scoring_point_ &&
+      last_sorted_scoring_point_->uplink_bandwidth_bps ==
+          scoring_point.uplink_bandwidth_bps &&
+      last_sorted_scoring_point_->uplink_packet_loss_fraction ==
+          scoring_point.uplink_packet_loss_fraction)
+    return sorted_controllers_;
+  last_sorted_scoring_point_ = scoring_point;
+
   // Sort controllers according to the distances of |scoring_point| to the
   // scoring points of controllers.
   //
@@ -403,22 +414,29 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
   // 1) they are less important than any controller that has a scoring point,
   // 2) they are equally important to any controller that has no scoring point,
   //    and their relative order will follow |default_sorted_controllers_|.
-  std::vector<Controller*> sorted_controllers(default_sorted_controllers_);
-  std::stable_sort(
-      sorted_controllers.begin(), sorted_controllers.end(),
-      [this, &scoring_point](const Controller* lhs, const Controller* rhs) {
-        auto lhs_scoring_point = controller_scoring_points_.find(lhs);
-        auto rhs_scoring_point = controller_scoring_points_.find(rhs);
-
-        if (lhs_scoring_point == controller_scoring_points_.end())
-          return false;
-
-        if (rhs_scoring_point == controller_scoring_points_.end())
-          return true;
-
-        return lhs_scoring_point->second.SquaredDistanceTo(scoring_point) <
-               rhs_scoring_point->second.SquaredDistanceTo(scoring_point);
-      });
+  //
+  // The distances are computed once per controller rather than once per
+  // comparison.
+  std::vector<std::pair<float, Controller*>> distances;
+  distances.reserve(default_sorted_controllers_.size());
+  for (Controller* controller : default_sorted_controllers_) {
+    auto controller_scoring_point = controller_scoring_points_.find(controller);
+    distances.emplace_back(
+        controller_scoring_point == controller_scoring_points_.end()
+            ? std::numeric_limits<float>::infinity()
+            : controller_scoring_point->second.SquaredDistanceTo(
+                  scoring_point),
+        controller);
+  }
+  std::stable_sort(distances.begin(), distances.end(),
+                   [](const std::pair<float, Controller*>& lhs,
+                      const std::pair<float, Controller*>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+  std::vector<Controller*> sorted_controllers;
+  sorted_controllers.reserve(distances.size());
+  for (const auto& distance : distances)
+    sorted_controllers.push_back(distance.second);
 
   if (sorted_controllers_ != sorted_controllers) {
     sorted_controllers_ = sorted_controllers;
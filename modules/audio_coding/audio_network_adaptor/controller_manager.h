@@ -107,6 +107,10 @@ class ControllerManagerImpl final : public ControllerManager {
   absl::optional<int64_t> last_reordering_time_ms_;
   ScoringPoint last_scoring_point_;
 
+  // The scoring point |sorted_controllers_| was last computed for, used to
+  // skip sorting again when the metrics have not changed since.
+  absl::optional<ScoringPoint> last_sorted_scoring_point_;
+
   std::vector<Controller*> default_sorted_controllers_;
 
   std::vector<Controller*> sorted_controllers_;
@@ -229,6 +229,36 @@ float GetMinPacketLossRate() {
   return 0.0;
 }
 
+int GetMinReconfigurationIntervalMs() {
+  constexpr char kReconfigurationIntervalFieldTrial[] =
+      "WebRTC-Audio-OpusMinReconfigurationInterval";
+  if (!webrtc::field_trial::IsEnabled(kReconfigurationIntervalFieldTrial))
+    return 0;
+  const std::string field_trial_string =
+      webrtc::field_trial::FindFullName(kReconfigurationIntervalFieldTrial);
+  constexpr int kDefaultMinReconfigurationIntervalMs = 500;
+  int value = kDefaultMinReconfigurationIntervalMs;
+  if (sscanf(field_trial_string.c_str(), "Enabled-%d", &value) == 1 &&
+      value < 0) {
+    RTC_LOG(LS_WARNING) << "Invalid parameter for "
+                        << kReconfigurationIntervalFieldTrial
+                        << ", using default value: "
+                        << kDefaultMinReconfigurationIntervalMs;
+    value = kDefaultMinReconfigurationIntervalMs;
+  }
+  return value;
+}
+
+// Returns true if an encoder instance created for |a| can be reset and reused
+// for |b|.
+bool CanReuseEncoderInstance(const AudioEncoderOpusConfig& a,
+                             const AudioEncoderOpusConfig& b) {
+  return a.num_channels == b.num_channels && a.application == b.application &&
+         a.sample_rate_hz == b.sample_rate_hz;
+}
+
+constexpr int64_t kReconfigurationStatsWindowMs = 60000;
+
 std::unique_ptr<AudioEncoderOpusImpl::NewPacketLossRateOptimizer>
 GetNewPacketLossRateOptimizer() {
   constexpr char kPacketLossOptimizationName[] =
@@ -434,10 +464,13 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       min_packet_loss_rate_(GetMinPacketLossRate()),
       new_packet_loss_optimizer_(GetNewPacketLossRateOptimizer()),
       inst_(nullptr),
+      spare_inst_(nullptr),
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
-      consecutive_dtx_frames_(0) {
+      consecutive_dtx_frames_(0),
+      min_reconfiguration_interval_ms_(GetMinReconfigurationIntervalMs()),
+      audio_network_adaptor_config_pending_(false) {
   RTC_DCHECK(0 <= payload_type && payload_type <= 127);
 
   // Sanity check of the redundant payload type field that we want to get rid
@@ -454,6 +487,8 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(int payload_type,
 
 AudioEncoderOpusImpl::~AudioEncoderOpusImpl() {
   RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(inst_));
+  if (spare_inst_)
+    RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(spare_inst_));
 }
 
 int AudioEncoderOpusImpl::SampleRateHz() const {
@@ -537,6 +572,8 @@ bool AudioEncoderOpusImpl::EnableAudioNetworkAdaptor(
 
 void AudioEncoderOpusImpl::DisableAudioNetworkAdaptor() {
   audio_network_adaptor_.reset(nullptr);
+  audio_network_adaptor_config_pending_ = false;
+  reconfiguration_times_ms_.clear();
 }
 
 void AudioEncoderOpusImpl::OnReceivedUplinkPacketLossFraction(
@@ -651,8 +688,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
     rtc::Buffer* encoded) {
   MaybeUpdateUplinkBandwidth();
 
-  if (input_buffer_.empty())
+  if (input_buffer_.empty()) {
+    if (audio_network_adaptor_config_pending_)
+      ApplyAudioNetworkAdaptor();
     first_timestamp_in_buffer_ = rtp_timestamp;
+  }
 
   input_buffer_.insert(input_buffer_.end(), audio.cbegin(), audio.cend());
   if (input_buffer_.size() <
@@ -731,18 +771,33 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
     const AudioEncoderOpusConfig& config) {
   if (!config.IsOk())
     return false;
+  // Reset the current or the spare encoder instance instead of creating a new
+  // one, if it was created for the same channels, application and sample rate.
+  if (inst_ && !CanReuseEncoderInstance(config_, config)) {
+    if (spare_inst_ && CanReuseEncoderInstance(spare_inst_config_, config)) {
+      std::swap(inst_, spare_inst_);
+    } else {
+      if (spare_inst_)
+        RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(spare_inst_));
+      spare_inst_ = inst_;
+      inst_ = nullptr;
+    }
+    spare_inst_config_ = config_;
+  }
   config_ = config;
-  if (inst_)
-    RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(inst_));
   input_buffer_.clear();
   input_buffer_.reserve(Num10msFramesPerPacket() * SamplesPer10msFrame());
-  RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(
-                      &inst_, config.num_channels,
-                      config.application ==
-                              AudioEncoderOpusConfig::ApplicationMode::kVoip
-                          ? 0
-                          : 1,
-                      config.sample_rate_hz));
+  if (inst_) {
+    RTC_CHECK_EQ(0, WebRtcOpus_EncoderReset(inst_));
+  } else {
+    RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(
+                        &inst_, config.num_channels,
+                        config.application ==
+                                AudioEncoderOpusConfig::ApplicationMode::kVoip
+                            ? 0
+                            : 1,
+                        config.sample_rate_hz));
+  }
   const int bitrate = GetBitrateBps(config);
   RTC_CHECK_EQ(0, WebRtcOpus_SetBitRate(inst_, bitrate));
   RTC_LOG(LS_INFO) << "Set Opus bitrate to " << bitrate << " bps.";
@@ -828,20 +883,51 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
 }
 
 void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
+  const int64_t now_ms = rtc::TimeMillis();
+  if (min_reconfiguration_interval_ms_ > 0 &&
+      !reconfiguration_times_ms_.empty() &&
+      now_ms - reconfiguration_times_ms_.back() <
+          min_reconfiguration_interval_ms_) {
+    // Batch this update with the ones that follow until the interval has
+    // passed.
+    audio_network_adaptor_config_pending_ = true;
+    return;
+  }
+  audio_network_adaptor_config_pending_ = false;
+
   auto config = audio_network_adaptor_->GetEncoderRuntimeConfig();
 
+  const int old_bitrate_bps = GetTargetBitrate();
+  const int old_frame_length_ms = next_frame_length_ms_;
+  const bool old_fec_enabled = config_.fec_enabled;
+  const bool old_dtx_enabled = config_.dtx_enabled;
+  const size_t old_num_channels_to_encode = num_channels_to_encode_;
+
   if (config.bitrate_bps)
     SetTargetBitrate(*config.bitrate_bps);
   if (config.frame_length_ms)
     SetFrameLength(*config.frame_length_ms);
-  if (config.enable_fec)
+  if (config.enable_fec && *config.enable_fec != config_.fec_enabled)
     SetFec(*config.enable_fec);
   if (config.uplink_packet_loss_fraction)
     SetProjectedPacketLossRate(*config.uplink_packet_loss_fraction);
-  if (config.enable_dtx)
+  if (config.enable_dtx && *config.enable_dtx != config_.dtx_enabled)
     SetDtx(*config.enable_dtx);
   if (config.num_channels)
     SetNumChannelsToEncode(*config.num_channels);
+
+  if (GetTargetBitrate() != old_bitrate_bps ||
+      next_frame_length_ms_ != old_frame_length_ms ||
+      config_.fec_enabled != old_fec_enabled ||
+      config_.dtx_enabled != old_dtx_enabled ||
+      num_channels_to_encode_ != old_num_channels_to_encode) {
+    while (!reconfiguration_times_ms_.empty() &&
+           now_ms - reconfiguration_times_ms_.front() >=
+               kReconfigurationStatsWindowMs) {
+      reconfiguration_times_ms_.pop_front();
+    }
+    reconfiguration_times_ms_.push_back(now_ms);
+  }
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -874,7 +960,14 @@ void AudioEncoderOpusImpl::MaybeUpdateUplinkBandwidth() {
 
 ANAStats AudioEncoderOpusImpl::GetANAStats() const {
   if (audio_network_adaptor_) {
-    return audio_network_adaptor_->GetStats();
+    ANAStats stats = audio_network_adaptor_->GetStats();
+    const int64_t now_ms = rtc::TimeMillis();
+    stats.reconfigurations_per_minute = static_cast<uint32_t>(std::count_if(
+        reconfiguration_times_ms_.begin(), reconfiguration_times_ms_.end(),
+        [now_ms](int64_t time_ms) {
+          return now_ms - time_ms < kReconfigurationStatsWindowMs;
+        }));
+    return stats;
   }
   return ANAStats();
 }
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 #define MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
@@ -166,6 +167,9 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   // |AudioEncoder::SetTargetBitrate|.
   void SetTargetBitrate(int target_bps) override;
 
+  // Applies the runtime config of the audio network adaptor, unless the
+  // encoder was reconfigured less than |min_reconfiguration_interval_ms_| ago.
+  // In that case, the config is applied when a later packet is started.
   void ApplyAudioNetworkAdaptor();
   std::unique_ptr<AudioNetworkAdaptor> DefaultAudioNetworkAdaptorCreator(
       const std::string& config_string,
@@ -184,6 +188,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   const std::unique_ptr<NewPacketLossRateOptimizer> new_packet_loss_optimizer_;
   std::vector<int16_t> input_buffer_;
   OpusEncInst* inst_;
+  // The instance used before the last change of channels, application or
+  // sample rate, kept to switch back without reallocating.
+  OpusEncInst* spare_inst_;
+  AudioEncoderOpusConfig spare_inst_config_;
   uint32_t first_timestamp_in_buffer_;
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
@@ -195,6 +203,11 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   const std::unique_ptr<SmoothingFilter> bitrate_smoother_;
   absl::optional<int64_t> bitrate_smoother_last_update_time_;
   int consecutive_dtx_frames_;
+  const int min_reconfiguration_interval_ms_;
+  bool audio_network_adaptor_config_pending_;
+  // The times of the reconfigurations by the audio network adaptor in the last
+  // minute.
+  std::deque<int64_t> reconfiguration_times_ms_;
 
   friend struct AudioEncoderOpus;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderOpusImpl);
@@ -652,6 +652,90 @@ TEST_P(AudioEncoderOpusTest, EmptyConfigDoesNotAffectEncoderSettings) {
   CheckEncoderRuntimeConfig(states->encoder.get(), config);
 }
 
+TEST_P(AudioEncoderOpusTest, ReportReconfigurationsPerMinute) {
+  auto states = CreateCodec(sample_rate_hz_, 2);
+  EXPECT_FALSE(states->encoder->GetANAStats().reconfigurations_per_minute);
+  states->encoder->EnableAudioNetworkAdaptor("", nullptr);
+
+  // Applying the same config twice only reconfigures the encoder once.
+  auto config = CreateEncoderRuntimeConfig();
+  EXPECT_CALL(*states->mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .WillRepeatedly(Return(config));
+  constexpr int kRtt = 30;
+  states->encoder->OnReceivedRtt(kRtt);
+  states->encoder->OnReceivedRtt(kRtt);
+  EXPECT_EQ(1u, states->encoder->GetANAStats().reconfigurations_per_minute);
+
+  states->fake_clock->AdvanceTime(TimeDelta::seconds(60));
+  EXPECT_EQ(0u, states->encoder->GetANAStats().reconfigurations_per_minute);
+}
+
+TEST_P(AudioEncoderOpusTest, ThrottleReconfigurationWithFieldTrial) {
+  test::ScopedFieldTrials override_field_trials(
+      "WebRTC-Audio-OpusMinReconfigurationInterval/Enabled-1000/");
+  auto states = CreateCodec(sample_rate_hz_, 2);
+  states->encoder->EnableAudioNetworkAdaptor("", nullptr);
+
+  auto config = CreateEncoderRuntimeConfig();
+  EXPECT_CALL(*states->mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .WillOnce(Return(config));
+  constexpr int kRtt = 30;
+  states->encoder->OnReceivedRtt(kRtt);
+  CheckEncoderRuntimeConfig(states->encoder.get(), config);
+
+  // Updates within the interval are not applied.
+  config.bitrate_bps = 20000;
+  ::testing::Mock::VerifyAndClearExpectations(
+      states->mock_audio_network_adaptor);
+  EXPECT_CALL(*states->mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .Times(0);
+  states->encoder->OnReceivedRtt(kRtt);
+  states->encoder->OnReceivedRtt(kRtt);
+  ::testing::Mock::VerifyAndClearExpectations(
+      states->mock_audio_network_adaptor);
+
+  // They are applied once, when a packet is started after the interval.
+  EXPECT_CALL(*states->mock_audio_network_adaptor, GetEncoderRuntimeConfig())
+      .WillOnce(Return(config));
+  states->fake_clock->AdvanceTime(TimeDelta::ms(1000));
+  const size_t opus_rate_khz = rtc::CheckedDivExact(sample_rate_hz_, 1000);
+  const std::vector<int16_t> audio(opus_rate_khz * 10 * 2, 0);
+  rtc::Buffer encoded;
+  states->encoder->Encode(0, audio, &encoded);
+  states->encoder->Encode(0, audio, &encoded);
+  CheckEncoderRuntimeConfig(states->encoder.get(), config);
+}
+
+// Resetting the encoder, or switching back to a previous application, reuses
+// an encoder instance. The output must be the same as with a new encoder.
+TEST_P(AudioEncoderOpusTest, ReusedEncoderInstanceBehavesAsNew) {
+  auto new_states = CreateCodec(sample_rate_hz_, 1);
+  auto reused_states = CreateCodec(sample_rate_hz_, 1);
+  constexpr int kNumPacketsToEncode = 10;
+  auto audio_frames = Create10msAudioBlocks(new_states->encoder,
+                                            kNumPacketsToEncode * 20);
+  ASSERT_TRUE(audio_frames) << "Create10msAudioBlocks failed";
+  rtc::Buffer encoded;
+  for (int i = 0; i < 2 * kNumPacketsToEncode; ++i) {
+    reused_states->encoder->Encode(0, audio_frames->GetNextBlock(), &encoded);
+  }
+  EXPECT_TRUE(reused_states->encoder->SetApplication(
+      AudioEncoder::Application::kAudio));
+  EXPECT_TRUE(reused_states->encoder->SetApplication(
+      AudioEncoder::Application::kSpeech));
+  reused_states->encoder->Reset();
+
+  rtc::Buffer new_encoded;
+  rtc::Buffer reused_encoded;
+  for (int i = 0; i < 2 * kNumPacketsToEncode; ++i) {
+    rtc::ArrayView<const int16_t> audio = audio_frames->GetNextBlock();
+    new_states->encoder->Encode(0, audio, &new_encoded);
+    reused_states->encoder->Encode(0, audio, &reused_encoded);
+  }
+  EXPECT_GT(new_encoded.size(), 0u);
+  EXPECT_EQ(new_encoded, reused_encoded);
+}
+
 TEST_P(AudioEncoderOpusTest, UpdateUplinkBandwidthInAudioNetworkAdaptor) {
   auto states = CreateCodec(sample_rate_hz_, 2);
   states->encoder->EnableAudioNetworkAdaptor("", nullptr);
@@ -201,6 +201,18 @@ int WebRtcOpus_Encode(OpusEncInst* inst,
     : opus_multistream_encoder_ctl(inst->multistream_encoder, vargs))
 
 
+int16_t WebRtcOpus_EncoderReset(OpusEncInst* inst) {
+  if (!inst)
+    return -1;
+  if (ENCODER_CTL(inst, OPUS_RESET_STATE) != OPUS_OK ||
+      ENCODER_CTL(inst, OPUS_SET_FORCE_CHANNELS(OPUS_AUTO)) != OPUS_OK ||
+      ENCODER_CTL(inst, OPUS_SET_BANDWIDTH(OPUS_AUTO)) != OPUS_OK) {
+    return -1;
+  }
+  inst->in_dtx_mode = 0;
+  return 0;
+}
+
 int16_t WebRtcOpus_SetBitRate(OpusEncInst* inst, int32_t rate) {
   if (inst) {
     return ENCODER_CTL(inst, OPUS_SET_BITRATE(rate));
@@ -83,6 +83,22 @@ int16_t WebRtcOpus_MultistreamEncoderCreate(
 
 int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst);
 
+/****************************************************************************
+ * WebRtcOpus_EncoderReset(...)
+ *
+ * This function resets an encoder to the state of a newly created one with
+ * the same channels, application and sample rate, without reallocating it.
+ * The forced channels and the bandwidth are reset to automatic, but other
+ * settings, like the bitrate, are kept and should be set again.
+ *
+ * Input:
+ *      - inst               : Encoder context
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
+int16_t WebRtcOpus_EncoderReset(OpusEncInst* inst);
+
 /****************************************************************************
  * WebRtcOpus_Encode(...)
  *
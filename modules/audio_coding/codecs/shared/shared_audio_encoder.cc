@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// The encoder of one stream. Apart from encoding, it only answers queries
+// about the shared encoder.
+class SharedAudioEncoder::StreamEncoder final : public AudioEncoder {
+ public:
+  explicit StreamEncoder(rtc::scoped_refptr<SharedAudioEncoder> shared)
+      : shared_(std::move(shared)) {
+    shared_->AddStream(this);
+  }
+
+  ~StreamEncoder() override { shared_->RemoveStream(this); }
+
+  int SampleRateHz() const override {
+    return Query(&AudioEncoder::SampleRateHz);
+  }
+  size_t NumChannels() const override {
+    return Query(&AudioEncoder::NumChannels);
+  }
+  int RtpTimestampRateHz() const override {
+    return Query(&AudioEncoder::RtpTimestampRateHz);
+  }
+  size_t Num10MsFramesInNextPacket() const override {
+    return Query(&AudioEncoder::Num10MsFramesInNextPacket);
+  }
+  size_t Max10MsFramesInAPacket() const override {
+    return Query(&AudioEncoder::Max10MsFramesInAPacket);
+  }
+  int GetTargetBitrate() const override {
+    return Query(&AudioEncoder::GetTargetBitrate);
+  }
+  bool GetDtx() const override { return Query(&AudioEncoder::GetDtx); }
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return Query(&AudioEncoder::GetFrameLengthRange);
+  }
+
+  // Continues with the latest block, without resetting the shared encoder.
+  void Reset() override { shared_->ResetStream(this); }
+
+  // The index of the next block that this stream encodes.
+  int64_t next_block_index_ RTC_GUARDED_BY(shared_->crit_) = 0;
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    return shared_->Encode(this, rtp_timestamp, audio, encoded);
+  }
+
+ private:
+  template <typename T>
+  T Query(T (AudioEncoder::*method)() const) const {
+    rtc::CritScope lock(&shared_->crit_);
+    return (shared_->encoder_.get()->*method)();
+  }
+
+  const rtc::scoped_refptr<SharedAudioEncoder> shared_;
+};
+
+SharedAudioEncoder::Block::Block() = default;
+SharedAudioEncoder::Block::Block(Block&&) = default;
+SharedAudioEncoder::Block::~Block() = default;
+
+const size_t SharedAudioEncoder::kMaxBufferedBlocks;
+
+rtc::scoped_refptr<SharedAudioEncoder> SharedAudioEncoder::Create(
+    std::unique_ptr<AudioEncoder> encoder) {
+  return new rtc::RefCountedObject<SharedAudioEncoder>(std::move(encoder));
+}
+
+SharedAudioEncoder::SharedAudioEncoder(std::unique_ptr<AudioEncoder> encoder)
+    : encoder_(std::move(encoder)) {
+  RTC_CHECK(encoder_) << "Shared encoder not provided.";
+}
+
+SharedAudioEncoder::~SharedAudioEncoder() {
+  RTC_DCHECK(streams_.empty());
+}
+
+std::unique_ptr<AudioEncoder> SharedAudioEncoder::CreateStreamEncoder() {
+  return std::make_unique<StreamEncoder>(this);
+}
+
+void SharedAudioEncoder::CallEncoder(
+    rtc::FunctionView<void(AudioEncoder*)> modifier) {
+  rtc::CritScope lock(&crit_);
+  modifier(encoder_.get());
+}
+
+size_t SharedAudioEncoder::num_encodes() const {
+  rtc::CritScope lock(&crit_);
+  return num_encodes_;
+}
+
+void SharedAudioEncoder::AddStream(StreamEncoder* stream) {
+  rtc::CritScope lock(&crit_);
+  stream->next_block_index_ = first_block_index_ + blocks_.size();
+  streams_.push_back(stream);
+}
+
+void SharedAudioEncoder::RemoveStream(StreamEncoder* stream) {
+  rtc::CritScope lock(&crit_);
+  auto it = std::find(streams_.begin(), streams_.end(), stream);
+  RTC_DCHECK(it != streams_.end());
+  streams_.erase(it);
+  DropConsumedBlocks();
+}
+
+void SharedAudioEncoder::ResetStream(StreamEncoder* stream) {
+  rtc::CritScope lock(&crit_);
+  stream->next_block_index_ = first_block_index_ + blocks_.size();
+  DropConsumedBlocks();
+}
+
+AudioEncoder::EncodedInfo SharedAudioEncoder::Encode(
+    StreamEncoder* stream,
+    uint32_t rtp_timestamp,
+    rtc::ArrayView<const int16_t> audio,
+    rtc::Buffer* encoded) {
+  rtc::CritScope lock(&crit_);
+  const int64_t end_block_index = first_block_index_ + blocks_.size();
+  int64_t& block_index = stream->next_block_index_;
+  if (block_index < first_block_index_) {
+    // The blocks that this stream missed have been dropped.
+    block_index = end_block_index;
+  }
+  RTC_DCHECK_LE(block_index, end_block_index);
+  if (block_index == end_block_index) {
+    // This stream is the first to get here, so encode the block for all.
+    blocks_.emplace_back();
+    Block& block = blocks_.back();
+    block.rtp_timestamp = rtp_timestamp;
+    block.info = encoder_->Encode(rtp_timestamp, audio, &block.payload);
+    ++num_encodes_;
+    if (blocks_.size() > kMaxBufferedBlocks) {
+      blocks_.pop_front();
+      ++first_block_index_;
+    }
+  }
+
+  const Block& block = blocks_[block_index - first_block_index_];
+  ++block_index;
+  // Move the timestamps from the RTP timeline of the stream that encoded the
+  // block to that of this stream.
+  const uint32_t timestamp_offset = rtp_timestamp - block.rtp_timestamp;
+  AudioEncoder::EncodedInfo info = block.info;
+  info.encoded_timestamp += timestamp_offset;
+  for (AudioEncoder::EncodedInfoLeaf& redundant : info.redundant) {
+    redundant.encoded_timestamp += timestamp_offset;
+  }
+  encoded->AppendData(block.payload);
+
+  DropConsumedBlocks();
+  return info;
+}
+
+void SharedAudioEncoder::DropConsumedBlocks() {
+  int64_t min_next_block_index = first_block_index_ + blocks_.size();
+  for (const StreamEncoder* stream : streams_) {
+    min_next_block_index =
+        std::min(min_next_block_index, stream->next_block_index_);
+  }
+  while (first_block_index_ < min_next_block_index) {
+    blocks_.pop_front();
+    ++first_block_index_;
+  }
+}
+
+}  // namespace webrtc
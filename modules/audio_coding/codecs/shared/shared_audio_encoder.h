@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
+#define MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/function_view.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encodes audio once for several outgoing streams that send the same audio,
+// e.g. the same mix sent to many receivers. Each stream gets its own
+// AudioEncoder from CreateStreamEncoder(), which is set on the stream like any
+// other encoder, e.g. by an AudioEncoderFactory. For each 10 ms block, the
+// first stream to encode it runs the shared encoder and the others get a copy
+// of its output, with the timestamp moved to their own RTP timeline. RTP
+// packetization stays per stream.
+//
+// All streams must provide the same audio, in the same 10 ms blocks. Since
+// they share an encoder, bitrate and other settings are not adapted per
+// stream: the stream encoders ignore the uplink feedback they get, and the
+// owner configures the shared encoder with CallEncoder() instead.
+//
+// The stream encoders may be used on different threads.
+class SharedAudioEncoder : public rtc::RefCountInterface {
+ public:
+  // The maximum number of 10 ms blocks kept for streams that lag behind. A
+  // stream that lags behind more, e.g. because it stopped sending for a
+  // while, continues with the latest block.
+  static const size_t kMaxBufferedBlocks = 50;
+
+  static rtc::scoped_refptr<SharedAudioEncoder> Create(
+      std::unique_ptr<AudioEncoder> encoder);
+
+  // The returned encoder keeps a reference to this object.
+  std::unique_ptr<AudioEncoder> CreateStreamEncoder();
+
+  // Runs |modifier| on the shared encoder.
+  void CallEncoder(rtc::FunctionView<void(AudioEncoder*)> modifier);
+
+  // The number of times the shared encoder was run, for testing.
+  size_t num_encodes() const;
+
+ protected:
+  explicit SharedAudioEncoder(std::unique_ptr<AudioEncoder> encoder);
+  ~SharedAudioEncoder() override;
+
+ private:
+  class StreamEncoder;
+
+  // The output of the shared encoder for a 10 ms block.
+  struct Block {
+    Block();
+    Block(Block&&);
+    ~Block();
+
+    // The RTP timestamp that the block was encoded with.
+    uint32_t rtp_timestamp;
+    AudioEncoder::EncodedInfo info;
+    rtc::Buffer payload;
+  };
+
+  void AddStream(StreamEncoder* stream);
+  void RemoveStream(StreamEncoder* stream);
+  void ResetStream(StreamEncoder* stream);
+  AudioEncoder::EncodedInfo Encode(StreamEncoder* stream,
+                                   uint32_t rtp_timestamp,
+                                   rtc::ArrayView<const int16_t> audio,
+                                   rtc::Buffer* encoded);
+  // Drops the blocks that all streams are done with.
+  void DropConsumedBlocks() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  rtc::CriticalSection crit_;
+  const std::unique_ptr<AudioEncoder> encoder_ RTC_PT_GUARDED_BY(crit_);
+  std::vector<StreamEncoder*> streams_ RTC_GUARDED_BY(crit_);
+  std::deque<Block> blocks_ RTC_GUARDED_BY(crit_);
+  // The index of the first block in |blocks_|, counted from the first block
+  // that was encoded.
+  int64_t first_block_index_ RTC_GUARDED_BY(crit_) = 0;
+  size_t num_encodes_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
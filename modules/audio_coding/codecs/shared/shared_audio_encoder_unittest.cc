@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoder.h"
+
+#include <memory>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/mock_audio_encoder.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+namespace webrtc {
+
+namespace {
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+
+// Encodes each block into a byte with its index, and returns the timestamp of
+// the first block of each 20 ms packet.
+AudioEncoder::EncodedInfo EncodeBlockIndex(uint32_t timestamp,
+                                           rtc::ArrayView<const int16_t> audio,
+                                           rtc::Buffer* encoded) {
+  AudioEncoder::EncodedInfo info;
+  if (audio[0] % 2 == 1) {
+    encoded->AppendData(static_cast<uint8_t>(audio[0]));
+    info.encoded_bytes = 1;
+    info.encoded_timestamp = timestamp - kSamplesPer10Ms;
+  }
+  return info;
+}
+}  // namespace
+
+class SharedAudioEncoderTest : public ::testing::Test {
+ protected:
+  SharedAudioEncoderTest() : mock_encoder_(new MockAudioEncoder) {
+    EXPECT_CALL(*mock_encoder_, NumChannels()).WillRepeatedly(Return(1U));
+    EXPECT_CALL(*mock_encoder_, SampleRateHz())
+        .WillRepeatedly(Return(kSampleRateHz));
+    EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+        .WillRepeatedly(Invoke(&EncodeBlockIndex));
+    shared_ = SharedAudioEncoder::Create(
+        std::unique_ptr<AudioEncoder>(mock_encoder_));
+  }
+
+  // Encodes block |block_index| with |encoder|, at |first_timestamp| plus the
+  // duration of the preceding blocks.
+  AudioEncoder::EncodedInfo Encode(AudioEncoder* encoder,
+                                   uint32_t first_timestamp,
+                                   int block_index,
+                                   rtc::Buffer* encoded) {
+    std::vector<int16_t> audio(kSamplesPer10Ms, block_index);
+    encoded->Clear();
+    return encoder->Encode(
+        static_cast<uint32_t>(first_timestamp + block_index * kSamplesPer10Ms),
+        audio, encoded);
+  }
+
+  MockAudioEncoder* mock_encoder_;
+  rtc::scoped_refptr<SharedAudioEncoder> shared_;
+};
+
+TEST_F(SharedAudioEncoderTest, ForwardsQueries) {
+  std::unique_ptr<AudioEncoder> encoder = shared_->CreateStreamEncoder();
+  EXPECT_EQ(kSampleRateHz, encoder->SampleRateHz());
+  EXPECT_EQ(1U, encoder->NumChannels());
+  EXPECT_CALL(*mock_encoder_, GetTargetBitrate()).WillOnce(Return(32000));
+  EXPECT_EQ(32000, encoder->GetTargetBitrate());
+}
+
+TEST_F(SharedAudioEncoderTest, IgnoresStreamFeedback) {
+  std::unique_ptr<AudioEncoder> encoder = shared_->CreateStreamEncoder();
+  EXPECT_CALL(*mock_encoder_, OnReceivedUplinkBandwidth(_, _)).Times(0);
+  EXPECT_CALL(*mock_encoder_, Reset()).Times(0);
+  encoder->OnReceivedUplinkBandwidth(20000, absl::nullopt);
+  encoder->Reset();
+
+  EXPECT_CALL(*mock_encoder_, OnReceivedUplinkBandwidth(20000, _));
+  shared_->CallEncoder([](AudioEncoder* encoder) {
+    encoder->OnReceivedUplinkBandwidth(20000, absl::nullopt);
+  });
+}
+
+TEST_F(SharedAudioEncoderTest, EncodesOnceForAllStreams) {
+  constexpr int kNumStreams = 3;
+  constexpr int kNumBlocks = 10;
+  const uint32_t first_timestamps[kNumStreams] = {1000, 4711, 0xffffff00};
+  std::vector<std::unique_ptr<AudioEncoder>> encoders;
+  for (int i = 0; i < kNumStreams; ++i)
+    encoders.push_back(shared_->CreateStreamEncoder());
+
+  rtc::Buffer encoded;
+  for (int block = 0; block < kNumBlocks; ++block) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      AudioEncoder::EncodedInfo info =
+          Encode(encoders[i].get(), first_timestamps[i], block, &encoded);
+      if (block % 2 == 1) {
+        ASSERT_EQ(1U, info.encoded_bytes);
+        EXPECT_EQ(block, encoded[0]);
+        EXPECT_EQ(static_cast<uint32_t>(first_timestamps[i] +
+                                        (block - 1) * kSamplesPer10Ms),
+                  info.encoded_timestamp);
+      } else {
+        EXPECT_EQ(0U, info.encoded_bytes);
+        EXPECT_EQ(0U, encoded.size());
+      }
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumBlocks), shared_->num_encodes());
+}
+
+TEST_F(SharedAudioEncoderTest, LaggingStreamGetsBufferedBlocks) {
+  std::unique_ptr<AudioEncoder> leader = shared_->CreateStreamEncoder();
+  std::unique_ptr<AudioEncoder> follower = shared_->CreateStreamEncoder();
+  rtc::Buffer encoded;
+  for (int block = 0; block < 4; ++block)
+    Encode(leader.get(), 0, block, &encoded);
+  for (int block = 0; block < 4; ++block) {
+    AudioEncoder::EncodedInfo info =
+        Encode(follower.get(), 100, block, &encoded);
+    if (block % 2 == 1) {
+      ASSERT_EQ(1U, info.encoded_bytes);
+      EXPECT_EQ(block, encoded[0]);
+    }
+  }
+  EXPECT_EQ(4U, shared_->num_encodes());
+}
+
+TEST_F(SharedAudioEncoderTest, StoppedStreamContinuesWithLatestBlock) {
+  std::unique_ptr<AudioEncoder> active = shared_->CreateStreamEncoder();
+  std::unique_ptr<AudioEncoder> stopped = shared_->CreateStreamEncoder();
+  rtc::Buffer encoded;
+  const int num_blocks = SharedAudioEncoder::kMaxBufferedBlocks + 10;
+  for (int block = 0; block < num_blocks; ++block)
+    Encode(active.get(), 0, block, &encoded);
+  EXPECT_EQ(static_cast<size_t>(num_blocks), shared_->num_encodes());
+
+  // The stopped stream encodes the next block, since the ones it missed were
+  // dropped.
+  Encode(stopped.get(), 0, num_blocks, &encoded);
+  EXPECT_EQ(static_cast<size_t>(num_blocks + 1), shared_->num_encodes());
+  Encode(active.get(), 0, num_blocks, &encoded);
+  EXPECT_EQ(static_cast<size_t>(num_blocks + 1), shared_->num_encodes());
+}
+
+TEST_F(SharedAudioEncoderTest, StreamEncoderKeepsSharedEncoderAlive) {
+  std::unique_ptr<AudioEncoder> encoder = shared_->CreateStreamEncoder();
+  shared_ = nullptr;
+  rtc::Buffer encoded;
+  Encode(encoder.get(), 0, 0, &encoded);
+  AudioEncoder::EncodedInfo info = Encode(encoder.get(), 0, 1, &encoded);
+  EXPECT_EQ(1U, info.encoded_bytes);
+}
+
+}  // namespace webrtc
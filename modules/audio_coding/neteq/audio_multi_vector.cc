@@ -75,19 +75,20 @@ void AudioMultiVector::PushBackInterleaved(
     channels_[0]->PushBack(append_this.data(), append_this.size());
     return;
   }
-  size_t length_per_channel = append_this.size() / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
+  const size_t length_per_channel = append_this.size() / num_channels_;
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to |temp_array|.
+    // Extend the channel and write its elements in place, instead of going
+    // through a temporary array.
+    AudioVector& channel_vector = *channels_[channel];
+    const size_t start = channel_vector.Size();
+    channel_vector.Extend(length_per_channel);
     // Set |source_ptr| to first element of this channel.
     const int16_t* source_ptr = &append_this[channel];
     for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = *source_ptr;
+      channel_vector[start + i] = *source_ptr;
       source_ptr += num_channels_;  // Jump to next element of this channel.
     }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
   }
-  delete[] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
@@ -206,6 +207,20 @@ bool AudioMultiVector::Empty() const {
   return channels_[0]->Empty();
 }
 
+size_t AudioMultiVector::Capacity() const {
+  size_t capacity = channels_[0]->Capacity();
+  for (size_t channel = 1; channel < num_channels_; ++channel) {
+    capacity = std::min(capacity, channels_[channel]->Capacity());
+  }
+  return capacity;
+}
+
+void AudioMultiVector::Reserve(size_t n) {
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    channels_[channel]->Reserve(n);
+  }
+}
+
 void AudioMultiVector::CopyChannel(size_t from_channel, size_t to_channel) {
   assert(from_channel < num_channels_);
   assert(to_channel < num_channels_);
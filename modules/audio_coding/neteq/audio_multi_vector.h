@@ -117,6 +117,14 @@ class AudioMultiVector {
 
   virtual bool Empty() const;
 
+  // Returns the number of elements per channel that all channels can hold
+  // without reallocating.
+  size_t Capacity() const;
+
+  // Makes room for at least |n| elements in each channel. See
+  // AudioVector::Reserve().
+  void Reserve(size_t n);
+
   // Copies the data between two channels in the AudioMultiVector. The method
   // does not add any new channel. Thus, |from_channel| and |to_channel| must
   // both be valid channel numbers.
@@ -309,6 +309,23 @@ TEST_P(AudioMultiVectorTest, CopyChannel) {
   }
 }
 
+// Test that PushBackInterleaved doesn't reallocate after Reserve.
+TEST_P(AudioMultiVectorTest, Reserve) {
+  AudioMultiVector vec(num_channels_);
+  vec.Reserve(2 * array_length());
+  const size_t capacity = vec.Capacity();
+  EXPECT_GE(capacity, 2 * array_length());
+  vec.PushBackInterleaved(array_interleaved_);
+  vec.PushBackInterleaved(array_interleaved_);
+  EXPECT_EQ(capacity, vec.Capacity());
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    for (size_t i = 0; i < array_length(); ++i) {
+      EXPECT_EQ(static_cast<int16_t>((channel + 1) * 100 + i),
+                vec[channel][array_length() + i]);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(TestNumChannels,
                          AudioMultiVectorTest,
                          ::testing::Values(static_cast<size_t>(1),
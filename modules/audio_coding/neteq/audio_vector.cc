@@ -286,6 +286,9 @@ void AudioVector::Reserve(size_t n) {
   if (capacity_ > n)
     return;
   const size_t length = Size();
+  // Grow geometrically, so that a vector that keeps growing by small amounts
+  // soon stops reallocating.
+  n = std::max(n, 2 * (capacity_ - 1));
   // Reserve one more sample to remove the ambiguity between empty vector and
   // full vector. Therefore |begin_index_| == |end_index_| indicates empty
   // vector, and |begin_index_| == (|end_index_| + 1) % capacity indicates
@@ -298,85 +301,61 @@ void AudioVector::Reserve(size_t n) {
   capacity_ = n + 1;
 }
 
+// The insert functions below make room for the new samples by moving the
+// samples after (or before) |position| within the array, so that no temporary
+// buffer is needed.
+
 void AudioVector::InsertByPushBack(const int16_t* insert_this,
                                    size_t length,
                                    size_t position) {
-  const size_t move_chunk_length = Size() - position;
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (move_chunk_length > 0) {
-    // TODO(minyue): see if it is possible to avoid copying to a buffer.
-    temp_array.reset(new int16_t[move_chunk_length]);
-    CopyTo(move_chunk_length, position, temp_array.get());
-    PopBack(move_chunk_length);
-  }
-
-  Reserve(Size() + length + move_chunk_length);
-  PushBack(insert_this, length);
-  if (move_chunk_length > 0)
-    PushBack(temp_array.get(), move_chunk_length);
+  MakeRoomByPushBack(length, position);
+  OverwriteAt(insert_this, length, position);
 }
 
 void AudioVector::InsertByPushFront(const int16_t* insert_this,
                                     size_t length,
                                     size_t position) {
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (position > 0) {
-    // TODO(minyue): see if it is possible to avoid copying to a buffer.
-    temp_array.reset(new int16_t[position]);
-    CopyTo(position, 0, temp_array.get());
-    PopFront(position);
-  }
-
-  Reserve(Size() + length + position);
-  PushFront(insert_this, length);
-  if (position > 0)
-    PushFront(temp_array.get(), position);
+  MakeRoomByPushFront(length, position);
+  OverwriteAt(insert_this, length, position);
 }
 
 void AudioVector::InsertZerosByPushBack(size_t length, size_t position) {
-  const size_t move_chunk_length = Size() - position;
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (move_chunk_length > 0) {
-    temp_array.reset(new int16_t[move_chunk_length]);
-    CopyTo(move_chunk_length, position, temp_array.get());
-    PopBack(move_chunk_length);
-  }
+  MakeRoomByPushBack(length, position);
+  SetZeros(length, position);
+}
 
-  Reserve(Size() + length + move_chunk_length);
+void AudioVector::InsertZerosByPushFront(size_t length, size_t position) {
+  MakeRoomByPushFront(length, position);
+  SetZeros(length, position);
+}
 
-  const size_t first_zero_chunk_length =
-      std::min(length, capacity_ - end_index_);
-  memset(&array_[end_index_], 0, first_zero_chunk_length * sizeof(int16_t));
-  const size_t remaining_zero_length = length - first_zero_chunk_length;
-  if (remaining_zero_length > 0)
-    memset(array_.get(), 0, remaining_zero_length * sizeof(int16_t));
+void AudioVector::MakeRoomByPushBack(size_t length, size_t position) {
+  const size_t old_size = Size();
+  Reserve(old_size + length);
   end_index_ = (end_index_ + length) % capacity_;
-
-  if (move_chunk_length > 0)
-    PushBack(temp_array.get(), move_chunk_length);
+  // Move the last samples first, since the regions may overlap.
+  for (size_t i = old_size; i > position; --i) {
+    (*this)[i - 1 + length] = (*this)[i - 1];
+  }
 }
 
-void AudioVector::InsertZerosByPushFront(size_t length, size_t position) {
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (position > 0) {
-    temp_array.reset(new int16_t[position]);
-    CopyTo(position, 0, temp_array.get());
-    PopFront(position);
+void AudioVector::MakeRoomByPushFront(size_t length, size_t position) {
+  Reserve(Size() + length);
+  begin_index_ = (begin_index_ + capacity_ - length) % capacity_;
+  // Move the first samples first, since the regions may overlap.
+  for (size_t i = 0; i < position; ++i) {
+    (*this)[i] = (*this)[i + length];
   }
+}
 
-  Reserve(Size() + length + position);
-
-  const size_t first_zero_chunk_length = std::min(length, begin_index_);
-  memset(&array_[begin_index_ - first_zero_chunk_length], 0,
-         first_zero_chunk_length * sizeof(int16_t));
+void AudioVector::SetZeros(size_t length, size_t position) {
+  const size_t zero_index = (begin_index_ + position) % capacity_;
+  const size_t first_zero_chunk_length =
+      std::min(length, capacity_ - zero_index);
+  memset(&array_[zero_index], 0, first_zero_chunk_length * sizeof(int16_t));
   const size_t remaining_zero_length = length - first_zero_chunk_length;
   if (remaining_zero_length > 0)
-    memset(&array_[capacity_ - remaining_zero_length], 0,
-           remaining_zero_length * sizeof(int16_t));
-  begin_index_ = (begin_index_ + capacity_ - length) % capacity_;
-
-  if (position > 0)
-    PushFront(temp_array.get(), position);
+    memset(array_.get(), 0, remaining_zero_length * sizeof(int16_t));
 }
 
 }  // namespace webrtc
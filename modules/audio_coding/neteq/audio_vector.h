@@ -112,6 +112,14 @@ class AudioVector {
   // Returns true if this AudioVector is empty.
   virtual bool Empty() const;
 
+  // Returns the number of elements this AudioVector can hold without
+  // reallocating.
+  size_t Capacity() const { return capacity_ - 1; }
+
+  // Makes room for at least |n| elements, so that the vector doesn't
+  // reallocate until it grows beyond that. Never shrinks the vector.
+  void Reserve(size_t n);
+
   // Accesses and modifies an element of AudioVector.
   inline const int16_t& operator[](size_t index) const {
     return array_[WrapIndex(index, begin_index_, capacity_)];
@@ -140,8 +148,6 @@ class AudioVector {
     return ix;
   }
 
-  void Reserve(size_t n);
-
   void InsertByPushBack(const int16_t* insert_this,
                         size_t length,
                         size_t position);
@@ -154,6 +160,17 @@ class AudioVector {
 
   void InsertZerosByPushFront(size_t length, size_t position);
 
+  // Grows the vector by |length| elements at the end (or the beginning) and
+  // moves the elements from |position| on (or before |position|) to make room
+  // for |length| new elements at |position|. The new elements are not
+  // initialized.
+  void MakeRoomByPushBack(size_t length, size_t position);
+
+  void MakeRoomByPushFront(size_t length, size_t position);
+
+  // Sets |length| elements from |position| to zero, without changing the size.
+  void SetZeros(size_t length, size_t position);
+
   std::unique_ptr<int16_t[]> array_;
 
   size_t capacity_;  // Allocated number of samples in the array.
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 
 #include <string>
+#include <vector>
 
 #include "rtc_base/numerics/safe_conversions.h"
 #include "test/gtest.h"
@@ -195,6 +196,55 @@ TEST_F(AudioVectorTest, InsertAt) {
   }
 }
 
+// Test InsertAt and InsertZerosAt at all positions, with the samples wrapping
+// around the end of the internal array, against a std::vector reference. The
+// inserts must not reallocate when the capacity is sufficient.
+TEST_F(AudioVectorTest, InsertAtAllPositionsWithWrapAround) {
+  static const int16_t kNewArray[] = {100, 101, 102};
+  static const size_t kNewLength = sizeof(kNewArray) / sizeof(kNewArray[0]);
+  for (bool zeros : {false, true}) {
+    for (size_t position = 0; position <= array_length(); ++position) {
+      AudioVector vec;
+      vec.Reserve(array_length() + kNewLength);
+      const size_t capacity = vec.Capacity();
+      // Move the start of the samples towards the end of the internal array.
+      vec.Extend(capacity - 2);
+      vec.PopFront(capacity - 2);
+      vec.PushBack(array_, array_length());
+
+      std::vector<int16_t> expected(array_, array_ + array_length());
+      if (zeros) {
+        vec.InsertZerosAt(kNewLength, position);
+        expected.insert(expected.begin() + position, kNewLength, 0);
+      } else {
+        vec.InsertAt(kNewArray, kNewLength, position);
+        expected.insert(expected.begin() + position, kNewArray,
+                        kNewArray + kNewLength);
+      }
+      EXPECT_EQ(capacity, vec.Capacity());
+      ASSERT_EQ(expected.size(), vec.Size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], vec[i]) << "position: " << position;
+      }
+    }
+  }
+}
+
+// Test that the capacity grows geometrically and is kept by Clear, so that a
+// reused vector stops reallocating.
+TEST_F(AudioVectorTest, CapacityIsKept) {
+  AudioVector vec;
+  vec.PushBack(array_, array_length());
+  const size_t capacity = vec.Capacity();
+  vec.PushBack(array_, 1);
+  EXPECT_GE(vec.Capacity(), 2 * capacity);
+  const size_t grown_capacity = vec.Capacity();
+  vec.Clear();
+  EXPECT_EQ(grown_capacity, vec.Capacity());
+  vec.Reserve(1);
+  EXPECT_EQ(grown_capacity, vec.Capacity());
+}
+
 // Test the InsertZerosAt method with an insert position in the middle of the
 // vector. Use the InsertAt method as reference.
 TEST_F(AudioVectorTest, InsertZerosAt) {
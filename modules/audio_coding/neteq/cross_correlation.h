@@ -46,6 +46,18 @@ int CrossCorrelationWithAutoShift(const int16_t* sequence_1,
                                   int cross_correlation_step,
                                   int32_t* cross_correlation);
 
+// Same as WebRtcSpl_CrossCorrelation(), with |right_shifts| applied to each
+// product, but uses the AVX2 version when the CPU supports it. Since the SPL
+// function pointers are fixed at compile time, this is where the CPU is
+// checked for NetEq.
+void ScaledCrossCorrelation(int32_t* cross_correlation,
+                            const int16_t* seq1,
+                            const int16_t* seq2,
+                            size_t dim_seq,
+                            size_t dim_cross_correlation,
+                            int right_shifts,
+                            int step_seq2);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_CODING_NETEQ_CROSS_CORRELATION_H_
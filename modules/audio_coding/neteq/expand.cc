@@ -73,6 +73,7 @@ int Expand::Process(AudioMultiVector* output) {
   static const int kTempDataSize = 3600;
   int16_t temp_data[kTempDataSize];  // TODO(hlundin) Remove this.
   int16_t* voiced_vector_storage = temp_data;
+  int16_t temp_vector1[kTempDataSize];
   int16_t* voiced_vector = &voiced_vector_storage[overlap_length_];
   static const size_t kNoiseLpcOrder = BackgroundNoise::kMaxLpcOrder;
   int16_t unvoiced_array_memory[kNoiseLpcOrder + kMaxSampleRate / 8000 * 125];
@@ -115,14 +116,14 @@ int Expand::Process(AudioMultiVector* output) {
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
                                        voiced_vector_storage);
     } else if (current_lag_index_ == 1) {
-      std::unique_ptr<int16_t[]> temp_0(new int16_t[temp_length]);
+      // Mix in place, the vectors are combined sample by sample.
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
-                                       temp_0.get());
-      std::unique_ptr<int16_t[]> temp_1(new int16_t[temp_length]);
+                                       voiced_vector_storage);
       parameters.expand_vector1.CopyTo(temp_length, expansion_vector_position,
-                                       temp_1.get());
+                                       temp_vector1);
       // Mix 3/4 of expand_vector0 with 1/4 of expand_vector1.
-      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0.get(), 3, temp_1.get(), 1, 2,
+      WebRtcSpl_ScaleAndAddVectorsWithRound(voiced_vector_storage, 3,
+                                            temp_vector1, 1, 2,
                                             voiced_vector_storage, temp_length);
     } else if (current_lag_index_ == 2) {
       // Mix 1/2 of expand_vector0 with 1/2 of expand_vector1.
@@ -131,13 +132,12 @@ int Expand::Process(AudioMultiVector* output) {
       assert(expansion_vector_position + temp_length <=
              parameters.expand_vector1.Size());
 
-      std::unique_ptr<int16_t[]> temp_0(new int16_t[temp_length]);
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
-                                       temp_0.get());
-      std::unique_ptr<int16_t[]> temp_1(new int16_t[temp_length]);
+                                       voiced_vector_storage);
       parameters.expand_vector1.CopyTo(temp_length, expansion_vector_position,
-                                       temp_1.get());
-      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0.get(), 1, temp_1.get(), 1, 1,
+                                       temp_vector1);
+      WebRtcSpl_ScaleAndAddVectorsWithRound(voiced_vector_storage, 1,
+                                            temp_vector1, 1, 1,
                                             voiced_vector_storage, temp_length);
     }
 
@@ -480,7 +480,7 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     correlation_scale = std::max(0, correlation_scale);
 
     // Calculate the correlation, store in |correlation_vector2|.
-    WebRtcSpl_CrossCorrelation(
+    ScaledCrossCorrelation(
         correlation_vector2,
         &(audio_history[signal_length - correlation_length]),
         &(audio_history[signal_length - correlation_length - start_index]),
@@ -195,6 +195,14 @@ class NetEq {
       bool* muted,
       absl::optional<Operations> action_override = absl::nullopt) = 0;
 
+  // Advances NetEq by 10 ms without producing audio, for when the output of
+  // GetAudio() would be discarded anyway. Inserted packets keep updating the
+  // delay estimate, and packets that would have been played out by now are
+  // discarded from the packet buffer, but nothing is decoded and no signal
+  // processing is done. The next call to GetAudio() continues with the first
+  // packet in the buffer.
+  virtual void SkipAudio() = 0;
+
   // Replaces the current set of decoders with the given one.
   virtual void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) = 0;
 
@@ -254,6 +262,12 @@ class NetEq {
   // statistics are never reset.
   virtual NetEqOperationsAndState GetOperationsAndState() const = 0;
 
+  // Returns the number of bytes allocated for audio samples by the sync
+  // buffer, the algorithm buffer and the decoder output buffer. These buffers
+  // only grow, and stop reallocating once they have fit the largest decoded
+  // frame. Packets waiting in the packet buffer are not included.
+  virtual size_t GetAudioBufferMemoryUsage() const = 0;
+
   // Enables post-decode VAD. When enabled, GetAudio() will return
   // kOutputVADPassive when the signal contains no speech.
   virtual void EnableVad() = 0;
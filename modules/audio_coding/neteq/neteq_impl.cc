@@ -241,6 +241,23 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
   return kOK;
 }
 
+void NetEqImpl::SkipAudio() {
+  TRACE_EVENT0("webrtc", "NetEqImpl::SkipAudio");
+  rtc::CritScope lock(&crit_sect_);
+  // The delay manager measures packet inter-arrival times in ticks.
+  tick_timer_->Increment();
+  last_decoded_timestamps_.clear();
+  last_decoded_packet_infos_.clear();
+  if (first_packet_) {
+    return;
+  }
+  // Dead reckoning, as in expand.
+  playout_timestamp_ += static_cast<uint32_t>(output_size_samples_);
+  packet_buffer_->DiscardOldPackets(playout_timestamp_, 5 * fs_hz_,
+                                    stats_.get());
+  resync_after_skipped_audio_ = true;
+}
+
 void NetEqImpl::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   rtc::CritScope lock(&crit_sect_);
   const std::vector<int> changed_payload_types =
@@ -363,6 +380,19 @@ NetEqOperationsAndState NetEqImpl::GetOperationsAndState() const {
   return result;
 }
 
+size_t NetEqImpl::GetAudioBufferMemoryUsage() const {
+  rtc::CritScope lock(&crit_sect_);
+  size_t num_samples = decoded_buffer_length_;
+  if (sync_buffer_) {
+    num_samples += sync_buffer_->Capacity() * sync_buffer_->Channels();
+  }
+  if (algorithm_buffer_) {
+    num_samples +=
+        algorithm_buffer_->Capacity() * algorithm_buffer_->Channels();
+  }
+  return num_samples * sizeof(int16_t);
+}
+
 void NetEqImpl::EnableVad() {
   rtc::CritScope lock(&crit_sect_);
   assert(vad_.get());
@@ -422,6 +452,7 @@ void NetEqImpl::FlushBuffers() {
                                expand_->overlap_length());
   // Set to wait for new codec.
   first_packet_ = true;
+  resync_after_skipped_audio_ = false;
 }
 
 void NetEqImpl::EnableNack(size_t max_nack_list_size) {
@@ -1013,6 +1044,19 @@ int NetEqImpl::GetDecision(Operations* operation,
   }
   const Packet* packet = packet_buffer_->PeekNextPacket();
 
+  if (resync_after_skipped_audio_ && packet) {
+    // Audio was skipped. Drop the decoded audio that is left, except for the
+    // overlap, and continue with the next packet as if it followed directly.
+    if (sync_buffer_->FutureLength() > expand_->overlap_length()) {
+      sync_buffer_->set_next_index(sync_buffer_->Size() -
+                                   expand_->overlap_length());
+    }
+    sync_buffer_->IncreaseEndTimestamp(packet->timestamp - end_timestamp);
+    end_timestamp = packet->timestamp;
+    generated_noise_stopwatch_.reset();
+    resync_after_skipped_audio_ = false;
+  }
+
   RTC_DCHECK(!generated_noise_stopwatch_ ||
              generated_noise_stopwatch_->ElapsedTicks() >= 1);
   uint64_t generated_noise_samples =
@@ -140,6 +140,8 @@ class NetEqImpl : public webrtc::NetEq {
       bool* muted,
       absl::optional<Operations> action_override = absl::nullopt) override;
 
+  void SkipAudio() override;
+
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) override;
 
   bool RegisterPayloadType(int rtp_payload_type,
@@ -171,6 +173,8 @@ class NetEqImpl : public webrtc::NetEq {
 
   NetEqOperationsAndState GetOperationsAndState() const override;
 
+  size_t GetAudioBufferMemoryUsage() const override;
+
   // Enables post-decode VAD. When enabled, GetAudio() will return
   // kOutputVADPassive when the signal contains no speech.
   void EnableVad() override;
@@ -399,6 +403,8 @@ class NetEqImpl : public webrtc::NetEq {
   absl::optional<uint8_t> current_cng_rtp_payload_type_
       RTC_GUARDED_BY(crit_sect_);
   bool first_packet_ RTC_GUARDED_BY(crit_sect_);
+  // Set by SkipAudio(), cleared when decoding resumes.
+  bool resync_after_skipped_audio_ RTC_GUARDED_BY(crit_sect_) = false;
   bool enable_fast_accelerate_ RTC_GUARDED_BY(crit_sect_);
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(crit_sect_);
   bool nack_enabled_ RTC_GUARDED_BY(crit_sect_);
@@ -1338,6 +1338,68 @@ TEST_F(NetEqImplTest, TickTimerIncrement) {
   EXPECT_EQ(1u, tick_timer_->ticks());
 }
 
+// Skipping audio should keep the packet buffer at its level instead of letting
+// it fill up, and decoding should resume with the oldest remaining packet.
+TEST_F(NetEqImplTest, SkipAudio) {
+  UseNoMocks();
+  CreateInstance();
+
+  const size_t kPayloadLengthSamples = 80;
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;  // PCM 16-bit.
+  const uint8_t kPayloadType = 17;  // Just an arbitrary number.
+  const size_t kInitialPackets = 5;
+  const int kSkippedFrames =
+      rtc::checked_cast<int>(2 * config_.max_packets_in_buffer);
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("l16", 8000, 1)));
+
+  auto insert_packet = [&] {
+    EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+    rtp_header.timestamp += rtc::checked_cast<uint32_t>(kPayloadLengthSamples);
+    ++rtp_header.sequenceNumber;
+  };
+
+  for (size_t i = 0; i < kInitialPackets; ++i) {
+    insert_packet();
+  }
+  AudioFrame output;
+  bool muted;
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  const size_t num_packets = packet_buffer_->NumPacketsInBuffer();
+  const absl::optional<uint32_t> playout_timestamp =
+      neteq_->GetPlayoutTimestamp();
+  ASSERT_TRUE(playout_timestamp);
+
+  // One packet arrives per skipped frame.
+  for (int i = 0; i < kSkippedFrames; ++i) {
+    insert_packet();
+    neteq_->SkipAudio();
+    EXPECT_LE(packet_buffer_->NumPacketsInBuffer(), num_packets + 1);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kSkippedFrames + 1), tick_timer_->ticks());
+  EXPECT_EQ(absl::optional<uint32_t>(
+                *playout_timestamp +
+                rtc::checked_cast<uint32_t>(kSkippedFrames *
+                                            kPayloadLengthSamples)),
+            neteq_->GetPlayoutTimestamp());
+
+  const Packet* next_packet = packet_buffer_->PeekNextPacket();
+  ASSERT_TRUE(next_packet);
+  const uint32_t next_timestamp = next_packet->timestamp;
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  EXPECT_FALSE(muted);
+  EXPECT_EQ(AudioFrame::kNormalSpeech, output.speech_type_);
+  ASSERT_FALSE(output.packet_infos_.empty());
+  EXPECT_EQ(next_timestamp, output.packet_infos_[0].rtp_timestamp());
+}
+
 TEST_F(NetEqImplTest, SetBaseMinimumDelay) {
   UseNoMocks();
   use_mock_delay_manager_ = true;
@@ -9,13 +9,12 @@
  */
 
 // This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// an STL deque. The deque is kept sorted at all times so that the next packet
+// to decode is at the beginning of the deque.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -75,6 +74,7 @@ PacketBuffer::~PacketBuffer() {
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
   buffer_.clear();
+  InvalidateNumSamplesCache();
 }
 
 bool PacketBuffer::Empty() const {
@@ -103,14 +103,15 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
   }
 
   // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // should be inserted. The buffer is searched from the back, since the most
+  // likely case is that the new packet should be at the end of it, in which
+  // case this is a single comparison.
+  auto rit = std::find_if(buffer_.rbegin(), buffer_.rend(),
+                          NewTimestampIsLarger(packet));
 
   // The new packet is to be inserted to the right of |rit|. If it has the same
   // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
+  // packet to the buffer.
   if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
@@ -119,12 +120,16 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
   // The new packet is to be inserted to the left of |it|. If it has the same
   // timestamp as |it|, which has a lower priority, replace |it| with the new
   // packet.
-  PacketList::iterator it = rit.base();
+  auto it = rit.base();
   if (it != buffer_.end() && packet.timestamp == it->timestamp) {
     LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+    *it = std::move(packet);  // Replace the packet at that position.
+  } else if (it == buffer_.end()) {
+    buffer_.push_back(std::move(packet));
+  } else {
+    buffer_.insert(it, std::move(packet));  // Insert the packet in between.
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InvalidateNumSamplesCache();
 
   return return_val;
 }
@@ -194,11 +199,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (const Packet& packet : buffer_) {
+    if (packet.timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = packet.timestamp;
       return kOK;
     }
   }
@@ -219,6 +223,7 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
   buffer_.pop_front();
+  InvalidateNumSamplesCache();
 
   return packet;
 }
@@ -232,20 +237,43 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
   buffer_.pop_front();
+  InvalidateNumSamplesCache();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
-    if (timestamp_limit == p.timestamp ||
-        !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  auto is_old = [timestamp_limit, horizon_samples](const Packet& p) {
+    return timestamp_limit != p.timestamp &&
+           IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples);
+  };
+  // The buffer is sorted, so the old packets are usually a run at its front.
+  // Drop that without compacting the rest of the buffer, and fall back to a
+  // full pass only if any are left further back, e.g. after a timestamp jump.
+  bool removed = false;
+  while (!buffer_.empty() && is_old(buffer_.front())) {
+    LogPacketDiscarded(buffer_.front().priority.codec_level, stats);
+    buffer_.pop_front();
+    removed = true;
+  }
+  auto first_old = std::find_if(buffer_.begin(), buffer_.end(), is_old);
+  if (first_old != buffer_.end()) {
+    buffer_.erase(std::remove_if(first_old, buffer_.end(),
+                                 [&is_old, stats](const Packet& p) {
+                                   if (!is_old(p)) {
+                                     return false;
+                                   }
+                                   LogPacketDiscarded(p.priority.codec_level,
+                                                      stats);
+                                   return true;
+                                 }),
+                  buffer_.end());
+    removed = true;
+  }
+  if (removed) {
+    InvalidateNumSamplesCache();
+  }
 }
 
 void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
@@ -255,13 +283,18 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
-    if (p.payload_type != payload_type) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  auto first_removed = std::remove_if(
+      buffer_.begin(), buffer_.end(), [payload_type, stats](const Packet& p) {
+        if (p.payload_type != payload_type) {
+          return false;
+        }
+        LogPacketDiscarded(p.priority.codec_level, stats);
+        return true;
+      });
+  if (first_removed != buffer_.end()) {
+    buffer_.erase(first_removed, buffer_.end());
+    InvalidateNumSamplesCache();
+  }
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
@@ -269,6 +302,10 @@ size_t PacketBuffer::NumPacketsInBuffer() const {
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
+  if (cached_num_samples_ &&
+      cached_last_decoded_length_ == last_decoded_length) {
+    return *cached_num_samples_;
+  }
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
   for (const Packet& packet : buffer_) {
@@ -285,6 +322,8 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
     }
     num_samples += last_duration;
   }
+  cached_num_samples_ = num_samples;
+  cached_last_decoded_length_ = last_decoded_length;
   return num_samples;
 }
 
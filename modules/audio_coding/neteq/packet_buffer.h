@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <deque>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -146,9 +148,21 @@ class PacketBuffer {
   }
 
  private:
+  // Marks the cached result of NumSamplesInBuffer() as stale. Called whenever
+  // packets are added to or removed from |buffer_|.
+  void InvalidateNumSamplesCache() { cached_num_samples_ = absl::nullopt; }
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Sorted by timestamp. A deque rather than a list: packets mostly arrive in
+  // order and leave from the front, which it handles without a heap allocation
+  // per packet, and it is cheaper to iterate.
+  std::deque<Packet> buffer_;
   const TickTimer* tick_timer_;
+  // NumSamplesInBuffer() is queried several times per 10 ms by NetEq between
+  // changes to the buffer, so its result is kept until the buffer changes or it
+  // is asked for with another |last_decoded_length|.
+  mutable absl::optional<size_t> cached_num_samples_;
+  mutable size_t cached_last_decoded_length_ = 0;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
 
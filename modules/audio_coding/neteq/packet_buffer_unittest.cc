@@ -400,6 +400,39 @@ TEST(PacketBuffer, DiscardPackets) {
   EXPECT_TRUE(buffer.Empty());
 }
 
+// Verifies that the number of samples follows the changes to the buffer and to
+// |last_decoded_length|.
+TEST(PacketBuffer, NumSamplesInBuffer) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);
+  PacketGenerator gen(0, 0, 0, 10);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  EXPECT_EQ(0u, buffer.NumSamplesInBuffer(10));
+
+  // Packets without a frame count as |last_decoded_length| samples each.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats));
+  }
+  EXPECT_EQ(30u, buffer.NumSamplesInBuffer(10));
+  EXPECT_EQ(30u, buffer.NumSamplesInBuffer(10));
+  EXPECT_EQ(60u, buffer.NumSamplesInBuffer(20));
+
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats));
+  EXPECT_EQ(80u, buffer.NumSamplesInBuffer(20));
+
+  EXPECT_CALL(mock_stats, PacketsDiscarded(1));
+  EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket(&mock_stats));
+  EXPECT_EQ(60u, buffer.NumSamplesInBuffer(20));
+
+  EXPECT_TRUE(buffer.GetNextPacket());
+  EXPECT_EQ(40u, buffer.NumSamplesInBuffer(20));
+
+  buffer.Flush();
+  EXPECT_EQ(0u, buffer.NumSamplesInBuffer(20));
+}
+
 TEST(PacketBuffer, Reordering) {
   TickTimer tick_timer;
   PacketBuffer buffer(100, &tick_timer);  // 100 packets.
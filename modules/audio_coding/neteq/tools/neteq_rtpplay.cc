@@ -145,6 +145,10 @@ ABSL_FLAG(bool,
           "Generates a text log describing the simulation on a "
           "step-by-step basis.");
 ABSL_FLAG(bool, concealment_events, false, "Prints concealment events");
+ABSL_FLAG(bool,
+          operation_costs,
+          false,
+          "Prints the time spent in GetAudio() by NetEq operation");
 ABSL_FLAG(int,
           max_nr_packets_in_buffer,
           TestConfig::default_max_nr_packets_in_buffer(),
@@ -372,6 +376,7 @@ int main(int argc, char* argv[]) {
   config.matlabplot = absl::GetFlag(FLAGS_matlabplot);
   config.pythonplot = absl::GetFlag(FLAGS_pythonplot);
   config.concealment_events = absl::GetFlag(FLAGS_concealment_events);
+  config.operation_costs = absl::GetFlag(FLAGS_operation_costs);
   config.max_nr_packets_in_buffer =
       absl::GetFlag(FLAGS_max_nr_packets_in_buffer);
   config.enable_fast_accelerate = absl::GetFlag(FLAGS_enable_fast_accelerate);
@@ -0,0 +1,299 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/types/optional.h"
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/audio_coding/neteq/tools/neteq_test_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/testsupport/file_utils.h"
+
+ABSL_FLAG(int,
+          num_threads,
+          0,
+          "Number of simulations to run in parallel. Defaults to the number of "
+          "cores.");
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+          " will assign the group Enable to field trial WebRTC-FooFeature. "
+          "The field trials apply to all the simulations.");
+ABSL_FLAG(int,
+          max_nr_packets_in_buffer,
+          webrtc::test::NetEqTestFactory::Config::
+              default_max_nr_packets_in_buffer(),
+          "Maximum allowed number of packets in the buffer");
+ABSL_FLAG(bool,
+          enable_fast_accelerate,
+          false,
+          "Enables jitter buffer fast accelerate");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+struct SimulationResult {
+  std::string input_filename;
+  bool ok = false;
+  int64_t duration_ms = 0;
+  NetEqStatsGetter::Stats stats;
+  NetEqLifetimeStatistics lifetime_stats;
+};
+
+// Runs the simulations of |inputs| on |num_threads| threads. Every thread
+// takes the next input that is not taken yet, so that long and short inputs
+// even out over the threads.
+class BatchRunner {
+ public:
+  BatchRunner(const std::vector<std::string>& inputs,
+              const NetEqTestFactory::Config& config)
+      : config_(config), results_(inputs.size()) {
+    for (size_t i = 0; i < inputs.size(); ++i)
+      results_[i].input_filename = inputs[i];
+  }
+
+  const std::vector<SimulationResult>& Run(int num_threads) {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(std::make_unique<rtc::PlatformThread>(
+          &BatchRunner::RunThread, this, "NetEqBatch"));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads)
+      thread->Stop();
+    return results_;
+  }
+
+ private:
+  static void RunThread(void* obj) {
+    BatchRunner* runner = static_cast<BatchRunner*>(obj);
+    for (size_t i = runner->next_input_++; i < runner->results_.size();
+         i = runner->next_input_++) {
+      runner->RunSimulation(&runner->results_[i]);
+    }
+  }
+
+  void RunSimulation(SimulationResult* result) {
+    NetEqTestFactory factory;
+    std::unique_ptr<NetEqTest> test =
+        factory.InitializeTestFromFile(result->input_filename, config_);
+    if (!test)
+      return;
+    result->duration_ms = test->Run();
+    result->stats = factory.stats_getter()->AverageStats();
+    result->lifetime_stats = test->LifetimeStats();
+    result->ok = true;
+  }
+
+  const NetEqTestFactory::Config config_;
+  // Each result is only written by the thread that took its input.
+  std::vector<SimulationResult> results_;
+  std::atomic<size_t> next_input_{0};
+};
+
+void AddLifetimeStats(const NetEqLifetimeStatistics& stats,
+                      NetEqLifetimeStatistics* total) {
+  total->total_samples_received += stats.total_samples_received;
+  total->concealed_samples += stats.concealed_samples;
+  total->concealment_events += stats.concealment_events;
+  total->jitter_buffer_delay_ms += stats.jitter_buffer_delay_ms;
+  total->jitter_buffer_emitted_count += stats.jitter_buffer_emitted_count;
+  total->inserted_samples_for_deceleration +=
+      stats.inserted_samples_for_deceleration;
+  total->removed_samples_for_acceleration +=
+      stats.removed_samples_for_acceleration;
+  total->silent_concealed_samples += stats.silent_concealed_samples;
+  total->fec_packets_received += stats.fec_packets_received;
+  total->fec_packets_discarded += stats.fec_packets_discarded;
+  total->delayed_packet_outage_samples += stats.delayed_packet_outage_samples;
+  total->relative_packet_arrival_delay_ms +=
+      stats.relative_packet_arrival_delay_ms;
+  total->jitter_buffer_packets_received += stats.jitter_buffer_packets_received;
+  total->interruption_count += stats.interruption_count;
+  total->total_interruption_duration_ms += stats.total_interruption_duration_ms;
+}
+
+// Averages the stats over all simulations, weighted by their duration.
+NetEqStatsGetter::Stats WeightedAverageStats(
+    const std::vector<SimulationResult>& results) {
+  NetEqStatsGetter::Stats average;
+  int64_t total_duration_ms = 0;
+  for (const SimulationResult& result : results) {
+    if (!result.ok)
+      continue;
+    const double w = result.duration_ms;
+    const NetEqStatsGetter::Stats& s = result.stats;
+    average.current_buffer_size_ms += w * s.current_buffer_size_ms;
+    average.preferred_buffer_size_ms += w * s.preferred_buffer_size_ms;
+    average.jitter_peaks_found += w * s.jitter_peaks_found;
+    average.packet_loss_rate += w * s.packet_loss_rate;
+    average.expand_rate += w * s.expand_rate;
+    average.speech_expand_rate += w * s.speech_expand_rate;
+    average.preemptive_rate += w * s.preemptive_rate;
+    average.accelerate_rate += w * s.accelerate_rate;
+    average.secondary_decoded_rate += w * s.secondary_decoded_rate;
+    average.secondary_discarded_rate += w * s.secondary_discarded_rate;
+    average.clockdrift_ppm += w * s.clockdrift_ppm;
+    average.added_zero_samples += w * s.added_zero_samples;
+    average.mean_waiting_time_ms += w * s.mean_waiting_time_ms;
+    average.median_waiting_time_ms += w * s.median_waiting_time_ms;
+    average.min_waiting_time_ms += w * s.min_waiting_time_ms;
+    average.max_waiting_time_ms += w * s.max_waiting_time_ms;
+    total_duration_ms += result.duration_ms;
+  }
+  if (total_duration_ms == 0)
+    return average;
+  const double scale = 1.0 / total_duration_ms;
+  average.current_buffer_size_ms *= scale;
+  average.preferred_buffer_size_ms *= scale;
+  average.jitter_peaks_found *= scale;
+  average.packet_loss_rate *= scale;
+  average.expand_rate *= scale;
+  average.speech_expand_rate *= scale;
+  average.preemptive_rate *= scale;
+  average.accelerate_rate *= scale;
+  average.secondary_decoded_rate *= scale;
+  average.secondary_discarded_rate *= scale;
+  average.clockdrift_ppm *= scale;
+  average.added_zero_samples *= scale;
+  average.mean_waiting_time_ms *= scale;
+  average.median_waiting_time_ms *= scale;
+  average.min_waiting_time_ms *= scale;
+  average.max_waiting_time_ms *= scale;
+  return average;
+}
+
+void PrintReport(const std::vector<SimulationResult>& results) {
+  NetEqLifetimeStatistics total;
+  int64_t total_duration_ms = 0;
+  int num_failed = 0;
+  printf("Simulations:\n");
+  for (const SimulationResult& result : results) {
+    if (!result.ok) {
+      printf("  %s: failed\n", result.input_filename.c_str());
+      ++num_failed;
+      continue;
+    }
+    printf("  %s: %" PRId64 " ms, expand_rate %f %%, accelerate_rate %f %%, "
+           "preemptive_rate %f %%, mean_waiting_time %f ms\n",
+           result.input_filename.c_str(), result.duration_ms,
+           100.0 * result.stats.expand_rate,
+           100.0 * result.stats.accelerate_rate,
+           100.0 * result.stats.preemptive_rate,
+           result.stats.mean_waiting_time_ms);
+    AddLifetimeStats(result.lifetime_stats, &total);
+    total_duration_ms += result.duration_ms;
+  }
+
+  const NetEqStatsGetter::Stats stats = WeightedAverageStats(results);
+  printf("Aggregated statistics of %d simulations (%d failed):\n",
+         static_cast<int>(results.size()) - num_failed, num_failed);
+  printf("  output duration: %" PRId64 " ms\n", total_duration_ms);
+  printf("  packet_loss_rate: %f %%\n", 100.0 * stats.packet_loss_rate);
+  printf("  expand_rate: %f %%\n", 100.0 * stats.expand_rate);
+  printf("  speech_expand_rate: %f %%\n", 100.0 * stats.speech_expand_rate);
+  printf("  preemptive_rate: %f %%\n", 100.0 * stats.preemptive_rate);
+  printf("  accelerate_rate: %f %%\n", 100.0 * stats.accelerate_rate);
+  printf("  secondary_decoded_rate: %f %%\n",
+         100.0 * stats.secondary_decoded_rate);
+  printf("  secondary_discarded_rate: %f %%\n",
+         100.0 * stats.secondary_discarded_rate);
+  printf("  clockdrift_ppm: %f ppm\n", stats.clockdrift_ppm);
+  printf("  mean_waiting_time_ms: %f ms\n", stats.mean_waiting_time_ms);
+  printf("  median_waiting_time_ms: %f ms\n", stats.median_waiting_time_ms);
+  printf("  min_waiting_time_ms: %f ms\n", stats.min_waiting_time_ms);
+  printf("  max_waiting_time_ms: %f ms\n", stats.max_waiting_time_ms);
+  printf("  current_buffer_size_ms: %f ms\n", stats.current_buffer_size_ms);
+  printf("  preferred_buffer_size_ms: %f ms\n", stats.preferred_buffer_size_ms);
+  printf("  total_samples_received: %" PRIu64 "\n",
+         total.total_samples_received);
+  printf("  concealed_samples: %" PRIu64 "\n", total.concealed_samples);
+  printf("  concealment_events: %" PRIu64 "\n", total.concealment_events);
+  printf("  jitter_buffer_delay: %f ms\n",
+         total.jitter_buffer_emitted_count > 0
+             ? static_cast<double>(total.jitter_buffer_delay_ms) /
+                   total.jitter_buffer_emitted_count
+             : 0.0);
+  printf("  inserted_samples_for_deceleration: %" PRIu64 "\n",
+         total.inserted_samples_for_deceleration);
+  printf("  removed_samples_for_acceleration: %" PRIu64 "\n",
+         total.removed_samples_for_acceleration);
+  printf("  delayed_packet_outage_samples: %" PRIu64 "\n",
+         total.delayed_packet_outage_samples);
+  printf("  interruption_count: %d\n", total.interruption_count);
+  printf("  total_interruption_duration_ms: %d\n",
+         total.total_interruption_duration_ms);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  std::string usage =
+      "Tool for running NetEq over every RTP dump and event log file in a "
+      "directory, in parallel, and aggregating the statistics.\n"
+      "Example usage:\n"
+      "./neteq_rtpplay_batch input_dir\n";
+  if (args.size() != 2) {
+    std::cout << usage;
+    exit(0);
+  }
+
+  absl::optional<std::vector<std::string>> entries =
+      webrtc::test::ReadDirectory(args[1]);
+  RTC_CHECK(entries) << "ERROR: Unable to read directory " << args[1];
+  std::vector<std::string> inputs;
+  for (const std::string& entry : *entries) {
+    if (!webrtc::test::DirExists(entry))
+      inputs.push_back(entry);
+  }
+  std::sort(inputs.begin(), inputs.end());
+
+  // The field trials are global, so they are set once for all simulations
+  // rather than through the config of each of them.
+  const std::string force_fieldtrials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(force_fieldtrials.c_str());
+
+  webrtc::test::NetEqTestFactory::Config config;
+  config.max_nr_packets_in_buffer =
+      absl::GetFlag(FLAGS_max_nr_packets_in_buffer);
+  config.enable_fast_accelerate = absl::GetFlag(FLAGS_enable_fast_accelerate);
+  config.print_stats = false;
+
+  int num_threads = absl::GetFlag(FLAGS_num_threads);
+  if (num_threads <= 0)
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+  num_threads =
+      std::max(1, std::min(num_threads, static_cast<int>(inputs.size())));
+
+  webrtc::test::BatchRunner runner(inputs, config);
+  webrtc::test::PrintReport(runner.Run(num_threads));
+  return 0;
+}
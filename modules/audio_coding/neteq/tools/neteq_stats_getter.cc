@@ -38,12 +38,34 @@ void NetEqStatsGetter::BeforeGetAudio(NetEq* neteq) {
   if (delay_analyzer_) {
     delay_analyzer_->BeforeGetAudio(neteq);
   }
+  get_audio_start_time_us_ = rtc::TimeMicros();
 }
 
 void NetEqStatsGetter::AfterGetAudio(int64_t time_now_ms,
                                      const AudioFrame& audio_frame,
                                      bool muted,
                                      NetEq* neteq) {
+  const int64_t get_audio_time_us =
+      rtc::TimeMicros() - get_audio_start_time_us_;
+  const NetEqOperationsAndState operations = neteq->GetOperationsAndState();
+  const char* operation = "normal";
+  if (operations.accelerate_samples != last_accelerate_samples_) {
+    operation = "accelerate";
+  } else if (operations.preemptive_samples != last_preemptive_samples_) {
+    operation = "preemptive_expand";
+  } else if (audio_frame.speech_type_ == AudioFrame::kPLC ||
+             audio_frame.speech_type_ == AudioFrame::kPLCCNG ||
+             audio_frame.speech_type_ == AudioFrame::kCodecPLC) {
+    operation = "expand";
+  } else if (audio_frame.speech_type_ == AudioFrame::kCNG) {
+    operation = "cng";
+  }
+  last_accelerate_samples_ = operations.accelerate_samples;
+  last_preemptive_samples_ = operations.preemptive_samples;
+  OperationCost& cost = operation_costs_[operation];
+  ++cost.num_calls;
+  cost.total_time_us += get_audio_time_us;
+
   // TODO(minyue): Get stats should better not be called as a call back after
   // get audio. It is called independently from get audio in practice.
   const auto lifetime_stat = neteq->GetLifetimeStatistics();
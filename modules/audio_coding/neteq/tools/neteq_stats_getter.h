@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_STATS_GETTER_H_
 #define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_STATS_GETTER_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -51,6 +52,13 @@ class NetEqStatsGetter : public NetEqGetAudioCallback {
     std::string ToString() const;
   };
 
+  // Wall-clock time spent in NetEq::GetAudio(), for the calls where NetEq
+  // performed a given operation.
+  struct OperationCost {
+    int64_t num_calls = 0;
+    int64_t total_time_us = 0;
+  };
+
   // Takes a pointer to another callback object, which will be invoked after
   // this object finishes. This does not transfer ownership, and null is a
   // valid value.
@@ -88,6 +96,13 @@ class NetEqStatsGetter : public NetEqGetAudioCallback {
 
   Stats AverageStats() const;
 
+  // The cost of GetAudio() by operation, as far as the operation can be told
+  // from the output frame and the stats: "accelerate", "preemptive_expand",
+  // "expand", "cng" and "normal", which includes merges.
+  const std::map<std::string, OperationCost>& operation_costs() const {
+    return operation_costs_;
+  }
+
  private:
   std::unique_ptr<NetEqDelayAnalyzer> delay_analyzer_;
   int64_t stats_query_interval_ms_ = 1000;
@@ -98,6 +113,10 @@ class NetEqStatsGetter : public NetEqGetAudioCallback {
   uint64_t voice_concealed_samples_until_last_event_ = 0;
   std::vector<ConcealmentEvent> concealment_events_;
   int64_t last_event_end_time_ms_ = 0;
+  int64_t get_audio_start_time_us_ = 0;
+  uint64_t last_accelerate_samples_ = 0;
+  uint64_t last_preemptive_samples_ = 0;
+  std::map<std::string, OperationCost> operation_costs_;
 };
 
 }  // namespace test
@@ -21,10 +21,12 @@ namespace test {
 NetEqStatsPlotter::NetEqStatsPlotter(bool make_matlab_plot,
                                      bool make_python_plot,
                                      bool show_concealment_events,
+                                     bool show_operation_costs,
                                      std::string base_file_name)
     : make_matlab_plot_(make_matlab_plot),
       make_python_plot_(make_python_plot),
       show_concealment_events_(show_concealment_events),
+      show_operation_costs_(show_operation_costs),
       base_file_name_(base_file_name) {
   std::unique_ptr<NetEqDelayAnalyzer> delay_analyzer;
   if (make_matlab_plot || make_python_plot) {
@@ -76,6 +78,15 @@ void NetEqStatsPlotter::SimulationEnded(int64_t simulation_time_ms) {
       printf("%s\n", concealment_event.ToString().c_str());
     printf(" end of concealment_events_ms\n");
   }
+  if (show_operation_costs_) {
+    printf("  operation_costs:\n");
+    for (const auto& operation_cost : stats_getter_->operation_costs()) {
+      const NetEqStatsGetter::OperationCost& cost = operation_cost.second;
+      printf("    %s: %" PRId64 " calls, %f us per call\n",
+             operation_cost.first.c_str(), cost.num_calls,
+             static_cast<double>(cost.total_time_us) / cost.num_calls);
+    }
+  }
 
   const auto lifetime_stats_vector = stats_getter_->lifetime_stats();
   if (!lifetime_stats_vector->empty()) {
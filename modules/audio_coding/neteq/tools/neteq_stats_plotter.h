@@ -26,6 +26,7 @@ class NetEqStatsPlotter : public NetEqSimulationEndedCallback {
   NetEqStatsPlotter(bool make_matlab_plot,
                     bool make_python_plot,
                     bool show_concealment_events,
+                    bool show_operation_costs,
                     std::string base_file_name);
 
   void SimulationEnded(int64_t simulation_time_ms) override;
@@ -37,6 +38,7 @@ class NetEqStatsPlotter : public NetEqSimulationEndedCallback {
   const bool make_matlab_plot_;
   const bool make_python_plot_;
   const bool show_concealment_events_;
+  const bool show_operation_costs_;
   const std::string base_file_name_;
 };
 
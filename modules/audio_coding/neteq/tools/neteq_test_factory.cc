@@ -149,6 +149,10 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTestFromFile(
   return InitializeTest(std::move(input), config);
 }
 
+NetEqStatsGetter* NetEqTestFactory::stats_getter() {
+  return stats_plotter_ ? stats_plotter_->stats_getter() : nullptr;
+}
+
 std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     std::unique_ptr<NetEqInput> input,
     const Config& config) {
@@ -314,13 +318,15 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
   NetEqTest::Callbacks callbacks;
   stats_plotter_ = std::make_unique<NetEqStatsPlotter>(
       config.matlabplot, config.pythonplot, config.concealment_events,
-      config.plot_scripts_basename.value_or(""));
+      config.operation_costs, config.plot_scripts_basename.value_or(""));
 
   ssrc_switch_detector_.reset(
       new SsrcSwitchDetector(stats_plotter_->stats_getter()->delay_analyzer()));
   callbacks.post_insert_packet = ssrc_switch_detector_.get();
   callbacks.get_audio_callback = stats_plotter_->stats_getter();
-  callbacks.simulation_ended_callback = stats_plotter_.get();
+  if (config.print_stats) {
+    callbacks.simulation_ended_callback = stats_plotter_.get();
+  }
   NetEq::Config neteq_config;
   neteq_config.sample_rate_hz = *sample_rate_hz;
   neteq_config.max_packets_in_buffer = config.max_nr_packets_in_buffer;
@@ -120,6 +120,8 @@ class NetEqTestFactory {
     bool pythonplot = false;
     // Prints concealment events.
     bool concealment_events = false;
+    // Prints the time spent in GetAudio() by NetEq operation.
+    bool operation_costs = false;
     // Maximum allowed number of packets in the buffer.
     static constexpr int default_max_nr_packets_in_buffer() { return 50; }
     int max_nr_packets_in_buffer = default_max_nr_packets_in_buffer();
@@ -141,6 +143,10 @@ class NetEqTestFactory {
     absl::optional<std::string> output_audio_filename;
     // Field trials to use during the simulation.
     std::string field_trial_string;
+    // Prints the simulation statistics and writes the plot scripts when the
+    // simulation ends. Runs of many simulations in parallel turn this off and
+    // read the statistics from stats_getter() instead.
+    bool print_stats = true;
   };
 
   std::unique_ptr<NetEqTest> InitializeTestFromFile(
@@ -150,6 +156,10 @@ class NetEqTestFactory {
       const std::string& input_string,
       const Config& config);
 
+  // Returns the statistics of the last initialized test, or null if no test
+  // was initialized.
+  NetEqStatsGetter* stats_getter();
+
  private:
   std::unique_ptr<NetEqTest> InitializeTest(std::unique_ptr<NetEqInput> input,
                                             const Config& config);
@@ -41,6 +41,19 @@ static const size_t kMinValidCallTimeTimeInMilliseconds =
 static const double k2Pi = 6.28318530717959;
 #endif
 
+namespace {
+
+// Raises |*level| to |value| if it's larger.
+void UpdateMaxLevel(std::atomic<int16_t>* level, int16_t value) {
+  int16_t current = level->load(std::memory_order_relaxed);
+  while (value > current &&
+         !level->compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
 AudioDeviceBuffer::AudioDeviceBuffer(TaskQueueFactory* task_queue_factory)
     : task_queue_(task_queue_factory->CreateTaskQueue(
           kTimerQueueName,
@@ -63,6 +76,8 @@ AudioDeviceBuffer::AudioDeviceBuffer(TaskQueueFactory* task_queue_factory)
       only_silence_recorded_(true),
       log_stats_(false) {
   RTC_LOG(INFO) << "AudioDeviceBuffer::ctor";
+  play_buffer_.EnsureCapacity(kMaxBufferSizeBytes / sizeof(int16_t));
+  rec_buffer_.EnsureCapacity(kMaxBufferSizeBytes / sizeof(int16_t));
 #ifdef AUDIO_DEVICE_PLAYS_SINUS_TONE
   phase_ = 0.0;
   RTC_LOG(WARNING) << "AUDIO_DEVICE_PLAYS_SINUS_TONE is defined!";
@@ -231,6 +246,7 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audio_buffer,
                                              size_t samples_per_channel) {
   // Copy the complete input buffer to the local buffer.
   const size_t old_size = rec_buffer_.size();
+  const size_t old_capacity = rec_buffer_.capacity();
   rec_buffer_.SetData(static_cast<const int16_t*>(audio_buffer),
                       rec_channels_ * samples_per_channel);
   // Keep track of the size of the recording buffer. Only updated when the
@@ -238,6 +254,7 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audio_buffer,
   if (old_size != rec_buffer_.size()) {
     RTC_LOG(LS_INFO) << "Size of recording buffer: " << rec_buffer_.size();
   }
+  const bool allocated = rec_buffer_.capacity() != old_capacity;
 
   // Derive a new level value twice per second and check if it is non-zero.
   int16_t max_abs = 0;
@@ -255,7 +272,7 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audio_buffer,
   }
   // Update recording stats which is used as base for periodic logging of the
   // audio input state.
-  UpdateRecStats(max_abs, samples_per_channel);
+  UpdateRecStats(max_abs, samples_per_channel, allocated);
   return 0;
 }
 
@@ -283,10 +300,12 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t samples_per_channel) {
   // resize the buffer accordingly. Also takes place at the first call to this
   // method.
   const size_t total_samples = play_channels_ * samples_per_channel;
+  const size_t old_capacity = play_buffer_.capacity();
   if (play_buffer_.size() != total_samples) {
     play_buffer_.SetSize(total_samples);
     RTC_LOG(LS_INFO) << "Size of playout buffer: " << play_buffer_.size();
   }
+  const bool allocated = play_buffer_.capacity() != old_capacity;
 
   size_t num_samples_out(0);
   // It is currently supported to start playout without a valid audio
@@ -318,7 +337,7 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t samples_per_channel) {
   }
   // Update playout stats which is used as base for periodic logging of the
   // audio output state.
-  UpdatePlayStats(max_abs, num_samples_out / play_channels_);
+  UpdatePlayStats(max_abs, num_samples_out / play_channels_, allocated);
   return static_cast<int32_t>(num_samples_out / play_channels_);
 }
 
@@ -385,12 +404,18 @@ void AudioDeviceBuffer::LogStats(LogState state) {
   last_timer_task_time_ = now_time;
 
   Stats stats;
-  {
-    rtc::CritScope cs(&lock_);
-    stats = stats_;
-    stats_.max_rec_level = 0;
-    stats_.max_play_level = 0;
-  }
+  stats.rec_callbacks = stats_.rec_callbacks.load(std::memory_order_relaxed);
+  stats.play_callbacks = stats_.play_callbacks.load(std::memory_order_relaxed);
+  stats.rec_samples = stats_.rec_samples.load(std::memory_order_relaxed);
+  stats.play_samples = stats_.play_samples.load(std::memory_order_relaxed);
+  stats.rec_allocations =
+      stats_.rec_allocations.load(std::memory_order_relaxed);
+  stats.play_allocations =
+      stats_.play_allocations.load(std::memory_order_relaxed);
+  stats.max_rec_level =
+      stats_.max_rec_level.exchange(0, std::memory_order_relaxed);
+  stats.max_play_level =
+      stats_.max_play_level.exchange(0, std::memory_order_relaxed);
 
   // Cache current sample rate from atomic members.
   const uint32_t rec_sample_rate = rec_sample_rate_;
@@ -417,7 +442,8 @@ void AudioDeviceBuffer::LogStats(LogState state) {
                     << "samples: " << diff_samples << ", "
                     << "rate: " << static_cast<int>(rate + 0.5) << ", "
                     << "rate diff: " << abs_diff_rate_in_percent << "%, "
-                    << "level: " << stats.max_rec_level;
+                    << "level: " << stats.max_rec_level << ", "
+                    << "allocations: " << stats.rec_allocations;
     }
 
     diff_samples = stats.play_samples - last_stats_.play_samples;
@@ -435,7 +461,8 @@ void AudioDeviceBuffer::LogStats(LogState state) {
                     << "samples: " << diff_samples << ", "
                     << "rate: " << static_cast<int>(rate + 0.5) << ", "
                     << "rate diff: " << abs_diff_rate_in_percent << "%, "
-                    << "level: " << stats.max_play_level;
+                    << "level: " << stats.max_play_level << ", "
+                    << "allocations: " << stats.play_allocations;
     }
   }
   last_stats_ = stats;
@@ -452,35 +479,40 @@ void AudioDeviceBuffer::LogStats(LogState state) {
 void AudioDeviceBuffer::ResetRecStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetRecStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetRecStats();
+  stats_.rec_callbacks = 0;
+  stats_.rec_samples = 0;
+  stats_.rec_allocations = 0;
+  stats_.max_rec_level = 0;
 }
 
 void AudioDeviceBuffer::ResetPlayStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetPlayStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetPlayStats();
+  stats_.play_callbacks = 0;
+  stats_.play_samples = 0;
+  stats_.play_allocations = 0;
+  stats_.max_play_level = 0;
 }
 
 void AudioDeviceBuffer::UpdateRecStats(int16_t max_abs,
-                                       size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.rec_callbacks;
-  stats_.rec_samples += samples_per_channel;
-  if (max_abs > stats_.max_rec_level) {
-    stats_.max_rec_level = max_abs;
-  }
+                                       size_t samples_per_channel,
+                                       bool allocated) {
+  stats_.rec_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.rec_samples.fetch_add(samples_per_channel, std::memory_order_relaxed);
+  if (allocated)
+    stats_.rec_allocations.fetch_add(1, std::memory_order_relaxed);
+  UpdateMaxLevel(&stats_.max_rec_level, max_abs);
 }
 
 void AudioDeviceBuffer::UpdatePlayStats(int16_t max_abs,
-                                        size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.play_callbacks;
-  stats_.play_samples += samples_per_channel;
-  if (max_abs > stats_.max_play_level) {
-    stats_.max_play_level = max_abs;
-  }
+                                        size_t samples_per_channel,
+                                        bool allocated) {
+  stats_.play_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.play_samples.fetch_add(samples_per_channel,
+                                std::memory_order_relaxed);
+  if (allocated)
+    stats_.play_allocations.fetch_add(1, std::memory_order_relaxed);
+  UpdateMaxLevel(&stats_.max_play_level, max_abs);
 }
 
 }  // namespace webrtc
@@ -19,7 +19,6 @@
 #include "api/task_queue/task_queue_factory.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "rtc_base/buffer.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
@@ -44,12 +43,14 @@ class AudioDeviceBuffer {
     void ResetRecStats() {
       rec_callbacks = 0;
       rec_samples = 0;
+      rec_allocations = 0;
       max_rec_level = 0;
     }
 
     void ResetPlayStats() {
       play_callbacks = 0;
       play_samples = 0;
+      play_allocations = 0;
       max_play_level = 0;
     }
 
@@ -67,6 +68,12 @@ class AudioDeviceBuffer {
     // Total number of played audio samples.
     uint64_t play_samples = 0;
 
+    // Number of times a recording or playout callback had to allocate memory,
+    // which should never happen on the real-time audio threads once the
+    // buffers have been preallocated.
+    uint64_t rec_allocations = 0;
+    uint64_t play_allocations = 0;
+
     // Contains max level (max(abs(x))) of recorded audio packets over the last
     // 10 seconds where a new measurement is done twice per second. The level
     // is reset to zero at each call to LogStats().
@@ -122,9 +129,14 @@ class AudioDeviceBuffer {
   void LogStats(LogState state);
 
   // Updates counters in each play/record callback. These counters are later
-  // (periodically) read by LogStats() using a lock.
-  void UpdateRecStats(int16_t max_abs, size_t samples_per_channel);
-  void UpdatePlayStats(int16_t max_abs, size_t samples_per_channel);
+  // (periodically) read by LogStats(). They are atomic, so that the real-time
+  // audio threads never have to wait for the task queue.
+  void UpdateRecStats(int16_t max_abs,
+                      size_t samples_per_channel,
+                      bool allocated);
+  void UpdatePlayStats(int16_t max_abs,
+                       size_t samples_per_channel,
+                       bool allocated);
 
   // Clears all members tracking stats for recording and playout.
   // These methods both run on the task queue.
@@ -142,7 +154,17 @@ class AudioDeviceBuffer {
   // Main thread on which this object is created.
   rtc::ThreadChecker main_thread_checker_;
 
-  rtc::CriticalSection lock_;
+  // Atomic counterpart of Stats, written by the native audio threads.
+  struct AtomicStats {
+    std::atomic<uint64_t> rec_callbacks{0};
+    std::atomic<uint64_t> play_callbacks{0};
+    std::atomic<uint64_t> rec_samples{0};
+    std::atomic<uint64_t> play_samples{0};
+    std::atomic<uint64_t> rec_allocations{0};
+    std::atomic<uint64_t> play_allocations{0};
+    std::atomic<int16_t> max_rec_level{0};
+    std::atomic<int16_t> max_play_level{0};
+  };
 
   // Task queue used to invoke LogStats() periodically. Tasks are executed on a
   // worker thread but it does not necessarily have to be the same thread for
@@ -173,11 +195,13 @@ class AudioDeviceBuffer {
 
   // Buffer used for audio samples to be played out. Size can be changed
   // dynamically. The 16-bit samples are interleaved, hence the size is
-  // proportional to the number of channels.
+  // proportional to the number of channels. Preallocated to hold
+  // kMaxBufferSizeBytes, so that it's never reallocated in the audio callbacks
+  // for 10ms buffers.
   rtc::BufferT<int16_t> play_buffer_;
 
   // Byte buffer used for recorded audio samples. Size can be changed
-  // dynamically.
+  // dynamically. Preallocated like |play_buffer_|.
   rtc::BufferT<int16_t> rec_buffer_;
 
   // Contains true of a key-press has been detected.
@@ -203,7 +227,7 @@ class AudioDeviceBuffer {
   int64_t rec_start_time_ RTC_GUARDED_BY(main_thread_checker_);
 
   // Contains counters for playout and recording statistics.
-  Stats stats_ RTC_GUARDED_BY(lock_);
+  AtomicStats stats_;
 
   // Stores current stats at each timer task. Used to calculate differences
   // between two successive timer events.
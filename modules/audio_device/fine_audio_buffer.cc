@@ -20,6 +20,8 @@
 
 namespace webrtc {
 
+constexpr size_t FineAudioBuffer::kMaxNativeBufferSizeMs;
+
 FineAudioBuffer::FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer)
     : audio_device_buffer_(audio_device_buffer),
       playout_samples_per_channel_10ms_(rtc::dchecked_cast<size_t>(
@@ -30,6 +32,13 @@ FineAudioBuffer::FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer)
       record_channels_(audio_device_buffer->RecordingChannels()) {
   RTC_DCHECK(audio_device_buffer_);
   RTC_DLOG(INFO) << __FUNCTION__;
+  // The buffers never hold more than one native buffer plus 10ms of audio.
+  playout_buffer_.EnsureCapacity(
+      playout_channels_ * playout_samples_per_channel_10ms_ *
+      (kMaxNativeBufferSizeMs + 10) / 10);
+  record_buffer_.EnsureCapacity(
+      record_channels_ * record_samples_per_channel_10ms_ *
+      (kMaxNativeBufferSizeMs + 10) / 10);
   if (IsReadyForPlayout()) {
     RTC_DLOG(INFO) << "playout_samples_per_channel_10ms: "
                    << playout_samples_per_channel_10ms_;
@@ -78,6 +87,7 @@ void FineAudioBuffer::GetPlayoutData(rtc::ArrayView<int16_t> audio_buffer,
       // into account.
       const size_t num_elements_10ms =
           playout_channels_ * playout_samples_per_channel_10ms_;
+      const size_t old_capacity = playout_buffer_.capacity();
       const size_t written_elements = playout_buffer_.AppendData(
           num_elements_10ms, [&](rtc::ArrayView<int16_t> buf) {
             const size_t samples_per_channel_10ms =
@@ -85,6 +95,8 @@ void FineAudioBuffer::GetPlayoutData(rtc::ArrayView<int16_t> audio_buffer,
             return playout_channels_ * samples_per_channel_10ms;
           });
       RTC_DCHECK_EQ(num_elements_10ms, written_elements);
+      if (playout_buffer_.capacity() != old_capacity)
+        ++num_allocations_;
     } else {
       // Provide silence if AudioDeviceBuffer::RequestPlayoutData() fails.
       // Can e.g. happen when an AudioTransport has not been registered.
@@ -110,7 +122,10 @@ void FineAudioBuffer::DeliverRecordedData(
     int record_delay_ms) {
   RTC_DCHECK(IsReadyForRecord());
   // Always append new data and grow the buffer when needed.
+  const size_t old_capacity = record_buffer_.capacity();
   record_buffer_.AppendData(audio_buffer.data(), audio_buffer.size());
+  if (record_buffer_.capacity() != old_capacity)
+    ++num_allocations_;
   // Consume samples from buffer in chunks of 10ms until there is not
   // enough data left. The number of remaining samples in the cache is given by
   // the new size of the internal |record_buffer_|.
@@ -27,8 +27,16 @@ class AudioDeviceBuffer;
 // buffers differs from 10ms.
 // As an example: calling DeliverRecordedData() with 5ms buffers will deliver
 // accumulated 10ms worth of data to the ADB every second call.
+// The internal buffers are preallocated at construction to hold native audio
+// buffers of up to kMaxNativeBufferSizeMs, hence larger buffers will cause
+// allocations on the real-time audio threads. These are counted by
+// num_allocations().
 class FineAudioBuffer {
  public:
+  // Size of the largest native audio buffer that can be handled without
+  // allocating memory in GetPlayoutData() or DeliverRecordedData().
+  static constexpr size_t kMaxNativeBufferSizeMs = 50;
+
   // |device_buffer| is a buffer that provides 10ms of audio data.
   FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer);
   ~FineAudioBuffer();
@@ -63,6 +71,11 @@ class FineAudioBuffer {
   void DeliverRecordedData(rtc::ArrayView<const int16_t> audio_buffer,
                            int record_delay_ms);
 
+  // Returns the number of times GetPlayoutData() or DeliverRecordedData() had
+  // to grow an internal buffer. Should be zero for all native buffer sizes up
+  // to kMaxNativeBufferSizeMs.
+  size_t num_allocations() const { return num_allocations_; }
+
  private:
   // Device buffer that works with 10ms chunks of data both for playout and
   // for recording. I.e., the WebRTC side will always be asked for audio to be
@@ -87,6 +100,9 @@ class FineAudioBuffer {
   rtc::BufferT<int16_t> record_buffer_;
   // Contains latest delay estimate given to GetPlayoutData().
   int playout_delay_ms_ = 0;
+  // Number of times one of the buffers above has been reallocated. Only
+  // modified on the audio threads.
+  size_t num_allocations_ = 0;
 };
 
 }  // namespace webrtc
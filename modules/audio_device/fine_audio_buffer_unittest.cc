@@ -143,6 +143,8 @@ void RunFineBufferTest(int frame_size_in_samples) {
                                       kChannels * kFrameSizeSamples),
         0);
   }
+  // All frame sizes used by the tests fit in the preallocated buffers.
+  EXPECT_EQ(0u, fine_buffer.num_allocations());
 }
 
 TEST(FineBufferTest, BufferLessThan10ms) {
@@ -155,4 +157,10 @@ TEST(FineBufferTest, GreaterThan10ms) {
   RunFineBufferTest(kFrameSizeSamples);
 }
 
+TEST(FineBufferTest, NearlyMaxNativeBufferSize) {
+  const int kFrameSizeSamples =
+      kSamplesPer10Ms * FineAudioBuffer::kMaxNativeBufferSizeMs / 10 - 50;
+  RunFineBufferTest(kFrameSizeSamples);
+}
+
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
@@ -72,6 +73,16 @@ bool ShouldMixBefore(const SourceFrame& a, const SourceFrame& b) {
   return a.energy > b.energy;
 }
 
+// A lower level in -dBov is louder. On ties, sources that are already mixed
+// are preferred, to avoid switching between them.
+bool IsLouder(const std::pair<int, AudioMixerImpl::SourceStatus*>& a,
+              const std::pair<int, AudioMixerImpl::SourceStatus*>& b) {
+  if (a.first != b.first) {
+    return a.first < b.first;
+  }
+  return a.second->is_mixed && !b.second->is_mixed;
+}
+
 void RampAndUpdateGain(
     const std::vector<SourceFrame>& mixed_sources_and_frames) {
   for (const auto& source_frame : mixed_sources_and_frames) {
@@ -136,6 +147,11 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   return;
 }
 
+void AudioMixerImpl::SetMaxSourcesSelectedByAudioLevel(size_t max_sources) {
+  rtc::CritScope lock(&crit_);
+  max_sources_selected_by_audio_level_ = max_sources;
+}
+
 void AudioMixerImpl::CalculateOutputFrequency() {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   rtc::CritScope lock(&crit_);
@@ -182,7 +198,7 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   std::vector<SourceFrame> ramp_list;
 
   // Get audio from the audio sources and put it in the SourceFrame vector.
-  for (auto& source_and_status : audio_source_list_) {
+  for (SourceStatus* source_and_status : SelectSourcesToGetAudioFrom()) {
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             OutputFrequency(), &source_and_status->audio_frame);
@@ -192,13 +208,18 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
       continue;
     }
     audio_source_mixing_data_list.emplace_back(
-        source_and_status.get(), &source_and_status->audio_frame,
+        source_and_status, &source_and_status->audio_frame,
         audio_frame_info == Source::AudioFrameInfo::kMuted);
   }
 
-  // Sort frames by sorting function.
-  std::sort(audio_source_mixing_data_list.begin(),
-            audio_source_mixing_data_list.end(), ShouldMixBefore);
+  // Sort the frames that may be mixed by sorting function. The order of the
+  // rest doesn't matter, they are not mixed.
+  const size_t num_candidates =
+      std::min(audio_source_mixing_data_list.size(),
+               static_cast<size_t>(kMaximumAmountOfMixedAudioSources));
+  std::partial_sort(audio_source_mixing_data_list.begin(),
+                    audio_source_mixing_data_list.begin() + num_candidates,
+                    audio_source_mixing_data_list.end(), ShouldMixBefore);
 
   int max_audio_frame_counter = kMaximumAmountOfMixedAudioSources;
 
@@ -224,6 +245,44 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   return result;
 }
 
+std::vector<AudioMixerImpl::SourceStatus*>
+AudioMixerImpl::SelectSourcesToGetAudioFrom() {
+  std::vector<SourceStatus*> selected_sources;
+  selected_sources.reserve(audio_source_list_.size());
+  if (max_sources_selected_by_audio_level_ == 0) {
+    for (auto& source_and_status : audio_source_list_) {
+      selected_sources.push_back(source_and_status.get());
+    }
+    return selected_sources;
+  }
+
+  std::vector<std::pair<int, SourceStatus*>> sources_by_level;
+  for (auto& source_and_status : audio_source_list_) {
+    const absl::optional<int> level =
+        source_and_status->audio_source->GetLatestReceivedAudioLevel();
+    if (level) {
+      sources_by_level.emplace_back(*level, source_and_status.get());
+    } else {
+      selected_sources.push_back(source_and_status.get());
+    }
+  }
+
+  const size_t num_loudest =
+      std::min(sources_by_level.size(), max_sources_selected_by_audio_level_);
+  std::nth_element(sources_by_level.begin(),
+                   sources_by_level.begin() + num_loudest,
+                   sources_by_level.end(), IsLouder);
+  for (size_t i = 0; i < sources_by_level.size(); ++i) {
+    // Sources that are mixed need a frame to be ramped out.
+    if (i < num_loudest || sources_by_level[i].second->is_mixed) {
+      selected_sources.push_back(sources_by_level[i].second);
+    } else {
+      sources_by_level[i].second->audio_source->SkipAudioFrame();
+    }
+  }
+  return selected_sources;
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
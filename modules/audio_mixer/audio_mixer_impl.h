@@ -65,6 +65,16 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(crit_);
 
+  // For mixers with many sources, e.g. in large conferences. When
+  // |max_sources| is non-zero, only the |max_sources| loudest sources by
+  // Source::GetLatestReceivedAudioLevel, as well as the sources that were
+  // mixed in the previous call, so that they can be ramped out, are asked for
+  // audio in Mix(). Source::SkipAudioFrame() is called on the other sources,
+  // which lets them advance without decoding. Sources that don't report an
+  // audio level are always asked for audio.
+  void SetMaxSourcesSelectedByAudioLevel(size_t max_sources)
+      RTC_LOCKS_EXCLUDED(crit_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
@@ -85,6 +95,11 @@ class AudioMixerImpl : public AudioMixer {
   // kMaximumAmountOfMixedAudioSources audio sources.
   AudioFrameList GetAudioFromSources() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the sources to ask for audio and calls SkipAudioFrame() on the
+  // others, see SetMaxSourcesSelectedByAudioLevel().
+  std::vector<SourceStatus*> SelectSourcesToGetAudioFrom()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
   // checks that mixing is done sequentially.
@@ -99,6 +114,9 @@ class AudioMixerImpl : public AudioMixer {
   // List of all audio sources. Note all lists are disjunct
   SourceStatusList audio_source_list_ RTC_GUARDED_BY(crit_);  // May be mixed.
 
+  // Zero if all sources are asked for audio.
+  size_t max_sources_selected_by_audio_level_ RTC_GUARDED_BY(crit_) = 0;
+
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
 
@@ -77,8 +77,10 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
   MOCK_METHOD2(GetAudioFrameWithInfo,
                AudioFrameInfo(int sample_rate_hz, AudioFrame* audio_frame));
 
+  MOCK_METHOD0(SkipAudioFrame, void());
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
   MOCK_CONST_METHOD0(Ssrc, int());
+  MOCK_CONST_METHOD0(GetLatestReceivedAudioLevel, absl::optional<int>());
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -473,6 +475,75 @@ TEST(AudioMixer, UnmutedShouldMixBeforeLoud) {
   MixAndCompare(frames, frame_info, expected_status);
 }
 
+TEST(AudioMixer, OnlyLoudestSourcesByAudioLevelAreAskedForAudio) {
+  constexpr int kAudioSources = 6;
+  constexpr int kMaxSelectedSources = 3;
+  const auto mixer = AudioMixerImpl::Create();
+  mixer->SetMaxSourcesSelectedByAudioLevel(kMaxSelectedSources);
+
+  // Source i has level 2 * i, the last one doesn't report a level.
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    if (i < kAudioSources - 1) {
+      ON_CALL(participants[i], GetLatestReceivedAudioLevel())
+          .WillByDefault(Return(absl::optional<int>(2 * i)));
+    }
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    const bool selected = i < kMaxSelectedSources || i == kAudioSources - 1;
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _))
+        .Times(Exactly(selected ? 1 : 0));
+    EXPECT_CALL(participants[i], SkipAudioFrame())
+        .Times(Exactly(selected ? 0 : 1));
+  }
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (int i = kMaxSelectedSources; i < kAudioSources - 1; ++i) {
+    EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+        << "Mixed status of AudioSource #" << i << " wrong.";
+  }
+}
+
+TEST(AudioMixer, SourcesSelectedByAudioLevelAreAskedForAudioUntilRampedOut) {
+  constexpr int kAudioSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 1;
+  const auto mixer = AudioMixerImpl::Create();
+  mixer->SetMaxSourcesSelectedByAudioLevel(
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources);
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    ON_CALL(participants[i], GetLatestReceivedAudioLevel())
+        .WillByDefault(Return(absl::optional<int>(i)));
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[0]));
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(
+      &participants[kAudioSources - 1]));
+
+  // The first source goes silent. It is still asked for audio once, since it
+  // was mixed, and is then ramped out.
+  ON_CALL(participants[0], GetLatestReceivedAudioLevel())
+      .WillByDefault(Return(absl::optional<int>(127)));
+  participants[0].fake_frame()->vad_activity_ = AudioFrame::kVadPassive;
+  EXPECT_CALL(participants[0], GetAudioFrameWithInfo(_, _)).Times(Exactly(1));
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[0]));
+  EXPECT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(
+      &participants[kAudioSources - 1]));
+
+  ::testing::Mock::VerifyAndClearExpectations(&participants[0]);
+  EXPECT_CALL(participants[0], GetAudioFrameWithInfo(_, _)).Times(Exactly(0));
+  EXPECT_CALL(participants[0], SkipAudioFrame()).Times(Exactly(1));
+  mixer->Mix(1, &frame_for_mixing);
+}
+
 TEST(AudioMixer, MixingRateShouldBeDecidedByRateCalculator) {
   constexpr int kOutputRate = 22000;
   const auto mixer =
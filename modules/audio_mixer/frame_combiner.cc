@@ -80,21 +80,35 @@ void MixToFloatFrame(const std::vector<AudioFrame*>& mix_list,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  const size_t num_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t num_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+
+  // Clear the part of the mixing buffer that is used.
+  for (size_t j = 0; j < num_channels; ++j) {
+    std::fill((*mixing_buffer)[j].begin(),
+              (*mixing_buffer)[j].begin() + num_samples, 0.f);
   }
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame->data()[number_of_channels * k + j];
+  // Convert to FloatS16 and mix. The frame data and the loop bounds are
+  // fetched outside of the per-sample loops, which lets the compiler vectorize
+  // them. Mono frames are added contiguously, other frames one channel at a
+  // time with a fixed stride.
+  for (const AudioFrame* const frame : mix_list) {
+    const int16_t* const frame_data = frame->data();
+    if (number_of_channels == 1) {
+      float* const channel = (*mixing_buffer)[0].data();
+      for (size_t k = 0; k < num_samples; ++k) {
+        channel[k] += frame_data[k];
+      }
+      continue;
+    }
+    for (size_t j = 0; j < num_channels; ++j) {
+      float* const channel = (*mixing_buffer)[j].data();
+      const int16_t* const frame_channel = frame_data + j;
+      for (size_t k = 0; k < num_samples; ++k) {
+        channel[k] += frame_channel[number_of_channels * k];
       }
     }
   }
@@ -114,10 +128,11 @@ void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
   // Put data in the result frame.
+  int16_t* const frame_data = audio_frame_for_mixing->mutable_data();
   for (size_t i = 0; i < number_of_channels; ++i) {
+    const rtc::ArrayView<const float> channel = mixing_buffer_view.channel(i);
     for (size_t j = 0; j < samples_per_channel; ++j) {
-      audio_frame_for_mixing->mutable_data()[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
+      frame_data[number_of_channels * j + i] = FloatS16ToS16(channel[j]);
     }
   }
 }
@@ -216,6 +216,35 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+TEST(FrameCombiner, CombiningTwoFramesShouldAddThem) {
+  FrameCombiner combiner(false);
+  for (const int rate : {8000, 10000, 11000, 32000, 44100}) {
+    for (const int number_of_channels : {1, 2, 4, 8}) {
+      SCOPED_TRACE(ProduceDebugText(rate, number_of_channels, 2));
+
+      SetUpFrames(rate, number_of_channels);
+      const size_t num_samples = number_of_channels * rate / 100;
+      int16_t* frame1_data = frame1.mutable_data();
+      std::iota(frame1_data, frame1_data + num_samples, 0);
+      int16_t* frame2_data = frame2.mutable_data();
+      std::fill(frame2_data, frame2_data + num_samples, 1000);
+      const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+      combiner.Combine(frames_to_combine, number_of_channels, rate,
+                       frames_to_combine.size(), &audio_frame_for_mixing);
+
+      const int16_t* audio_frame_for_mixing_data =
+          audio_frame_for_mixing.data();
+      const std::vector<int16_t> mixed_data(
+          audio_frame_for_mixing_data,
+          audio_frame_for_mixing_data + num_samples);
+
+      std::vector<int16_t> expected(num_samples);
+      std::iota(expected.begin(), expected.end(), 1000);
+      EXPECT_EQ(mixed_data, expected);
+    }
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
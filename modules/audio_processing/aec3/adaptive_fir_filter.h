@@ -43,6 +43,12 @@ void ComputeFrequencyResponse_Sse2(
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
+#if defined(WEBRTC_HAS_AVX2)
+void ComputeFrequencyResponse_Avx2(
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+#endif
 
 // Adapts the filter partitions.
 void AdaptPartitions(const RenderBuffer& render_buffer,
@@ -61,6 +67,12 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
                           size_t num_partitions,
                           std::vector<std::vector<FftData>>* H);
 #endif
+#if defined(WEBRTC_HAS_AVX2)
+void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t num_partitions,
+                          std::vector<std::vector<FftData>>* H);
+#endif
 
 // Produces the filter output.
 void ApplyFilter(const RenderBuffer& render_buffer,
@@ -79,6 +91,12 @@ void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
                       const std::vector<std::vector<FftData>>& H,
                       FftData* S);
 #endif
+#if defined(WEBRTC_HAS_AVX2)
+void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
+                      size_t num_partitions,
+                      const std::vector<std::vector<FftData>>& H,
+                      FftData* S);
+#endif
 
 }  // namespace aec3
 
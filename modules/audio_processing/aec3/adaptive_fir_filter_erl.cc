@@ -81,6 +81,11 @@ void ComputeErl(const Aec3Optimization& optimization,
   RTC_DCHECK_EQ(kFftLengthBy2Plus1, erl.size());
   // Update the frequency response and echo return loss for the filter.
   switch (optimization) {
+#if defined(WEBRTC_HAS_AVX2)
+    case Aec3Optimization::kAvx2:
+      aec3::ErlComputer_AVX2(H2, erl);
+      break;
+#endif
 #if defined(WEBRTC_ARCH_X86_FAMILY)
     case Aec3Optimization::kSse2:
       aec3::ErlComputer_SSE2(H2, erl);
@@ -276,6 +276,129 @@ TEST(AdaptiveFirFilter, ComputeFrequencyResponseSse2Optimization) {
 
 #endif
 
+#if defined(WEBRTC_HAS_AVX2)
+// Verifies that the AVX2 methods for filter adaptation match their reference
+// counterparts, up to the rounding differences of the fused multiply-adds.
+TEST(AdaptiveFirFilter, FilterAdaptationAvx2Optimizations) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  // The fused multiply-adds round differently from the reference code, so the
+  // outputs are compared relative to their largest magnitude.
+  auto expect_near = [](const FftData& a, const FftData& b) {
+    float max_abs = 1.f;
+    for (size_t j = 0; j < a.re.size(); ++j) {
+      max_abs = std::max({max_abs, fabsf(a.re[j]), fabsf(a.im[j])});
+    }
+    for (size_t j = 0; j < a.re.size(); ++j) {
+      EXPECT_NEAR(a.re[j], b.re[j], 1e-5f * max_abs);
+      EXPECT_NEAR(a.im[j], b.im[j], 1e-5f * max_abs);
+    }
+  };
+
+  bool use_avx2 = (WebRtc_GetCPUInfo(kAVX2) != 0);
+  if (use_avx2) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      for (size_t num_render_channels : {1, 2, 4, 8}) {
+        std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+            RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
+                                      num_render_channels));
+        Random random_generator(42U);
+        std::vector<std::vector<std::vector<float>>> x(
+            kNumBands,
+            std::vector<std::vector<float>>(
+                num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+        FftData S_C;
+        FftData S_Avx2;
+        FftData G;
+        Aec3Fft fft;
+        std::vector<std::vector<FftData>> H_C(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        std::vector<std::vector<FftData>> H_Avx2(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t ch = 0; ch < num_render_channels; ++ch) {
+            H_C[p][ch].Clear();
+            H_Avx2[p][ch].Clear();
+          }
+        }
+
+        for (size_t k = 0; k < 500; ++k) {
+          for (size_t band = 0; band < x.size(); ++band) {
+            for (size_t ch = 0; ch < x[band].size(); ++ch) {
+              RandomizeSampleVector(&random_generator, x[band][ch]);
+            }
+          }
+          render_delay_buffer->Insert(x);
+          if (k == 0) {
+            render_delay_buffer->Reset();
+          }
+          render_delay_buffer->PrepareCaptureProcessing();
+          auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+          ApplyFilter_Avx2(*render_buffer, num_partitions, H_Avx2, &S_Avx2);
+          ApplyFilter(*render_buffer, num_partitions, H_C, &S_C);
+          expect_near(S_C, S_Avx2);
+
+          std::for_each(G.re.begin(), G.re.end(),
+                        [&](float& a) { a = random_generator.Rand<float>(); });
+          std::for_each(G.im.begin(), G.im.end(),
+                        [&](float& a) { a = random_generator.Rand<float>(); });
+
+          AdaptPartitions_Avx2(*render_buffer, G, num_partitions, &H_Avx2);
+          AdaptPartitions(*render_buffer, G, num_partitions, &H_C);
+
+          for (size_t p = 0; p < num_partitions; ++p) {
+            for (size_t ch = 0; ch < num_render_channels; ++ch) {
+              expect_near(H_C[p][ch], H_Avx2[p][ch]);
+            }
+          }
+
+          // Continue from the same filter, so that the rounding differences
+          // don't accumulate.
+          H_Avx2 = H_C;
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the AVX2 method for frequency response computation matches the
+// reference counterpart.
+TEST(AdaptiveFirFilter, ComputeFrequencyResponseAvx2Optimization) {
+  bool use_avx2 = (WebRtc_GetCPUInfo(kAVX2) != 0);
+  if (use_avx2) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      for (size_t num_render_channels : {1, 2, 4, 8}) {
+        std::vector<std::vector<FftData>> H(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
+        std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Avx2(
+            num_partitions);
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t ch = 0; ch < num_render_channels; ++ch) {
+            for (size_t k = 0; k < H[p][ch].re.size(); ++k) {
+              H[p][ch].re[k] = k + p / 3.f + ch;
+              H[p][ch].im[k] = p + k / 7.f - ch;
+            }
+          }
+        }
+
+        ComputeFrequencyResponse(num_partitions, H, &H2);
+        ComputeFrequencyResponse_Avx2(num_partitions, H, &H2_Avx2);
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t k = 0; k < H2[p].size(); ++k) {
+            EXPECT_FLOAT_EQ(H2[p][k], H2_Avx2[p][k]);
+          }
+        }
+      }
+    }
+  }
+}
+
+#endif
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 // Verifies that the check for non-null data dumper works.
 TEST(AdaptiveFirFilter, NullDataDumper) {
@@ -19,6 +19,12 @@
 namespace webrtc {
 
 Aec3Optimization DetectOptimization() {
+#if defined(WEBRTC_HAS_AVX2)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return Aec3Optimization::kAvx2;
+  }
+#endif
+
 #if defined(WEBRTC_ARCH_X86_FAMILY)
   if (WebRtc_GetCPUInfo(kSSE2) != 0) {
     return Aec3Optimization::kSse2;
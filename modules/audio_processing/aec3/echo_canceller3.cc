@@ -13,6 +13,8 @@
 #include <utility>
 
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/subtractor.h"
 #include "modules/audio_processing/high_pass_filter.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/atomic_ops.h"
@@ -383,6 +385,58 @@ bool EchoCanceller3::ActiveProcessing() const {
   return true;
 }
 
+size_t EchoCanceller3::EstimateChannelStateSizeBytes(
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_render_channels,
+    size_t num_capture_channels) {
+  // The render delay buffer stores the blocks, spectra and FFTs of all render
+  // channels, shared by all capture channels.
+  const size_t num_buffered_blocks =
+      GetRenderDelayBufferSize(config.delay.down_sampling_factor,
+                               config.delay.num_filters,
+                               config.filter.main.length_blocks);
+  const size_t render_bytes =
+      num_buffered_blocks * num_render_channels *
+      (NumBandsForRate(sample_rate_hz) * kBlockSize * sizeof(float) +
+       kFftLengthBy2Plus1 * sizeof(float) + sizeof(FftData));
+  return render_bytes +
+         Subtractor::FilterStateSizeBytes(config, num_render_channels,
+                                          num_capture_channels);
+}
+
+size_t EchoCanceller3::EstimateMemoryFootprintBytes(
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_render_channels,
+    size_t num_capture_channels) {
+  // The delay estimator keeps a downsampled render history and one matched
+  // filter per delay range, independently of the channel counts.
+  const size_t sub_block_size =
+      kBlockSize / config.delay.down_sampling_factor;
+  const size_t delay_estimator_bytes =
+      (GetDownSampledBufferSize(config.delay.down_sampling_factor,
+                                config.delay.num_filters) +
+       config.delay.num_filters * kMatchedFilterWindowSizeSubBlocks *
+           sub_block_size) *
+      sizeof(float);
+  return delay_estimator_bytes +
+         EstimateChannelStateSizeBytes(config, sample_rate_hz,
+                                       num_render_channels,
+                                       num_capture_channels);
+}
+
+EchoCanceller3Config EchoCanceller3::CreateLowMemoryConfig() {
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = 8;
+  config.delay.num_filters = 3;
+  config.filter.main.length_blocks = 10;
+  config.filter.shadow.length_blocks = 10;
+  config.filter.main_initial.length_blocks = 8;
+  config.filter.shadow_initial.length_blocks = 8;
+  return config;
+}
+
 void EchoCanceller3::EmptyRenderQueue() {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
   bool frame_to_buffer =
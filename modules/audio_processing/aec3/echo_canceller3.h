@@ -113,6 +113,28 @@ class EchoCanceller3 : public EchoControl {
 
   bool ActiveProcessing() const override;
 
+  // Returns an estimate of the number of bytes used by the state that scales
+  // with the channel counts: the render buffers and the linear filters.
+  static size_t EstimateChannelStateSizeBytes(
+      const EchoCanceller3Config& config,
+      int sample_rate_hz,
+      size_t num_render_channels,
+      size_t num_capture_channels);
+
+  // Returns an estimate of the number of bytes used by an instance: the
+  // channel dependent state above and the render delay estimator.
+  static size_t EstimateMemoryFootprintBytes(const EchoCanceller3Config& config,
+                                             int sample_rate_hz,
+                                             size_t num_render_channels,
+                                             size_t num_capture_channels);
+
+  // Returns a configuration for devices that are short of memory and cache.
+  // It uses shorter linear filters, searches for delays up to about 320 ms
+  // instead of about 500 ms and estimates the delay at a lower rate. That
+  // takes about a third off the footprint, at the cost of some echo removal in
+  // reverberant rooms and of robustness to large delays.
+  static EchoCanceller3Config CreateLowMemoryConfig();
+
   // Signals whether an external detector has detected echo leakage from the
   // echo canceller.
   // Note that in the case echo leakage has been flagged, it should be unflagged
@@ -643,6 +643,22 @@ TEST(EchoCanceller3Buffering, RenderSwapQueueOverrunReturnValue) {
   }
 }
 
+TEST(EchoCanceller3, LowMemoryConfig) {
+  EchoCanceller3Config config = EchoCanceller3::CreateLowMemoryConfig();
+  EXPECT_TRUE(EchoCanceller3Config::Validate(&config));
+  for (auto rate : {16000, 32000, 48000}) {
+    SCOPED_TRACE(ProduceDebugText(rate));
+    const size_t default_size = EchoCanceller3::EstimateMemoryFootprintBytes(
+        EchoCanceller3Config(), rate, 1, 1);
+    const size_t low_memory_size =
+        EchoCanceller3::EstimateMemoryFootprintBytes(config, rate, 1, 1);
+    EXPECT_LT(low_memory_size, default_size * 3 / 4);
+    EXPECT_LT(EchoCanceller3::EstimateChannelStateSizeBytes(config, rate, 1, 1),
+              low_memory_size);
+  }
+  EchoCanceller3 aec3(config, 48000, 1, 1);
+}
+
 TEST(EchoCanceller3Messaging, CaptureSaturation) {
   auto variants = {EchoCanceller3Tester::SaturationTestVariant::kNone,
                    EchoCanceller3Tester::SaturationTestVariant::kOneNegative,
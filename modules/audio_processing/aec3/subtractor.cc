@@ -54,6 +54,13 @@ void ScaleFilterOutput(rtc::ArrayView<const float> y,
   }
 }
 
+size_t NumFilters(const EchoCanceller3Config& config,
+                  size_t num_capture_channels) {
+  return config.filter.share_filters_across_capture_channels
+             ? 1
+             : num_capture_channels;
+}
+
 }  // namespace
 
 Subtractor::Subtractor(const EchoCanceller3Config& config,
@@ -66,12 +73,13 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
       optimization_(optimization),
       config_(config),
       num_capture_channels_(num_capture_channels),
-      main_filter_(num_capture_channels_),
-      shadow_filter_(num_capture_channels_),
-      G_main_(num_capture_channels_),
-      G_shadow_(num_capture_channels_),
-      filter_misadjustment_estimator_(num_capture_channels_),
-      poor_shadow_filter_counter_(num_capture_channels_, 0),
+      num_filters_(NumFilters(config, num_capture_channels)),
+      main_filter_(num_filters_),
+      shadow_filter_(num_filters_),
+      G_main_(num_filters_),
+      G_shadow_(num_filters_),
+      filter_misadjustment_estimator_(num_filters_),
+      poor_shadow_filter_counter_(num_filters_, 0),
       main_frequency_response_(
           num_capture_channels_,
           std::vector<std::array<float, kFftLengthBy2Plus1>>(
@@ -84,7 +92,7 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                                  config_.filter.main_initial.length_blocks,
                                  config_.filter.main.length_blocks)),
                              0.f)) {
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  for (size_t ch = 0; ch < num_filters_; ++ch) {
     main_filter_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.main.length_blocks,
         config_.filter.main_initial.length_blocks,
@@ -114,10 +122,29 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
 
 Subtractor::~Subtractor() = default;
 
+size_t Subtractor::FilterStateSizeBytes(const EchoCanceller3Config& config,
+                                        size_t num_render_channels,
+                                        size_t num_capture_channels) {
+  const size_t main_length_blocks =
+      std::max(config.filter.main_initial.length_blocks,
+               config.filter.main.length_blocks);
+  const size_t shadow_length_blocks =
+      std::max(config.filter.shadow_initial.length_blocks,
+               config.filter.shadow.length_blocks);
+  const size_t filters_bytes = NumFilters(config, num_capture_channels) *
+                               (main_length_blocks + shadow_length_blocks) *
+                               num_render_channels * sizeof(FftData);
+  const size_t responses_bytes =
+      num_capture_channels *
+      (main_length_blocks * sizeof(std::array<float, kFftLengthBy2Plus1>) +
+       GetTimeDomainLength(main_length_blocks) * sizeof(float));
+  return filters_bytes + responses_bytes;
+}
+
 void Subtractor::HandleEchoPathChange(
     const EchoPathVariability& echo_path_variability) {
   const auto full_reset = [&]() {
-    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    for (size_t ch = 0; ch < num_filters_; ++ch) {
       main_filter_[ch]->HandleEchoPathChange();
       shadow_filter_[ch]->HandleEchoPathChange();
       G_main_[ch]->HandleEchoPathChange(echo_path_variability);
@@ -137,14 +164,14 @@ void Subtractor::HandleEchoPathChange(
   }
 
   if (echo_path_variability.gain_change) {
-    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    for (size_t ch = 0; ch < num_filters_; ++ch) {
       G_main_[ch]->HandleEchoPathChange(echo_path_variability);
     }
   }
 }
 
 void Subtractor::ExitInitialState() {
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  for (size_t ch = 0; ch < num_filters_; ++ch) {
     G_main_[ch]->SetConfig(config_.filter.main, false);
     G_shadow_[ch]->SetConfig(config_.filter.shadow, false);
     main_filter_[ch]->SetSizePartitions(config_.filter.main.length_blocks,
@@ -180,7 +207,11 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_shadow);
   }
 
-  // Process all capture channels
+  // Process all capture channels. With shared filters, both filters are only
+  // run on the first channel and only adapted based on its outputs.
+  FftData S_main;
+  FftData S_shadow;
+  float main_filter_scale = 1.f;
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
     SubtractorOutput& output = outputs[ch];
@@ -189,32 +220,36 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     FftData E_shadow;
     std::array<float, kBlockSize>& e_main = output.e_main;
     std::array<float, kBlockSize>& e_shadow = output.e_shadow;
-
-    FftData S;
-    FftData& G = S;
+    const bool adapt_filters = ch < num_filters_;
 
     // Form the outputs of the main and shadow filters.
-    main_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_main, &output.s_main);
-
-    shadow_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_shadow, &output.s_shadow);
+    if (adapt_filters) {
+      main_filter_[ch]->Filter(render_buffer, &S_main);
+      shadow_filter_[ch]->Filter(render_buffer, &S_shadow);
+    }
+    PredictionError(fft_, S_main, y, &e_main, &output.s_main);
+    PredictionError(fft_, S_shadow, y, &e_shadow, &output.s_shadow);
 
     // Compute the signal powers in the subtractor output.
     output.ComputeMetrics(y);
 
     // Adjust the filter if needed.
     bool main_filter_adjusted = false;
-    filter_misadjustment_estimator_[ch].Update(output);
-    if (filter_misadjustment_estimator_[ch].IsAdjustmentNeeded()) {
-      float scale = filter_misadjustment_estimator_[ch].GetMisadjustment();
-      main_filter_[ch]->ScaleFilter(scale);
-      for (auto& h_k : main_impulse_response_[ch]) {
-        h_k *= scale;
+    if (adapt_filters) {
+      filter_misadjustment_estimator_[ch].Update(output);
+      if (filter_misadjustment_estimator_[ch].IsAdjustmentNeeded()) {
+        main_filter_scale =
+            filter_misadjustment_estimator_[ch].GetMisadjustment();
+        main_filter_[ch]->ScaleFilter(main_filter_scale);
+        for (auto& h_k : main_impulse_response_[ch]) {
+          h_k *= main_filter_scale;
+        }
+        filter_misadjustment_estimator_[ch].Reset();
+        main_filter_adjusted = true;
       }
-      ScaleFilterOutput(y, scale, e_main, output.s_main);
-      filter_misadjustment_estimator_[ch].Reset();
-      main_filter_adjusted = true;
+    }
+    if (main_filter_adjusted || (!adapt_filters && main_filter_scale != 1.f)) {
+      ScaleFilterOutput(y, main_filter_scale, e_main, output.s_main);
     }
 
     // Compute the FFts of the main and shadow filter outputs.
@@ -225,6 +260,17 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     E_shadow.Spectrum(optimization_, output.E2_shadow);
     E_main.Spectrum(optimization_, output.E2_main);
 
+    if (!adapt_filters) {
+      std::for_each(e_main.begin(), e_main.end(), [](float& a) {
+        a = rtc::SafeClamp(a, -32768.f, 32767.f);
+      });
+      main_frequency_response_[ch] = main_frequency_response_[0];
+      main_impulse_response_[ch] = main_impulse_response_[0];
+      continue;
+    }
+
+    FftData G;
+
     // Update the main filter.
     if (!main_filter_adjusted) {
       std::array<float, kFftLengthBy2Plus1> erl;
@@ -55,6 +55,13 @@ class Subtractor {
 
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
+  // Returns the number of bytes used by the adaptive filters and the filter
+  // responses for the given configuration. The per-filter state of the
+  // adaptation gains is not included.
+  static size_t FilterStateSizeBytes(const EchoCanceller3Config& config,
+                                     size_t num_render_channels,
+                                     size_t num_capture_channels);
+
   // Exits the initial state.
   void ExitInitialState();
 
@@ -119,6 +126,8 @@ class Subtractor {
   const Aec3Optimization optimization_;
   const EchoCanceller3Config config_;
   const size_t num_capture_channels_;
+  // Either one filter pair per capture channel or a single shared one.
+  const size_t num_filters_;
 
   std::vector<std::unique_ptr<AdaptiveFirFilter>> main_filter_;
   std::vector<std::unique_ptr<AdaptiveFirFilter>> shadow_filter_;
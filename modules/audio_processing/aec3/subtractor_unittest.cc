@@ -34,6 +34,7 @@ std::vector<float> RunSubtractorTest(
     int main_filter_length_blocks,
     int shadow_filter_length_blocks,
     bool uncorrelated_inputs,
+    bool share_filters,
     const std::vector<int>& blocks_with_echo_path_changes) {
   ApmDataDumper data_dumper(42);
   constexpr int kSampleRateHz = 48000;
@@ -41,6 +42,7 @@ std::vector<float> RunSubtractorTest(
   EchoCanceller3Config config;
   config.filter.main.length_blocks = main_filter_length_blocks;
   config.filter.shadow.length_blocks = shadow_filter_length_blocks;
+  config.filter.share_filters_across_capture_channels = share_filters;
 
   Subtractor subtractor(config, num_render_channels, num_capture_channels,
                         &data_dumper, DetectOptimization());
@@ -222,7 +224,7 @@ TEST(Subtractor, Convergence) {
       SCOPED_TRACE(ProduceDebugText(1, 1, delay_samples, filter_length_blocks));
       std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
           1, 1, 2500, delay_samples, filter_length_blocks, filter_length_blocks,
-          false, blocks_with_echo_path_changes);
+          false, false, blocks_with_echo_path_changes);
 
       for (float echo_to_nearend_power : echo_to_nearend_powers) {
         EXPECT_GT(0.1f, echo_to_nearend_power);
@@ -241,7 +243,7 @@ TEST(Subtractor, ConvergenceMultiChannel) {
       size_t num_blocks_to_process = 2500 * num_render_channels;
       std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
           num_render_channels, num_capture_channels, num_blocks_to_process, 64,
-          20, 20, false, blocks_with_echo_path_changes);
+          20, 20, false, false, blocks_with_echo_path_changes);
 
       for (float echo_to_nearend_power : echo_to_nearend_powers) {
         EXPECT_GT(0.1f, echo_to_nearend_power);
@@ -250,12 +252,48 @@ TEST(Subtractor, ConvergenceMultiChannel) {
   }
 }
 
+// Verifies that filters shared by all capture channels converge when the
+// capture channels are correlated.
+TEST(Subtractor, ConvergenceWithSharedFilters) {
+  std::vector<int> blocks_with_echo_path_changes;
+  for (size_t num_render_channels : {1, 2}) {
+    for (size_t num_capture_channels : {2, 4}) {
+      SCOPED_TRACE(
+          ProduceDebugText(num_render_channels, num_capture_channels, 64, 20));
+      size_t num_blocks_to_process = 2500 * num_render_channels;
+      std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
+          num_render_channels, num_capture_channels, num_blocks_to_process, 64,
+          20, 20, false, true, blocks_with_echo_path_changes);
+
+      for (float echo_to_nearend_power : echo_to_nearend_powers) {
+        EXPECT_GT(0.1f, echo_to_nearend_power);
+      }
+    }
+  }
+}
+
+// Verifies that sharing the filters only leaves the filter responses to scale
+// with the number of capture channels.
+TEST(Subtractor, FilterStateSizeWithSharedFilters) {
+  EchoCanceller3Config config;
+  const size_t one_channel_size =
+      Subtractor::FilterStateSizeBytes(config, 2, 1);
+  EXPECT_EQ(4 * one_channel_size,
+            Subtractor::FilterStateSizeBytes(config, 2, 4));
+
+  config.filter.share_filters_across_capture_channels = true;
+  EXPECT_EQ(one_channel_size, Subtractor::FilterStateSizeBytes(config, 2, 1));
+  const size_t shared_size = Subtractor::FilterStateSizeBytes(config, 2, 4);
+  EXPECT_LT(one_channel_size, shared_size);
+  EXPECT_GT(2 * one_channel_size, shared_size);
+}
+
 // Verifies that the subtractor is able to handle the case when the main filter
 // is longer than the shadow filter.
 TEST(Subtractor, MainFilterLongerThanShadowFilter) {
   std::vector<int> blocks_with_echo_path_changes;
   std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
-      1, 1, 400, 64, 20, 15, false, blocks_with_echo_path_changes);
+      1, 1, 400, 64, 20, 15, false, false, blocks_with_echo_path_changes);
   for (float echo_to_nearend_power : echo_to_nearend_powers) {
     EXPECT_GT(0.5f, echo_to_nearend_power);
   }
@@ -266,7 +304,7 @@ TEST(Subtractor, MainFilterLongerThanShadowFilter) {
 TEST(Subtractor, ShadowFilterLongerThanMainFilter) {
   std::vector<int> blocks_with_echo_path_changes;
   std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
-      1, 1, 400, 64, 15, 20, false, blocks_with_echo_path_changes);
+      1, 1, 400, 64, 15, 20, false, false, blocks_with_echo_path_changes);
   for (float echo_to_nearend_power : echo_to_nearend_powers) {
     EXPECT_GT(0.5f, echo_to_nearend_power);
   }
@@ -281,7 +319,7 @@ TEST(Subtractor, NonConvergenceOnUncorrelatedSignals) {
 
       std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
           1, 1, 3000, delay_samples, filter_length_blocks, filter_length_blocks,
-          true, blocks_with_echo_path_changes);
+          true, false, blocks_with_echo_path_changes);
       for (float echo_to_nearend_power : echo_to_nearend_powers) {
         EXPECT_NEAR(1.f, echo_to_nearend_power, 0.1);
       }
@@ -299,7 +337,7 @@ TEST(Subtractor, NonConvergenceOnUncorrelatedSignalsMultiChannel) {
       size_t num_blocks_to_process = 5000 * num_render_channels;
       std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
           num_render_channels, num_capture_channels, num_blocks_to_process, 64,
-          20, 20, true, blocks_with_echo_path_changes);
+          20, 20, true, false, blocks_with_echo_path_changes);
       for (float echo_to_nearend_power : echo_to_nearend_powers) {
         EXPECT_LT(.8f, echo_to_nearend_power);
         EXPECT_NEAR(1.f, echo_to_nearend_power, 0.25f);
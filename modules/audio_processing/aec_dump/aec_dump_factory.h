@@ -26,6 +26,18 @@ namespace webrtc {
 
 class RTC_EXPORT AecDumpFactory {
  public:
+  struct Options {
+    // -1 means the log size will be unlimited. The limit applies to the
+    // uncompressed size.
+    int64_t max_log_size_bytes = -1;
+    // Compresses the file with gzip. It must be decompressed, e.g. with
+    // gunzip, before it can be read by the aec dump tools.
+    bool compress = false;
+    // Logs only every |frame_subsampling_factor|-th capture and render frame.
+    // The init, config and runtime setting messages are always logged.
+    int frame_subsampling_factor = 1;
+  };
+
   // The |worker_queue| may not be null and must outlive the created
   // AecDump instance. |max_log_size_bytes == -1| means the log size
   // will be unlimited. |handle| may not be null. The AecDump takes
@@ -41,6 +53,9 @@ class RTC_EXPORT AecDumpFactory {
   static std::unique_ptr<AecDump> Create(FILE* handle,
                                          int64_t max_log_size_bytes,
                                          rtc::TaskQueue* worker_queue);
+  static std::unique_ptr<AecDump> Create(webrtc::FileWrapper file,
+                                         const Options& options,
+                                         rtc::TaskQueue* worker_queue);
 };
 
 }  // namespace webrtc
@@ -56,12 +56,16 @@ void CopyFromConfigToEvent(const webrtc::InternalAPMConfig& config,
 }  // namespace
 
 AecDumpImpl::AecDumpImpl(FileWrapper debug_file,
-                         int64_t max_log_size_bytes,
+                         const AecDumpFactory::Options& options,
                          rtc::TaskQueue* worker_queue)
-    : debug_file_(std::move(debug_file)),
-      num_bytes_left_for_log_(max_log_size_bytes),
+    : writer_(std::move(debug_file),
+              options.max_log_size_bytes,
+              options.compress),
       worker_queue_(worker_queue),
-      capture_stream_info_(CreateWriteToFileTask()) {}
+      capture_stream_info_(CreateWriteToFileTask()),
+      frame_subsampling_factor_(options.frame_subsampling_factor) {
+  RTC_DCHECK_GT(frame_subsampling_factor_, 0);
+}
 
 AecDumpImpl::~AecDumpImpl() {
   // Block until all tasks have finished running.
@@ -101,34 +105,53 @@ void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
 
 void AecDumpImpl::AddCaptureStreamInput(
     const AudioFrameView<const float>& src) {
-  capture_stream_info_.AddInput(src);
+  if (capture_frame_counter_ == 0)
+    capture_stream_info_.AddInput(src);
 }
 
 void AecDumpImpl::AddCaptureStreamOutput(
     const AudioFrameView<const float>& src) {
-  capture_stream_info_.AddOutput(src);
+  if (capture_frame_counter_ == 0)
+    capture_stream_info_.AddOutput(src);
 }
 
 void AecDumpImpl::AddCaptureStreamInput(const AudioFrame& frame) {
-  capture_stream_info_.AddInput(frame);
+  if (capture_frame_counter_ == 0)
+    capture_stream_info_.AddInput(frame);
 }
 
 void AecDumpImpl::AddCaptureStreamOutput(const AudioFrame& frame) {
-  capture_stream_info_.AddOutput(frame);
+  if (capture_frame_counter_ == 0)
+    capture_stream_info_.AddOutput(frame);
 }
 
 void AecDumpImpl::AddAudioProcessingState(const AudioProcessingState& state) {
-  capture_stream_info_.AddAudioProcessingState(state);
+  if (capture_frame_counter_ == 0)
+    capture_stream_info_.AddAudioProcessingState(state);
 }
 
 void AecDumpImpl::WriteCaptureStreamMessage() {
+  const bool skip_frame = capture_frame_counter_ != 0;
+  capture_frame_counter_ =
+      (capture_frame_counter_ + 1) % frame_subsampling_factor_;
+  if (skip_frame)
+    return;
   auto task = capture_stream_info_.GetTask();
   RTC_DCHECK(task);
   worker_queue_->PostTask(std::move(task));
   capture_stream_info_.SetTask(CreateWriteToFileTask());
 }
 
+bool AecDumpImpl::SkipRenderFrame() {
+  const bool skip_frame = render_frame_counter_ != 0;
+  render_frame_counter_ =
+      (render_frame_counter_ + 1) % frame_subsampling_factor_;
+  return skip_frame;
+}
+
 void AecDumpImpl::WriteRenderStreamMessage(const AudioFrame& frame) {
+  if (SkipRenderFrame())
+    return;
   auto task = CreateWriteToFileTask();
   auto* event = task->GetEvent();
 
@@ -143,6 +166,8 @@ void AecDumpImpl::WriteRenderStreamMessage(const AudioFrame& frame) {
 
 void AecDumpImpl::WriteRenderStreamMessage(
     const AudioFrameView<const float>& src) {
+  if (SkipRenderFrame())
+    return;
   auto task = CreateWriteToFileTask();
   auto* event = task->GetEvent();
 
@@ -212,19 +237,15 @@ void AecDumpImpl::WriteRuntimeSetting(
 }
 
 std::unique_ptr<WriteToFileTask> AecDumpImpl::CreateWriteToFileTask() {
-  return std::make_unique<WriteToFileTask>(&debug_file_,
-                                           &num_bytes_left_for_log_);
+  return std::make_unique<WriteToFileTask>(&writer_);
 }
 
 std::unique_ptr<AecDump> AecDumpFactory::Create(webrtc::FileWrapper file,
                                                 int64_t max_log_size_bytes,
                                                 rtc::TaskQueue* worker_queue) {
-  RTC_DCHECK(worker_queue);
-  if (!file.is_open())
-    return nullptr;
-
-  return std::make_unique<AecDumpImpl>(std::move(file), max_log_size_bytes,
-                                       worker_queue);
+  Options options;
+  options.max_log_size_bytes = max_log_size_bytes;
+  return Create(std::move(file), options, worker_queue);
 }
 
 std::unique_ptr<AecDump> AecDumpFactory::Create(std::string file_name,
@@ -240,4 +261,14 @@ std::unique_ptr<AecDump> AecDumpFactory::Create(FILE* handle,
   return Create(FileWrapper(handle), max_log_size_bytes, worker_queue);
 }
 
+std::unique_ptr<AecDump> AecDumpFactory::Create(webrtc::FileWrapper file,
+                                                const Options& options,
+                                                rtc::TaskQueue* worker_queue) {
+  RTC_DCHECK(worker_queue);
+  if (!file.is_open())
+    return nullptr;
+
+  return std::make_unique<AecDumpImpl>(std::move(file), options, worker_queue);
+}
+
 }  // namespace webrtc
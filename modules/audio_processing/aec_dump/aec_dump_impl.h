@@ -16,14 +16,15 @@
 #include <vector>
 
 #include "api/audio/audio_frame.h"
+#include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 #include "modules/audio_processing/aec_dump/capture_stream_info.h"
+#include "modules/audio_processing/aec_dump/dump_file_writer.h"
 #include "modules/audio_processing/aec_dump/write_to_file_task.h"
 #include "modules/audio_processing/include/aec_dump.h"
 #include "rtc_base/ignore_wundef.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/system/file_wrapper.h"
 #include "rtc_base/task_queue.h"
-#include "rtc_base/thread_annotations.h"
 
 // Files generated at build-time by the protobuf compiler.
 RTC_PUSH_IGNORING_WUNDEF()
@@ -41,12 +42,13 @@ class TaskQueue;
 namespace webrtc {
 
 // Task-queue based implementation of AecDump. It is thread safe by
-// relying on locks in TaskQueue.
+// relying on locks in TaskQueue. The events are written to the file by a
+// DumpFileWriter on the |worker_queue|.
 class AecDumpImpl : public AecDump {
  public:
   // Does member variables initialization shared across all c-tors.
   AecDumpImpl(FileWrapper debug_file,
-              int64_t max_log_size_bytes,
+              const AecDumpFactory::Options& options,
               rtc::TaskQueue* worker_queue);
 
   ~AecDumpImpl() override;
@@ -71,12 +73,22 @@ class AecDumpImpl : public AecDump {
 
  private:
   std::unique_ptr<WriteToFileTask> CreateWriteToFileTask();
+  // Advances the render frame counter. Returns true if the frame isn't
+  // logged.
+  bool SkipRenderFrame();
 
-  FileWrapper debug_file_;
-  int64_t num_bytes_left_for_log_ = 0;
+  // Only used on |worker_queue_|, until the destructor has waited for it.
+  DumpFileWriter writer_;
   rtc::RaceChecker race_checker_;
   rtc::TaskQueue* worker_queue_;
   CaptureStreamInfo capture_stream_info_;
+
+  // Frames are logged when their counter is zero. The capture counter is
+  // only used on the capture thread and the render counter on the render
+  // thread.
+  const int frame_subsampling_factor_;
+  int capture_frame_counter_ = 0;
+  int render_frame_counter_ = 0;
 };
 }  // namespace webrtc
 
@@ -8,12 +8,96 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "rtc_base/ignore_wundef.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
+#include "third_party/zlib/zlib.h"
+
+RTC_PUSH_IGNORING_WUNDEF()
+#include "modules/audio_processing/debug.pb.h"
+RTC_POP_IGNORING_WUNDEF()
+
+namespace {
+
+std::string ReadFile(const std::string& filename) {
+  std::string contents;
+  FILE* fid = fopen(filename.c_str(), "rb");
+  if (!fid)
+    return contents;
+  char buffer[4096];
+  size_t num_bytes;
+  while ((num_bytes = fread(buffer, 1, sizeof(buffer), fid)) > 0)
+    contents.append(buffer, num_bytes);
+  fclose(fid);
+  return contents;
+}
+
+std::string Gunzip(const std::string& compressed) {
+  z_stream stream = {};
+  EXPECT_EQ(Z_OK, inflateInit2(&stream, 15 + 16));
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  stream.avail_in = compressed.size();
+  std::string decompressed;
+  char buffer[4096];
+  int result;
+  do {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer);
+    stream.avail_out = sizeof(buffer);
+    result = inflate(&stream, Z_NO_FLUSH);
+    decompressed.append(buffer, sizeof(buffer) - stream.avail_out);
+  } while (result == Z_OK);
+  EXPECT_EQ(Z_STREAM_END, result);
+  inflateEnd(&stream);
+  return decompressed;
+}
+
+// Returns the types of the size-prefixed events in |dump|.
+std::vector<webrtc::audioproc::Event::Type> ParseEventTypes(
+    const std::string& dump) {
+  std::vector<webrtc::audioproc::Event::Type> types;
+  size_t offset = 0;
+  while (offset + sizeof(int32_t) <= dump.size()) {
+    int32_t size;
+    memcpy(&size, &dump[offset], sizeof(size));
+    offset += sizeof(size);
+    webrtc::audioproc::Event event;
+    EXPECT_TRUE(event.ParseFromString(dump.substr(offset, size)));
+    types.push_back(event.type());
+    offset += size;
+  }
+  EXPECT_EQ(dump.size(), offset);
+  return types;
+}
+
+// Writes |num_frames| render and capture frames of 10ms stereo audio.
+void WriteFrames(webrtc::AecDump* aec_dump, int num_frames) {
+  webrtc::AudioFrame frame;
+  frame.UpdateFrame(0, nullptr, 480, 48000, webrtc::AudioFrame::kNormalSpeech,
+                    webrtc::AudioFrame::kVadActive, 2);
+  for (int i = 0; i < num_frames; ++i) {
+    int16_t* data = frame.mutable_data();
+    for (size_t j = 0; j < frame.samples_per_channel_ * frame.num_channels_;
+         ++j) {
+      data[j] = static_cast<int16_t>(i * j);
+    }
+    aec_dump->WriteRenderStreamMessage(frame);
+    aec_dump->AddCaptureStreamInput(frame);
+    aec_dump->AddCaptureStreamOutput(frame);
+    aec_dump->WriteCaptureStreamMessage();
+  }
+}
+
+}  // namespace
 
 TEST(AecDumper, APICallsDoNotCrash) {
   // Note order of initialization: Task queue has to be initialized
@@ -68,3 +152,61 @@ TEST(AecDumper, WriteToFile) {
   ASSERT_EQ(0, fclose(fid));
   ASSERT_EQ(0, remove(filename.c_str()));
 }
+
+TEST(AecDumper, CompressedDumpDecompressesToUncompressedDump) {
+  webrtc::TaskQueueForTest file_writer_queue("file_writer_queue");
+  const std::string filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump");
+  const std::string compressed_filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump_gz");
+
+  // Enough frames to fill the write buffer a few times.
+  constexpr int kNumFrames = 200;
+  webrtc::AecDumpFactory::Options options;
+  {
+    std::unique_ptr<webrtc::AecDump> aec_dump = webrtc::AecDumpFactory::Create(
+        webrtc::FileWrapper::OpenWriteOnly(filename), options,
+        &file_writer_queue);
+    WriteFrames(aec_dump.get(), kNumFrames);
+  }
+  options.compress = true;
+  {
+    std::unique_ptr<webrtc::AecDump> aec_dump = webrtc::AecDumpFactory::Create(
+        webrtc::FileWrapper::OpenWriteOnly(compressed_filename), options,
+        &file_writer_queue);
+    WriteFrames(aec_dump.get(), kNumFrames);
+  }
+
+  const std::string dump = ReadFile(filename);
+  const std::string compressed_dump = ReadFile(compressed_filename);
+  EXPECT_EQ(2u * kNumFrames, ParseEventTypes(dump).size());
+  EXPECT_LT(compressed_dump.size(), dump.size());
+  EXPECT_EQ(dump, Gunzip(compressed_dump));
+
+  ASSERT_EQ(0, remove(filename.c_str()));
+  ASSERT_EQ(0, remove(compressed_filename.c_str()));
+}
+
+TEST(AecDumper, LogsSubsetOfFramesWhenSubsampling) {
+  webrtc::TaskQueueForTest file_writer_queue("file_writer_queue");
+  const std::string filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump");
+
+  webrtc::AecDumpFactory::Options options;
+  options.frame_subsampling_factor = 3;
+  {
+    std::unique_ptr<webrtc::AecDump> aec_dump = webrtc::AecDumpFactory::Create(
+        webrtc::FileWrapper::OpenWriteOnly(filename), options,
+        &file_writer_queue);
+    webrtc::InternalAPMConfig apm_config;
+    aec_dump->WriteConfig(apm_config);
+    WriteFrames(aec_dump.get(), 6);
+  }
+
+  using Event = webrtc::audioproc::Event;
+  const std::vector<Event::Type> expected_types = {
+      Event::CONFIG,        Event::REVERSE_STREAM, Event::STREAM,
+      Event::REVERSE_STREAM, Event::STREAM};
+  EXPECT_EQ(expected_types, ParseEventTypes(ReadFile(filename)));
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/dump_file_writer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+
+namespace {
+// Adds a gzip header and trailer to the deflate stream.
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kZlibMemLevel = 8;
+}  // namespace
+
+constexpr size_t DumpFileWriter::kWriteBufferSizeBytes;
+
+DumpFileWriter::DumpFileWriter(FileWrapper file,
+                               int64_t max_log_size_bytes,
+                               bool compress)
+    : file_(std::move(file)),
+      num_bytes_left_for_log_(max_log_size_bytes),
+      compress_(compress) {
+  buffer_.reserve(kWriteBufferSizeBytes);
+  memset(&zlib_stream_, 0, sizeof(zlib_stream_));
+  if (compress_) {
+    compressed_buffer_.resize(kWriteBufferSizeBytes);
+    // Favor speed, since the audio doesn't compress well anyway.
+    const int result =
+        deflateInit2(&zlib_stream_, Z_BEST_SPEED, Z_DEFLATED, kGzipWindowBits,
+                     kZlibMemLevel, Z_DEFAULT_STRATEGY);
+    RTC_CHECK_EQ(Z_OK, result);
+  }
+}
+
+DumpFileWriter::~DumpFileWriter() {
+  WriteBuffer(/*finish=*/true);
+  if (compress_)
+    deflateEnd(&zlib_stream_);
+}
+
+void DumpFileWriter::WriteEvent(const audioproc::Event& event) {
+  const size_t event_byte_size = event.ByteSizeLong();
+  if (!IsRoomForNextEvent(event_byte_size)) {
+    // Ensure that no further events are written, even if they're smaller than
+    // the current event.
+    num_bytes_left_for_log_ = 0;
+    return;
+  }
+  if (num_bytes_left_for_log_ >= 0) {
+    num_bytes_left_for_log_ -= (sizeof(int32_t) + event_byte_size);
+  }
+
+  // Append the message preceded by its size.
+  const int32_t size = rtc::checked_cast<int32_t>(event_byte_size);
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + sizeof(size) + event_byte_size);
+  memcpy(&buffer_[offset], &size, sizeof(size));
+  const bool serialized = event.SerializeToArray(
+      &buffer_[offset + sizeof(size)], static_cast<int>(event_byte_size));
+  RTC_DCHECK(serialized);
+
+  if (buffer_.size() >= kWriteBufferSizeBytes)
+    WriteBuffer(/*finish=*/false);
+}
+
+bool DumpFileWriter::IsRoomForNextEvent(size_t event_byte_size) const {
+  int64_t next_message_size = event_byte_size + sizeof(int32_t);
+  return (num_bytes_left_for_log_ < 0) ||
+         (num_bytes_left_for_log_ >= next_message_size);
+}
+
+void DumpFileWriter::WriteBuffer(bool finish) {
+  if (!compress_) {
+    if (!buffer_.empty() && !file_.Write(buffer_.data(), buffer_.size())) {
+      RTC_NOTREACHED();
+    }
+    buffer_.clear();
+    return;
+  }
+
+  zlib_stream_.next_in = buffer_.data();
+  zlib_stream_.avail_in = rtc::checked_cast<uInt>(buffer_.size());
+  // Compress until all input is consumed and, when finishing, the gzip
+  // trailer has been written. Both are the case when deflate() leaves room in
+  // the output buffer.
+  do {
+    zlib_stream_.next_out = compressed_buffer_.data();
+    zlib_stream_.avail_out = rtc::checked_cast<uInt>(compressed_buffer_.size());
+    const int result = deflate(&zlib_stream_, finish ? Z_FINISH : Z_NO_FLUSH);
+    RTC_DCHECK_NE(Z_STREAM_ERROR, result);
+    const size_t num_bytes =
+        compressed_buffer_.size() - zlib_stream_.avail_out;
+    if (num_bytes > 0 && !file_.Write(compressed_buffer_.data(), num_bytes)) {
+      RTC_NOTREACHED();
+    }
+  } while (zlib_stream_.avail_out == 0);
+  RTC_DCHECK_EQ(0, zlib_stream_.avail_in);
+  buffer_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_DUMP_FILE_WRITER_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_DUMP_FILE_WRITER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/ignore_wundef.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "third_party/zlib/zlib.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/modules/audio_processing/debug.pb.h"
+#else
+#include "modules/audio_processing/debug.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// Writes the events of an AecDump to a file, each preceded by its size as a
+// 32-bit integer. The events are collected in a buffer of
+// kWriteBufferSizeBytes, which is written in one go. If |compress| is set, the
+// file is gzip compressed, so that it can be read after decompressing it with
+// e.g. gunzip. The remaining events are written when the writer is destroyed.
+class DumpFileWriter {
+ public:
+  static constexpr size_t kWriteBufferSizeBytes = 256 * 1024;
+
+  // |max_log_size_bytes == -1| means the log size will be unlimited.
+  // Otherwise no more events are written once the next one, with its size
+  // field, wouldn't fit. The limit applies to the uncompressed size.
+  DumpFileWriter(FileWrapper file, int64_t max_log_size_bytes, bool compress);
+  ~DumpFileWriter();
+
+  void WriteEvent(const audioproc::Event& event);
+
+ private:
+  bool IsRoomForNextEvent(size_t event_byte_size) const;
+  // Writes |buffer_| to |file_|. If |finish| is set, also completes the
+  // compressed stream.
+  void WriteBuffer(bool finish);
+
+  FileWrapper file_;
+  int64_t num_bytes_left_for_log_;
+  const bool compress_;
+  std::vector<uint8_t> buffer_;
+  std::vector<uint8_t> compressed_buffer_;
+  z_stream zlib_stream_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_DUMP_FILE_WRITER_H_
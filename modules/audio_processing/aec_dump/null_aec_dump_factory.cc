@@ -30,4 +30,10 @@ std::unique_ptr<AecDump> AecDumpFactory::Create(FILE* handle,
                                                 rtc::TaskQueue* worker_queue) {
   return nullptr;
 }
+
+std::unique_ptr<AecDump> AecDumpFactory::Create(webrtc::FileWrapper file,
+                                                const Options& options,
+                                                rtc::TaskQueue* worker_queue) {
+  return nullptr;
+}
 }  // namespace webrtc
@@ -10,14 +10,9 @@
 
 #include "modules/audio_processing/aec_dump/write_to_file_task.h"
 
-#include <string>
-
 namespace webrtc {
 
-WriteToFileTask::WriteToFileTask(webrtc::FileWrapper* debug_file,
-                                 int64_t* num_bytes_left_for_log)
-    : debug_file_(debug_file),
-      num_bytes_left_for_log_(num_bytes_left_for_log) {}
+WriteToFileTask::WriteToFileTask(DumpFileWriter* writer) : writer_(writer) {}
 
 WriteToFileTask::~WriteToFileTask() = default;
 
@@ -25,41 +20,8 @@ audioproc::Event* WriteToFileTask::GetEvent() {
   return &event_;
 }
 
-bool WriteToFileTask::IsRoomForNextEvent(size_t event_byte_size) const {
-  int64_t next_message_size = event_byte_size + sizeof(int32_t);
-  return (*num_bytes_left_for_log_ < 0) ||
-         (*num_bytes_left_for_log_ >= next_message_size);
-}
-
-void WriteToFileTask::UpdateBytesLeft(size_t event_byte_size) {
-  RTC_DCHECK(IsRoomForNextEvent(event_byte_size));
-  if (*num_bytes_left_for_log_ >= 0) {
-    *num_bytes_left_for_log_ -= (sizeof(int32_t) + event_byte_size);
-  }
-}
-
 bool WriteToFileTask::Run() {
-  std::string event_string;
-  event_.SerializeToString(&event_string);
-
-  const size_t event_byte_size = event_.ByteSizeLong();
-
-  if (!IsRoomForNextEvent(event_byte_size)) {
-    // Ensure that no further events are written, even if they're smaller than
-    // the current event.
-    *num_bytes_left_for_log_ = 0;
-    return true;
-  }
-
-  UpdateBytesLeft(event_byte_size);
-
-  // Write message preceded by its size.
-  if (!debug_file_->Write(&event_byte_size, sizeof(int32_t))) {
-    RTC_NOTREACHED();
-  }
-  if (!debug_file_->Write(event_string.data(), event_string.length())) {
-    RTC_NOTREACHED();
-  }
+  writer_->WriteEvent(event_);
   return true;  // Delete task from queue at once.
 }
 
@@ -125,8 +125,9 @@ TEST(RnnVadTest, RefinePitchPeriod48kHzBitExactness) {
     // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
     // FloatingPointExceptionObserver fpe_observer;
     const std::array<size_t, 2> pitch_candidates_inv_lags = {280, 284};
-    pitch_inv_lag = RefinePitchPeriod48kHz(test_data.GetPitchBufView(),
-                                           pitch_candidates_inv_lags);
+    pitch_inv_lag =
+        RefinePitchPeriod48kHz(test_data.GetPitchBufView(),
+                               pitch_candidates_inv_lags, DetectOptimization());
   }
   EXPECT_EQ(560u, pitch_inv_lag);
 }
@@ -156,7 +157,7 @@ TEST_P(CheckLowerPitchPeriodsAndComputePitchGainTest,
     // FloatingPointExceptionObserver fpe_observer;
     const auto computed_output = CheckLowerPitchPeriodsAndComputePitchGain(
         test_data.GetPitchBufView(), initial_pitch_period,
-        {prev_pitch_period, prev_pitch_gain});
+        {prev_pitch_period, prev_pitch_gain}, DetectOptimization());
     EXPECT_EQ(expected_pitch_period, computed_output.period);
     EXPECT_NEAR(expected_pitch_gain, computed_output.gain, 1e-6f);
   }
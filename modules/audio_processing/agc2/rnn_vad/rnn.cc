@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "rtc_base/checks.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -48,17 +49,71 @@ using rnnoise::RectifiedLinearUnit;
 using rnnoise::SigmoidApproximated;
 using rnnoise::TansigApproximated;
 
+namespace {
+
+// Converts quantized parameters to floats applying |kWeightsScale|.
+std::vector<float> ScaleParams(rtc::ArrayView<const int8_t> params) {
+  std::vector<float> scaled_params(params.size());
+  std::transform(params.begin(), params.end(), scaled_params.begin(),
+                 [](int8_t x) -> float { return kWeightsScale * x; });
+  return scaled_params;
+}
+
+// Converts the quantized weights of a fully-connected layer to floats,
+// applying |kWeightsScale| and transposing them from input-major to
+// output-major order.
+std::vector<float> PreprocessFullyConnectedWeights(
+    rtc::ArrayView<const int8_t> weights,
+    size_t input_size,
+    size_t output_size) {
+  RTC_DCHECK_EQ(input_size * output_size, weights.size());
+  std::vector<float> preprocessed(weights.size());
+  for (size_t o = 0; o < output_size; ++o) {
+    for (size_t i = 0; i < input_size; ++i) {
+      preprocessed[o * input_size + i] =
+          kWeightsScale * weights[i * output_size + o];
+    }
+  }
+  return preprocessed;
+}
+
+// Converts the quantized weights of a GRU layer to floats, applying
+// |kWeightsScale| and reordering them from input-major order with interleaved
+// gates to gate-major and then output-major order.
+std::vector<float> PreprocessGruWeights(rtc::ArrayView<const int8_t> weights,
+                                        size_t input_size,
+                                        size_t output_size) {
+  RTC_DCHECK_LE(3 * input_size * output_size, weights.size());
+  const size_t stride = 3 * output_size;
+  std::vector<float> preprocessed(3 * input_size * output_size);
+  for (size_t g = 0; g < 3; ++g) {
+    for (size_t o = 0; o < output_size; ++o) {
+      for (size_t i = 0; i < input_size; ++i) {
+        preprocessed[(g * output_size + o) * input_size + i] =
+            kWeightsScale * weights[g * output_size + i * stride + o];
+      }
+    }
+  }
+  return preprocessed;
+}
+
+}  // namespace
+
 FullyConnectedLayer::FullyConnectedLayer(
     const size_t input_size,
     const size_t output_size,
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      activation_function_(activation_function) {
+      bias_(ScaleParams(bias)),
+      weights_(PreprocessFullyConnectedWeights(weights,
+                                               input_size,
+                                               output_size)),
+      activation_function_(activation_function),
+      vector_math_(optimization) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayersMaxUnits)
       << "Static over-allocation of fully-connected layers output vectors is "
          "not sufficient.";
@@ -75,16 +130,12 @@ rtc::ArrayView<const float> FullyConnectedLayer::GetOutput() const {
 }
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
+  RTC_DCHECK_EQ(input_size_, input.size());
   for (size_t o = 0; o < output_size_; ++o) {
-    output_[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| change the performance across different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {
-      output_[o] += input[i] * weights_[i * output_size_ + o];
-    }
-    output_[o] = (*activation_function_)(kWeightsScale * output_[o]);
+    const rtc::ArrayView<const float> weights(&weights_[o * input_size_],
+                                              input_size_);
+    output_[o] = (*activation_function_)(
+        bias_[o] + vector_math_.DotProduct(input, weights));
   }
 }
 
@@ -94,21 +145,24 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      recurrent_weights_(recurrent_weights),
-      activation_function_(activation_function) {
+      bias_(ScaleParams(bias)),
+      weights_(PreprocessGruWeights(weights, input_size, output_size)),
+      recurrent_weights_(
+          PreprocessGruWeights(recurrent_weights, output_size, output_size)),
+      activation_function_(activation_function),
+      vector_math_(optimization) {
   RTC_DCHECK_LE(output_size_, kRecurrentLayersMaxUnits)
       << "Static over-allocation of recurrent layers state vectors is not "
       << "sufficient.";
   RTC_DCHECK_EQ(3 * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size.";
-  RTC_DCHECK_EQ(3 * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(3 * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size.";
-  RTC_DCHECK_EQ(3 * input_size_ * output_size_, recurrent_weights_.size())
+  RTC_DCHECK_EQ(3 * input_size_ * output_size_, recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
       << " size.";
   Reset();
@@ -125,56 +179,38 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
-  // Stride and offset used to read parameter arrays.
-  const size_t stride = 3 * output_size_;
-  size_t offset = 0;
+  RTC_DCHECK_EQ(input_size_, input.size());
+  const rtc::ArrayView<const float> state(state_.data(), output_size_);
+  // Returns the weighted sum of the input and of |recurrent_input| for unit
+  // |o| of gate |g|.
+  auto weighted_sum = [&](size_t g, size_t o,
+                          rtc::ArrayView<const float> recurrent_input) {
+    const size_t unit = g * output_size_ + o;
+    return bias_[unit] +
+           vector_math_.DotProduct(
+               input, {&weights_[unit * input_size_], input_size_}) +
+           vector_math_.DotProduct(
+               recurrent_input,
+               {&recurrent_weights_[unit * output_size_], output_size_});
+  };
 
   // Compute update gates.
   std::array<float, kRecurrentLayersMaxUnits> update;
   for (size_t o = 0; o < output_size_; ++o) {
-    update[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| and |recurrent_weights_| change the performance across
-    // different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      update[o] += input[i] * weights_[i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {
-      update[o] += state_[s] * recurrent_weights_[s * stride + o];
-    }  // Add state.
-    update[o] = SigmoidApproximated(kWeightsScale * update[o]);
+    update[o] = SigmoidApproximated(weighted_sum(0, o, state));
   }
 
-  // Compute reset gates.
-  offset += output_size_;
-  std::array<float, kRecurrentLayersMaxUnits> reset;
+  // Compute reset gates and apply them to the state.
+  std::array<float, kRecurrentLayersMaxUnits> reset_state;
   for (size_t o = 0; o < output_size_; ++o) {
-    reset[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      reset[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {  // Add state.
-      reset[o] += state_[s] * recurrent_weights_[offset + s * stride + o];
-    }
-    reset[o] = SigmoidApproximated(kWeightsScale * reset[o]);
+    reset_state[o] = state_[o] * SigmoidApproximated(weighted_sum(1, o, state));
   }
 
   // Compute output.
-  offset += output_size_;
   std::array<float, kRecurrentLayersMaxUnits> output;
   for (size_t o = 0; o < output_size_; ++o) {
-    output[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      output[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_;
-         ++s) {  // Add state through reset gates.
-      output[o] +=
-          state_[s] * recurrent_weights_[offset + s * stride + o] * reset[s];
-    }
-    output[o] = (*activation_function_)(kWeightsScale * output[o]);
+    output[o] = (*activation_function_)(
+        weighted_sum(2, o, {reset_state.data(), output_size_}));
     // Update output through the update gates.
     output[o] = update[o] * state_[o] + (1.f - update[o]) * output[o];
   }
@@ -184,23 +220,28 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   std::copy(output.begin(), output.end(), state_.begin());
 }
 
-RnnBasedVad::RnnBasedVad()
+RnnBasedVad::RnnBasedVad() : RnnBasedVad(DetectOptimization()) {}
+
+RnnBasedVad::RnnBasedVad(Optimization optimization)
     : input_layer_(kInputLayerInputSize,
                    kInputLayerOutputSize,
                    kInputDenseBias,
                    kInputDenseWeights,
-                   TansigApproximated),
+                   TansigApproximated,
+                   optimization),
       hidden_layer_(kInputLayerOutputSize,
                     kHiddenLayerOutputSize,
                     kHiddenGruBias,
                     kHiddenGruWeights,
                     kHiddenGruRecurrentWeights,
-                    RectifiedLinearUnit),
+                    RectifiedLinearUnit,
+                    optimization),
       output_layer_(kHiddenLayerOutputSize,
                     kOutputLayerOutputSize,
                     kOutputDenseBias,
                     kOutputDenseWeights,
-                    SigmoidApproximated) {
+                    SigmoidApproximated,
+                    optimization) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_layer_.output_size(), hidden_layer_.input_size())
       << "The input and the hidden layers sizes do not match.";
@@ -11,9 +11,14 @@
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
 #include <array>
+#include <vector>
 
 #include "modules/audio_processing/agc2/rnn_vad/test_utils.h"
+#include "modules/audio_processing/test/performance_timer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
 #include "third_party/rnnoise/src/rnn_vad_weights.h"
@@ -27,6 +32,39 @@ using rnnoise::SigmoidApproximated;
 
 namespace {
 
+// Returns the optimizations supported by the current CPU, including none.
+std::vector<Optimization> GetOptimizationsToTest() {
+  std::vector<Optimization> optimizations = {Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(Optimization::kSse2);
+  }
+#endif
+#if defined(WEBRTC_HAS_AVX2)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(Optimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
+const char* OptimizationToString(Optimization optimization) {
+  switch (optimization) {
+    case Optimization::kNone:
+      return "none";
+    case Optimization::kSse2:
+      return "SSE2";
+    case Optimization::kAvx2:
+      return "AVX2";
+    case Optimization::kNeon:
+      return "NEON";
+  }
+  return "";
+}
+
 void TestFullyConnectedLayer(FullyConnectedLayer* fc,
                              rtc::ArrayView<const float> input_vector,
                              const float expected_output) {
@@ -60,16 +98,8 @@ void TestGatedRecurrentLayer(
   }
 }
 
-}  // namespace
-
-// Checks that the output of a fully connected layer is within tolerance given
-// test input data.
-TEST(RnnVadTest, CheckFullyConnectedLayerOutput) {
-  const std::array<int8_t, 1> bias = {-50};
-  const std::array<int8_t, 24> weights = {
-      127,  127,  127, 127,  127,  20,  127,  -126, -126, -54, 14,  125,
-      -126, -126, 127, -125, -126, 127, -127, -127, -57,  -30, 127, 80};
-  FullyConnectedLayer fc(24, 1, bias, weights, SigmoidApproximated);
+// Checks the output of |fc| on different inputs.
+void TestFullyConnectedLayerOutput(FullyConnectedLayer* fc) {
   // Test on different inputs.
   {
     const std::array<float, 24> input_vector = {
@@ -78,7 +108,7 @@ TEST(RnnVadTest, CheckFullyConnectedLayerOutput) {
         0.f,           0.0461241305f, 0.106401242f, 0.223070428f, 0.630603909f,
         0.690453172f,  0.f,           0.387645692f, 0.166913897f, 0.f,
         0.0327451192f, 0.f,           0.136149868f, 0.446351469f};
-    TestFullyConnectedLayer(&fc, input_vector, 0.436567038f);
+    TestFullyConnectedLayer(fc, input_vector, 0.436567038f);
   }
   {
     const std::array<float, 24> input_vector = {
@@ -90,7 +120,7 @@ TEST(RnnVadTest, CheckFullyConnectedLayerOutput) {
         0.9688586f,    0.0320267938f, 0.244722098f,
         0.312745273f,  0.f,           0.00650715502f,
         0.312553257f,  1.62619662f,   0.782880902f};
-    TestFullyConnectedLayer(&fc, input_vector, 0.874741316f);
+    TestFullyConnectedLayer(fc, input_vector, 0.874741316f);
   }
   {
     const std::array<float, 24> input_vector = {
@@ -102,7 +132,24 @@ TEST(RnnVadTest, CheckFullyConnectedLayerOutput) {
         1.20532358f,   0.0254284926f, 0.283327013f,
         0.726210058f,  0.0550272502f, 0.000344108557f,
         0.369803518f,  1.56680179f,   0.997883797f};
-    TestFullyConnectedLayer(&fc, input_vector, 0.672785878f);
+    TestFullyConnectedLayer(fc, input_vector, 0.672785878f);
+  }
+}
+
+}  // namespace
+
+// Checks that the output of a fully connected layer is within tolerance given
+// test input data.
+TEST(RnnVadTest, CheckFullyConnectedLayerOutput) {
+  const std::array<int8_t, 1> bias = {-50};
+  const std::array<int8_t, 24> weights = {
+      127,  127,  127, 127,  127,  20,  127,  -126, -126, -54, 14,  125,
+      -126, -126, 127, -125, -126, 127, -127, -127, -57,  -30, 127, 80};
+  for (Optimization optimization : GetOptimizationsToTest()) {
+    SCOPED_TRACE(OptimizationToString(optimization));
+    FullyConnectedLayer fc(24, 1, bias, weights, SigmoidApproximated,
+                           optimization);
+    TestFullyConnectedLayerOutput(&fc);
   }
 }
 
@@ -123,24 +170,72 @@ TEST(RnnVadTest, CheckGatedRecurrentLayer) {
       64,  -62, 117, 85,  -51,  -43, 54,  -105, 120, 56,  -128, -107,
       39,  50,  -17, -47, -117, 14,  108, 12,   -7,  -72, 103,  -87,
       -66, 82,  84,  100, -98,  102, -49, 44,   122, 106, -20,  -69};
-  GatedRecurrentLayer gru(5, 4, bias, weights, recurrent_weights,
-                          RectifiedLinearUnit);
-  // Test on different inputs.
-  {
-    const std::array<float, 20> input_sequence = {
-        0.89395463f, 0.93224651f, 0.55788344f, 0.32341808f, 0.93355054f,
-        0.13475326f, 0.97370994f, 0.14253306f, 0.93710381f, 0.76093364f,
-        0.65780413f, 0.41657975f, 0.49403164f, 0.46843281f, 0.75138855f,
-        0.24517593f, 0.47657707f, 0.57064998f, 0.435184f,   0.19319285f};
-    const std::array<float, 16> expected_output_sequence = {
-        0.0239123f,  0.5773077f,  0.f,         0.f,
-        0.01282811f, 0.64330572f, 0.f,         0.04863098f,
-        0.00781069f, 0.75267816f, 0.f,         0.02579715f,
-        0.00471378f, 0.59162533f, 0.11087593f, 0.01334511f};
+  const std::array<float, 20> input_sequence = {
+      0.89395463f, 0.93224651f, 0.55788344f, 0.32341808f, 0.93355054f,
+      0.13475326f, 0.97370994f, 0.14253306f, 0.93710381f, 0.76093364f,
+      0.65780413f, 0.41657975f, 0.49403164f, 0.46843281f, 0.75138855f,
+      0.24517593f, 0.47657707f, 0.57064998f, 0.435184f,   0.19319285f};
+  const std::array<float, 16> expected_output_sequence = {
+      0.0239123f,  0.5773077f,  0.f,         0.f,
+      0.01282811f, 0.64330572f, 0.f,         0.04863098f,
+      0.00781069f, 0.75267816f, 0.f,         0.02579715f,
+      0.00471378f, 0.59162533f, 0.11087593f, 0.01334511f};
+  for (Optimization optimization : GetOptimizationsToTest()) {
+    SCOPED_TRACE(OptimizationToString(optimization));
+    GatedRecurrentLayer gru(5, 4, bias, weights, recurrent_weights,
+                            RectifiedLinearUnit, optimization);
     TestGatedRecurrentLayer(&gru, input_sequence, expected_output_sequence);
   }
 }
 
+// Checks that all the optimizations produce the same VAD probabilities.
+TEST(RnnVadTest, RnnBasedVadOptimizationsMatch) {
+  std::array<float, kFeatureVectorSize> feature_vector;
+  for (size_t i = 0; i < feature_vector.size(); ++i) {
+    feature_vector[i] = 0.1f * static_cast<float>(i % 7) - 0.2f;
+  }
+  RnnBasedVad reference_vad(Optimization::kNone);
+  for (Optimization optimization : GetOptimizationsToTest()) {
+    SCOPED_TRACE(OptimizationToString(optimization));
+    RnnBasedVad vad(optimization);
+    reference_vad.Reset();
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_NEAR(reference_vad.ComputeVadProbability(feature_vector, false),
+                  vad.ComputeVadProbability(feature_vector, false), 1e-5f);
+    }
+  }
+}
+
+// Performance test for the RNN inference with the different optimizations.
+// Keep disabled and only enable locally to measure performance with
+// "--logs".
+TEST(RnnVadTest, DISABLED_BenchmarkRnnBasedVad) {
+  std::array<float, kFeatureVectorSize> feature_vector;
+  for (size_t i = 0; i < feature_vector.size(); ++i) {
+    feature_vector[i] = 0.1f * static_cast<float>(i % 7) - 0.2f;
+  }
+  constexpr int kNumFrames = 10000;
+  constexpr size_t kNumTests = 100;
+  for (Optimization optimization : GetOptimizationsToTest()) {
+    RnnBasedVad vad(optimization);
+    ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
+    for (size_t k = 0; k < kNumTests; ++k) {
+      vad.Reset();
+      perf_timer.StartTimer();
+      for (int i = 0; i < kNumFrames; ++i) {
+        vad.ComputeVadProbability(feature_vector, false);
+      }
+      perf_timer.StopTimer();
+    }
+    RTC_LOG(LS_INFO) << OptimizationToString(optimization) << ": "
+                     << (perf_timer.GetDurationAverage() / kNumFrames)
+                     << " +/- "
+                     << (perf_timer.GetDurationStandardDeviation() /
+                         kNumFrames)
+                     << " us per frame";
+  }
+}
+
 }  // namespace test
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_H_
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include <numeric>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Provides optimizations for mathematical operations based on vectors.
+class VectorMath {
+ public:
+  explicit VectorMath(Optimization optimization)
+      : optimization_(optimization) {}
+
+  // Computes the dot product of two equally sized vectors.
+  float DotProduct(rtc::ArrayView<const float> x,
+                   rtc::ArrayView<const float> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+    switch (optimization_) {
+#if defined(WEBRTC_HAS_AVX2)
+      case Optimization::kAvx2:
+        return DotProductAvx2(x, y);
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Optimization::kSse2: {
+        const size_t vector_limit = x.size() & ~static_cast<size_t>(3);
+        __m128 accumulator = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i < vector_limit; i += 4) {
+          const __m128 x_i = _mm_loadu_ps(&x[i]);
+          const __m128 y_i = _mm_loadu_ps(&y[i]);
+          accumulator = _mm_add_ps(accumulator, _mm_mul_ps(x_i, y_i));
+        }
+        // Reduce |accumulator| to a single sum.
+        __m128 high = _mm_movehl_ps(accumulator, accumulator);
+        accumulator = _mm_add_ps(accumulator, high);
+        high = _mm_shuffle_ps(accumulator, accumulator, 1);
+        accumulator = _mm_add_ss(accumulator, high);
+        float dot_product = _mm_cvtss_f32(accumulator);
+        for (; i < x.size(); ++i) {
+          dot_product += x[i] * y[i];
+        }
+        return dot_product;
+      }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Optimization::kNeon: {
+        const size_t vector_limit = x.size() & ~static_cast<size_t>(3);
+        float32x4_t accumulator = vdupq_n_f32(0.f);
+        size_t i = 0;
+        for (; i < vector_limit; i += 4) {
+          accumulator =
+              vmlaq_f32(accumulator, vld1q_f32(&x[i]), vld1q_f32(&y[i]));
+        }
+        float32x2_t sum =
+            vadd_f32(vget_low_f32(accumulator), vget_high_f32(accumulator));
+        sum = vpadd_f32(sum, sum);
+        float dot_product = vget_lane_f32(sum, 0);
+        for (; i < x.size(); ++i) {
+          dot_product += x[i] * y[i];
+        }
+        return dot_product;
+      }
+#endif
+      default:
+        return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
+    }
+  }
+
+ private:
+#if defined(WEBRTC_HAS_AVX2)
+  float DotProductAvx2(rtc::ArrayView<const float> x,
+                       rtc::ArrayView<const float> y) const;
+#endif
+
+  const Optimization optimization_;
+};
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATH_H_
@@ -64,6 +64,14 @@ constexpr int kRuntimeSettingQueueSize = 100;
 
 namespace {
 
+// Number of 10 ms capture frames over which the processing time is averaged
+// before comparing it to the compute budget.
+constexpr int kComputeBudgetWindowFrames = 100;
+// Length of the AEC3 filters when they have been shortened to stay within the
+// compute budget, instead of the default 13 blocks. Covers echo paths of up to
+// 40 ms, and is the shortest length supported by the reverb decay estimator.
+constexpr size_t kComputeBudgetAec3FilterLengthBlocks = 10;
+
 static bool LayoutHasKeyboard(AudioProcessing::ChannelLayout layout) {
   switch (layout) {
     case AudioProcessing::kMono:
@@ -140,6 +148,16 @@ static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 // TODO(peah): Decrease this once we properly handle hugely unbalanced
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
+
+// Hands a frame of render audio over to the capture side. If the capture side
+// has fallen so far behind that the queue is full, the frame is dropped, as
+// emptying the queue here would make the render thread wait for the capture
+// lock. AEC3 treats its render queue the same way.
+template <typename T, typename QueueItemVerifier>
+void InsertRenderAudio(SwapQueue<std::vector<T>, QueueItemVerifier>* queue,
+                       std::vector<T>* audio) {
+  static_cast<void>(queue->Insert(audio));
+}
 }  // namespace
 
 // Throughout webrtc, it's assumed that success is represented by zero.
@@ -479,6 +497,7 @@ int AudioProcessingImpl::MaybeInitializeRender(
 
 int AudioProcessingImpl::InitializeLocked() {
   UpdateActiveSubmoduleStates();
+  capture_.compute_budget.reinitialization_pending = false;
 
   const int render_audiobuffer_sample_rate_hz =
       formats_.api_format.reverse_output_stream().num_frames() == 0
@@ -698,8 +717,23 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.noise_suppression.enabled != config.noise_suppression.enabled ||
       config_.noise_suppression.level != config.noise_suppression.level;
 
+  const bool compute_budget_config_changed =
+      config_.compute_budget.enabled != config.compute_budget.enabled ||
+      config_.compute_budget.max_processing_time_us !=
+          config.compute_budget.max_processing_time_us;
+
   config_ = config;
 
+  if (compute_budget_config_changed) {
+    // Restore the shed stages with the next capture frame and start over.
+    const bool stages_shed =
+        capture_.compute_budget.transient_suppression_shed ||
+        capture_.compute_budget.echo_canceller_filter_shortened ||
+        capture_.compute_budget.noise_suppression_shed;
+    capture_.compute_budget = ApmCaptureState::ComputeBudgetState();
+    capture_.compute_budget.reinitialization_pending = stages_shed;
+  }
+
   if (aec_config_changed) {
     InitializeEchoController();
   }
@@ -947,7 +981,9 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
     }
 
     processing_config = formats_.api_format;
-    reinitialization_required = UpdateActiveSubmoduleStates();
+    reinitialization_required =
+        UpdateActiveSubmoduleStates() ||
+        capture_.compute_budget.reinitialization_pending;
   }
 
   if (processing_config.input_stream() != input_config) {
@@ -1078,14 +1114,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                 num_reverse_channels(),
                                                 &aec_render_queue_buffer_);
 
-    if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = aec_render_signal_queue_->Insert(&aec_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    InsertRenderAudio(aec_render_signal_queue_.get(),
+                      &aec_render_queue_buffer_);
   }
 
   if (private_submodules_->echo_control_mobile) {
@@ -1094,28 +1124,15 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                  &aecm_render_queue_buffer_);
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
-    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    InsertRenderAudio(aecm_render_signal_queue_.get(),
+                      &aecm_render_queue_buffer_);
   }
 
   if (!constants_.use_experimental_agc) {
     GainControlImpl::PackRenderAudioBuffer(audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
-    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    InsertRenderAudio(agc_render_signal_queue_.get(),
+                      &agc_render_queue_buffer_);
   }
 }
 
@@ -1123,14 +1140,7 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
   ResidualEchoDetector::PackRenderAudioBuffer(audio, &red_render_queue_buffer_);
 
   // Insert the samples into the queue.
-  if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
-    // Retry the insert (should always work).
-    bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-    RTC_DCHECK(result);
-  }
+  InsertRenderAudio(red_render_signal_queue_.get(), &red_render_queue_buffer_);
 }
 
 void AudioProcessingImpl::AllocateRenderQueue() {
@@ -1183,7 +1193,6 @@ void AudioProcessingImpl::AllocateRenderQueue() {
 }
 
 void AudioProcessingImpl::EmptyQueuedRenderAudio() {
-  rtc::CritScope cs_capture(&crit_capture_);
   if (private_submodules_->echo_cancellation) {
     RTC_DCHECK(aec_render_signal_queue_);
     while (aec_render_signal_queue_->Remove(&aec_capture_queue_buffer_)) {
@@ -1214,6 +1223,17 @@ void AudioProcessingImpl::EmptyQueuedRenderAudio() {
 
 int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_AudioFrame");
+  return ProcessAudioFrame(frame, frame);
+}
+
+int AudioProcessingImpl::ProcessStream(const AudioFrame& input_frame,
+                                       AudioFrame* output_frame) {
+  TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_AudioFrames");
+  return ProcessAudioFrame(&input_frame, output_frame);
+}
+
+int AudioProcessingImpl::ProcessAudioFrame(const AudioFrame* input_frame,
+                                           AudioFrame* output_frame) {
   {
     // Acquire the capture lock in order to safely call the function
     // that retrieves the render side data. This function accesses APM
@@ -1222,14 +1242,17 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
     EmptyQueuedRenderAudio();
   }
 
-  if (!frame) {
+  if (!input_frame || !output_frame) {
     return kNullPointerError;
   }
-  // Must be a native rate.
-  if (frame->sample_rate_hz_ != kSampleRate8kHz &&
-      frame->sample_rate_hz_ != kSampleRate16kHz &&
-      frame->sample_rate_hz_ != kSampleRate32kHz &&
-      frame->sample_rate_hz_ != kSampleRate48kHz) {
+  // The output must be a native rate.
+  if (output_frame->sample_rate_hz_ != kSampleRate8kHz &&
+      output_frame->sample_rate_hz_ != kSampleRate16kHz &&
+      output_frame->sample_rate_hz_ != kSampleRate32kHz &&
+      output_frame->sample_rate_hz_ != kSampleRate48kHz) {
+    return kBadSampleRateError;
+  }
+  if (input_frame->sample_rate_hz_ < kSampleRate8kHz) {
     return kBadSampleRateError;
   }
 
@@ -1240,28 +1263,33 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
     // The lock is released immediately due to the conditional
     // reinitialization.
     rtc::CritScope cs_capture(&crit_capture_);
-    // TODO(ajm): The input and output rates and channels are currently
-    // constrained to be identical in the int16 interface.
     processing_config = formats_.api_format;
 
-    reinitialization_required = UpdateActiveSubmoduleStates();
+    reinitialization_required =
+        UpdateActiveSubmoduleStates() ||
+        capture_.compute_budget.reinitialization_pending;
   }
 
   reinitialization_required =
       reinitialization_required ||
       processing_config.input_stream().sample_rate_hz() !=
-          frame->sample_rate_hz_ ||
-      processing_config.input_stream().num_channels() != frame->num_channels_ ||
+          input_frame->sample_rate_hz_ ||
+      processing_config.input_stream().num_channels() !=
+          input_frame->num_channels_ ||
       processing_config.output_stream().sample_rate_hz() !=
-          frame->sample_rate_hz_ ||
-      processing_config.output_stream().num_channels() != frame->num_channels_;
+          output_frame->sample_rate_hz_ ||
+      processing_config.output_stream().num_channels() !=
+          output_frame->num_channels_;
 
   if (reinitialization_required) {
-    processing_config.input_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-    processing_config.input_stream().set_num_channels(frame->num_channels_);
+    processing_config.input_stream().set_sample_rate_hz(
+        input_frame->sample_rate_hz_);
+    processing_config.input_stream().set_num_channels(
+        input_frame->num_channels_);
     processing_config.output_stream().set_sample_rate_hz(
-        frame->sample_rate_hz_);
-    processing_config.output_stream().set_num_channels(frame->num_channels_);
+        output_frame->sample_rate_hz_);
+    processing_config.output_stream().set_num_channels(
+        output_frame->num_channels_);
 
     // Reinitialize.
     rtc::CritScope cs_render(&crit_render_);
@@ -1270,42 +1298,49 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   }
 
   rtc::CritScope cs_capture(&crit_capture_);
-  if (frame->samples_per_channel_ !=
+  if (input_frame->samples_per_channel_ !=
       formats_.api_format.input_stream().num_frames()) {
     return kBadDataLengthError;
   }
 
   if (aec_dump_) {
-    RecordUnprocessedCaptureStream(*frame);
+    RecordUnprocessedCaptureStream(*input_frame);
   }
 
-  capture_.capture_audio->CopyFrom(frame);
+  capture_.capture_audio->CopyFrom(input_frame);
   if (capture_.capture_fullband_audio) {
-    capture_.capture_fullband_audio->CopyFrom(frame);
+    capture_.capture_fullband_audio->CopyFrom(input_frame);
   }
   RETURN_ON_ERR(ProcessCaptureStreamLocked());
-  if (submodule_states_.CaptureMultiBandProcessingPresent() ||
+  // When processing in-place, the frame is left as is unless the audio has
+  // been modified.
+  if (input_frame != output_frame ||
+      submodule_states_.CaptureMultiBandProcessingPresent() ||
       submodule_states_.CaptureFullBandProcessingActive()) {
+    output_frame->samples_per_channel_ =
+        formats_.api_format.output_stream().num_frames();
     if (capture_.capture_fullband_audio) {
-      capture_.capture_fullband_audio->CopyTo(frame);
+      capture_.capture_fullband_audio->CopyTo(output_frame);
     } else {
-      capture_.capture_audio->CopyTo(frame);
+      capture_.capture_audio->CopyTo(output_frame);
     }
   }
   if (capture_.stats.voice_detected) {
-    frame->vad_activity_ = *capture_.stats.voice_detected
-                               ? AudioFrame::kVadActive
-                               : AudioFrame::kVadPassive;
+    output_frame->vad_activity_ = *capture_.stats.voice_detected
+                                      ? AudioFrame::kVadActive
+                                      : AudioFrame::kVadPassive;
   }
 
   if (aec_dump_) {
-    RecordProcessedCaptureStream(*frame);
+    RecordProcessedCaptureStream(*output_frame);
   }
 
   return kNoError;
 }
 
 int AudioProcessingImpl::ProcessCaptureStreamLocked() {
+  const int64_t start_time_us =
+      config_.compute_budget.enabled ? rtc::TimeMicros() : 0;
   HandleCaptureRuntimeSettings();
 
   // Ensure that not both the AEC and AECM are active at the same time.
@@ -1497,7 +1532,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
   // TODO(aluebs): Investigate if the transient suppression placement should be
   // before or after the AGC.
-  if (capture_.transient_suppressor_enabled) {
+  if (TransientSuppressorActive()) {
     float voice_probability =
         private_submodules_->agc_manager.get()
             ? private_submodules_->agc_manager->voice_probability()
@@ -1548,10 +1583,57 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
                                 levels.peak, 1, RmsLevel::kMinLevelDb, 64);
   }
 
+  if (config_.compute_budget.enabled) {
+    UpdateComputeBudget(rtc::TimeMicros() - start_time_us);
+  }
+
   capture_.was_stream_delay_set = false;
   return kNoError;
 }
 
+void AudioProcessingImpl::UpdateComputeBudget(int64_t processing_time_us) {
+  auto& budget = capture_.compute_budget;
+  budget.window_processing_time_us += processing_time_us;
+  if (++budget.window_num_frames < kComputeBudgetWindowFrames) {
+    return;
+  }
+  const bool over_budget =
+      budget.window_processing_time_us >
+      static_cast<int64_t>(config_.compute_budget.max_processing_time_us) *
+          kComputeBudgetWindowFrames;
+  budget.window_processing_time_us = 0;
+  budget.window_num_frames = 0;
+  if (!over_budget) {
+    return;
+  }
+
+  // Shed the cheapest active stage that is left, in terms of quality lost.
+  if (TransientSuppressorActive()) {
+    budget.transient_suppression_shed = true;
+    RTC_LOG(LS_WARNING) << "Over compute budget, shedding the transient "
+                           "suppressor.";
+  } else if (capture_nonlocked_.echo_controller_enabled &&
+             !echo_control_factory_ &&
+             !budget.echo_canceller_filter_shortened) {
+    budget.echo_canceller_filter_shortened = true;
+    RTC_LOG(LS_WARNING) << "Over compute budget, shortening the AEC3 filters.";
+  } else if (private_submodules_->noise_suppressor) {
+    budget.noise_suppression_shed = true;
+    RTC_LOG(LS_WARNING) << "Over compute budget, shedding the noise "
+                           "suppressor.";
+  } else {
+    return;
+  }
+  // The submodules are reinitialized by the next capture call, which holds
+  // both locks.
+  budget.reinitialization_pending = true;
+}
+
+bool AudioProcessingImpl::TransientSuppressorActive() const {
+  return capture_.transient_suppressor_enabled &&
+         !capture_.compute_budget.transient_suppression_shed;
+}
+
 int AudioProcessingImpl::AnalyzeReverseStream(const float* const* data,
                                               size_t samples_per_channel,
                                               int sample_rate_hz,
@@ -1802,10 +1884,18 @@ void AudioProcessingImpl::DetachPlayoutAudioGenerator() {
 AudioProcessingStats AudioProcessingImpl::GetStatistics(
     bool has_remote_tracks) const {
   rtc::CritScope cs_capture(&crit_capture_);
+  AudioProcessingStats stats = capture_.stats;
+  if (config_.compute_budget.enabled) {
+    stats.transient_suppression_shed =
+        capture_.compute_budget.transient_suppression_shed;
+    stats.echo_canceller_filter_shortened =
+        capture_.compute_budget.echo_canceller_filter_shortened;
+    stats.noise_suppression_shed =
+        capture_.compute_budget.noise_suppression_shed;
+  }
   if (!has_remote_tracks) {
-    return capture_.stats;
+    return stats;
   }
-  AudioProcessingStats stats = capture_.stats;
   EchoCancellationImpl::Metrics metrics;
   if (private_submodules_->echo_controller) {
     auto ec_metrics = private_submodules_->echo_controller->GetMetrics();
@@ -1848,11 +1938,11 @@ bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
       public_submodules_->gain_control->is_enabled(),
       config_.gain_controller2.enabled, config_.pre_amplifier.enabled,
       capture_nonlocked_.echo_controller_enabled,
-      config_.voice_detection.enabled, capture_.transient_suppressor_enabled);
+      config_.voice_detection.enabled, TransientSuppressorActive());
 }
 
 void AudioProcessingImpl::InitializeTransient() {
-  if (capture_.transient_suppressor_enabled) {
+  if (TransientSuppressorActive()) {
     if (!public_submodules_->transient_suppressor.get()) {
       public_submodules_->transient_suppressor.reset(new TransientSuppressor());
     }
@@ -1891,8 +1981,20 @@ void AudioProcessingImpl::InitializeEchoController() {
       private_submodules_->echo_controller =
           echo_control_factory_->Create(proc_sample_rate_hz());
     } else {
+      EchoCanceller3Config config;
+      if (capture_.compute_budget.echo_canceller_filter_shortened) {
+        config.filter.main.length_blocks = kComputeBudgetAec3FilterLengthBlocks;
+        config.filter.shadow.length_blocks =
+            kComputeBudgetAec3FilterLengthBlocks;
+        config.filter.main_initial.length_blocks =
+            std::min(config.filter.main_initial.length_blocks,
+                     kComputeBudgetAec3FilterLengthBlocks);
+        config.filter.shadow_initial.length_blocks =
+            std::min(config.filter.shadow_initial.length_blocks,
+                     kComputeBudgetAec3FilterLengthBlocks);
+      }
       private_submodules_->echo_controller = std::make_unique<EchoCanceller3>(
-          EchoCanceller3Config(), proc_sample_rate_hz(), num_reverse_channels(),
+          config, proc_sample_rate_hz(), num_reverse_channels(),
           num_proc_channels());
     }
 
@@ -1989,7 +2091,8 @@ void AudioProcessingImpl::InitializeGainController2() {
 }
 
 void AudioProcessingImpl::InitializeNoiseSuppressor() {
-  if (config_.noise_suppression.enabled) {
+  if (config_.noise_suppression.enabled &&
+      !capture_.compute_budget.noise_suppression_shed) {
     auto ns_level =
         NsConfigLevelToInterfaceLevel(config_.noise_suppression.level);
     private_submodules_->noise_suppressor = std::make_unique<NoiseSuppression>(
@@ -69,6 +69,8 @@ class AudioProcessingImpl : public AudioProcessing {
   // Capture-side exclusive methods possibly running APM in a
   // multi-threaded manner. Acquire the capture lock.
   int ProcessStream(AudioFrame* frame) override;
+  int ProcessStream(const AudioFrame& input_frame,
+                    AudioFrame* output_frame) override;
   int ProcessStream(const float* const* src,
                     size_t samples_per_channel,
                     int input_sample_rate_hz,
@@ -217,6 +219,15 @@ class AudioProcessingImpl : public AudioProcessing {
   bool UpdateActiveSubmoduleStates()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
 
+  // Accounts |processing_time_us| of a capture frame against
+  // |config_.compute_budget|, and sheds the next stage at the end of a window
+  // in which it was exceeded.
+  void UpdateComputeBudget(int64_t processing_time_us)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
+  // Whether the transient suppressor is enabled and hasn't been shed.
+  bool TransientSuppressorActive() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
+
   // Methods requiring APM running in a single-threaded manner.
   // Are called with both the render and capture locks already
   // acquired.
@@ -253,7 +264,7 @@ class AudioProcessingImpl : public AudioProcessing {
   GainControl* agc1();
   const GainControl* agc1() const;
 
-  void EmptyQueuedRenderAudio();
+  void EmptyQueuedRenderAudio() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
   void QueueBandedRenderAudio(AudioBuffer* audio)
@@ -261,6 +272,11 @@ class AudioProcessingImpl : public AudioProcessing {
   void QueueNonbandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
 
+  // Implements both ProcessStream() methods for AudioFrames. |input_frame| and
+  // |output_frame| may be the same frame.
+  int ProcessAudioFrame(const AudioFrame* input_frame,
+                        AudioFrame* output_frame);
+
   // Capture-side exclusive methods possibly running APM in a multi-threaded
   // manner that are called with the render lock already acquired.
   int ProcessCaptureStreamLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
@@ -395,6 +411,18 @@ class AudioProcessingImpl : public AudioProcessing {
     int playout_volume;
     int prev_playout_volume;
     AudioProcessingStats stats;
+    // Capture processing time and the stages shed to keep it within
+    // |config_.compute_budget|.
+    struct ComputeBudgetState {
+      int64_t window_processing_time_us = 0;
+      int window_num_frames = 0;
+      bool transient_suppression_shed = false;
+      bool echo_canceller_filter_shortened = false;
+      bool noise_suppression_shed = false;
+      // Set when the shed stages have changed, until the submodules have been
+      // reinitialized accordingly.
+      bool reinitialization_pending = false;
+    } compute_budget;
     struct KeyboardInfo {
       void Extract(const float* const* data, const StreamConfig& stream_config);
       size_t num_keyboard_frames = 0;
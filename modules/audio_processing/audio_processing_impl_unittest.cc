@@ -353,6 +353,32 @@ TEST(AudioProcessingImplTest, EchoControllerObservesPlayoutVolumeChange) {
   apm->ProcessStream(&frame);
 }
 
+TEST(AudioProcessingImplTest, RenderQueueOverflowDoesNotBreakCapture) {
+  // Render frames that the capture side can't keep up with are dropped
+  // instead of being consumed on the render thread.
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.echo_canceller.enabled = true;
+  apm_config.echo_canceller.mobile_mode = true;
+  apm_config.residual_echo_detector.enabled = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  InitializeAudioFrame(16000, 1, &frame);
+  FillFixedFrame(1000, &frame);
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(AudioProcessing::Error::kNoError,
+              apm->ProcessReverseStream(&frame));
+  }
+  for (int i = 0; i < 10; ++i) {
+    FillFixedFrame(1000, &frame);
+    ASSERT_EQ(AudioProcessing::Error::kNoError,
+              apm->ProcessReverseStream(&frame));
+    FillFixedFrame(1000, &frame);
+    EXPECT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  }
+}
+
 TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
   // Make sure that signal changes caused by a render pre-processing sub-module
   // take place before any echo detector analysis.
@@ -400,4 +426,109 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, ProcessStreamConvertsToOutputFormat) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  constexpr int16_t kAudioLevel = 1000;
+  AudioFrame input_frame;
+  InitializeAudioFrame(44100, 2, &input_frame);
+  AudioFrame output_frame;
+  output_frame.sample_rate_hz_ = 16000;
+  output_frame.num_channels_ = 1;
+
+  // Lets the resampler settle on the input level.
+  for (int i = 0; i < 10; ++i) {
+    FillFixedFrame(kAudioLevel, &input_frame);
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessStream(input_frame, &output_frame));
+  }
+  EXPECT_EQ(160u, output_frame.samples_per_channel_);
+  EXPECT_EQ(16000, output_frame.sample_rate_hz_);
+  EXPECT_EQ(1u, output_frame.num_channels_);
+  EXPECT_NEAR(kAudioLevel, output_frame.data()[159], 2);
+  // The input is left as is.
+  EXPECT_EQ(kAudioLevel, input_frame.data()[0]);
+}
+
+TEST(AudioProcessingImplTest, ProcessStreamRejectsUnsupportedOutputFormat) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  AudioFrame input_frame;
+  InitializeAudioFrame(16000, 1, &input_frame);
+  AudioFrame output_frame;
+
+  // No more output than input channels.
+  output_frame.sample_rate_hz_ = 16000;
+  output_frame.num_channels_ = 2;
+  EXPECT_EQ(AudioProcessing::kBadNumberChannelsError,
+            apm->ProcessStream(input_frame, &output_frame));
+
+  // The output must have a native rate.
+  output_frame.sample_rate_hz_ = 44100;
+  output_frame.num_channels_ = 1;
+  EXPECT_EQ(AudioProcessing::kBadSampleRateError,
+            apm->ProcessStream(input_frame, &output_frame));
+}
+
+TEST(AudioProcessingImplTest, ShedsStagesInOrderWhenOverComputeBudget) {
+  webrtc::Config config;
+  config.Set<ExperimentalNs>(new ExperimentalNs(true));
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder().Create(config));
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.echo_canceller.enabled = true;
+  apm_config.noise_suppression.enabled = true;
+  apm_config.compute_budget.enabled = true;
+  // Any processing is over budget.
+  apm_config.compute_budget.max_processing_time_us = 0;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  InitializeAudioFrame(48000, 1, &frame);
+  auto process_one_second = [&] {
+    for (int i = 0; i < 100; ++i) {
+      FillFixedFrame(1000, &frame);
+      ASSERT_EQ(AudioProcessing::kNoError, apm->set_stream_delay_ms(0));
+      ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+    }
+  };
+
+  AudioProcessingStats stats = apm->GetStatistics(false);
+  EXPECT_EQ(false, stats.transient_suppression_shed);
+  EXPECT_EQ(false, stats.echo_canceller_filter_shortened);
+  EXPECT_EQ(false, stats.noise_suppression_shed);
+
+  process_one_second();
+  stats = apm->GetStatistics(false);
+  EXPECT_EQ(true, stats.transient_suppression_shed);
+  EXPECT_EQ(false, stats.echo_canceller_filter_shortened);
+
+  process_one_second();
+  stats = apm->GetStatistics(false);
+  EXPECT_EQ(true, stats.echo_canceller_filter_shortened);
+  EXPECT_EQ(false, stats.noise_suppression_shed);
+
+  process_one_second();
+  stats = apm->GetStatistics(false);
+  EXPECT_EQ(true, stats.noise_suppression_shed);
+
+  // Changing the budget restores all stages.
+  apm_config.compute_budget.max_processing_time_us = 1000000;
+  apm->ApplyConfig(apm_config);
+  process_one_second();
+  stats = apm->GetStatistics(false);
+  EXPECT_EQ(false, stats.transient_suppression_shed);
+  EXPECT_EQ(false, stats.echo_canceller_filter_shortened);
+  EXPECT_EQ(false, stats.noise_suppression_shed);
+}
+
+TEST(AudioProcessingImplTest, ComputeBudgetNotReportedWhenDisabled) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  AudioFrame frame;
+  InitializeAudioFrame(16000, 1, &frame);
+  ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+  AudioProcessingStats stats = apm->GetStatistics(false);
+  EXPECT_FALSE(stats.transient_suppression_shed);
+  EXPECT_FALSE(stats.echo_canceller_filter_shortened);
+  EXPECT_FALSE(stats.noise_suppression_shed);
+}
+
 }  // namespace webrtc
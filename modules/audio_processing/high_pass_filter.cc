@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/high_pass_filter.h"
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "rtc_base/checks.h"
@@ -74,4 +76,55 @@ void HighPassFilter::Reset(size_t num_channels) {
   }
 }
 
+BatchedHighPassFilter::BatchedHighPassFilter(size_t num_streams)
+    : num_streams_(num_streams),
+      x0_(num_streams, 0.f),
+      x1_(num_streams, 0.f),
+      y0_(num_streams, 0.f),
+      y1_(num_streams, 0.f) {
+  RTC_DCHECK_LT(0, num_streams_);
+}
+
+BatchedHighPassFilter::~BatchedHighPassFilter() = default;
+
+void BatchedHighPassFilter::Process(rtc::ArrayView<float> audio) {
+  static_assert(kNumberOfHighPassBiQuads == 1,
+                "BatchedHighPassFilter only applies a single biquad.");
+  RTC_DCHECK_EQ(0, audio.size() % num_streams_);
+  const float* c_b = kHighPassFilterCoefficients.b;
+  const float* c_a = kHighPassFilterCoefficients.a;
+  const size_t num_frames = audio.size() / num_streams_;
+  float* x0 = x0_.data();
+  float* x1 = x1_.data();
+  float* y0 = y0_.data();
+  float* y1 = y1_.data();
+  for (size_t k = 0; k < num_frames; ++k) {
+    float* frame = &audio[k * num_streams_];
+    // Same operations, in the same order, as CascadedBiQuadFilter, so that the
+    // output is bitexact to HighPassFilter.
+    for (size_t s = 0; s < num_streams_; ++s) {
+      const float tmp = frame[s];
+      const float y = c_b[0] * tmp + c_b[1] * x0[s] + c_b[2] * x1[s] -
+                      c_a[0] * y0[s] - c_a[1] * y1[s];
+      frame[s] = y;
+      x1[s] = x0[s];
+      x0[s] = tmp;
+      y1[s] = y0[s];
+      y0[s] = y;
+    }
+  }
+}
+
+void BatchedHighPassFilter::Reset() {
+  std::fill(x0_.begin(), x0_.end(), 0.f);
+  std::fill(x1_.begin(), x1_.end(), 0.f);
+  std::fill(y0_.begin(), y0_.end(), 0.f);
+  std::fill(y1_.begin(), y1_.end(), 0.f);
+}
+
+void BatchedHighPassFilter::Reset(size_t stream) {
+  RTC_DCHECK_LT(stream, num_streams_);
+  x0_[stream] = x1_[stream] = y0_[stream] = y1_[stream] = 0.f;
+}
+
 }  // namespace webrtc
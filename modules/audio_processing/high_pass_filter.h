@@ -37,6 +37,38 @@ class HighPassFilter {
  private:
   std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters_;
 };
+
+// Applies the same filter as HighPassFilter to a batch of independent mono
+// streams in one call, e.g. the capture signals of many calls on a server. The
+// samples are laid out frame by frame, with the samples of all streams for one
+// frame next to each other: sample |k| of stream |s| is at
+// |k * num_streams() + s|. Since a biquad is recursive in time but independent
+// across streams, this layout lets each filter step be vectorized across the
+// streams, which is not possible when filtering one stream at a time.
+class BatchedHighPassFilter {
+ public:
+  explicit BatchedHighPassFilter(size_t num_streams);
+  ~BatchedHighPassFilter();
+  BatchedHighPassFilter(const BatchedHighPassFilter&) = delete;
+  BatchedHighPassFilter& operator=(const BatchedHighPassFilter&) = delete;
+
+  size_t num_streams() const { return num_streams_; }
+
+  // Filters |audio| in place. Its size must be a multiple of num_streams().
+  void Process(rtc::ArrayView<float> audio);
+  // Resets the state of all streams.
+  void Reset();
+  // Resets the state of |stream|, e.g. when it is reused for a new call.
+  void Reset(size_t stream);
+
+ private:
+  const size_t num_streams_;
+  // The direct form 1 filter state, one element per stream.
+  std::vector<float> x0_;
+  std::vector<float> x1_;
+  std::vector<float> y0_;
+  std::vector<float> y1_;
+};
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
@@ -9,12 +9,15 @@
  */
 #include "modules/audio_processing/high_pass_filter.h"
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/test/audio_buffer_tools.h"
 #include "modules/audio_processing/test/bitexactness_tools.h"
+#include "rtc_base/random.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -298,4 +301,63 @@ TEST(HighPassFilterAccuracyTest, MonoConverged) {
   }
 }
 
+// Verifies that the batched filter produces the same output for each stream as
+// a HighPassFilter that only processes that stream.
+TEST(BatchedHighPassFilterTest, MatchesHighPassFilterForEachStream) {
+  constexpr size_t kNumFrames = 160;
+  for (size_t num_streams : {1, 3, 16}) {
+    BatchedHighPassFilter batched_filter(num_streams);
+    std::vector<std::unique_ptr<HighPassFilter>> filters(num_streams);
+    for (auto& filter : filters) {
+      filter = std::make_unique<HighPassFilter>(1);
+    }
+
+    Random random_generator(42U);
+    std::vector<float> batch(kNumFrames * num_streams);
+    std::vector<std::vector<float>> stream(1, std::vector<float>(kNumFrames));
+    for (int block = 0; block < 10; ++block) {
+      for (float& sample : batch) {
+        sample = 32767.f * (2.f * random_generator.Rand<float>() - 1.f);
+      }
+      std::vector<float> input = batch;
+      batched_filter.Process(batch);
+
+      for (size_t s = 0; s < num_streams; ++s) {
+        for (size_t k = 0; k < kNumFrames; ++k) {
+          stream[0][k] = input[k * num_streams + s];
+        }
+        filters[s]->Process(&stream);
+        for (size_t k = 0; k < kNumFrames; ++k) {
+          EXPECT_FLOAT_EQ(stream[0][k], batch[k * num_streams + s]);
+        }
+      }
+    }
+  }
+}
+
+TEST(BatchedHighPassFilterTest, ResetsOneStream) {
+  constexpr size_t kNumStreams = 2;
+  constexpr size_t kNumFrames = 160;
+  BatchedHighPassFilter batched_filter(kNumStreams);
+  HighPassFilter filter(1);
+
+  std::vector<float> batch(kNumFrames * kNumStreams, 1000.f);
+  batched_filter.Process(batch);
+  std::vector<std::vector<float>> stream(1, std::vector<float>(kNumFrames));
+  std::fill(stream[0].begin(), stream[0].end(), 1000.f);
+  filter.Process(&stream);
+
+  // Only the first stream starts over, the second one continues.
+  batched_filter.Reset(0);
+  filter.Reset();
+  std::fill(batch.begin(), batch.end(), 1000.f);
+  batched_filter.Process(batch);
+  std::fill(stream[0].begin(), stream[0].end(), 1000.f);
+  filter.Process(&stream);
+  for (size_t k = 0; k < kNumFrames; ++k) {
+    EXPECT_FLOAT_EQ(stream[0][k], batch[k * kNumStreams]);
+  }
+  EXPECT_NE(batch[0], batch[1]);
+}
+
 }  // namespace webrtc
@@ -105,7 +105,9 @@ std::string AudioProcessing::Config::ToString() const {
           << " } }, residual_echo_detector: { enabled: "
           << residual_echo_detector.enabled
           << " }, level_estimation: { enabled: " << level_estimation.enabled
-          << " } }";
+          << " }, compute_budget: { enabled: " << compute_budget.enabled
+          << ", max_processing_time_us: "
+          << compute_budget.max_processing_time_us << " } }";
   return builder.str();
 }
 
@@ -377,6 +377,18 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       bool enabled = false;
     } level_estimation;
 
+    // Sheds capture processing stages when processing the capture frames takes
+    // longer than |max_processing_time_us| per 10 ms frame on average, so that
+    // an overloaded CPU degrades the audio quality rather than missing the
+    // real-time deadline. One stage is shed per second of overload, in this
+    // order: the transient suppressor, the length of the AEC3 filters, and
+    // the noise suppressor. Shed stages stay shed until the budget is changed.
+    // The shed stages are reported in webrtc::AudioProcessingStats.
+    struct ComputeBudget {
+      bool enabled = false;
+      int max_processing_time_us = 2000;
+    } compute_budget;
+
     // Explicit copy assignment implementation to avoid issues with memory
     // sanitizer complaints in case of self-assignment.
     // TODO(peah): Add buildflag to ensure that this is only included for memory
@@ -542,6 +554,19 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
   // method, it will trigger an initialization.
   virtual int ProcessStream(AudioFrame* frame) = 0;
 
+  // Like ProcessStream(AudioFrame*), but writes the processed audio to
+  // |output_frame|, in the format given by its |sample_rate_hz_| and
+  // |num_channels_| members, which must be set. |samples_per_channel_| and
+  // |vad_activity_| of |output_frame| are updated, its other members are left
+  // as is. The rate of |input_frame| doesn't need to be a native rate.
+  //
+  // This lets the caller skip a separate resampling of the int16 audio, since
+  // the conversion to the output format is part of the conversion to and from
+  // the float format used for processing. The output must have one channel or
+  // as many channels as the input.
+  virtual int ProcessStream(const AudioFrame& input_frame,
+                            AudioFrame* output_frame) = 0;
+
   // Accepts deinterleaved float audio with the range [-1, 1]. Each element
   // of |src| points to a channel buffer, arranged according to
   // |input_layout|. At output, the channels will be arranged according to
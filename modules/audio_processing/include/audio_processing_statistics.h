@@ -66,6 +66,13 @@ struct RTC_EXPORT AudioProcessingStats {
   // milliseconds and the value is the instantaneous value at the time of the
   // call to |GetStatistics()|.
   absl::optional<int32_t> delay_ms;
+
+  // Capture processing stages that have been shed to keep the processing
+  // within AudioProcessing::Config::ComputeBudget. Only reported if the
+  // budget is enabled.
+  absl::optional<bool> transient_suppression_shed;
+  absl::optional<bool> echo_canceller_filter_shortened;
+  absl::optional<bool> noise_suppression_shed;
 };
 
 }  // namespace webrtc
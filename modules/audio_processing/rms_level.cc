@@ -100,6 +100,19 @@ void RmsLevel::AnalyzeMuted(size_t length) {
   sample_count_ += length;
 }
 
+void RmsLevel::AnalyzeSumSquare(float sum_square, size_t length) {
+  if (length == 0) {
+    return;
+  }
+
+  CheckBlockSize(length);
+  RTC_DCHECK_GE(sum_square, 0.f);
+  sum_square_ += sum_square;
+  sample_count_ += length;
+
+  max_sum_square_ = std::max(max_sum_square_, sum_square);
+}
+
 int RmsLevel::Average() {
   int rms = (sample_count_ == 0) ? RmsLevel::kMinLevelDb
                                  : ComputeRms(sum_square_ / sample_count_);
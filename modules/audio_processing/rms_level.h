@@ -51,6 +51,10 @@ class RmsLevel {
   // a shortcut to avoid some computation.
   void AnalyzeMuted(size_t length);
 
+  // Like Analyze(), for a chunk of |length| samples whose sum of squares has
+  // already been computed, e.g. AudioFrame::SampleLevels::sum_square.
+  void AnalyzeSumSquare(float sum_square, size_t length);
+
   // Computes the RMS level over all data passed to Analyze() since the last
   // call to Average(). The returned value is positive but should be interpreted
   // as negative as per the RFC. It is constrained to [0, 127]. Resets the
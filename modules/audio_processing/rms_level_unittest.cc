@@ -182,4 +182,22 @@ TEST(RmsLevelTest, ResetOnBlockSizeChange) {
   EXPECT_EQ(9, stats.peak);
 }
 
+TEST(RmsLevelTest, AnalyzeSumSquareMatchesAnalyze) {
+  auto x = CreateInt16Sinusoid(1000, INT16_MAX / 4, kSampleRateHz);
+  auto level = RunTest(x);
+  RmsLevel level_sum_square;
+  for (size_t n = 0; n + kBlockSizeSamples <= x.size();
+       n += kBlockSizeSamples) {
+    float sum_square = 0.f;
+    for (size_t k = n; k < n + kBlockSizeSamples; ++k) {
+      sum_square += x[k] * x[k];
+    }
+    level_sum_square.AnalyzeSumSquare(sum_square, kBlockSizeSamples);
+  }
+  auto stats = level->AverageAndPeak();
+  auto stats_sum_square = level_sum_square.AverageAndPeak();
+  EXPECT_EQ(stats.average, stats_sum_square.average);
+  EXPECT_EQ(stats.peak, stats_sum_square.peak);
+}
+
 }  // namespace webrtc
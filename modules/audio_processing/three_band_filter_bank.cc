@@ -35,6 +35,7 @@
 
 #include "modules/audio_processing/three_band_filter_bank.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "rtc_base/checks.h"
@@ -55,6 +56,10 @@ const size_t kSparsity = 4;
 //   3. The computation complexity also increases linearly with |kNumCoeffs|.
 const size_t kNumCoeffs = 4;
 
+// Number of past input samples needed by the polyphase filters, which are
+// delayed by up to |kSparsity| - 1 samples.
+const size_t kMemorySize = kSparsity * (kNumCoeffs - 1) + kSparsity - 1;
+
 // The Matlab code to generate these |kLowpassCoeffs| is:
 //
 // N = kNumBands * kSparsity * kNumCoeffs - 1;
@@ -103,24 +108,38 @@ void Upsample(const float* in, size_t split_length, size_t offset, float* out) {
   }
 }
 
+// Filters |in| with the |kNumCoeffs| coefficients in |coeffs|, upsampled by
+// |kSparsity| and delayed by |delay| samples. |in| starts with |kMemorySize|
+// past samples, followed by the |split_length| ones to filter into |out|. The
+// products are accumulated in the same order as in SparseFIRFilter, so the
+// output is identical, but without any branching on the position in the frame,
+// which lets the compiler vectorize the loop.
+void FilterPolyphaseComponent(const float* coeffs,
+                              size_t delay,
+                              const float* in,
+                              size_t split_length,
+                              float* out) {
+  RTC_DCHECK_LT(delay, kSparsity);
+  for (size_t i = 0; i < split_length; ++i) {
+    float sum = 0.f;
+    for (size_t j = 0; j < kNumCoeffs; ++j) {
+      sum += in[kMemorySize - delay + i - j * kSparsity] * coeffs[j];
+    }
+    out[i] = sum;
+  }
+}
+
 }  // namespace
 
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
 ThreeBandFilterBank::ThreeBandFilterBank(size_t length)
-    : in_buffer_(rtc::CheckedDivExact(length, kNumBands)),
-      out_buffer_(in_buffer_.size()) {
-  for (size_t i = 0; i < kSparsity; ++i) {
-    for (size_t j = 0; j < kNumBands; ++j) {
-      analysis_filters_.push_back(
-          std::unique_ptr<SparseFIRFilter>(new SparseFIRFilter(
-              kLowpassCoeffs[i * kNumBands + j], kNumCoeffs, kSparsity, i)));
-      synthesis_filters_.push_back(
-          std::unique_ptr<SparseFIRFilter>(new SparseFIRFilter(
-              kLowpassCoeffs[i * kNumBands + j], kNumCoeffs, kSparsity, i)));
-    }
-  }
+    : in_buffer_(kMemorySize + rtc::CheckedDivExact(length, kNumBands)),
+      out_buffer_(in_buffer_.size() - kMemorySize),
+      analysis_state_(kNumBands, std::vector<float>(kMemorySize, 0.f)),
+      synthesis_state_(kNumBands * kSparsity,
+                       std::vector<float>(kMemorySize, 0.f)) {
   dct_modulation_.resize(kNumBands * kSparsity);
   for (size_t i = 0; i < dct_modulation_.size(); ++i) {
     dct_modulation_[i].resize(kNumBands);
@@ -139,19 +158,26 @@ ThreeBandFilterBank::~ThreeBandFilterBank() = default;
 //      decomposition of the low-pass prototype filter and upsampled by a factor
 //      of |kSparsity|.
 //   3. Modulating with cosines and accumulating to get the desired band.
+//
+// The |kSparsity| polyphase filters of a branch all filter the same downsampled
+// signal, so they share its past samples.
 void ThreeBandFilterBank::Analysis(const float* in,
                                    size_t length,
                                    float* const* out) {
-  RTC_CHECK_EQ(in_buffer_.size(), rtc::CheckedDivExact(length, kNumBands));
+  RTC_CHECK_EQ(out_buffer_.size(), rtc::CheckedDivExact(length, kNumBands));
   for (size_t i = 0; i < kNumBands; ++i) {
-    memset(out[i], 0, in_buffer_.size() * sizeof(*out[i]));
+    memset(out[i], 0, out_buffer_.size() * sizeof(*out[i]));
   }
   for (size_t i = 0; i < kNumBands; ++i) {
-    Downsample(in, in_buffer_.size(), kNumBands - i - 1, &in_buffer_[0]);
+    std::vector<float>& state = analysis_state_[i];
+    std::copy(state.begin(), state.end(), in_buffer_.begin());
+    Downsample(in, out_buffer_.size(), kNumBands - i - 1,
+               &in_buffer_[kMemorySize]);
+    std::copy(in_buffer_.end() - kMemorySize, in_buffer_.end(), state.begin());
     for (size_t j = 0; j < kSparsity; ++j) {
       const size_t offset = i + j * kNumBands;
-      analysis_filters_[offset]->Filter(&in_buffer_[0], in_buffer_.size(),
-                                        &out_buffer_[0]);
+      FilterPolyphaseComponent(kLowpassCoeffs[offset], j, &in_buffer_[0],
+                               out_buffer_.size(), &out_buffer_[0]);
       DownModulate(&out_buffer_[0], out_buffer_.size(), offset, out);
     }
   }
@@ -166,15 +192,19 @@ void ThreeBandFilterBank::Analysis(const float* in,
 void ThreeBandFilterBank::Synthesis(const float* const* in,
                                     size_t split_length,
                                     float* out) {
-  RTC_CHECK_EQ(in_buffer_.size(), split_length);
-  memset(out, 0, kNumBands * in_buffer_.size() * sizeof(*out));
+  RTC_CHECK_EQ(out_buffer_.size(), split_length);
+  memset(out, 0, kNumBands * split_length * sizeof(*out));
   for (size_t i = 0; i < kNumBands; ++i) {
     for (size_t j = 0; j < kSparsity; ++j) {
       const size_t offset = i + j * kNumBands;
-      UpModulate(in, in_buffer_.size(), offset, &in_buffer_[0]);
-      synthesis_filters_[offset]->Filter(&in_buffer_[0], in_buffer_.size(),
-                                         &out_buffer_[0]);
-      Upsample(&out_buffer_[0], out_buffer_.size(), i, out);
+      std::vector<float>& state = synthesis_state_[offset];
+      std::copy(state.begin(), state.end(), in_buffer_.begin());
+      UpModulate(in, split_length, offset, &in_buffer_[kMemorySize]);
+      std::copy(in_buffer_.end() - kMemorySize, in_buffer_.end(),
+                state.begin());
+      FilterPolyphaseComponent(kLowpassCoeffs[offset], j, &in_buffer_[0],
+                               split_length, &out_buffer_[0]);
+      Upsample(&out_buffer_[0], split_length, i, out);
     }
   }
 }
@@ -12,11 +12,8 @@
 #define MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_H_
 
 #include <cstring>
-#include <memory>
 #include <vector>
 
-#include "common_audio/sparse_fir_filter.h"
-
 namespace webrtc {
 
 // An implementation of a 3-band FIR filter-bank with DCT modulation, similar to
@@ -57,10 +54,13 @@ class ThreeBandFilterBank final {
                   size_t offset,
                   float* out);
 
+  // Input of the polyphase filters, preceded by the past samples they need.
   std::vector<float> in_buffer_;
   std::vector<float> out_buffer_;
-  std::vector<std::unique_ptr<SparseFIRFilter>> analysis_filters_;
-  std::vector<std::unique_ptr<SparseFIRFilter>> synthesis_filters_;
+  // Past input samples of the three analysis branches, which share them across
+  // their polyphase filters, and of each of the synthesis polyphase filters.
+  std::vector<std::vector<float>> analysis_state_;
+  std::vector<std::vector<float>> synthesis_state_;
   std::vector<std::vector<float>> dct_modulation_;
 };
 
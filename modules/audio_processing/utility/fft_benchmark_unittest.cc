@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the cost of the FFT implementations used in APM at the sizes they
+// are used with: OouraFft in AEC3 (128 points), fft4g in the noise suppressor
+// (128 or 256 points) and the transient suppressor (128 to 1024 points), and
+// PFFFT in the RNN VAD.
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "common_audio/third_party/fft4g/fft4g.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "modules/audio_processing/utility/ooura_fft.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr size_t kFftSizes[] = {128, 256, 512, 1024};
+constexpr int kNumFfts = 10000;
+constexpr size_t kNumTests = 20;
+
+void FillWithInput(rtc::ArrayView<float> x) {
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>(static_cast<int>(i * 7919) % 2000 - 1000);
+  }
+}
+
+// Runs |transform|, a forward and an inverse FFT, |kNumFfts| times and logs the
+// average time of one of them. The transforms are not normalized, so each of
+// them starts from a fresh copy of the input to keep the values finite.
+template <typename Transform>
+void Benchmark(const char* name, size_t fft_size, Transform transform) {
+  PerformanceTimer perf_timer(kNumTests);
+  for (size_t k = 0; k < kNumTests; ++k) {
+    perf_timer.StartTimer();
+    for (int i = 0; i < kNumFfts; ++i) {
+      transform();
+    }
+    perf_timer.StopTimer();
+  }
+  RTC_LOG(LS_INFO) << name << ", " << fft_size << " points: "
+                   << (perf_timer.GetDurationAverage(1) / kNumFfts) << " +/- "
+                   << (perf_timer.GetDurationStandardDeviation(1) / kNumFfts)
+                   << " us per forward and inverse FFT";
+}
+
+}  // namespace
+
+TEST(FftBenchmark, DISABLED_OouraFft) {
+  const OouraFft fft;
+  std::array<float, 128> input;
+  std::array<float, 128> x;
+  FillWithInput(input);
+  Benchmark("OouraFft", x.size(), [&] {
+    x = input;
+    fft.Fft(x.data());
+    fft.InverseFft(x.data());
+  });
+}
+
+TEST(FftBenchmark, DISABLED_Fft4g) {
+  for (size_t fft_size : kFftSizes) {
+    std::vector<float> input(fft_size);
+    std::vector<float> x(fft_size);
+    // Work areas, at least as large as fft4g.c asks for. They are initialized
+    // by the first call.
+    std::vector<size_t> ip(2 + fft_size, 0);
+    std::vector<float> w(fft_size / 2);
+    FillWithInput(input);
+    Benchmark("fft4g", fft_size, [&] {
+      x = input;
+      WebRtc_rdft(fft_size, 1, x.data(), ip.data(), w.data());
+      WebRtc_rdft(fft_size, -1, x.data(), ip.data(), w.data());
+    });
+  }
+}
+
+TEST(FftBenchmark, DISABLED_Pffft) {
+  RTC_LOG(LS_INFO) << "PFFFT SIMD enabled: " << Pffft::IsSimdEnabled();
+  for (size_t fft_size : kFftSizes) {
+    Pffft fft(fft_size, Pffft::FftType::kReal);
+    auto input = fft.CreateBuffer();
+    auto x = fft.CreateBuffer();
+    auto y = fft.CreateBuffer();
+    FillWithInput(input->GetView());
+    Benchmark("PFFFT", fft_size, [&] {
+      std::copy(input->GetConstView().begin(), input->GetConstView().end(),
+                x->GetView().begin());
+      fft.ForwardTransform(*x, y.get(), /*ordered=*/true);
+      fft.BackwardTransform(*y, x.get(), /*ordered=*/true);
+    });
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
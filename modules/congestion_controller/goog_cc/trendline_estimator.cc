@@ -68,30 +68,6 @@ size_t ReadTrendlineFilterWindowSize(
   return kDefaultTrendlineWindowSize;
 }
 
-absl::optional<double> LinearFitSlope(
-    const std::deque<std::pair<double, double>>& points) {
-  RTC_DCHECK(points.size() >= 2);
-  // Compute the "center of mass".
-  double sum_x = 0;
-  double sum_y = 0;
-  for (const auto& point : points) {
-    sum_x += point.first;
-    sum_y += point.second;
-  }
-  double x_avg = sum_x / points.size();
-  double y_avg = sum_y / points.size();
-  // Compute the slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2
-  double numerator = 0;
-  double denominator = 0;
-  for (const auto& point : points) {
-    numerator += (point.first - x_avg) * (point.second - y_avg);
-    denominator += (point.first - x_avg) * (point.first - x_avg);
-  }
-  if (denominator == 0)
-    return absl::nullopt;
-  return numerator / denominator;
-}
-
 constexpr double kMaxAdaptOffsetMs = 15.0;
 constexpr double kOverUsingTimeThreshold = 10;
 constexpr int kMinNumDeltas = 60;
@@ -115,6 +91,12 @@ TrendlineEstimator::TrendlineEstimator(
       accumulated_delay_(0),
       smoothed_delay_(0),
       delay_hist_(),
+      regression_origin_(0, 0),
+      sum_x_(0),
+      sum_y_(0),
+      sum_xx_(0),
+      sum_xy_(0),
+      updates_since_recompute_(0),
       k_up_(0.0087),
       k_down_(0.039),
       overusing_time_threshold_(kOverUsingTimeThreshold),
@@ -178,8 +160,13 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
   delay_hist_.push_back(std::make_pair(
       static_cast<double>(arrival_time_ms - first_arrival_time_ms_),
       smoothed_delay_));
-  if (delay_hist_.size() > window_size_)
+  UpdateRegressionSums(delay_hist_.back(), 1);
+  if (delay_hist_.size() > window_size_) {
+    UpdateRegressionSums(delay_hist_.front(), -1);
     delay_hist_.pop_front();
+  }
+  if (++updates_since_recompute_ >= window_size_)
+    RecomputeRegressionSums();
   double trend = prev_trend_;
   if (delay_hist_.size() == window_size_) {
     // Update trend_ if it is possible to fit a line to the data. The delay
@@ -187,13 +174,47 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
     // 0 < trend < 1   ->  the delay increases, queues are filling up
     //   trend == 0    ->  the delay does not change
     //   trend < 0     ->  the delay decreases, queues are being emptied
-    trend = LinearFitSlope(delay_hist_).value_or(trend);
+    trend = LinearFitSlope().value_or(trend);
   }
   BWE_TEST_LOGGING_PLOT(1, "trendline_slope", arrival_time_ms, trend);
 
   Detect(trend, send_delta_ms, arrival_time_ms);
 }
 
+void TrendlineEstimator::UpdateRegressionSums(
+    const std::pair<double, double>& point,
+    double sign) {
+  const double x = point.first - regression_origin_.first;
+  const double y = point.second - regression_origin_.second;
+  sum_x_ += sign * x;
+  sum_y_ += sign * y;
+  sum_xx_ += sign * x * x;
+  sum_xy_ += sign * x * y;
+}
+
+void TrendlineEstimator::RecomputeRegressionSums() {
+  regression_origin_ = delay_hist_.front();
+  sum_x_ = 0;
+  sum_y_ = 0;
+  sum_xx_ = 0;
+  sum_xy_ = 0;
+  for (const auto& point : delay_hist_)
+    UpdateRegressionSums(point, 1);
+  updates_since_recompute_ = 0;
+}
+
+absl::optional<double> TrendlineEstimator::LinearFitSlope() const {
+  RTC_DCHECK(delay_hist_.size() >= 2);
+  // The slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2, with the
+  // sums expanded to be updated one point at a time.
+  const double n = delay_hist_.size();
+  const double numerator = sum_xy_ - sum_x_ * sum_y_ / n;
+  const double denominator = sum_xx_ - sum_x_ * sum_x_ / n;
+  if (denominator == 0)
+    return absl::nullopt;
+  return numerator / denominator;
+}
+
 void TrendlineEstimator::Update(double recv_delta_ms,
                                 double send_delta_ms,
                                 int64_t send_time_ms,
@@ -17,6 +17,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/congestion_controller/goog_cc/delay_increase_detector_interface.h"
@@ -72,6 +73,13 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
 
   void UpdateThreshold(double modified_offset, int64_t now_ms);
 
+  // Adds (|sign| = 1) or removes (|sign| = -1) a point of |delay_hist_| from
+  // the regression sums.
+  void UpdateRegressionSums(const std::pair<double, double>& point,
+                            double sign);
+  void RecomputeRegressionSums();
+  absl::optional<double> LinearFitSlope() const;
+
   // Filtering out small packets. (Intention is to base the detection only
   // on video packets even if we have TWCC sequence number for audio.)
   BweIgnoreSmallPacketsSettings ignore_small_packets_;
@@ -90,6 +98,15 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   double smoothed_delay_;
   // Linear least squares regression.
   std::deque<std::pair<double, double>> delay_hist_;
+  // Sums over the points in |delay_hist_|, relative to |regression_origin_|
+  // to keep them small, which give the slope in constant time. They are
+  // recomputed once per window to keep rounding errors from building up.
+  std::pair<double, double> regression_origin_;
+  double sum_x_;
+  double sum_y_;
+  double sum_xx_;
+  double sum_xy_;
+  size_t updates_since_recompute_;
 
   const double k_up_;
   const double k_down_;
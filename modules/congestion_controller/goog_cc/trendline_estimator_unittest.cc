@@ -148,4 +148,21 @@ TEST_F(TrendlineEstimatorTest, IncludesSmallPacketsByDefault) {
   EXPECT_EQ(count, kPacketCount);  // All packets processed
 }
 
+TEST(TrendlineEstimatorLongRunTest, StaysNormalWithJitter) {
+  const FieldTrialBasedConfig config;
+  TrendlineEstimator estimator(&config, nullptr);
+  // Hours of packet groups, delivered at the sending pace with 1 ms of jitter,
+  // shouldn't make the running regression sums drift.
+  int64_t send_time_ms = 123456789;
+  int64_t recv_time_ms = 987654321;
+  for (int i = 0; i < 1000000; ++i) {
+    const int64_t jitter_ms = i % 2 ? 1 : -1;
+    send_time_ms += 20;
+    recv_time_ms += 20 + jitter_ms;
+    estimator.Update(20 + jitter_ms, 20, send_time_ms, recv_time_ms, 1200,
+                     true);
+    ASSERT_EQ(BandwidthUsage::kBwNormal, estimator.State()) << i;
+  }
+}
+
 }  // namespace webrtc
@@ -42,12 +42,18 @@ PacketResult NetworkPacketFeedbackFromRtpPacketFeedback(
       DataSize::bytes(pf.unacknowledged_data);
   return feedback;
 }
+
+// The history grows on demand up to half the range of the transport sequence
+// number, beyond which feedback can't be unwrapped unambiguously anyway.
+constexpr size_t kMinHistorySize = 1024;
+constexpr size_t kMaxHistorySize = 1 << 15;
 }  // namespace
 const int64_t kNoTimestamp = -1;
 const int64_t kSendTimeHistoryWindowMs = 60000;
 
 TransportFeedbackAdapter::TransportFeedbackAdapter()
     : packet_age_limit_ms_(kSendTimeHistoryWindowMs),
+      history_(kMinHistorySize),
       current_offset_ms_(kNoTimestamp),
       last_timestamp_us_(kNoTimestamp),
       local_net_id_(0),
@@ -91,14 +97,13 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
     packet.long_sequence_number =
         seq_num_unwrapper_.Unwrap(packet.sequence_number);
 
-    while (!history_.empty() &&
-           creation_time.ms() - history_.begin()->second.creation_time_ms >
+    while (history_begin_ != history_end_ &&
+           creation_time.ms() - HistorySlot(history_begin_)->creation_time_ms >
                packet_age_limit_ms_) {
       // TODO(sprang): Warn if erasing (too many) old items?
-      RemoveInFlightPacketBytes(history_.begin()->second);
-      history_.erase(history_.begin());
+      PopOldestPacket();
     }
-    history_.insert(std::make_pair(packet.long_sequence_number, packet));
+    InsertPacket(packet);
   }
 
   {
@@ -116,10 +121,10 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.send_time_ms >= 0;
-      it->second.send_time_ms = sent_packet.send_time_ms;
+    PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+    if (packet) {
+      bool packet_retransmit = packet->send_time_ms >= 0;
+      packet->send_time_ms = sent_packet.send_time_ms;
       last_send_time_ms_ =
           std::max(last_send_time_ms_, sent_packet.send_time_ms);
       // TODO(srte): Don't do this on retransmit.
@@ -129,17 +134,16 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
               << "appending acknowledged data for out of order packet. (Diff: "
               << last_untracked_send_time_ms_ - sent_packet.send_time_ms
               << " ms.)";
-        it->second.unacknowledged_data += pending_untracked_size_;
+        packet->unacknowledged_data += pending_untracked_size_;
         pending_untracked_size_ = 0;
       }
       if (!packet_retransmit) {
-        AddInFlightPacketBytes(it->second);
-        auto packet = it->second;
+        AddInFlightPacketBytes(*packet);
         SentPacket msg;
-        msg.size = DataSize::bytes(packet.payload_size);
-        msg.send_time = Timestamp::ms(packet.send_time_ms);
-        msg.sequence_number = packet.long_sequence_number;
-        msg.prior_unacked_data = DataSize::bytes(packet.unacknowledged_data);
+        msg.size = DataSize::bytes(packet->payload_size);
+        msg.send_time = Timestamp::ms(packet->send_time_ms);
+        msg.sequence_number = packet->long_sequence_number;
+        msg.prior_unacked_data = DataSize::bytes(packet->unacknowledged_data);
         msg.data_in_flight = GetOutstandingData();
         return msg;
       }
@@ -188,10 +192,10 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   }
   {
     rtc::CritScope cs(&lock_);
-    auto it = history_.find(last_ack_seq_num_);
-    if (it != history_.end() &&
-        it->second.send_time_ms != PacketFeedback::kNoSendTime) {
-      msg.first_unacked_send_time = Timestamp::ms(it->second.send_time_ms);
+    const PacketFeedback* first_unacked = FindPacket(last_ack_seq_num_);
+    if (first_unacked &&
+        first_unacked->send_time_ms != PacketFeedback::kNoSendTime) {
+      msg.first_unacked_send_time = Timestamp::ms(first_unacked->send_time_ms);
     }
   }
   msg.feedback_time = feedback_receive_time;
@@ -292,30 +296,103 @@ bool TransportFeedbackAdapter::GetFeedback(PacketFeedback* packet_feedback,
       seq_num_unwrapper_.Unwrap(packet_feedback->sequence_number);
 
   if (acked_seq_num > last_ack_seq_num_) {
-    // Returns history_.begin() if last_ack_seq_num_ < 0, since any valid
-    // sequence number is >= 0.
-    auto unacked_it = history_.lower_bound(last_ack_seq_num_);
-    auto newly_acked_end = history_.upper_bound(acked_seq_num);
-    for (; unacked_it != newly_acked_end; ++unacked_it) {
-      RemoveInFlightPacketBytes(unacked_it->second);
+    for (int64_t seq_num = std::max(last_ack_seq_num_, history_begin_);
+         seq_num <= acked_seq_num && seq_num < history_end_; ++seq_num) {
+      const absl::optional<PacketFeedback>& packet = HistorySlot(seq_num);
+      if (packet)
+        RemoveInFlightPacketBytes(*packet);
     }
     last_ack_seq_num_ = acked_seq_num;
   }
 
-  auto it = history_.find(acked_seq_num);
-  if (it == history_.end())
+  const PacketFeedback* packet = FindPacket(acked_seq_num);
+  if (!packet)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_feedback->arrival_time_ms;
-  *packet_feedback = it->second;
+  *packet_feedback = *packet;
   packet_feedback->arrival_time_ms = arrival_time_ms;
 
   if (remove)
-    history_.erase(it);
+    ErasePacket(acked_seq_num);
   return true;
 }
 
+absl::optional<PacketFeedback>& TransportFeedbackAdapter::HistorySlot(
+    int64_t seq_num) {
+  return history_[static_cast<size_t>(seq_num) & (history_.size() - 1)];
+}
+
+PacketFeedback* TransportFeedbackAdapter::FindPacket(int64_t seq_num) {
+  if (seq_num < history_begin_ || seq_num >= history_end_)
+    return nullptr;
+  absl::optional<PacketFeedback>& packet = HistorySlot(seq_num);
+  return packet ? &*packet : nullptr;
+}
+
+void TransportFeedbackAdapter::InsertPacket(const PacketFeedback& packet) {
+  const int64_t seq_num = packet.long_sequence_number;
+  if (history_begin_ == history_end_) {
+    history_begin_ = seq_num;
+    history_end_ = seq_num;
+  }
+  if (seq_num < history_end_ - static_cast<int64_t>(kMaxHistorySize)) {
+    RTC_LOG(LS_WARNING) << "Packet " << seq_num
+                        << " is too old for the send history.";
+    return;
+  }
+  const int64_t begin = std::min(history_begin_, seq_num);
+  const int64_t end = std::max(history_end_, seq_num + 1);
+  if (end - begin > static_cast<int64_t>(history_.size())) {
+    GrowHistory(static_cast<size_t>(
+        std::min<int64_t>(end - begin, kMaxHistorySize)));
+  }
+  // Make room by dropping the oldest packets once the history can't grow.
+  while (end - history_begin_ > static_cast<int64_t>(history_.size()) &&
+         history_begin_ != history_end_) {
+    PopOldestPacket();
+  }
+  if (history_begin_ == history_end_) {
+    history_begin_ = seq_num;
+    history_end_ = seq_num;
+  }
+
+  absl::optional<PacketFeedback>& slot = HistorySlot(seq_num);
+  if (slot)
+    return;
+  slot = packet;
+  history_begin_ = std::min(history_begin_, seq_num);
+  history_end_ = std::max(history_end_, seq_num + 1);
+}
+
+void TransportFeedbackAdapter::ErasePacket(int64_t seq_num) {
+  HistorySlot(seq_num).reset();
+  // Keep the oldest slot occupied so that it can be checked for age.
+  while (history_begin_ != history_end_ && !HistorySlot(history_begin_))
+    ++history_begin_;
+}
+
+void TransportFeedbackAdapter::PopOldestPacket() {
+  RTC_DCHECK_NE(history_begin_, history_end_);
+  absl::optional<PacketFeedback>& oldest = HistorySlot(history_begin_);
+  if (oldest)
+    RemoveInFlightPacketBytes(*oldest);
+  ErasePacket(history_begin_);
+}
+
+void TransportFeedbackAdapter::GrowHistory(size_t min_size) {
+  size_t size = history_.size();
+  while (size < min_size)
+    size *= 2;
+  std::vector<absl::optional<PacketFeedback>> history(size);
+  for (int64_t seq_num = history_begin_; seq_num < history_end_; ++seq_num) {
+    history[static_cast<size_t>(seq_num) & (size - 1)] =
+        std::move(HistorySlot(seq_num));
+  }
+  history_.swap(history);
+}
+
 void TransportFeedbackAdapter::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
   RTC_DCHECK_NE(packet.send_time_ms, -1);
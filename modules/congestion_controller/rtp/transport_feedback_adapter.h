@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/transport/network_types.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -73,6 +74,16 @@ class TransportFeedbackAdapter {
   // thus be non-null and have the sequence_number field set.
   bool GetFeedback(PacketFeedback* packet_feedback, bool remove)
       RTC_RUN_ON(&lock_);
+  // Send history, indexed by unwrapped sequence number. Returns nullptr if
+  // the packet is not in the history.
+  PacketFeedback* FindPacket(int64_t seq_num) RTC_RUN_ON(&lock_);
+  absl::optional<PacketFeedback>& HistorySlot(int64_t seq_num)
+      RTC_RUN_ON(&lock_);
+  void InsertPacket(const PacketFeedback& packet) RTC_RUN_ON(&lock_);
+  void ErasePacket(int64_t seq_num) RTC_RUN_ON(&lock_);
+  // Drops the oldest packet, or the empty slots before it.
+  void PopOldestPacket() RTC_RUN_ON(&lock_);
+  void GrowHistory(size_t min_size) RTC_RUN_ON(&lock_);
   void AddInFlightPacketBytes(const PacketFeedback& packet) RTC_RUN_ON(&lock_);
   void RemoveInFlightPacketBytes(const PacketFeedback& packet)
       RTC_RUN_ON(&lock_);
@@ -84,7 +95,12 @@ class TransportFeedbackAdapter {
   int64_t last_send_time_ms_ RTC_GUARDED_BY(&lock_) = -1;
   int64_t last_untracked_send_time_ms_ RTC_GUARDED_BY(&lock_) = -1;
   SequenceNumberUnwrapper seq_num_unwrapper_ RTC_GUARDED_BY(&lock_);
-  std::map<int64_t, PacketFeedback> history_ RTC_GUARDED_BY(&lock_);
+  // Ring buffer holding the packets with sequence numbers in
+  // [|history_begin_|, |history_end_|) at index |seq_num| modulo its size,
+  // which is a power of two. Slots outside the range are always empty.
+  std::vector<absl::optional<PacketFeedback>> history_ RTC_GUARDED_BY(&lock_);
+  int64_t history_begin_ RTC_GUARDED_BY(&lock_) = 0;
+  int64_t history_end_ RTC_GUARDED_BY(&lock_) = 0;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
@@ -425,6 +425,44 @@ TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   EXPECT_FALSE(duplicate_packet.has_value());
 }
 
+TEST_F(TransportFeedbackAdapterTest, KeepsUnackedPacketsBeyondInitialHistory) {
+  const int kNumPackets = 5000;
+  const size_t kPayloadSize = 1000;
+  std::vector<PacketFeedback> packets;
+  for (int i = 0; i < kNumPackets; ++i) {
+    packets.push_back(PacketFeedback(i, i + 100, static_cast<uint16_t>(i),
+                                     kPayloadSize, kPacingInfo0));
+    OnSentPacket(packets.back());
+  }
+  EXPECT_EQ(DataSize::bytes(kNumPackets * kPayloadSize),
+            adapter_->GetOutstandingData());
+
+  // Acking the newest packet takes all packets out of flight.
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(packets.back().sequence_number,
+                   packets.back().arrival_time_ms * 1000);
+  EXPECT_TRUE(feedback.AddReceivedPacket(
+      packets.back().sequence_number, packets.back().arrival_time_ms * 1000));
+  feedback.Build();
+  adapter_->ProcessTransportFeedback(
+      feedback, Timestamp::ms(clock_.TimeInMilliseconds()));
+  EXPECT_EQ(DataSize::Zero(), adapter_->GetOutstandingData());
+
+  // The oldest, unacked, packet is still in the history.
+  PacketFeedback late_packet = packets.front();
+  late_packet.arrival_time_ms = packets.back().arrival_time_ms + 100;
+  rtcp::TransportFeedback late_feedback;
+  late_feedback.SetBase(late_packet.sequence_number,
+                        late_packet.arrival_time_ms * 1000);
+  EXPECT_TRUE(late_feedback.AddReceivedPacket(
+      late_packet.sequence_number, late_packet.arrival_time_ms * 1000));
+  late_feedback.Build();
+  adapter_->ProcessTransportFeedback(
+      late_feedback, Timestamp::ms(clock_.TimeInMilliseconds()));
+  ComparePacketFeedbackVectors({late_packet},
+                               adapter_->GetTransportFeedbackVector());
+}
+
 }  // namespace test
 }  // namespace webrtc_cc
 }  // namespace webrtc
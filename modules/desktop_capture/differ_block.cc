@@ -16,6 +16,10 @@
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
+#if defined(WEBRTC_HAS_AVX2)
+#include "modules/desktop_capture/differ_vector_avx2.h"
+#endif
+
 namespace webrtc {
 
 namespace {
@@ -35,14 +39,25 @@ bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
     // TODO(hclam): Implement a NEON version.
     diff_proc = &VectorDifference_C;
 #else
+#if defined(WEBRTC_HAS_AVX2)
+    // Prefer AVX2, which compares a 32 pixel vector in four loads.
+    bool have_avx2 = WebRtc_GetCPUInfo(kAVX2) != 0;
+    if (have_avx2 && kBlockSize == 32) {
+      diff_proc = &VectorDifference_AVX2_W32;
+    } else if (have_avx2 && kBlockSize == 16) {
+      diff_proc = &VectorDifference_AVX2_W16;
+    }
+#endif
     bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
-      diff_proc = &VectorDifference_SSE2_W32;
-    } else if (have_sse2 && kBlockSize == 16) {
-      diff_proc = &VectorDifference_SSE2_W16;
-    } else {
-      diff_proc = &VectorDifference_C;
+    if (!diff_proc) {
+      // For x86 processors, check if SSE2 is supported.
+      if (have_sse2 && kBlockSize == 32) {
+        diff_proc = &VectorDifference_SSE2_W32;
+      } else if (have_sse2 && kBlockSize == 16) {
+        diff_proc = &VectorDifference_SSE2_W16;
+      } else {
+        diff_proc = &VectorDifference_C;
+      }
     }
 #endif
   }
@@ -86,4 +86,19 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(VectorDifferenceTestEachByte, VectorDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  // A change of any byte of the vector is found, whichever lane of the vector
+  // unit it falls in.
+  EXPECT_FALSE(VectorDifference(block1, block2));
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+    block2[i] ^= 0x80;
+    EXPECT_TRUE(VectorDifference(block1, block2)) << "byte " << i;
+    block2[i] ^= 0x80;
+  }
+}
+
 }  // namespace webrtc
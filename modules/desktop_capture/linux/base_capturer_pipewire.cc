@@ -17,6 +17,7 @@
 #include <spa/param/video/raw-utils.h>
 #include <spa/support/type-map.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -402,26 +403,31 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   }
   RTC_DCHECK(current_frame_ != nullptr);
 
+  // Only the rows of the frame are read by CaptureFrame(), so copy those
+  // rather than the whole buffer, which may be larger.
+  const uint32_t frameSize = std::min<uint32_t>(
+      maxSize, static_cast<uint32_t>(srcStride) * desktop_size_.height());
+
   // If both sides decided to go with the RGBx format we need to convert it to
   // BGRx to match color format expected by WebRTC.
   if (spa_video_format_->format == pw_type_->video_format.RGBx) {
-    uint8_t* tempFrame = static_cast<uint8_t*>(malloc(maxSize));
-    std::memcpy(tempFrame, src, maxSize);
-    ConvertRGBxToBGRx(tempFrame, maxSize);
-    std::memcpy(current_frame_, tempFrame, maxSize);
-    free(tempFrame);
+    ConvertRGBxToBGRx(static_cast<const uint8_t*>(src), current_frame_,
+                      frameSize);
   } else {
-    std::memcpy(current_frame_, src, maxSize);
+    std::memcpy(current_frame_, src, frameSize);
   }
 }
 
-void BaseCapturerPipeWire::ConvertRGBxToBGRx(uint8_t* frame, uint32_t size) {
-  // Change color format for KDE KWin which uses RGBx and not BGRx
+void BaseCapturerPipeWire::ConvertRGBxToBGRx(const uint8_t* src,
+                                             uint8_t* dst,
+                                             uint32_t size) {
+  // Change color format for KDE KWin which uses RGBx and not BGRx. Done while
+  // copying, so that the frame is only read and written once.
   for (uint32_t i = 0; i < size; i += 4) {
-    uint8_t tempR = frame[i];
-    uint8_t tempB = frame[i + 2];
-    frame[i] = tempB;
-    frame[i + 2] = tempR;
+    dst[i] = src[i + 2];
+    dst[i + 1] = src[i + 1];
+    dst[i + 2] = src[i];
+    dst[i + 3] = src[i + 3];
   }
 }
 
@@ -868,6 +874,11 @@ void BaseCapturerPipeWire::CaptureFrame() {
     return;
   }
 
+  // The PipeWire stream does not tell which part of the frame changed, so mark
+  // the whole frame. DesktopCapturerDifferWrapper narrows it down, if used.
+  result->mutable_updated_region()->SetRect(
+      DesktopRect::MakeSize(result->size()));
+
   // TODO(julien.isorce): http://crbug.com/945468. Set the icc profile on the
   // frame, see ScreenCapturerX11::CaptureFrame.
 
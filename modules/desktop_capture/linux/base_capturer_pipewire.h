@@ -94,7 +94,7 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   void CreateReceivingStream();
   void HandleBuffer(pw_buffer* buffer);
 
-  void ConvertRGBxToBGRx(uint8_t* frame, uint32_t size);
+  void ConvertRGBxToBGRx(const uint8_t* src, uint8_t* dst, uint32_t size);
 
   static void OnStateChanged(void* data,
                              pw_remote_state old_state,
@@ -179,7 +179,19 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
   if (error.Error() == S_OK && frame_info.AccumulatedFrames > 0 && resource) {
     DetectUpdatedRegion(frame_info, &context->updated_region);
     SpreadContextChange(context);
-    if (!texture_->CopyFrom(frame_info, resource.Get())) {
+    // The |texture_| is not rotated, so neither is the part of it to copy.
+    DesktopRegion texture_updated_region;
+    if (rotation_ != Rotation::CLOCK_WISE_0) {
+      for (DesktopRegion::Iterator it(context->updated_region); !it.IsAtEnd();
+           it.Advance()) {
+        texture_updated_region.AddRect(
+            RotateRect(it.rect(), desktop_size(), ReverseRotation(rotation_)));
+      }
+    } else {
+      texture_updated_region = context->updated_region;
+    }
+    if (!texture_->CopyFrom(frame_info, resource.Get(),
+                            texture_updated_region)) {
       return false;
     }
     updated_region.AddRegion(context->updated_region);
@@ -33,9 +33,12 @@ class DxgiTexture {
   virtual ~DxgiTexture();
 
   // Copies selected regions of a frame represented by frame_info and resource.
-  // Returns false if anything wrong.
+  // |updated_region| is the part of the texture that changed since the
+  // previous frame, in texture coordinates; implementations that keep the
+  // previous frame may copy only that part. Returns false if anything wrong.
   bool CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                IDXGIResource* resource);
+                IDXGIResource* resource,
+                const DesktopRegion& updated_region);
 
   const DesktopSize& desktop_size() const { return desktop_size_; }
 
@@ -58,7 +61,8 @@ class DxgiTexture {
   DXGI_MAPPED_RECT* rect();
 
   virtual bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                               ID3D11Texture2D* texture) = 0;
+                               ID3D11Texture2D* texture,
+                               const DesktopRegion& updated_region) = 0;
 
   virtual bool DoRelease() = 0;
 
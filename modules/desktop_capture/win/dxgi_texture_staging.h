@@ -40,8 +40,10 @@ class DxgiTextureStaging : public DxgiTexture {
  protected:
   // Copies selected regions of a frame represented by frame_info and texture.
   // Returns false if anything wrong.
+  // Only |updated_region| is copied if |stage_| holds the previous frame.
   bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                       ID3D11Texture2D* texture) override;
+                       ID3D11Texture2D* texture,
+                       const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -61,6 +63,9 @@ class DxgiTextureStaging : public DxgiTexture {
   const D3dDevice device_;
   Microsoft::WRL::ComPtr<ID3D11Texture2D> stage_;
   Microsoft::WRL::ComPtr<IDXGISurface> surface_;
+  // Whether |stage_| holds the previous frame, so that only the updated region
+  // of the next one needs to be copied to it.
+  bool stage_has_frame_ = false;
 };
 
 }  // namespace webrtc
@@ -24,13 +24,23 @@ IntervalBudget::IntervalBudget(int initial_target_rate_kbps)
 
 IntervalBudget::IntervalBudget(int initial_target_rate_kbps,
                                bool can_build_up_underuse)
-    : bytes_remaining_(0), can_build_up_underuse_(can_build_up_underuse) {
+    : IntervalBudget(initial_target_rate_kbps,
+                     can_build_up_underuse,
+                     kWindowMs) {}
+
+IntervalBudget::IntervalBudget(int initial_target_rate_kbps,
+                               bool can_build_up_underuse,
+                               int64_t window_ms)
+    : window_ms_(window_ms),
+      bytes_remaining_(0),
+      can_build_up_underuse_(can_build_up_underuse) {
+  RTC_DCHECK_GT(window_ms, 0);
   set_target_rate_kbps(initial_target_rate_kbps);
 }
 
 void IntervalBudget::set_target_rate_kbps(int target_rate_kbps) {
   target_rate_kbps_ = target_rate_kbps;
-  max_bytes_in_budget_ = (kWindowMs * target_rate_kbps_) / 8;
+  max_bytes_in_budget_ = (window_ms_ * target_rate_kbps_) / 8;
   bytes_remaining_ = std::min(std::max(-max_bytes_in_budget_, bytes_remaining_),
                               max_bytes_in_budget_);
 }
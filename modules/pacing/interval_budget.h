@@ -22,6 +22,11 @@ class IntervalBudget {
  public:
   explicit IntervalBudget(int initial_target_rate_kbps);
   IntervalBudget(int initial_target_rate_kbps, bool can_build_up_underuse);
+  // Limits the budget, and the overuse, to what the target rate gives in
+  // |window_ms| instead of the default 500 ms.
+  IntervalBudget(int initial_target_rate_kbps,
+                 bool can_build_up_underuse,
+                 int64_t window_ms);
   void set_target_rate_kbps(int target_rate_kbps);
 
   // TODO(tschumim): Unify IncreaseBudget and UseBudget to one function.
@@ -33,6 +38,7 @@ class IntervalBudget {
   int target_rate_kbps() const;
 
  private:
+  const int64_t window_ms_;
   int target_rate_kbps_;
   int64_t max_bytes_in_budget_;
   int64_t bytes_remaining_;
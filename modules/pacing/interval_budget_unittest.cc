@@ -120,4 +120,19 @@ TEST(IntervalBudgetTest, CanNotBuildUpUnderuseWhenConfigured) {
             TimeToBytes(kBitrateKbps, delta_time_ms));
 }
 
+TEST(IntervalBudgetTest, DontBuildUpUnderuseMoreThanConfiguredWindow) {
+  constexpr int64_t kShortWindowMs = 40;
+  IntervalBudget interval_budget(kBitrateKbps, kCanBuildUpUnderuse,
+                                 kShortWindowMs);
+  interval_budget.IncreaseBudget(30);
+  interval_budget.IncreaseBudget(30);
+  EXPECT_DOUBLE_EQ(interval_budget.budget_ratio(), 1.0);
+  EXPECT_EQ(interval_budget.bytes_remaining(),
+            TimeToBytes(kBitrateKbps, kShortWindowMs));
+
+  // Overuse is limited by the same window.
+  interval_budget.UseBudget(TimeToBytes(kBitrateKbps, 3 * kShortWindowMs));
+  EXPECT_DOUBLE_EQ(interval_budget.budget_ratio(), -1.0);
+}
+
 }  // namespace webrtc
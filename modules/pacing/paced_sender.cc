@@ -24,6 +24,18 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+
+bool IsIdleSleepEnabled(const WebRtcKeyValueConfig* field_trials) {
+  constexpr char kIdleSleepFieldTrial[] = "WebRTC-Pacer-IdleSleep";
+  if (field_trials)
+    return field_trials->Lookup(kIdleSleepFieldTrial).find("Enabled") == 0;
+  return FieldTrialBasedConfig().Lookup(kIdleSleepFieldTrial).find(
+             "Enabled") == 0;
+}
+
+}  // namespace
+
 const int64_t PacedSender::kMaxQueueLengthMs = 2000;
 const float PacedSender::kDefaultPaceMultiplier = 2.5f;
 
@@ -37,7 +49,8 @@ PacedSender::PacedSender(Clock* clock,
                          event_log,
                          field_trials),
       packet_router_(packet_router),
-      process_thread_(process_thread) {
+      process_thread_(process_thread),
+      idle_sleep_(IsIdleSleepEnabled(field_trials)) {
   if (process_thread_)
     process_thread_->RegisterModule(&module_proxy_, RTC_FROM_HERE);
 }
@@ -87,16 +100,34 @@ void PacedSender::UpdateOutstandingData(DataSize outstanding_data) {
 }
 
 void PacedSender::SetPacingRates(DataRate pacing_rate, DataRate padding_rate) {
-  rtc::CritScope cs(&critsect_);
-  pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
+  bool wake_up;
+  {
+    rtc::CritScope cs(&critsect_);
+    bool was_idle = pacing_controller_.IsIdle();
+    pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
+    wake_up = idle_sleep_ && was_idle && !pacing_controller_.IsIdle();
+  }
+
+  // Padding was enabled while sleeping, process right away.
+  if (wake_up && process_thread_)
+    process_thread_->WakeUp(&module_proxy_);
 }
 
 void PacedSender::EnqueuePackets(
     std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
-  rtc::CritScope cs(&critsect_);
-  for (auto& packet : packets) {
-    pacing_controller_.EnqueuePacket(std::move(packet));
+  bool wake_up;
+  {
+    rtc::CritScope cs(&critsect_);
+    wake_up = idle_sleep_ && !packets.empty() && pacing_controller_.IsIdle();
+    for (auto& packet : packets) {
+      pacing_controller_.EnqueuePacket(std::move(packet));
+    }
   }
+
+  // The process thread may be sleeping for a long time while idle, make sure
+  // the new packets are sent without waiting for that.
+  if (wake_up && process_thread_)
+    process_thread_->WakeUp(&module_proxy_);
 }
 
 void PacedSender::SetAccountForAudioPackets(bool account_for_audio) {
@@ -141,6 +172,15 @@ int64_t PacedSender::TimeUntilNextProcess() {
     return next_probe->ms();
   }
 
+  // Nothing to send, sleep until woken up by EnqueuePackets() or
+  // SetPacingRates(). Still process every 500 ms, like when paused, so that
+  // keep-alive packets are not delayed.
+  if (idle_sleep_ && pacing_controller_.IsIdle()) {
+    return std::max(PacingController::kPausedProcessInterval - elapsed_time,
+                    TimeDelta::Zero())
+        .ms();
+  }
+
   const TimeDelta min_packet_limit = TimeDelta::ms(5);
   return std::max(min_packet_limit - elapsed_time, TimeDelta::Zero()).ms();
 }
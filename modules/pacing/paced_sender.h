@@ -167,6 +167,12 @@ class PacedSender : public Module,
 
   PacketRouter* const packet_router_;
   ProcessThread* const process_thread_;
+
+  // If set, the process thread is not woken up every 5 ms while there is
+  // nothing to send. Instead it is woken up when packets are enqueued or
+  // padding is enabled. This matters when many pacers share a thread, see
+  // ProcessThreadPool.
+  const bool idle_sleep_;
 };
 }  // namespace webrtc
 #endif  // MODULES_PACING_PACED_SENDER_H_
@@ -115,5 +115,36 @@ TEST(PacedSenderTest, PacesPackets) {
   EXPECT_GT(duration, TimeDelta::ms(900));
 }
 
+TEST(PacedSenderTest, SleepsWhileIdleWithIdleSleepEnabled) {
+  ScopedFieldTrials field_trials("WebRTC-Pacer-IdleSleep/Enabled/");
+  SimulatedClock clock(0);
+  MockCallback callback;
+  MockProcessThread process_thread;
+  Module* paced_module = nullptr;
+  EXPECT_CALL(process_thread, RegisterModule(_, _))
+      .WillOnce(SaveArg<0>(&paced_module));
+  PacedSender pacer(&clock, &callback, nullptr, nullptr, &process_thread);
+  EXPECT_CALL(process_thread, DeRegisterModule(paced_module)).Times(1);
+  pacer.SetPacingRates(DataRate::kbps(300), DataRate::Zero());
+
+  // Nothing to send, don't wake up every 5 ms.
+  EXPECT_EQ(paced_module->TimeUntilNextProcess(),
+            PacingController::kPausedProcessInterval.ms());
+
+  // Enqueueing a packet wakes up the process thread and resumes regular
+  // processing.
+  EXPECT_CALL(process_thread, WakeUp(paced_module)).Times(1);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.emplace_back(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
+  pacer.EnqueuePackets(std::move(packets));
+  EXPECT_LE(paced_module->TimeUntilNextProcess(), 5);
+
+  EXPECT_CALL(callback, SendPacket).Times(1);
+  clock.AdvanceTimeMilliseconds(paced_module->TimeUntilNextProcess());
+  paced_module->Process();
+  EXPECT_EQ(paced_module->TimeUntilNextProcess(),
+            PacingController::kPausedProcessInterval.ms());
+}
+
 }  // namespace test
 }  // namespace webrtc
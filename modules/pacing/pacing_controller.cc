@@ -22,6 +22,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
@@ -36,6 +37,22 @@ constexpr TimeDelta kMaxProcessingInterval = TimeDelta::Millis<30>();
 
 constexpr int kFirstPriority = 0;
 
+constexpr int kMinRequiredQueueDelaySamples = 200;
+
+// Names of the queue delay histograms, nullptr for padding which is never
+// queued for long.
+constexpr const char* kQueueDelayHistogramNames[] = {
+    "WebRTC.Pacer.QueueDelayInMs.Audio",           // kAudio
+    "WebRTC.Pacer.QueueDelayInMs.Video",           // kVideo
+    "WebRTC.Pacer.QueueDelayInMs.Retransmission",  // kRetransmission
+    "WebRTC.Pacer.QueueDelayInMs.Fec",             // kForwardErrorCorrection
+    nullptr,                                       // kPadding
+};
+static_assert(sizeof(kQueueDelayHistogramNames) /
+                      sizeof(kQueueDelayHistogramNames[0]) ==
+                  PacingController::kNumPacketTypes,
+              "Every packet type needs a histogram name.");
+
 bool IsDisabled(const WebRtcKeyValueConfig& field_trials,
                 absl::string_view key) {
   return field_trials.Lookup(key).find("Disabled") == 0;
@@ -46,6 +63,19 @@ bool IsEnabled(const WebRtcKeyValueConfig& field_trials,
   return field_trials.Lookup(key).find("Enabled") == 0;
 }
 
+// The media budget is allowed to build up while there is headroom, so that
+// e.g. a key frame can be sent in a burst of up to |max_burst_ms| at the
+// pacing rate. Zero keeps the default behaviour where budget that is not used
+// in an interval is lost.
+IntervalBudget CreateMediaBudget(const WebRtcKeyValueConfig& field_trials) {
+  FieldTrialParameter<int> max_burst_ms("", 0);
+  ParseFieldTrial({&max_burst_ms},
+                  field_trials.Lookup("WebRTC-Pacer-MaxBurstMs"));
+  if (max_burst_ms.Get() <= 0)
+    return IntervalBudget(0);
+  return IntervalBudget(0, /*can_build_up_underuse=*/true, max_burst_ms.Get());
+}
+
 int GetPriorityForType(RtpPacketToSend::Type type) {
   // Lower number takes priority over higher.
   switch (type) {
@@ -75,6 +105,7 @@ const TimeDelta PacingController::kMaxExpectedQueueLength =
 const float PacingController::kDefaultPaceMultiplier = 2.5f;
 const TimeDelta PacingController::kPausedProcessInterval =
     kCongestedPacketInterval;
+constexpr size_t PacingController::kNumPacketTypes;
 
 PacingController::PacingController(Clock* clock,
                                    PacketSender* packet_sender,
@@ -95,7 +126,7 @@ PacingController::PacingController(Clock* clock,
       min_packet_limit_(kDefaultMinPacketLimit),
       last_timestamp_(clock_->CurrentTime()),
       paused_(false),
-      media_budget_(0),
+      media_budget_(CreateMediaBudget(*field_trials_)),
       padding_budget_(0),
       prober_(*field_trials_),
       probing_send_failure_(false),
@@ -120,7 +151,17 @@ PacingController::PacingController(Clock* clock,
   UpdateBudgetWithElapsedTime(min_packet_limit_);
 }
 
-PacingController::~PacingController() = default;
+PacingController::~PacingController() {
+  for (size_t type = 0; type < kNumPacketTypes; ++type) {
+    if (!kQueueDelayHistogramNames[type])
+      continue;
+    absl::optional<int> avg_ms =
+        queue_delay_ms_counters_[type].Avg(kMinRequiredQueueDelaySamples);
+    if (avg_ms)
+      RTC_HISTOGRAM_COUNTS_SPARSE_10000(kQueueDelayHistogramNames[type],
+                                        *avg_ms);
+  }
+}
 
 void PacingController::CreateProbeCluster(DataRate bitrate, int cluster_id) {
   prober_.CreateProbeCluster(bitrate.bps(), CurrentTime().ms(), cluster_id);
@@ -159,6 +200,12 @@ bool PacingController::Congested() const {
   return false;
 }
 
+bool PacingController::IsIdle() const {
+  return packet_queue_.Empty() && !prober_.IsProbing() &&
+         padding_budget_.target_rate_kbps() == 0 && !send_padding_if_silent_ &&
+         !Congested();
+}
+
 Timestamp PacingController::CurrentTime() const {
   Timestamp time = clock_->CurrentTime();
   if (time < last_timestamp_) {
@@ -305,7 +352,7 @@ void PacingController::ProcessPackets() {
           DataSize::bytes(packet->payload_size() + packet->padding_size());
       packet_sender_->SendRtpPacket(std::move(packet), PacedPacketInfo());
     }
-    OnPaddingSent(keepalive_data_sent);
+    OnPaddingSent(keepalive_data_sent, now);
   }
 
   if (paused_)
@@ -318,7 +365,7 @@ void PacingController::ProcessPackets() {
       // Assuming equal size packets and input/output rate, the average packet
       // has avg_time_left_ms left to get queue_size_bytes out of the queue, if
       // time constraint shall be met. Determine bitrate needed for that.
-      packet_queue_.UpdateQueueTime(CurrentTime());
+      packet_queue_.UpdateQueueTime(now);
       if (drain_large_queues_) {
         TimeDelta avg_time_left =
             std::max(TimeDelta::ms(1),
@@ -394,7 +441,9 @@ void PacingController::ProcessPackets() {
 
     data_sent += packet->size();
     // Send succeeded, remove it from the queue.
-    OnPacketSent(packet);
+    // The clock is read once per process call; packets sent in the same call
+    // are all accounted at its start.
+    OnPacketSent(packet, now);
     if (recommended_probe_size && data_sent > *recommended_probe_size)
       break;
   }
@@ -458,11 +507,13 @@ RoundRobinPacketQueue::QueuedPacket* PacingController::GetPendingPacket(
 }
 
 void PacingController::OnPacketSent(
-    RoundRobinPacketQueue::QueuedPacket* packet) {
-  Timestamp now = CurrentTime();
+    RoundRobinPacketQueue::QueuedPacket* packet,
+    Timestamp now) {
   if (!first_sent_packet_time_) {
     first_sent_packet_time_ = now;
   }
+  queue_delay_ms_counters_[static_cast<size_t>(packet->type())].Add(
+      static_cast<int>((now - packet->enqueue_time()).ms()));
   bool audio_packet = packet->type() == RtpPacketToSend::Type::kAudio;
   if (!audio_packet || account_for_audio_) {
     // Update media bytes sent.
@@ -474,13 +525,13 @@ void PacingController::OnPacketSent(
   padding_failure_state_ = false;
 }
 
-void PacingController::OnPaddingSent(DataSize data_sent) {
+void PacingController::OnPaddingSent(DataSize data_sent, Timestamp now) {
   if (data_sent > DataSize::Zero()) {
     UpdateBudgetWithSentData(data_sent);
   } else {
     padding_failure_state_ = true;
   }
-  last_send_time_ = CurrentTime();
+  last_send_time_ = now;
 }
 
 void PacingController::UpdateBudgetWithElapsedTime(TimeDelta delta) {
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <vector>
@@ -32,6 +33,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/numerics/sample_counter.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -68,6 +70,8 @@ class PacingController {
   // order to send a keep-alive packet so we don't get stuck in a bad state due
   // to lack of feedback.
   static const TimeDelta kPausedProcessInterval;
+  static constexpr size_t kNumPacketTypes =
+      static_cast<size_t>(RtpPacketToSend::Type::kPadding) + 1;
 
   PacingController(Clock* clock,
                    PacketSender* packet_sender,
@@ -134,6 +138,11 @@ class PacingController {
 
   bool Congested() const;
 
+  // Returns true if ProcessPackets() has nothing to do until a new packet is
+  // enqueued: the queue is empty, and no probing, padding or keep-alive
+  // packets are due.
+  bool IsIdle() const;
+
  private:
   void EnqueuePacketInternal(std::unique_ptr<RtpPacketToSend> packet,
                              int priority);
@@ -149,8 +158,9 @@ class PacingController {
 
   RoundRobinPacketQueue::QueuedPacket* GetPendingPacket(
       const PacedPacketInfo& pacing_info);
-  void OnPacketSent(RoundRobinPacketQueue::QueuedPacket* packet);
-  void OnPaddingSent(DataSize padding_sent);
+  void OnPacketSent(RoundRobinPacketQueue::QueuedPacket* packet,
+                    Timestamp now);
+  void OnPaddingSent(DataSize padding_sent, Timestamp now);
 
   Timestamp CurrentTime() const;
 
@@ -195,6 +205,10 @@ class PacingController {
 
   TimeDelta queue_time_limit;
   bool account_for_audio_;
+
+  // Time packets spent in the queue, per RtpPacketToSend::Type. Reported as
+  // histograms when destroyed.
+  std::array<rtc::SampleCounter, kNumPacketTypes> queue_delay_ms_counters_;
 };
 }  // namespace webrtc
 
@@ -20,6 +20,7 @@
 #include "api/units/data_rate.h"
 #include "modules/pacing/packet_router.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -396,6 +397,86 @@ TEST_F(PacingControllerFieldTrialTest, BudgetDoesNotAffectAudioInTrial) {
   ProcessNext(&pacer);
 }
 
+TEST_F(PacingControllerFieldTrialTest, DefaultUnusedBudgetIsLost) {
+  PacingController pacer(&clock_, &callback_, nullptr, nullptr);
+  pacer.SetPacingRates(
+      DataRate::bps(video.packet_size * 8 * kProcessIntervalsPerSecond),
+      DataRate::Zero());
+  InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback_, SendPacket).Times(1);
+  ProcessNext(&pacer);
+  for (int i = 0; i < 10; ++i)
+    ProcessNext(&pacer);
+  ::testing::Mock::VerifyAndClearExpectations(&callback_);
+
+  // A burst is paced out at one packet per process interval.
+  for (int i = 0; i < 5; ++i)
+    InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback_, SendPacket).Times(1);
+  ProcessNext(&pacer);
+}
+
+TEST_F(PacingControllerFieldTrialTest, SendsBurstWithMaxBurstTrial) {
+  ScopedFieldTrials trial("WebRTC-Pacer-MaxBurstMs/40/");
+  PacingController pacer(&clock_, &callback_, nullptr, nullptr);
+  pacer.SetPacingRates(
+      DataRate::bps(video.packet_size * 8 * kProcessIntervalsPerSecond),
+      DataRate::Zero());
+  InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback_, SendPacket).Times(1);
+  ProcessNext(&pacer);
+  for (int i = 0; i < 10; ++i)
+    ProcessNext(&pacer);
+  ::testing::Mock::VerifyAndClearExpectations(&callback_);
+
+  // The budget built up while idle, limited to 40 ms at the pacing rate, is
+  // used to send the burst at once.
+  for (int i = 0; i < 10; ++i)
+    InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback_, SendPacket).Times(8);
+  ProcessNext(&pacer);
+}
+
+TEST_F(PacingControllerFieldTrialTest, ReportsQueueDelayPerPacketType) {
+  metrics::Reset();
+  {
+    PacingController pacer(&clock_, &callback_, nullptr, nullptr);
+    pacer.SetPacingRates(DataRate::bps(10000000), DataRate::Zero());
+    EXPECT_CALL(callback_, SendPacket).Times(200);
+    for (int i = 0; i < 200; ++i) {
+      InsertPacket(&pacer, &video);
+      ProcessNext(&pacer);
+    }
+  }
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Pacer.QueueDelayInMs.Video", 5));
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Pacer.QueueDelayInMs.Audio"));
+}
+
+TEST(PacingControllerClockTest, ReadsClockOncePerProcessCall) {
+  class CountingClock : public SimulatedClock {
+   public:
+    using SimulatedClock::SimulatedClock;
+    Timestamp CurrentTime() override {
+      ++reads_;
+      return SimulatedClock::CurrentTime();
+    }
+    int reads_ = 0;
+  };
+  CountingClock clock(123456);
+  ::testing::NiceMock<MockPacingControllerCallback> callback;
+  PacingController pacer(&clock, &callback, nullptr, nullptr);
+  pacer.SetPacingRates(DataRate::bps(10000000), DataRate::Zero());
+  for (uint16_t i = 0; i < 10; ++i) {
+    pacer.EnqueuePacket(BuildPacket(RtpPacketToSend::Type::kVideo, 12345, i,
+                                    clock.TimeInMilliseconds(), 250));
+  }
+  clock.AdvanceTimeMilliseconds(5);
+  clock.reads_ = 0;
+  EXPECT_CALL(callback, SendPacket).Times(10);
+  pacer.ProcessPackets();
+  EXPECT_EQ(1, clock.reads_);
+}
+
 TEST_F(PacingControllerTest, FirstSentPacketTimeIsSet) {
   uint16_t sequence_number = 1234;
   const uint32_t kSsrc = 12345;
@@ -62,6 +62,13 @@ void PacketRouter::AddSendRtpModule(RtpRtcp* rtp_module, bool remb_candidate) {
   } else {
     rtp_send_modules_.push_back(rtp_module);
   }
+  AddSendRtpModuleToMap(rtp_module, rtp_module->SSRC());
+  if (absl::optional<uint32_t> rtx_ssrc = rtp_module->RtxSsrc()) {
+    AddSendRtpModuleToMap(rtp_module, *rtx_ssrc);
+  }
+  if (absl::optional<uint32_t> flexfec_ssrc = rtp_module->FlexfecSsrc()) {
+    AddSendRtpModuleToMap(rtp_module, *flexfec_ssrc);
+  }
 
   if (remb_candidate) {
     AddRembModuleCandidate(rtp_module, /* media_sender = */ true);
@@ -70,12 +77,18 @@ void PacketRouter::AddSendRtpModule(RtpRtcp* rtp_module, bool remb_candidate) {
 
 void PacketRouter::RemoveSendRtpModule(RtpRtcp* rtp_module) {
   rtc::CritScope cs(&modules_crit_);
-  rtp_module_cache_map_.clear();
   MaybeRemoveRembModuleCandidate(rtp_module, /* media_sender = */ true);
   auto it =
       std::find(rtp_send_modules_.begin(), rtp_send_modules_.end(), rtp_module);
   RTC_DCHECK(it != rtp_send_modules_.end());
   rtp_send_modules_.erase(it);
+  RemoveSendRtpModuleFromMap(rtp_module->SSRC());
+  if (absl::optional<uint32_t> rtx_ssrc = rtp_module->RtxSsrc()) {
+    RemoveSendRtpModuleFromMap(*rtx_ssrc);
+  }
+  if (absl::optional<uint32_t> flexfec_ssrc = rtp_module->FlexfecSsrc()) {
+    RemoveSendRtpModuleFromMap(*flexfec_ssrc);
+  }
   if (last_send_module_ == rtp_module) {
     last_send_module_ = nullptr;
   }
@@ -105,23 +118,14 @@ void PacketRouter::RemoveReceiveRtpModule(
   rtcp_feedback_senders_.erase(it);
 }
 
-RtpRtcp* PacketRouter::FindRtpModule(uint32_t ssrc) {
-  auto it = rtp_module_cache_map_.find(ssrc);
-  if (it != rtp_module_cache_map_.end()) {
-    if (ssrc == it->second->SSRC() || ssrc == it->second->FlexfecSsrc()) {
-      return it->second;
-    }
-    // This entry is stale due to a changed ssrc - remove it.
-    rtp_module_cache_map_.erase(it);
-  }
-  // Slow path - find and cache matching module
-  for (RtpRtcp* rtp_module : rtp_send_modules_) {
-    if (ssrc == rtp_module->SSRC() || ssrc == rtp_module->FlexfecSsrc()) {
-      rtp_module_cache_map_[ssrc] = rtp_module;
-      return rtp_module;
-    }
-  }
-  return nullptr;
+void PacketRouter::AddSendRtpModuleToMap(RtpRtcp* rtp_module, uint32_t ssrc) {
+  // The SSRCs of a module are set at construction, so they can be bound once.
+  RTC_DCHECK(send_modules_map_.find(ssrc) == send_modules_map_.end());
+  send_modules_map_[ssrc] = rtp_module;
+}
+
+void PacketRouter::RemoveSendRtpModuleFromMap(uint32_t ssrc) {
+  send_modules_map_.erase(ssrc);
 }
 
 void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
@@ -133,26 +137,29 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
     packet->SetExtension<TransportSequenceNumber>(AllocateSequenceNumber());
   }
 
-  auto it = rtp_module_cache_map_.find(packet->Ssrc());
-  if (it != rtp_module_cache_map_.end()) {
-    if (TrySendPacket(packet.get(), cluster_info, it->second)) {
-      return;
-    }
-    // Entry is stale, remove it.
-    rtp_module_cache_map_.erase(it);
+  auto it = send_modules_map_.find(packet->Ssrc());
+  if (it == send_modules_map_.end()) {
+    RTC_LOG(LS_WARNING) << "Failed to send packet, matching RTP module not "
+                           "found. SSRC = "
+                        << packet->Ssrc() << ", sequence number "
+                        << packet->SequenceNumber();
+    return;
   }
 
-  // Slow path, find the correct send module.
-  for (auto* rtp_module : rtp_send_modules_) {
-    if (TrySendPacket(packet.get(), cluster_info, rtp_module)) {
-      return;
-    }
+  RtpRtcp* rtp_module = it->second;
+  if (!rtp_module->TrySendPacket(packet.get(), cluster_info)) {
+    RTC_LOG(LS_WARNING) << "Failed to send packet, rejected by RTP module. "
+                           "SSRC = "
+                        << packet->Ssrc() << ", sequence number "
+                        << packet->SequenceNumber();
+    return;
   }
 
-  RTC_LOG(LS_WARNING) << "Failed to send packet, matching RTP module not found "
-                         "or transport error. SSRC = "
-                      << packet->Ssrc() << ", sequence number "
-                      << packet->SequenceNumber();
+  if (rtp_module->SupportsRtxPayloadPadding()) {
+    // This is now the last module to send media, and has the desired
+    // properties needed for payload based padding. Cache it for later use.
+    last_send_module_ = rtp_module;
+  }
 }
 
 std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::GeneratePadding(
@@ -352,23 +359,4 @@ void PacketRouter::DetermineActiveRembModule() {
   active_remb_module_ = new_active_remb_module;
 }
 
-bool PacketRouter::TrySendPacket(RtpPacketToSend* packet,
-                                 const PacedPacketInfo& cluster_info,
-                                 RtpRtcp* rtp_module) {
-  uint32_t ssrc = packet->Ssrc();
-  if (rtp_module->TrySendPacket(packet, cluster_info)) {
-    // Sending succeeded, make sure this SSRC mapping for future use.
-    rtp_module_cache_map_[ssrc] = rtp_module;
-
-    if (rtp_module->SupportsRtxPayloadPadding()) {
-      // This is now the last module to send media, and has the desired
-      // properties needed for payload based padding. Cache it for later use.
-      last_send_module_ = rtp_module;
-    }
-
-    return true;
-  }
-  return false;
-}
-
 }  // namespace webrtc
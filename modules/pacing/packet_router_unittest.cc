@@ -40,6 +40,7 @@ using ::testing::Field;
 using ::testing::Gt;
 using ::testing::Le;
 using ::testing::NiceMock;
+using ::testing::Pointee;
 using ::testing::Property;
 using ::testing::Return;
 using ::testing::SaveArg;
@@ -273,11 +274,10 @@ TEST_F(PacketRouterTest, SendTransportFeedback) {
 
 TEST_F(PacketRouterTest, SendPacketWithoutTransportSequenceNumbers) {
   NiceMock<MockRtpRtcp> rtp_1;
-  packet_router_.AddSendRtpModule(&rtp_1, false);
-
   const uint16_t kSsrc1 = 1234;
   ON_CALL(rtp_1, SendingMedia).WillByDefault(Return(true));
   ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
 
   // Send a packet without TransportSequenceNumber extension registered,
   // packets sent should not have the extension set.
@@ -300,15 +300,15 @@ TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   NiceMock<MockRtpRtcp> rtp_1;
   NiceMock<MockRtpRtcp> rtp_2;
 
-  packet_router_.AddSendRtpModule(&rtp_1, false);
-  packet_router_.AddSendRtpModule(&rtp_2, false);
-
   const uint16_t kSsrc1 = 1234;
   const uint16_t kSsrc2 = 2345;
 
   ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
   ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
 
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+
   // Transport sequence numbers start at 1, for historical reasons.
   uint16_t transport_sequence_number = 1;
 
@@ -327,9 +327,8 @@ TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   packet = BuildRtpPacket(kSsrc2);
   EXPECT_TRUE(packet->ReserveExtension<TransportSequenceNumber>());
 
-  // There will be a failed attempt to send on kSsrc1 before trying
-  // the correct RTP module.
-  EXPECT_CALL(rtp_1, TrySendPacket).WillOnce(Return(false));
+  // The packet goes straight to the module bound to its SSRC.
+  EXPECT_CALL(rtp_1, TrySendPacket).Times(0);
   EXPECT_CALL(
       rtp_2,
       TrySendPacket(
@@ -343,6 +342,38 @@ TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_2);
 }
 
+TEST_F(PacketRouterTest, SendsPacketsOnRtxAndFlexfecSsrcsToTheirModule) {
+  const uint32_t kSsrc1 = 1234;
+  const uint32_t kRtxSsrc1 = 1235;
+  const uint32_t kFlexfecSsrc1 = 1236;
+  const uint32_t kSsrc2 = 2345;
+
+  NiceMock<MockRtpRtcp> rtp_1;
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_1, RtxSsrc).WillByDefault(Return(kRtxSsrc1));
+  ON_CALL(rtp_1, FlexfecSsrc).WillByDefault(Return(kFlexfecSsrc1));
+  NiceMock<MockRtpRtcp> rtp_2;
+  ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
+
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+
+  EXPECT_CALL(rtp_2, TrySendPacket).Times(0);
+  for (uint32_t ssrc : {kSsrc1, kRtxSsrc1, kFlexfecSsrc1}) {
+    EXPECT_CALL(rtp_1, TrySendPacket(
+                           Pointee(Property(&RtpPacketToSend::Ssrc, ssrc)), _))
+        .WillOnce(Return(true));
+    packet_router_.SendPacket(BuildRtpPacket(ssrc), PacedPacketInfo());
+  }
+
+  // Once the module is removed, its SSRCs are no longer bound.
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+  EXPECT_CALL(rtp_1, TrySendPacket).Times(0);
+  packet_router_.SendPacket(BuildRtpPacket(kRtxSsrc1), PacedPacketInfo());
+
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 TEST_F(PacketRouterTest, DoubleRegistrationOfSendModuleDisallowed) {
   NiceMock<MockRtpRtcp> module;
@@ -19,6 +19,8 @@
 namespace webrtc {
 namespace {
 static constexpr DataSize kMaxLeadingSize = DataSize::Bytes<1400>();
+// The most list nodes of sent packets that are kept for reuse.
+static constexpr size_t kMaxFreePacketNodes = 1000;
 }
 
 RoundRobinPacketQueue::QueuedPacket::QueuedPacket(const QueuedPacket& rhs) =
@@ -35,7 +37,7 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
     DataSize size,
     bool retransmission,
     uint64_t enqueue_order,
-    std::multiset<Timestamp>::iterator enqueue_time_it,
+    uint64_t enqueue_time_index,
     absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
         packet_it)
     : type_(type),
@@ -47,7 +49,7 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
       size_(size),
       retransmission_(retransmission),
       enqueue_order_(enqueue_order),
-      enqueue_time_it_(enqueue_time_it),
+      enqueue_time_index_(enqueue_time_index),
       packet_it_(packet_it) {}
 
 std::unique_ptr<RtpPacketToSend>
@@ -70,10 +72,24 @@ bool RoundRobinPacketQueue::QueuedPacket::operator<(
   return enqueue_order_ > other.enqueue_order_;
 }
 
-RoundRobinPacketQueue::Stream::Stream() : size(DataSize::Zero()), ssrc(0) {}
+RoundRobinPacketQueue::Stream::Stream()
+    : size(DataSize::Zero()),
+      ssrc(0),
+      scheduled(false),
+      scheduled_priority(0),
+      scheduled_size(DataSize::Zero()),
+      schedule_order(0),
+      heap_index(0) {}
 RoundRobinPacketQueue::Stream::Stream(const Stream& stream) = default;
 RoundRobinPacketQueue::Stream::~Stream() {}
 
+RoundRobinPacketQueue::PriorityLevel::PriorityLevel(int priority)
+    : priority(priority) {}
+RoundRobinPacketQueue::PriorityLevel::PriorityLevel(PriorityLevel&&) = default;
+RoundRobinPacketQueue::PriorityLevel&
+RoundRobinPacketQueue::PriorityLevel::operator=(PriorityLevel&&) = default;
+RoundRobinPacketQueue::PriorityLevel::~PriorityLevel() = default;
+
 bool IsEnabled(const WebRtcKeyValueConfig* field_trials, const char* name) {
   if (!field_trials) {
     return false;
@@ -91,6 +107,9 @@ RoundRobinPacketQueue::RoundRobinPacketQueue(
       max_size_(kMaxLeadingSize),
       queue_time_sum_(TimeDelta::Zero()),
       pause_time_sum_(TimeDelta::Zero()),
+      num_scheduled_streams_(0),
+      schedule_counter_(0),
+      first_enqueue_time_index_(0),
       send_side_bwe_with_overhead_(
           IsEnabled(field_trials, "WebRTC-SendSideBwe-WithOverhead")) {}
 
@@ -107,7 +126,7 @@ void RoundRobinPacketQueue::Push(int priority,
                                  uint64_t enqueue_order) {
   Push(QueuedPacket(priority, type, ssrc, seq_number, capture_time_ms,
                     enqueue_time, size, retransmission, enqueue_order,
-                    enqueue_times_.insert(enqueue_time), absl::nullopt));
+                    AddEnqueueTime(enqueue_time), absl::nullopt));
 }
 
 void RoundRobinPacketQueue::Push(int priority,
@@ -124,11 +143,17 @@ void RoundRobinPacketQueue::Push(int priority,
   auto type = packet->packet_type();
   RTC_DCHECK(type.has_value());
 
-  rtp_packets_.push_front(std::move(packet));
+  if (free_packet_nodes_.empty()) {
+    rtp_packets_.push_front(std::move(packet));
+  } else {
+    rtp_packets_.splice(rtp_packets_.begin(), free_packet_nodes_,
+                        free_packet_nodes_.begin());
+    rtp_packets_.front() = std::move(packet);
+  }
   Push(QueuedPacket(
       priority, *type, ssrc, sequence_number, capture_time_ms, enqueue_time,
       size, *type == RtpPacketToSend::Type::kRetransmission, enqueue_order,
-      enqueue_times_.insert(enqueue_time), rtp_packets_.begin()));
+      AddEnqueueTime(enqueue_time), rtp_packets_.begin()));
 }
 
 RoundRobinPacketQueue::QueuedPacket* RoundRobinPacketQueue::BeginPop() {
@@ -153,7 +178,7 @@ void RoundRobinPacketQueue::FinalizePop() {
   if (!Empty()) {
     RTC_CHECK(pop_packet_ && pop_stream_);
     Stream* stream = *pop_stream_;
-    stream_priorities_.erase(stream->priority_it);
+    UnscheduleStream(stream);
     const QueuedPacket& packet = *pop_packet_;
 
     // Calculate the total amount of time spent by this packet in the queue
@@ -165,12 +190,17 @@ void RoundRobinPacketQueue::FinalizePop() {
         time_last_updated_ - packet.enqueue_time() - pause_time_sum_;
     queue_time_sum_ -= time_in_non_paused_state;
 
-    RTC_CHECK(packet.EnqueueTimeIterator() != enqueue_times_.end());
-    enqueue_times_.erase(packet.EnqueueTimeIterator());
+    RemoveEnqueueTime(packet.EnqueueTimeIndex());
 
     auto packet_it = packet.PacketIterator();
     if (packet_it) {
-      rtp_packets_.erase(*packet_it);
+      if (free_packet_nodes_.size() < kMaxFreePacketNodes) {
+        (*packet_it)->reset();
+        free_packet_nodes_.splice(free_packet_nodes_.begin(), rtp_packets_,
+                                  *packet_it);
+      } else {
+        rtp_packets_.erase(*packet_it);
+      }
     }
 
     // Update |bytes| of this stream. The general idea is that the stream that
@@ -188,13 +218,8 @@ void RoundRobinPacketQueue::FinalizePop() {
     RTC_CHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
 
     // If there are packets left to be sent, schedule the stream again.
-    RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-    if (stream->packet_queue.empty()) {
-      stream->priority_it = stream_priorities_.end();
-    } else {
-      int priority = stream->packet_queue.top().priority();
-      stream->priority_it = stream_priorities_.emplace(
-          StreamPrioKey(priority, stream->size), stream->ssrc);
+    if (!stream->packet_queue.empty()) {
+      ScheduleStream(stream, stream->packet_queue.top().priority());
     }
 
     pop_packet_.reset();
@@ -203,9 +228,9 @@ void RoundRobinPacketQueue::FinalizePop() {
 }
 
 bool RoundRobinPacketQueue::Empty() const {
-  RTC_CHECK((!stream_priorities_.empty() && size_packets_ > 0) ||
-            (stream_priorities_.empty() && size_packets_ == 0));
-  return stream_priorities_.empty();
+  RTC_CHECK((num_scheduled_streams_ > 0 && size_packets_ > 0) ||
+            (num_scheduled_streams_ == 0 && size_packets_ == 0));
+  return num_scheduled_streams_ == 0;
 }
 
 size_t RoundRobinPacketQueue::SizeInPackets() const {
@@ -220,7 +245,7 @@ Timestamp RoundRobinPacketQueue::OldestEnqueueTime() const {
   if (Empty())
     return Timestamp::MinusInfinity();
   RTC_CHECK(!enqueue_times_.empty());
-  return *enqueue_times_.begin();
+  return enqueue_times_.front().time;
 }
 
 void RoundRobinPacketQueue::UpdateQueueTime(Timestamp now) {
@@ -256,26 +281,21 @@ void RoundRobinPacketQueue::Push(QueuedPacket packet) {
   auto stream_info_it = streams_.find(packet.ssrc());
   if (stream_info_it == streams_.end()) {
     stream_info_it = streams_.emplace(packet.ssrc(), Stream()).first;
-    stream_info_it->second.priority_it = stream_priorities_.end();
     stream_info_it->second.ssrc = packet.ssrc();
   }
 
   Stream* stream = &stream_info_it->second;
 
-  if (stream->priority_it == stream_priorities_.end()) {
-    // If the SSRC is not currently scheduled, add it to |stream_priorities_|.
-    RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.priority(), stream->size), packet.ssrc());
-  } else if (packet.priority() < stream->priority_it->first.priority) {
-    // If the priority of this SSRC increased, remove the outdated StreamPrioKey
-    // and insert a new one with the new priority. Note that |priority_| uses
-    // lower ordinal for higher priority.
-    stream_priorities_.erase(stream->priority_it);
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.priority(), stream->size), packet.ssrc());
+  if (!stream->scheduled) {
+    // If the SSRC is not currently scheduled, schedule it.
+    ScheduleStream(stream, packet.priority());
+  } else if (packet.priority() < stream->scheduled_priority) {
+    // If the priority of this SSRC increased, reschedule it with the new
+    // priority. Note that |priority_| uses lower ordinal for higher priority.
+    UnscheduleStream(stream);
+    ScheduleStream(stream, packet.priority());
   }
-  RTC_CHECK(stream->priority_it != stream_priorities_.end());
+  RTC_CHECK(stream->scheduled);
 
   // In order to figure out how much time a packet has spent in the queue while
   // not in a paused state, we subtract the total amount of time the queue has
@@ -294,22 +314,122 @@ void RoundRobinPacketQueue::Push(QueuedPacket packet) {
 
 RoundRobinPacketQueue::Stream*
 RoundRobinPacketQueue::GetHighestPriorityStream() {
-  RTC_CHECK(!stream_priorities_.empty());
-  uint32_t ssrc = stream_priorities_.begin()->second;
-
-  auto stream_info_it = streams_.find(ssrc);
-  RTC_CHECK(stream_info_it != streams_.end());
-  RTC_CHECK(stream_info_it->second.priority_it == stream_priorities_.begin());
-  RTC_CHECK(!stream_info_it->second.packet_queue.empty());
-  return &stream_info_it->second;
+  RTC_CHECK_GT(num_scheduled_streams_, 0);
+  for (PriorityLevel& level : priority_levels_) {
+    if (level.heap.empty())
+      continue;
+    Stream* stream = level.heap.front();
+    RTC_CHECK(stream->scheduled);
+    RTC_CHECK(!stream->packet_queue.empty());
+    return stream;
+  }
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
+void RoundRobinPacketQueue::ScheduleStream(Stream* stream, int priority) {
+  RTC_CHECK(!stream->scheduled);
+  PriorityLevel* level = GetPriorityLevel(priority);
+  stream->scheduled = true;
+  stream->scheduled_priority = priority;
+  stream->scheduled_size = stream->size;
+  stream->schedule_order = schedule_counter_++;
+  stream->heap_index = level->heap.size();
+  level->heap.push_back(stream);
+  SiftUp(level, stream->heap_index);
+  ++num_scheduled_streams_;
+}
+
+void RoundRobinPacketQueue::UnscheduleStream(Stream* stream) {
+  RTC_CHECK(stream->scheduled);
+  PriorityLevel* level = GetPriorityLevel(stream->scheduled_priority);
+  size_t index = stream->heap_index;
+  RTC_CHECK_LT(index, level->heap.size());
+  RTC_CHECK_EQ(level->heap[index], stream);
+  Stream* last = level->heap.back();
+  level->heap.pop_back();
+  if (last != stream) {
+    level->heap[index] = last;
+    last->heap_index = index;
+    SiftUp(level, index);
+    SiftDown(level, last->heap_index);
+  }
+  stream->scheduled = false;
+  --num_scheduled_streams_;
+}
+
+RoundRobinPacketQueue::PriorityLevel* RoundRobinPacketQueue::GetPriorityLevel(
+    int priority) {
+  // There are only a handful of priorities in use, so a linear search in a
+  // sorted vector is cheap.
+  auto it = priority_levels_.begin();
+  while (it != priority_levels_.end() && it->priority < priority)
+    ++it;
+  if (it == priority_levels_.end() || it->priority != priority)
+    it = priority_levels_.emplace(it, priority);
+  return &*it;
+}
+
+bool RoundRobinPacketQueue::ScheduledBefore(const Stream* lhs,
+                                            const Stream* rhs) {
+  if (lhs->scheduled_size != rhs->scheduled_size)
+    return lhs->scheduled_size < rhs->scheduled_size;
+  return lhs->schedule_order < rhs->schedule_order;
+}
+
+void RoundRobinPacketQueue::SiftUp(PriorityLevel* level, size_t index) {
+  std::vector<Stream*>& heap = level->heap;
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!ScheduledBefore(heap[index], heap[parent]))
+      break;
+    std::swap(heap[index], heap[parent]);
+    heap[index]->heap_index = index;
+    heap[parent]->heap_index = parent;
+    index = parent;
+  }
+}
+
+void RoundRobinPacketQueue::SiftDown(PriorityLevel* level, size_t index) {
+  std::vector<Stream*>& heap = level->heap;
+  while (true) {
+    size_t first = index;
+    size_t left = 2 * index + 1;
+    size_t right = left + 1;
+    if (left < heap.size() && ScheduledBefore(heap[left], heap[first]))
+      first = left;
+    if (right < heap.size() && ScheduledBefore(heap[right], heap[first]))
+      first = right;
+    if (first == index)
+      break;
+    std::swap(heap[index], heap[first]);
+    heap[index]->heap_index = index;
+    heap[first]->heap_index = first;
+    index = first;
+  }
+}
+
+uint64_t RoundRobinPacketQueue::AddEnqueueTime(Timestamp enqueue_time) {
+  if (!enqueue_times_.empty() && enqueue_times_.back().time == enqueue_time) {
+    ++enqueue_times_.back().count;
+  } else {
+    RTC_CHECK(enqueue_times_.empty() ||
+              enqueue_times_.back().time < enqueue_time);
+    enqueue_times_.push_back({enqueue_time, 1});
+  }
+  return first_enqueue_time_index_ + enqueue_times_.size() - 1;
 }
 
-bool RoundRobinPacketQueue::IsSsrcScheduled(uint32_t ssrc) const {
-  for (const auto& scheduled_stream : stream_priorities_) {
-    if (scheduled_stream.second == ssrc)
-      return true;
+void RoundRobinPacketQueue::RemoveEnqueueTime(uint64_t index) {
+  RTC_CHECK_GE(index, first_enqueue_time_index_);
+  RTC_CHECK_LT(index - first_enqueue_time_index_, enqueue_times_.size());
+  EnqueueTimeCount& entry = enqueue_times_[index - first_enqueue_time_index_];
+  RTC_CHECK_GT(entry.count, 0);
+  --entry.count;
+  while (!enqueue_times_.empty() && enqueue_times_.front().count == 0) {
+    enqueue_times_.pop_front();
+    ++first_enqueue_time_index_;
   }
-  return false;
 }
 
 }  // namespace webrtc
@@ -14,11 +14,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <list>
-#include <map>
 #include <memory>
 #include <queue>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/transport/webrtc_key_value_config.h"
@@ -49,7 +50,7 @@ class RoundRobinPacketQueue {
         DataSize size,
         bool retransmission,
         uint64_t enqueue_order,
-        std::multiset<Timestamp>::iterator enqueue_time_it,
+        uint64_t enqueue_time_index,
         absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
             packet_it);
     QueuedPacket(const QueuedPacket& rhs);
@@ -73,9 +74,7 @@ class RoundRobinPacketQueue {
     PacketIterator() const {
       return packet_it_;
     }
-    std::multiset<Timestamp>::iterator EnqueueTimeIterator() const {
-      return enqueue_time_it_;
-    }
+    uint64_t EnqueueTimeIndex() const { return enqueue_time_index_; }
     void SubtractPauseTime(TimeDelta pause_time_sum);
 
    private:
@@ -88,7 +87,8 @@ class RoundRobinPacketQueue {
     DataSize size_;
     bool retransmission_;
     uint64_t enqueue_order_;
-    std::multiset<Timestamp>::iterator enqueue_time_it_;
+    // Index of the entry in |enqueue_times_| counting this packet.
+    uint64_t enqueue_time_index_;
     // Iterator into |rtp_packets_| where the memory for RtpPacket is owned,
     // if applicable.
     absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
@@ -122,20 +122,6 @@ class RoundRobinPacketQueue {
   void SetPauseState(bool paused, Timestamp now);
 
  private:
-  struct StreamPrioKey {
-    StreamPrioKey(int priority, DataSize size)
-        : priority(priority), size(size) {}
-
-    bool operator<(const StreamPrioKey& other) const {
-      if (priority != other.priority)
-        return priority < other.priority;
-      return size < other.size;
-    }
-
-    const int priority;
-    const DataSize size;
-  };
-
   struct Stream {
     Stream();
     Stream(const Stream&);
@@ -146,20 +132,52 @@ class RoundRobinPacketQueue {
     uint32_t ssrc;
     std::priority_queue<QueuedPacket> packet_queue;
 
-    // Whenever a packet is inserted for this stream we check if |priority_it|
-    // points to an element in |stream_priorities_|, and if it does it means
-    // this stream has already been scheduled, and if the scheduled priority is
-    // lower than the priority of the incoming packet we reschedule this stream
-    // with the higher priority.
-    std::multimap<StreamPrioKey, uint32_t>::iterator priority_it;
+    // Whenever a packet is inserted for this stream we check if it is
+    // |scheduled|, and if the scheduled priority is lower than the priority of
+    // the incoming packet we reschedule this stream with the higher priority.
+    bool scheduled;
+    // While |scheduled|: the priority and size the stream was scheduled with,
+    // the order used to break ties between streams scheduled with the same
+    // priority and size, and the position in the heap of its priority level.
+    int scheduled_priority;
+    DataSize scheduled_size;
+    uint64_t schedule_order;
+    size_t heap_index;
+  };
+
+  // The streams scheduled with one priority, kept as a binary min-heap on
+  // (scheduled size, schedule order).
+  struct PriorityLevel {
+    explicit PriorityLevel(int priority);
+    PriorityLevel(PriorityLevel&&);
+    PriorityLevel& operator=(PriorityLevel&&);
+    ~PriorityLevel();
+
+    int priority;
+    std::vector<Stream*> heap;
+  };
+
+  // Number of packets that were enqueued at |time|.
+  struct EnqueueTimeCount {
+    Timestamp time;
+    size_t count;
   };
 
   void Push(QueuedPacket packet);
 
   Stream* GetHighestPriorityStream();
 
-  // Just used to verify correctness.
-  bool IsSsrcScheduled(uint32_t ssrc) const;
+  // Schedules |stream| with |priority| and its current size, after all streams
+  // already scheduled with the same priority and size.
+  void ScheduleStream(Stream* stream, int priority);
+  void UnscheduleStream(Stream* stream);
+  PriorityLevel* GetPriorityLevel(int priority);
+  static bool ScheduledBefore(const Stream* lhs, const Stream* rhs);
+  static void SiftUp(PriorityLevel* level, size_t index);
+  static void SiftDown(PriorityLevel* level, size_t index);
+
+  uint64_t AddEnqueueTime(Timestamp enqueue_time);
+  void RemoveEnqueueTime(uint64_t index);
 
   Timestamp time_last_updated_;
   absl::optional<QueuedPacket> pop_packet_;
@@ -172,24 +190,33 @@ class RoundRobinPacketQueue {
   TimeDelta queue_time_sum_;
   TimeDelta pause_time_sum_;
 
-  // A map of streams used to prioritize from which stream to send next. We use
-  // a multimap instead of a priority_queue since the priority of a stream can
-  // change as a new packet is inserted, and a multimap allows us to remove and
-  // then reinsert a StreamPrioKey if the priority has increased.
-  std::multimap<StreamPrioKey, uint32_t> stream_priorities_;
-
-  // A map of SSRCs to Streams.
-  std::map<uint32_t, Stream> streams_;
-
-  // The enqueue time of every packet currently in the queue. Used to figure out
-  // the age of the oldest packet in the queue.
-  std::multiset<Timestamp> enqueue_times_;
+  // The scheduled streams, bucketed on priority and ordered by priority. The
+  // stream to send from next is the one at the top of the heap of the first
+  // non-empty level, i.e. we prioritize on (priority, size) and send from
+  // streams with equal keys in the order they were scheduled.
+  std::vector<PriorityLevel> priority_levels_;
+  size_t num_scheduled_streams_;
+  uint64_t schedule_counter_;
+
+  // A map of SSRCs to Streams. Streams are never removed, so pointers to them
+  // stay valid.
+  std::unordered_map<uint32_t, Stream> streams_;
+
+  // The enqueue time of every packet currently in the queue, run-length
+  // encoded in the order the packets were pushed. Enqueue times never
+  // decrease, so the front is the oldest packet still in the queue.
+  std::deque<EnqueueTimeCount> enqueue_times_;
+  // Index of the front entry of |enqueue_times_|.
+  uint64_t first_enqueue_time_index_;
 
   // List of RTP packets to be sent, not necessarily in the order they will be
   // sent. PacketInfo.packet_it will point to an entry in this list, or the
   // end iterator of this list if queue does not have direct ownership of the
   // packet.
   std::list<std::unique_ptr<RtpPacketToSend>> rtp_packets_;
+  // Empty list nodes of sent packets, moved back into |rtp_packets_| when
+  // packets are pushed, so that a steady flow of packets does not allocate.
+  std::list<std::unique_ptr<RtpPacketToSend>> free_packet_nodes_;
 
   const bool send_side_bwe_with_overhead_;
 };
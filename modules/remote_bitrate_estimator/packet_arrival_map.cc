@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr size_t PacketArrivalTimeMap::kMaxNumberOfPackets;
+constexpr int64_t PacketArrivalTimeMap::kNotReceived;
+
+PacketArrivalTimeMap::PacketArrivalTimeMap() = default;
+PacketArrivalTimeMap::~PacketArrivalTimeMap() = default;
+
+bool PacketArrivalTimeMap::has_received(int64_t sequence_number) const {
+  return sequence_number >= begin_sequence_number_ &&
+         sequence_number < end_sequence_number() &&
+         arrival_times_ms_[sequence_number - begin_sequence_number_] !=
+             kNotReceived;
+}
+
+int64_t PacketArrivalTimeMap::get(int64_t sequence_number) const {
+  RTC_DCHECK(has_received(sequence_number));
+  return arrival_times_ms_[sequence_number - begin_sequence_number_];
+}
+
+void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
+                                     int64_t arrival_time_ms) {
+  RTC_DCHECK_GE(arrival_time_ms, 0);
+  if (!has_seen_packet_ ||
+      (empty() && sequence_number < begin_sequence_number_)) {
+    has_seen_packet_ = true;
+    begin_sequence_number_ = sequence_number;
+    arrival_times_ms_.push_back(arrival_time_ms);
+    return;
+  }
+
+  if (sequence_number < begin_sequence_number_) {
+    // Reordered packet before the buffer. Only expand the buffer if it doesn't
+    // push out newer packets.
+    const size_t num_missing =
+        static_cast<size_t>(begin_sequence_number_ - sequence_number);
+    if (num_missing + arrival_times_ms_.size() > kMaxNumberOfPackets)
+      return;
+    arrival_times_ms_.insert(arrival_times_ms_.begin(), num_missing,
+                             kNotReceived);
+    arrival_times_ms_.front() = arrival_time_ms;
+    begin_sequence_number_ = sequence_number;
+    return;
+  }
+
+  if (sequence_number < end_sequence_number()) {
+    int64_t& arrival_time_slot =
+        arrival_times_ms_[sequence_number - begin_sequence_number_];
+    if (arrival_time_slot == kNotReceived)
+      arrival_time_slot = arrival_time_ms;
+    return;
+  }
+
+  // Make room for the new packet by dropping the oldest ones.
+  const int64_t new_begin_sequence_number =
+      sequence_number - static_cast<int64_t>(kMaxNumberOfPackets) + 1;
+  if (new_begin_sequence_number >= end_sequence_number()) {
+    arrival_times_ms_.clear();
+    begin_sequence_number_ = sequence_number;
+  } else if (new_begin_sequence_number > begin_sequence_number_) {
+    EraseTo(new_begin_sequence_number);
+  }
+
+  // Fill the gap up to the new packet with packets not received.
+  arrival_times_ms_.insert(
+      arrival_times_ms_.end(),
+      static_cast<size_t>(sequence_number - end_sequence_number()),
+      kNotReceived);
+  arrival_times_ms_.push_back(arrival_time_ms);
+  RTC_DCHECK_LE(arrival_times_ms_.size(), kMaxNumberOfPackets);
+}
+
+void PacketArrivalTimeMap::EraseTo(int64_t sequence_number) {
+  if (sequence_number >= end_sequence_number()) {
+    begin_sequence_number_ = end_sequence_number();
+    arrival_times_ms_.clear();
+    return;
+  }
+  if (sequence_number <= begin_sequence_number_)
+    return;
+  arrival_times_ms_.erase(
+      arrival_times_ms_.begin(),
+      arrival_times_ms_.begin() + (sequence_number - begin_sequence_number_));
+  begin_sequence_number_ = sequence_number;
+  TrimFront();
+}
+
+void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
+                                            int64_t arrival_time_limit_ms) {
+  while (!empty() && begin_sequence_number_ < sequence_number &&
+         arrival_times_ms_.front() <= arrival_time_limit_ms) {
+    arrival_times_ms_.pop_front();
+    ++begin_sequence_number_;
+    TrimFront();
+  }
+}
+
+void PacketArrivalTimeMap::TrimFront() {
+  while (!empty() && arrival_times_ms_.front() == kNotReceived) {
+    arrival_times_ms_.pop_front();
+    ++begin_sequence_number_;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+
+namespace webrtc {
+
+// Arrival times of received packets, keyed by unwrapped transport sequence
+// number, in one contiguous buffer with a slot per sequence number in
+// [begin_sequence_number(), end_sequence_number()). The last slot always holds
+// the newest received packet, and the buffer never spans more than
+// |kMaxNumberOfPackets| sequence numbers; older packets are dropped to make
+// room for newer ones. Once packets are removed, the next packet continues
+// from where they ended.
+class PacketArrivalTimeMap {
+ public:
+  // Impossible to request feedback older than what can be represented by 15
+  // bits.
+  static constexpr size_t kMaxNumberOfPackets = (1 << 15);
+
+  PacketArrivalTimeMap();
+  ~PacketArrivalTimeMap();
+
+  bool empty() const { return arrival_times_ms_.empty(); }
+  // The first sequence number in the map, and one past the last one. Equal
+  // when the map is empty.
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+  int64_t end_sequence_number() const {
+    return begin_sequence_number_ +
+           static_cast<int64_t>(arrival_times_ms_.size());
+  }
+
+  bool has_received(int64_t sequence_number) const;
+  // Returns the arrival time of a received packet.
+  int64_t get(int64_t sequence_number) const;
+
+  // Records the arrival of a packet, unless it was already received or it is
+  // too old to fit in the map.
+  void AddPacket(int64_t sequence_number, int64_t arrival_time_ms);
+
+  // Removes all packets before |sequence_number|.
+  void EraseTo(int64_t sequence_number);
+
+  // Removes the oldest packets before |sequence_number| that arrived no later
+  // than |arrival_time_limit_ms|.
+  void RemoveOldPackets(int64_t sequence_number, int64_t arrival_time_limit_ms);
+
+ private:
+  static constexpr int64_t kNotReceived = -1;
+
+  // Drops leading slots of packets that were not received.
+  void TrimFront();
+
+  std::deque<int64_t> arrival_times_ms_;
+  int64_t begin_sequence_number_ = 0;
+  bool has_seen_packet_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
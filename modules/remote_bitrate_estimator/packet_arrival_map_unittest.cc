@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kMaxNumberOfPackets =
+    PacketArrivalTimeMap::kMaxNumberOfPackets;
+
+TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin_sequence_number(), map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(0));
+}
+
+TEST(PacketArrivalMapTest, InsertsFirstItemIntoMap) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_EQ(43, map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_EQ(10, map.get(42));
+}
+
+TEST(PacketArrivalMapTest, KeepsFirstArrivalTime) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(42, 11);
+  EXPECT_EQ(10, map.get(42));
+}
+
+TEST(PacketArrivalMapTest, FillsGapsWithPacketsNotReceived) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(45, 11);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_EQ(46, map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_FALSE(map.has_received(44));
+
+  // Reordered packets.
+  map.AddPacket(44, 12);
+  map.AddPacket(40, 13);
+  EXPECT_EQ(40, map.begin_sequence_number());
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_EQ(12, map.get(44));
+  EXPECT_EQ(13, map.get(40));
+}
+
+TEST(PacketArrivalMapTest, DropsOldestPacketsToBoundSize) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(0, 10);
+  map.AddPacket(1, 11);
+  map.AddPacket(5, 12);
+  map.AddPacket(kMaxNumberOfPackets + 1, 13);
+  // Packet 1 is dropped, and so are the packets not received after it.
+  EXPECT_EQ(5, map.begin_sequence_number());
+  EXPECT_EQ(kMaxNumberOfPackets + 2, map.end_sequence_number());
+
+  // A packet so old that it would push out newer ones is ignored.
+  map.AddPacket(1, 14);
+  EXPECT_EQ(5, map.begin_sequence_number());
+
+  map.AddPacket(3 * kMaxNumberOfPackets, 15);
+  EXPECT_EQ(3 * kMaxNumberOfPackets, map.begin_sequence_number());
+  EXPECT_EQ(3 * kMaxNumberOfPackets + 1, map.end_sequence_number());
+}
+
+TEST(PacketArrivalMapTest, ErasesToSequenceNumber) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(40, 10);
+  map.AddPacket(42, 11);
+  map.AddPacket(44, 12);
+
+  map.EraseTo(41);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_FALSE(map.has_received(40));
+  map.EraseTo(45);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(45, map.begin_sequence_number());
+}
+
+TEST(PacketArrivalMapTest, RemovesOldPackets) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(40, 10);
+  map.AddPacket(42, 20);
+  map.AddPacket(43, 15);
+  map.AddPacket(44, 30);
+
+  // Stops at the first packet that is recent enough.
+  map.RemoveOldPackets(44, 15);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_TRUE(map.has_received(43));
+
+  // Only removes packets before the given sequence number.
+  map.RemoveOldPackets(44, 100);
+  EXPECT_EQ(44, map.begin_sequence_number());
+  EXPECT_TRUE(map.has_received(44));
+}
+
+TEST(PacketArrivalMapTest, ContinuesFromRemovedPackets) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(40, 10);
+  map.AddPacket(41, 11);
+  map.RemoveOldPackets(42, 20);
+  EXPECT_TRUE(map.empty());
+
+  map.AddPacket(43, 30);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_FALSE(map.has_received(42));
+  EXPECT_TRUE(map.has_received(43));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -82,12 +82,17 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
   return fabs(static_cast<float>(send_delta_ms) - cluster_mean) < 2.5f;
 }
 
-void RemoteBitrateEstimatorAbsSendTime::AddCluster(std::list<Cluster>* clusters,
-                                                   Cluster* cluster) {
-  cluster->send_mean_ms /= static_cast<float>(cluster->count);
-  cluster->recv_mean_ms /= static_cast<float>(cluster->count);
-  cluster->mean_size /= cluster->count;
-  clusters->push_back(*cluster);
+bool RemoteBitrateEstimatorAbsSendTime::IsClusterComplete(
+    const Cluster& cluster) {
+  return cluster.count >= kMinClusterSize && cluster.send_mean_ms > 0.0f &&
+         cluster.recv_mean_ms > 0.0f;
+}
+
+Cluster RemoteBitrateEstimatorAbsSendTime::FinalizeCluster(Cluster cluster) {
+  cluster.send_mean_ms /= static_cast<float>(cluster.count);
+  cluster.recv_mean_ms /= static_cast<float>(cluster.count);
+  cluster.mean_size /= cluster.count;
+  return cluster;
 }
 
 RemoteBitrateEstimatorAbsSendTime::RemoteBitrateEstimatorAbsSendTime(
@@ -100,56 +105,83 @@ RemoteBitrateEstimatorAbsSendTime::RemoteBitrateEstimatorAbsSendTime(
       detector_(&field_trials_),
       incoming_bitrate_(kBitrateWindowMs, 8000),
       incoming_bitrate_initialized_(false),
+      first_probe_index_(0),
+      num_probes_(0),
       total_probes_received_(0),
       first_packet_time_ms_(-1),
       last_update_ms_(-1),
       uma_recorded_(false),
+      earliest_stream_timeout_ms_(0),
       remote_rate_(&field_trials_) {
+  // Every probe but the first can start a new cluster.
+  clusters_.reserve(kMaxStoredProbes);
   RTC_DCHECK(clock_);
   RTC_DCHECK(observer_);
   RTC_LOG(LS_INFO) << "RemoteBitrateEstimatorAbsSendTime: Instantiating.";
 }
 
-void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
-    std::list<Cluster>* clusters) const {
-  Cluster current;
-  int64_t prev_send_time = -1;
-  int64_t prev_recv_time = -1;
-  for (std::list<Probe>::const_iterator it = probes_.begin();
-       it != probes_.end(); ++it) {
-    if (prev_send_time >= 0) {
-      int send_delta_ms = it->send_time_ms - prev_send_time;
-      int recv_delta_ms = it->recv_time_ms - prev_recv_time;
-      if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
-        ++current.num_above_min_delta;
-      }
-      if (!IsWithinClusterBounds(send_delta_ms, current)) {
-        if (current.count >= kMinClusterSize && current.send_mean_ms > 0.0f &&
-            current.recv_mean_ms > 0.0f) {
-          AddCluster(clusters, &current);
-        }
-        current = Cluster();
-      }
-      current.send_mean_ms += send_delta_ms;
-      current.recv_mean_ms += recv_delta_ms;
-      current.mean_size += it->payload_size;
-      ++current.count;
+const Probe& RemoteBitrateEstimatorAbsSendTime::GetProbe(size_t index) const {
+  RTC_DCHECK_LT(index, num_probes_);
+  return probes_[(first_probe_index_ + index) % kMaxStoredProbes];
+}
+
+void RemoteBitrateEstimatorAbsSendTime::AddProbe(const Probe& probe) {
+  if (num_probes_ == kMaxStoredProbes)
+    RemoveOldestProbe();
+  if (num_probes_ > 0)
+    AddProbeToClusters(GetProbe(num_probes_ - 1), probe);
+  probes_[(first_probe_index_ + num_probes_) % kMaxStoredProbes] = probe;
+  ++num_probes_;
+}
+
+void RemoteBitrateEstimatorAbsSendTime::RemoveOldestProbe() {
+  RTC_DCHECK_GT(num_probes_, 0);
+  first_probe_index_ = (first_probe_index_ + 1) % kMaxStoredProbes;
+  --num_probes_;
+  ComputeClusters();
+}
+
+void RemoteBitrateEstimatorAbsSendTime::ClearProbes() {
+  first_probe_index_ = 0;
+  num_probes_ = 0;
+  clusters_.clear();
+  open_cluster_ = Cluster();
+}
+
+void RemoteBitrateEstimatorAbsSendTime::AddProbeToClusters(
+    const Probe& prev_probe,
+    const Probe& probe) {
+  int send_delta_ms = probe.send_time_ms - prev_probe.send_time_ms;
+  int recv_delta_ms = probe.recv_time_ms - prev_probe.recv_time_ms;
+  if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
+    ++open_cluster_.num_above_min_delta;
+  }
+  if (!IsWithinClusterBounds(send_delta_ms, open_cluster_)) {
+    if (IsClusterComplete(open_cluster_)) {
+      clusters_.push_back(FinalizeCluster(open_cluster_));
     }
-    prev_send_time = it->send_time_ms;
-    prev_recv_time = it->recv_time_ms;
+    open_cluster_ = Cluster();
   }
-  if (current.count >= kMinClusterSize && current.send_mean_ms > 0.0f &&
-      current.recv_mean_ms > 0.0f) {
-    AddCluster(clusters, &current);
+  open_cluster_.send_mean_ms += send_delta_ms;
+  open_cluster_.recv_mean_ms += recv_delta_ms;
+  open_cluster_.mean_size += probe.payload_size;
+  ++open_cluster_.count;
+}
+
+void RemoteBitrateEstimatorAbsSendTime::ComputeClusters() {
+  clusters_.clear();
+  open_cluster_ = Cluster();
+  for (size_t i = 1; i < num_probes_; ++i) {
+    AddProbeToClusters(GetProbe(i - 1), GetProbe(i));
   }
 }
 
-std::list<Cluster>::const_iterator
+std::vector<Cluster>::const_iterator
 RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
-    const std::list<Cluster>& clusters) const {
+    const std::vector<Cluster>& clusters) const {
   int highest_probe_bitrate_bps = 0;
-  std::list<Cluster>::const_iterator best_it = clusters.end();
-  for (std::list<Cluster>::const_iterator it = clusters.begin();
+  std::vector<Cluster>::const_iterator best_it = clusters.end();
+  for (std::vector<Cluster>::const_iterator it = clusters.begin();
        it != clusters.end(); ++it) {
     if (it->send_mean_ms == 0 || it->recv_mean_ms == 0)
       continue;
@@ -178,18 +210,16 @@ RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
 
 RemoteBitrateEstimatorAbsSendTime::ProbeResult
 RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
-  std::list<Cluster> clusters;
-  ComputeClusters(&clusters);
-  if (clusters.empty()) {
-    // If we reach the max number of probe packets and still have no clusters,
-    // we will remove the oldest one.
-    if (probes_.size() >= kMaxProbePackets)
-      probes_.pop_front();
-    return ProbeResult::kNoUpdate;
-  }
-
-  std::list<Cluster>::const_iterator best_it = FindBestProbe(clusters);
-  if (best_it != clusters.end()) {
+  // The open cluster is evaluated as if no more probes were coming. It is
+  // appended temporarily, which doesn't allocate since |clusters_| has room
+  // for a cluster per probe.
+  const bool has_open_cluster = IsClusterComplete(open_cluster_);
+  if (has_open_cluster)
+    clusters_.push_back(FinalizeCluster(open_cluster_));
+  const size_t num_clusters = clusters_.size();
+  ProbeResult result = ProbeResult::kNoUpdate;
+  std::vector<Cluster>::const_iterator best_it = FindBestProbe(clusters_);
+  if (best_it != clusters_.end()) {
     int probe_bitrate_bps =
         std::min(best_it->GetSendBitrateBps(), best_it->GetRecvBitrateBps());
     // Make sure that a probe sent on a lower bitrate than our estimate can't
@@ -203,14 +233,26 @@ RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
                        << " ms, num probes: " << best_it->count;
       remote_rate_.SetEstimate(DataRate::bps(probe_bitrate_bps),
                                Timestamp::ms(now_ms));
-      return ProbeResult::kBitrateUpdated;
+      result = ProbeResult::kBitrateUpdated;
     }
   }
+  if (has_open_cluster)
+    clusters_.pop_back();
+
+  if (num_clusters == 0) {
+    // If we reach the max number of probe packets and still have no clusters,
+    // we will remove the oldest one.
+    if (num_probes_ >= kMaxProbePackets)
+      RemoveOldestProbe();
+    return ProbeResult::kNoUpdate;
+  }
+  if (result == ProbeResult::kBitrateUpdated)
+    return result;
 
   // Not probing and received non-probe packet, or finished with current set
   // of probes.
-  if (clusters.size() >= kExpectedNumberOfProbes)
-    probes_.clear();
+  if (num_clusters >= kExpectedNumberOfProbes)
+    ClearProbes();
   return ProbeResult::kNoUpdate;
 }
 
@@ -287,6 +329,8 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
     TimeoutStreams(now_ms);
     RTC_DCHECK(inter_arrival_.get());
     RTC_DCHECK(estimator_.get());
+    if (ssrcs_.empty())
+      earliest_stream_timeout_ms_ = now_ms + kStreamTimeOutMs;
     ssrcs_[ssrc] = now_ms;
 
     // For now only try to detect probes while we don't have a valid estimate.
@@ -300,16 +344,17 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
       if (total_probes_received_ < kMaxProbePackets) {
         int send_delta_ms = -1;
         int recv_delta_ms = -1;
-        if (!probes_.empty()) {
-          send_delta_ms = send_time_ms - probes_.back().send_time_ms;
-          recv_delta_ms = arrival_time_ms - probes_.back().recv_time_ms;
+        if (num_probes_ > 0) {
+          const Probe& last_probe = GetProbe(num_probes_ - 1);
+          send_delta_ms = send_time_ms - last_probe.send_time_ms;
+          recv_delta_ms = arrival_time_ms - last_probe.recv_time_ms;
         }
         RTC_LOG(LS_INFO) << "Probe packet received: send time=" << send_time_ms
                          << " ms, recv time=" << arrival_time_ms
                          << " ms, send delta=" << send_delta_ms
                          << " ms, recv delta=" << recv_delta_ms << " ms.";
       }
-      probes_.push_back(Probe(send_time_ms, arrival_time_ms, payload_size));
+      AddProbe(Probe(send_time_ms, arrival_time_ms, payload_size));
       ++total_probes_received_;
       // Make sure that a probe which updated the bitrate immediately has an
       // effect by calling the OnReceiveBitrateChanged callback.
@@ -370,12 +415,20 @@ int64_t RemoteBitrateEstimatorAbsSendTime::TimeUntilNextProcess() {
 }
 
 void RemoteBitrateEstimatorAbsSendTime::TimeoutStreams(int64_t now_ms) {
-  for (Ssrcs::iterator it = ssrcs_.begin(); it != ssrcs_.end();) {
-    if ((now_ms - it->second) > kStreamTimeOutMs) {
-      ssrcs_.erase(it++);
-    } else {
-      ++it;
+  // The last packet time of a stream only moves forward, so the earliest
+  // timeout computed here stays a lower bound until the streams are checked
+  // again.
+  if (!ssrcs_.empty() && now_ms > earliest_stream_timeout_ms_) {
+    int64_t earliest_last_packet_ms = now_ms;
+    for (Ssrcs::iterator it = ssrcs_.begin(); it != ssrcs_.end();) {
+      if ((now_ms - it->second) > kStreamTimeOutMs) {
+        ssrcs_.erase(it++);
+      } else {
+        earliest_last_packet_ms = std::min(earliest_last_packet_ms, it->second);
+        ++it;
+      }
     }
+    earliest_stream_timeout_ms_ = earliest_last_packet_ms + kStreamTimeOutMs;
   }
   if (ssrcs_.empty()) {
     // We can't update the estimate if we don't have any active streams.
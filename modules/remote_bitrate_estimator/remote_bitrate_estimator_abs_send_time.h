@@ -14,7 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
+#include <array>
 #include <map>
 #include <memory>
 #include <vector>
@@ -37,6 +37,7 @@
 namespace webrtc {
 
 struct Probe {
+  Probe() : Probe(0, 0, 0) {}
   Probe(int64_t send_time_ms, int64_t recv_time_ms, size_t payload_size)
       : send_time_ms(send_time_ms),
         recv_time_ms(recv_time_ms),
@@ -97,20 +98,34 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   typedef std::map<uint32_t, int64_t> Ssrcs;
   enum class ProbeResult { kBitrateUpdated, kNoUpdate };
 
+  // At most this many probes are kept, the oldest being dropped first.
+  static constexpr size_t kMaxStoredProbes = 64;
+
   static bool IsWithinClusterBounds(int send_delta_ms,
                                     const Cluster& cluster_aggregate);
 
-  static void AddCluster(std::list<Cluster>* clusters, Cluster* cluster);
+  static bool IsClusterComplete(const Cluster& cluster);
+
+  // Returns |cluster| with its sums turned into means.
+  static Cluster FinalizeCluster(Cluster cluster);
 
   void IncomingPacketInfo(int64_t arrival_time_ms,
                           uint32_t send_time_24bits,
                           size_t payload_size,
                           uint32_t ssrc);
 
-  void ComputeClusters(std::list<Cluster>* clusters) const;
+  // The probes are stored in a ring buffer, and the clusters are extended as
+  // probes are added instead of being recomputed for every probe. They are
+  // only recomputed when the oldest probe is dropped.
+  const Probe& GetProbe(size_t index) const;
+  void AddProbe(const Probe& probe);
+  void RemoveOldestProbe();
+  void ClearProbes();
+  void AddProbeToClusters(const Probe& prev_probe, const Probe& probe);
+  void ComputeClusters();
 
-  std::list<Cluster>::const_iterator FindBestProbe(
-      const std::list<Cluster>& clusters) const;
+  std::vector<Cluster>::const_iterator FindBestProbe(
+      const std::vector<Cluster>& clusters) const;
 
   // Returns true if a probe which changed the estimate was detected.
   ProbeResult ProcessClusters(int64_t now_ms)
@@ -132,7 +147,13 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   bool incoming_bitrate_initialized_;
   std::vector<int> recent_propagation_delta_ms_;
   std::vector<int64_t> recent_update_time_ms_;
-  std::list<Probe> probes_;
+  std::array<Probe, kMaxStoredProbes> probes_;
+  size_t first_probe_index_;
+  size_t num_probes_;
+  // The complete clusters of |probes_|, and the one that its latest probes
+  // are aggregated into, which isn't divided by its count yet.
+  std::vector<Cluster> clusters_;
+  Cluster open_cluster_;
   size_t total_probes_received_;
   int64_t first_packet_time_ms_;
   int64_t last_update_ms_;
@@ -140,6 +161,9 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
 
   rtc::CriticalSection crit_;
   Ssrcs ssrcs_ RTC_GUARDED_BY(&crit_);
+  // No stream in |ssrcs_| times out before this time, so they only have to be
+  // checked once it has passed.
+  int64_t earliest_stream_timeout_ms_ RTC_GUARDED_BY(&crit_);
   AimdRateControl remote_rate_ RTC_GUARDED_BY(&crit_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RemoteBitrateEstimatorAbsSendTime);
@@ -289,4 +289,35 @@ TEST_F(RemoteBitrateEstimatorAbsSendTimeTest, ProbingIgnoresSmallPackets) {
   EXPECT_TRUE(bitrate_observer_->updated());
   EXPECT_NEAR(bitrate_observer_->latest_bitrate(), 800000u, 10000);
 }
+
+TEST_F(RemoteBitrateEstimatorAbsSendTimeTest,
+       ProbeDetectedOnceFailedProbeIsDropped) {
+  const int kProbeLength = 5;
+  const int kNumPackets = 70;
+  int64_t now_ms = clock_.TimeInMilliseconds();
+  // Burst sent at 8 * 1000 / 1 = 8000 kbps, but arriving at
+  // 8 * 1000 / 10 = 800 kbps, which fails the probe.
+  int64_t send_time_ms = 0;
+  for (int i = 0; i < kProbeLength; ++i) {
+    clock_.AdvanceTimeMilliseconds(10);
+    send_time_ms += 1;
+    now_ms = clock_.TimeInMilliseconds();
+    IncomingPacket(0, 1000, now_ms, 90 * send_time_ms,
+                   AbsSendTime(send_time_ms, 1000));
+  }
+
+  // Followed by packets sent and arriving at 800 kbps, which are detected as
+  // a probe once the failed one has been dropped from the stored probes.
+  for (int i = 0; i < kNumPackets; ++i) {
+    clock_.AdvanceTimeMilliseconds(10);
+    send_time_ms += 10;
+    now_ms = clock_.TimeInMilliseconds();
+    IncomingPacket(0, 1000, now_ms, 90 * send_time_ms,
+                   AbsSendTime(send_time_ms, 1000));
+  }
+
+  bitrate_estimator_->Process();
+  EXPECT_TRUE(bitrate_observer_->updated());
+  EXPECT_NEAR(bitrate_observer_->latest_bitrate(), 800000u, 10000);
+}
 }  // namespace webrtc
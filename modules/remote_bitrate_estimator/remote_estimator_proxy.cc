@@ -23,9 +23,6 @@
 
 namespace webrtc {
 
-// Impossible to request feedback older than what can be represented by 15 bits.
-const int RemoteEstimatorProxy::kMaxNumberOfPackets = (1 << 15);
-
 // The maximum allowed value for a timestamp in milliseconds. This is lower
 // than the numerical limit since we often convert to microseconds.
 static constexpr int64_t kMaxTimeMs =
@@ -70,14 +67,11 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
 
     if (send_periodic_feedback_) {
       if (periodic_window_start_seq_ &&
-          packet_arrival_times_.lower_bound(*periodic_window_start_seq_) ==
-              packet_arrival_times_.end()) {
+          packet_arrival_times_.end_sequence_number() <=
+              *periodic_window_start_seq_) {
         // Start new feedback packet, cull old packets.
-        for (auto it = packet_arrival_times_.begin();
-             it != packet_arrival_times_.end() && it->first < seq &&
-             arrival_time_ms - it->second >= send_config_.back_window->ms();) {
-          it = packet_arrival_times_.erase(it);
-        }
+        packet_arrival_times_.RemoveOldPackets(
+            seq, arrival_time_ms - send_config_.back_window->ms());
       }
       if (!periodic_window_start_seq_ || seq < *periodic_window_start_seq_) {
         periodic_window_start_seq_ = seq;
@@ -85,23 +79,17 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
     }
 
     // We are only interested in the first time a packet is received.
-    if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
+    if (packet_arrival_times_.has_received(seq))
       return;
 
-    packet_arrival_times_[seq] = arrival_time_ms;
-
-    // Limit the range of sequence numbers to send feedback for.
-    auto first_arrival_time_to_keep = packet_arrival_times_.lower_bound(
-        packet_arrival_times_.rbegin()->first - kMaxNumberOfPackets);
-    if (first_arrival_time_to_keep != packet_arrival_times_.begin()) {
-      packet_arrival_times_.erase(packet_arrival_times_.begin(),
-                                  first_arrival_time_to_keep);
-      if (send_periodic_feedback_) {
-        // |packet_arrival_times_| cannot be empty since we just added one
-        // element and the last element is not deleted.
-        RTC_DCHECK(!packet_arrival_times_.empty());
-        periodic_window_start_seq_ = packet_arrival_times_.begin()->first;
-      }
+    packet_arrival_times_.AddPacket(seq, arrival_time_ms);
+
+    // The map limits the range of sequence numbers to send feedback for.
+    if (send_periodic_feedback_ &&
+        *periodic_window_start_seq_ <
+            packet_arrival_times_.begin_sequence_number()) {
+      periodic_window_start_seq_ =
+          packet_arrival_times_.begin_sequence_number();
     }
 
     if (header.extension.feedback_request) {
@@ -199,15 +187,14 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     }
   }
 
-  for (auto begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_);
-       begin_iterator != packet_arrival_times_.cend();
-       begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_)) {
+  while (*periodic_window_start_seq_ <
+         packet_arrival_times_.end_sequence_number()) {
     auto feedback_packet = std::make_unique<rtcp::TransportFeedback>();
     periodic_window_start_seq_ = BuildFeedbackPacket(
         feedback_packet_count_++, media_ssrc_, *periodic_window_start_seq_,
-        begin_iterator, packet_arrival_times_.cend(), feedback_packet.get());
+        std::max(*periodic_window_start_seq_,
+                 packet_arrival_times_.begin_sequence_number()),
+        packet_arrival_times_.end_sequence_number(), feedback_packet.get());
 
     RTC_DCHECK(feedback_sender_ != nullptr);
 
@@ -236,16 +223,15 @@ void RemoteEstimatorProxy::SendFeedbackOnRequest(
 
   int64_t first_sequence_number =
       sequence_number - feedback_request.sequence_count + 1;
-  auto begin_iterator =
-      packet_arrival_times_.lower_bound(first_sequence_number);
-  auto end_iterator = packet_arrival_times_.upper_bound(sequence_number);
-
-  BuildFeedbackPacket(feedback_packet_count_++, media_ssrc_,
-                      first_sequence_number, begin_iterator, end_iterator,
-                      feedback_packet.get());
 
   // Clear up to the first packet that is included in this feedback packet.
-  packet_arrival_times_.erase(packet_arrival_times_.begin(), begin_iterator);
+  packet_arrival_times_.EraseTo(first_sequence_number);
+
+  BuildFeedbackPacket(feedback_packet_count_++, media_ssrc_,
+                      first_sequence_number,
+                      std::max(first_sequence_number,
+                               packet_arrival_times_.begin_sequence_number()),
+                      sequence_number + 1, feedback_packet.get());
 
   RTC_DCHECK(feedback_sender_ != nullptr);
   std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets;
@@ -257,34 +243,44 @@ int64_t RemoteEstimatorProxy::BuildFeedbackPacket(
     uint8_t feedback_packet_count,
     uint32_t media_ssrc,
     int64_t base_sequence_number,
-    std::map<int64_t, int64_t>::const_iterator begin_iterator,
-    std::map<int64_t, int64_t>::const_iterator end_iterator,
-    rtcp::TransportFeedback* feedback_packet) {
-  RTC_DCHECK(begin_iterator != end_iterator);
+    int64_t begin_sequence_number_inclusive,
+    int64_t end_sequence_number_exclusive,
+    rtcp::TransportFeedback* feedback_packet) const {
+  RTC_DCHECK_LT(begin_sequence_number_inclusive, end_sequence_number_exclusive);
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
   feedback_packet->SetMediaSsrc(media_ssrc);
-  // Base sequence number is the expected first sequence number. This is known,
-  // but we might not have actually received it, so the base time shall be the
-  // time of the first received packet in the feedback.
-  feedback_packet->SetBase(static_cast<uint16_t>(base_sequence_number & 0xFFFF),
-                           begin_iterator->second * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_packet_count);
   int64_t next_sequence_number = base_sequence_number;
-  for (auto it = begin_iterator; it != end_iterator; ++it) {
-    if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+  bool is_first_packet = true;
+  for (int64_t seq = begin_sequence_number_inclusive;
+       seq < end_sequence_number_exclusive; ++seq) {
+    if (!packet_arrival_times_.has_received(seq))
+      continue;
+    const int64_t arrival_time_ms = packet_arrival_times_.get(seq);
+    if (is_first_packet) {
+      // Base sequence number is the expected first sequence number. This is
+      // known, but we might not have actually received it, so the base time
+      // shall be the time of the first received packet in the feedback.
+      feedback_packet->SetBase(
+          static_cast<uint16_t>(base_sequence_number & 0xFFFF),
+          arrival_time_ms * 1000);
+    }
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq & 0xFFFF),
+                                            arrival_time_ms * 1000)) {
       // If we can't even add the first seq to the feedback packet, we won't be
       // able to build it at all.
-      RTC_CHECK(begin_iterator != it);
+      RTC_CHECK(!is_first_packet);
 
       // Could not add timestamp, feedback packet might be full. Return and
       // try again with a fresh packet.
       break;
     }
-    next_sequence_number = it->first + 1;
+    is_first_packet = false;
+    next_sequence_number = seq + 1;
   }
+  RTC_DCHECK(!is_first_packet);
   return next_sequence_number;
 }
 
@@ -231,6 +231,9 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
   virtual void SetRtxSendPayloadType(int payload_type,
                                      int associated_payload_type) = 0;
 
+  // Returns the RTX SSRC, if there is one.
+  virtual absl::optional<uint32_t> RtxSsrc() const = 0;
+
   // Returns the FlexFEC SSRC, if there is one.
   virtual absl::optional<uint32_t> FlexfecSsrc() const = 0;
 
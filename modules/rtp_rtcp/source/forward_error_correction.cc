@@ -13,6 +13,8 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
+#include <tuple>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -25,12 +27,69 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/mod_ops.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+// Bounds the memory used by cached packet masks. This is far more than a
+// stream uses at any single protection level.
+constexpr size_t kMaxCachedPacketMasks = 128;
+
+// XORs |size| bytes of |src| into |dst|, 16 bytes at a time where possible.
+void XorBytes(const uint8_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  for (; i + 16 <= size; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i*>(&dst[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), _mm_xor_si128(s, d));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 16 <= size; i += 16) {
+    vst1q_u8(&dst[i], veorq_u8(vld1q_u8(&src[i]), vld1q_u8(&dst[i])));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+// Returns the position in the sorted |packets| after the last packet that is
+// not newer than |seq_num|. The search starts from the back, since packets
+// mostly arrive in order and then this is a single comparison.
+template <typename T>
+typename std::list<std::unique_ptr<T>>::iterator FindInsertionPosition(
+    std::list<std::unique_ptr<T>>* packets,
+    uint16_t seq_num) {
+  auto it = packets->end();
+  while (it != packets->begin() &&
+         IsNewerSequenceNumber((*std::prev(it))->seq_num, seq_num)) {
+    --it;
+  }
+  return it;
+}
+
+// Returns true if |fec_packet| protects the media packet |seq_num|.
+bool IsProtectedBy(const ForwardErrorCorrection::ReceivedFecPacket& fec_packet,
+                   uint16_t seq_num) {
+  for (const auto& protected_packet : fec_packet.protected_packets) {
+    if (protected_packet->seq_num == seq_num) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
@@ -150,19 +209,28 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
     return 0;
   }
   for (int i = 0; i < num_fec_packets; ++i) {
+    // The packets are reused, so this only allocates on the first call. Their
+    // bytes are zeroed as the payloads grow, in GenerateFecPayloads().
     generated_fec_packets_[i].data.EnsureCapacity(IP_PACKET_SIZE);
-    memset(generated_fec_packets_[i].data.data(), 0, IP_PACKET_SIZE);
     // Use this as a marker for untouched packets.
     generated_fec_packets_[i].data.SetSize(0);
     fec_packets->push_back(&generated_fec_packets_[i]);
   }
 
-  internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
   packet_mask_size_ = internal::PacketMaskSize(num_media_packets);
-  memset(packet_masks_, 0, num_fec_packets * packet_mask_size_);
-  internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
-                                num_important_packets, use_unequal_protection,
-                                &mask_table, packet_masks_);
+  if (use_unequal_protection && num_important_packets > 0) {
+    internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+    memset(packet_masks_, 0, num_fec_packets * packet_mask_size_);
+    internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
+                                  num_important_packets, use_unequal_protection,
+                                  &mask_table, packet_masks_);
+  } else {
+    // The equal protection masks only depend on the packet counts and the mask
+    // type, so they are generated once.
+    const std::vector<uint8_t>& packet_masks = EqualProtectionPacketMasks(
+        num_media_packets, num_fec_packets, fec_mask_type);
+    memcpy(packet_masks_, packet_masks.data(), packet_masks.size());
+  }
 
   // Adapt packet masks to missing media packets.
   int num_mask_bits = InsertZerosInPacketMasks(media_packets, num_fec_packets);
@@ -186,6 +254,28 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
   return 0;
 }
 
+const std::vector<uint8_t>& ForwardErrorCorrection::EqualProtectionPacketMasks(
+    int num_media_packets,
+    int num_fec_packets,
+    FecMaskType fec_mask_type) {
+  const auto key =
+      std::make_tuple(num_media_packets, num_fec_packets, fec_mask_type);
+  auto it = packet_mask_cache_.find(key);
+  if (it != packet_mask_cache_.end())
+    return it->second;
+
+  if (packet_mask_cache_.size() >= kMaxCachedPacketMasks)
+    packet_mask_cache_.clear();
+  std::vector<uint8_t> packet_masks(
+      num_fec_packets * internal::PacketMaskSize(num_media_packets), 0);
+  internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+  internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
+                                /*num_imp_packets=*/0,
+                                /*use_unequal_protection=*/false, &mask_table,
+                                packet_masks.data());
+  return packet_mask_cache_.emplace(key, std::move(packet_masks)).first->second;
+}
+
 int ForwardErrorCorrection::NumFecPackets(int num_media_packets,
                                           int protection_factor) {
   // Result in Q0 with an unsigned round.
@@ -225,10 +315,13 @@ void ForwardErrorCorrection::GenerateFecPayloads(
         bool first_protected_packet = (fec_packet->data.size() == 0);
         size_t fec_packet_length = fec_header_size + media_payload_length;
         if (fec_packet_length > fec_packet->data.size()) {
-          // Recall that XORing with zero (which the FEC packets are prefilled
+          // Recall that XORing with zero (which the FEC packets are extended
           // with) is the identity operator, thus all prior XORs are
           // still correct even though we expand the packet length here.
+          const size_t old_length = fec_packet->data.size();
           fec_packet->data.SetSize(fec_packet_length);
+          memset(fec_packet->data.data() + old_length, 0,
+                 fec_packet_length - old_length);
         }
         if (first_protected_packet) {
           uint8_t* data = fec_packet->data.data();
@@ -361,13 +454,14 @@ void ForwardErrorCorrection::InsertMediaPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, protected_media_ssrc_);
 
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    RTC_DCHECK_EQ(recovered_packet->ssrc, received_packet.ssrc);
-    if (recovered_packet->seq_num == received_packet.seq_num) {
-      // Duplicate packet, no need to add to list.
-      return;
-    }
+  // The list is sorted, so a duplicate would be right before the position of
+  // the new packet.
+  auto position =
+      FindInsertionPosition(recovered_packets, received_packet.seq_num);
+  if (position != recovered_packets->begin() &&
+      (*std::prev(position))->seq_num == received_packet.seq_num) {
+    // Duplicate packet, no need to add to list.
+    return;
   }
 
   std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
@@ -378,11 +472,8 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->ssrc = received_packet.ssrc;
   recovered_packet->seq_num = received_packet.seq_num;
   recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
   RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
+  recovered_packets->insert(position, std::move(recovered_packet));
   UpdateCoveringFecPackets(*recovered_packet_ptr);
 }
 
@@ -405,13 +496,14 @@ void ForwardErrorCorrection::InsertFecPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, ssrc_);
 
-  // Check for duplicate.
-  for (const auto& existing_fec_packet : received_fec_packets_) {
-    RTC_DCHECK_EQ(existing_fec_packet->ssrc, received_packet.ssrc);
-    if (existing_fec_packet->seq_num == received_packet.seq_num) {
-      // Drop duplicate FEC packet data.
-      return;
-    }
+  // Check for duplicate. The list is sorted, so it would be right before the
+  // position of the new packet.
+  auto position =
+      FindInsertionPosition(&received_fec_packets_, received_packet.seq_num);
+  if (position != received_fec_packets_.begin() &&
+      (*std::prev(position))->seq_num == received_packet.seq_num) {
+    // Drop duplicate FEC packet data.
+    return;
   }
 
   std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
@@ -461,10 +553,7 @@ void ForwardErrorCorrection::InsertFecPacket(
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
   } else {
     AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
+    received_fec_packets_.insert(position, std::move(fec_packet));
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
       received_fec_packets_.pop_front();
@@ -633,13 +722,12 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   RTC_DCHECK_LE(kRtpHeaderSize + payload_length, src.data.size());
   RTC_DCHECK_LE(dst_offset + payload_length, dst->data.capacity());
   if (dst_offset + payload_length > dst->data.size()) {
+    const size_t old_size = dst->data.size();
     dst->data.SetSize(dst_offset + payload_length);
+    memset(dst->data.data() + old_size, 0, dst->data.size() - old_size);
   }
-  uint8_t* dst_data = dst->data.data();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+           dst->data.data() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -682,22 +770,28 @@ void ForwardErrorCorrection::AttemptRecovery(
         continue;
       }
 
+      const uint16_t recovered_seq_num = recovered_packet->seq_num;
       auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
+      recovered_packets->insert(
+          FindInsertionPosition(recovered_packets, recovered_seq_num),
+          std::move(recovered_packet));
       UpdateCoveringFecPackets(*recovered_packet_ptr);
       DiscardOldRecoveredPackets(recovered_packets);
       fec_packet_it = received_fec_packets_.erase(fec_packet_it);
 
-      // A packet has been recovered. We need to check the FEC list again, as
-      // this may allow additional packets to be recovered.
-      // Restart for first FEC packet.
-      fec_packet_it = received_fec_packets_.begin();
+      // A packet has been recovered, which may allow additional packets to be
+      // recovered. The FEC packets checked so far were each missing at least
+      // two packets, and only those covering the recovered packet can have
+      // changed. Go back to the first of those, if any, instead of starting
+      // over.
+      for (auto it = received_fec_packets_.begin(); it != fec_packet_it; ++it) {
+        if (IsProtectedBy(**it, recovered_seq_num)) {
+          fec_packet_it = it;
+          break;
+        }
+      }
     } else if (packets_missing == 0) {
       // Either all protected packets arrived or have been recovered. We can
       // discard this FEC packet.
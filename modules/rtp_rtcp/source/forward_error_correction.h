@@ -15,7 +15,9 @@
 #include <stdint.h>
 
 #include <list>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "api/scoped_refptr.h"
@@ -253,6 +255,13 @@ class ForwardErrorCorrection {
   int InsertZerosInPacketMasks(const PacketList& media_packets,
                                size_t num_fec_packets);
 
+  // Returns the packet masks for protecting |num_media_packets| equally with
+  // |num_fec_packets|, generating them on first use.
+  const std::vector<uint8_t>& EqualProtectionPacketMasks(
+      int num_media_packets,
+      int num_fec_packets,
+      FecMaskType fec_mask_type);
+
   // Writes FEC payloads and some recovery fields in the FEC headers.
   void GenerateFecPayloads(const PacketList& media_packets,
                            size_t num_fec_packets);
@@ -345,6 +354,10 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+  // Equal protection packet masks, keyed on the number of media packets, the
+  // number of FEC packets and the mask type.
+  std::map<std::tuple<int, int, FecMaskType>, std::vector<uint8_t>>
+      packet_mask_cache_;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
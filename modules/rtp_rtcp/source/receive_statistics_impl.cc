@@ -26,6 +26,9 @@ namespace webrtc {
 
 const int64_t kStatisticsTimeoutMs = 8000;
 const int64_t kStatisticsProcessIntervalMs = 1000;
+// The incoming bitrate is only reported as a stat, so a coarse approximation
+// is good enough and saves memory for every received SSRC.
+const int64_t kBitrateBucketSizeMs = 25;
 
 StreamStatistician::~StreamStatistician() {}
 
@@ -35,7 +38,8 @@ StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
     : ssrc_(ssrc),
       clock_(clock),
       incoming_bitrate_(kStatisticsProcessIntervalMs,
-                        RateStatistics::kBpsScale),
+                        RateStatistics::kBpsScale,
+                        kBitrateBucketSizeMs),
       max_reordering_threshold_(max_reordering_threshold),
       enable_retransmit_detection_(false),
       jitter_q4_(0),
@@ -100,9 +104,10 @@ bool StreamStatisticianImpl::UpdateOutOfOrder(const RtpPacketReceived& packet,
 }
 
 void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
-  rtc::CritScope cs(&stream_lock_);
   RTC_DCHECK_EQ(ssrc_, packet.Ssrc());
+  // Read before taking the lock, to keep the time it is held for short.
   int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope cs(&stream_lock_);
 
   incoming_bitrate_.Update(packet.size(), now_ms);
   receive_counters_.last_packet_received_timestamp_ms = now_ms;
@@ -301,7 +306,10 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_returned_ssrc_(0),
-      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {}
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {
+  for (auto& cached_statistician : cached_statisticians_)
+    cached_statistician.store(nullptr, std::memory_order_relaxed);
+}
 
 ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   while (!statisticians_.empty()) {
@@ -320,32 +328,68 @@ void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetStatistician(
     uint32_t ssrc) const {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  const auto& it = statisticians_.find(ssrc);
-  if (it == statisticians_.end())
-    return NULL;
-  return it->second;
+  StreamStatisticianImpl* impl = GetCachedStatistician(ssrc);
+  if (impl)
+    return impl;
+  {
+    rtc::CritScope cs(&receive_statistics_lock_);
+    const auto& it = statisticians_.find(ssrc);
+    if (it == statisticians_.end())
+      return NULL;
+    impl = it->second;
+  }
+  CacheStatistician(impl);
+  return impl;
 }
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetOrCreateStatistician(
     uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  StreamStatisticianImpl*& impl = statisticians_[ssrc];
-  if (impl == nullptr) {  // new element
-    impl = new StreamStatisticianImpl(ssrc, clock_, max_reordering_threshold_);
+  StreamStatisticianImpl* impl = GetCachedStatistician(ssrc);
+  if (impl)
+    return impl;
+  {
+    rtc::CritScope cs(&receive_statistics_lock_);
+    StreamStatisticianImpl*& entry = statisticians_[ssrc];
+    if (entry == nullptr) {  // new element
+      entry =
+          new StreamStatisticianImpl(ssrc, clock_, max_reordering_threshold_);
+    }
+    impl = entry;
   }
+  CacheStatistician(impl);
   return impl;
 }
 
+StreamStatisticianImpl* ReceiveStatisticsImpl::GetCachedStatistician(
+    uint32_t ssrc) const {
+  // Acquire, to see the statistician as it was created by the thread that
+  // cached it.
+  StreamStatisticianImpl* impl =
+      cached_statisticians_[ssrc % kNumCachedStatisticians].load(
+          std::memory_order_acquire);
+  return impl && impl->ssrc() == ssrc ? impl : nullptr;
+}
+
+void ReceiveStatisticsImpl::CacheStatistician(
+    StreamStatisticianImpl* statistician) const {
+  cached_statisticians_[statistician->ssrc() % kNumCachedStatisticians].store(
+      statistician, std::memory_order_release);
+}
+
+std::vector<std::pair<uint32_t, StreamStatisticianImpl*>>
+ReceiveStatisticsImpl::AllStatisticians() const {
+  rtc::CritScope cs(&receive_statistics_lock_);
+  return std::vector<std::pair<uint32_t, StreamStatisticianImpl*>>(
+      statisticians_.begin(), statisticians_.end());
+}
+
 void ReceiveStatisticsImpl::SetMaxReorderingThreshold(
     int max_reordering_threshold) {
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians;
   {
     rtc::CritScope cs(&receive_statistics_lock_);
     max_reordering_threshold_ = max_reordering_threshold;
-    statisticians = statisticians_;
   }
-  for (auto& statistician : statisticians) {
+  for (auto& statistician : AllStatisticians()) {
     statistician.second->SetMaxReorderingThreshold(max_reordering_threshold);
   }
 }
@@ -364,11 +408,11 @@ void ReceiveStatisticsImpl::EnableRetransmitDetection(uint32_t ssrc,
 
 std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     size_t max_blocks) {
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians;
-  {
-    rtc::CritScope cs(&receive_statistics_lock_);
-    statisticians = statisticians_;
-  }
+  // The statisticians are read one at a time, without holding
+  // |receive_statistics_lock_|, so that new SSRCs on the packet path do not
+  // wait for the report.
+  const std::vector<std::pair<uint32_t, StreamStatisticianImpl*>>
+      statisticians = AllStatisticians();
   std::vector<rtcp::ReportBlock> result;
   result.reserve(std::min(max_blocks, statisticians.size()));
   auto add_report_block = [&result](uint32_t media_ssrc,
@@ -390,7 +434,12 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     block.SetJitter(stats.jitter);
   };
 
-  const auto start_it = statisticians.upper_bound(last_returned_ssrc_);
+  const auto start_it = std::upper_bound(
+      statisticians.begin(), statisticians.end(), last_returned_ssrc_,
+      [](uint32_t ssrc,
+         const std::pair<uint32_t, StreamStatisticianImpl*>& statistician) {
+        return ssrc < statistician.first;
+      });
   for (auto it = start_it;
        result.size() < max_blocks && it != statisticians.end(); ++it)
     add_report_block(it->first, it->second);
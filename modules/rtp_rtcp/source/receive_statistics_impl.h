@@ -12,7 +12,10 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -31,6 +34,8 @@ class StreamStatisticianImpl : public StreamStatistician {
                          int max_reordering_threshold);
   ~StreamStatisticianImpl() override;
 
+  uint32_t ssrc() const { return ssrc_; }
+
   RtpReceiveStats GetStats() const override;
 
   bool GetActiveStatisticsAndReset(RtcpStatistics* statistics);
@@ -108,7 +113,9 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   // Implements ReceiveStatisticsProvider.
   std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
 
-  // Implements RtpPacketSinkInterface
+  // Implements RtpPacketSinkInterface. Normally does not take
+  // |receive_statistics_lock_|, only the lock of the statistician, which is
+  // not contended unless the stats of the same SSRC are being read.
   void OnRtpPacket(const RtpPacketReceived& packet) override;
 
   // Implements ReceiveStatistics.
@@ -120,9 +127,23 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
  private:
+  // Statisticians for a few SSRCs, cached so that the packet path can find
+  // them without taking |receive_statistics_lock_|. An SSRC can only be in its
+  // own slot, and a statistician is only deleted with |this|, so that a cached
+  // pointer with a matching SSRC stays valid.
+  static constexpr size_t kNumCachedStatisticians = 8;
+
   StreamStatisticianImpl* GetOrCreateStatistician(uint32_t ssrc);
+  StreamStatisticianImpl* GetCachedStatistician(uint32_t ssrc) const;
+  void CacheStatistician(StreamStatisticianImpl* statistician) const;
+  // Returns the statisticians ordered by SSRC.
+  std::vector<std::pair<uint32_t, StreamStatisticianImpl*>> AllStatisticians()
+      const;
 
   Clock* const clock_;
+  mutable std::array<std::atomic<StreamStatisticianImpl*>,
+                     kNumCachedStatisticians>
+      cached_statisticians_;
   rtc::CriticalSection receive_statistics_lock_;
   uint32_t last_returned_ssrc_;
   int max_reordering_threshold_ RTC_GUARDED_BY(receive_statistics_lock_);
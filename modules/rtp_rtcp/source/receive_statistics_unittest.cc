@@ -133,6 +133,31 @@ TEST_F(ReceiveStatisticsTest, TwoIncomingSsrcs) {
   EXPECT_EQ(3u, counters.transmitted.packets);
 }
 
+TEST_F(ReceiveStatisticsTest, SsrcsWithSameLowBitsAreCountedSeparately) {
+  // SSRCs that differ only in their high bits, interleaved so that each packet
+  // replaces the statistician that the previous one looked up.
+  const uint32_t kSsrcs[] = {kSsrc1, kSsrc1 + 0x100, kSsrc1 + 0x10000};
+  RtpPacketReceived packets[] = {CreateRtpPacket(kSsrcs[0], kPacketSize1),
+                                 CreateRtpPacket(kSsrcs[1], kPacketSize1),
+                                 CreateRtpPacket(kSsrcs[2], kPacketSize1)};
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j <= i; ++j) {
+      receive_statistics_->OnRtpPacket(packets[j]);
+      IncrementSequenceNumber(&packets[j]);
+    }
+  }
+
+  for (size_t i = 0; i < 3; ++i) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(kSsrcs[i]);
+    ASSERT_TRUE(statistician);
+    EXPECT_EQ(3u - i,
+              statistician->GetReceiveStreamDataCounters().transmitted.packets);
+  }
+  EXPECT_FALSE(receive_statistics_->GetStatistician(kSsrc1 + 0x1000000));
+  EXPECT_THAT(receive_statistics_->RtcpReportBlocks(5), SizeIs(3));
+}
+
 TEST_F(ReceiveStatisticsTest,
        RtcpReportBlocksReturnsMaxBlocksWhenThereAreMoreStatisticians) {
   RtpPacketReceived packet1 = CreateRtpPacket(kSsrc1, kPacketSize1);
@@ -153,6 +153,12 @@ uint16_t TransportFeedback::LastChunk::EncodeLast() const {
   return EncodeOneBit();
 }
 
+TransportFeedback::LastChunk::DeltaSize
+TransportFeedback::LastChunk::delta_size(size_t index) const {
+  RTC_DCHECK_LT(index, size_);
+  return all_same_ ? delta_sizes_[0] : delta_sizes_[index];
+}
+
 // Appends content of the Lastchunk to |deltas|.
 void TransportFeedback::LastChunk::AppendTo(
     std::vector<DeltaSize>* deltas) const {
@@ -413,39 +419,70 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
 
-  std::vector<uint8_t> delta_sizes;
-  delta_sizes.reserve(status_count);
-  while (delta_sizes.size() < status_count) {
+  // Walk the chunks once to validate them and to size the receive deltas, so
+  // that the packets can be decoded straight into storage of the right size.
+  const size_t chunks_index = index;
+  size_t num_chunks = 0;
+  size_t num_received = 0;
+  size_t recv_delta_size = 0;
+  for (size_t num_decoded = 0; num_decoded < status_count;) {
     if (index + kChunkSizeBytes > end_index) {
       RTC_LOG(LS_WARNING) << "Buffer overflow while parsing packet.";
       Clear();
       return false;
     }
-
     uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[index]);
     index += kChunkSizeBytes;
-    encoded_chunks_.push_back(chunk);
-    last_chunk_.Decode(chunk, status_count - delta_sizes.size());
-    last_chunk_.AppendTo(&delta_sizes);
+    ++num_chunks;
+    last_chunk_.Decode(chunk, status_count - num_decoded);
+    for (size_t i = 0; i < last_chunk_.size(); ++i) {
+      DeltaSize delta_size = last_chunk_.delta_size(i);
+      recv_delta_size += delta_size;
+      if (delta_size > 0)
+        ++num_received;
+    }
+    num_decoded += last_chunk_.size();
   }
-  // Last chunk is stored in the |last_chunk_|.
-  encoded_chunks_.pop_back();
-  RTC_DCHECK_EQ(delta_sizes.size(), status_count);
   num_seq_no_ = status_count;
+  // Last chunk is stored in the |last_chunk_|.
+  encoded_chunks_.reserve(num_chunks - 1);
+  received_packets_.reserve(num_received);
+  if (include_lost_)
+    all_packets_.reserve(status_count);
 
-  uint16_t seq_no = base_seq_no_;
-  size_t recv_delta_size = 0;
-  for (size_t delta_size : delta_sizes) {
-    recv_delta_size += delta_size;
+  // Determine if timestamps, that is, recv_delta are included in the packet.
+  const bool has_recv_deltas = end_index >= index + recv_delta_size;
+  if (!has_recv_deltas) {
+    // The packet does not contain receive deltas.
+    include_timestamps_ = false;
   }
 
-  // Determine if timestamps, that is, recv_delta are included in the packet.
-  if (end_index >= index + recv_delta_size) {
-    for (size_t delta_size : delta_sizes) {
-      if (index + delta_size > end_index) {
-        RTC_LOG(LS_WARNING) << "Buffer overflow while parsing packet.";
-        Clear();
-        return false;
+  uint16_t seq_no = base_seq_no_;
+  size_t num_delta_sizes = 0;
+  size_t chunk_index = chunks_index;
+  LastChunk chunk_decoder;
+  for (size_t c = 0; c < num_chunks; ++c) {
+    uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[chunk_index]);
+    chunk_index += kChunkSizeBytes;
+    if (c + 1 < num_chunks)
+      encoded_chunks_.push_back(chunk);
+    chunk_decoder.Decode(chunk, status_count - num_delta_sizes);
+    num_delta_sizes += chunk_decoder.size();
+    for (size_t i = 0; i < chunk_decoder.size(); ++i, ++seq_no) {
+      DeltaSize delta_size = chunk_decoder.delta_size(i);
+      if (!has_recv_deltas) {
+        // Use delta sizes to detect if packet was received.
+        if (delta_size > 0) {
+          received_packets_.emplace_back(seq_no, 0);
+        }
+        if (include_lost_) {
+          if (delta_size > 0) {
+            all_packets_.emplace_back(seq_no, 0);
+          } else {
+            all_packets_.emplace_back(seq_no);
+          }
+        }
+        continue;
       }
       switch (delta_size) {
         case 0:
@@ -479,24 +516,6 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
           RTC_NOTREACHED();
           break;
       }
-      ++seq_no;
-    }
-  } else {
-    // The packet does not contain receive deltas.
-    include_timestamps_ = false;
-    for (size_t delta_size : delta_sizes) {
-      // Use delta sizes to detect if packet was received.
-      if (delta_size > 0) {
-        received_packets_.emplace_back(seq_no, 0);
-      }
-      if (include_lost_) {
-        if (delta_size > 0) {
-          all_packets_.emplace_back(seq_no, 0);
-        } else {
-          all_packets_.emplace_back(seq_no);
-        }
-      }
-      ++seq_no;
     }
   }
   size_bytes_ = RtcpPacket::kHeaderLength + index;
@@ -127,6 +127,9 @@ class TransportFeedback : public Rtpfb {
     void Decode(uint16_t chunk, size_t max_size);
     // Appends content of the Lastchunk to |deltas|.
     void AppendTo(std::vector<DeltaSize>* deltas) const;
+    // Number of stored delta sizes, and the delta size at |index|.
+    size_t size() const { return size_; }
+    DeltaSize delta_size(size_t index) const;
 
    private:
     static constexpr size_t kMaxRunLengthCapacity = 0x1fff;
@@ -77,6 +77,12 @@ std::set<uint32_t> GetRegisteredSsrcs(const RtpRtcp::Configuration& config) {
   }
   return ssrcs;
 }
+
+// Key of the report block |remote_ssrc| sent about |source_ssrc|. Ordered by
+// source SSRC first.
+uint64_t ReportBlockKey(uint32_t source_ssrc, uint32_t remote_ssrc) {
+  return (static_cast<uint64_t>(source_ssrc) << 32) | remote_ssrc;
+}
 }  // namespace
 
 struct RTCPReceiver::PacketInformation {
@@ -205,15 +211,12 @@ int32_t RTCPReceiver::RTT(uint32_t remote_ssrc,
                           int64_t* max_rtt_ms) const {
   rtc::CritScope lock(&rtcp_receiver_lock_);
 
-  auto it = received_report_blocks_.find(main_ssrc_);
+  auto it =
+      received_report_blocks_.find(ReportBlockKey(main_ssrc_, remote_ssrc));
   if (it == received_report_blocks_.end())
     return -1;
 
-  auto it_info = it->second.find(remote_ssrc);
-  if (it_info == it->second.end())
-    return -1;
-
-  const ReportBlockData* report_block_data = &it_info->second;
+  const ReportBlockData* report_block_data = &it->second;
 
   if (report_block_data->num_rtts() == 0)
     return -1;
@@ -307,18 +310,19 @@ int32_t RTCPReceiver::StatisticsReceived(
     std::vector<RTCPReportBlock>* receive_blocks) const {
   RTC_DCHECK(receive_blocks);
   rtc::CritScope lock(&rtcp_receiver_lock_);
-  for (const auto& reports_per_receiver : received_report_blocks_)
-    for (const auto& report : reports_per_receiver.second)
-      receive_blocks->push_back(report.second.report_block());
+  receive_blocks->reserve(receive_blocks->size() +
+                          received_report_blocks_.size());
+  for (const auto& report : received_report_blocks_)
+    receive_blocks->push_back(report.second.report_block());
   return 0;
 }
 
 std::vector<ReportBlockData> RTCPReceiver::GetLatestReportBlockData() const {
   std::vector<ReportBlockData> result;
   rtc::CritScope lock(&rtcp_receiver_lock_);
-  for (const auto& reports_per_receiver : received_report_blocks_)
-    for (const auto& report : reports_per_receiver.second)
-      result.push_back(report.second);
+  result.reserve(received_report_blocks_.size());
+  for (const auto& report : received_report_blocks_)
+    result.push_back(report.second);
   return result;
 }
 
@@ -498,7 +502,8 @@ void RTCPReceiver::HandleReportBlock(const ReportBlock& report_block,
   last_received_rb_ms_ = clock_->TimeInMilliseconds();
 
   ReportBlockData* report_block_data =
-      &received_report_blocks_[report_block.source_ssrc()][remote_ssrc];
+      &received_report_blocks_[ReportBlockKey(report_block.source_ssrc(),
+                                              remote_ssrc)];
   RTCPReportBlock rtcp_report_block;
   rtcp_report_block.sender_ssrc = remote_ssrc;
   rtcp_report_block.source_ssrc = report_block.source_ssrc();
@@ -718,8 +723,10 @@ void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
   }
 
   // Clear our lists.
-  for (auto& reports_per_receiver : received_report_blocks_)
-    reports_per_receiver.second.erase(bye.sender_ssrc());
+  for (uint32_t source_ssrc : registered_ssrcs_) {
+    received_report_blocks_.erase(
+        ReportBlockKey(source_ssrc, bye.sender_ssrc()));
+  }
 
   TmmbrInformation* tmmbr_info = GetTmmbrInformation(bye.sender_ssrc());
   if (tmmbr_info)
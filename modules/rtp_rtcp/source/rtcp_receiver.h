@@ -119,10 +119,9 @@ class RTCPReceiver {
   struct TmmbrInformation;
   struct RrtrInformation;
   struct LastFirStatus;
-  // RTCP report blocks mapped by remote SSRC.
-  using ReportBlockDataMap = std::map<uint32_t, ReportBlockData>;
-  // RTCP report blocks map mapped by source SSRC.
-  using ReportBlockMap = std::map<uint32_t, ReportBlockDataMap>;
+  // RTCP report blocks mapped by source SSRC, in the upper 32 bits of the key,
+  // and remote SSRC. A single map needs one search per received report block.
+  using ReportBlockMap = std::map<uint64_t, ReportBlockData>;
 
   bool ParseCompoundPacket(const uint8_t* packet_begin,
                            const uint8_t* packet_end,
@@ -90,6 +90,14 @@ struct RtcpTransceiverConfig {
   // Period between periodic compound packets.
   int report_period_ms = 1000;
 
+  // Maximum number of report blocks in a periodic compound packet. When they
+  // do not fit in one receiver report and one packet of |max_packet_size|,
+  // the compound packet is split over several packets that each start with
+  // receiver reports and carry the rest of the compound packet, e.g. for a
+  // transport that receives many streams. Defaults to the capacity of a
+  // single receiver report.
+  size_t max_report_blocks = 31;
+
   //
   // Flags for features and experiments.
   //
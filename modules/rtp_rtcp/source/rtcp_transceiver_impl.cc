@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtcp_transceiver_impl.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -44,6 +46,21 @@ struct SenderReportTimes {
   NtpTime remote_sent_time;
 };
 
+// Returns how many report blocks fit in |size| bytes of receiver reports.
+size_t MaxReportBlocksInSize(size_t size) {
+  // Size of a receiver report without report blocks.
+  constexpr size_t kRrBaseLength = 8;
+  constexpr size_t kMaxBlocksPerRr =
+      rtcp::ReceiverReport::kMaxNumberOfReportBlocks;
+  constexpr size_t kFullRrLength =
+      kRrBaseLength + kMaxBlocksPerRr * rtcp::ReportBlock::kLength;
+  size_t num_blocks = (size / kFullRrLength) * kMaxBlocksPerRr;
+  size_t remaining_size = size % kFullRrLength;
+  if (remaining_size > kRrBaseLength)
+    num_blocks += (remaining_size - kRrBaseLength) / rtcp::ReportBlock::kLength;
+  return num_blocks;
+}
+
 }  // namespace
 
 struct RtcpTransceiverImpl::RemoteSenderState {
@@ -336,38 +353,76 @@ void RtcpTransceiverImpl::SchedulePeriodicCompoundPackets(int64_t delay_ms) {
       });
 }
 
-void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender) {
+void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender,
+                                               size_t max_report_blocks) {
   RTC_DCHECK(sender->IsEmpty());
   const uint32_t sender_ssrc = config_.feedback_ssrc;
   int64_t now_us = rtc::TimeMicros();
-  rtcp::ReceiverReport receiver_report;
-  receiver_report.SetSenderSsrc(sender_ssrc);
-  receiver_report.SetReportBlocks(CreateReportBlocks(now_us));
-  sender->AppendPacket(receiver_report);
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(now_us, max_report_blocks);
 
+  // Packets that follow the receiver reports in every compound packet.
+  absl::optional<rtcp::Sdes> sdes;
   if (!config_.cname.empty()) {
-    rtcp::Sdes sdes;
-    bool added = sdes.AddCName(config_.feedback_ssrc, config_.cname);
+    sdes.emplace();
+    bool added = sdes->AddCName(config_.feedback_ssrc, config_.cname);
     RTC_DCHECK(added) << "Failed to add cname " << config_.cname
                       << " to rtcp sdes packet.";
-    sender->AppendPacket(sdes);
   }
-  if (remb_) {
+  if (remb_)
     remb_->SetSenderSsrc(sender_ssrc);
-    sender->AppendPacket(*remb_);
-  }
   // TODO(bugs.webrtc.org/8239): Do not send rrtr if this packet starts with
   // SenderReport instead of ReceiverReport
   // when RtcpTransceiver supports rtp senders.
+  absl::optional<rtcp::ExtendedReports> xr;
   if (config_.non_sender_rtt_measurement) {
-    rtcp::ExtendedReports xr;
+    xr.emplace();
 
     rtcp::Rrtr rrtr;
     rrtr.SetNtp(TimeMicrosToNtp(now_us));
-    xr.SetRrtr(rrtr);
+    xr->SetRrtr(rrtr);
 
-    xr.SetSenderSsrc(sender_ssrc);
-    sender->AppendPacket(xr);
+    xr->SetSenderSsrc(sender_ssrc);
+  }
+  size_t trailing_packets_size = 0;
+  if (sdes)
+    trailing_packets_size += sdes->BlockLength();
+  if (remb_)
+    trailing_packets_size += remb_->BlockLength();
+  if (xr)
+    trailing_packets_size += xr->BlockLength();
+  const size_t max_blocks_per_packet = std::max<size_t>(
+      1, MaxReportBlocksInSize(config_.max_packet_size -
+                               std::min(config_.max_packet_size,
+                                        trailing_packets_size)));
+
+  auto block_it = report_blocks.begin();
+  while (true) {
+    size_t num_packet_blocks = std::min<size_t>(
+        std::distance(block_it, report_blocks.end()), max_blocks_per_packet);
+    do {
+      size_t num_report_blocks =
+          std::min(num_packet_blocks,
+                   rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+      rtcp::ReceiverReport receiver_report;
+      receiver_report.SetSenderSsrc(sender_ssrc);
+      receiver_report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+          block_it, block_it + num_report_blocks));
+      sender->AppendPacket(receiver_report);
+      block_it += num_report_blocks;
+      num_packet_blocks -= num_report_blocks;
+    } while (num_packet_blocks > 0);
+
+    if (sdes)
+      sender->AppendPacket(*sdes);
+    if (remb_)
+      sender->AppendPacket(*remb_);
+    if (xr)
+      sender->AppendPacket(*xr);
+
+    if (block_it == report_blocks.end())
+      break;
+    sender->Send();
   }
 }
 
@@ -376,7 +431,7 @@ void RtcpTransceiverImpl::SendPeriodicCompoundPacket() {
     config_.outgoing_transport->SendRtcp(packet.data(), packet.size());
   };
   PacketSender sender(send_packet, config_.max_packet_size);
-  CreateCompoundPacket(&sender);
+  CreateCompoundPacket(&sender, config_.max_report_blocks);
   sender.Send();
 }
 
@@ -401,9 +456,13 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
   };
   PacketSender sender(send_packet, config_.max_packet_size);
   // Compound mode requires every sent rtcp packet to be compound, i.e. start
-  // with a sender or receiver report.
-  if (config_.rtcp_mode == RtcpMode::kCompound)
-    CreateCompoundPacket(&sender);
+  // with a sender or receiver report. Limit it to a single receiver report to
+  // keep the feedback small.
+  if (config_.rtcp_mode == RtcpMode::kCompound) {
+    CreateCompoundPacket(
+        &sender, std::min(config_.max_report_blocks,
+                          rtcp::ReceiverReport::kMaxNumberOfReportBlocks));
+  }
 
   sender.AppendPacket(rtcp_packet);
   sender.Send();
@@ -414,14 +473,12 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
 }
 
 std::vector<rtcp::ReportBlock> RtcpTransceiverImpl::CreateReportBlocks(
-    int64_t now_us) {
+    int64_t now_us,
+    size_t max_report_blocks) {
   if (!config_.receive_statistics)
     return {};
-  // TODO(danilchap): Support sending more than
-  // |ReceiverReport::kMaxNumberOfReportBlocks| per compound rtcp packet.
   std::vector<rtcp::ReportBlock> report_blocks =
-      config_.receive_statistics->RtcpReportBlocks(
-          rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+      config_.receive_statistics->RtcpReportBlocks(max_report_blocks);
   uint32_t last_sr = 0;
   uint32_t last_delay = 0;
   for (rtcp::ReportBlock& report_block : report_blocks) {
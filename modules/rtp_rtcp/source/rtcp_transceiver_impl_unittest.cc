@@ -18,6 +18,7 @@
 #include "modules/rtp_rtcp/mocks/mock_rtcp_rtt_stats.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
 #include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/event.h"
@@ -32,6 +33,7 @@ namespace {
 
 using ::testing::_;
 using ::testing::ElementsAre;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SizeIs;
 using ::testing::StrictMock;
@@ -492,6 +494,78 @@ TEST(RtcpTransceiverImplTest, ReceiverReportUsesReceiveStatistics) {
             kMediaSsrc);
 }
 
+TEST(RtcpTransceiverImplTest,
+     SplitsManyReportBlocksOverCompoundPacketsStartingWithReceiverReport) {
+  constexpr size_t kNumReportBlocks = 100;
+  MockReceiveStatisticsProvider receive_statistics;
+  std::vector<ReportBlock> report_blocks(kNumReportBlocks);
+  for (size_t i = 0; i < kNumReportBlocks; ++i)
+    report_blocks[i].SetMediaSsrc(1000 + i);
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(kNumReportBlocks))
+      .WillOnce(Return(report_blocks));
+
+  size_t num_sent_report_blocks = 0;
+  int num_packets = 0;
+  MockTransport transport;
+  EXPECT_CALL(transport, SendRtcp)
+      .WillRepeatedly(Invoke([&](const uint8_t* data, size_t size) {
+        ++num_packets;
+        EXPECT_LE(size, 1200u);
+        RtcpPacketParser rtcp_parser;
+        EXPECT_TRUE(rtcp_parser.Parse(data, size));
+        // Every packet is a compound packet of its own.
+        EXPECT_EQ(data[1], webrtc::rtcp::ReceiverReport::kPacketType);
+        EXPECT_EQ(rtcp_parser.sdes()->num_packets(), 1);
+
+        webrtc::rtcp::CommonHeader rtcp_block;
+        for (const uint8_t* next = data; next != data + size;
+             next = rtcp_block.NextPacket()) {
+          if (!rtcp_block.Parse(next, data + size - next)) {
+            ADD_FAILURE() << "Failed to parse rtcp packet.";
+            break;
+          }
+          if (rtcp_block.type() == webrtc::rtcp::ReceiverReport::kPacketType)
+            num_sent_report_blocks += rtcp_block.count();
+        }
+        return true;
+      }));
+
+  RtcpTransceiverConfig config = DefaultTestConfig();
+  config.cname = "transceiver";
+  config.max_packet_size = 1200;
+  config.max_report_blocks = kNumReportBlocks;
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  EXPECT_EQ(num_packets, 3);
+  EXPECT_EQ(num_sent_report_blocks, kNumReportBlocks);
+}
+
+TEST(RtcpTransceiverImplTest, ImmediateFeedbackSendsSingleReceiverReport) {
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics,
+              RtcpReportBlocks(webrtc::rtcp::ReceiverReport::
+                                   kMaxNumberOfReportBlocks))
+      .WillOnce(Return(std::vector<ReportBlock>(1)));
+
+  RtcpTransceiverConfig config = DefaultTestConfig();
+  config.max_report_blocks = 100;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendPictureLossIndication(/*ssrc=*/4321);
+
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.pli()->num_packets(), 1);
+}
+
 TEST(RtcpTransceiverImplTest, MultipleObserversOnSameSsrc) {
   const uint32_t kRemoteSsrc = 12345;
   StrictMock<MockMediaReceiverRtcpObserver> observer1;
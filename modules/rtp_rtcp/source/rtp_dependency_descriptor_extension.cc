@@ -32,6 +32,13 @@ bool RtpDependencyDescriptorExtension::Parse(
   return reader.ParseSuccessful();
 }
 
+bool RtpDependencyDescriptorExtension::ParseFrameLayer(
+    rtc::ArrayView<const uint8_t> data,
+    const FrameDependencyStructure& structure,
+    DependencyDescriptorFrameLayer* layer) {
+  return RtpDependencyDescriptorReader::ReadFrameLayer(data, structure, layer);
+}
+
 size_t RtpDependencyDescriptorExtension::ValueSize(
     const FrameDependencyStructure& structure,
     const DependencyDescriptor& descriptor) {
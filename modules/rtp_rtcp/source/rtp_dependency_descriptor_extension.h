@@ -17,6 +17,16 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 
 namespace webrtc {
+// Fields of the dependency descriptor that are enough to decide whether to
+// forward a packet of a layered stream.
+struct DependencyDescriptorFrameLayer {
+  bool first_packet_in_frame = true;
+  bool last_packet_in_frame = true;
+  int frame_number = 0;
+  int spatial_id = 0;
+  int temporal_id = 0;
+};
+
 // Trait to read/write the dependency descriptor extension as described in
 // https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension
 // While the format is still in design, the code might change without backward
@@ -33,6 +43,16 @@ class RtpDependencyDescriptorExtension {
                     const FrameDependencyStructure* structure,
                     DependencyDescriptor* descriptor);
 
+  // Reads only the mandatory fields and looks up the layer of the frame in
+  // |structure|, without reading the rest of the descriptor. This is meant for
+  // forwarding decisions, e.g. layer filtering in an SFU, on every packet.
+  // Returns false if the descriptor is malformed or refers to a template that
+  // |structure| does not have, and also if it attaches a new structure, in
+  // which case Parse should be used to get it.
+  static bool ParseFrameLayer(rtc::ArrayView<const uint8_t> data,
+                              const FrameDependencyStructure& structure,
+                              DependencyDescriptorFrameLayer* layer);
+
   static size_t ValueSize(const FrameDependencyStructure& structure,
                           const DependencyDescriptor& descriptor);
   static bool Write(rtc::ArrayView<uint8_t> data,
@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+
+#include <memory>
+#include <vector>
+
+#include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+FrameDependencyStructure TwoSpatialLayersStructure() {
+  FrameDependencyStructure structure;
+  structure.structure_id = 5;
+  structure.num_decode_targets = 2;
+  structure.templates.resize(3);
+  structure.templates[0].spatial_id = 0;
+  structure.templates[0].decode_target_indications =
+      GenericFrameInfo::DecodeTargetInfo("SS");
+  structure.templates[1].spatial_id = 0;
+  structure.templates[1].decode_target_indications =
+      GenericFrameInfo::DecodeTargetInfo("SS");
+  structure.templates[1].frame_diffs = {2};
+  structure.templates[2].spatial_id = 1;
+  structure.templates[2].decode_target_indications =
+      GenericFrameInfo::DecodeTargetInfo("-S");
+  structure.templates[2].frame_diffs = {1};
+  return structure;
+}
+
+std::vector<uint8_t> Write(const FrameDependencyStructure& structure,
+                           const DependencyDescriptor& descriptor) {
+  std::vector<uint8_t> buffer(
+      RtpDependencyDescriptorExtension::ValueSize(structure, descriptor));
+  EXPECT_TRUE(
+      RtpDependencyDescriptorExtension::Write(buffer, structure, descriptor));
+  return buffer;
+}
+
+TEST(RtpDependencyDescriptorExtensionTest, ParseFrameLayerMatchesParse) {
+  const FrameDependencyStructure structure = TwoSpatialLayersStructure();
+  DependencyDescriptor descriptor;
+  descriptor.first_packet_in_frame = true;
+  descriptor.last_packet_in_frame = false;
+  descriptor.frame_number = 0x1234;
+  descriptor.frame_dependencies = structure.templates[2];
+  const std::vector<uint8_t> buffer = Write(structure, descriptor);
+
+  DependencyDescriptor parsed;
+  ASSERT_TRUE(
+      RtpDependencyDescriptorExtension::Parse(buffer, &structure, &parsed));
+  DependencyDescriptorFrameLayer layer;
+  ASSERT_TRUE(RtpDependencyDescriptorExtension::ParseFrameLayer(
+      buffer, structure, &layer));
+  EXPECT_EQ(layer.first_packet_in_frame, parsed.first_packet_in_frame);
+  EXPECT_EQ(layer.last_packet_in_frame, parsed.last_packet_in_frame);
+  EXPECT_EQ(layer.frame_number, 0x1234);
+  EXPECT_EQ(layer.spatial_id, 1);
+  EXPECT_EQ(layer.temporal_id, 0);
+}
+
+TEST(RtpDependencyDescriptorExtensionTest,
+     ParseFrameLayerReadsFramesWithCustomDependencies) {
+  const FrameDependencyStructure structure = TwoSpatialLayersStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_dependencies = structure.templates[2];
+  descriptor.frame_dependencies.frame_diffs = {3};
+  const std::vector<uint8_t> buffer = Write(structure, descriptor);
+
+  DependencyDescriptorFrameLayer layer;
+  ASSERT_TRUE(RtpDependencyDescriptorExtension::ParseFrameLayer(
+      buffer, structure, &layer));
+  EXPECT_EQ(layer.spatial_id, 1);
+}
+
+TEST(RtpDependencyDescriptorExtensionTest,
+     ParseFrameLayerFailsOnAttachedStructure) {
+  const FrameDependencyStructure structure = TwoSpatialLayersStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_dependencies = structure.templates[0];
+  descriptor.attached_structure =
+      std::make_unique<FrameDependencyStructure>(structure);
+  const std::vector<uint8_t> buffer = Write(structure, descriptor);
+
+  DependencyDescriptorFrameLayer layer;
+  EXPECT_FALSE(RtpDependencyDescriptorExtension::ParseFrameLayer(
+      buffer, structure, &layer));
+  DependencyDescriptor parsed;
+  EXPECT_TRUE(
+      RtpDependencyDescriptorExtension::Parse(buffer, nullptr, &parsed));
+}
+
+TEST(RtpDependencyDescriptorExtensionTest,
+     ParseFrameLayerFailsOnUnknownTemplate) {
+  const FrameDependencyStructure structure = TwoSpatialLayersStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_dependencies = structure.templates[2];
+  const std::vector<uint8_t> buffer = Write(structure, descriptor);
+
+  FrameDependencyStructure other_structure = structure;
+  other_structure.structure_id = 10;
+  DependencyDescriptorFrameLayer layer;
+  EXPECT_FALSE(RtpDependencyDescriptorExtension::ParseFrameLayer(
+      buffer, other_structure, &layer));
+  EXPECT_FALSE(RtpDependencyDescriptorExtension::ParseFrameLayer(
+      rtc::ArrayView<const uint8_t>(buffer.data(), 2), structure, &layer));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -48,6 +48,44 @@ RtpDependencyDescriptorReader::RtpDependencyDescriptorReader(
   ReadFrameDependencyDefinition();
 }
 
+bool RtpDependencyDescriptorReader::ReadFrameLayer(
+    rtc::ArrayView<const uint8_t> raw_data,
+    const FrameDependencyStructure& structure,
+    DependencyDescriptorFrameLayer* layer) {
+  RTC_DCHECK(layer);
+  rtc::BitBuffer buffer(raw_data.data(), raw_data.size());
+  uint32_t first_packet_in_frame = 0;
+  uint32_t last_packet_in_frame = 0;
+  uint32_t template_id = 0;
+  uint32_t frame_number = 0;
+  if (!buffer.ReadBits(&first_packet_in_frame, 1) ||
+      !buffer.ReadBits(&last_packet_in_frame, 1) ||
+      !buffer.ReadBits(&template_id, 6) ||
+      !buffer.ReadBits(&frame_number, 16)) {
+    return false;
+  }
+  if (template_id == kExtendedFieldsIndicator) {
+    uint32_t structure_present = 0;
+    if (!buffer.ReadBits(&template_id, 6) ||
+        template_id == kExtendedFieldsIndicator ||
+        !buffer.ReadBits(&structure_present, 1) || structure_present) {
+      return false;
+    }
+  }
+  size_t template_index =
+      (template_id + (kMaxTemplateId + 1) - structure.structure_id) %
+      (kMaxTemplateId + 1);
+  if (template_index >= structure.templates.size())
+    return false;
+
+  layer->first_packet_in_frame = first_packet_in_frame;
+  layer->last_packet_in_frame = last_packet_in_frame;
+  layer->frame_number = frame_number;
+  layer->spatial_id = structure.templates[template_index].spatial_id;
+  layer->temporal_id = structure.templates[template_index].temporal_id;
+  return true;
+}
+
 uint32_t RtpDependencyDescriptorReader::ReadBits(size_t bit_count) {
   uint32_t value = 0;
   if (!buffer_.ReadBits(&value, bit_count))
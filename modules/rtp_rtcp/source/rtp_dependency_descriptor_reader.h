@@ -16,6 +16,7 @@
 
 #include "api/array_view.h"
 #include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
 #include "rtc_base/bit_buffer.h"
 
 namespace webrtc {
@@ -33,6 +34,12 @@ class RtpDependencyDescriptorReader {
   // Returns true if parse was successful.
   bool ParseSuccessful() { return !parsing_failed_; }
 
+  // Reads the mandatory fields and the layer of the frame, see
+  // RtpDependencyDescriptorExtension::ParseFrameLayer.
+  static bool ReadFrameLayer(rtc::ArrayView<const uint8_t> raw_data,
+                             const FrameDependencyStructure& structure,
+                             DependencyDescriptorFrameLayer* layer);
+
  private:
   // Reads bits from |buffer_|. If it fails, returns 0 and marks parsing as
   // failed, but doesn't stop the parsing.
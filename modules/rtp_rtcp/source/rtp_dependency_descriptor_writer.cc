@@ -168,8 +168,10 @@ void RtpDependencyDescriptorWriter::FindBestTemplate() {
   auto last = std::find_if_not(first, templates.end(), same_layer);
 
   best_template_ = CalculateMatch(first);
-  // Search if there any better template than the first one.
-  for (auto next = std::next(first); next != last; ++next) {
+  // Search if there any better template than the first one, unless it is
+  // already a perfect match.
+  for (auto next = std::next(first);
+       next != last && best_template_.extra_size_bits > 0; ++next) {
     TemplateMatch match = CalculateMatch(next);
     if (match.extra_size_bits < best_template_.extra_size_bits)
       best_template_ = match;
@@ -333,6 +333,45 @@ TYPED_TEST(RtpFecTest, FecRecoveryWithLoss) {
   EXPECT_FALSE(this->IsRecoveryComplete());
 }
 
+// Verify that reusing the FEC packets and packet masks of an earlier, larger
+// frame does not change the FEC packets generated for the next frame.
+TYPED_TEST(RtpFecTest, FecPacketsDoNotDependOnEarlierFrames) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr uint8_t kProtectionFactor = 255;
+
+  this->media_packets_ = this->media_packet_generator_.ConstructMediaPackets(
+      kMaxMediaPackets);
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskRandom, &this->generated_fec_packets_));
+  this->generated_fec_packets_.clear();
+
+  for (int num_media_packets : {15, 4, 15}) {
+    this->media_packets_ =
+        this->media_packet_generator_.ConstructMediaPackets(num_media_packets);
+    EXPECT_EQ(
+        0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                                kNumImportantPackets, kUseUnequalProtection,
+                                kFecMaskRandom, &this->generated_fec_packets_));
+    TypeParam fresh_fec;
+    std::list<ForwardErrorCorrection::Packet*> expected_fec_packets;
+    EXPECT_EQ(0, fresh_fec.EncodeFec(this->media_packets_, kProtectionFactor,
+                                     kNumImportantPackets,
+                                     kUseUnequalProtection, kFecMaskRandom,
+                                     &expected_fec_packets));
+
+    EXPECT_TRUE(absl::c_equal(
+        expected_fec_packets, this->generated_fec_packets_,
+        [](const ForwardErrorCorrection::Packet* expected,
+           const ForwardErrorCorrection::Packet* actual) {
+          return expected->data == actual->data;
+        }));
+    this->generated_fec_packets_.clear();
+  }
+}
+
 // Verify that we don't use an old FEC packet for FEC decoding.
 TYPED_TEST(RtpFecTest, NoFecRecoveryWithOldFecPacket) {
   constexpr int kNumImportantPackets = 0;
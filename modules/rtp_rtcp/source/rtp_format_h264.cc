@@ -267,7 +267,7 @@ bool RtpPacketizerH264::NextPacket(RtpPacketToSend* rtp_packet) {
     return false;
   }
 
-  PacketUnit packet = packets_.front();
+  const PacketUnit& packet = packets_.front();
   if (packet.first_fragment && packet.last_fragment) {
     // Single NAL unit packet.
     size_t bytes_to_send = packet.source_fragment.size();
@@ -342,7 +342,8 @@ void RtpPacketizerH264::NextFragmentPacket(RtpPacketToSend* rtp_packet) {
   packets_.pop();
 }
 
-RtpDepacketizerH264::RtpDepacketizerH264() : offset_(0), length_(0) {}
+RtpDepacketizerH264::RtpDepacketizerH264()
+    : offset_(0), length_(0), payload_modified_(false) {}
 RtpDepacketizerH264::~RtpDepacketizerH264() {}
 
 bool RtpDepacketizerH264::Parse(ParsedPayload* parsed_payload,
@@ -356,7 +357,7 @@ bool RtpDepacketizerH264::Parse(ParsedPayload* parsed_payload,
 
   offset_ = 0;
   length_ = payload_data_length;
-  modified_buffer_.reset();
+  payload_modified_ = false;
 
   uint8_t nal_type = payload_data[0] & kTypeMask;
   parsed_payload->video_header()
@@ -374,7 +375,7 @@ bool RtpDepacketizerH264::Parse(ParsedPayload* parsed_payload,
   }
 
   const uint8_t* payload =
-      modified_buffer_ ? modified_buffer_->data() : payload_data;
+      payload_modified_ ? modified_buffer_.data() : payload_data;
 
   parsed_payload->payload = payload + offset_;
   parsed_payload->payload_length = length_;
@@ -452,7 +453,7 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
             nullptr, output_buffer.get(), SpsVuiRewriter::Direction::kIncoming);
 
         if (result == SpsVuiRewriter::ParseResult::kVuiRewritten) {
-          if (modified_buffer_) {
+          if (payload_modified_) {
             RTC_LOG(LS_WARNING)
                 << "More than one H264 SPS NAL units needing "
                    "rewriting found within a single STAP-A packet. "
@@ -474,8 +475,9 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
           output_buffer->AppendData(&payload_data[end_offset],
                                     nalu_length + kNalHeaderSize - end_offset);
 
-          modified_buffer_ = std::move(output_buffer);
-          length_ = modified_buffer_->size();
+          modified_buffer_ = std::move(*output_buffer);
+          payload_modified_ = true;
+          length_ = modified_buffer_.size();
         }
 
         if (sps) {
@@ -571,9 +573,9 @@ bool RtpDepacketizerH264::ParseFuaNalu(
           << static_cast<int>(nalu.type);
     }
     uint8_t original_nal_header = fnri | original_nal_type;
-    modified_buffer_.reset(new rtc::Buffer());
-    modified_buffer_->AppendData(payload_data + kNalHeaderSize, length_);
-    (*modified_buffer_)[0] = original_nal_header;
+    modified_buffer_.SetData(payload_data + kNalHeaderSize, length_);
+    modified_buffer_[0] = original_nal_header;
+    payload_modified_ = true;
   } else {
     offset_ = kFuAHeaderSize;
     length_ -= kFuAHeaderSize;
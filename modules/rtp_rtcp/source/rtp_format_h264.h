@@ -106,7 +106,10 @@ class RtpDepacketizerH264 : public RtpDepacketizer {
 
   size_t offset_;
   size_t length_;
-  std::unique_ptr<rtc::Buffer> modified_buffer_;
+  // Holds the payload of the current packet if it had to be modified. Kept
+  // between packets, so that its memory is reused.
+  rtc::Buffer modified_buffer_;
+  bool payload_modified_;
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H264_H_
@@ -301,7 +301,7 @@ bool RtpPacketizerH265::NextPacket(RtpPacketToSend* rtp_packet) {
     return false;
   }
 
-  PacketUnit packet = packets_.front();
+  const PacketUnit& packet = packets_.front();
 
   if (packet.first_fragment && packet.last_fragment) {
     // Single NAL unit packet.
@@ -384,13 +384,8 @@ void RtpPacketizerH265::NextFragmentPacket(RtpPacketToSend* rtp_packet) {
   buffer[1] = payload_hdr_l;
   buffer[2] = fu_header;
 
-  if (packet->last_fragment) {
-    memcpy(buffer + kHevcFuHeaderSize + kHevcNalHeaderSize, fragment.buffer,
-           fragment.length);
-  } else {
-    memcpy(buffer + kHevcFuHeaderSize + kHevcNalHeaderSize, fragment.buffer,
-           fragment.length);
-  }
+  memcpy(buffer + kHevcFuHeaderSize + kHevcNalHeaderSize, fragment.buffer,
+         fragment.length);
   packets_.pop();
 }
 
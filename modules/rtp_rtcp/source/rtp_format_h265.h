@@ -67,7 +67,6 @@ class RtpPacketizerH265 : public RtpPacketizer {
     explicit Fragment(const Fragment& fragment);
     const uint8_t* buffer = nullptr;
     size_t length = 0;
-    std::unique_ptr<rtc::Buffer> tmp_buffer;
   };
   struct PacketUnit {
     PacketUnit(const Fragment& source_fragment,
@@ -101,7 +100,6 @@ class RtpPacketizerH265 : public RtpPacketizer {
 
   const PayloadSizeLimits limits_;
   size_t num_packets_left_;
-  RTPFragmentationHeader fragmentation_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketizerH265);
 };
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -148,6 +149,8 @@ class RtpPacket {
   std::string ToString() const;
 
  private:
+  static constexpr size_t kMaxInlinedExtensions = 16;
+
   struct ExtensionInfo {
     explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
     ExtensionInfo(uint8_t id, uint8_t length, uint16_t offset)
@@ -194,7 +197,9 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
+  // Inlined, so that copying a packet template for every packet of a frame
+  // does not allocate.
+  absl::InlinedVector<ExtensionInfo, kMaxInlinedExtensions> extension_entries_;
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
@@ -22,6 +22,21 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+
+// Number of slots reserved for the history when packet storage is enabled,
+// unless number_to_store is larger.
+constexpr size_t kMinRingCapacity = 64;
+
+size_t RoundUpToPowerOfTwo(size_t n) {
+  size_t power = 1;
+  while (power < n) {
+    power <<= 1;
+  }
+  return power;
+}
+
+}  // namespace
 
 constexpr size_t RtpPacketHistory::kMaxCapacity;
 constexpr size_t RtpPacketHistory::kMaxPaddingtHistory;
@@ -70,6 +85,61 @@ void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
   }
 }
 
+RtpPacketHistory::StoredPacketRing::StoredPacketRing() : begin_(0), size_(0) {}
+
+RtpPacketHistory::StoredPacketRing::~StoredPacketRing() = default;
+
+size_t RtpPacketHistory::StoredPacketRing::IndexOf(
+    const StoredPacket* packet) const {
+  RTC_DCHECK_GE(packet, slots_.data());
+  RTC_DCHECK_LT(packet, slots_.data() + slots_.size());
+  size_t slot = static_cast<size_t>(packet - slots_.data());
+  return (slot + slots_.size() - begin_) & (slots_.size() - 1);
+}
+
+void RtpPacketHistory::StoredPacketRing::PushFrontEmpty() {
+  RTC_DCHECK_LT(size_, slots_.size());
+  begin_ = (begin_ + slots_.size() - 1) & (slots_.size() - 1);
+  ++size_;
+}
+
+void RtpPacketHistory::StoredPacketRing::PushBackEmpty() {
+  RTC_DCHECK_LT(size_, slots_.size());
+  ++size_;
+}
+
+void RtpPacketHistory::StoredPacketRing::PopFront() {
+  RTC_DCHECK(!empty());
+  front() = StoredPacket(nullptr, absl::nullopt, 0);
+  begin_ = (begin_ + 1) & (slots_.size() - 1);
+  --size_;
+}
+
+void RtpPacketHistory::StoredPacketRing::Clear() {
+  for (size_t i = 0; i < size_; ++i) {
+    (*this)[i] = StoredPacket(nullptr, absl::nullopt, 0);
+  }
+  begin_ = 0;
+  size_ = 0;
+}
+
+void RtpPacketHistory::StoredPacketRing::Reserve(size_t capacity) {
+  RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+  if (capacity <= slots_.size()) {
+    return;
+  }
+  std::vector<StoredPacket> slots;
+  slots.reserve(capacity);
+  for (size_t i = 0; i < size_; ++i) {
+    slots.push_back(std::move((*this)[i]));
+  }
+  while (slots.size() < capacity) {
+    slots.emplace_back(nullptr, absl::nullopt, 0);
+  }
+  slots_ = std::move(slots);
+  begin_ = 0;
+}
+
 bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
                                               StoredPacket* rhs) const {
   // Prefer to send packets we haven't already sent as padding.
@@ -99,6 +169,9 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  if (mode_ != StorageMode::kDisabled) {
+    EnsureCapacity(std::max(kMinRingCapacity, number_to_store_));
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -142,13 +215,19 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
+  if (packet_index < 0) {
+    EnsureCapacity(packet_history_.size() - packet_index);
+  } else {
+    EnsureCapacity(std::max(packet_history_.size(),
+                            static_cast<size_t>(packet_index) + 1));
+  }
   // Packet to be inserted ahead of first packet, expand front.
   for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front(nullptr, absl::nullopt, 0);
+    packet_history_.PushFrontEmpty();
   }
   // Packet to be inserted behind last packet, expand back.
   while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back(nullptr, absl::nullopt, 0);
+    packet_history_.PushBackEmpty();
   }
 
   RTC_DCHECK_GE(packet_index, 0);
@@ -367,8 +446,26 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  packet_history_.Clear();
+  padding_priority_.clear();
+}
+
+void RtpPacketHistory::EnsureCapacity(size_t num_packets) {
+  if (num_packets <= packet_history_.capacity()) {
+    return;
+  }
+  // Growing the ring moves the stored packets, invalidating the pointers in
+  // |padding_priority_|. Remember their indices and insert them again.
+  std::vector<size_t> padding_indices;
+  padding_indices.reserve(padding_priority_.size());
+  for (const StoredPacket* packet : padding_priority_) {
+    padding_indices.push_back(packet_history_.IndexOf(packet));
+  }
   padding_priority_.clear();
+  packet_history_.Reserve(RoundUpToPowerOfTwo(num_packets));
+  for (size_t index : padding_indices) {
+    padding_priority_.insert(&packet_history_[index]);
+  }
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
@@ -419,7 +516,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
   if (packet_index == 0) {
     while (!packet_history_.empty() &&
            packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+      packet_history_.PopFront();
     }
   }
 
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -174,11 +173,55 @@ class RtpPacketHistory {
     bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
   };
 
+  // Ring buffer of stored packets, indexed relative to the oldest packet.
+  // Unlike a deque it does not allocate as packets are added and removed; the
+  // storage, a power of two number of slots, only grows when the span between
+  // the oldest and the newest packet exceeds it.
+  class StoredPacketRing {
+   public:
+    StoredPacketRing();
+    ~StoredPacketRing();
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+
+    StoredPacket& operator[](size_t index) {
+      return slots_[(begin_ + index) & (slots_.size() - 1)];
+    }
+    const StoredPacket& operator[](size_t index) const {
+      return slots_[(begin_ + index) & (slots_.size() - 1)];
+    }
+    StoredPacket& front() { return (*this)[0]; }
+    const StoredPacket& front() const { return (*this)[0]; }
+
+    // Returns the index of |packet|, which must be stored in this ring.
+    size_t IndexOf(const StoredPacket* packet) const;
+
+    // Add an empty slot at the front/back. There must be spare capacity.
+    void PushFrontEmpty();
+    void PushBackEmpty();
+    void PopFront();
+    void Clear();
+
+    // Grows the storage to |capacity| slots, a power of two, preserving the
+    // stored packets. Pointers to stored packets are invalidated.
+    void Reserve(size_t capacity);
+
+   private:
+    std::vector<StoredPacket> slots_;
+    size_t begin_;
+    size_t size_;
+  };
+
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
   bool VerifyRtt(const StoredPacket& packet, int64_t now_ms) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Makes sure |packet_history_| can hold |num_packets| packets, fixing up
+  // |padding_priority_| if the packets had to be moved.
+  void EnsureCapacity(size_t num_packets) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
@@ -203,7 +246,7 @@ class RtpPacketHistory {
   // Packets may also be removed out-of-order, in which case there will be
   // instances of StoredPacket with |packet_| set to nullptr. The first and last
   // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  StoredPacketRing packet_history_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
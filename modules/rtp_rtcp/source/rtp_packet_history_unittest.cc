@@ -766,4 +766,28 @@ TEST_F(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
     expected_time_offset_ms += 33;
   }
 }
+
+TEST_F(RtpPacketHistoryTest, GrowsStorageBeyondInitialCapacity) {
+  // Start out small so that the storage has to grow while packets are kept
+  // alive by the pacer, both forwards and backwards in sequence number.
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 1);
+  const size_t kNumPackets = 500;
+  for (size_t i = 1; i <= kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)), absl::nullopt);
+  }
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), absl::nullopt);
+
+  for (size_t i = 0; i <= kNumPackets; ++i) {
+    EXPECT_TRUE(hist_.GetPacketAndSetSendTime(To16u(kStartSeqNum + i)));
+  }
+
+  // The padding priority must still reference the stored packets after they
+  // were moved; the newest packet is the most useful one.
+  std::unique_ptr<RtpPacketToSend> padding = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(padding);
+  EXPECT_EQ(To16u(kStartSeqNum), padding->SequenceNumber());
+  padding = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(padding);
+  EXPECT_EQ(To16u(kStartSeqNum + kNumPackets), padding->SequenceNumber());
+}
 }  // namespace webrtc
@@ -180,6 +180,12 @@ void ModuleRtpRtcpImpl::SetRtxSendPayloadType(int payload_type,
   rtp_sender_->SetRtxPayloadType(payload_type, associated_payload_type);
 }
 
+absl::optional<uint32_t> ModuleRtpRtcpImpl::RtxSsrc() const {
+  if (rtp_sender_)
+    return rtp_sender_->RtxSsrc();
+  return absl::nullopt;
+}
+
 absl::optional<uint32_t> ModuleRtpRtcpImpl::FlexfecSsrc() const {
   if (rtp_sender_)
     return rtp_sender_->FlexfecSsrc();
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "common_types.h"  // NOLINT(build/include)
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/ntp_time.h"
+#include "test/gtest.h"
+#include "test/testsupport/allocation_counter.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWarmUpIterations = 1000;
+constexpr int kIterations = 100000;
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr size_t kPayloadSize = 1000;
+constexpr int kNumFeedbackPackets = 100;
+
+// Runs |operation| repeatedly and reports the mean time and number of heap
+// allocations per call. |operation| returns whether it succeeded, so that its
+// work can not be optimized away.
+template <typename Operation>
+void ReportOperationCost(const std::string& name, Operation operation) {
+  for (int i = 0; i < kWarmUpIterations; ++i)
+    ASSERT_TRUE(operation());
+  int failures = 0;
+  test::AllocationCounter allocations;
+  const int64_t start_time_ns = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i) {
+    if (!operation())
+      ++failures;
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_time_ns;
+  const int64_t num_allocations = allocations.new_count();
+  EXPECT_EQ(failures, 0);
+  test::PrintResult("time_per_op", "", name,
+                    static_cast<double>(elapsed_ns) / kIterations, "ns", false,
+                    test::ImproveDirection::kSmallerIsBetter);
+  test::PrintResult("allocations_per_op", "", name,
+                    static_cast<double>(num_allocations) / kIterations,
+                    "count", false, test::ImproveDirection::kSmallerIsBetter);
+}
+
+RtpHeaderExtensionMap CommonExtensions() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<AbsoluteSendTime>(1);
+  extensions.Register<TransmissionOffset>(2);
+  extensions.Register<AudioLevel>(3);
+  extensions.Register<TransportSequenceNumber>(4);
+  extensions.Register<VideoOrientation>(5);
+  extensions.Register<PlayoutDelayLimits>(6);
+  extensions.Register<RtpMid>(7);
+  return extensions;
+}
+
+bool BuildRtpPacket(uint16_t sequence_number, RtpPacketToSend* packet) {
+  packet->SetPayloadType(96);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetTimestamp(sequence_number * 3000u);
+  packet->SetSsrc(kSsrc);
+  return packet->SetExtension<AbsoluteSendTime>(0x123456) &&
+         packet->SetExtension<TransmissionOffset>(-12) &&
+         packet->SetExtension<AudioLevel>(true, 0x10) &&
+         packet->SetExtension<TransportSequenceNumber>(sequence_number) &&
+         packet->SetExtension<VideoOrientation>(kVideoRotation_90) &&
+         packet->SetExtension<PlayoutDelayLimits>(PlayoutDelay{0, 10}) &&
+         packet->SetExtension<RtpMid>("video") &&
+         packet->AllocatePayload(kPayloadSize) != nullptr;
+}
+
+rtc::CopyOnWriteBuffer SerializedRtpPacket(
+    const RtpHeaderExtensionMap* extensions) {
+  RtpPacketToSend packet(extensions);
+  RTC_CHECK(BuildRtpPacket(1, &packet));
+  return packet.Buffer();
+}
+
+rtc::Buffer CompoundReport() {
+  rtcp::SenderReport sender_report;
+  sender_report.SetSenderSsrc(kSsrc);
+  sender_report.SetNtp(NtpTime(0x11223344, 0x55667788));
+  sender_report.SetRtpTimestamp(0x12345);
+  sender_report.SetPacketCount(1000);
+  sender_report.SetOctetCount(1000000);
+  for (uint32_t media_ssrc = 1; media_ssrc <= 2; ++media_ssrc) {
+    rtcp::ReportBlock report_block;
+    report_block.SetMediaSsrc(media_ssrc);
+    report_block.SetExtHighestSeqNum(0x10000);
+    report_block.SetJitter(10);
+    sender_report.AddReportBlock(report_block);
+  }
+  rtcp::Sdes sdes;
+  sdes.AddCName(kSsrc, "abcdefghijklmnop");
+  rtcp::CompoundPacket compound;
+  compound.Append(&sender_report);
+  compound.Append(&sdes);
+  return compound.Build();
+}
+
+bool ParseCompoundReport(const rtc::Buffer& buffer) {
+  const uint8_t* const end = buffer.data() + buffer.size();
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = buffer.data(); next != end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, end - next))
+      return false;
+    if (header.type() == rtcp::SenderReport::kPacketType) {
+      rtcp::SenderReport sender_report;
+      if (!sender_report.Parse(header))
+        return false;
+    } else if (header.type() == rtcp::Sdes::kPacketType) {
+      rtcp::Sdes sdes;
+      if (!sdes.Parse(header))
+        return false;
+    }
+  }
+  return true;
+}
+
+rtcp::TransportFeedback Feedback() {
+  rtcp::TransportFeedback feedback;
+  feedback.SetSenderSsrc(kSsrc);
+  feedback.SetMediaSsrc(kSsrc + 1);
+  feedback.SetBase(1000, 10000000);
+  for (int i = 0; i < kNumFeedbackPackets; ++i) {
+    // Every tenth packet is lost.
+    if (i % 10 != 9)
+      feedback.AddReceivedPacket(1000 + i, 10000000 + i * 2000);
+  }
+  return feedback;
+}
+
+}  // namespace
+
+// Baselines for the cost of RTP and RTCP packet handling, per packet. The
+// results are meant to be compared between builds on the same machine.
+TEST(RtpRtcpPacketPerformanceTest, RtpPacket) {
+  const RtpHeaderExtensionMap extensions = CommonExtensions();
+  const rtc::CopyOnWriteBuffer buffer = SerializedRtpPacket(&extensions);
+
+  ReportOperationCost("rtp_packet_parse", [&] {
+    RtpPacketReceived packet(&extensions);
+    return packet.Parse(buffer);
+  });
+  ReportOperationCost("rtp_packet_parse_array_view", [&] {
+    RtpPacketReceived packet(&extensions);
+    return packet.Parse(buffer.cdata(), buffer.size());
+  });
+
+  uint16_t sequence_number = 0;
+  ReportOperationCost("rtp_packet_to_send_build", [&] {
+    RtpPacketToSend packet(&extensions);
+    return BuildRtpPacket(++sequence_number, &packet);
+  });
+}
+
+TEST(RtpRtcpPacketPerformanceTest, RtpPacketGetExtension) {
+  const RtpHeaderExtensionMap extensions = CommonExtensions();
+  RtpPacketReceived packet(&extensions);
+  ASSERT_TRUE(packet.Parse(SerializedRtpPacket(&extensions)));
+
+  ReportOperationCost("get_extension_abs_send_time", [&] {
+    uint32_t time_24bits;
+    return packet.GetExtension<AbsoluteSendTime>(&time_24bits);
+  });
+  ReportOperationCost("get_extension_transmission_offset", [&] {
+    int32_t rtp_time;
+    return packet.GetExtension<TransmissionOffset>(&rtp_time);
+  });
+  ReportOperationCost("get_extension_audio_level", [&] {
+    bool voice_activity;
+    uint8_t audio_level;
+    return packet.GetExtension<AudioLevel>(&voice_activity, &audio_level);
+  });
+  ReportOperationCost("get_extension_transport_sequence_number", [&] {
+    uint16_t sequence_number;
+    return packet.GetExtension<TransportSequenceNumber>(&sequence_number);
+  });
+  ReportOperationCost("get_extension_video_orientation", [&] {
+    VideoRotation rotation;
+    return packet.GetExtension<VideoOrientation>(&rotation);
+  });
+  ReportOperationCost("get_extension_playout_delay", [&] {
+    PlayoutDelay playout_delay;
+    return packet.GetExtension<PlayoutDelayLimits>(&playout_delay);
+  });
+  ReportOperationCost("get_extension_mid", [&] {
+    std::string mid;
+    return packet.GetExtension<RtpMid>(&mid);
+  });
+}
+
+TEST(RtpRtcpPacketPerformanceTest, RtcpCompoundReport) {
+  ReportOperationCost("rtcp_compound_report_build",
+                      [] { return CompoundReport().size() > 0; });
+
+  const rtc::Buffer buffer = CompoundReport();
+  ReportOperationCost("rtcp_compound_report_parse",
+                      [&] { return ParseCompoundReport(buffer); });
+}
+
+TEST(RtpRtcpPacketPerformanceTest, TransportFeedback) {
+  ReportOperationCost("transport_feedback_build",
+                      [] { return Feedback().Build().size() > 0; });
+
+  const rtc::Buffer buffer = Feedback().Build();
+  ReportOperationCost("transport_feedback_parse", [&] {
+    return rtcp::TransportFeedback::ParseFrom(buffer.data(), buffer.size()) !=
+           nullptr;
+  });
+}
+
+}  // namespace webrtc
@@ -47,7 +47,7 @@ constexpr uint32_t kTimestampTicksPerMs = 90;
 constexpr int kBitrateStatisticsWindowMs = 1000;
 
 // Min size needed to get payload padding from packet history.
-constexpr int kMinPayloadPaddingBytes = 50;
+constexpr size_t kMinPayloadPaddingBytes = 50;
 
 template <typename Extension>
 constexpr RtpExtensionSize CreateExtensionSize() {
@@ -171,7 +171,9 @@ RTPSender::RTPSender(const RtpRtcp::Configuration& config)
       overhead_observer_(config.overhead_observer),
       populate_network2_timestamp_(config.populate_network2_timestamp),
       send_side_bwe_with_overhead_(
-          IsEnabled("WebRTC-SendSideBwe-WithOverhead", config.field_trials)) {
+          IsEnabled("WebRTC-SendSideBwe-WithOverhead", config.field_trials)),
+      payload_padding_only_(
+          IsEnabled("WebRTC-PayloadPaddingOnly", config.field_trials)) {
   // This random initialization is not intended to be cryptographic strong.
   timestamp_offset_ = random_.Rand<uint32_t>();
   // Random start, 16 bits. Can't be 0.
@@ -264,12 +266,10 @@ size_t RTPSender::MaxRtpPacketSize() const {
 }
 
 void RTPSender::SetRtxStatus(int mode) {
-  rtc::CritScope lock(&send_critsect_);
   rtx_ = mode;
 }
 
 int RTPSender::RtxStatus() const {
-  rtc::CritScope lock(&send_critsect_);
   return rtx_;
 }
 
@@ -402,44 +402,43 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
   const auto packet_type = packet->packet_type();
   RTC_DCHECK(packet_type.has_value());
 
+  // Nothing here needs |send_critsect_|: the SSRCs are const and the flags
+  // are atomic, so the pacer does not contend with the encoder for the lock.
+  if (!sending_media_) {
+    return false;
+  }
+
   PacketOptions options;
   bool is_media = false;
   bool is_rtx = false;
-  {
-    rtc::CritScope lock(&send_critsect_);
-    if (!sending_media_) {
-      return false;
-    }
-
-    switch (*packet_type) {
-      case RtpPacketToSend::Type::kAudio:
-      case RtpPacketToSend::Type::kVideo:
-        if (packet_ssrc != ssrc_) {
-          return false;
-        }
-        is_media = true;
-        break;
-      case RtpPacketToSend::Type::kRetransmission:
-      case RtpPacketToSend::Type::kPadding:
-        // Both padding and retransmission must be on either the media or the
-        // RTX stream.
-        if (packet_ssrc == rtx_ssrc_) {
-          is_rtx = true;
-        } else if (packet_ssrc != ssrc_) {
-          return false;
-        }
-        break;
-      case RtpPacketToSend::Type::kForwardErrorCorrection:
-        // FlexFEC is on separate SSRC, ULPFEC uses media SSRC.
-        if (packet_ssrc != ssrc_ && packet_ssrc != flexfec_ssrc_) {
-          return false;
-        }
-        break;
-    }
-
-    options.included_in_allocation = force_part_of_allocation_;
+  switch (*packet_type) {
+    case RtpPacketToSend::Type::kAudio:
+    case RtpPacketToSend::Type::kVideo:
+      if (packet_ssrc != ssrc_) {
+        return false;
+      }
+      is_media = true;
+      break;
+    case RtpPacketToSend::Type::kRetransmission:
+    case RtpPacketToSend::Type::kPadding:
+      // Both padding and retransmission must be on either the media or the
+      // RTX stream.
+      if (packet_ssrc == rtx_ssrc_) {
+        is_rtx = true;
+      } else if (packet_ssrc != ssrc_) {
+        return false;
+      }
+      break;
+    case RtpPacketToSend::Type::kForwardErrorCorrection:
+      // FlexFEC is on separate SSRC, ULPFEC uses media SSRC.
+      if (packet_ssrc != ssrc_ && packet_ssrc != flexfec_ssrc_) {
+        return false;
+      }
+      break;
   }
 
+  options.included_in_allocation = force_part_of_allocation_;
+
   // Bug webrtc:7859. While FEC is invoked from rtp_sender_video, and not after
   // the pacer, these modifications of the header below are happening after the
   // FEC protection packets are calculated. This will corrupt recovered packets
@@ -500,8 +499,6 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
   if (send_success) {
     UpdateRtpStats(*packet, is_rtx,
                    packet_type == RtpPacketToSend::Type::kRetransmission);
-
-    rtc::CritScope lock(&send_critsect_);
     media_has_been_sent_ = true;
   }
 
@@ -512,12 +509,10 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
 }
 
 bool RTPSender::SupportsPadding() const {
-  rtc::CritScope lock(&send_critsect_);
   return sending_media_ && supports_bwe_extension_;
 }
 
 bool RTPSender::SupportsRtxPayloadPadding() const {
-  rtc::CritScope lock(&send_critsect_);
   return sending_media_ && supports_bwe_extension_ &&
          (rtx_ & kRtxRedundantPayloads);
 }
@@ -559,7 +554,11 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
   std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
   size_t bytes_left = target_size_bytes;
   if (SupportsRtxPayloadPadding()) {
-    while (bytes_left >= kMinPayloadPaddingBytes) {
+    // Resending media costs at most one packet more than requested, e.g. by a
+    // probe, but is useful to the receiver unlike pure padding.
+    const size_t min_payload_padding_bytes =
+        payload_padding_only_ ? 1 : kMinPayloadPaddingBytes;
+    while (bytes_left >= min_payload_padding_bytes) {
       std::unique_ptr<RtpPacketToSend> packet =
           packet_history_.GetPayloadPaddingPacket(
               [&](const RtpPacketToSend& packet)
@@ -574,6 +573,9 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
       packet->set_packet_type(RtpPacketToSend::Type::kPadding);
       padding_packets.push_back(std::move(packet));
     }
+    if (payload_padding_only_ && !padding_packets.empty()) {
+      return padding_packets;
+    }
   }
 
   rtc::CritScope lock(&send_critsect_);
@@ -885,17 +887,14 @@ bool RTPSender::AssignSequenceNumber(RtpPacketToSend* packet) {
 }
 
 void RTPSender::SetSendingMediaStatus(bool enabled) {
-  rtc::CritScope lock(&send_critsect_);
   sending_media_ = enabled;
 }
 
 bool RTPSender::SendingMedia() const {
-  rtc::CritScope lock(&send_critsect_);
   return sending_media_;
 }
 
 void RTPSender::SetAsPartOfAllocation(bool part_of_allocation) {
-  rtc::CritScope lock(&send_critsect_);
   force_part_of_allocation_ = part_of_allocation;
 }
 
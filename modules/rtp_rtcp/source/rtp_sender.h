@@ -11,6 +11,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_SENDER_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_SENDER_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -114,10 +115,7 @@ class RTPSender {
   // RTX.
   void SetRtxStatus(int mode);
   int RtxStatus() const;
-  uint32_t RtxSsrc() const {
-    RTC_DCHECK(rtx_ssrc_);
-    return *rtx_ssrc_;
-  }
+  absl::optional<uint32_t> RtxSsrc() const { return rtx_ssrc_; }
 
   void SetRtxPayloadType(int payload_type, int associated_payload_type);
 
@@ -229,8 +227,11 @@ class RTPSender {
   rtc::CriticalSection send_critsect_;
 
   Transport* transport_;
-  bool sending_media_ RTC_GUARDED_BY(send_critsect_);
-  bool force_part_of_allocation_ RTC_GUARDED_BY(send_critsect_);
+  // Atomic rather than guarded by |send_critsect_|, since they are read for
+  // every packet on the pacer thread, like |media_has_been_sent_|, |rtx_| and
+  // |supports_bwe_extension_| below.
+  std::atomic<bool> sending_media_;
+  std::atomic<bool> force_part_of_allocation_;
   size_t max_packet_size_;
 
   int8_t last_payload_type_ RTC_GUARDED_BY(send_critsect_);
@@ -274,20 +275,26 @@ class RTPSender {
   uint32_t last_rtp_timestamp_ RTC_GUARDED_BY(send_critsect_);
   int64_t capture_time_ms_ RTC_GUARDED_BY(send_critsect_);
   int64_t last_timestamp_time_ms_ RTC_GUARDED_BY(send_critsect_);
-  bool media_has_been_sent_ RTC_GUARDED_BY(send_critsect_);
+  std::atomic<bool> media_has_been_sent_;
   bool last_packet_marker_bit_ RTC_GUARDED_BY(send_critsect_);
   std::vector<uint32_t> csrcs_ RTC_GUARDED_BY(send_critsect_);
-  int rtx_ RTC_GUARDED_BY(send_critsect_);
+  std::atomic<int> rtx_;
   // Mapping rtx_payload_type_map_[associated] = rtx.
   std::map<int8_t, int8_t> rtx_payload_type_map_ RTC_GUARDED_BY(send_critsect_);
   size_t rtp_overhead_bytes_per_packet_ RTC_GUARDED_BY(send_critsect_);
-  bool supports_bwe_extension_ RTC_GUARDED_BY(send_critsect_);
+  // Written with |send_critsect_| held, together with
+  // |rtp_header_extension_map_|.
+  std::atomic<bool> supports_bwe_extension_;
 
   RateLimiter* const retransmission_rate_limiter_;
   OverheadObserver* overhead_observer_;
   const bool populate_network2_timestamp_;
 
   const bool send_side_bwe_with_overhead_;
+  // If set, padding requests are filled with RTX payload padding whenever
+  // the packet history has a packet to resend, also when that overshoots the
+  // request, instead of being topped up with pure padding.
+  const bool payload_padding_only_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTPSender);
 };
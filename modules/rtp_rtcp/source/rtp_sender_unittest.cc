@@ -1228,22 +1228,21 @@ TEST_P(RtpSenderTest, SendFlexfecPackets) {
     std::unique_ptr<RtpPacketToSend> fec_packet;
 
     EXPECT_CALL(mock_paced_sender_, EnqueuePackets)
-        .Times(2)
-        .WillRepeatedly(
-            [&](std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
-              for (auto& packet : packets) {
-                if (packet->packet_type() == RtpPacketToSend::Type::kVideo) {
-                  EXPECT_EQ(packet->Ssrc(), kSsrc);
-                  EXPECT_EQ(packet->SequenceNumber(), kSeqNum);
-                  media_packet = std::move(packet);
-                } else {
-                  EXPECT_EQ(packet->packet_type(),
-                            RtpPacketToSend::Type::kForwardErrorCorrection);
-                  EXPECT_EQ(packet->Ssrc(), kFlexFecSsrc);
-                  fec_packet = std::move(packet);
-                }
-              }
-            });
+        .WillOnce([&](std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+          EXPECT_EQ(packets.size(), 2u);
+          for (auto& packet : packets) {
+            if (packet->packet_type() == RtpPacketToSend::Type::kVideo) {
+              EXPECT_EQ(packet->Ssrc(), kSsrc);
+              EXPECT_EQ(packet->SequenceNumber(), kSeqNum);
+              media_packet = std::move(packet);
+            } else {
+              EXPECT_EQ(packet->packet_type(),
+                        RtpPacketToSend::Type::kForwardErrorCorrection);
+              EXPECT_EQ(packet->Ssrc(), kFlexFecSsrc);
+              fec_packet = std::move(packet);
+            }
+          }
+        });
 
     video_header.frame_type = VideoFrameType::kVideoFrameKey;
     EXPECT_TRUE(rtp_sender_video.SendVideo(
@@ -1365,22 +1364,21 @@ TEST_P(RtpSenderTest, NoFlexfecForTimingFrames) {
   std::unique_ptr<RtpPacketToSend> fec_packet;
 
   EXPECT_CALL(mock_paced_sender_, EnqueuePackets)
-      .Times(2)
-      .WillRepeatedly(
-          [&](std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
-            for (auto& packet : packets) {
-              if (packet->packet_type() == RtpPacketToSend::Type::kVideo) {
-                EXPECT_EQ(packet->Ssrc(), kSsrc);
-                EXPECT_EQ(packet->SequenceNumber(), kSeqNum + 1);
-                media_packet2 = std::move(packet);
-              } else {
-                EXPECT_EQ(packet->packet_type(),
-                          RtpPacketToSend::Type::kForwardErrorCorrection);
-                EXPECT_EQ(packet->Ssrc(), kFlexFecSsrc);
-                fec_packet = std::move(packet);
-              }
-            }
-          });
+      .WillOnce([&](std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+        EXPECT_EQ(packets.size(), 2u);
+        for (auto& packet : packets) {
+          if (packet->packet_type() == RtpPacketToSend::Type::kVideo) {
+            EXPECT_EQ(packet->Ssrc(), kSsrc);
+            EXPECT_EQ(packet->SequenceNumber(), kSeqNum + 1);
+            media_packet2 = std::move(packet);
+          } else {
+            EXPECT_EQ(packet->packet_type(),
+                      RtpPacketToSend::Type::kForwardErrorCorrection);
+            EXPECT_EQ(packet->Ssrc(), kFlexFecSsrc);
+            fec_packet = std::move(packet);
+          }
+        }
+      });
 
   video_header.video_timing.flags = VideoSendTiming::kInvalid;
   video_header.frame_type = VideoFrameType::kVideoFrameKey;
@@ -1723,8 +1721,8 @@ TEST_P(RtpSenderTest, FecOverheadRate) {
   constexpr size_t kNumMediaPackets = 10;
   constexpr size_t kNumFecPackets = kNumMediaPackets;
   constexpr int64_t kTimeBetweenPacketsMs = 10;
-  EXPECT_CALL(mock_paced_sender_, EnqueuePackets)
-      .Times(kNumMediaPackets + kNumFecPackets);
+  // Each frame is enqueued at once, media and FEC packets together.
+  EXPECT_CALL(mock_paced_sender_, EnqueuePackets).Times(kNumMediaPackets);
   for (size_t i = 0; i < kNumMediaPackets; ++i) {
     RTPVideoHeader video_header;
 
@@ -2394,6 +2392,44 @@ TEST_P(RtpSenderTest, GeneratePaddingResendsOldPacketsWithRtx) {
   EXPECT_EQ(padding_bytes_generated, kMaxPaddingSize);
 }
 
+TEST_P(RtpSenderTest, GeneratePaddingOnlyResendsPacketsWithTrial) {
+  test::ScopedFieldTrials field_trials("WebRTC-PayloadPaddingOnly/Enabled/");
+  SetUpRtpSender(true, false);
+  rtp_sender_->SetRtxStatus(kRtxRetransmitted | kRtxRedundantPayloads);
+  rtp_sender_->SetRtxPayloadType(kRtxPayload, kPayload);
+  rtp_sender_->SetStorePacketsStatus(true, 1);
+  ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionTransportSequenceNumber,
+                   kTransportSequenceNumberExtensionId));
+
+  const size_t kPayloadPacketSize = 1234;
+  std::unique_ptr<RtpPacketToSend> packet =
+      BuildRtpPacket(kPayload, true, 0, fake_clock_.TimeInMilliseconds());
+  packet->set_allow_retransmission(true);
+  packet->SetPayloadSize(kPayloadPacketSize);
+  packet->set_packet_type(RtpPacketToSend::Type::kVideo);
+  EXPECT_CALL(send_packet_observer_, OnSendPacket).Times(1);
+  EXPECT_TRUE(rtp_sender_->TrySendPacket(packet.get(), PacedPacketInfo()));
+
+  // Even a small request is filled by resending the media packet, without any
+  // pure padding.
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_packets =
+      rtp_sender_->GeneratePadding(/*target_size_bytes=*/10);
+  ASSERT_EQ(generated_packets.size(), 1u);
+  EXPECT_EQ(generated_packets[0]->Ssrc(), kRtxSsrc);
+  EXPECT_EQ(generated_packets[0]->payload_size(),
+            kPayloadPacketSize + kRtxHeaderSize);
+  EXPECT_EQ(generated_packets[0]->padding_size(), 0u);
+
+  // A request larger than the packet is filled by resending it again.
+  generated_packets =
+      rtp_sender_->GeneratePadding(/*target_size_bytes=*/kPayloadPacketSize +
+                                   100);
+  ASSERT_EQ(generated_packets.size(), 2u);
+  for (const auto& padding_packet : generated_packets)
+    EXPECT_GT(padding_packet->payload_size(), 0u);
+}
+
 TEST_P(RtpSenderTest, GeneratePaddingCreatesPurePaddingWithoutRtx) {
   rtp_sender_->SetStorePacketsStatus(true, 1);
   ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
@@ -372,10 +372,8 @@ void RTPSenderVideo::LogAndSendToNetwork(
         clock_->TimeInMilliseconds());
   }
 
-  // TODO(sprang): Replace with bulk send method.
-  for (auto& packet : packets) {
-    rtp_sender_->SendToNetwork(std::move(packet));
-  }
+  // Hand the whole frame to the pacer at once, under a single lock.
+  rtp_sender_->EnqueuePackets(std::move(packets));
 }
 
 size_t RTPSenderVideo::FecPacketOverhead() const {
@@ -562,7 +560,6 @@ bool RTPSenderVideo::SendVideo(
   }
 
   // TODO(benwright@webrtc.org) - Allocate enough to always encrypt inline.
-  rtc::Buffer encrypted_video_payload;
   if (frame_encryptor_ != nullptr) {
     if (generic_descriptor_raw.empty()) {
       return false;
@@ -571,7 +568,7 @@ bool RTPSenderVideo::SendVideo(
     const size_t max_ciphertext_size =
         frame_encryptor_->GetMaxCiphertextByteSize(cricket::MEDIA_TYPE_VIDEO,
                                                    payload.size());
-    encrypted_video_payload.SetSize(max_ciphertext_size);
+    encrypted_video_payload_.SetSize(max_ciphertext_size);
 
     size_t bytes_written = 0;
 
@@ -583,12 +580,12 @@ bool RTPSenderVideo::SendVideo(
 
     if (frame_encryptor_->Encrypt(
             cricket::MEDIA_TYPE_VIDEO, first_packet->Ssrc(), additional_data,
-            payload, encrypted_video_payload, &bytes_written) != 0) {
+            payload, encrypted_video_payload_, &bytes_written) != 0) {
       return false;
     }
 
-    encrypted_video_payload.SetSize(bytes_written);
-    payload = encrypted_video_payload;
+    encrypted_video_payload_.SetSize(bytes_written);
+    payload = encrypted_video_payload_;
   } else if (require_frame_encryption_) {
     RTC_LOG(LS_WARNING)
         << "No FrameEncryptor is attached to this video sending stream but "
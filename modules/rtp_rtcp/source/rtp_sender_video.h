@@ -29,6 +29,7 @@
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "modules/rtp_rtcp/source/ulpfec_generator.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/one_time_event.h"
 #include "rtc_base/race_checker.h"
@@ -226,6 +227,8 @@ class RTPSenderVideo {
 
   // E2EE Custom Video Frame Encryptor (optional)
   FrameEncryptorInterface* const frame_encryptor_ = nullptr;
+  // Output of |frame_encryptor_|, kept to reuse its allocation between frames.
+  rtc::Buffer encrypted_video_payload_ RTC_GUARDED_BY(send_checker_);
   // If set to true will require all outgoing frames to pass through an
   // initialized frame_encryptor_ before being sent out of the network.
   // Otherwise these payloads will be dropped.
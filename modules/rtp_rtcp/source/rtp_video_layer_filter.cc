@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_video_layer_filter.h"
+
+#include <algorithm>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kFixedHeaderSize = 12;
+constexpr uint8_t kRtpVersion = 2;
+constexpr uint8_t kMarkerBit = 0x80;
+
+// Returns false if |packet| is not a valid RTP packet. |payload_size| excludes
+// the padding.
+bool ParseRtpHeader(rtc::ArrayView<const uint8_t> packet,
+                    size_t* payload_offset,
+                    size_t* payload_size) {
+  if (packet.size() < kFixedHeaderSize || (packet[0] >> 6) != kRtpVersion)
+    return false;
+  const bool has_padding = (packet[0] & 0x20) != 0;
+  const bool has_extension = (packet[0] & 0x10) != 0;
+  const size_t num_csrcs = packet[0] & 0x0f;
+  size_t offset = kFixedHeaderSize + 4 * num_csrcs;
+  if (has_extension) {
+    if (packet.size() < offset + 4)
+      return false;
+    offset += 4 + 4 * ByteReader<uint16_t>::ReadBigEndian(&packet[offset + 2]);
+  }
+  if (packet.size() < offset)
+    return false;
+  size_t padding_size = 0;
+  if (has_padding) {
+    padding_size = packet[packet.size() - 1];
+    if (padding_size == 0 || packet.size() - offset < padding_size)
+      return false;
+  }
+  *payload_offset = offset;
+  *payload_size = packet.size() - offset - padding_size;
+  return true;
+}
+
+// Reads the picture id starting at |payload[*offset]|.
+bool ReadPictureId(rtc::ArrayView<const uint8_t> payload,
+                   size_t* offset,
+                   size_t* picture_id_offset,
+                   int* picture_id_bits,
+                   int* picture_id) {
+  if (*offset >= payload.size())
+    return false;
+  *picture_id_offset = *offset;
+  if (payload[*offset] & 0x80) {
+    if (*offset + 1 >= payload.size())
+      return false;
+    *picture_id_bits = 15;
+    *picture_id = ((payload[*offset] & 0x7f) << 8) | payload[*offset + 1];
+    *offset += 2;
+  } else {
+    *picture_id_bits = 7;
+    *picture_id = payload[*offset];
+    *offset += 1;
+  }
+  return true;
+}
+
+}  // namespace
+
+// Layer information of a packet, read from its payload descriptor.
+struct RtpVideoLayerFilter::PayloadInfo {
+  bool is_vp9 = false;
+  int spatial_idx = kNoSpatialIdx;
+  int temporal_idx = kNoTemporalIdx;
+  bool end_of_frame = true;
+  bool non_ref_for_inter_layer_pred = false;
+  absl::optional<int> num_spatial_layers;
+  // Offset of the picture id in the payload and its size in bits, 7 or 15, or
+  // 0 if there is none.
+  size_t picture_id_offset = 0;
+  int picture_id_bits = 0;
+  int picture_id = 0;
+};
+
+RtpVideoLayerFilter::RtpVideoLayerFilter(int vp8_payload_type,
+                                         int vp9_payload_type)
+    : vp8_payload_type_(vp8_payload_type),
+      vp9_payload_type_(vp9_payload_type) {}
+
+RtpVideoLayerFilter::~RtpVideoLayerFilter() = default;
+
+void RtpVideoLayerFilter::SelectLayers(int spatial_id, int temporal_id) {
+  selected_spatial_id_ = spatial_id;
+  selected_temporal_id_ = temporal_id;
+}
+
+bool RtpVideoLayerFilter::FilterPacket(rtc::ArrayView<uint8_t> packet) {
+  size_t payload_offset = 0;
+  size_t payload_size = 0;
+  if (!ParseRtpHeader(packet, &payload_offset, &payload_size))
+    return false;
+
+  const int payload_type = packet[1] & 0x7f;
+  const bool is_vp8 = payload_type == vp8_payload_type_;
+  const bool is_vp9 = payload_type == vp9_payload_type_;
+  bool forward = true;
+  bool set_marker = false;
+  if ((is_vp8 || is_vp9) && payload_size > 0) {
+    rtc::ArrayView<const uint8_t> payload(&packet[payload_offset],
+                                          payload_size);
+    PayloadInfo info;
+    info.is_vp9 = is_vp9;
+    size_t offset = 1;
+    if (is_vp8) {
+      // X | R | N | S | R | PID, then I | L | T | K | RSV if X is set.
+      if (payload[0] & 0x80) {
+        if (payload.size() < 2)
+          return false;
+        const uint8_t extension = payload[1];
+        offset = 2;
+        if ((extension & 0x80) &&
+            !ReadPictureId(payload, &offset, &info.picture_id_offset,
+                           &info.picture_id_bits, &info.picture_id)) {
+          return false;
+        }
+        // TL0PICIDX.
+        if (extension & 0x40)
+          ++offset;
+        if (extension & 0x30) {
+          if (offset >= payload.size())
+            return false;
+          if (extension & 0x20)
+            info.temporal_idx = payload[offset] >> 6;
+          ++offset;
+        }
+      }
+    } else {
+      // I | P | L | F | B | E | V | Z.
+      const uint8_t flags = payload[0];
+      if ((flags & 0x80) &&
+          !ReadPictureId(payload, &offset, &info.picture_id_offset,
+                         &info.picture_id_bits, &info.picture_id)) {
+        return false;
+      }
+      const bool flexible_mode = (flags & 0x10) != 0;
+      if (flags & 0x20) {
+        if (offset >= payload.size())
+          return false;
+        info.temporal_idx = payload[offset] >> 5;
+        info.spatial_idx = (payload[offset] >> 1) & 0x07;
+        ++offset;
+        // TL0PICIDX.
+        if (!flexible_mode)
+          ++offset;
+      }
+      if (flexible_mode && (flags & 0x40)) {
+        // Up to three reference indices, each with a bit telling if another
+        // one follows.
+        for (int i = 0; i < 3; ++i) {
+          if (offset >= payload.size())
+            return false;
+          if (!(payload[offset++] & 0x01))
+            break;
+        }
+      }
+      if (flags & 0x02) {
+        if (offset >= payload.size())
+          return false;
+        info.num_spatial_layers = (payload[offset] >> 5) + 1;
+      }
+      info.end_of_frame = (flags & 0x04) != 0;
+      info.non_ref_for_inter_layer_pred = (flags & 0x01) != 0;
+    }
+    if (offset > payload.size())
+      return false;
+
+    forward = ShouldForward(info);
+    set_marker = forward && info.is_vp9 && selected_spatial_id_ >= 0 &&
+                 info.end_of_frame &&
+                 info.spatial_idx ==
+                     std::min(num_active_spatial_layers_ - 1,
+                              selected_spatial_id_);
+    RewritePictureId(info, forward, &packet[payload_offset]);
+  }
+
+  if (!forward) {
+    ++num_dropped_packets_;
+    return false;
+  }
+  if (set_marker)
+    packet[1] |= kMarkerBit;
+  if (num_dropped_packets_ > 0) {
+    ByteWriter<uint16_t>::WriteBigEndian(
+        &packet[2], ByteReader<uint16_t>::ReadBigEndian(&packet[2]) -
+                        num_dropped_packets_);
+  }
+  return true;
+}
+
+bool RtpVideoLayerFilter::ShouldForward(const PayloadInfo& info) {
+  if (!info.is_vp9 || info.spatial_idx == kNoSpatialIdx) {
+    num_active_spatial_layers_ = 1;
+  } else if (info.num_spatial_layers) {
+    num_active_spatial_layers_ = *info.num_spatial_layers;
+  }
+
+  if (selected_temporal_id_ >= 0 && info.temporal_idx != kNoTemporalIdx &&
+      info.temporal_idx > selected_temporal_id_) {
+    return false;
+  }
+  if (selected_spatial_id_ < 0 || info.spatial_idx == kNoSpatialIdx)
+    return true;
+  if (info.spatial_idx > selected_spatial_id_)
+    return false;
+  // Lower spatial layers that are not used for inter-layer prediction are not
+  // needed to decode the selected one.
+  return !(info.spatial_idx < std::min(num_active_spatial_layers_ - 1,
+                                       selected_spatial_id_) &&
+           info.non_ref_for_inter_layer_pred);
+}
+
+void RtpVideoLayerFilter::RewritePictureId(const PayloadInfo& info,
+                                           bool forward,
+                                           uint8_t* payload) {
+  if (info.picture_id_bits == 0)
+    return;
+  if (info.picture_id != last_picture_id_) {
+    if (last_picture_id_ && !last_picture_forwarded_)
+      ++num_dropped_pictures_;
+    last_picture_id_ = info.picture_id;
+    last_picture_forwarded_ = false;
+  }
+  if (!forward)
+    return;
+  last_picture_forwarded_ = true;
+  if (num_dropped_pictures_ == 0)
+    return;
+  const int mask = (1 << info.picture_id_bits) - 1;
+  const int picture_id = (info.picture_id - num_dropped_pictures_) & mask;
+  uint8_t* picture_id_field = payload + info.picture_id_offset;
+  if (info.picture_id_bits == 15) {
+    picture_id_field[0] = 0x80 | (picture_id >> 8);
+    picture_id_field[1] = picture_id & 0xff;
+  } else {
+    picture_id_field[0] = picture_id;
+  }
+}
+
+}  // namespace webrtc
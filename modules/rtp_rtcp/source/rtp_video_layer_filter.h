@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_VIDEO_LAYER_FILTER_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_VIDEO_LAYER_FILTER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Forwards a VP8 or VP9 RTP stream with fewer spatial and/or temporal layers
+// than it was sent with, as an SFU does for receivers that can not take all of
+// them. Only the RTP header and the payload descriptor are inspected, and
+// forwarded packets are rewritten in place: sequence numbers and picture ids
+// are shifted to stay continuous over the dropped packets, and the marker bit
+// is set on the last packet of the highest forwarded spatial layer. Packets
+// must be given unprotected and in sending order, i.e. before SRTP protection
+// on the forwarding side. One instance handles one SSRC, and it is not thread
+// safe.
+//
+// Base temporal layer frames are never dropped, so TL0PICIDX stays continuous
+// and is left as it is.
+class RtpVideoLayerFilter {
+ public:
+  // A negative payload type disables the codec.
+  RtpVideoLayerFilter(int vp8_payload_type, int vp9_payload_type);
+  RtpVideoLayerFilter(const RtpVideoLayerFilter&) = delete;
+  RtpVideoLayerFilter& operator=(const RtpVideoLayerFilter&) = delete;
+  ~RtpVideoLayerFilter();
+
+  // Selects the highest spatial and temporal layer to forward. A negative
+  // value forwards all layers. Switching to a higher layer should be done at a
+  // key frame or a switching point, or the receiver has to ask for one.
+  void SelectLayers(int spatial_id, int temporal_id);
+
+  // Returns false if |packet| belongs to a layer that is not forwarded, or is
+  // not a valid RTP packet, and should be dropped. Otherwise rewrites |packet|
+  // in place and returns true. Packets of other payload types only get their
+  // sequence number rewritten.
+  bool FilterPacket(rtc::ArrayView<uint8_t> packet);
+
+ private:
+  struct PayloadInfo;
+
+  bool ShouldForward(const PayloadInfo& info);
+  void RewritePictureId(const PayloadInfo& info,
+                        bool forward,
+                        uint8_t* payload);
+
+  const int vp8_payload_type_;
+  const int vp9_payload_type_;
+  int selected_spatial_id_ = -1;
+  int selected_temporal_id_ = -1;
+  int num_active_spatial_layers_ = 1;
+
+  // Number of packets and whole pictures dropped so far, subtracted from the
+  // sequence numbers and picture ids of forwarded packets.
+  uint16_t num_dropped_packets_ = 0;
+  uint16_t num_dropped_pictures_ = 0;
+  absl::optional<int> last_picture_id_;
+  bool last_picture_forwarded_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_VIDEO_LAYER_FILTER_H_
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_video_layer_filter.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kVp8PayloadType = 96;
+constexpr int kVp9PayloadType = 98;
+constexpr int kOtherPayloadType = 100;
+constexpr size_t kHeaderSize = 12;
+
+std::vector<uint8_t> RtpPacket(int payload_type,
+                               uint16_t sequence_number,
+                               bool marker,
+                               const std::vector<uint8_t>& descriptor) {
+  std::vector<uint8_t> packet(kHeaderSize);
+  packet[0] = 0x80;
+  packet[1] = payload_type | (marker ? 0x80 : 0);
+  ByteWriter<uint16_t>::WriteBigEndian(&packet[2], sequence_number);
+  packet.insert(packet.end(), descriptor.begin(), descriptor.end());
+  // Some payload after the descriptor.
+  packet.insert(packet.end(), {0xaa, 0xbb});
+  return packet;
+}
+
+// VP8 descriptor with a 15-bit picture id, TL0PICIDX and TID.
+std::vector<uint8_t> Vp8Packet(uint16_t sequence_number,
+                               int picture_id,
+                               int temporal_idx) {
+  return RtpPacket(kVp8PayloadType, sequence_number, /*marker=*/true,
+                   {0x90, 0xe0, static_cast<uint8_t>(0x80 | (picture_id >> 8)),
+                    static_cast<uint8_t>(picture_id & 0xff), 0x05,
+                    static_cast<uint8_t>(temporal_idx << 6)});
+}
+
+// VP9 non-flexible mode descriptor with a 7-bit picture id, layer indices and
+// TL0PICIDX, and the number of spatial layers if it is a key frame.
+std::vector<uint8_t> Vp9Packet(uint16_t sequence_number,
+                               bool marker,
+                               int picture_id,
+                               int spatial_idx,
+                               bool end_of_frame,
+                               int num_spatial_layers) {
+  std::vector<uint8_t> descriptor = {
+      static_cast<uint8_t>(0xa8 | (end_of_frame ? 0x04 : 0) |
+                           (num_spatial_layers > 0 ? 0x02 : 0)),
+      static_cast<uint8_t>(picture_id),
+      static_cast<uint8_t>(spatial_idx << 1), 0x00};
+  if (num_spatial_layers > 0)
+    descriptor.push_back((num_spatial_layers - 1) << 5);
+  return RtpPacket(kVp9PayloadType, sequence_number, marker, descriptor);
+}
+
+uint16_t SequenceNumber(const std::vector<uint8_t>& packet) {
+  return ByteReader<uint16_t>::ReadBigEndian(&packet[2]);
+}
+
+bool Marker(const std::vector<uint8_t>& packet) {
+  return packet[1] & 0x80;
+}
+
+TEST(RtpVideoLayerFilterTest, ForwardsEverythingByDefault) {
+  RtpVideoLayerFilter filter(kVp8PayloadType, kVp9PayloadType);
+  std::vector<uint8_t> packet = Vp8Packet(10, 100, 1);
+  const std::vector<uint8_t> original = packet;
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  EXPECT_EQ(packet, original);
+}
+
+TEST(RtpVideoLayerFilterTest, DropsHigherTemporalLayersOfVp8) {
+  RtpVideoLayerFilter filter(kVp8PayloadType, kVp9PayloadType);
+  filter.SelectLayers(-1, 0);
+
+  std::vector<uint8_t> packet = Vp8Packet(0xffff, 0x7fff, 0);
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  EXPECT_EQ(SequenceNumber(packet), 0xffff);
+
+  packet = Vp8Packet(0, 0, 1);
+  EXPECT_FALSE(filter.FilterPacket(packet));
+
+  // Sequence number and picture id continue from the last forwarded packet.
+  packet = Vp8Packet(1, 1, 0);
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  EXPECT_EQ(SequenceNumber(packet), 0);
+  EXPECT_EQ(packet[kHeaderSize + 2], 0x80);
+  EXPECT_EQ(packet[kHeaderSize + 3], 0x00);
+  // TL0PICIDX is left as it is.
+  EXPECT_EQ(packet[kHeaderSize + 4], 0x05);
+}
+
+TEST(RtpVideoLayerFilterTest, DropsHigherSpatialLayersOfVp9) {
+  RtpVideoLayerFilter filter(kVp8PayloadType, kVp9PayloadType);
+  filter.SelectLayers(0, -1);
+
+  std::vector<uint8_t> packet = Vp9Packet(1, false, 5, 0, true, 2);
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  // Now the last packet of the forwarded superframe.
+  EXPECT_TRUE(Marker(packet));
+  packet = Vp9Packet(2, true, 5, 1, true, 0);
+  EXPECT_FALSE(filter.FilterPacket(packet));
+
+  packet = Vp9Packet(3, false, 6, 0, true, 0);
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  EXPECT_EQ(SequenceNumber(packet), 2);
+  // The picture was forwarded in part, so its id stays.
+  EXPECT_EQ(packet[kHeaderSize + 1], 6);
+}
+
+TEST(RtpVideoLayerFilterTest, OnlyRewritesSequenceNumberOfOtherPayloads) {
+  RtpVideoLayerFilter filter(kVp8PayloadType, kVp9PayloadType);
+  filter.SelectLayers(-1, 0);
+  std::vector<uint8_t> packet = Vp8Packet(1, 1, 2);
+  EXPECT_FALSE(filter.FilterPacket(packet));
+
+  packet = RtpPacket(kOtherPayloadType, 2, false, {0x90, 0xe0});
+  std::vector<uint8_t> expected = packet;
+  ByteWriter<uint16_t>::WriteBigEndian(&expected[2], 1);
+  EXPECT_TRUE(filter.FilterPacket(packet));
+  EXPECT_EQ(packet, expected);
+}
+
+TEST(RtpVideoLayerFilterTest, DropsInvalidPackets) {
+  RtpVideoLayerFilter filter(kVp8PayloadType, kVp9PayloadType);
+  std::vector<uint8_t> packet = Vp8Packet(1, 1, 0);
+  // Header extension that is longer than the packet.
+  packet[0] |= 0x10;
+  EXPECT_FALSE(filter.FilterPacket(packet));
+
+  // Truncated descriptor.
+  packet = Vp8Packet(1, 1, 0);
+  packet.resize(kHeaderSize + 3);
+  EXPECT_FALSE(filter.FilterPacket(packet));
+
+  packet.resize(kHeaderSize - 1);
+  EXPECT_FALSE(filter.FilterPacket(packet));
+}
+
+}  // namespace
+}  // namespace webrtc
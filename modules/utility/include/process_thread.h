@@ -21,6 +21,7 @@ class Location;
 
 namespace webrtc {
 class Module;
+class TaskQueueFactory;
 
 // TODO(tommi): ProcessThread probably doesn't need to be a virtual
 // interface.  There exists one override besides ProcessThreadImpl,
@@ -32,6 +33,13 @@ class ProcessThread {
 
   static std::unique_ptr<ProcessThread> Create(const char* thread_name);
 
+  // Creates a ProcessThread running on a task queue from |task_queue_factory|.
+  // Rather than polling all modules on every wake-up, it only wakes up when
+  // the earliest module deadline is reached.
+  static std::unique_ptr<ProcessThread> Create(
+      const char* thread_name,
+      TaskQueueFactory* task_queue_factory);
+
   // Starts the worker thread.  Must be called from the construction thread.
   virtual void Start() = 0;
 
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_UTILITY_INCLUDE_PROCESS_THREAD_POOL_H_
+#define MODULES_UTILITY_INCLUDE_PROCESS_THREAD_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Multiplexes the modules of many ProcessThread instances onto a small, fixed
+// set of worker threads. This is intended for processes hosting a large number
+// of calls (e.g. an SFU), where giving every RtpTransportControllerSend its own
+// pacer thread results in a large number of threads and idle wake-ups.
+//
+// Each worker sleeps until the earliest time any of its modules wants to be
+// processed (as reported by Module::TimeUntilNextProcess()), or until it is
+// woken up, so an idle worker does not wake up at all.
+//
+// The ProcessThread instances returned by CreateProcessThread() behave like
+// the ones returned by ProcessThread::Create(), except that Start() and Stop()
+// only control when their own modules and tasks are run. All of them must be
+// destroyed before the pool is.
+class ProcessThreadPool {
+ public:
+  ProcessThreadPool(const char* thread_name, int num_threads);
+  ~ProcessThreadPool();
+
+  // Returns a new ProcessThread which runs on the least loaded worker of the
+  // pool. Can be called on any thread.
+  std::unique_ptr<ProcessThread> CreateProcessThread();
+
+ private:
+  class Worker;
+  class PooledProcessThread;
+
+  rtc::CriticalSection lock_;
+  std::vector<std::unique_ptr<Worker>> workers_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_UTILITY_INCLUDE_PROCESS_THREAD_POOL_H_
@@ -0,0 +1,334 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/process_thread_pool.h"
+
+#include <list>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/task_queue/queued_task.h"
+#include "modules/include/module.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_checker.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+// Same meaning as in ProcessThreadImpl: the module has requested a callback
+// right away, so Process() is called without asking TimeUntilNextProcess().
+const int64_t kCallProcessImmediately = -1;
+
+// Upper bound on how long a worker sleeps when it has nothing to do.
+const int64_t kMaxWaitTimeMs = 1000 * 60;
+
+int64_t GetNextCallbackTime(Module* module, int64_t time_now) {
+  int64_t interval = module->TimeUntilNextProcess();
+  if (interval < 0) {
+    // Falling behind, we should call the callback now.
+    return time_now;
+  }
+  return time_now + interval;
+}
+
+}  // namespace
+
+// A single pool thread, running the modules and tasks of all ProcessThreads
+// assigned to it. Modules are run while holding |lock_|, so DeRegisterModule()
+// and Stop() do not return while one of the affected modules is processing.
+class ProcessThreadPool::Worker {
+ public:
+  struct ModuleCallback {
+    ModuleCallback(Module* module, const rtc::Location& location)
+        : module(module), location(location) {}
+
+    Module* const module;
+    int64_t next_callback = 0;  // Absolute timestamp.
+    const rtc::Location location;
+  };
+
+  struct Client {
+    explicit Client(ProcessThread* thread) : thread(thread) {}
+
+    ProcessThread* const thread;
+    bool started = false;
+    std::list<ModuleCallback> modules;
+    std::queue<std::unique_ptr<QueuedTask>> tasks;
+  };
+
+  explicit Worker(const char* thread_name)
+      : stop_(false), thread_(&Worker::Run, this, thread_name) {
+    thread_.Start();
+  }
+
+  ~Worker() {
+    {
+      rtc::CritScope lock(&lock_);
+      RTC_DCHECK(clients_.empty());
+      stop_ = true;
+    }
+    wake_up_.Set();
+    thread_.Stop();
+  }
+
+  size_t num_clients() const {
+    rtc::CritScope lock(&lock_);
+    return clients_.size();
+  }
+
+  Client* AddClient(ProcessThread* thread) {
+    rtc::CritScope lock(&lock_);
+    clients_.emplace_back(thread);
+    return &clients_.back();
+  }
+
+  void RemoveClient(Client* client) {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(!client->started);
+    clients_.remove_if([client](const Client& c) { return &c == client; });
+  }
+
+  void Start(Client* client) {
+    std::vector<Module*> modules;
+    {
+      rtc::CritScope lock(&lock_);
+      RTC_DCHECK(!client->started);
+      for (ModuleCallback& m : client->modules) {
+        m.next_callback = 0;
+        modules.push_back(m.module);
+      }
+    }
+
+    for (Module* module : modules)
+      module->ProcessThreadAttached(client->thread);
+
+    {
+      rtc::CritScope lock(&lock_);
+      client->started = true;
+    }
+    wake_up_.Set();
+  }
+
+  void Stop(Client* client) {
+    std::vector<Module*> modules;
+    {
+      rtc::CritScope lock(&lock_);
+      if (!client->started)
+        return;
+      client->started = false;
+      for (const ModuleCallback& m : client->modules)
+        modules.push_back(m.module);
+    }
+
+    for (Module* module : modules)
+      module->ProcessThreadAttached(nullptr);
+  }
+
+  void WakeUp(Client* client, Module* module) {
+    {
+      rtc::CritScope lock(&lock_);
+      for (ModuleCallback& m : client->modules) {
+        if (m.module == module)
+          m.next_callback = kCallProcessImmediately;
+      }
+    }
+    wake_up_.Set();
+  }
+
+  void PostTask(Client* client, std::unique_ptr<QueuedTask> task) {
+    {
+      rtc::CritScope lock(&lock_);
+      client->tasks.push(std::move(task));
+    }
+    wake_up_.Set();
+  }
+
+  void RegisterModule(Client* client,
+                      Module* module,
+                      const rtc::Location& from) {
+    RTC_DCHECK(module) << from.ToString();
+    bool started;
+    {
+      rtc::CritScope lock(&lock_);
+#if RTC_DCHECK_IS_ON
+      // Catch programmer error.
+      for (const ModuleCallback& mc : client->modules) {
+        RTC_DCHECK(mc.module != module)
+            << "Already registered here: " << mc.location.ToString() << "\n"
+            << "Now attempting from here: " << from.ToString();
+      }
+#endif
+      started = client->started;
+    }
+
+    if (started)
+      module->ProcessThreadAttached(client->thread);
+
+    {
+      rtc::CritScope lock(&lock_);
+      client->modules.emplace_back(module, from);
+    }
+
+    // The waiting time for the just registered module may be shorter than
+    // for all other modules of this worker.
+    wake_up_.Set();
+  }
+
+  void DeRegisterModule(Client* client, Module* module) {
+    RTC_DCHECK(module);
+    {
+      rtc::CritScope lock(&lock_);
+      client->modules.remove_if(
+          [module](const ModuleCallback& m) { return m.module == module; });
+    }
+
+    // Notify the module that it's been detached.
+    module->ProcessThreadAttached(nullptr);
+  }
+
+ private:
+  static void Run(void* obj) {
+    Worker* worker = static_cast<Worker*>(obj);
+    while (worker->Process()) {
+    }
+  }
+
+  bool Process() {
+    TRACE_EVENT1("webrtc", "ProcessThreadPool", "name",
+                 thread_.name().c_str());
+    int64_t now = rtc::TimeMillis();
+    int64_t next_checkpoint = now + kMaxWaitTimeMs;
+
+    {
+      rtc::CritScope lock(&lock_);
+      if (stop_)
+        return false;
+      for (Client& client : clients_) {
+        if (!client.started)
+          continue;
+
+        for (ModuleCallback& m : client.modules) {
+          if (m.next_callback == 0)
+            m.next_callback = GetNextCallbackTime(m.module, now);
+
+          if (m.next_callback <= now ||
+              m.next_callback == kCallProcessImmediately) {
+            {
+              TRACE_EVENT2("webrtc", "ModuleProcess", "function",
+                           m.location.function_name(), "file",
+                           m.location.file_and_line());
+              m.module->Process();
+            }
+            int64_t new_now = rtc::TimeMillis();
+            m.next_callback = GetNextCallbackTime(m.module, new_now);
+          }
+
+          if (m.next_callback < next_checkpoint)
+            next_checkpoint = m.next_callback;
+        }
+
+        // Unlike ProcessThreadImpl, tasks are run with |lock_| held, so that
+        // stopping or destroying a ProcessThread synchronizes with its tasks
+        // without joining the shared thread. |lock_| is recursive, so tasks
+        // may still post tasks and (de)register modules.
+        while (!client.tasks.empty()) {
+          std::unique_ptr<QueuedTask> task = std::move(client.tasks.front());
+          client.tasks.pop();
+          if (!task->Run())
+            task.release();
+        }
+      }
+    }
+
+    int64_t time_to_wait = next_checkpoint - rtc::TimeMillis();
+    if (time_to_wait > 0)
+      wake_up_.Wait(static_cast<int>(time_to_wait));
+
+    return true;
+  }
+
+  rtc::CriticalSection lock_;
+  rtc::Event wake_up_;
+  std::list<Client> clients_ RTC_GUARDED_BY(lock_);
+  bool stop_ RTC_GUARDED_BY(lock_);
+  rtc::PlatformThread thread_;
+};
+
+// The ProcessThread handed out to users of the pool. Start() and Stop() must
+// be called on the construction thread, like for ProcessThreadImpl.
+class ProcessThreadPool::PooledProcessThread : public ProcessThread {
+ public:
+  explicit PooledProcessThread(Worker* worker)
+      : worker_(worker), client_(worker->AddClient(this)) {}
+
+  ~PooledProcessThread() override {
+    RTC_DCHECK(thread_checker_.IsCurrent());
+    Stop();
+    worker_->RemoveClient(client_);
+  }
+
+  void Start() override {
+    RTC_DCHECK(thread_checker_.IsCurrent());
+    worker_->Start(client_);
+  }
+
+  void Stop() override {
+    RTC_DCHECK(thread_checker_.IsCurrent());
+    worker_->Stop(client_);
+  }
+
+  void WakeUp(Module* module) override { worker_->WakeUp(client_, module); }
+
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    worker_->PostTask(client_, std::move(task));
+  }
+
+  void RegisterModule(Module* module, const rtc::Location& from) override {
+    worker_->RegisterModule(client_, module, from);
+  }
+
+  void DeRegisterModule(Module* module) override {
+    worker_->DeRegisterModule(client_, module);
+  }
+
+ private:
+  rtc::ThreadChecker thread_checker_;
+  Worker* const worker_;
+  Worker::Client* const client_;
+};
+
+ProcessThreadPool::ProcessThreadPool(const char* thread_name,
+                                     int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  rtc::CritScope lock(&lock_);
+  for (int i = 0; i < num_threads; ++i)
+    workers_.push_back(std::make_unique<Worker>(thread_name));
+}
+
+ProcessThreadPool::~ProcessThreadPool() = default;
+
+std::unique_ptr<ProcessThread> ProcessThreadPool::CreateProcessThread() {
+  rtc::CritScope lock(&lock_);
+  Worker* least_loaded = workers_.front().get();
+  for (const auto& worker : workers_) {
+    if (worker->num_clients() < least_loaded->num_clients())
+      least_loaded = worker.get();
+  }
+  return std::make_unique<PooledProcessThread>(least_loaded);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/process_thread_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/task_queue/queued_task.h"
+#include "modules/include/module.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+
+constexpr int kEventWaitTimeout = 500;
+
+class MockModule : public Module {
+ public:
+  MOCK_METHOD0(TimeUntilNextProcess, int64_t());
+  MOCK_METHOD0(Process, void());
+  MOCK_METHOD1(ProcessThreadAttached, void(ProcessThread*));
+};
+
+class RaiseEventTask : public QueuedTask {
+ public:
+  explicit RaiseEventTask(rtc::Event* event) : event_(event) {}
+  bool Run() override {
+    event_->Set();
+    return true;
+  }
+
+ private:
+  rtc::Event* event_;
+};
+
+ACTION_P(SetEvent, event) {
+  event->Set();
+}
+
+TEST(ProcessThreadPoolTest, ProcessesModulesOfAllThreads) {
+  ProcessThreadPool pool("PacerThread", 1);
+  std::unique_ptr<ProcessThread> thread1 = pool.CreateProcessThread();
+  std::unique_ptr<ProcessThread> thread2 = pool.CreateProcessThread();
+
+  rtc::Event event1;
+  rtc::Event event2;
+  MockModule module1;
+  MockModule module2;
+  EXPECT_CALL(module1, TimeUntilNextProcess()).WillRepeatedly(Return(1));
+  EXPECT_CALL(module2, TimeUntilNextProcess()).WillRepeatedly(Return(1));
+  EXPECT_CALL(module1, Process())
+      .WillOnce(DoAll(SetEvent(&event1), Return()))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module2, Process())
+      .WillOnce(DoAll(SetEvent(&event2), Return()))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module1, ProcessThreadAttached(thread1.get())).Times(1);
+  EXPECT_CALL(module2, ProcessThreadAttached(thread2.get())).Times(1);
+
+  thread1->RegisterModule(&module1, RTC_FROM_HERE);
+  thread2->RegisterModule(&module2, RTC_FROM_HERE);
+  thread1->Start();
+  thread2->Start();
+  EXPECT_TRUE(event1.Wait(kEventWaitTimeout));
+  EXPECT_TRUE(event2.Wait(kEventWaitTimeout));
+
+  EXPECT_CALL(module1, ProcessThreadAttached(nullptr)).Times(1);
+  EXPECT_CALL(module2, ProcessThreadAttached(nullptr)).Times(1);
+  thread1->DeRegisterModule(&module1);
+  thread2->DeRegisterModule(&module2);
+  thread1->Stop();
+  thread2->Stop();
+}
+
+TEST(ProcessThreadPoolTest, StoppedThreadIsNotProcessed) {
+  ProcessThreadPool pool("PacerThread", 1);
+  std::unique_ptr<ProcessThread> thread = pool.CreateProcessThread();
+
+  MockModule module;
+  EXPECT_CALL(module, TimeUntilNextProcess()).WillRepeatedly(Return(0));
+  EXPECT_CALL(module, Process()).Times(0);
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  thread->RegisterModule(&module, RTC_FROM_HERE);
+
+  rtc::Event event;
+  thread->PostTask(std::make_unique<RaiseEventTask>(&event));
+  EXPECT_FALSE(event.Wait(20));
+
+  thread->DeRegisterModule(&module);
+}
+
+TEST(ProcessThreadPoolTest, WakeUpProcessesSleepingModule) {
+  ProcessThreadPool pool("PacerThread", 2);
+  std::unique_ptr<ProcessThread> thread = pool.CreateProcessThread();
+
+  rtc::Event event;
+  MockModule module;
+  // Sleep until explicitly woken up.
+  EXPECT_CALL(module, TimeUntilNextProcess()).WillRepeatedly(Return(10000));
+  EXPECT_CALL(module, Process())
+      .WillOnce(DoAll(SetEvent(&event), Return()))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module, ProcessThreadAttached(_)).Times(2);
+
+  thread->Start();
+  thread->RegisterModule(&module, RTC_FROM_HERE);
+  EXPECT_FALSE(event.Wait(20));
+
+  thread->WakeUp(&module);
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+
+  thread->DeRegisterModule(&module);
+  thread->Stop();
+}
+
+TEST(ProcessThreadPoolTest, PostTask) {
+  ProcessThreadPool pool("PacerThread", 2);
+  std::unique_ptr<ProcessThread> thread = pool.CreateProcessThread();
+
+  rtc::Event event;
+  thread->PostTask(std::make_unique<RaiseEventTask>(&event));
+  thread->Start();
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+  thread->Stop();
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,349 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/source/task_queue_process_thread.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+// Stale heap entries are removed once the heap is this much larger than twice
+// the number of modules.
+constexpr size_t kMinStaleDeadlinesForCompaction = 16;
+
+int64_t GetNextCallbackTime(Module* module, int64_t time_now) {
+  int64_t interval = module->TimeUntilNextProcess();
+  if (interval < 0) {
+    // Falling behind, we should call the callback now.
+    return time_now;
+  }
+  return time_now + interval;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<ProcessThread> ProcessThread::Create(
+    const char* thread_name,
+    TaskQueueFactory* task_queue_factory) {
+  return std::make_unique<TaskQueueProcessThread>(thread_name,
+                                                  task_queue_factory);
+}
+
+TaskQueueProcessThread::TaskQueueProcessThread(
+    const char* thread_name,
+    TaskQueueFactory* task_queue_factory)
+    : thread_name_(thread_name),
+      next_generation_(0),
+      started_(false),
+      scheduled_wake_up_ms_(-1),
+      planned_run_time_us_(0),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          thread_name,
+          TaskQueueFactory::Priority::NORMAL)) {}
+
+TaskQueueProcessThread::~TaskQueueProcessThread() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+#if RTC_DCHECK_IS_ON
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(!started_);
+#endif
+}
+
+void TaskQueueProcessThread::Start() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  std::vector<Module*> modules;
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(!started_);
+    if (started_)
+      return;
+    int64_t now = rtc::TimeMillis();
+    for (auto& it : modules_) {
+      it.second.query_next_callback = true;
+      PushDeadline(it.first, &it.second, now);
+      modules.push_back(it.first);
+    }
+  }
+
+  for (Module* module : modules)
+    module->ProcessThreadAttached(this);
+
+  rtc::CritScope lock(&lock_);
+  started_ = true;
+  WakeUpTaskQueue(rtc::TimeMillis());
+  if (!queue_.empty())
+    task_queue_->PostTask(ToQueuedTask([this] { RunPendingTasks(); }));
+}
+
+void TaskQueueProcessThread::Stop() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  std::vector<Module*> modules;
+  {
+    rtc::CritScope lock(&lock_);
+    if (!started_)
+      return;
+    started_ = false;
+    deadlines_.clear();
+    scheduled_wake_up_ms_ = -1;
+    for (const auto& it : modules_)
+      modules.push_back(it.first);
+  }
+
+  // Wait for a module or task that is currently running to finish. Nothing is
+  // run after that, since |started_| is now false.
+  rtc::Event stopped;
+  task_queue_->PostTask(ToQueuedTask([this, &stopped] {
+    repeating_task_.Stop();
+    stopped.Set();
+  }));
+  stopped.Wait(rtc::Event::kForever);
+
+  for (Module* module : modules)
+    module->ProcessThreadAttached(nullptr);
+}
+
+void TaskQueueProcessThread::WakeUp(Module* module) {
+  // Allowed to be called on any thread.
+  rtc::CritScope lock(&lock_);
+  auto it = modules_.find(module);
+  if (it == modules_.end())
+    return;
+  int64_t now = rtc::TimeMillis();
+  it->second.query_next_callback = false;
+  PushDeadline(module, &it->second, now);
+  WakeUpTaskQueue(now);
+}
+
+void TaskQueueProcessThread::PostTask(std::unique_ptr<QueuedTask> task) {
+  // Allowed to be called on any thread.
+  rtc::CritScope lock(&lock_);
+  queue_.push(std::move(task));
+  if (started_)
+    task_queue_->PostTask(ToQueuedTask([this] { RunPendingTasks(); }));
+}
+
+void TaskQueueProcessThread::RegisterModule(Module* module,
+                                            const rtc::Location& from) {
+  RTC_DCHECK(module) << from.ToString();
+  bool started;
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(modules_.find(module) == modules_.end())
+        << "Already registered here: "
+        << modules_.find(module)->second.location.ToString() << "\n"
+        << "Now attempting from here: " << from.ToString();
+    started = started_;
+  }
+
+  // Notify the module while not holding the lock, as ProcessThreadImpl does.
+  if (started)
+    module->ProcessThreadAttached(this);
+
+  rtc::CritScope lock(&lock_);
+  auto it = modules_.emplace(module, ModuleCallback(from, 0)).first;
+  int64_t now = rtc::TimeMillis();
+  PushDeadline(module, &it->second, now);
+  WakeUpTaskQueue(now);
+}
+
+void TaskQueueProcessThread::DeRegisterModule(Module* module) {
+  RTC_DCHECK(module);
+  {
+    // Blocks until the module is no longer being processed. Heap entries of
+    // the module become stale and are skipped.
+    rtc::CritScope lock(&lock_);
+    modules_.erase(module);
+  }
+
+  // Notify the module that it's been detached.
+  module->ProcessThreadAttached(nullptr);
+}
+
+TimeDelta TaskQueueProcessThread::Process() {
+  RTC_DCHECK_RUN_ON(task_queue_.get());
+  TRACE_EVENT1("webrtc", "TaskQueueProcessThread", "name", thread_name_);
+  rtc::CritScope lock(&lock_);
+  if (!started_) {
+    repeating_task_.Stop();
+    return TimeDelta::Zero();
+  }
+
+  int64_t now = rtc::TimeMillis();
+  // New deadlines of processed modules are pushed after the loop, so that a
+  // module that wants to be called back right away is processed at most once
+  // per wake-up.
+  std::vector<std::pair<Module*, int64_t>> next_deadlines;
+  RemoveStaleDeadlines();
+  while (!deadlines_.empty() && deadlines_.front().time_ms <= now) {
+    Deadline deadline = deadlines_.front();
+    std::pop_heap(deadlines_.begin(), deadlines_.end(),
+                  std::greater<Deadline>());
+    deadlines_.pop_back();
+    auto it = modules_.find(deadline.module);
+    if (it == modules_.end() || it->second.generation != deadline.generation)
+      continue;
+
+    ModuleCallback* callback = &it->second;
+    if (callback->query_next_callback) {
+      callback->query_next_callback = false;
+      int64_t next_callback = GetNextCallbackTime(deadline.module, now);
+      if (next_callback > now) {
+        PushDeadline(deadline.module, callback, next_callback);
+        continue;
+      }
+    }
+
+    {
+      TRACE_EVENT2("webrtc", "ModuleProcess", "function",
+                   callback->location.function_name(), "file",
+                   callback->location.file_and_line());
+      deadline.module->Process();
+    }
+    // The module may have deregistered itself.
+    it = modules_.find(deadline.module);
+    if (it == modules_.end())
+      continue;
+    // Entries pushed while processing, e.g. by WakeUp(), are replaced by the
+    // next callback time, as for ProcessThreadImpl.
+    it->second.generation = ++next_generation_;
+    next_deadlines.emplace_back(
+        deadline.module,
+        GetNextCallbackTime(deadline.module, rtc::TimeMillis()));
+  }
+
+  for (const auto& next_deadline : next_deadlines) {
+    auto it = modules_.find(next_deadline.first);
+    if (it != modules_.end())
+      PushDeadline(next_deadline.first, &it->second, next_deadline.second);
+  }
+
+  RemoveStaleDeadlines();
+  if (deadlines_.empty()) {
+    // Sleep until a module is registered or woken up.
+    scheduled_wake_up_ms_ = -1;
+    repeating_task_.Stop();
+    return TimeDelta::Zero();
+  }
+
+  // RepeatingTaskHandle subtracts the time lost since the planned run time from
+  // the returned delay, so return the delay relative to that time.
+  int64_t next_run_time_us =
+      deadlines_.front().time_ms * rtc::kNumMicrosecsPerMillisec;
+  TimeDelta delay = TimeDelta::us(
+      std::max<int64_t>(next_run_time_us - planned_run_time_us_, 0));
+  planned_run_time_us_ += delay.us();
+  scheduled_wake_up_ms_ = deadlines_.front().time_ms;
+  return delay;
+}
+
+void TaskQueueProcessThread::MaybeReschedule() {
+  RTC_DCHECK_RUN_ON(task_queue_.get());
+  rtc::CritScope lock(&lock_);
+  if (!started_)
+    return;
+  RemoveStaleDeadlines();
+  if (deadlines_.empty() ||
+      (repeating_task_.Running() &&
+       planned_run_time_us_ <=
+           deadlines_.front().time_ms * rtc::kNumMicrosecsPerMillisec)) {
+    // Keep the current schedule, which may be no wake-up at all.
+    scheduled_wake_up_ms_ = repeating_task_.Running()
+                                ? planned_run_time_us_ /
+                                      rtc::kNumMicrosecsPerMillisec
+                                : -1;
+    return;
+  }
+
+  int64_t next_run_time_us =
+      deadlines_.front().time_ms * rtc::kNumMicrosecsPerMillisec;
+
+  repeating_task_.Stop();
+  int64_t now_us = rtc::TimeMicros();
+  TimeDelta delay =
+      TimeDelta::us(std::max<int64_t>(next_run_time_us - now_us, 0));
+  planned_run_time_us_ = now_us + delay.us();
+  scheduled_wake_up_ms_ = deadlines_.front().time_ms;
+  // Modules such as the pacer expect to be processed on time.
+  repeating_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_.get(), delay, [this] { return Process(); },
+      TaskQueueBase::DelayPrecision::kHigh);
+}
+
+void TaskQueueProcessThread::RunPendingTasks() {
+  RTC_DCHECK_RUN_ON(task_queue_.get());
+  while (true) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      rtc::CritScope lock(&lock_);
+      if (!started_ || queue_.empty())
+        return;
+      task = std::move(queue_.front());
+      queue_.pop();
+    }
+    if (!task->Run())
+      task.release();
+  }
+}
+
+void TaskQueueProcessThread::PushDeadline(Module* module,
+                                          ModuleCallback* callback,
+                                          int64_t time_ms) {
+  callback->generation = ++next_generation_;
+  deadlines_.push_back(Deadline{time_ms, module, callback->generation});
+  std::push_heap(deadlines_.begin(), deadlines_.end(),
+                 std::greater<Deadline>());
+
+  if (deadlines_.size() >
+      2 * modules_.size() + kMinStaleDeadlinesForCompaction) {
+    deadlines_.erase(
+        std::remove_if(deadlines_.begin(), deadlines_.end(),
+                       [this](const Deadline& deadline) {
+                         auto it = modules_.find(deadline.module);
+                         return it == modules_.end() ||
+                                it->second.generation != deadline.generation;
+                       }),
+        deadlines_.end());
+    std::make_heap(deadlines_.begin(), deadlines_.end(),
+                   std::greater<Deadline>());
+  }
+}
+
+void TaskQueueProcessThread::RemoveStaleDeadlines() {
+  while (!deadlines_.empty()) {
+    const Deadline& deadline = deadlines_.front();
+    auto it = modules_.find(deadline.module);
+    if (it != modules_.end() && it->second.generation == deadline.generation)
+      return;
+    std::pop_heap(deadlines_.begin(), deadlines_.end(),
+                  std::greater<Deadline>());
+    deadlines_.pop_back();
+  }
+}
+
+void TaskQueueProcessThread::WakeUpTaskQueue(int64_t time_ms) {
+  if (!started_)
+    return;
+  if (scheduled_wake_up_ms_ >= 0 && scheduled_wake_up_ms_ <= time_ms)
+    return;
+  scheduled_wake_up_ms_ = time_ms;
+  task_queue_->PostTask(ToQueuedTask([this] { MaybeReschedule(); }));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_UTILITY_SOURCE_TASK_QUEUE_PROCESS_THREAD_H_
+#define MODULES_UTILITY_SOURCE_TASK_QUEUE_PROCESS_THREAD_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/include/module.h"
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/location.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+// ProcessThread implementation running on a task queue. Instead of polling
+// every module on each wake-up, the next callback time of each module is kept
+// in a min-heap and a single repeating task is scheduled for the earliest one,
+// so the number of wake-ups equals the number of module deadlines.
+//
+// Modules are only asked for TimeUntilNextProcess() after being registered,
+// processed or woken up, as for ProcessThreadImpl.
+class TaskQueueProcessThread : public ProcessThread {
+ public:
+  TaskQueueProcessThread(const char* thread_name,
+                         TaskQueueFactory* task_queue_factory);
+  ~TaskQueueProcessThread() override;
+
+  void Start() override;
+  void Stop() override;
+
+  void WakeUp(Module* module) override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+
+  void RegisterModule(Module* module, const rtc::Location& from) override;
+  void DeRegisterModule(Module* module) override;
+
+ private:
+  struct ModuleCallback {
+    ModuleCallback(const rtc::Location& location, uint64_t generation)
+        : location(location), generation(generation) {}
+
+    const rtc::Location location;
+    // Identifies the heap entry currently valid for this module. Entries with
+    // another generation are stale and skipped when they reach the top.
+    uint64_t generation;
+    // If set, the module has to be asked for TimeUntilNextProcess() rather
+    // than being processed when its entry is due.
+    bool query_next_callback = true;
+  };
+
+  struct Deadline {
+    bool operator>(const Deadline& other) const {
+      return time_ms > other.time_ms;
+    }
+
+    int64_t time_ms;
+    Module* module;
+    uint64_t generation;
+  };
+
+  // Runs on |task_queue_|. Processes all due modules and returns the time until
+  // the next deadline.
+  TimeDelta Process();
+  // Runs on |task_queue_|. Restarts |repeating_task_| if the earliest deadline
+  // is before the currently scheduled wake-up.
+  void MaybeReschedule();
+  void RunPendingTasks();
+
+  void PushDeadline(Module* module, ModuleCallback* callback, int64_t time_ms)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Pops stale entries until the top of the heap is valid or it is empty.
+  void RemoveStaleDeadlines() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Wakes up the task queue if |time_ms| is before the scheduled wake-up.
+  void WakeUpTaskQueue(int64_t time_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  rtc::ThreadChecker thread_checker_;
+  const char* const thread_name_;
+
+  // Held while modules are processed, so that DeRegisterModule() does not
+  // return while the module is being processed.
+  rtc::CriticalSection lock_;
+  std::unordered_map<Module*, ModuleCallback> modules_ RTC_GUARDED_BY(lock_);
+  // Min-heap ordered on Deadline::time_ms.
+  std::vector<Deadline> deadlines_ RTC_GUARDED_BY(lock_);
+  uint64_t next_generation_ RTC_GUARDED_BY(lock_);
+  std::queue<std::unique_ptr<QueuedTask>> queue_ RTC_GUARDED_BY(lock_);
+  bool started_ RTC_GUARDED_BY(lock_);
+  // Time of the next wake-up of |repeating_task_|, or -1 if not running.
+  int64_t scheduled_wake_up_ms_ RTC_GUARDED_BY(lock_);
+
+  // Only accessed on |task_queue_|.
+  RepeatingTaskHandle repeating_task_;
+  int64_t planned_run_time_us_;
+
+  // Destroyed first, so that pending tasks don't outlive the members above.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_UTILITY_SOURCE_TASK_QUEUE_PROCESS_THREAD_H_
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/source/task_queue_process_thread.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/queued_task.h"
+#include "modules/include/module.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "rtc_base/time_utils.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::Return;
+
+constexpr int kEventWaitTimeout = 500;
+
+class MockModule : public Module {
+ public:
+  MOCK_METHOD0(TimeUntilNextProcess, int64_t());
+  MOCK_METHOD0(Process, void());
+  MOCK_METHOD1(ProcessThreadAttached, void(ProcessThread*));
+};
+
+class RaiseEventTask : public QueuedTask {
+ public:
+  explicit RaiseEventTask(rtc::Event* event) : event_(event) {}
+  bool Run() override {
+    event_->Set();
+    return true;
+  }
+
+ private:
+  rtc::Event* event_;
+};
+
+ACTION_P(SetEvent, event) {
+  event->Set();
+}
+
+ACTION_P(Increment, counter) {
+  ++(*counter);
+}
+
+class TaskQueueProcessThreadTest : public ::testing::Test {
+ protected:
+  TaskQueueProcessThreadTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        thread_("ProcessThread", task_queue_factory_.get()) {}
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  TaskQueueProcessThread thread_;
+};
+
+TEST_F(TaskQueueProcessThreadTest, StartStop) {
+  thread_.Start();
+  thread_.Stop();
+  thread_.Start();
+  thread_.Stop();
+}
+
+TEST_F(TaskQueueProcessThreadTest, ProcessCall) {
+  thread_.Start();
+
+  rtc::Event event;
+  MockModule module;
+  EXPECT_CALL(module, TimeUntilNextProcess())
+      .WillOnce(Return(0))
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(module, Process())
+      .WillOnce(DoAll(SetEvent(&event), Return()))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module, ProcessThreadAttached(&thread_)).Times(1);
+
+  thread_.RegisterModule(&module, RTC_FROM_HERE);
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  thread_.DeRegisterModule(&module);
+  thread_.Stop();
+}
+
+TEST_F(TaskQueueProcessThreadTest, Deregister) {
+  rtc::Event event;
+  int process_count = 0;
+  MockModule module;
+  EXPECT_CALL(module, TimeUntilNextProcess())
+      .WillOnce(Return(0))
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(module, Process())
+      .WillOnce(DoAll(SetEvent(&event), Increment(&process_count), Return()))
+      .WillRepeatedly(DoAll(Increment(&process_count), Return()));
+
+  thread_.RegisterModule(&module, RTC_FROM_HERE);
+  EXPECT_CALL(module, ProcessThreadAttached(&thread_)).Times(1);
+  thread_.Start();
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  thread_.DeRegisterModule(&module);
+  EXPECT_GE(process_count, 1);
+  int count_after_deregister = process_count;
+
+  // We shouldn't get any more callbacks.
+  EXPECT_FALSE(event.Wait(20));
+  EXPECT_EQ(count_after_deregister, process_count);
+  thread_.Stop();
+}
+
+// Only the module whose deadline is reached is asked for its next callback
+// time; other modules are not polled.
+TEST_F(TaskQueueProcessThreadTest, DoesNotPollSleepingModules) {
+  rtc::Event event;
+  int fast_process_count = 0;
+  MockModule fast_module;
+  MockModule slow_module;
+  EXPECT_CALL(fast_module, TimeUntilNextProcess()).WillRepeatedly(Return(5));
+  EXPECT_CALL(fast_module, Process())
+      .WillRepeatedly(Invoke([&] {
+        if (++fast_process_count == 10)
+          event.Set();
+      }));
+  // Queried once on registration and never processed.
+  EXPECT_CALL(slow_module, TimeUntilNextProcess())
+      .Times(1)
+      .WillOnce(Return(10000));
+  EXPECT_CALL(slow_module, Process()).Times(0);
+  EXPECT_CALL(fast_module, ProcessThreadAttached(_)).Times(2);
+  EXPECT_CALL(slow_module, ProcessThreadAttached(_)).Times(2);
+
+  thread_.Start();
+  thread_.RegisterModule(&slow_module, RTC_FROM_HERE);
+  thread_.RegisterModule(&fast_module, RTC_FROM_HERE);
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+
+  thread_.DeRegisterModule(&fast_module);
+  thread_.DeRegisterModule(&slow_module);
+  thread_.Stop();
+}
+
+TEST_F(TaskQueueProcessThreadTest, WakeUp) {
+  rtc::Event event;
+  MockModule module;
+  int64_t wake_up_time = 0;
+  int64_t process_time = 0;
+  EXPECT_CALL(module, TimeUntilNextProcess()).WillRepeatedly(Return(10000));
+  EXPECT_CALL(module, Process())
+      .WillOnce(Invoke([&] {
+        process_time = rtc::TimeMillis();
+        event.Set();
+      }))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module, ProcessThreadAttached(_)).Times(2);
+
+  thread_.Start();
+  thread_.RegisterModule(&module, RTC_FROM_HERE);
+  EXPECT_FALSE(event.Wait(20));
+
+  wake_up_time = rtc::TimeMillis();
+  thread_.WakeUp(&module);
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+  EXPECT_LT(process_time - wake_up_time, 50);
+
+  thread_.DeRegisterModule(&module);
+  thread_.Stop();
+}
+
+TEST_F(TaskQueueProcessThreadTest, PostTask) {
+  rtc::Event task_ran;
+  thread_.PostTask(std::make_unique<RaiseEventTask>(&task_ran));
+  EXPECT_FALSE(task_ran.Wait(20));
+
+  thread_.Start();
+  EXPECT_TRUE(task_ran.Wait(kEventWaitTimeout));
+  thread_.Stop();
+}
+
+TEST(ProcessThreadTest, CreatesTaskQueueBasedThread) {
+  auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  std::unique_ptr<ProcessThread> thread =
+      ProcessThread::Create("ProcessThread", task_queue_factory.get());
+  rtc::Event task_ran;
+  thread->PostTask(std::make_unique<RaiseEventTask>(&task_ran));
+  thread->Start();
+  EXPECT_TRUE(task_ran.Wait(kEventWaitTimeout));
+  thread->Stop();
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -154,9 +154,13 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   // In Windows, the image starts bottom left, instead of top left.
   // Setting a negative source height, inverts the image (within LibYuv).
 
-  // TODO(nisse): Use a pool?
-  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(
+  rtc::scoped_refptr<I420Buffer> buffer = buffer_pool_.CreateBuffer(
       target_width, target_height, stride_y, stride_uv, stride_uv);
+  if (!buffer) {
+    // All pooled buffers are still held downstream.
+    buffer = I420Buffer::Create(target_width, target_height, stride_y,
+                                stride_uv, stride_uv);
+  }
 
   libyuv::RotationMode rotation_mode = libyuv::kRotate0;
   if (apply_rotation) {
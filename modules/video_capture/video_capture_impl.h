@@ -22,6 +22,7 @@
 #include "api/video/video_frame.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_capture/video_capture.h"
 #include "modules/video_capture/video_capture_config.h"
 #include "modules/video_capture/video_capture_defines.h"
@@ -102,6 +103,10 @@ class VideoCaptureImpl : public VideoCaptureModule {
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_;
+
+  // Reuses the converted frames once the sinks release them, instead of
+  // allocating a new buffer per captured frame.
+  I420BufferPool buffer_pool_;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -55,6 +55,20 @@ enum H264DecoderImplEvent {
   kH264DecoderEventMax = 16,
 };
 
+// Unlike frame threading, slice threading decodes the slices of one frame in
+// parallel and so adds no delay. It only helps if the stream has several
+// slices per frame, which is common for high resolutions.
+int NumberOfDecodeThreads(int width, int height, int number_of_cores) {
+  if (width * height >= 3840 * 2160 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1920 * 1080 && number_of_cores > 4) {
+    return 4;
+  } else if (width * height > 1280 * 720 && number_of_cores >= 3) {
+    return 2;
+  }
+  return 1;
+}
+
 }  // namespace
 
 int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
@@ -153,6 +167,8 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
 H264DecoderImpl::H264DecoderImpl()
     : kEnable8bitHdrFix_(
           !field_trial::IsEnabled("WebRTC-8bitH264HdrKillSwitch")),
+      enable_slice_threading_(
+          field_trial::IsEnabled("WebRTC-H264DecoderSliceThreading")),
       pool_(true),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
@@ -191,9 +207,15 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->extradata = nullptr;
   av_context_->extradata_size = 0;
 
-  // If this is ever increased, look at |av_context_->thread_safe_callbacks| and
-  // make it possible to disable the thread checker in the frame buffer pool.
+  // With slice threading, |get_buffer2| is still only called on the decoding
+  // thread. Frame threading isn't used, since it delays the output by a frame
+  // per thread. The resolution is unknown until the first key frame, in which
+  // case one thread is used.
   av_context_->thread_count = 1;
+  if (enable_slice_threading_ && codec_settings) {
+    av_context_->thread_count = NumberOfDecodeThreads(
+        codec_settings->width, codec_settings->height, number_of_cores);
+  }
   av_context_->thread_type = FF_THREAD_SLICE;
 
   // Function used by FFmpeg to get buffers to store decoded frames in.
@@ -78,6 +78,9 @@ class H264DecoderImpl : public H264Decoder {
 
  private:
   const bool kEnable8bitHdrFix_;
+  // Decode the slices of a frame in parallel, on up to |number_of_cores|
+  // threads depending on the resolution.
+  const bool enable_slice_threading_;
   // Called by FFmpeg when it needs a frame buffer to store decoded frames in.
   // The |VideoFrame| returned by FFmpeg at |Decode| originate from here. Their
   // buffers are reference counted and freed by FFmpeg using |AVFreeBuffer2|.
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "absl/strings/match.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "modules/video_coding/utility/simulcast_utility.h"
@@ -88,8 +89,9 @@ VideoFrameType ConvertToVideoFrameType(EVideoFrameType type) {
 
 // Helper method used by H264EncoderImpl::Encode.
 // Copies the encoded bytes from |info| to |encoded_image| and updates the
-// fragmentation information of |frag_header|. The |encoded_image->_buffer| may
-// be deleted and reallocated if a bigger buffer is required.
+// fragmentation information of |frag_header|. The |encoded_image->_buffer| is
+// replaced by a buffer from |buffer_pool| that is big enough to hold the
+// frame.
 //
 // After OpenH264 encoding, the encoded bytes are stored in |info| spread out
 // over a number of layers and "NAL units". Each NAL unit is a fragment starting
@@ -100,7 +102,8 @@ VideoFrameType ConvertToVideoFrameType(EVideoFrameType type) {
 static void RtpFragmentize(EncodedImage* encoded_image,
                            const VideoFrameBuffer& frame_buffer,
                            SFrameBSInfo* info,
-                           RTPFragmentationHeader* frag_header) {
+                           RTPFragmentationHeader* frag_header,
+                           video_coding::EncodedImageBufferPool* buffer_pool) {
   // Calculate minimum buffer size required to hold encoded data.
   size_t required_capacity = 0;
   size_t fragments_count = 0;
@@ -114,8 +117,7 @@ static void RtpFragmentize(EncodedImage* encoded_image,
       required_capacity += layerInfo.pNalLengthInByte[nal];
     }
   }
-  // TODO(nisse): Use a cache or buffer pool to avoid allocation?
-  encoded_image->SetEncodedData(EncodedImageBuffer::Create(required_capacity));
+  encoded_image->SetEncodedData(buffer_pool->CreateBuffer(required_capacity));
 
   // Iterate layers and NAL units, note each NAL unit as a fragment and copy
   // the data to |encoded_image->_buffer|.
@@ -384,8 +386,11 @@ int32_t H264EncoderImpl::Encode(
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
+  // NV12 input is converted into a pooled buffer, to not allocate per frame.
   rtc::scoped_refptr<const I420BufferInterface> frame_buffer =
-      input_frame.video_frame_buffer()->ToI420();
+      ConvertToI420(input_frame.video_frame_buffer(), I420BufferPool::Shared());
+  if (!frame_buffer)
+    return WEBRTC_VIDEO_CODEC_ERROR;
 
   bool send_key_frame = false;
   for (size_t i = 0; i < configurations_.size(); ++i) {
@@ -487,7 +492,8 @@ int32_t H264EncoderImpl::Encode(
     // Split encoded image up into fragments. This also updates
     // |encoded_image_|.
     RTPFragmentationHeader frag_header;
-    RtpFragmentize(&encoded_images_[i], *frame_buffer, &info, &frag_header);
+    RtpFragmentize(&encoded_images_[i], *frame_buffer, &info, &frag_header,
+                   &encoded_buffer_pool_);
 
     // Encoder can skip frames to save bandwidth in which case
     // |encoded_images_[i]._length| == 0.
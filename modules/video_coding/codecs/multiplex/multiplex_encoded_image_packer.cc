@@ -130,7 +130,7 @@ MultiplexImageComponentHeader UnpackFrameHeader(const uint8_t* buffer) {
   return frame_header;
 }
 
-void PackBitstream(uint8_t* buffer, MultiplexImageComponent image) {
+void PackBitstream(uint8_t* buffer, const MultiplexImageComponent& image) {
   memcpy(buffer, image.encoded_image.data(), image.encoded_image.size());
 }
 
@@ -262,13 +262,14 @@ MultiplexImage MultiplexEncodedImagePacker::Unpack(
     EncodedImage encoded_image = combined_image;
     encoded_image.SetTimestamp(combined_image.Timestamp());
     encoded_image._frameType = frame_headers[i].frame_type;
-    encoded_image.SetEncodedData(EncodedImageBuffer::Create(
-        combined_image.data() + frame_headers[i].bitstream_offset,
-        frame_headers[i].bitstream_length));
+    encoded_image.set_buffer(
+        combined_image.mutable_data() + frame_headers[i].bitstream_offset,
+        frame_headers[i].bitstream_length);
+    encoded_image.set_size(frame_headers[i].bitstream_length);
 
-    image_component.encoded_image = encoded_image;
+    image_component.encoded_image = std::move(encoded_image);
 
-    multiplex_image.image_components.push_back(image_component);
+    multiplex_image.image_components.push_back(std::move(image_component));
   }
 
   return multiplex_image;
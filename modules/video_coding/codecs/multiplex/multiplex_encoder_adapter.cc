@@ -294,9 +294,6 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
       PayloadStringToCodecType(associated_format_.name);
   image_component.encoded_image = encodedImage;
 
-  // If we don't already own the buffer, make a copy.
-  image_component.encoded_image.Retain();
-
   rtc::CritScope cs(&crit_);
   const auto& stashed_image_itr =
       stashed_images_.find(encodedImage.Timestamp());
@@ -305,7 +302,13 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
   MultiplexImage& stashed_image = stashed_image_itr->second;
   const uint8_t frame_count = stashed_image.component_count;
 
-  stashed_image.image_components.push_back(image_component);
+  // The image is packed as soon as its last component arrives, while this
+  // callback still has it. Only components stashed for later need a copy,
+  // since the encoder may reuse its buffer once this callback returns.
+  if (stashed_image.image_components.size() + 1 < frame_count)
+    image_component.encoded_image.Retain();
+
+  stashed_image.image_components.push_back(std::move(image_component));
 
   if (stashed_image.image_components.size() == frame_count) {
     // Complete case
@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "api/test/create_videocodec_test_fixture.h"
+#include "media/base/media_constants.h"
+#include "rtc_base/numerics/samples_stats_counter.h"
+#include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+const int kNumFrames = 100;
+const int kCoreCounts[] = {1, 2, 4, 8};
+
+struct BenchmarkCase {
+  const char* codec_name;
+  const char* filename;
+  size_t width;
+  size_t height;
+  size_t num_simulcast_streams;
+  size_t num_spatial_layers;
+  size_t target_kbps;
+};
+
+const BenchmarkCase kBenchmarkCases[] = {
+    {cricket::kVp8CodecName, "foreman_cif", 352, 288, 1, 1, 500},
+    {cricket::kVp8CodecName, "ConferenceMotion_1280_720_50", 1280, 720, 1, 1,
+     1500},
+    {cricket::kVp8CodecName, "ConferenceMotion_1280_720_50", 1280, 720, 3, 1,
+     2500},
+    {cricket::kVp9CodecName, "foreman_cif", 352, 288, 1, 1, 500},
+    {cricket::kVp9CodecName, "ConferenceMotion_1280_720_50", 1280, 720, 1, 1,
+     1500},
+    {cricket::kVp9CodecName, "ConferenceMotion_1280_720_50", 1280, 720, 1, 3,
+     2500},
+#if defined(WEBRTC_USE_H264)
+    {cricket::kH264CodecName, "foreman_cif", 352, 288, 1, 1, 500},
+    {cricket::kH264CodecName, "ConferenceMotion_1280_720_50", 1280, 720, 1, 1,
+     1500},
+#endif
+};
+
+struct BenchmarkResult {
+  SamplesStatsCounter encode_time_ms;
+  SamplesStatsCounter decode_time_ms;
+
+  double EncodeFps() const { return Fps(encode_time_ms); }
+  double DecodeFps() const { return Fps(decode_time_ms); }
+
+ private:
+  static double Fps(const SamplesStatsCounter& frame_time_ms) {
+    return frame_time_ms.IsEmpty() || frame_time_ms.GetAverage() <= 0
+               ? 0.0
+               : 1000.0 / frame_time_ms.GetAverage();
+  }
+};
+
+std::string CaseName(const BenchmarkCase& benchmark_case) {
+  rtc::StringBuilder name;
+  name << benchmark_case.codec_name << "_" << benchmark_case.width << "x"
+       << benchmark_case.height << "_S"
+       << std::max(benchmark_case.num_simulcast_streams,
+                   benchmark_case.num_spatial_layers);
+  return name.Release();
+}
+
+BenchmarkResult RunCase(const BenchmarkCase& benchmark_case,
+                        size_t num_cores) {
+  VideoCodecTestFixture::Config config;
+  config.filename = benchmark_case.filename;
+  config.filepath = ResourcePath(config.filename, "yuv");
+  config.num_frames = kNumFrames;
+  config.num_cores = num_cores;
+  config.test_name = CaseName(benchmark_case) + "_" +
+                     std::to_string(num_cores) + "cores";
+  config.SetCodecSettings(benchmark_case.codec_name,
+                          benchmark_case.num_simulcast_streams,
+                          benchmark_case.num_spatial_layers, 1, false, false,
+                          false, benchmark_case.width, benchmark_case.height);
+  auto fixture = CreateVideoCodecTestFixture(config);
+  std::vector<RateProfile> rate_profiles = {
+      {benchmark_case.target_kbps, 30, 0}};
+  fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+
+  // All layers of a frame are produced by one encode call and delivered when
+  // it is done, so the encode time of a frame is that of its slowest layer.
+  // Each layer has a decoder of its own, run one after the other, so the
+  // decode time of a frame is the sum over its layers.
+  std::map<size_t, size_t> encode_time_us;
+  std::map<size_t, size_t> decode_time_us;
+  for (const auto& frame_stat : fixture->GetStats().GetFrameStatistics()) {
+    if (frame_stat.encoding_successful) {
+      size_t& frame_encode_time_us = encode_time_us[frame_stat.frame_number];
+      frame_encode_time_us =
+          std::max(frame_encode_time_us, frame_stat.encode_time_us);
+    }
+    if (frame_stat.decoding_successful)
+      decode_time_us[frame_stat.frame_number] += frame_stat.decode_time_us;
+  }
+  BenchmarkResult result;
+  for (const auto& frame_time : encode_time_us)
+    result.encode_time_ms.AddSample(frame_time.second / 1000.0);
+  for (const auto& frame_time : decode_time_us)
+    result.decode_time_ms.AddSample(frame_time.second / 1000.0);
+  return result;
+}
+
+void PrintTimeResults(const std::string& measurement,
+                      const std::string& trace,
+                      SamplesStatsCounter* frame_time_ms) {
+  if (frame_time_ms->IsEmpty())
+    return;
+  PrintResult(measurement, "", trace, *frame_time_ms, "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult(measurement + "_p50", "", trace,
+              frame_time_ms->GetPercentile(0.50), "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult(measurement + "_p95", "", trace,
+              frame_time_ms->GetPercentile(0.95), "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult(measurement + "_p99", "", trace,
+              frame_time_ms->GetPercentile(0.99), "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+}
+}  // namespace
+
+// Sweeps codec, resolution, simulcast/SVC configuration and the number of
+// cores given to the encoder and decoder, and reports encode and decode speed,
+// frame time percentiles and how well the speed scales with the number of
+// cores. Scaling efficiency is the speed on n cores over n times the speed on
+// one core. The results are printed as perf results, to be written as JSON
+// with --isolated_script_test_perf_output, and as a summary table.
+TEST(VideoCodecTestBenchmark, DISABLED_CodecMatrix) {
+  const int max_cores = CpuInfo::DetectNumberOfCores();
+  printf("--> Summary\n");
+  printf("%-30s %9s %13s %13s %13s %13s %18s %18s\n", "case", "num_cores",
+         "enc_speed_fps", "dec_speed_fps", "enc_p95_ms", "dec_p95_ms",
+         "enc_scaling_pct", "dec_scaling_pct");
+  for (const BenchmarkCase& benchmark_case : kBenchmarkCases) {
+    const std::string case_name = CaseName(benchmark_case);
+    BenchmarkResult single_core_result;
+    for (int num_cores : kCoreCounts) {
+      if (num_cores > max_cores)
+        break;
+      BenchmarkResult result = RunCase(benchmark_case, num_cores);
+      ASSERT_FALSE(result.encode_time_ms.IsEmpty());
+      if (num_cores == 1)
+        single_core_result = result;
+
+      const std::string trace =
+          case_name + "_" + std::to_string(num_cores) + "cores";
+      PrintResult("enc_speed", "", trace, result.EncodeFps(), "fps", false,
+                  ImproveDirection::kBiggerIsBetter);
+      PrintResult("dec_speed", "", trace, result.DecodeFps(), "fps", false,
+                  ImproveDirection::kBiggerIsBetter);
+      PrintTimeResults("encode_time", trace, &result.encode_time_ms);
+      PrintTimeResults("decode_time", trace, &result.decode_time_ms);
+
+      const double enc_scaling_pct =
+          single_core_result.EncodeFps() > 0
+              ? 100.0 * result.EncodeFps() /
+                    (num_cores * single_core_result.EncodeFps())
+              : 0.0;
+      const double dec_scaling_pct =
+          single_core_result.DecodeFps() > 0
+              ? 100.0 * result.DecodeFps() /
+                    (num_cores * single_core_result.DecodeFps())
+              : 0.0;
+      if (num_cores > 1) {
+        PrintResult("enc_scaling_efficiency", "", trace, enc_scaling_pct, "%",
+                    false, ImproveDirection::kBiggerIsBetter);
+        PrintResult("dec_scaling_efficiency", "", trace, dec_scaling_pct, "%",
+                    false, ImproveDirection::kBiggerIsBetter);
+      }
+      printf("%-30s %9d %13.2f %13.2f %13.2f %13.2f %18.1f %18.1f\n",
+             case_name.c_str(), num_cores, result.EncodeFps(),
+             result.DecodeFps(), result.encode_time_ms.GetPercentile(0.95),
+             result.decode_time_ms.IsEmpty()
+                 ? 0.0
+                 : result.decode_time_ms.GetPercentile(0.95),
+             enc_scaling_pct, dec_scaling_pct);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
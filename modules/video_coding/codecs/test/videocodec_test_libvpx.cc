@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -482,5 +484,60 @@ TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
   PrintRdPerf(rd_stats);
 }
 
+// Reports the encode time of 720p VP9 SVC superframes with one, two and three
+// spatial layers, on one core and on all cores. Since libvpx encodes all
+// spatial layers of a superframe in one call, and each added layer is a new
+// lowest layer, the time spent on a layer is the increase in time over the
+// superframe without it.
+TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9EncodeSpeed) {
+  printf("--> Summary\n");
+  printf("%11s %18s %13s %16s %20s\n", "use_threads", "num_spatial_layers",
+         "added_layer", "layer_encode_ms", "superframe_encode_ms");
+  for (bool use_single_core : {true, false}) {
+    double prev_avg_encode_ms = 0.0;
+    for (size_t num_spatial_layers = 1; num_spatial_layers <= 3;
+         ++num_spatial_layers) {
+      auto config = CreateConfig();
+      config.filename = "ConferenceMotion_1280_720_50";
+      config.filepath = ResourcePath(config.filename, "yuv");
+      config.num_frames = kNumFramesShort;
+      config.use_single_core = use_single_core;
+      config.SetCodecSettings(cricket::kVp9CodecName, 1, num_spatial_layers, 3,
+                              true, true, false, 1280, 720);
+      auto fixture = CreateVideoCodecTestFixture(config);
+
+      std::vector<RateProfile> rate_profiles = {{1500, 30, 0}};
+      fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+
+      // The layers of a superframe are delivered after it has been encoded as
+      // a whole, so the encode time of its top layer is that of the superframe.
+      std::map<size_t, size_t> superframe_encode_time_us;
+      for (const auto& frame_stat : fixture->GetStats().GetFrameStatistics()) {
+        if (!frame_stat.encoding_successful)
+          continue;
+        size_t& encode_time_us =
+            superframe_encode_time_us[frame_stat.frame_number];
+        encode_time_us = std::max(encode_time_us, frame_stat.encode_time_us);
+      }
+      ASSERT_FALSE(superframe_encode_time_us.empty());
+      double avg_encode_ms = 0.0;
+      for (const auto& encode_time : superframe_encode_time_us)
+        avg_encode_ms += encode_time.second / 1000.0;
+      avg_encode_ms /= superframe_encode_time_us.size();
+
+      const VideoCodec& codec = config.codec_settings;
+      const int added_layer_width =
+          num_spatial_layers > 1 ? codec.spatialLayers[0].width : codec.width;
+      const int added_layer_height =
+          num_spatial_layers > 1 ? codec.spatialLayers[0].height : codec.height;
+      printf("%11s %18zu %6dx%-6d %16.2f %20.2f\n",
+             use_single_core ? "false" : "true", num_spatial_layers,
+             added_layer_width, added_layer_height,
+             avg_encode_ms - prev_avg_encode_ms, avg_encode_ms);
+      prev_avg_encode_ms = avg_encode_ms;
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -27,6 +27,8 @@
 #include "api/video/video_timing.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "api/video_codecs/vp8_temporal_layers_factory.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/codecs/interface/common_constants.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_error_codes.h"
@@ -53,6 +55,11 @@ const char kVP8IosMaxNumberOfThreadFieldTrialParameter[] = "max_thread";
 const char kVp8ForcePartitionResilience[] =
     "WebRTC-VP8-ForcePartitionResilience";
 
+// Lets the lower simulcast streams use more than one thread, instead of
+// relying on the highest stream's threads alone.
+const char kVp8MultithreadedLowerStreams[] =
+    "WebRTC-VP8-MultithreadedLowerStreams";
+
 // QP is obtained from VP8-bitstream for HW, so the QP corresponds to the
 // bitstream range of [0, 127] and not the user-level range of [0,63].
 constexpr int kLowVp8QpThreshold = 29;
@@ -287,6 +294,8 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(
       qp_max_(56),  // Setting for max quantizer.
       cpu_speed_default_(-6),
       number_of_cores_(0),
+      initial_width_(0),
+      initial_height_(0),
       rc_max_intra_target_(0),
       frame_buffer_controller_factory_(
           std::move(frame_buffer_controller_factory)),
@@ -478,6 +487,9 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   if (inst->VP8().automaticResizeOn && inst->numberOfSimulcastStreams > 1) {
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
+  if (ChangeResolutionInPlace(*inst, settings)) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
   int retVal = Release();
   if (retVal < 0) {
     return retVal;
@@ -503,6 +515,8 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   number_of_cores_ = settings.number_of_cores;
   timestamp_ = 0;
   codec_ = *inst;
+  initial_width_ = inst->width;
+  initial_height_ = inst->height;
 
   // Code expects simulcastStream resolutions to be correct, make sure they are
   // filled even when there are no simulcast layers.
@@ -670,8 +684,15 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     vpx_configs_[i].g_w = inst->simulcastStream[stream_idx].width;
     vpx_configs_[i].g_h = inst->simulcastStream[stream_idx].height;
 
-    // Use 1 thread for lower resolutions.
-    vpx_configs_[i].g_threads = 1;
+    // Use 1 thread for lower resolutions, unless enabled by field trial. The
+    // multi-resolution encoder encodes the streams one after the other, since
+    // each one reuses the mode decisions of the stream above it, so threads
+    // within a stream are the only parallelism available.
+    vpx_configs_[i].g_threads =
+        field_trial::IsEnabled(kVp8MultithreadedLowerStreams)
+            ? NumberOfThreads(vpx_configs_[i].g_w, vpx_configs_[i].g_h,
+                              settings.number_of_cores)
+            : 1;
 
     vpx_configs_[i].rc_dropframe_thresh = FrameDropThreshold(stream_idx);
 
@@ -698,6 +719,57 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   return InitAndSetControlSettings();
 }
 
+bool LibvpxVp8Encoder::ChangeResolutionInPlace(
+    const VideoCodec& inst,
+    const VideoEncoder::Settings& settings) {
+  if (!inited_ || encoders_.size() != 1 ||
+      SimulcastUtility::NumberOfSimulcastStreams(inst) != 1 ||
+      settings.number_of_cores != number_of_cores_) {
+    return false;
+  }
+  if (inst.width == codec_.width && inst.height == codec_.height) {
+    return false;
+  }
+  if (inst.width > initial_width_ || inst.height > initial_height_) {
+    return false;
+  }
+  // Anything else that is configured at initialization must be unchanged.
+  if (inst.codecType != codec_.codecType || inst.mode != codec_.mode ||
+      inst.numberOfSimulcastStreams != codec_.numberOfSimulcastStreams ||
+      inst.qpMax != codec_.qpMax || inst.maxFramerate != codec_.maxFramerate ||
+      inst.VP8() != codec_.VP8() ||
+      inst.simulcastStream[0].numberOfTemporalLayers !=
+          codec_.simulcastStream[0].numberOfTemporalLayers ||
+      inst.simulcastStream[0].qpMax != codec_.simulcastStream[0].qpMax ||
+      inst.simulcastStream[0].active != codec_.simulcastStream[0].active) {
+    return false;
+  }
+
+  // Without lagged frames and in one pass mode, which is always the case here,
+  // libvpx reallocates its frame buffers for the new resolution and starts
+  // over with a key frame. If it rejects the configuration, the state is left
+  // as is and the encoder is reinitialized from scratch.
+  vpx_codec_enc_cfg_t config = vpx_configs_[0];
+  config.g_w = inst.width;
+  config.g_h = inst.height;
+  if (libvpx_->codec_enc_config_set(&encoders_[0], &config)) {
+    return false;
+  }
+  vpx_configs_[0] = config;
+  codec_.width = inst.width;
+  codec_.height = inst.height;
+  codec_.simulcastStream[0].width = inst.width;
+  codec_.simulcastStream[0].height = inst.height;
+  libvpx_->img_wrap(&raw_images_[0], VPX_IMG_FMT_I420, inst.width, inst.height,
+                    1, NULL);
+  cpu_speed_[0] = GetCpuSpeed(inst.width, inst.height);
+  libvpx_->codec_control(&encoders_[0], VP8E_SET_CPUUSED, cpu_speed_[0]);
+  key_frame_request_[0] = true;
+  RTC_LOG(LS_INFO) << "Changed resolution in place to " << inst.width << "x"
+                   << inst.height;
+  return true;
+}
+
 int LibvpxVp8Encoder::GetCpuSpeed(int width, int height) {
 #if defined(WEBRTC_ARCH_ARM) || defined(WEBRTC_ARCH_ARM64) || \
     defined(WEBRTC_ANDROID)
@@ -986,8 +1058,11 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     flags[i] = send_key_frame ? VPX_EFLAG_FORCE_KF : EncodeFlags(tl_configs[i]);
   }
 
+  // NV12 input is converted into a pooled buffer, to not allocate per frame.
   rtc::scoped_refptr<I420BufferInterface> input_image =
-      frame.video_frame_buffer()->ToI420();
+      ConvertToI420(frame.video_frame_buffer(), I420BufferPool::Shared());
+  if (!input_image)
+    return WEBRTC_VIDEO_CODEC_ERROR;
   // Since we are extracting raw pointers from |input_image| to
   // |raw_images_[0]|, the resolution of these frames must match.
   RTC_DCHECK_EQ(input_image->width(), raw_images_[0].d_w);
@@ -1131,9 +1206,7 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
     CodecSpecificInfo codec_specific;
     const vpx_codec_cx_pkt_t* pkt = NULL;
 
-    // TODO(nisse): Introduce some buffer cache or buffer pool, to reduce
-    // allocations and/or copy operations.
-    auto buffer = EncodedImageBuffer::Create();
+    auto buffer = encoded_buffer_pool_.CreateBuffer(0);
 
     while ((pkt = libvpx_->codec_get_cx_data(&encoders_[encoder_idx], &iter)) !=
            NULL) {
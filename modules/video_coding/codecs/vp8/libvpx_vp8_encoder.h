@@ -23,6 +23,7 @@
 #include "api/video_codecs/vp8_frame_config.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/libvpx_interface.h"
+#include "modules/video_coding/encoded_image_buffer_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/framerate_controller.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
@@ -78,6 +79,12 @@ class LibvpxVp8Encoder : public VideoEncoder {
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings();
 
+  // Applies |inst| to the initialized encoder without recreating it, if it
+  // only changes the resolution of a single stream encoder. Returns false if
+  // the encoder needs to be reinitialized instead.
+  bool ChangeResolutionInPlace(const VideoCodec& inst,
+                               const VideoEncoder::Settings& settings);
+
   void PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                              const vpx_codec_cx_pkt& pkt,
                              int stream_idx,
@@ -112,6 +119,10 @@ class LibvpxVp8Encoder : public VideoEncoder {
   int qp_max_;
   int cpu_speed_default_;
   int number_of_cores_;
+  // Resolution that the libvpx encoder was initialized with. libvpx can switch
+  // to a different resolution in place, but not to a larger one.
+  int initial_width_;
+  int initial_height_;
   uint32_t rc_max_intra_target_;
   const std::unique_ptr<Vp8FrameBufferControllerFactory>
       frame_buffer_controller_factory_;
@@ -121,6 +132,9 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<int> cpu_speed_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
+  // Recycles the bitstream buffers of |encoded_images_| once the packetizer
+  // and any other user of a frame has released it.
+  video_coding::EncodedImageBufferPool encoded_buffer_pool_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> vpx_configs_;
   std::vector<Vp8EncoderConfig> config_overrides_;
@@ -249,6 +249,60 @@ TEST_F(TestVp8Impl, DynamicSetRates) {
   encoder.SetRates(rate_settings);
 }
 
+TEST_F(TestVp8Impl, ChangesResolutionInPlace) {
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+
+  // Scaling down and back up to the initial resolution keeps the encoder.
+  const unsigned int kScaledWidth = kWidth / 2;
+  const unsigned int kScaledHeight = kHeight / 2;
+  EXPECT_CALL(*vpx, codec_destroy(_)).Times(0);
+  EXPECT_CALL(*vpx, codec_enc_init(_, _, _, _)).Times(0);
+  EXPECT_CALL(*vpx, codec_enc_config_set(
+                        _, AllOf(Field(&vpx_codec_enc_cfg_t::g_w, kScaledWidth),
+                                 Field(&vpx_codec_enc_cfg_t::g_h,
+                                       kScaledHeight))))
+      .WillOnce(Return(VPX_CODEC_OK));
+  EXPECT_CALL(*vpx, codec_enc_config_set(
+                        _, AllOf(Field(&vpx_codec_enc_cfg_t::g_w,
+                                       static_cast<unsigned int>(kWidth)),
+                                 Field(&vpx_codec_enc_cfg_t::g_h,
+                                       static_cast<unsigned int>(kHeight)))))
+      .WillOnce(Return(VPX_CODEC_OK));
+  VideoCodec codec_settings = codec_settings_;
+  codec_settings.width = kScaledWidth;
+  codec_settings.height = kScaledHeight;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings, kSettings));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  ::testing::Mock::VerifyAndClearExpectations(vpx);
+}
+
+TEST_F(TestVp8Impl, ReinitializesWhenResolutionExceedsInitialResolution) {
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+
+  EXPECT_CALL(*vpx, codec_destroy(_));
+  EXPECT_CALL(*vpx, codec_enc_init(
+                        _, _,
+                        AllOf(Field(&vpx_codec_enc_cfg_t::g_w,
+                                    static_cast<unsigned int>(kWidth * 2)),
+                              Field(&vpx_codec_enc_cfg_t::g_h,
+                                    static_cast<unsigned int>(kHeight * 2))),
+                        _));
+  VideoCodec codec_settings = codec_settings_;
+  codec_settings.width = kWidth * 2;
+  codec_settings.height = kHeight * 2;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings, kSettings));
+  ::testing::Mock::VerifyAndClearExpectations(vpx);
+}
+
 TEST_F(TestVp8Impl, EncodeFrameAndRelease) {
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
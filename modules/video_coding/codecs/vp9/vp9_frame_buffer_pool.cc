@@ -30,7 +30,14 @@ size_t Vp9FrameBufferPool::Vp9FrameBuffer::GetDataSize() const {
   return data_.size();
 }
 
+size_t Vp9FrameBufferPool::Vp9FrameBuffer::GetCapacity() const {
+  return data_.capacity();
+}
+
 void Vp9FrameBufferPool::Vp9FrameBuffer::SetSize(size_t size) {
+  // The old contents are not needed, so don't copy them when growing.
+  if (size > data_.capacity())
+    data_.Clear();
   data_.SetSize(size);
 }
 
@@ -60,10 +67,39 @@ Vp9FrameBufferPool::GetFrameBuffer(size_t min_size) {
   {
     rtc::CritScope cs(&buffers_lock_);
     // Do we have a buffer we can recycle?
+    size_t num_available_buffers = 0;
     for (const auto& buffer : allocated_buffers_) {
-      if (buffer->HasOneRef()) {
+      if (!buffer->HasOneRef())
+        continue;
+      ++num_available_buffers;
+      if (available_buffer == nullptr) {
+        available_buffer = buffer;
+        continue;
+      }
+      // One that is big enough beats one that is not. Among those that are big
+      // enough the smallest wins, and among the others the biggest.
+      const size_t capacity = buffer->GetCapacity();
+      const size_t best_capacity = available_buffer->GetCapacity();
+      const bool fits = capacity >= min_size;
+      const bool best_fits = best_capacity >= min_size;
+      if (fits != best_fits ? fits
+                            : (fits ? capacity < best_capacity
+                                    : capacity > best_capacity)) {
         available_buffer = buffer;
-        break;
+      }
+    }
+    // Delete buffers that have been idle since a burst of buffers in use, e.g.
+    // frames held by a renderer that fell behind.
+    if (num_available_buffers > kMaxNumIdleBuffers + 1) {
+      size_t num_to_delete = num_available_buffers - kMaxNumIdleBuffers - 1;
+      for (auto it = allocated_buffers_.begin();
+           num_to_delete > 0 && it != allocated_buffers_.end();) {
+        if (*it != available_buffer && (*it)->HasOneRef()) {
+          it = allocated_buffers_.erase(it);
+          --num_to_delete;
+        } else {
+          ++it;
+        }
       }
     }
     // Otherwise create one.
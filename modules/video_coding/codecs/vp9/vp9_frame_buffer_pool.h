@@ -58,6 +58,8 @@ class Vp9FrameBufferPool {
    public:
     uint8_t* GetData();
     size_t GetDataSize() const;
+    size_t GetCapacity() const;
+    // Resizes the buffer. The data is not preserved if the buffer grows.
     void SetSize(size_t size);
 
     virtual bool HasOneRef() const = 0;
@@ -73,7 +75,8 @@ class Vp9FrameBufferPool {
 
   // Gets a frame buffer of at least |min_size|, recycling an available one or
   // creating a new one. When no longer referenced from the outside the buffer
-  // becomes recyclable.
+  // becomes recyclable. Available buffers beyond |kMaxNumIdleBuffers| are
+  // deleted.
   rtc::scoped_refptr<Vp9FrameBuffer> GetFrameBuffer(size_t min_size);
   // Gets the number of buffers currently in use (not ready to be recycled).
   int GetNumBuffersInUse() const;
@@ -118,6 +121,10 @@ class Vp9FrameBufferPool {
   // then the application has ~1 second to e.g. render each frame of a 60 fps
   // video.
   static const size_t max_num_buffers_ = 68;
+  // Buffers kept for recycling when not in use. Decoding a frame needs at
+  // most one new buffer, keeping a few more absorbs jitter in when frames are
+  // released.
+  static constexpr size_t kMaxNumIdleBuffers = 4;
 };
 
 }  // namespace webrtc
@@ -635,7 +635,12 @@ int VP9EncoderImpl::NumberOfThreads(int width,
                                     int number_of_cores) {
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+  // Since row-based multithreading is on, the threads are kept busy even when
+  // the encoder caps the number of tile columns below the number of threads,
+  // as it does for widths below 2048.
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
   } else if (width * height >= 640 * 360 && number_of_cores > 2) {
     return 2;
@@ -794,9 +799,17 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
-
-  // Turn on row-based multithreading.
+  int log2_tile_columns = 0;
+  while ((2u << log2_tile_columns) <= config_->g_threads)
+    ++log2_tile_columns;
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, log2_tile_columns);
+
+  // Turn on row-based multithreading. The rows of each tile are then encoded
+  // in parallel, which matters for the lower spatial layers, where the tile
+  // columns of the top layer resolution don't fit. The spatial layers of a
+  // superframe are still encoded one after the other, since libvpx encodes
+  // them in a single vpx_codec_encode() call, each layer predicting from the
+  // one below.
   vpx_codec_control(encoder_, VP9E_SET_ROW_MT, 1);
 
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
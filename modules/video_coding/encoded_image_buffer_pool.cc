@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/encoded_image_buffer_pool.h"
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace video_coding {
+
+constexpr size_t EncodedImageBufferPool::kDefaultMaxFreeBuffers;
+
+// Shared between the pool and every buffer it hands out, so that buffers may
+// outlive the pool.
+class EncodedImageBufferPool::FreeList : public rtc::RefCountInterface {
+ public:
+  explicit FreeList(size_t max_size) : max_size_(max_size) {}
+
+  // Takes ownership of |buffer| if there is room and the pool is still
+  // alive. Returns false if the caller should delete it instead.
+  bool Push(PooledBuffer* buffer) {
+    rtc::CritScope cs(&crit_);
+    if (closed_ || buffers_.size() >= max_size_)
+      return false;
+    buffers_.push_back(buffer);
+    return true;
+  }
+
+  PooledBuffer* Pop() {
+    rtc::CritScope cs(&crit_);
+    if (buffers_.empty())
+      return nullptr;
+    PooledBuffer* buffer = buffers_.back();
+    buffers_.pop_back();
+    return buffer;
+  }
+
+  size_t size() const {
+    rtc::CritScope cs(&crit_);
+    return buffers_.size();
+  }
+
+  // Stops accepting buffers and deletes the ones waiting for reuse.
+  void Close();
+
+ private:
+  const size_t max_size_;
+  rtc::CriticalSection crit_;
+  bool closed_ RTC_GUARDED_BY(crit_) = false;
+  std::vector<PooledBuffer*> buffers_ RTC_GUARDED_BY(crit_);
+};
+
+class EncodedImageBufferPool::PooledBuffer
+    : public rtc::RefCountedObject<EncodedImageBuffer> {
+ public:
+  PooledBuffer(size_t size, rtc::scoped_refptr<FreeList> free_list)
+      : rtc::RefCountedObject<EncodedImageBuffer>(size),
+        capacity_(size),
+        free_list_(std::move(free_list)) {}
+
+  // Keeps the content, like EncodedImageBuffer::Realloc(), but only grows
+  // the storage if needed.
+  void Realloc(size_t size) override {
+    if (size > capacity_) {
+      rtc::RefCountedObject<EncodedImageBuffer>::Realloc(size);
+      capacity_ = size;
+    } else {
+      size_ = size;
+    }
+  }
+
+  rtc::RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+      PooledBuffer* self = const_cast<PooledBuffer*>(this);
+      if (!free_list_->Push(self))
+        delete self;
+    }
+    return status;
+  }
+
+ private:
+  friend class FreeList;
+  ~PooledBuffer() override = default;
+
+  size_t capacity_;
+  const rtc::scoped_refptr<FreeList> free_list_;
+};
+
+void EncodedImageBufferPool::FreeList::Close() {
+  std::vector<PooledBuffer*> buffers;
+  {
+    rtc::CritScope cs(&crit_);
+    closed_ = true;
+    buffers.swap(buffers_);
+  }
+  for (PooledBuffer* buffer : buffers)
+    delete buffer;
+}
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxFreeBuffers) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_free_buffers)
+    : free_list_(new rtc::RefCountedObject<FreeList>(max_free_buffers)) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() {
+  free_list_->Close();
+}
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::CreateBuffer(
+    size_t size) {
+  PooledBuffer* buffer = free_list_->Pop();
+  if (!buffer)
+    return new PooledBuffer(size, free_list_);
+  buffer->Realloc(size);
+  return buffer;
+}
+
+size_t EncodedImageBufferPool::free_buffers() const {
+  return free_list_->size();
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
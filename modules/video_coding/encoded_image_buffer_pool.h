@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_ENCODED_IMAGE_BUFFER_POOL_H_
+#define MODULES_VIDEO_CODING_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// Pool of bitstream buffers, for frames assembled on the receive side and for
+// the output of encoders. When the last reference to a buffer created by the
+// pool is released, on any thread, the buffer is kept for reuse instead of
+// being freed, so that a steady stream of frames of similar size doesn't
+// touch the allocator.
+// The pool itself should be used from a single thread (or under a lock).
+// Buffers released after the pool has been destroyed are simply deleted.
+class EncodedImageBufferPool {
+ public:
+  static constexpr size_t kDefaultMaxFreeBuffers = 16;
+
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_free_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of |size| bytes with undefined content. Recycled buffers
+  // are only reallocated if they are smaller than |size|, and Realloc() on
+  // the returned buffer likewise only reallocates when growing beyond the
+  // largest size it has had.
+  rtc::scoped_refptr<EncodedImageBuffer> CreateBuffer(size_t size);
+
+  // Number of buffers currently waiting for reuse.
+  size_t free_buffers() const;
+
+ private:
+  class FreeList;
+  class PooledBuffer;
+
+  const rtc::scoped_refptr<FreeList> free_list_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/encoded_image_buffer_pool.h"
+
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+
+TEST(EncodedImageBufferPoolTest, CreatesBufferOfRequestedSize) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(100);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(100u, buffer->size());
+  EXPECT_NE(nullptr, buffer->data());
+}
+
+TEST(EncodedImageBufferPoolTest, RecyclesBuffers) {
+  EncodedImageBufferPool pool;
+  const uint8_t* storage;
+  {
+    rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(100);
+    storage = buffer->data();
+    EXPECT_EQ(0u, pool.free_buffers());
+  }
+  EXPECT_EQ(1u, pool.free_buffers());
+
+  // A smaller buffer reuses the storage as is.
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(50);
+  EXPECT_EQ(storage, buffer->data());
+  EXPECT_EQ(50u, buffer->size());
+  EXPECT_EQ(0u, pool.free_buffers());
+}
+
+TEST(EncodedImageBufferPoolTest, GrowsRecycledBuffer) {
+  EncodedImageBufferPool pool;
+  pool.CreateBuffer(10);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(1000u, buffer->size());
+  buffer->data()[999] = 0xff;
+}
+
+TEST(EncodedImageBufferPoolTest, ReallocKeepsStorageWithinCapacity) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(100);
+  uint8_t* storage = buffer->data();
+  buffer->data()[9] = 0x17;
+  buffer->Realloc(10);
+  buffer->Realloc(100);
+  EXPECT_EQ(storage, buffer->data());
+  EXPECT_EQ(100u, buffer->size());
+  EXPECT_EQ(0x17, buffer->data()[9]);
+
+  buffer->Realloc(200);
+  EXPECT_EQ(200u, buffer->size());
+  EXPECT_EQ(0x17, buffer->data()[9]);
+}
+
+TEST(EncodedImageBufferPoolTest, ReturnsBufferWhenLastReferenceIsDropped) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(10);
+  rtc::scoped_refptr<EncodedImageBuffer> copy = buffer;
+  buffer = nullptr;
+  EXPECT_EQ(0u, pool.free_buffers());
+  copy = nullptr;
+  EXPECT_EQ(1u, pool.free_buffers());
+}
+
+TEST(EncodedImageBufferPoolTest, LimitsNumberOfFreeBuffers) {
+  EncodedImageBufferPool pool(/*max_free_buffers=*/2);
+  {
+    rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.CreateBuffer(1);
+    rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.CreateBuffer(1);
+    rtc::scoped_refptr<EncodedImageBuffer> buffer3 = pool.CreateBuffer(1);
+  }
+  EXPECT_EQ(2u, pool.free_buffers());
+}
+
+TEST(EncodedImageBufferPoolTest, BufferMayOutlivePool) {
+  auto pool = std::make_unique<EncodedImageBufferPool>();
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool->CreateBuffer(10);
+  pool.reset();
+  buffer->data()[9] = 0xff;
+  EXPECT_EQ(10u, buffer->size());
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -27,9 +27,11 @@
 #include "rtc_base/experiments/rtt_mult_experiment.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace video_coding {
@@ -161,18 +163,21 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
 }
 
 int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
+  const int64_t start_time_us = rtc::TimeMicros();
   int64_t wait_ms = latest_return_time_ms_ - now_ms;
   frames_to_decode_.clear();
 
+  // Only the decodable frames can start a superframe, so the frames waiting
+  // for references are never visited.
   // |last_continuous_frame_| may be empty below, but nullopt is smaller
   // than everything else and loop will immediately terminate as expected.
-  for (auto frame_it = frames_.begin();
-       frame_it != frames_.end() && frame_it->first <= last_continuous_frame_;
-       ++frame_it) {
-    if (!frame_it->second.continuous ||
-        frame_it->second.num_missing_decodable > 0) {
-      continue;
-    }
+  for (auto id_it = decodable_frames_.begin();
+       id_it != decodable_frames_.end() && *id_it <= last_continuous_frame_;
+       ++id_it) {
+    FrameMap::iterator frame_it = frames_.find(*id_it);
+    RTC_DCHECK(frame_it != frames_.end());
+    RTC_DCHECK(frame_it->second.continuous);
+    RTC_DCHECK_EQ(frame_it->second.num_missing_decodable, 0);
 
     EncodedFrame* frame = frame_it->second.frame.get();
 
@@ -251,6 +256,8 @@ int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
   }
   wait_ms = std::min<int64_t>(wait_ms, latest_return_time_ms_ - now_ms);
   wait_ms = std::max<int64_t>(wait_ms, 0);
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.FrameBuffer.FindNextFrameTimeUs",
+                             rtc::TimeMicros() - start_time_us);
   return wait_ms;
 }
 
@@ -297,6 +304,8 @@ EncodedFrame* FrameBuffer::GetNextFrame() {
       }
     }
 
+    decodable_frames_.erase(decodable_frames_.begin(),
+                            decodable_frames_.upper_bound(frame_it->first));
     frames_.erase(frames_.begin(), ++frame_it);
 
     frames_out.push_back(frame);
@@ -460,6 +469,15 @@ bool FrameBuffer::IsCompleteSuperFrame(const EncodedFrame& frame) {
 
 int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
   TRACE_EVENT0("webrtc", "FrameBuffer::InsertFrame");
+  const int64_t start_time_us = rtc::TimeMicros();
+  const int64_t last_continuous_picture_id =
+      InsertFrameInternal(std::move(frame));
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.FrameBuffer.InsertFrameTimeUs",
+                             rtc::TimeMicros() - start_time_us);
+  return last_continuous_picture_id;
+}
+
+int64_t FrameBuffer::InsertFrameInternal(std::unique_ptr<EncodedFrame> frame) {
   RTC_DCHECK(frame);
 
   rtc::CritScope lock(&crit_);
@@ -594,6 +612,8 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
     if (!last_continuous_frame_ || *last_continuous_frame_ < frame->first) {
       last_continuous_frame_ = frame->first;
     }
+    if (frame->second.num_missing_decodable == 0)
+      decodable_frames_.insert(frame->first);
 
     // Loop through all dependent frames, and if that frame no longer has
     // any unfulfilled dependencies then that frame is continuous as well.
@@ -622,6 +642,10 @@ void FrameBuffer::PropagateDecodability(const FrameInfo& info) {
     if (ref_info != frames_.end()) {
       RTC_DCHECK_GT(ref_info->second.num_missing_decodable, 0U);
       --ref_info->second.num_missing_decodable;
+      if (ref_info->second.num_missing_decodable == 0 &&
+          ref_info->second.continuous) {
+        decodable_frames_.insert(ref_info->first);
+      }
     }
   }
 }
@@ -745,6 +769,7 @@ void FrameBuffer::ClearFramesAndHistory() {
     }
   }
   frames_.clear();
+  decodable_frames_.clear();
   last_continuous_frame_.reset();
   frames_to_decode_.clear();
   decoded_frames_history_.Clear();
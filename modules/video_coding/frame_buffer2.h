@@ -14,6 +14,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -122,6 +123,8 @@ class FrameBuffer {
 
   using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
 
+  int64_t InsertFrameInternal(std::unique_ptr<EncodedFrame> frame);
+
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
 
@@ -169,6 +172,10 @@ class FrameBuffer {
 
   // Stores only undecoded frames.
   FrameMap frames_ RTC_GUARDED_BY(crit_);
+  // The continuous frames in |frames_| whose references have all been decoded.
+  // Kept up to date as frames become continuous and decodable, so that
+  // FindNextFrame() doesn't have to scan all of |frames_|.
+  std::set<VideoLayerFrameId> decodable_frames_ RTC_GUARDED_BY(crit_);
   DecodedFramesHistory decoded_frames_history_ RTC_GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
@@ -23,6 +23,7 @@
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -361,6 +362,27 @@ TEST_F(TestFrameBuffer2, ExtractFromEmptyBuffer) {
   CheckNoFrame(0);
 }
 
+TEST_F(TestFrameBuffer2, LongChainOfContinuousFrames) {
+  constexpr int kNumFrames = 100;
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  // All frames are continuous, but each only becomes decodable once the frame
+  // before it has been decoded.
+  InsertFrame(pid, 0, ts, false, true, kFrameSize);
+  for (int i = 1; i < kNumFrames; ++i) {
+    InsertFrame(pid + i, 0, ts + i * kFps10, false, true, kFrameSize,
+                pid + i - 1);
+  }
+  for (int i = 0; i < kNumFrames; ++i) {
+    ExtractFrame();
+    clock_.AdvanceTimeMilliseconds(kFps10);
+    CheckFrame(i, pid + i, 0);
+  }
+  ExtractFrame();
+  CheckNoFrame(kNumFrames);
+}
+
 TEST_F(TestFrameBuffer2, MissingFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -705,6 +727,22 @@ TEST_F(TestFrameBuffer2, CombineFramesToSuperframe) {
   EXPECT_EQ(frames_[0]->SpatialLayerFrameSize(1), 2 * kFrameSize);
 }
 
+TEST_F(TestFrameBuffer2, TimeSpentIsRecorded) {
+  metrics::Reset();
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid, 0, ts, false, true, kFrameSize);
+  InsertFrame(pid + 1, 0, ts + kFps10, false, true, kFrameSize, pid);
+  ExtractFrame();
+  CheckFrame(0, pid, 0);
+
+  EXPECT_EQ(2,
+            metrics::NumSamples("WebRTC.Video.FrameBuffer.InsertFrameTimeUs"));
+  EXPECT_EQ(
+      1, metrics::NumSamples("WebRTC.Video.FrameBuffer.FindNextFrameTimeUs"));
+}
+
 TEST_F(TestFrameBuffer2, HigherSpatialLayerNonDecodable) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -30,6 +30,16 @@ namespace video_coding {
 
 namespace {
 const uint8_t start_code_h265[] = {0, 0, 0, 1};
+
+void SetAnnexBData(const std::vector<uint8_t>& nalu, rtc::Buffer* buffer) {
+  buffer->SetData(start_code_h265);
+  buffer->AppendData(nalu.data(), nalu.size());
+}
+
+uint8_t* InsertData(const rtc::Buffer& data, uint8_t* insert_at) {
+  memcpy(insert_at, data.data(), data.size());
+  return insert_at + data.size();
+}
 }  // namespace
 
 H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
@@ -51,13 +61,14 @@ H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
     const H265NaluInfo& nalu = h265_header.nalus[i];
     switch (nalu.type) {
       case H265::NaluType::kVps: {
-        vps_data_[nalu.vps_id].size = 0;
+        vps_data_[nalu.vps_id].annexb_data.Clear();
         break;
       }
       case H265::NaluType::kSps: {
-        sps_data_[nalu.sps_id].vps_id = nalu.vps_id;
-        sps_data_[nalu.sps_id].width = packet->width();
-        sps_data_[nalu.sps_id].height = packet->height();
+        SpsInfo& sps_info = sps_data_[nalu.sps_id];
+        sps_info.vps_id = nalu.vps_id;
+        sps_info.width = packet->width();
+        sps_info.height = packet->height();
         break;
       }
       case H265::NaluType::kPps: {
@@ -104,12 +115,11 @@ H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
           packet->video_header.height = sps->second.height;
 
           // If the VPS/SPS/PPS was supplied out of band then we will have saved
-          // the actual bitstream in |data|.
+          // the actual bitstream in |annexb_data|.
           // This branch is not verified.
-          if (vps->second.data && sps->second.data && pps->second.data) {
-            RTC_DCHECK_GT(vps->second.size, 0);
-            RTC_DCHECK_GT(sps->second.size, 0);
-            RTC_DCHECK_GT(pps->second.size, 0);
+          if (!vps->second.annexb_data.empty() &&
+              !sps->second.annexb_data.empty() &&
+              !pps->second.annexb_data.empty()) {
             append_vps_sps_pps = true;
           }
         }
@@ -121,15 +131,16 @@ H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
   }
 
   RTC_CHECK(!append_vps_sps_pps ||
-            (sps != sps_data_.end() && pps != pps_data_.end()));
+            (vps != vps_data_.end() && sps != sps_data_.end() &&
+             pps != pps_data_.end()));
 
   // Calculate how much space we need for the rest of the bitstream.
   size_t required_size = 0;
 
   if (append_vps_sps_pps) {
-    required_size += vps->second.size + sizeof(start_code_h265);
-    required_size += sps->second.size + sizeof(start_code_h265);
-    required_size += pps->second.size + sizeof(start_code_h265);
+    required_size += vps->second.annexb_data.size();
+    required_size += sps->second.annexb_data.size();
+    required_size += pps->second.annexb_data.size();
   }
 
   if (h265_header.packetization_type == kH265AP) {
@@ -156,23 +167,9 @@ H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
   uint8_t* insert_at = buffer;
 
   if (append_vps_sps_pps) {
-    // Insert VPS.
-    memcpy(insert_at, start_code_h265, sizeof(start_code_h265));
-    insert_at += sizeof(start_code_h265);
-    memcpy(insert_at, vps->second.data.get(), vps->second.size);
-    insert_at += vps->second.size;
-
-    // Insert SPS.
-    memcpy(insert_at, start_code_h265, sizeof(start_code_h265));
-    insert_at += sizeof(start_code_h265);
-    memcpy(insert_at, sps->second.data.get(), sps->second.size);
-    insert_at += sps->second.size;
-
-    // Insert PPS.
-    memcpy(insert_at, start_code_h265, sizeof(start_code_h265));
-    insert_at += sizeof(start_code_h265);
-    memcpy(insert_at, pps->second.data.get(), pps->second.size);
-    insert_at += pps->second.size;
+    insert_at = InsertData(vps->second.annexb_data, insert_at);
+    insert_at = InsertData(sps->second.annexb_data, insert_at);
+    insert_at = InsertData(pps->second.annexb_data, insert_at);
 
     // Update codec header to reflect the newly added SPS and PPS.
     H265NaluInfo vps_info;
@@ -190,7 +187,7 @@ H265VpsSpsPpsTracker::PacketAction H265VpsSpsPpsTracker::CopyAndFixBitstream(
     pps_info.vps_id = vps->first;
     pps_info.sps_id = sps->first;
     pps_info.pps_id = pps->first;
-    if (h265_header.nalus_length + 2 <= kMaxNalusPerPacket) {
+    if (h265_header.nalus_length + 3 <= kMaxNalusPerPacket) {
       h265_header.nalus[h265_header.nalus_length++] = vps_info;
       h265_header.nalus[h265_header.nalus_length++] = sps_info;
       h265_header.nalus[h265_header.nalus_length++] = pps_info;
@@ -244,8 +241,8 @@ void H265VpsSpsPpsTracker::InsertVpsSpsPpsNalus(
                         << kNaluHeaderOffset;
     return;
   }
-  if ((vps[0] & 0x7e) >> 1 != H265::NaluType::kSps) {
-    RTC_LOG(LS_WARNING) << "SPS Nalu header missing";
+  if ((vps[0] & 0x7e) >> 1 != H265::NaluType::kVps) {
+    RTC_LOG(LS_WARNING) << "VPS Nalu header missing";
     return;
   }
   if (sps.size() < kNaluHeaderOffset) {
@@ -263,7 +260,7 @@ void H265VpsSpsPpsTracker::InsertVpsSpsPpsNalus(
     return;
   }
   if ((pps[0] & 0x7e) >> 1 != H265::NaluType::kPps) {
-    RTC_LOG(LS_WARNING) << "SPS Nalu header missing";
+    RTC_LOG(LS_WARNING) << "PPS Nalu header missing";
     return;
   }
   absl::optional<H265VpsParser::VpsState> parsed_vps = H265VpsParser::ParseVps(
@@ -289,30 +286,17 @@ void H265VpsSpsPpsTracker::InsertVpsSpsPpsNalus(
     return;
   }
 
-  VpsInfo vps_info;
-  vps_info.size = vps.size();
-  uint8_t* vps_data = new uint8_t[vps_info.size];
-  memcpy(vps_data, vps.data(), vps_info.size);
-  vps_info.data.reset(vps_data);
-  vps_data_[parsed_vps->id] = std::move(vps_info);
+  SetAnnexBData(vps, &vps_data_[parsed_vps->id].annexb_data);
 
-  SpsInfo sps_info;
-  sps_info.size = sps.size();
+  SpsInfo& sps_info = sps_data_[parsed_sps->id];
   sps_info.width = parsed_sps->width;
   sps_info.height = parsed_sps->height;
   sps_info.vps_id = parsed_sps->vps_id;
-  uint8_t* sps_data = new uint8_t[sps_info.size];
-  memcpy(sps_data, sps.data(), sps_info.size);
-  sps_info.data.reset(sps_data);
-  sps_data_[parsed_sps->id] = std::move(sps_info);
+  SetAnnexBData(sps, &sps_info.annexb_data);
 
-  PpsInfo pps_info;
-  pps_info.size = pps.size();
+  PpsInfo& pps_info = pps_data_[parsed_pps->id];
   pps_info.sps_id = parsed_pps->sps_id;
-  uint8_t* pps_data = new uint8_t[pps_info.size];
-  memcpy(pps_data, pps.data(), pps_info.size);
-  pps_info.data.reset(pps_data);
-  pps_data_[parsed_pps->id] = std::move(pps_info);
+  SetAnnexBData(pps, &pps_info.annexb_data);
 
   RTC_LOG(LS_INFO) << "Inserted SPS id " << parsed_sps->id << " and PPS id "
                    << parsed_pps->id << " (referencing SPS "
@@ -12,11 +12,11 @@
 #define MODULES_VIDEO_CODING_H265_VPS_SPS_PPS_TRACKER_H_
 
 #include <cstdint>
-#include <map>
-#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/include/module_common_types.h"
+#include "rtc_base/buffer.h"
 
 namespace webrtc {
 
@@ -35,28 +35,27 @@ class H265VpsSpsPpsTracker {
                             const std::vector<uint8_t>& pps);
 
  private:
+  // Parameter sets received out of band are stored with a start code in front
+  // of them, in the form they are prepended to the bitstream of a keyframe.
   struct VpsInfo {
-    size_t size = 0;
-    std::unique_ptr<uint8_t[]> data;
+    rtc::Buffer annexb_data;
   };
 
   struct PpsInfo {
     int sps_id = -1;
-    size_t size = 0;
-    std::unique_ptr<uint8_t[]> data;
+    rtc::Buffer annexb_data;
   };
 
   struct SpsInfo {
     int vps_id = -1;
-    size_t size = 0;
     int width = -1;
     int height = -1;
-    std::unique_ptr<uint8_t[]> data;
+    rtc::Buffer annexb_data;
   };
 
-  std::map<uint32_t, VpsInfo> vps_data_;
-  std::map<uint32_t, PpsInfo> pps_data_;
-  std::map<uint32_t, SpsInfo> sps_data_;
+  std::unordered_map<uint32_t, VpsInfo> vps_data_;
+  std::unordered_map<uint32_t, PpsInfo> pps_data_;
+  std::unordered_map<uint32_t, SpsInfo> sps_data_;
 };
 
 }  // namespace video_coding
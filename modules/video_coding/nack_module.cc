@@ -65,6 +65,8 @@ NackModule::NackModule(Clock* clock,
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
       newest_seq_num_(0),
+      recovered_cleared_to_(0),
+      earliest_nack_time_ms_(std::numeric_limits<int64_t>::max()),
       next_process_time_ms_(-1),
       send_nack_delay_ms_(GetSendNackDelay()) {
   RTC_DCHECK(clock_);
@@ -88,6 +90,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   if (!initialized_) {
     newest_seq_num_ = seq_num;
+    recovered_cleared_to_ = seq_num - kMaxPacketAge;
     if (is_keyframe)
       keyframe_list_.insert(seq_num);
     initialized_ = true;
@@ -121,13 +124,11 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   if (it != keyframe_list_.begin())
     keyframe_list_.erase(keyframe_list_.begin(), it);
 
-  if (is_recovered) {
-    recovered_list_.insert(seq_num);
+  // Remove old recovered packets, also when no more packets are recovered.
+  ClearRecoveredPacketsUpTo(seq_num - kMaxPacketAge);
 
-    // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+  if (is_recovered) {
+    recovered_packets_.set(seq_num);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -152,12 +153,14 @@ void NackModule::ClearUpTo(uint16_t seq_num) {
   nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
   keyframe_list_.erase(keyframe_list_.begin(),
                        keyframe_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  ClearRecoveredPacketsUpTo(seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
   rtc::CritScope lock(&crit_);
+  // With a shorter rtt packets may be due earlier than estimated.
+  if (rtt_ms < rtt_ms_)
+    earliest_nack_time_ms_ = std::numeric_limits<int64_t>::min();
   rtt_ms_ = rtt_ms;
 }
 
@@ -165,7 +168,7 @@ void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
   keyframe_list_.clear();
-  recovered_list_.clear();
+  recovered_packets_.reset();
 }
 
 int64_t NackModule::TimeUntilNextProcess() {
@@ -178,7 +181,8 @@ void NackModule::Process() {
     std::vector<uint16_t> nack_batch;
     {
       rtc::CritScope lock(&crit_);
-      nack_batch = GetNackBatch(kTimeOnly);
+      if (clock_->TimeInMilliseconds() >= earliest_nack_time_ms_)
+        nack_batch = GetNackBatch(kTimeOnly);
     }
 
     if (!nack_batch.empty()) {
@@ -244,14 +248,16 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
+  const int64_t now_ms = clock_->TimeInMilliseconds();
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_packets_.test(seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
+    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5), now_ms);
     RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
     nack_list_[seq_num] = nack_info;
+    earliest_nack_time_ms_ =
+        std::min(earliest_nack_time_ms_, now_ms + send_nack_delay_ms_);
   }
 }
 
@@ -260,6 +266,7 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
+  earliest_nack_time_ms_ = std::numeric_limits<int64_t>::max();
   auto it = nack_list_.begin();
   while (it != nack_list_.end()) {
     bool delay_timed_out =
@@ -277,16 +284,32 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
         RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
                             << " removed from NACK list due to max retries.";
         it = nack_list_.erase(it);
-      } else {
-        ++it;
+        continue;
       }
-      continue;
     }
+    earliest_nack_time_ms_ = std::min(
+        earliest_nack_time_ms_,
+        std::max(it->second.created_at_time + send_nack_delay_ms_,
+                 it->second.sent_at_time + rtt_ms_));
     ++it;
   }
   return nack_batch;
 }
 
+void NackModule::ClearRecoveredPacketsUpTo(uint16_t seq_num) {
+  if (!AheadOf(seq_num, recovered_cleared_to_))
+    return;
+  if (ForwardDiff(recovered_cleared_to_, seq_num) > kMaxPacketAge) {
+    // No packet newer than |kMaxPacketAge| after |recovered_cleared_to_| has
+    // been recovered yet, so all bits are older than |seq_num|.
+    recovered_packets_.reset();
+  } else {
+    for (uint16_t n = recovered_cleared_to_; n != seq_num; ++n)
+      recovered_packets_.reset(n);
+  }
+  recovered_cleared_to_ = seq_num;
+}
+
 void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
   RTC_DCHECK(AheadOf(newest_seq_num_, seq_num));
   uint16_t diff = ReverseDiff(newest_seq_num_, seq_num);
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <bitset>
 #include <map>
 #include <set>
 #include <vector>
@@ -73,6 +74,10 @@ class NackModule : public Module {
   std::vector<uint16_t> GetNackBatch(NackFilterOptions options)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Forgets the recovered packets older than |seq_num|.
+  void ClearRecoveredPacketsUpTo(uint16_t seq_num)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Update the reordering distribution.
   void UpdateReorderingStatistics(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -94,8 +99,15 @@ class NackModule : public Module {
       RTC_GUARDED_BY(crit_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
       RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(crit_);
+  // Packets recovered by FEC or RTX, as a bitmap indexed by sequence number.
+  // The bits older than |recovered_cleared_to_| are all cleared, which is kept
+  // close behind |newest_seq_num_| so that the bits are clear when the
+  // sequence numbers wrap around.
+  std::bitset<1 << 16> recovered_packets_ RTC_GUARDED_BY(crit_);
+  uint16_t recovered_cleared_to_ RTC_GUARDED_BY(crit_);
+  // No packet in |nack_list_| is due to be nacked again before this time, so
+  // Process() doesn't have to look through the list until then.
+  int64_t earliest_nack_time_ms_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
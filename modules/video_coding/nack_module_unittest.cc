@@ -288,6 +288,46 @@ TEST_F(TestNackModule, HandleFecRecoveredPacket) {
   EXPECT_EQ(2u, sent_nacks_.size());
 }
 
+TEST_F(TestNackModule, RecoveredPacketForgottenWhenSeqNumWraps) {
+  nack_module_.OnReceivedPacket(0, false, false);
+  nack_module_.OnReceivedPacket(1, false, true);
+  nack_module_.OnReceivedPacket(2, false, false);
+  EXPECT_EQ(0u, sent_nacks_.size());
+
+  // Go around the sequence number space, received without losses.
+  for (int seq_num = 3; seq_num <= 0xffff + 1; ++seq_num)
+    nack_module_.OnReceivedPacket(seq_num, false, false);
+  EXPECT_EQ(0u, sent_nacks_.size());
+
+  // Sequence number 1 is reused, and this time it is lost.
+  nack_module_.OnReceivedPacket(2, false, false);
+  ASSERT_EQ(1u, sent_nacks_.size());
+  EXPECT_EQ(1, sent_nacks_[0]);
+}
+
+TEST_F(TestNackModule, NoNacksResentBeforeRtt) {
+  nack_module_.UpdateRtt(100);
+  nack_module_.OnReceivedPacket(0, false, false);
+  nack_module_.OnReceivedPacket(2, false, false);
+  ASSERT_EQ(1u, sent_nacks_.size());
+
+  for (int i = 0; i < 4; ++i) {
+    clock_->AdvanceTimeMilliseconds(20);
+    nack_module_.Process();
+  }
+  EXPECT_EQ(1u, sent_nacks_.size());
+
+  clock_->AdvanceTimeMilliseconds(20);
+  nack_module_.Process();
+  EXPECT_EQ(2u, sent_nacks_.size());
+
+  // A shorter rtt makes the packet due again sooner.
+  nack_module_.UpdateRtt(10);
+  clock_->AdvanceTimeMilliseconds(10);
+  nack_module_.Process();
+  EXPECT_EQ(3u, sent_nacks_.size());
+}
+
 TEST_F(TestNackModule, SendNackWithoutDelay) {
   nack_module_.OnReceivedPacket(0, false, false);
   nack_module_.OnReceivedPacket(100, false, false);
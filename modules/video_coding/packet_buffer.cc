@@ -37,6 +37,9 @@
 namespace webrtc {
 namespace video_coding {
 
+constexpr int PacketBuffer::kMaxPaddingAge;
+constexpr size_t PacketBuffer::kMaxTimestampsHistory;
+
 PacketBuffer::PacketBuffer(Clock* clock,
                            size_t start_buffer_size,
                            size_t max_buffer_size,
@@ -52,7 +55,9 @@ PacketBuffer::PacketBuffer(Clock* clock,
       assembled_frame_callback_(assembled_frame_callback),
       unique_frames_seen_(0),
       sps_pps_idr_is_h264_keyframe_(
-          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
+          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")),
+      rtp_timestamps_history_newest_(0) {
+  rtp_timestamps_history_.reserve(kMaxTimestampsHistory);
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
@@ -171,11 +176,7 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  auto clear_to_it = missing_packets_.upper_bound(seq_num);
-  if (clear_to_it != missing_packets_.begin()) {
-    --clear_to_it;
-    missing_packets_.erase(missing_packets_.begin(), clear_to_it);
-  }
+  EraseMissingPacketsUpTo(seq_num, /*keep_newest=*/true);
 }
 
 void PacketBuffer::ClearInterval(uint16_t start_seq_num,
@@ -208,7 +209,7 @@ void PacketBuffer::Clear() {
   last_received_packet_ms_.reset();
   last_received_keyframe_packet_ms_.reset();
   newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
+  missing_packets_.reset();
 }
 
 void PacketBuffer::PaddingReceived(uint16_t seq_num) {
@@ -447,8 +448,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         const uint8_t h264tid =
             data_buffer_[start_index].video_header.frame_marking.temporal_id;
         if (h264tid == kNoTemporalIdx && !is_h264_keyframe &&
-            missing_packets_.upper_bound(start_seq_num) !=
-                missing_packets_.begin()) {
+            HasMissingPacketsUpTo(start_seq_num)) {
           uint16_t stop_index = (index + 1) % size_;
           while (start_index != stop_index) {
             sequence_buffer_[start_index].frame_created = false;
@@ -484,8 +484,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
         // If this is not a key frame, make sure there are no gaps in the
         // packet sequence numbers up until this point.
-        if (!is_h265_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
+        if (!is_h265_keyframe && HasMissingPacketsUpTo(start_seq_num)) {
           uint16_t stop_index = (index + 1) % size_;
           while (start_index != stop_index) {
             sequence_buffer_[start_index].frame_created = false;
@@ -497,8 +496,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
       }
 #endif
 
-      missing_packets_.erase(missing_packets_.begin(),
-                             missing_packets_.upper_bound(seq_num));
+      EraseMissingPacketsUpTo(seq_num, /*keep_newest=*/false);
 
       const VCMPacket* first_packet = GetPacket(start_seq_num);
       const VCMPacket* last_packet = GetPacket(seq_num);
@@ -530,7 +528,7 @@ rtc::scoped_refptr<EncodedImageBuffer> PacketBuffer::GetEncodedImageBuffer(
   size_t index = first_seq_num % size_;
   size_t end = (last_seq_num + 1) % size_;
 
-  auto buffer = EncodedImageBuffer::Create(frame_size);
+  auto buffer = buffer_pool_.CreateBuffer(frame_size);
   size_t offset = 0;
 
   do {
@@ -560,39 +558,89 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   if (!newest_inserted_seq_num_)
     newest_inserted_seq_num_ = seq_num;
 
-  const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
     if (AheadOf(old_seq_num, *newest_inserted_seq_num_))
       *newest_inserted_seq_num_ = old_seq_num;
 
-    ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
-    }
+    // Re-base the bitmap on |seq_num|, marking every packet in between the
+    // previous newest packet and |seq_num| as missing, and forget the ones
+    // that are too old.
+    size_t missing = ForwardDiff(*newest_inserted_seq_num_, seq_num) - 1;
+    missing_packets_ <<= ForwardDiff(*newest_inserted_seq_num_, seq_num);
+    for (size_t i = 0; i < missing; ++i)
+      missing_packets_.set(i);
+    for (size_t i = kMaxPaddingAge; i < missing_packets_.size(); ++i)
+      missing_packets_.reset(i);
+    newest_inserted_seq_num_ = seq_num;
   } else {
-    missing_packets_.erase(seq_num);
+    size_t bit = static_cast<uint16_t>(*newest_inserted_seq_num_ - 1 - seq_num);
+    if (bit < static_cast<size_t>(kMaxPaddingAge))
+      missing_packets_.reset(bit);
   }
 }
 
-void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
-  const size_t kMaxTimestampsHistory = 1000;
-  if (rtp_timestamps_history_set_.insert(rtp_timestamp).second) {
-    rtp_timestamps_history_queue_.push(rtp_timestamp);
-    ++unique_frames_seen_;
-    if (rtp_timestamps_history_set_.size() > kMaxTimestampsHistory) {
-      uint32_t discarded_timestamp = rtp_timestamps_history_queue_.front();
-      rtp_timestamps_history_set_.erase(discarded_timestamp);
-      rtp_timestamps_history_queue_.pop();
+uint16_t PacketBuffer::MissingSeqNum(size_t bit) const {
+  return static_cast<uint16_t>(*newest_inserted_seq_num_ - 1 - bit);
+}
+
+bool PacketBuffer::HasMissingPacketsUpTo(uint16_t seq_num) const {
+  if (missing_packets_.none())
+    return false;
+  // Only the oldest missing packet needs to be checked.
+  for (size_t bit = kMaxPaddingAge; bit-- > 0;) {
+    if (missing_packets_.test(bit))
+      return !AheadOf(MissingSeqNum(bit), seq_num);
+  }
+  return false;
+}
+
+void PacketBuffer::EraseMissingPacketsUpTo(uint16_t seq_num,
+                                           bool keep_newest) {
+  if (missing_packets_.none())
+    return;
+  // Walk from the oldest missing packet towards the newest.
+  absl::optional<size_t> previous_bit;
+  for (size_t bit = kMaxPaddingAge; bit-- > 0;) {
+    if (!missing_packets_.test(bit))
+      continue;
+    if (AheadOf(MissingSeqNum(bit), seq_num))
+      break;
+    if (!keep_newest) {
+      missing_packets_.reset(bit);
+    } else {
+      if (previous_bit)
+        missing_packets_.reset(*previous_bit);
+      previous_bit = bit;
     }
   }
 }
 
+void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
+  // Usually all packets of a frame arrive back to back.
+  if (!rtp_timestamps_history_.empty() &&
+      rtp_timestamps_history_[rtp_timestamps_history_newest_] ==
+          rtp_timestamp) {
+    return;
+  }
+  if (std::find(rtp_timestamps_history_.begin(), rtp_timestamps_history_.end(),
+                rtp_timestamp) != rtp_timestamps_history_.end()) {
+    return;
+  }
+  ++unique_frames_seen_;
+  if (rtp_timestamps_history_.size() < kMaxTimestampsHistory) {
+    rtp_timestamps_history_newest_ = rtp_timestamps_history_.size();
+    rtp_timestamps_history_.push_back(rtp_timestamp);
+  } else {
+    // Overwrite the oldest timestamp.
+    rtp_timestamps_history_newest_ =
+        (rtp_timestamps_history_newest_ + 1) % kMaxTimestampsHistory;
+    rtp_timestamps_history_[rtp_timestamps_history_newest_] = rtp_timestamp;
+  }
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -11,12 +11,12 @@
 #ifndef MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 #define MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 
+#include <bitset>
 #include <memory>
-#include <queue>
-#include <set>
 #include <vector>
 
 #include "api/video/encoded_image.h"
+#include "modules/video_coding/encoded_image_buffer_pool.h"
 #include "modules/video_coding/packet.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/numerics/sequence_number_util.h"
@@ -87,6 +87,12 @@ class PacketBuffer {
     bool frame_created = false;
   };
 
+  // Missing packets older than this, relative to the newest inserted packet,
+  // are no longer tracked.
+  static constexpr int kMaxPaddingAge = 1000;
+  // Number of unique RTP timestamps remembered by OnTimestampReceived().
+  static constexpr size_t kMaxTimestampsHistory = 1000;
+
   Clock* const clock_;
 
   // Tries to expand the buffer.
@@ -119,6 +125,19 @@ class PacketBuffer {
   void UpdateMissingPackets(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Sequence number of the missing packet represented by bit |bit| of
+  // |missing_packets_|.
+  uint16_t MissingSeqNum(size_t bit) const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Returns true if any missing packet is not newer than |seq_num|.
+  bool HasMissingPacketsUpTo(uint16_t seq_num) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Forgets the missing packets that are not newer than |seq_num|, except the
+  // newest of them if |keep_newest| is set.
+  void EraseMissingPacketsUpTo(uint16_t seq_num, bool keep_newest)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Counts unique received timestamps and updates |unique_frames_seen_|.
   void OnTimestampReceived(uint32_t rtp_timestamp)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -157,17 +176,21 @@ class PacketBuffer {
   int unique_frames_seen_ RTC_GUARDED_BY(crit_);
 
   absl::optional<uint16_t> newest_inserted_seq_num_ RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_
-      RTC_GUARDED_BY(crit_);
+  // Bit i is set if packet |*newest_inserted_seq_num_| - 1 - i is missing.
+  // Only the first |kMaxPaddingAge| bits are used.
+  std::bitset<1024> missing_packets_ RTC_GUARDED_BY(crit_);
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
   const bool sps_pps_idr_is_h264_keyframe_;
 
-  // Stores several last seen unique timestamps for quick search.
-  std::set<uint32_t> rtp_timestamps_history_set_ RTC_GUARDED_BY(crit_);
-  // Stores the same unique timestamps in the order of insertion.
-  std::queue<uint32_t> rtp_timestamps_history_queue_ RTC_GUARDED_BY(crit_);
+  // Ring of the last |kMaxTimestampsHistory| unique timestamps, the newest
+  // one at |rtp_timestamps_history_[rtp_timestamps_history_newest_]|.
+  std::vector<uint32_t> rtp_timestamps_history_ RTC_GUARDED_BY(crit_);
+  size_t rtp_timestamps_history_newest_ RTC_GUARDED_BY(crit_);
+
+  // Storage for the bitstreams of assembled frames.
+  EncodedImageBufferPool buffer_pool_ RTC_GUARDED_BY(crit_);
 };
 
 }  // namespace video_coding
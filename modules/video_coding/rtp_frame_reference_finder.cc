@@ -51,8 +51,8 @@ void RtpFrameReferenceFinder::ManageFrame(
   switch (decision) {
     case kStash:
       if (stashed_frames_.size() > kMaxStashedFrames)
-        stashed_frames_.pop_back();
-      stashed_frames_.push_front(std::move(frame));
+        stashed_frames_.pop_front();
+      stashed_frames_.push_back(std::move(frame));
       break;
     case kHandOff:
       HandOffFrame(std::move(frame));
@@ -64,26 +64,31 @@ void RtpFrameReferenceFinder::ManageFrame(
 }
 
 void RtpFrameReferenceFinder::RetryStashedFrames() {
-  bool complete_frame = false;
+  // The frames are retried oldest first, so a frame that completes can make
+  // the newer frames after it complete in the same pass. Another pass is only
+  // needed if a frame completed after a frame that stayed stashed.
+  bool retry_stashed_frames = false;
   do {
-    complete_frame = false;
+    retry_stashed_frames = false;
+    bool frame_kept = false;
     for (auto frame_it = stashed_frames_.begin();
          frame_it != stashed_frames_.end();) {
       FrameDecision decision = ManageFrameInternal(frame_it->get());
 
       switch (decision) {
         case kStash:
+          frame_kept = true;
           ++frame_it;
           break;
         case kHandOff:
-          complete_frame = true;
+          retry_stashed_frames |= frame_kept;
           HandOffFrame(std::move(*frame_it));
           RTC_FALLTHROUGH();
         case kDrop:
           frame_it = stashed_frames_.erase(frame_it);
       }
     }
-  } while (complete_frame);
+  } while (retry_stashed_frames);
 }
 
 void RtpFrameReferenceFinder::HandOffFrame(
@@ -305,11 +310,6 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
 
   int64_t unwrapped_tl0 = tl0_unwrapper_.Unwrap(codec_header.tl0PicIdx);
 
-  // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
-
   // Clean up info about not yet received frames that are too old.
   uint16_t old_picture_id =
       Subtract<kPicIdLength>(frame->id.picture_id, kMaxNotYetReceivedFrames);
@@ -319,26 +319,25 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    layer_info_.Emplace(unwrapped_tl0, LayerInfo())->fill(-1);
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
 
-  auto layer_info_it = layer_info_.find(
+  LayerInfo* layer_info = layer_info_.Find(
       codec_header.temporalIdx == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // A non keyframe base layer frame has been received, copy the layer info
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_.emplace(unwrapped_tl0, layer_info_it->second).first;
+    layer_info = layer_info_.Emplace(unwrapped_tl0, *layer_info);
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
@@ -346,7 +345,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
 
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
@@ -357,13 +356,13 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // If the last frame on this layer is ahead of this frame it means that
     // a layer sync frame has been received after this frame for the same
     // base layer frame, drop this frame.
-    if (AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[layer],
+    if (AheadOf<uint16_t, kPicIdLength>((*layer_info)[layer],
                                         frame->id.picture_id)) {
       return kDrop;
     }
@@ -371,7 +370,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
     auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
+        not_yet_received_frames_.upper_bound((*layer_info)[layer]);
     if (not_received_frame_it != not_yet_received_frames_.end() &&
         AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
                                         *not_received_frame_it)) {
@@ -379,7 +378,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
     }
 
     if (!(AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
-                                          layer_info_it->second[layer]))) {
+                                          (*layer_info)[layer]))) {
       RTC_LOG(LS_WARNING) << "Frame with picture id " << frame->id.picture_id
                           << " and packet range [" << frame->first_seq_num()
                           << ", " << frame->last_seq_num()
@@ -389,7 +388,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = (*layer_info)[layer];
   }
 
   UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
@@ -399,21 +398,21 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
 void RtpFrameReferenceFinder::UpdateLayerInfoVp8(RtpFrameObject* frame,
                                                  int64_t unwrapped_tl0,
                                                  uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  LayerInfo* layer_info = layer_info_.Find(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[temporal_idx],
+  while (layer_info) {
+    if ((*layer_info)[temporal_idx] != -1 &&
+        AheadOf<uint16_t, kPicIdLength>((*layer_info)[temporal_idx],
                                         frame->id.picture_id)) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->id.picture_id;
+    (*layer_info)[temporal_idx] = frame->id.picture_id;
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = layer_info_.Find(unwrapped_tl0);
   }
   not_yet_received_frames_.erase(frame->id.picture_id);
 
@@ -478,17 +477,15 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->id.picture_id;
-      gof_info_.emplace(unwrapped_tl0,
+      gof_info_.Emplace(unwrapped_tl0,
                         GofInfo(&scalability_structures_[current_ss_idx_],
                                 frame->id.picture_id));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->id.picture_id, info);
@@ -500,12 +497,10 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->id.picture_id, info);
@@ -513,28 +508,19 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       return kHandOff;
     }
   } else {
-    auto gof_info_it = gof_info_.find(
-        (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
+    info = gof_info_.Find((codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1
+                                                           : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (!info)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0, GofInfo(gof_info_it->second.gof,
-                                                        frame->id.picture_id))
-                        .first;
+      info = gof_info_.Emplace(unwrapped_tl0,
+                               GofInfo(info->gof, frame->id.picture_id));
     }
-
-    info = &gof_info_it->second;
   }
 
-  // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
-
   FrameReceivedVp9(frame->id.picture_id, info);
 
   // Make sure we don't miss any frame that could potentially have the
@@ -713,11 +699,6 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
 
   int64_t unwrapped_tl0 = tl0_unwrapper_.Unwrap(rtp_frame_marking.tl0_pic_idx);
 
-  // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
-
   // Clean up info about not yet received frames that are too old.
   uint16_t old_picture_id = frame->id.picture_id - kMaxNotYetReceivedFrames * 2;
   auto clean_frames_to = not_yet_received_seq_num_.lower_bound(old_picture_id);
@@ -726,25 +707,23 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    layer_info_.Emplace(unwrapped_tl0, LayerInfo())->fill(-1);
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
 
-  auto layer_info_it =
-      layer_info_.find(tid == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
+  LayerInfo* layer_info =
+      layer_info_.Find(tid == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // Stash if we have no base layer frame yet.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // Base layer frame. Copy layer info from previous base layer frame.
   if (tid == 0) {
-    layer_info_it =
-        layer_info_.insert(std::make_pair(unwrapped_tl0, layer_info_it->second))
-            .first;
+    layer_info = layer_info_.Emplace(unwrapped_tl0, *layer_info);
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
@@ -752,7 +731,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   // This frame only references its base layer frame.
   if (blSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
@@ -761,12 +740,12 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   frame->num_references = 0;
   for (uint8_t layer = 0; layer <= tid; ++layer) {
     // Stash if we have not yet received frames on this temporal layer.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // Drop if the last frame on this layer is ahead of this frame. A layer sync
     // frame was received after this frame for the same base layer frame.
-    uint16_t last_frame_in_layer = layer_info_it->second[layer];
+    uint16_t last_frame_in_layer = (*layer_info)[layer];
     if (AheadOf<uint16_t>(last_frame_in_layer, frame->id.picture_id))
       return kDrop;
 
@@ -815,20 +794,20 @@ void RtpFrameReferenceFinder::UpdateLastPictureIdWithPaddingH264() {
 void RtpFrameReferenceFinder::UpdateLayerInfoH264(RtpFrameObject* frame,
                                                   int64_t unwrapped_tl0,
                                                   uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  LayerInfo* layer_info = layer_info_.Find(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t>(layer_info_it->second[temporal_idx],
+  while (layer_info) {
+    if ((*layer_info)[temporal_idx] != -1 &&
+        AheadOf<uint16_t>((*layer_info)[temporal_idx],
                           frame->id.picture_id)) {
       // Not a newer frame. No subsequent layer info needs update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->id.picture_id;
+    (*layer_info)[temporal_idx] = frame->id.picture_id;
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = layer_info_.Find(unwrapped_tl0);
   }
 
   for (size_t i = 0; i < frame->num_references; ++i)
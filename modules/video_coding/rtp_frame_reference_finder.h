@@ -18,6 +18,7 @@
 #include <set>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
@@ -79,6 +80,47 @@ class RtpFrameReferenceFinder {
     uint16_t last_picture_id;
   };
 
+  // Holds a value for each of the last |kSize| unwrapped TL0 picture indices,
+  // in a fixed array indexed by the TL0 picture index modulo |kSize|. Storing
+  // the value of a newer index overwrites the value |kSize| indices older.
+  template <typename T, int kSize>
+  class Tl0PicIdxBuffer {
+   public:
+    // Returns nullptr if there is no value for |unwrapped_tl0|.
+    T* Find(int64_t unwrapped_tl0) {
+      Entry& entry = entries_[Index(unwrapped_tl0)];
+      if (!entry.value || entry.unwrapped_tl0 != unwrapped_tl0)
+        return nullptr;
+      return &*entry.value;
+    }
+
+    // Stores |value| for |unwrapped_tl0|, unless there already is a value for
+    // it. Returns the stored value.
+    T* Emplace(int64_t unwrapped_tl0, const T& value) {
+      T* existing = Find(unwrapped_tl0);
+      if (existing)
+        return existing;
+      Entry& entry = entries_[Index(unwrapped_tl0)];
+      entry.unwrapped_tl0 = unwrapped_tl0;
+      entry.value = value;
+      return &*entry.value;
+    }
+
+   private:
+    struct Entry {
+      int64_t unwrapped_tl0 = 0;
+      absl::optional<T> value;
+    };
+
+    static int Index(int64_t unwrapped_tl0) {
+      return ((unwrapped_tl0 % kSize) + kSize) % kSize;
+    }
+
+    std::array<Entry, kSize> entries_;
+  };
+
+  using LayerInfo = std::array<int64_t, kMaxTemporalLayers>;
+
   // Find the relevant group of pictures and update its "last-picture-id-with
   // padding" sequence number.
   void UpdateLastPictureIdWithPadding(uint16_t seq_num);
@@ -171,12 +213,12 @@ class RtpFrameReferenceFinder {
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> not_yet_received_seq_num_;
 
   // Frames that have been fully received but didn't have all the information
-  // needed to determine their references.
+  // needed to determine their references, oldest first.
   std::deque<std::unique_ptr<RtpFrameObject>> stashed_frames_;
 
   // Holds the information about the last completed frame for a given temporal
   // layer given an unwrapped Tl0 picture index.
-  std::map<int64_t, std::array<int64_t, kMaxTemporalLayers>> layer_info_;
+  Tl0PicIdxBuffer<LayerInfo, kMaxLayerInfo> layer_info_;
 
   // Where the current scalability structure is in the
   // |scalability_structures_| array.
@@ -186,7 +228,7 @@ class RtpFrameReferenceFinder {
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
   // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  Tl0PicIdxBuffer<GofInfo, kMaxGofSaved> gof_info_;
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
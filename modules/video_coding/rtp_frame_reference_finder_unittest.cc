@@ -631,6 +631,24 @@ TEST_F(TestRtpFrameReferenceFinder, Vp8InsertManyFrames_0212) {
   }
 }
 
+TEST_F(TestRtpFrameReferenceFinder, Vp8StashedFramesCompleteAfterKeyframe) {
+  uint16_t pid = Rand();
+  uint16_t sn = Rand();
+  const int kNumDeltaFrames = 40;
+  uint8_t tl0 = 250;
+
+  for (int f = 1; f <= kNumDeltaFrames; ++f)
+    InsertVp8(sn + f, sn + f, false, pid + f, 0, tl0 + f, false);
+  EXPECT_EQ(0UL, frames_from_callback_.size());
+
+  InsertVp8(sn, sn, true, pid, 0, tl0, false);
+  ASSERT_EQ(static_cast<size_t>(kNumDeltaFrames + 1),
+            frames_from_callback_.size());
+  CheckReferencesVp8(pid);
+  for (int f = 1; f <= kNumDeltaFrames; ++f)
+    CheckReferencesVp8(pid + f, pid + f - 1);
+}
+
 TEST_F(TestRtpFrameReferenceFinder, Vp8LayerSync) {
   uint16_t pid = Rand();
   uint16_t sn = Rand();
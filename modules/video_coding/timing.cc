@@ -19,10 +19,10 @@
 
 namespace webrtc {
 
-VCMTiming::VCMTiming(Clock* clock, VCMTiming* master_timing)
+VCMTiming::VCMTiming(Clock* clock)
     : clock_(clock),
-      master_(false),
-      ts_extrapolator_(),
+      ts_extrapolator_(std::make_unique<TimestampExtrapolator>(
+          clock_->TimeInMilliseconds())),
       codec_timer_(new VCMCodecTimer()),
       render_delay_ms_(kDefaultRenderDelayMs),
       min_playout_delay_ms_(0),
@@ -31,20 +31,9 @@ VCMTiming::VCMTiming(Clock* clock, VCMTiming* master_timing)
       current_delay_ms_(0),
       prev_frame_timestamp_(0),
       timing_frame_info_(),
-      num_decoded_frames_(0) {
-  if (master_timing == NULL) {
-    master_ = true;
-    ts_extrapolator_ = new TimestampExtrapolator(clock_->TimeInMilliseconds());
-  } else {
-    ts_extrapolator_ = master_timing->ts_extrapolator_;
-  }
-}
+      num_decoded_frames_(0) {}
 
-VCMTiming::~VCMTiming() {
-  if (master_) {
-    delete ts_extrapolator_;
-  }
-}
+VCMTiming::~VCMTiming() = default;
 
 void VCMTiming::Reset() {
   rtc::CritScope cs(&crit_sect_);
@@ -26,9 +26,7 @@ class TimestampExtrapolator;
 
 class VCMTiming {
  public:
-  // The primary timing component should be passed
-  // if this is the dual timing component.
-  explicit VCMTiming(Clock* clock, VCMTiming* master_timing = NULL);
+  explicit VCMTiming(Clock* clock);
   virtual ~VCMTiming();
 
   // Resets the timing to the initial state.
@@ -112,8 +110,8 @@ class VCMTiming {
  private:
   rtc::CriticalSection crit_sect_;
   Clock* const clock_;
-  bool master_ RTC_GUARDED_BY(crit_sect_);
-  TimestampExtrapolator* ts_extrapolator_ RTC_GUARDED_BY(crit_sect_);
+  const std::unique_ptr<TimestampExtrapolator> ts_extrapolator_
+      RTC_PT_GUARDED_BY(crit_sect_);
   std::unique_ptr<VCMCodecTimer> codec_timer_ RTC_GUARDED_BY(crit_sect_);
   int render_delay_ms_ RTC_GUARDED_BY(crit_sect_);
   // Best-effort playout delay range for frames from capture to render.
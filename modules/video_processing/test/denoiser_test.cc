@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -132,6 +133,46 @@ TEST(VideoDenoiserTest, MbDenoise) {
   EXPECT_EQ(COPY_BLOCK, decision);
 }
 
+TEST(VideoDenoiserTest, MbDenoiseRandomBlocks) {
+  std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
+  std::unique_ptr<DenoiserFilter> df_simd(
+      DenoiserFilter::Create(true, nullptr));
+  // Blocks inside wider rows, so that the stride differs from the width.
+  const int kStride = 40;
+  uint8_t running_src[16 * kStride], src[16 * kStride];
+  uint8_t dst[16 * kStride], dst_simd[16 * kStride];
+  uint32_t seed = 1;
+  for (int test = 0; test < 100; ++test) {
+    const int max_diff = test % 20;
+    for (int i = 0; i < 16 * kStride; ++i) {
+      seed = seed * 1103515245 + 12345;
+      running_src[i] = seed >> 24;
+      const int diff = static_cast<int>((seed >> 8) % (2 * max_diff + 1)) -
+                       max_diff;
+      src[i] = std::min(255, std::max(0, running_src[i] + diff));
+    }
+    const uint8_t motion_magnitude = test % 3 == 0 ? 30 : 0;
+    const int increase_denoising = test % 2;
+    memset(dst, 0, sizeof(dst));
+    memset(dst_simd, 0, sizeof(dst_simd));
+    DenoiserDecision decision =
+        df_c->MbDenoise(running_src, kStride, dst, kStride, src, kStride,
+                        motion_magnitude, increase_denoising);
+    DenoiserDecision decision_simd =
+        df_simd->MbDenoise(running_src, kStride, dst_simd, kStride, src,
+                           kStride, motion_magnitude, increase_denoising);
+    EXPECT_EQ(decision, decision_simd);
+    EXPECT_EQ(0, memcmp(dst, dst_simd, sizeof(dst)));
+
+    uint32_t sse = 0;
+    uint32_t sse_simd = 0;
+    EXPECT_EQ(df_c->Variance16x8(running_src, kStride, src, kStride, &sse),
+              df_simd->Variance16x8(running_src, kStride, src, kStride,
+                                    &sse_simd));
+    EXPECT_EQ(sse, sse_simd);
+  }
+}
+
 TEST(VideoDenoiserTest, Denoiser) {
   const int kWidth = 352;
   const int kHeight = 288;
@@ -165,4 +206,32 @@ TEST(VideoDenoiserTest, Denoiser) {
   ASSERT_NE(0, feof(source_file)) << "Error reading source file";
 }
 
+TEST(VideoDenoiserTest, DenoiserHighResolution) {
+  // 1080p, which is not a multiple of the macroblock size in height.
+  const int kWidth = 1920;
+  const int kHeight = 1080;
+  VideoDenoiser denoiser_c(false);
+  VideoDenoiser denoiser_simd(true);
+
+  uint32_t seed = 1;
+  for (int frame = 0; frame < 5; ++frame) {
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+    I420Buffer::SetBlack(buffer.get());
+    // A gradient with some noise, which differs between the frames.
+    for (int y = 0; y < kHeight; ++y) {
+      uint8_t* row = buffer->MutableDataY() + y * buffer->StrideY();
+      for (int x = 0; x < kWidth; ++x) {
+        seed = seed * 1103515245 + 12345;
+        row[x] = static_cast<uint8_t>((x + y) / 16 + ((seed >> 24) & 7));
+      }
+    }
+
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame_c(
+        denoiser_c.DenoiseFrame(buffer, true));
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame_simd(
+        denoiser_simd.DenoiseFrame(buffer, true));
+    ASSERT_TRUE(test::FrameBufsEqual(denoised_frame_c, denoised_frame_simd));
+  }
+}
+
 }  // namespace webrtc
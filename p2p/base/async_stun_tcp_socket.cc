@@ -103,26 +103,34 @@ void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
   // |         Channel Number        |            Length             |
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
+  // Packets are read in place, and what is left of the last one is moved to
+  // the start of |data| once, when all complete packets have been read.
+  size_t processed_len = 0;
   while (true) {
+    const char* packet = data + processed_len;
+    const size_t remaining_len = *len - processed_len;
     // We need at least 4 bytes to read the STUN or ChannelData packet length.
-    if (*len < kPacketLenOffset + kPacketLenSize)
-      return;
+    if (remaining_len < kPacketLenOffset + kPacketLenSize)
+      break;
 
     int pad_bytes;
-    size_t expected_pkt_len = GetExpectedLength(data, *len, &pad_bytes);
+    size_t expected_pkt_len =
+        GetExpectedLength(packet, remaining_len, &pad_bytes);
     size_t actual_length = expected_pkt_len + pad_bytes;
 
-    if (*len < actual_length) {
-      return;
+    if (remaining_len < actual_length) {
+      break;
     }
 
-    SignalReadPacket(this, data, expected_pkt_len, remote_addr,
+    SignalReadPacket(this, packet, expected_pkt_len, remote_addr,
                      rtc::TimeMicros());
 
-    *len -= actual_length;
-    if (*len > 0) {
-      memmove(data, data + actual_length, *len);
-    }
+    processed_len += actual_length;
+  }
+
+  *len -= processed_len;
+  if (processed_len > 0 && *len > 0) {
+    memmove(data, data + processed_len, *len);
   }
 }
 
@@ -179,6 +179,31 @@ TEST_F(AsyncStunTCPSocketTest, TestTurnChannelDataPadding) {
                         sizeof(kTurnChannelDataMessageWithOddLength)));
 }
 
+// Verifying that packets that are received together are all read, padding
+// included.
+TEST_F(AsyncStunTCPSocketTest, TestMultiplePacketsInOneRead) {
+  rtc::PacketOptions options;
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+            send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                               sizeof(kTurnChannelDataMessageWithOddLength),
+                               options));
+  EXPECT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+            send_socket_->Send(kStunMessageWithZeroLength,
+                               sizeof(kStunMessageWithZeroLength), options));
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessage)),
+            send_socket_->Send(kTurnChannelDataMessage,
+                               sizeof(kTurnChannelDataMessage), options));
+  vss_->ProcessMessagesUntilIdle();
+
+  ASSERT_EQ(3u, recv_packets_.size());
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+  EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                        sizeof(kStunMessageWithZeroLength)));
+  EXPECT_TRUE(
+      CheckData(kTurnChannelDataMessage, sizeof(kTurnChannelDataMessage)));
+}
+
 // Verifying stun message with invalid length.
 TEST_F(AsyncStunTCPSocketTest, TestStunInvalidLength) {
   EXPECT_FALSE(Send(kStunMessageWithInvalidLength,
@@ -374,6 +374,8 @@ class Connection : public CandidatePairInterface,
 
   IceMode remote_ice_mode_;
   StunRequestManager requests_;
+  // Keyed with the remote ICE password.
+  StunPasswordHmac remote_password_hmac_;
   int rtt_;
   int rtt_samples_ = 0;
   // https://w3c.github.io/webrtc-stats/#dom-rtcicecandidatepairstats-totalroundtriptime
@@ -10,6 +10,7 @@
 
 #include "p2p/base/p2p_transport_channel.h"
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -699,7 +700,8 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
   webrtc::StructParametersParser::Create(
       "skip_relay_to_non_relay_connections",
       &field_trials_.skip_relay_to_non_relay_connections,
-      "max_outstanding_pings", &field_trials_.max_outstanding_pings)
+      "max_outstanding_pings", &field_trials_.max_outstanding_pings,
+      "max_connections", &field_trials_.max_connections)
       ->Parse(webrtc::field_trial::FindFullName("WebRTC-IceFieldTrials"));
 
   if (field_trials_.skip_relay_to_non_relay_connections) {
@@ -711,6 +713,11 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
                      << *field_trials_.max_outstanding_pings;
   }
 
+  if (field_trials_.max_connections.has_value()) {
+    RTC_LOG(LS_INFO) << "Set max_connections: "
+                     << *field_trials_.max_connections;
+  }
+
   webrtc::BasicRegatheringController::Config regathering_config(
       config_.regather_all_networks_interval_range,
       config_.regather_on_failed_networks_interval_or_default());
@@ -1389,7 +1396,10 @@ bool P2PTransportChannel::CreateConnection(PortInterface* port,
 
 bool P2PTransportChannel::FindConnection(Connection* connection) const {
   RTC_DCHECK_RUN_ON(network_thread_);
-  return absl::c_linear_search(connections_, connection);
+  // Every connection is in exactly one of these sets, which avoids scanning
+  // |connections_| for every received packet.
+  return pinged_connections_.count(connection) > 0 ||
+         unpinged_connections_.count(connection) > 0;
 }
 
 uint32_t P2PTransportChannel::GetRemoteCandidateGeneration(
@@ -1835,16 +1845,23 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
-      connections_, [this](const Connection* a, const Connection* b) {
-        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-        if (cmp != 0) {
-          return cmp > 0;
-        }
-        // Otherwise, sort based on latency estimate.
-        return a->rtt() < b->rtt();
-      });
+  auto is_better = [this](const Connection* a, const Connection* b) {
+    int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+    // Otherwise, sort based on latency estimate.
+    return a->rtt() < b->rtt();
+  };
+  // Usually only a few connections change their rank between two sorts, so
+  // sort by insertion, which costs one comparison per connection that keeps
+  // its place. Like a stable sort, this keeps the order of equal connections.
+  for (auto it = connections_.begin(); it != connections_.end(); ++it) {
+    if (it == connections_.begin() || !is_better(*it, *(it - 1)))
+      continue;
+    auto pos = std::upper_bound(connections_.begin(), it, *it, is_better);
+    std::rotate(pos, it, it + 1);
+  }
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections";
@@ -1871,6 +1888,8 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
     PruneConnections();
   }
 
+  EvictConnectionsOverLimit();
+
   // Check if all connections are timedout.
   bool all_connections_timedout = true;
   for (size_t i = 0; i < connections_.size(); ++i) {
@@ -1965,6 +1984,34 @@ void P2PTransportChannel::PruneConnections() {
   }
 }
 
+void P2PTransportChannel::EvictConnectionsOverLimit() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!field_trials_.max_connections.has_value())
+    return;
+  // Failed connections are already being destroyed, or at least pruned.
+  size_t max_connections =
+      static_cast<size_t>(std::max(*field_trials_.max_connections, 1));
+  size_t num_connections =
+      absl::c_count_if(connections_, [](const Connection* conn) {
+        return conn->state() != IceCandidatePairState::FAILED;
+      });
+  // |connections_| is sorted, so walk it starting at the lowest ranked one.
+  // Destroying a connection removes it from |connections_| asynchronously.
+  for (auto it = connections_.rbegin();
+       it != connections_.rend() && num_connections > max_connections; ++it) {
+    Connection* conn = *it;
+    if (conn == selected_connection_ ||
+        conn->state() == IceCandidatePairState::FAILED) {
+      continue;
+    }
+    RTC_LOG(LS_INFO) << ToString() << ": Evicting connection "
+                     << conn->ToString() << ", over the limit of "
+                     << max_connections;
+    conn->FailAndDestroy();
+    --num_connections;
+  }
+}
+
 // Change the selected connection, and let listeners know.
 void P2PTransportChannel::SwitchSelectedConnection(Connection* conn,
                                                    const std::string& reason) {
@@ -78,6 +78,8 @@ class RemoteCandidate : public Candidate {
 struct IceFieldTrials {
   bool skip_relay_to_non_relay_connections = false;
   absl::optional<int> max_outstanding_pings;
+  // When set, the lowest ranked connections beyond this number are destroyed.
+  absl::optional<int> max_connections;
 };
 
 // P2PTransportChannel manages the candidates and connection process to keep
@@ -366,6 +368,9 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   std::map<rtc::Network*, Connection*> GetBestConnectionByNetwork() const;
   std::vector<Connection*> GetBestWritableConnectionPerNetwork() const;
   void PruneConnections();
+  // Destroys the lowest ranked connections beyond the max_connections field
+  // trial limit.
+  void EvictConnectionsOverLimit();
   bool IsBackupConnection(const Connection* conn) const;
 
   Connection* FindOldestConnectionNeedingTriggeredCheck(int64_t now);
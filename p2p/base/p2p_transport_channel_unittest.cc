@@ -4556,6 +4556,30 @@ TEST_F(P2PTransportChannelPingTest, TestMaxOutstandingPingsFieldTrial) {
   EXPECT_EQ(nullptr, ch.FindNextPingableConnection());
 }
 
+TEST_F(P2PTransportChannelPingTest, TestMaxConnectionsFieldTrial) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-IceFieldTrials/max_connections:2/");
+  FakePortAllocator pa(rtc::Thread::Current(), nullptr);
+  P2PTransportChannel ch("max", 1, &pa);
+  ch.SetIceConfig(ch.config());
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 3));
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "2.2.2.2", 2, 2));
+  Connection* conn1 = WaitForConnectionTo(&ch, "1.1.1.1", 1);
+  Connection* conn2 = WaitForConnectionTo(&ch, "2.2.2.2", 2);
+  ASSERT_TRUE(conn1 != nullptr);
+  ASSERT_TRUE(conn2 != nullptr);
+
+  // The connection with the lowest priority is destroyed.
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "3.3.3.3", 3, 1));
+  EXPECT_TRUE_WAIT(ch.connections().size() == 2u &&
+                       GetConnectionTo(&ch, "3.3.3.3", 3) == nullptr,
+                   kDefaultTimeout);
+  EXPECT_EQ(conn1, GetConnectionTo(&ch, "1.1.1.1", 1));
+  EXPECT_EQ(conn2, GetConnectionTo(&ch, "2.2.2.2", 2));
+}
+
 class P2PTransportChannelMostLikelyToWorkFirstTest
     : public P2PTransportChannelPingTest {
  public:
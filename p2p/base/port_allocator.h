@@ -88,6 +88,12 @@ enum {
   // Exclude link-local network interfaces
   // from considertaion after adapter enumeration.
   PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000,
+
+  // When specified, the UDP, relay and TCP phases of an allocation sequence run
+  // back to back instead of being separated by the step delay. Host candidates
+  // are still signaled first, as soon as their ports are ready. Combine with
+  // TURN port pruning to drop relay candidates dominated by a better one.
+  PORTALLOCATOR_ENABLE_PARALLEL_GATHERING = 0x20000,
 };
 
 // Defines various reasons that have caused ICE regathering.
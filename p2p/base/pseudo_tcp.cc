@@ -14,6 +14,7 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <set>
@@ -74,6 +75,10 @@ const uint32_t JINGLE_HEADER_SIZE = 64;  // when relay framing is in use
 const uint32_t DEFAULT_RCV_BUF_SIZE = 60 * 1024;
 const uint32_t DEFAULT_SND_BUF_SIZE = 90 * 1024;
 
+// CUBIC constants, RFC 8312 section 5.
+const double kCubicC = 0.4;     // Segments per second cubed.
+const double kCubicBeta = 0.7;  // Multiplicative decrease factor.
+
 //////////////////////////////////////////////////////////////////////
 // Global Constants and Functions
 //////////////////////////////////////////////////////////////////////
@@ -246,6 +251,13 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_dup_acks = 0;
   m_recover = 0;
 
+  m_cubic_w_max = 0;
+  m_cubic_epoch_started = false;
+  m_cubic_epoch_start = 0;
+  m_cubic_origin = 0;
+  m_cubic_k = 0;
+  m_cubic_reno_estimate = 0;
+
   m_ts_recent = m_ts_lastack = 0;
 
   m_rx_rto = DEF_RTO;
@@ -253,6 +265,7 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
 
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
+  m_use_cubic = false;
   m_support_wnd_scale = true;
 }
 
@@ -303,7 +316,7 @@ void PseudoTcp::NotifyClock(uint32_t now) {
       }
 
       uint32_t nInFlight = m_snd_nxt - m_snd_una;
-      m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+      onCongestion(nInFlight);
       // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: " <<
       // nInFlight << "  m_mss: " << m_mss;
       m_cwnd = m_mss;
@@ -373,6 +386,8 @@ void PseudoTcp::GetOption(Option opt, int* value) {
     *value = m_sbuf_len;
   } else if (opt == OPT_RCVBUF) {
     *value = m_rbuf_len;
+  } else if (opt == OPT_CUBIC) {
+    *value = m_use_cubic ? 1 : 0;
   } else {
     RTC_NOTREACHED();
   }
@@ -388,6 +403,8 @@ void PseudoTcp::SetOption(Option opt, int value) {
   } else if (opt == OPT_RCVBUF) {
     RTC_DCHECK(m_state == TCP_LISTEN);
     resizeReceiveBuffer(value);
+  } else if (opt == OPT_CUBIC) {
+    m_use_cubic = value != 0;
   } else {
     RTC_NOTREACHED();
   }
@@ -779,7 +796,7 @@ bool PseudoTcp::process(Segment& seg) {
       if (m_cwnd < m_ssthresh) {
         m_cwnd += m_mss;
       } else {
-        m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
+        m_cwnd += congestionAvoidanceIncrease(now);
       }
     }
   } else if (seg.ack == m_snd_una) {
@@ -803,7 +820,7 @@ bool PseudoTcp::process(Segment& seg) {
         }
         m_recover = m_snd_nxt;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
-        m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+        onCongestion(nInFlight);
         // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: "
         // << nInFlight << "  m_mss: " << m_mss;
         m_cwnd = m_ssthresh + 3 * m_mss;
@@ -1058,6 +1075,59 @@ bool PseudoTcp::transmit(const SList::iterator& seg, uint32_t now) {
   return true;
 }
 
+void PseudoTcp::onCongestion(uint32_t nInFlight) {
+  if (!m_use_cubic) {
+    m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+    return;
+  }
+  // With fast convergence, release some bandwidth for new flows when the
+  // window did not grow back to where it was at the previous loss.
+  m_cubic_w_max = m_cwnd < m_cubic_w_max
+                      ? static_cast<uint32_t>(m_cwnd * (1 + kCubicBeta) / 2)
+                      : m_cwnd;
+  m_cubic_epoch_started = false;
+  m_ssthresh =
+      std::max(static_cast<uint32_t>(nInFlight * kCubicBeta), 2 * m_mss);
+}
+
+uint32_t PseudoTcp::congestionAvoidanceIncrease(uint32_t now) {
+  const uint32_t reno_increase = std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
+  if (!m_use_cubic)
+    return reno_increase;
+
+  if (!m_cubic_epoch_started) {
+    m_cubic_epoch_started = true;
+    m_cubic_epoch_start = now;
+    if (m_cwnd < m_cubic_w_max) {
+      m_cubic_k = std::cbrt(static_cast<double>(m_cubic_w_max - m_cwnd) /
+                            m_mss / kCubicC);
+      m_cubic_origin = m_cubic_w_max;
+    } else {
+      m_cubic_k = 0;
+      m_cubic_origin = m_cwnd;
+    }
+    m_cubic_reno_estimate = m_cwnd;
+  }
+
+  // The window that the cubic function reaches one round trip from now.
+  const double t =
+      (rtc::TimeDiff32(now, m_cubic_epoch_start) + m_rx_srtt) / 1000.0;
+  double target =
+      m_cubic_origin + kCubicC * std::pow(t - m_cubic_k, 3) * m_mss;
+
+  // Never grow slower than Reno would with the same decrease factor.
+  m_cubic_reno_estimate += 3 * (1 - kCubicBeta) / (1 + kCubicBeta) *
+                           m_mss * m_mss / m_cwnd;
+  target = std::max(target, m_cubic_reno_estimate);
+
+  if (target <= m_cwnd)
+    return 1;
+  // Grow towards the target over a round trip, at most 1.5x per round trip.
+  target = std::min(target, 1.5 * m_cwnd);
+  return std::max<uint32_t>(
+      1, static_cast<uint32_t>((target - m_cwnd) * m_mss / m_cwnd));
+}
+
 void PseudoTcp::attemptSend(SendFlags sflags) {
   uint32_t now = Now();
 
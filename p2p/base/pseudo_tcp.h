@@ -97,6 +97,9 @@ class RTC_EXPORT PseudoTcp {
     OPT_ACKDELAY,  // The Delayed ACK timeout (0 == off).
     OPT_RCVBUF,    // Set the receive buffer size, in bytes.
     OPT_SNDBUF,    // Set the send buffer size, in bytes.
+    OPT_CUBIC,     // Whether to use CUBIC congestion control (0 == off, the
+                   // default, for NewReno). Only affects the sender, so it
+                   // works with any remote implementation.
   };
   void GetOption(Option opt, int* value);
   void SetOption(Option opt, int value);
@@ -168,6 +171,11 @@ class RTC_EXPORT PseudoTcp {
 
   void adjustMTU();
 
+  // Sets |m_ssthresh| after a loss, with |nInFlight| bytes in flight.
+  void onCongestion(uint32_t nInFlight);
+  // Returns by how much to grow |m_cwnd| for an ACK in congestion avoidance.
+  uint32_t congestionAvoidanceIncrease(uint32_t now);
+
  protected:
   // This method is used in test only to query receive buffer state.
   bool isReceiveBufferFull() const;
@@ -236,9 +244,20 @@ class RTC_EXPORT PseudoTcp {
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // CUBIC congestion control (RFC 8312), when |m_use_cubic|. The window size
+  // before the last reduction, and the origin point and time of the cubic
+  // function since then.
+  uint32_t m_cubic_w_max;
+  bool m_cubic_epoch_started;
+  uint32_t m_cubic_epoch_start;
+  uint32_t m_cubic_origin;
+  double m_cubic_k;              // Seconds from epoch start to origin point.
+  double m_cubic_reno_estimate;  // Window that Reno would have, in bytes.
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
+  bool m_use_cubic;
 
   // This is used by unit tests to test backward compatibility of
   // PseudoTcp implementations that don't support window scaling.
@@ -90,6 +90,10 @@ class PseudoTcpTestBase : public ::testing::Test,
     local_.SetOption(PseudoTcp::OPT_ACKDELAY, ack_delay);
     remote_.SetOption(PseudoTcp::OPT_ACKDELAY, ack_delay);
   }
+  void SetOptCubic(bool enable_cubic) {
+    local_.SetOption(PseudoTcp::OPT_CUBIC, enable_cubic);
+    remote_.SetOption(PseudoTcp::OPT_CUBIC, enable_cubic);
+  }
   void SetOptSndBuf(int size) {
     local_.SetOption(PseudoTcp::OPT_SNDBUF, size);
     remote_.SetOption(PseudoTcp::OPT_SNDBUF, size);
@@ -643,6 +647,30 @@ TEST_F(PseudoTcpTest, TestSendWithDelayAndLoss) {
   TestTransfer(100000);  // less data so test runs faster
 }
 
+// Test sending data with a 50 ms RTT and 10% packet loss, with CUBIC
+// congestion control.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossAndOptCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  SetOptCubic(true);
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Test sending data with large windows and CUBIC congestion control.
+TEST_F(PseudoTcpTest, TestSendBothUseLargeWindowScaleAndOptCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLocalOptRcvBuf(1000000);
+  SetRemoteOptRcvBuf(1000000);
+  SetOptSndBuf(1000000);
+  SetDelay(20);
+  SetLoss(2);
+  SetOptCubic(true);
+  TestTransfer(1000000);
+}
+
 // Test sending data with 10% packet loss and Nagling disabled.  Transmission
 // should take about the same time as with Nagling enabled.
 TEST_F(PseudoTcpTest, TestSendWithLossAndOptNaglingOff) {
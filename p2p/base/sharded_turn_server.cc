@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <utility>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/location.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket_server.h"
+
+namespace cricket {
+
+namespace {
+
+// Creates a socket bound to |*address| on |thread| and adds it to |server|.
+// If the port of |*address| is 0, it's updated with the bound address.
+bool CreateInternalSocket(rtc::Thread* thread,
+                          TurnServer* server,
+                          bool reuse_port,
+                          rtc::SocketAddress* address,
+                          ProtocolType proto) {
+  RTC_DCHECK(thread->IsCurrent());
+  const bool is_udp = proto == PROTO_UDP;
+  std::unique_ptr<rtc::AsyncSocket> socket(
+      thread->socketserver()->CreateAsyncSocket(
+          address->family(), is_udp ? SOCK_DGRAM : SOCK_STREAM));
+  if (!socket) {
+    RTC_LOG(LS_ERROR) << "Failed to create internal TURN socket.";
+    return false;
+  }
+  if (reuse_port && socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to enable SO_REUSEPORT on TURN socket.";
+    return false;
+  }
+  if (socket->Bind(*address) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to bind internal TURN socket to "
+                      << address->ToString();
+    return false;
+  }
+  if (address->port() == 0)
+    *address = socket->GetLocalAddress();
+
+  if (is_udp) {
+    server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                              proto);
+    return true;
+  }
+
+  if (socket->Listen(5) != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to listen on internal TURN socket "
+                      << address->ToString();
+    return false;
+  }
+  server->AddInternalServerSocket(socket.release(), proto);
+  return true;
+}
+
+}  // namespace
+
+ShardedTurnServer::Shard::Shard() = default;
+ShardedTurnServer::Shard::Shard(Shard&&) = default;
+ShardedTurnServer::Shard::~Shard() = default;
+
+ShardedTurnServer::ShardedTurnServer(int num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+  for (int i = 0; i < num_shards; ++i) {
+    Shard shard;
+    shard.thread = rtc::Thread::CreateWithSocketServer();
+    shard.thread->SetName("TurnServerShard", shard.thread.get());
+    shard.thread->Start();
+    rtc::Thread* thread = shard.thread.get();
+    shard.server = thread->Invoke<std::unique_ptr<TurnServer>>(
+        RTC_FROM_HERE,
+        [thread] { return std::make_unique<TurnServer>(thread); });
+    shards_.push_back(std::move(shard));
+  }
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  for (Shard& shard : shards_) {
+    // TurnServer must be destroyed on the thread it was created on.
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&shard] { shard.server.reset(); });
+    shard.thread->Stop();
+  }
+}
+
+template <class FunctorT>
+void ShardedTurnServer::InvokeOnAllShards(const FunctorT& functor) const {
+  for (const Shard& shard : shards_) {
+    TurnServer* server = shard.server.get();
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&functor, server] { functor(server); });
+  }
+}
+
+void ShardedTurnServer::set_realm(const std::string& realm) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards([&realm](TurnServer* server) { server->set_realm(realm); });
+}
+
+void ShardedTurnServer::set_software(const std::string& software) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards(
+      [&software](TurnServer* server) { server->set_software(software); });
+}
+
+void ShardedTurnServer::set_auth_hook(TurnAuthInterface* auth_hook) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards(
+      [auth_hook](TurnServer* server) { server->set_auth_hook(auth_hook); });
+}
+
+void ShardedTurnServer::set_enable_otu_nonce(bool enable) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards(
+      [enable](TurnServer* server) { server->set_enable_otu_nonce(enable); });
+}
+
+void ShardedTurnServer::set_reject_private_addresses(bool filter) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards([filter](TurnServer* server) {
+    server->set_reject_private_addresses(filter);
+  });
+}
+
+void ShardedTurnServer::set_enable_permission_checks(bool enable) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  InvokeOnAllShards([enable](TurnServer* server) {
+    server->set_enable_permission_checks(enable);
+  });
+}
+
+bool ShardedTurnServer::AddInternalSocket(const rtc::SocketAddress& address,
+                                          ProtocolType proto) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK(proto == PROTO_UDP || proto == PROTO_TCP ||
+             proto == PROTO_SSLTCP);
+  // With a single shard there is nothing to distribute, so don't require
+  // SO_REUSEPORT support.
+  const bool reuse_port = shards_.size() > 1;
+  rtc::SocketAddress bind_address = address;
+  for (const Shard& shard : shards_) {
+    rtc::Thread* thread = shard.thread.get();
+    TurnServer* server = shard.server.get();
+    bool created = thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return CreateInternalSocket(thread, server, reuse_port, &bind_address,
+                                  proto);
+    });
+    if (!created)
+      return false;
+  }
+  internal_addresses_.emplace_back(proto, bind_address);
+  return true;
+}
+
+void ShardedTurnServer::SetExternalAddress(
+    const rtc::SocketAddress& external_addr) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  for (const Shard& shard : shards_) {
+    rtc::Thread* thread = shard.thread.get();
+    TurnServer* server = shard.server.get();
+    thread->Invoke<void>(RTC_FROM_HERE, [thread, server, &external_addr] {
+      server->SetExternalSocketFactory(
+          new rtc::BasicPacketSocketFactory(thread), external_addr);
+    });
+  }
+}
+
+rtc::SocketAddress ShardedTurnServer::internal_address(
+    ProtocolType proto) const {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  for (const auto& internal_address : internal_addresses_) {
+    if (internal_address.first == proto)
+      return internal_address.second;
+  }
+  return rtc::SocketAddress();
+}
+
+size_t ShardedTurnServer::NumAllocations() const {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  size_t num_allocations = 0;
+  InvokeOnAllShards([&num_allocations](TurnServer* server) {
+    num_allocations += server->allocations().size();
+  });
+  return num_allocations;
+}
+
+}  // namespace cricket
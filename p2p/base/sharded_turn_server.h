@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDED_TURN_SERVER_H_
+#define P2P_BASE_SHARDED_TURN_SERVER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "p2p/base/port_interface.h"
+#include "p2p/base/turn_server.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace cricket {
+
+// Runs a TurnServer per shard, each on its own network thread with its own
+// sockets. The internal sockets of all shards are bound to the same address
+// with SO_REUSEPORT, which makes the kernel distribute incoming packets and
+// connections by their 5-tuple. All packets of a client therefore reach the
+// same shard, and relayed data (including ChannelData) is handled entirely on
+// that shard's thread.
+//
+// Since each shard has its own nonce key, a client must keep its 5-tuple for
+// the lifetime of its allocation, which holds for the kernel's hashing as long
+// as the set of internal sockets doesn't change.
+class ShardedTurnServer {
+ public:
+  explicit ShardedTurnServer(int num_shards);
+  ~ShardedTurnServer();
+
+  size_t num_shards() const { return shards_.size(); }
+
+  // These apply to all shards. See TurnServer for details.
+  void set_realm(const std::string& realm);
+  void set_software(const std::string& software);
+  // |auth_hook| is called on all shard threads, so it must be thread safe.
+  // Does not take ownership.
+  void set_auth_hook(TurnAuthInterface* auth_hook);
+  void set_enable_otu_nonce(bool enable);
+  void set_reject_private_addresses(bool filter);
+  void set_enable_permission_checks(bool enable);
+
+  // Creates one internal socket per shard, all bound to |address|. If the port
+  // of |address| is 0, the port picked for the first shard is used for all
+  // shards. Returns false if the sockets could not be created, e.g. because
+  // SO_REUSEPORT is not supported.
+  bool AddInternalSocket(const rtc::SocketAddress& address,
+                         ProtocolType proto);
+  // Allocates relayed addresses on |external_addr|, using a socket factory
+  // for each shard's thread.
+  void SetExternalAddress(const rtc::SocketAddress& external_addr);
+
+  // Returns the address that the internal sockets of |proto| are bound to, or
+  // a nil address if there is none.
+  rtc::SocketAddress internal_address(ProtocolType proto) const;
+
+  // Returns the total number of allocations of all shards.
+  size_t NumAllocations() const;
+
+  // For testing. The server must only be used on the shard's thread.
+  rtc::Thread* shard_thread(size_t index) const {
+    return shards_[index].thread.get();
+  }
+  TurnServer* shard_server(size_t index) const {
+    return shards_[index].server.get();
+  }
+
+ private:
+  struct Shard {
+    Shard();
+    Shard(Shard&&);
+    ~Shard();
+
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  // Runs |functor| with the TurnServer of each shard, on the shard's thread.
+  template <class FunctorT>
+  void InvokeOnAllShards(const FunctorT& functor) const;
+
+  rtc::ThreadChecker thread_checker_;
+  std::vector<Shard> shards_;
+  std::vector<std::pair<ProtocolType, rtc::SocketAddress>> internal_addresses_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDED_TURN_SERVER_H_
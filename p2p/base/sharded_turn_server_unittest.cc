@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/test_client.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+namespace {
+const rtc::SocketAddress kLoopbackAddress("127.0.0.1", 0);
+constexpr int kNumShards = 2;
+constexpr int kNumClients = 8;
+}  // namespace
+
+class ShardedTurnServerTest : public ::testing::Test {
+ public:
+  ShardedTurnServerTest() : thread_(&ss_), server_(kNumShards) {}
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  ShardedTurnServer server_;
+};
+
+TEST_F(ShardedTurnServerTest, BindsAllShardsToTheSamePort) {
+  ASSERT_TRUE(server_.AddInternalSocket(kLoopbackAddress, PROTO_UDP));
+  rtc::SocketAddress address = server_.internal_address(PROTO_UDP);
+  EXPECT_NE(0, address.port());
+  EXPECT_TRUE(server_.internal_address(PROTO_TCP).IsNil());
+  EXPECT_EQ(0u, server_.NumAllocations());
+}
+
+// Each client is served by one of the shards, whichever the kernel picks.
+TEST_F(ShardedTurnServerTest, AnswersBindingRequestsOfAllClients) {
+  ASSERT_TRUE(server_.AddInternalSocket(kLoopbackAddress, PROTO_UDP));
+  rtc::SocketAddress server_address = server_.internal_address(PROTO_UDP);
+
+  std::vector<std::unique_ptr<rtc::TestClient>> clients;
+  for (int i = 0; i < kNumClients; ++i) {
+    clients.push_back(std::make_unique<rtc::TestClient>(
+        absl::WrapUnique(rtc::AsyncUDPSocket::Create(&ss_, kLoopbackAddress))));
+  }
+
+  for (auto& client : clients) {
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(
+        rtc::CreateRandomString(kStunTransactionIdLength));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client->SendTo(buf.Data(), buf.Length(), server_address);
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client->NextPacket(rtc::TestClient::kTimeoutMs);
+    ASSERT_TRUE(packet);
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    StunMessage response;
+    ASSERT_TRUE(response.Read(&reader));
+    EXPECT_EQ(STUN_BINDING_RESPONSE, response.type());
+    EXPECT_EQ(request.transaction_id(), response.transaction_id());
+  }
+}
+
+}  // namespace cricket
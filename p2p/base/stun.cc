@@ -182,6 +182,14 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 bool StunMessage::ValidateMessageIntegrity(const char* data,
                                            size_t size,
                                            const std::string& password) {
+  std::unique_ptr<rtc::HmacContext> hmac = rtc::HmacContext::Create(
+      rtc::DIGEST_SHA_1, password.c_str(), password.size());
+  return hmac && ValidateMessageIntegrity(data, size, hmac.get());
+}
+
+bool StunMessage::ValidateMessageIntegrity(const char* data,
+                                           size_t size,
+                                           rtc::HmacContext* hmac) {
   // Verifying the size of the message.
   if ((size % 4) != 0 || size < kStunHeaderSize) {
     return false;
@@ -224,10 +232,12 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
+  // Getting length of the message to calculate Message Integrity. Only the
+  // header may need to be changed, so it's copied and hashed separately from
+  // the attributes.
   size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
+  char header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
   if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
     // Stun message has other attributes after message integrity.
     // Adjust the length parameter in stun message to calculate HMAC.
@@ -241,20 +251,20 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
     //     |0 0|     STUN Message Type     |         Message Length        |
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
+    rtc::SetBE16(header + 2, static_cast<uint16_t>(new_adjusted_len));
   }
 
-  char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac))
+  char hmac_value[kStunMessageIntegritySize];
+  hmac->Update(header, kStunHeaderSize);
+  hmac->Update(data + kStunHeaderSize, mi_pos - kStunHeaderSize);
+  size_t ret = hmac->Finish(hmac_value, sizeof(hmac_value));
+  RTC_DCHECK(ret == sizeof(hmac_value));
+  if (ret != sizeof(hmac_value))
     return false;
 
   // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac,
-                sizeof(hmac)) == 0;
+  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac_value,
+                sizeof(hmac_value)) == 0;
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
@@ -262,6 +272,12 @@ bool StunMessage::AddMessageIntegrity(const std::string& password) {
 }
 
 bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
+  std::unique_ptr<rtc::HmacContext> hmac =
+      rtc::HmacContext::Create(rtc::DIGEST_SHA_1, key, keylen);
+  return hmac && AddMessageIntegrity(hmac.get());
+}
+
+bool StunMessage::AddMessageIntegrity(rtc::HmacContext* hmac) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   auto msg_integrity_attr_ptr = std::make_unique<StunByteStringAttribute>(
@@ -276,18 +292,18 @@ bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
 
   int msg_len_for_hmac = static_cast<int>(
       buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
-  char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1, key, keylen, buf.Data(),
-                                msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  char hmac_value[kStunMessageIntegritySize];
+  hmac->Update(buf.Data(), msg_len_for_hmac);
+  size_t ret = hmac->Finish(hmac_value, sizeof(hmac_value));
+  RTC_DCHECK(ret == sizeof(hmac_value));
+  if (ret != sizeof(hmac_value)) {
     RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
                          "has dummy value.";
     return false;
   }
 
   // Insert correct HMAC into the attribute.
-  msg_integrity_attr->CopyBytes(hmac, sizeof(hmac));
+  msg_integrity_attr->CopyBytes(hmac_value, sizeof(hmac_value));
   return true;
 }
 
@@ -1133,4 +1149,18 @@ StunMessage* IceMessage::CreateNew() const {
   return new IceMessage();
 }
 
+StunPasswordHmac::StunPasswordHmac() = default;
+
+StunPasswordHmac::~StunPasswordHmac() = default;
+
+rtc::HmacContext* StunPasswordHmac::Get(const std::string& password) {
+  if (!hmac_ || password != password_) {
+    hmac_ = rtc::HmacContext::Create(rtc::DIGEST_SHA_1, password.c_str(),
+                                     password.size());
+    RTC_DCHECK(hmac_);
+    password_ = password;
+  }
+  return hmac_.get();
+}
+
 }  // namespace cricket
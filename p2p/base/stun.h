@@ -23,6 +23,7 @@
 
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 
 namespace cricket {
@@ -179,9 +180,15 @@ class StunMessage {
   static bool ValidateMessageIntegrity(const char* data,
                                        size_t size,
                                        const std::string& password);
+  // Like above, but with an HMAC-SHA1 context keyed with the password, see
+  // StunPasswordHmac.
+  static bool ValidateMessageIntegrity(const char* data,
+                                       size_t size,
+                                       rtc::HmacContext* hmac);
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
   bool AddMessageIntegrity(const char* key, size_t keylen);
+  bool AddMessageIntegrity(rtc::HmacContext* hmac);
 
   // Verifies that a given buffer is STUN by checking for a correct FINGERPRINT.
   static bool ValidateFingerprint(const char* data, size_t size);
@@ -221,6 +228,22 @@ class StunMessage {
   uint32_t stun_magic_cookie_;
 };
 
+// Keeps an HMAC-SHA1 context for computing and validating MESSAGE-INTEGRITY
+// with a password, so that the key is only set up again when the password
+// changes rather than for every message.
+class StunPasswordHmac {
+ public:
+  StunPasswordHmac();
+  ~StunPasswordHmac();
+
+  // Returns the context keyed with |password|.
+  rtc::HmacContext* Get(const std::string& password);
+
+ private:
+  std::string password_;
+  std::unique_ptr<rtc::HmacContext> hmac_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
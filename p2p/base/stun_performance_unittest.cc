@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/allocation_counter.h"
+#include "test/testsupport/perf_test.h"
+
+namespace cricket {
+namespace {
+
+constexpr int kWarmUpIterations = 1000;
+constexpr int kIterations = 100000;
+const char kTransactionId[] = "0123456789ab";
+const char kUsername[] = "abcdefgh:ijklmnop";
+const char kPassword[] = "0123456789abcdefghijklmn";
+
+// Runs |operation| repeatedly and reports the mean time and number of heap
+// allocations per call. |operation| returns whether it succeeded, so that its
+// work can not be optimized away.
+template <typename Operation>
+void ReportOperationCost(const std::string& name, Operation operation) {
+  for (int i = 0; i < kWarmUpIterations; ++i)
+    ASSERT_TRUE(operation());
+  int failures = 0;
+  webrtc::test::AllocationCounter allocations;
+  const int64_t start_time_ns = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i) {
+    if (!operation())
+      ++failures;
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_time_ns;
+  const int64_t num_allocations = allocations.new_count();
+  EXPECT_EQ(failures, 0);
+  webrtc::test::PrintResult(
+      "time_per_op", "", name, static_cast<double>(elapsed_ns) / kIterations,
+      "ns", false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult(
+      "allocations_per_op", "", name,
+      static_cast<double>(num_allocations) / kIterations, "count", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+}
+
+// A connectivity check as sent by a controlling ICE agent.
+bool WriteBindingRequest(rtc::ByteBufferWriter* buffer) {
+  IceMessage message;
+  message.SetType(STUN_BINDING_REQUEST);
+  message.SetTransactionID(kTransactionId);
+  message.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  message.AddAttribute(
+      std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 0x6e7f1eff));
+  message.AddAttribute(std::make_unique<StunUInt64Attribute>(
+      STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdefull));
+  message.AddAttribute(
+      StunAttribute::CreateByteString(STUN_ATTR_USE_CANDIDATE));
+  return message.AddMessageIntegrity(kPassword) && message.AddFingerprint() &&
+         message.Write(buffer);
+}
+
+bool WriteBindingResponse(rtc::ByteBufferWriter* buffer) {
+  IceMessage message;
+  message.SetType(STUN_BINDING_RESPONSE);
+  message.SetTransactionID(kTransactionId);
+  message.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_MAPPED_ADDRESS, rtc::SocketAddress("192.168.1.2", 5678)));
+  return message.AddMessageIntegrity(kPassword) && message.AddFingerprint() &&
+         message.Write(buffer);
+}
+
+bool ReadMessage(const rtc::ByteBufferWriter& buffer) {
+  IceMessage message;
+  rtc::ByteBufferReader reader(buffer);
+  return message.Read(&reader);
+}
+
+}  // namespace
+
+// Baselines for the cost of the STUN messages of ICE connectivity checks, per
+// message. The results are meant to be compared between builds on the same
+// machine.
+TEST(StunPerformanceTest, BindingRequest) {
+  ReportOperationCost("stun_binding_request_write", [] {
+    rtc::ByteBufferWriter buffer;
+    return WriteBindingRequest(&buffer);
+  });
+
+  rtc::ByteBufferWriter buffer;
+  ASSERT_TRUE(WriteBindingRequest(&buffer));
+  ReportOperationCost("stun_binding_request_read",
+                      [&] { return ReadMessage(buffer); });
+  ReportOperationCost("stun_binding_request_validate", [&] {
+    return StunMessage::ValidateFingerprint(buffer.Data(), buffer.Length()) &&
+           StunMessage::ValidateMessageIntegrity(buffer.Data(),
+                                                 buffer.Length(), kPassword);
+  });
+}
+
+TEST(StunPerformanceTest, BindingResponse) {
+  ReportOperationCost("stun_binding_response_write", [] {
+    rtc::ByteBufferWriter buffer;
+    return WriteBindingResponse(&buffer);
+  });
+
+  rtc::ByteBufferWriter buffer;
+  ASSERT_TRUE(WriteBindingResponse(&buffer));
+  ReportOperationCost("stun_binding_response_read",
+                      [&] { return ReadMessage(buffer); });
+}
+
+}  // namespace cricket
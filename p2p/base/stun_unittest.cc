@@ -1271,6 +1271,38 @@ TEST_F(StunTest, AddMessageIntegrity) {
       kRfc5769SampleMsgPassword));
 }
 
+// Test that a cached HMAC context can be used for several messages, and is
+// keyed again when the password changes.
+TEST_F(StunTest, MessageIntegrityWithPasswordHmac) {
+  StunPasswordHmac password_hmac;
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleRequest),
+        sizeof(kRfc5769SampleRequest),
+        password_hmac.Get(kRfc5769SampleMsgPassword)));
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleResponse),
+        sizeof(kRfc5769SampleResponse),
+        password_hmac.Get(kRfc5769SampleMsgPassword)));
+  }
+  EXPECT_FALSE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest), password_hmac.Get("InvalidPassword")));
+
+  IceMessage msg;
+  rtc::ByteBufferReader buf(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+      sizeof(kRfc5769SampleRequestWithoutMI));
+  EXPECT_TRUE(msg.Read(&buf));
+  EXPECT_TRUE(
+      msg.AddMessageIntegrity(password_hmac.Get(kRfc5769SampleMsgPassword)));
+  const StunByteStringAttribute* mi_attr =
+      msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+  EXPECT_EQ(20U, mi_attr->length());
+  EXPECT_EQ(
+      0, memcmp(mi_attr->bytes(), kCalculatedHmac1, sizeof(kCalculatedHmac1)));
+}
+
 // Check our STUN message validation code against the RFC5769 test messages.
 TEST_F(StunTest, ValidateFingerprint) {
   EXPECT_TRUE(StunMessage::ValidateFingerprint(
@@ -718,7 +718,8 @@ bool TurnPort::HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
   // This must be a response for one of our requests.
   // Check success responses, but not errors, for MESSAGE-INTEGRITY.
   if (IsStunSuccessResponseType(msg_type) &&
-      !StunMessage::ValidateMessageIntegrity(data, size, hash())) {
+      !StunMessage::ValidateMessageIntegrity(data, size,
+                                             hash_hmac_.Get(hash()))) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received TURN message with invalid "
                            "message integrity, msg_type: "
@@ -1122,7 +1123,7 @@ void TurnPort::AddRequestAuthInfo(StunMessage* msg) {
       std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, realm_));
   msg->AddAttribute(
       std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
-  const bool success = msg->AddMessageIntegrity(hash());
+  const bool success = msg->AddMessageIntegrity(hash_hmac_.Get(hash()));
   RTC_DCHECK(success);
 }
 
@@ -1175,16 +1176,13 @@ bool TurnPort::HasPermission(const rtc::IPAddress& ipaddr) const {
 }
 
 TurnEntry* TurnPort::FindEntry(const rtc::SocketAddress& addr) const {
-  auto it = absl::c_find_if(
-      entries_, [&addr](const TurnEntry* e) { return e->address() == addr; });
-  return (it != entries_.end()) ? *it : NULL;
+  auto it = entries_by_address_.find(addr);
+  return (it != entries_by_address_.end()) ? it->second : NULL;
 }
 
 TurnEntry* TurnPort::FindEntry(int channel_id) const {
-  auto it = absl::c_find_if(entries_, [&channel_id](const TurnEntry* e) {
-    return e->channel_id() == channel_id;
-  });
-  return (it != entries_.end()) ? *it : NULL;
+  auto it = entries_by_channel_id_.find(channel_id);
+  return (it != entries_by_channel_id_.end()) ? it->second : NULL;
 }
 
 bool TurnPort::EntryExists(TurnEntry* e) {
@@ -1203,6 +1201,9 @@ bool TurnPort::CreateOrRefreshEntry(const rtc::SocketAddress& addr,
   if (entry == nullptr) {
     entry = new TurnEntry(this, channel_number, addr, remote_ufrag);
     entries_.push_back(entry);
+    entries_by_address_[addr] = entry;
+    // Keeps the older entry if a channel id is reused.
+    entries_by_channel_id_.emplace(channel_number, entry);
     return true;
   } else {
     if (entry->destruction_timestamp()) {
@@ -1237,6 +1238,8 @@ void TurnPort::DestroyEntry(TurnEntry* entry) {
   RTC_DCHECK(entry != NULL);
   entry->SignalDestroyed(entry);
   entries_.remove(entry);
+  entries_by_address_.erase(entry->address());
+  RemoveEntryChannelId(entry);
   delete entry;
 }
 
@@ -1279,10 +1282,19 @@ bool TurnPort::SetEntryChannelId(const rtc::SocketAddress& address,
   if (!entry) {
     return false;
   }
+  RemoveEntryChannelId(entry);
   entry->set_channel_id(channel_id);
+  entries_by_channel_id_.emplace(channel_id, entry);
   return true;
 }
 
+void TurnPort::RemoveEntryChannelId(TurnEntry* entry) {
+  auto it = entries_by_channel_id_.find(entry->channel_id());
+  if (it != entries_by_channel_id_.end() && it->second == entry) {
+    entries_by_channel_id_.erase(it);
+  }
+}
+
 std::string TurnPort::ReconstructedServerUrl(bool use_hostname) {
   // draft-petithuguenin-behave-turn-uris-01
   // turnURI       = scheme ":" turn-host [ ":" turn-port ]
@@ -1781,7 +1793,8 @@ int TurnEntry::Send(const void* data,
                     size_t size,
                     bool payload,
                     const rtc::PacketOptions& options) {
-  rtc::ByteBufferWriter buf;
+  rtc::ByteBufferWriter& buf = port_->send_buf_;
+  buf.Clear();
   if (state_ != STATE_BOUND ||
       !port_->TurnCustomizerAllowChannelData(data, size, payload)) {
     // If we haven't bound the channel yet, we have to use a Send Indication.
@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -25,6 +26,7 @@
 #include "p2p/client/basic_port_allocator.h"
 #include "rtc_base/async_invoker.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/byte_buffer.h"
 #include "rtc_base/ssl_certificate.h"
 
 namespace webrtc {
@@ -281,6 +283,11 @@ class TurnPort : public Port {
     MSG_ALLOCATION_RELEASED
   };
 
+  struct SocketAddressHash {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
   typedef std::list<TurnEntry*> EntryList;
   typedef std::map<rtc::Socket::Option, int> SocketOptionsMap;
   typedef std::set<rtc::SocketAddress> AttemptedServerSet;
@@ -337,6 +344,7 @@ class TurnPort : public Port {
   TurnEntry* FindEntry(const rtc::SocketAddress& address) const;
   TurnEntry* FindEntry(int channel_id) const;
   bool EntryExists(TurnEntry* e);
+  void RemoveEntryChannelId(TurnEntry* entry);
   void DestroyEntry(TurnEntry* entry);
   // Destroys the entry only if |timestamp| matches the destruction timestamp
   // in |entry|.
@@ -375,9 +383,17 @@ class TurnPort : public Port {
   std::string realm_;  // From 401/438 response message.
   std::string nonce_;  // From 401/438 response message.
   std::string hash_;   // Digest of username:realm:password
+  StunPasswordHmac hash_hmac_;  // Keyed with |hash_|.
 
   int next_channel_number_;
   EntryList entries_;
+  // Index of |entries_| by peer address and by channel id, which are looked
+  // up for every packet sent and received.
+  std::unordered_map<rtc::SocketAddress, TurnEntry*, SocketAddressHash>
+      entries_by_address_;
+  std::unordered_map<int, TurnEntry*> entries_by_channel_id_;
+  // Reused for the Send indications and ChannelData messages of the entries.
+  rtc::ByteBufferWriter send_buf_;
 
   PortState state_;
   // By default the value will be set to 0. This value will be used in
@@ -0,0 +1,308 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udp_mux.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "api/packet_socket_factory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace cricket {
+
+namespace {
+
+struct SocketAddressHash {
+  size_t operator()(const rtc::SocketAddress& address) const {
+    return address.Hash();
+  }
+};
+
+// Returns the local username fragment of |data| if it is a STUN binding
+// request, or an empty string.
+std::string GetBindingRequestUfrag(const char* data, size_t size) {
+  // All ICE STUN messages have a fingerprint, which is cheap to look for.
+  if (!StunMessage::ValidateFingerprint(data, size)) {
+    return std::string();
+  }
+  IceMessage message;
+  rtc::ByteBufferReader buf(data, size);
+  if (!message.Read(&buf) || message.type() != STUN_BINDING_REQUEST) {
+    return std::string();
+  }
+  const StunByteStringAttribute* username_attr =
+      message.GetByteString(STUN_ATTR_USERNAME);
+  if (!username_attr) {
+    return std::string();
+  }
+  // The USERNAME of a request is "<receiver ufrag>:<sender ufrag>".
+  const std::string username = username_attr->GetString();
+  size_t colon_pos = username.find(':');
+  if (colon_pos == std::string::npos) {
+    return std::string();
+  }
+  return username.substr(0, colon_pos);
+}
+
+}  // namespace
+
+// Owns one shared UDP socket and routes its packets to the UdpMuxSockets on
+// it.
+class UdpMux::SharedSocket : public sigslot::has_slots<> {
+ public:
+  explicit SharedSocket(std::unique_ptr<rtc::AsyncPacketSocket> socket)
+      : socket_(std::move(socket)) {
+    socket_->SignalReadPacket.connect(this, &SharedSocket::OnReadPacket);
+    socket_->SignalSentPacket.connect(this, &SharedSocket::OnSentPacket);
+    socket_->SignalReadyToSend.connect(this, &SharedSocket::OnReadyToSend);
+  }
+
+  ~SharedSocket() override {
+    RTC_DCHECK(sockets_by_ufrag_.empty())
+        << "UdpMuxSockets must be destroyed before the UdpMux.";
+  }
+
+  rtc::AsyncPacketSocket* socket() { return socket_.get(); }
+
+  bool AddUfrag(UdpMuxSocket* socket, const std::string& ufrag) {
+    return sockets_by_ufrag_.emplace(ufrag, socket).second;
+  }
+
+  void RemoveUfrag(UdpMuxSocket* socket, const std::string& ufrag) {
+    auto it = sockets_by_ufrag_.find(ufrag);
+    if (it != sockets_by_ufrag_.end() && it->second == socket) {
+      sockets_by_ufrag_.erase(it);
+    }
+  }
+
+  void RemoveSocket(UdpMuxSocket* socket) {
+    RemoveUfrag(socket, socket->ufrag());
+    for (auto it = sockets_by_remote_address_.begin();
+         it != sockets_by_remote_address_.end();) {
+      if (it->second == socket) {
+        it = sockets_by_remote_address_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    RemoveFromReadyToSend(socket);
+  }
+
+  void AddToReadyToSend(UdpMuxSocket* socket) {
+    sockets_.push_back(socket);
+  }
+
+  int SendTo(UdpMuxSocket* socket,
+             const void* data,
+             size_t size,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) {
+    // Replies from an address that has not been seen yet, e.g. to a binding
+    // request sent before the remote side sent its own, go to this socket.
+    sockets_by_remote_address_.emplace(addr, socket);
+    // The shared socket signals the sent packet from within SendTo().
+    RTC_DCHECK(!sending_socket_);
+    sending_socket_ = socket;
+    int ret = socket_->SendTo(data, size, addr, options);
+    sending_socket_ = nullptr;
+    return ret;
+  }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    UdpMuxSocket* target = nullptr;
+    // Binding requests are routed by ufrag even from known addresses, so that
+    // a remote endpoint that restarts ICE from the same address reaches the
+    // new session.
+    std::string ufrag = GetBindingRequestUfrag(data, size);
+    if (!ufrag.empty()) {
+      auto it = sockets_by_ufrag_.find(ufrag);
+      if (it != sockets_by_ufrag_.end()) {
+        target = it->second;
+        sockets_by_remote_address_[remote_addr] = target;
+      }
+    }
+    if (!target) {
+      auto it = sockets_by_remote_address_.find(remote_addr);
+      if (it == sockets_by_remote_address_.end()) {
+        RTC_LOG(LS_VERBOSE) << "Dropping packet from unknown address "
+                            << remote_addr.ToSensitiveString();
+        return;
+      }
+      target = it->second;
+    }
+    target->SignalReadPacket(target, data, size, remote_addr, packet_time_us);
+  }
+
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet) {
+    if (sending_socket_) {
+      sending_socket_->SignalSentPacket(sending_socket_, sent_packet);
+    }
+  }
+
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket) {
+    // Copied, since a socket may be destroyed by a signal handler.
+    std::vector<UdpMuxSocket*> sockets = sockets_;
+    for (UdpMuxSocket* mux_socket : sockets) {
+      if (std::find(sockets_.begin(), sockets_.end(), mux_socket) !=
+          sockets_.end()) {
+        mux_socket->SignalReadyToSend(mux_socket);
+      }
+    }
+  }
+
+  void RemoveFromReadyToSend(UdpMuxSocket* socket) {
+    sockets_.erase(std::remove(sockets_.begin(), sockets_.end(), socket),
+                   sockets_.end());
+  }
+
+  const std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  std::unordered_map<std::string, UdpMuxSocket*> sockets_by_ufrag_;
+  std::unordered_map<rtc::SocketAddress, UdpMuxSocket*, SocketAddressHash>
+      sockets_by_remote_address_;
+  // All sockets on this shared socket, which are signaled when it is ready to
+  // send again.
+  std::vector<UdpMuxSocket*> sockets_;
+  UdpMuxSocket* sending_socket_ = nullptr;
+};
+
+UdpMux::UdpMux(rtc::PacketSocketFactory* socket_factory, uint16_t port)
+    : socket_factory_(socket_factory), port_(port) {
+  RTC_DCHECK(socket_factory_);
+}
+
+UdpMux::~UdpMux() = default;
+
+std::unique_ptr<UdpMuxSocket> UdpMux::CreateSocket(
+    const rtc::IPAddress& local_ip,
+    const std::string& ufrag) {
+  auto it = shared_sockets_.find(local_ip);
+  if (it == shared_sockets_.end()) {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(
+        socket_factory_->CreateUdpSocket(rtc::SocketAddress(local_ip, 0),
+                                         port_, port_));
+    if (!socket) {
+      RTC_LOG(LS_WARNING) << "Failed to create shared UDP socket on "
+                          << local_ip.ToSensitiveString() << ":" << port_;
+      return nullptr;
+    }
+    RTC_LOG(LS_INFO) << "Created shared UDP socket on "
+                     << socket->GetLocalAddress().ToSensitiveString();
+    it = shared_sockets_
+             .emplace(local_ip,
+                      std::make_unique<SharedSocket>(std::move(socket)))
+             .first;
+  }
+  SharedSocket* shared_socket = it->second.get();
+  std::unique_ptr<UdpMuxSocket> socket(new UdpMuxSocket(shared_socket, ufrag));
+  if (!shared_socket->AddUfrag(socket.get(), ufrag)) {
+    RTC_LOG(LS_WARNING) << "Ufrag " << ufrag << " is already used on "
+                        << local_ip.ToSensitiveString();
+    // Not registered, so nothing to remove when it is destroyed.
+    socket->shared_socket_ = nullptr;
+    return nullptr;
+  }
+  shared_socket->AddToReadyToSend(socket.get());
+  return socket;
+}
+
+UdpMuxSocket::UdpMuxSocket(UdpMux::SharedSocket* shared_socket,
+                           const std::string& ufrag)
+    : shared_socket_(shared_socket), ufrag_(ufrag) {}
+
+UdpMuxSocket::~UdpMuxSocket() {
+  Close();
+}
+
+bool UdpMuxSocket::SetUfrag(const std::string& ufrag) {
+  if (!shared_socket_ || ufrag == ufrag_) {
+    return shared_socket_ != nullptr;
+  }
+  shared_socket_->RemoveUfrag(this, ufrag_);
+  ufrag_ = ufrag;
+  if (!shared_socket_->AddUfrag(this, ufrag_)) {
+    RTC_LOG(LS_WARNING) << "Ufrag " << ufrag << " is already used on "
+                        << GetLocalAddress().ToSensitiveString();
+    return false;
+  }
+  return true;
+}
+
+rtc::SocketAddress UdpMuxSocket::GetLocalAddress() const {
+  return shared_socket_ ? shared_socket_->socket()->GetLocalAddress()
+                        : rtc::SocketAddress();
+}
+
+rtc::SocketAddress UdpMuxSocket::GetRemoteAddress() const {
+  return rtc::SocketAddress();
+}
+
+int UdpMuxSocket::Send(const void* pv,
+                       size_t cb,
+                       const rtc::PacketOptions& options) {
+  // Not connected to a remote address.
+  SetError(ENOTCONN);
+  return -1;
+}
+
+int UdpMuxSocket::SendTo(const void* pv,
+                         size_t cb,
+                         const rtc::SocketAddress& addr,
+                         const rtc::PacketOptions& options) {
+  if (!shared_socket_) {
+    return -1;
+  }
+  return shared_socket_->SendTo(this, pv, cb, addr, options);
+}
+
+int UdpMuxSocket::Close() {
+  if (shared_socket_) {
+    shared_socket_->RemoveSocket(this);
+    shared_socket_ = nullptr;
+  }
+  return 0;
+}
+
+rtc::AsyncPacketSocket::State UdpMuxSocket::GetState() const {
+  return shared_socket_ ? shared_socket_->socket()->GetState() : STATE_CLOSED;
+}
+
+// Options are set on the shared socket, so they apply to all sockets on it.
+int UdpMuxSocket::GetOption(rtc::Socket::Option opt, int* value) {
+  return shared_socket_ ? shared_socket_->socket()->GetOption(opt, value) : -1;
+}
+
+int UdpMuxSocket::SetOption(rtc::Socket::Option opt, int value) {
+  return shared_socket_ ? shared_socket_->socket()->SetOption(opt, value) : -1;
+}
+
+int UdpMuxSocket::GetError() const {
+  return shared_socket_ ? shared_socket_->socket()->GetError() : 0;
+}
+
+void UdpMuxSocket::SetError(int error) {
+  if (shared_socket_) {
+    shared_socket_->socket()->SetError(error);
+  }
+}
+
+}  // namespace cricket
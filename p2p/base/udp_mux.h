@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_UDP_MUX_H_
+#define P2P_BASE_UDP_MUX_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+
+namespace rtc {
+class PacketSocketFactory;
+}  // namespace rtc
+
+namespace cricket {
+
+class UdpMuxSocket;
+
+// Shares one UDP socket per local address between the ICE sessions of a
+// server, instead of binding a socket per session and network, which cuts the
+// number of file descriptors and poller registrations to one per interface.
+// The first packet from a remote address is routed by the local username
+// fragment in the USERNAME of its STUN binding request, and later packets by
+// the remote address. Addresses that a socket sends to are routed to it as
+// well, unless they already belong to another socket.
+//
+// BasicPortAllocator uses it for sessions without STUN or TURN servers, since a
+// server address can't be told apart between the sessions that use it. All
+// methods must be called on the network thread, and the mux must outlive the
+// sockets it creates.
+class UdpMux {
+ public:
+  // The shared sockets are created with |socket_factory| and bound to |port|,
+  // or to any port if it is 0.
+  UdpMux(rtc::PacketSocketFactory* socket_factory, uint16_t port);
+  ~UdpMux();
+
+  // Returns a socket on the shared socket of |local_ip|, which is created if
+  // needed, that receives the packets for |ufrag|. Returns null if the shared
+  // socket can't be created or |ufrag| is already used on it.
+  std::unique_ptr<UdpMuxSocket> CreateSocket(const rtc::IPAddress& local_ip,
+                                             const std::string& ufrag);
+
+ private:
+  friend class UdpMuxSocket;
+  class SharedSocket;
+
+  rtc::PacketSocketFactory* const socket_factory_;
+  const uint16_t port_;
+  std::map<rtc::IPAddress, std::unique_ptr<SharedSocket>> shared_sockets_;
+};
+
+// The socket of one ICE session on a UDP socket shared through UdpMux. It
+// sends from the shared socket and only signals the packets routed to it.
+class UdpMuxSocket : public rtc::AsyncPacketSocket {
+ public:
+  ~UdpMuxSocket() override;
+
+  // Changes the username fragment that STUN binding requests are matched
+  // against, e.g. when a pooled session is taken into use. Returns false if
+  // another socket on the same shared socket uses |ufrag|, in which case only
+  // the packets from addresses that this socket has sent to are routed to it.
+  bool SetUfrag(const std::string& ufrag);
+  const std::string& ufrag() const { return ufrag_; }
+
+  // rtc::AsyncPacketSocket implementation. Sends are never batched, so that
+  // SignalSentPacket is emitted on the socket that sent the packet.
+  rtc::SocketAddress GetLocalAddress() const override;
+  rtc::SocketAddress GetRemoteAddress() const override;
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override;
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override;
+  int Close() override;
+  State GetState() const override;
+  int GetOption(rtc::Socket::Option opt, int* value) override;
+  int SetOption(rtc::Socket::Option opt, int value) override;
+  int GetError() const override;
+  void SetError(int error) override;
+
+ private:
+  friend class UdpMux;
+
+  UdpMuxSocket(UdpMux::SharedSocket* shared_socket, const std::string& ufrag);
+
+  UdpMux::SharedSocket* shared_socket_;
+  std::string ufrag_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_UDP_MUX_H_
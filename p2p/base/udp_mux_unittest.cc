@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udp_mux.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+namespace {
+
+const rtc::IPAddress kLocalIp(0x01020304);
+const rtc::SocketAddress kRemoteAddr1("11.11.11.11", 5000);
+const rtc::SocketAddress kRemoteAddr2("22.22.22.22", 5000);
+const uint16_t kMuxPort = 3478;
+const int kTimeoutMs = 1000;
+
+// Records the packets and sent packets signaled by a socket.
+class PacketReceiver : public sigslot::has_slots<> {
+ public:
+  explicit PacketReceiver(rtc::AsyncPacketSocket* socket) {
+    socket->SignalReadPacket.connect(this, &PacketReceiver::OnReadPacket);
+    socket->SignalSentPacket.connect(this, &PacketReceiver::OnSentPacket);
+  }
+
+  const std::vector<std::string>& packets() const { return packets_; }
+  int num_sent_packets() const { return num_sent_packets_; }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets_.emplace_back(data, size);
+  }
+
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet) {
+    ++num_sent_packets_;
+  }
+
+  std::vector<std::string> packets_;
+  int num_sent_packets_ = 0;
+};
+
+std::string CreateBindingRequest(const std::string& local_ufrag) {
+  IceMessage message;
+  message.SetType(STUN_BINDING_REQUEST);
+  message.SetTransactionID("0123456789ab");
+  message.AddAttribute(std::make_unique<StunByteStringAttribute>(
+      STUN_ATTR_USERNAME, local_ufrag + ":remote"));
+  message.AddFingerprint();
+  rtc::ByteBufferWriter buf;
+  message.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+}  // namespace
+
+class UdpMuxTest : public ::testing::Test {
+ public:
+  UdpMuxTest()
+      : thread_(&ss_),
+        socket_factory_(&thread_),
+        mux_(&socket_factory_, kMuxPort),
+        remote_socket1_(socket_factory_.CreateUdpSocket(kRemoteAddr1,
+                                                        kRemoteAddr1.port(),
+                                                        kRemoteAddr1.port())),
+        remote_socket2_(socket_factory_.CreateUdpSocket(kRemoteAddr2,
+                                                        kRemoteAddr2.port(),
+                                                        kRemoteAddr2.port())) {}
+
+  // Sends |data| from |remote_addr| to the shared socket.
+  void SendFromRemote(const rtc::SocketAddress& remote_addr,
+                      const std::string& data) {
+    rtc::AsyncPacketSocket* socket = remote_addr == kRemoteAddr1
+                                         ? remote_socket1_.get()
+                                         : remote_socket2_.get();
+    const rtc::SocketAddress mux_addr(kLocalIp, kMuxPort);
+    socket->SendTo(data.data(), data.size(), mux_addr, rtc::PacketOptions());
+  }
+
+ protected:
+  rtc::VirtualSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  UdpMux mux_;
+  std::unique_ptr<rtc::AsyncPacketSocket> remote_socket1_;
+  std::unique_ptr<rtc::AsyncPacketSocket> remote_socket2_;
+};
+
+TEST_F(UdpMuxTest, SharesOneSocketPerLocalAddress) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  std::unique_ptr<UdpMuxSocket> socket2 = mux_.CreateSocket(kLocalIp, "ufrag2");
+  ASSERT_TRUE(socket1);
+  ASSERT_TRUE(socket2);
+  EXPECT_EQ(rtc::SocketAddress(kLocalIp, kMuxPort), socket1->GetLocalAddress());
+  EXPECT_EQ(socket1->GetLocalAddress(), socket2->GetLocalAddress());
+  EXPECT_EQ(rtc::AsyncPacketSocket::STATE_BOUND, socket1->GetState());
+}
+
+TEST_F(UdpMuxTest, RejectsDuplicateUfrag) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  ASSERT_TRUE(socket1);
+  EXPECT_FALSE(mux_.CreateSocket(kLocalIp, "ufrag1"));
+  std::unique_ptr<UdpMuxSocket> socket2 = mux_.CreateSocket(kLocalIp, "ufrag2");
+  ASSERT_TRUE(socket2);
+  EXPECT_FALSE(socket2->SetUfrag("ufrag1"));
+  // The ufrag can be used again once its socket is destroyed.
+  socket1.reset();
+  EXPECT_TRUE(socket2->SetUfrag("ufrag1"));
+}
+
+TEST_F(UdpMuxTest, RoutesByUfragThenByAddress) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  std::unique_ptr<UdpMuxSocket> socket2 = mux_.CreateSocket(kLocalIp, "ufrag2");
+  PacketReceiver receiver1(socket1.get());
+  PacketReceiver receiver2(socket2.get());
+
+  const std::string request1 = CreateBindingRequest("ufrag1");
+  const std::string request2 = CreateBindingRequest("ufrag2");
+  SendFromRemote(kRemoteAddr1, request2);
+  SendFromRemote(kRemoteAddr2, request1);
+  EXPECT_EQ_WAIT(1u, receiver1.packets().size(), kTimeoutMs);
+  EXPECT_EQ_WAIT(1u, receiver2.packets().size(), kTimeoutMs);
+  EXPECT_EQ(request1, receiver1.packets()[0]);
+  EXPECT_EQ(request2, receiver2.packets()[0]);
+
+  // Media from the same addresses goes to the sockets that the binding
+  // requests were routed to.
+  SendFromRemote(kRemoteAddr1, "media2");
+  SendFromRemote(kRemoteAddr2, "media1");
+  EXPECT_EQ_WAIT(2u, receiver1.packets().size(), kTimeoutMs);
+  EXPECT_EQ_WAIT(2u, receiver2.packets().size(), kTimeoutMs);
+  EXPECT_EQ("media1", receiver1.packets()[1]);
+  EXPECT_EQ("media2", receiver2.packets()[1]);
+}
+
+TEST_F(UdpMuxTest, RoutesRepliesToAddressesSentTo) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  std::unique_ptr<UdpMuxSocket> socket2 = mux_.CreateSocket(kLocalIp, "ufrag2");
+  PacketReceiver receiver1(socket1.get());
+  PacketReceiver receiver2(socket2.get());
+
+  const std::string kData = "data";
+  EXPECT_EQ(static_cast<int>(kData.size()),
+            socket2->SendTo(kData.data(), kData.size(), kRemoteAddr1,
+                            rtc::PacketOptions()));
+  SendFromRemote(kRemoteAddr1, "reply");
+  EXPECT_EQ_WAIT(1u, receiver2.packets().size(), kTimeoutMs);
+  EXPECT_EQ("reply", receiver2.packets()[0]);
+  EXPECT_TRUE(receiver1.packets().empty());
+}
+
+TEST_F(UdpMuxTest, DropsPacketsFromUnknownSources) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  PacketReceiver receiver1(socket1.get());
+
+  // Neither a binding request for a known ufrag nor from a known address.
+  SendFromRemote(kRemoteAddr1, CreateBindingRequest("unknown"));
+  SendFromRemote(kRemoteAddr1, "media");
+  // Sent last, so that the packets above have been handled once it arrives.
+  SendFromRemote(kRemoteAddr2, CreateBindingRequest("ufrag1"));
+  EXPECT_EQ_WAIT(1u, receiver1.packets().size(), kTimeoutMs);
+  EXPECT_EQ(CreateBindingRequest("ufrag1"), receiver1.packets()[0]);
+}
+
+TEST_F(UdpMuxTest, SentPacketSignaledOnlyOnSendingSocket) {
+  std::unique_ptr<UdpMuxSocket> socket1 = mux_.CreateSocket(kLocalIp, "ufrag1");
+  std::unique_ptr<UdpMuxSocket> socket2 = mux_.CreateSocket(kLocalIp, "ufrag2");
+  PacketReceiver receiver1(socket1.get());
+  PacketReceiver receiver2(socket2.get());
+
+  const std::string kData = "data";
+  socket1->SendTo(kData.data(), kData.size(), kRemoteAddr1,
+                  rtc::PacketOptions());
+  EXPECT_EQ(1, receiver1.num_sent_packets());
+  EXPECT_EQ(0, receiver2.num_sent_packets());
+}
+
+}  // namespace cricket
@@ -625,6 +625,9 @@ void BasicPortAllocatorSession::UpdateIceParametersInternal() {
     port.port()->set_content_name(content_name());
     port.port()->SetIceParameters(component(), ice_ufrag(), ice_pwd());
   }
+  for (AllocationSequence* sequence : sequences_) {
+    sequence->SetIceUfrag(ice_ufrag());
+  }
 }
 
 void BasicPortAllocatorSession::GetPortConfigurations() {
@@ -1250,9 +1253,22 @@ AllocationSequence::AllocationSequence(BasicPortAllocatorSession* session,
 
 void AllocationSequence::Init() {
   if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
-    udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
-        rtc::SocketAddress(network_->GetBestIP(), 0),
-        session_->allocator()->min_port(), session_->allocator()->max_port()));
+    UdpMux* udp_mux = session_->allocator()->udp_mux();
+    // Packets from STUN and TURN servers can't be told apart by ufrag, so
+    // sessions that use them get a socket of their own.
+    if (udp_mux && config_ && config_->StunServers().empty() &&
+        config_->relays.empty()) {
+      std::unique_ptr<UdpMuxSocket> socket =
+          udp_mux->CreateSocket(network_->GetBestIP(), session_->ice_ufrag());
+      udp_mux_socket_ = socket.get();
+      udp_socket_ = std::move(socket);
+    }
+    if (!udp_socket_) {
+      udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
+          rtc::SocketAddress(network_->GetBestIP(), 0),
+          session_->allocator()->min_port(),
+          session_->allocator()->max_port()));
+    }
     if (udp_socket_) {
       udp_socket_->SignalReadPacket.connect(this,
                                             &AllocationSequence::OnReadPacket);
@@ -1262,6 +1278,12 @@ void AllocationSequence::Init() {
   }
 }
 
+void AllocationSequence::SetIceUfrag(const std::string& ice_ufrag) {
+  if (udp_mux_socket_) {
+    udp_mux_socket_->SetUfrag(ice_ufrag);
+  }
+}
+
 void AllocationSequence::Clear() {
   udp_port_ = NULL;
   relay_ports_.clear();
@@ -1397,9 +1419,13 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
 
   if (state() == kRunning) {
     ++phase_;
-    session_->network_thread()->PostDelayed(RTC_FROM_HERE,
-                                            session_->allocator()->step_delay(),
-                                            this, MSG_ALLOCATION_PHASE);
+    // Posting the next phase, even without delay, lets the candidates of this
+    // phase be signaled before the next one starts.
+    int delay = IsFlagSet(PORTALLOCATOR_ENABLE_PARALLEL_GATHERING)
+                    ? 0
+                    : session_->allocator()->step_delay();
+    session_->network_thread()->PostDelayed(RTC_FROM_HERE, delay, this,
+                                            MSG_ALLOCATION_PHASE);
   } else {
     // If all phases in AllocationSequence are completed, no allocation
     // steps needed further. Canceling  pending signal.
@@ -17,6 +17,7 @@
 
 #include "api/turn_customizer.h"
 #include "p2p/base/port_allocator.h"
+#include "p2p/base/udp_mux.h"
 #include "p2p/client/relay_port_factory_interface.h"
 #include "p2p/client/turn_port_factory.h"
 #include "rtc_base/checks.h"
@@ -76,6 +77,19 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
     return relay_port_factory_;
   }
 
+  // Sets the mux that the UDP ports of sessions without STUN or TURN servers
+  // are created on when PORTALLOCATOR_ENABLE_SHARED_SOCKET is set, so that
+  // they share one socket per local address. Not owned, and must outlive the
+  // allocator and its sessions. Null by default.
+  void set_udp_mux(UdpMux* udp_mux) {
+    CheckRunOnValidThreadIfInitialized();
+    udp_mux_ = udp_mux;
+  }
+  UdpMux* udp_mux() {
+    CheckRunOnValidThreadIfInitialized();
+    return udp_mux_;
+  }
+
  private:
   void Construct();
 
@@ -97,6 +111,8 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   // This instance is created if caller does pass a factory.
   std::unique_ptr<RelayPortFactoryInterface> default_relay_port_factory_;
+
+  UdpMux* udp_mux_ = nullptr;
 };
 
 struct PortConfiguration;
@@ -345,6 +361,9 @@ class AllocationSequence : public rtc::MessageHandler,
   ~AllocationSequence() override;
   void Init();
   void Clear();
+  // Updates the username fragment that the shared socket is demultiplexed by,
+  // if it is on a UdpMux.
+  void SetIceUfrag(const std::string& ice_ufrag);
   void OnNetworkFailed();
 
   State state() const { return state_; }
@@ -407,6 +426,8 @@ class AllocationSequence : public rtc::MessageHandler,
   uint32_t flags_;
   ProtocolList protocols_;
   std::unique_ptr<rtc::AsyncPacketSocket> udp_socket_;
+  // Set if |udp_socket_| is on the allocator's UdpMux.
+  UdpMuxSocket* udp_mux_socket_ = nullptr;
   // There will be only one udp port per AllocationSequence.
   UDPPort* udp_port_;
   std::vector<Port*> relay_ports_;
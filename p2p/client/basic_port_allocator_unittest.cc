@@ -22,6 +22,7 @@
 #include "p2p/base/test_relay_server.h"
 #include "p2p/base/test_stun_server.h"
 #include "p2p/base/test_turn_server.h"
+#include "p2p/base/udp_mux.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/fake_mdns_responder.h"
 #include "rtc_base/fake_network.h"
@@ -93,6 +94,8 @@ static const int kMaxPort = 10099;
 static const char kIceUfrag0[] = "UF00";
 // Based on ICE_PWD_LENGTH
 static const char kIcePwd0[] = "TESTICEPWD00000000000000";
+static const char kIceUfrag1[] = "UF01";
+static const char kIcePwd1[] = "TESTICEPWD00000000000001";
 
 static const char kContentName[] = "test content";
 
@@ -1018,6 +1021,25 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithMinimumStepDelay) {
   EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
 }
 
+// Tests that with parallel gathering, all phases run without waiting for the
+// step delay.
+TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithParallelGathering) {
+  AddInterface(kClientAddr);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->set_flags(session_->flags() |
+                      PORTALLOCATOR_ENABLE_PARALLEL_GATHERING);
+  session_->StartGettingPorts();
+  ASSERT_EQ_SIMULATED_WAIT(3U, ports_.size(), kDefaultStepDelay / 2,
+                           fake_clock);
+  ASSERT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultAllocationTimeout, fake_clock);
+  EXPECT_EQ(3U, candidates_.size());
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "udp", kClientAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "stun", "udp", kClientAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
+}
+
 // Test that when the same network interface is brought down and up, the
 // port allocator session will restart a new allocation sequence if
 // it is not stopped.
@@ -1590,6 +1612,54 @@ TEST_F(BasicPortAllocatorTest, TestEnableSharedUfrag) {
   }
 }
 
+// Test that with a UdpMux, the UDP ports of sessions without STUN or TURN
+// servers share one socket, which is demultiplexed by the session's ufrag, also
+// once a pooled session is taken into use.
+TEST_F(BasicPortAllocatorTest, TestSharedSocketOnUdpMux) {
+  const uint16_t kMuxPort = 3478;
+  AddInterface(kClientAddr);
+  ResetWithNoServersOrNat();
+  rtc::BasicPacketSocketFactory mux_socket_factory(rtc::Thread::Current());
+  UdpMux udp_mux(&mux_socket_factory, kMuxPort);
+  allocator_->set_udp_mux(&udp_mux);
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_SHARED_SOCKET |
+                        PORTALLOCATOR_DISABLE_TCP);
+  int pool_size = 1;
+  allocator_->SetConfiguration(allocator_->stun_servers(),
+                               allocator_->turn_servers(), pool_size,
+                               webrtc::NO_PRUNE);
+  const PortAllocatorSession* peeked_session = allocator_->GetPooledSession();
+  ASSERT_NE(nullptr, peeked_session);
+  EXPECT_EQ_SIMULATED_WAIT(true, peeked_session->CandidatesAllocationDone(),
+                           kDefaultAllocationTimeout, fake_clock);
+  std::unique_ptr<PortAllocatorSession> pooled_session =
+      allocator_->TakePooledSession(kContentName, ICE_CANDIDATE_COMPONENT_RTP,
+                                    kIceUfrag1, kIcePwd1);
+  ASSERT_NE(nullptr, pooled_session);
+  EXPECT_FALSE(udp_mux.CreateSocket(kClientAddr.ipaddr(), kIceUfrag1));
+
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  EXPECT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultAllocationTimeout, fake_clock);
+  EXPECT_FALSE(udp_mux.CreateSocket(kClientAddr.ipaddr(), kIceUfrag0));
+
+  const rtc::SocketAddress kMuxAddr(kClientAddr.ipaddr(), kMuxPort);
+  std::vector<Candidate> candidates = pooled_session->ReadyCandidates();
+  ASSERT_EQ(1U, candidates.size());
+  EXPECT_EQ(kMuxAddr, candidates[0].address());
+  ASSERT_EQ(1U, candidates_.size());
+  EXPECT_EQ(kMuxAddr, candidates_[0].address());
+
+  // The sockets must be destroyed before the mux.
+  session_.reset();
+  pooled_session.reset();
+  allocator_->SetConfiguration(allocator_->stun_servers(),
+                               allocator_->turn_servers(), 0,
+                               webrtc::NO_PRUNE);
+}
+
 // Test that when PORTALLOCATOR_ENABLE_SHARED_SOCKET is enabled only one port
 // is allocated for udp and stun. Also verify there is only one candidate
 // (local) if stun candidate is same as local candidate, which will be the case
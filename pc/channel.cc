@@ -307,12 +307,6 @@ bool BaseChannel::IsReadyToReceiveMedia_w() const {
 }
 
 bool BaseChannel::IsReadyToSendMedia_w() const {
-  // Need to access some state updated on the network thread.
-  return network_thread_->Invoke<bool>(
-      RTC_FROM_HERE, Bind(&BaseChannel::IsReadyToSendMedia_n, this));
-}
-
-bool BaseChannel::IsReadyToSendMedia_n() const {
   // Send outgoing data if we are enabled, have local and remote content,
   // and we have had some form of connectivity.
   return enabled() &&
@@ -505,9 +499,16 @@ void BaseChannel::UpdateRtpHeaderExtensionMap(
   // NOTE: This doesn't take the BUNDLE case in account meaning the RTP header
   // extension maps are not merged when BUNDLE is enabled. This is fine because
   // the ID for MID should be consistent among all the RTP transports.
-  network_thread_->Invoke<void>(RTC_FROM_HERE, [this, &header_extensions] {
-    rtp_transport_->UpdateRtpHeaderExtensionMap(header_extensions);
-  });
+  //
+  // Nothing depends on the result, so post the update instead of blocking the
+  // worker thread on the network thread for every content update.
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, network_thread_, [this, header_extensions] {
+        RTC_DCHECK(network_thread_->IsCurrent());
+        if (rtp_transport_) {
+          rtp_transport_->UpdateRtpHeaderExtensionMap(header_extensions);
+        }
+      });
 }
 
 bool BaseChannel::RegisterRtpDemuxerSink() {
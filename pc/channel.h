@@ -11,6 +11,7 @@
 #ifndef PC_CHANNEL_H_
 #define PC_CHANNEL_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -285,7 +286,6 @@ class BaseChannel : public ChannelInterface,
   bool ConnectToRtpTransport();
   void DisconnectFromRtpTransport();
   void SignalSentPacket_n(const rtc::SentPacket& sent_packet);
-  bool IsReadyToSendMedia_n() const;
 
   // MediaTransportNetworkChangeCallback override.
   void OnNetworkRouteChanged(const rtc::NetworkRoute& network_route) override;
@@ -309,7 +309,9 @@ class BaseChannel : public ChannelInterface,
   std::vector<std::pair<rtc::Socket::Option, int> > socket_options_;
   std::vector<std::pair<rtc::Socket::Option, int> > rtcp_socket_options_;
   bool writable_ = false;
-  bool was_ever_writable_ = false;
+  // Set on the network thread and read on the worker thread, without a
+  // blocking invoke, when the send state is updated.
+  std::atomic<bool> was_ever_writable_{false};
   const bool srtp_required_ = true;
   webrtc::CryptoOptions crypto_options_;
 
@@ -289,6 +289,9 @@ bool DataChannel::Send(const DataBuffer& buffer) {
   }
 
   bool success = SendDataMessage(buffer, true);
+  if (success && observer_) {
+    observer_->OnBufferedAmountChange(buffer.size());
+  }
   if (data_channel_type_ == cricket::DCT_RTP) {
     return success;
   }
@@ -588,6 +591,10 @@ void DataChannel::SendQueuedDataMessages() {
 
   RTC_DCHECK(state_ == kOpen || state_ == kClosing);
 
+  // With many small messages queued, notifying the observer about each of
+  // them would dominate the cost of sending, so it's notified once for all
+  // messages sent here.
+  uint64_t sent_data_size = 0;
   while (!queued_send_data_.Empty()) {
     std::unique_ptr<DataBuffer> buffer = queued_send_data_.PopFront();
     if (!SendDataMessage(*buffer, false)) {
@@ -595,6 +602,10 @@ void DataChannel::SendQueuedDataMessages() {
       queued_send_data_.PushFront(std::move(buffer));
       break;
     }
+    sent_data_size += buffer->size();
+  }
+  if (observer_ && sent_data_size > 0) {
+    observer_->OnBufferedAmountChange(sent_data_size);
   }
 }
 
@@ -631,9 +642,6 @@ bool DataChannel::SendDataMessage(const DataBuffer& buffer,
 
     RTC_DCHECK(buffered_amount_ >= buffer.size());
     buffered_amount_ -= buffer.size();
-    if (observer_ && buffer.size() > 0) {
-      observer_->OnBufferedAmountChange(buffer.size());
-    }
     return true;
   }
 
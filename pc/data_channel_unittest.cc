@@ -35,8 +35,9 @@ class FakeDataChannelObserver : public webrtc::DataChannelObserver {
 
   void OnStateChange() { ++on_state_change_count_; }
 
-  void OnBufferedAmountChange(uint64_t previous_amount) {
+  void OnBufferedAmountChange(uint64_t sent_data_size) {
     ++on_buffered_amount_change_count_;
+    sent_data_size_ += sent_data_size;
   }
 
   void OnMessage(const webrtc::DataBuffer& buffer) { ++messages_received_; }
@@ -55,10 +56,13 @@ class FakeDataChannelObserver : public webrtc::DataChannelObserver {
     return on_buffered_amount_change_count_;
   }
 
+  uint64_t sent_data_size() const { return sent_data_size_; }
+
  private:
   size_t messages_received_;
   size_t on_state_change_count_;
   size_t on_buffered_amount_change_count_;
+  uint64_t sent_data_size_ = 0;
 };
 
 // TODO(deadbeef): The fact that these tests use a fake provider makes them not
@@ -182,11 +186,13 @@ TEST_F(SctpDataChannelTest, BufferedAmountWhenBlocked) {
   EXPECT_EQ(successful_send_count,
             observer_->on_buffered_amount_change_count());
 
+  // The queued packets are reported together.
   provider_->set_send_blocked(false);
-  successful_send_count += number_of_packets;
   EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
-  EXPECT_EQ(successful_send_count,
+  EXPECT_EQ(successful_send_count + 1,
             observer_->on_buffered_amount_change_count());
+  EXPECT_EQ(buffer.data.size() * (number_of_packets + 1),
+            observer_->sent_data_size());
 }
 
 // Tests that the queued data are sent when the channel transitions from blocked
@@ -104,16 +104,14 @@ bool DatagramRtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
                                          int flags) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
 
-  // Assign and increment datagram_id.
-  const DatagramId datagram_id = current_datagram_id_++;
-
   // Send as is (without extracting transport sequence number) for
   // RTP packets if we are not doing datagram => RTCP feedback translation.
   if (disable_datagram_to_rtcp_feeback_translation_) {
     // Even if we are not extracting transport sequence number we need to
     // propagate "Sent" notification for both RTP and RTCP packets. For this
     // reason we need save options.packet_id in packet map.
-    sent_rtp_packet_map_[datagram_id] = SentPacketInfo(options.packet_id);
+    const DatagramId datagram_id =
+        AddSentPacketInfo(SentPacketInfo(options.packet_id));
 
     return SendDatagram(*packet, datagram_id);
   }
@@ -133,7 +131,8 @@ bool DatagramRtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   if (!rtp_packet.GetExtension<TransportSequenceNumber>(
           &transport_senquence_number)) {
     // Save packet info without transport sequence number.
-    sent_rtp_packet_map_[datagram_id] = SentPacketInfo(options.packet_id);
+    const DatagramId datagram_id =
+        AddSentPacketInfo(SentPacketInfo(options.packet_id));
 
     RTC_LOG(LS_VERBOSE)
         << "Sending rtp packet without transport sequence number, packet="
@@ -144,8 +143,8 @@ bool DatagramRtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
 
   // Save packet info with sequence number and ssrc so we could reconstruct
   // RTCP feedback packet when we receive datagram ACK.
-  sent_rtp_packet_map_[datagram_id] = SentPacketInfo(
-      options.packet_id, rtp_packet.Ssrc(), transport_senquence_number);
+  const DatagramId datagram_id = AddSentPacketInfo(SentPacketInfo(
+      options.packet_id, rtp_packet.Ssrc(), transport_senquence_number));
 
   // Since datagram transport provides feedback and timestamps, we do not need
   // to send transport sequence number, so we remove it from RTP packet. Later
@@ -171,19 +170,23 @@ bool DatagramRtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                           int flags) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
 
-  // Assign and increment datagram_id.
-  const DatagramId datagram_id = current_datagram_id_++;
-
   // Even if we are not extracting transport sequence number we need to
   // propagate "Sent" notification for both RTP and RTCP packets. For this
   // reason we need save options.packet_id in packet map.
-  sent_rtp_packet_map_[datagram_id] = SentPacketInfo(options.packet_id);
+  const DatagramId datagram_id =
+      AddSentPacketInfo(SentPacketInfo(options.packet_id));
   return SendDatagram(*packet, datagram_id);
 }
 
 bool DatagramRtpTransport::SendDatagram(rtc::ArrayView<const uint8_t> data,
                                         DatagramId datagram_id) {
-  return datagram_transport_->SendDatagram(data, datagram_id).ok();
+  if (!datagram_transport_->SendDatagram(data, datagram_id).ok()) {
+    // There will be no notifications about this datagram.
+    SentPacketInfo sent_packet_info;
+    GetAndRemoveSentPacketInfo(datagram_id, &sent_packet_info);
+    return false;
+  }
+  return true;
 }
 
 void DatagramRtpTransport::OnDatagramReceived(
@@ -217,8 +220,8 @@ void DatagramRtpTransport::OnDatagramSent(DatagramId datagram_id) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
 
   // Find packet_id and propagate OnPacketSent notification.
-  const auto& it = sent_rtp_packet_map_.find(datagram_id);
-  if (it == sent_rtp_packet_map_.end()) {
+  const SentPacketInfo* sent_packet_info = FindSentPacketInfo(datagram_id);
+  if (!sent_packet_info) {
     RTC_NOTREACHED() << "Did not find sent packet info for sent datagram_id="
                      << datagram_id;
     return;
@@ -226,24 +229,50 @@ void DatagramRtpTransport::OnDatagramSent(DatagramId datagram_id) {
 
   // Also see how DatagramRtpTransport::OnSentPacket handles OnSentPacket
   // notification from ICE in bypass mode.
-  rtc::SentPacket sent_packet(/*packet_id=*/it->second.packet_id,
+  rtc::SentPacket sent_packet(/*packet_id=*/sent_packet_info->packet_id,
                               rtc::TimeMillis());
 
   SignalSentPacket(sent_packet);
 }
 
+DatagramId DatagramRtpTransport::AddSentPacketInfo(
+    const SentPacketInfo& sent_packet_info) {
+  const DatagramId datagram_id =
+      first_sent_datagram_id_ + static_cast<DatagramId>(sent_packets_.size());
+  sent_packets_.push_back(sent_packet_info);
+  return datagram_id;
+}
+
+const DatagramRtpTransport::SentPacketInfo*
+DatagramRtpTransport::FindSentPacketInfo(DatagramId datagram_id) {
+  if (datagram_id < first_sent_datagram_id_ ||
+      datagram_id - first_sent_datagram_id_ >=
+          static_cast<DatagramId>(sent_packets_.size())) {
+    return nullptr;
+  }
+  const absl::optional<SentPacketInfo>& sent_packet_info =
+      sent_packets_[datagram_id - first_sent_datagram_id_];
+  return sent_packet_info ? &*sent_packet_info : nullptr;
+}
+
 bool DatagramRtpTransport::GetAndRemoveSentPacketInfo(
     DatagramId datagram_id,
     SentPacketInfo* sent_packet_info) {
   RTC_CHECK(sent_packet_info != nullptr);
 
-  const auto& it = sent_rtp_packet_map_.find(datagram_id);
-  if (it == sent_rtp_packet_map_.end()) {
+  const SentPacketInfo* found_info = FindSentPacketInfo(datagram_id);
+  if (!found_info) {
     return false;
   }
 
-  *sent_packet_info = it->second;
-  sent_rtp_packet_map_.erase(it);
+  *sent_packet_info = *found_info;
+  sent_packets_[datagram_id - first_sent_datagram_id_].reset();
+  // Datagrams are usually acked in order, so this typically removes the
+  // entry right away.
+  while (!sent_packets_.empty() && !sent_packets_.front()) {
+    sent_packets_.pop_front();
+    ++first_sent_datagram_id_;
+  }
   return true;
 }
 
@@ -11,7 +11,7 @@
 #ifndef PC_DATAGRAM_RTP_TRANSPORT_H_
 #define PC_DATAGRAM_RTP_TRANSPORT_H_
 
-#include <map>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -125,7 +125,15 @@ class DatagramRtpTransport : public RtpTransportInternal,
     int64_t packet_id = 0;
   };
 
-  // Finds SentPacketInfo for given |datagram_id| and removes map entry.
+  // Assigns the next datagram id to a packet about to be sent and saves its
+  // info.
+  webrtc::DatagramId AddSentPacketInfo(const SentPacketInfo& sent_packet_info);
+
+  // Finds SentPacketInfo for given |datagram_id|. Returns nullptr if it was
+  // not found.
+  const SentPacketInfo* FindSentPacketInfo(webrtc::DatagramId datagram_id);
+
+  // Finds SentPacketInfo for given |datagram_id| and removes it.
   // Returns false if entry was not found.
   bool GetAndRemoveSentPacketInfo(webrtc::DatagramId datagram_id,
                                   SentPacketInfo* sent_packet_info);
@@ -149,12 +157,11 @@ class DatagramRtpTransport : public RtpTransportInternal,
   webrtc::RtpHeaderExtensionMap rtp_header_extension_map_;
 
   // Keeps information about sent RTP packet until they are Acked or Lost.
-  std::map<webrtc::DatagramId, SentPacketInfo> sent_rtp_packet_map_;
-
-  // Current datagram_id, incremented after each sent RTP packets.
-  // Datagram id is passed to datagram transport when we send datagram and we
-  // get it back in notifications about Sent, Acked and Lost datagrams.
-  int64_t current_datagram_id_ = 0;
+  // Datagram ids are assigned consecutively, so the info of datagram id
+  // |first_sent_datagram_id_| + i is at index i. Entries of datagrams that
+  // were acked or lost are reset, and removed once they reach the front.
+  std::deque<absl::optional<SentPacketInfo>> sent_packets_;
+  webrtc::DatagramId first_sent_datagram_id_ = 0;
 
   // TODO(sukhanov): Previous nonzero timestamp is required for workaround for
   // zero timestamps received, which sometimes are received from datagram
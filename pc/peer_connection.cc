@@ -949,16 +949,34 @@ PeerConnection::~PeerConnection() {
 void PeerConnection::DestroyAllChannels() {
   // Destroy video channels first since they may have a pointer to a voice
   // channel.
+  std::vector<cricket::ChannelInterface*> channels;
   for (const auto& transceiver : transceivers_) {
     if (transceiver->media_type() == cricket::MEDIA_TYPE_VIDEO) {
-      DestroyTransceiverChannel(transceiver);
+      cricket::ChannelInterface* channel = transceiver->internal()->channel();
+      if (channel) {
+        transceiver->internal()->SetChannel(nullptr);
+        channels.push_back(channel);
+      }
     }
   }
   for (const auto& transceiver : transceivers_) {
     if (transceiver->media_type() == cricket::MEDIA_TYPE_AUDIO) {
-      DestroyTransceiverChannel(transceiver);
+      cricket::ChannelInterface* channel = transceiver->internal()->channel();
+      if (channel) {
+        transceiver->internal()->SetChannel(nullptr);
+        channels.push_back(channel);
+      }
     }
   }
+  // The channels are destroyed on the worker thread; do that with a single
+  // invocation rather than one per transceiver.
+  if (!channels.empty()) {
+    worker_thread()->Invoke<void>(RTC_FROM_HERE, [this, &channels] {
+      for (cricket::ChannelInterface* channel : channels) {
+        DestroyChannelInterface(channel);
+      }
+    });
+  }
   DestroyDataChannel();
 }
 
@@ -5918,6 +5936,11 @@ RTCError PeerConnection::PushdownMediaDescription(
   RTC_DCHECK(sdesc);
 
   // Push down the new SDP media section for each audio/video transceiver.
+  // Channels apply their content on the worker thread, so collect them first
+  // and apply all of them with a single invocation instead of one per channel.
+  std::vector<std::pair<cricket::ChannelInterface*,
+                        const MediaContentDescription*>>
+      channels;
   for (const auto& transceiver : transceivers_) {
     const ContentInfo* content_info =
         FindMediaSectionForTransceiver(transceiver, sdesc);
@@ -5930,33 +5953,35 @@ RTCError PeerConnection::PushdownMediaDescription(
     if (!content_desc) {
       continue;
     }
-    std::string error;
-    bool success = (source == cricket::CS_LOCAL)
-                       ? channel->SetLocalContent(content_desc, type, &error)
-                       : channel->SetRemoteContent(content_desc, type, &error);
-    if (!success) {
-      LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
-    }
+    channels.emplace_back(channel, content_desc);
   }
 
   // If using the RtpDataChannel, push down the new SDP section for it too.
   if (rtp_data_channel_) {
     const ContentInfo* data_content =
         cricket::GetFirstDataContent(sdesc->description());
-    if (data_content && !data_content->rejected) {
-      const MediaContentDescription* data_desc =
-          data_content->media_description();
-      if (data_desc) {
-        std::string error;
-        bool success =
-            (source == cricket::CS_LOCAL)
-                ? rtp_data_channel_->SetLocalContent(data_desc, type, &error)
-                : rtp_data_channel_->SetRemoteContent(data_desc, type, &error);
-        if (!success) {
-          LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
-        }
+    if (data_content && !data_content->rejected &&
+        data_content->media_description()) {
+      channels.emplace_back(rtp_data_channel_,
+                            data_content->media_description());
+    }
+  }
+
+  RTCError error = worker_thread()->Invoke<RTCError>(RTC_FROM_HERE, [&] {
+    for (const auto& entry : channels) {
+      std::string error;
+      bool success =
+          (source == cricket::CS_LOCAL)
+              ? entry.first->SetLocalContent(entry.second, type, &error)
+              : entry.first->SetRemoteContent(entry.second, type, &error);
+      if (!success) {
+        LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
       }
     }
+    return RTCError::OK();
+  });
+  if (!error.ok()) {
+    return error;
   }
 
   // Need complete offer/answer with an SCTP m= section before starting SCTP,
@@ -6433,16 +6458,27 @@ void PeerConnection::OnTransportControllerDtlsHandshakeError(
 }
 
 void PeerConnection::EnableSending() {
+  std::vector<cricket::ChannelInterface*> channels;
   for (const auto& transceiver : transceivers_) {
     cricket::ChannelInterface* channel = transceiver->internal()->channel();
     if (channel && !channel->enabled()) {
-      channel->Enable(true);
+      channels.push_back(channel);
     }
   }
 
   if (rtp_data_channel_ && !rtp_data_channel_->enabled()) {
-    rtp_data_channel_->Enable(true);
+    channels.push_back(rtp_data_channel_);
+  }
+
+  if (channels.empty()) {
+    return;
   }
+  // Enable all channels with a single hop to the worker thread.
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [&channels] {
+    for (cricket::ChannelInterface* channel : channels) {
+      channel->Enable(true);
+    }
+  });
 }
 
 // Returns the media index for a local ice candidate given the content name.
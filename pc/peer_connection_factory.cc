@@ -39,9 +39,12 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
@@ -84,6 +87,7 @@ PeerConnectionFactory::PeerConnectionFactory(
   if (!network_thread_) {
     owned_network_thread_ = rtc::Thread::CreateWithSocketServer();
     owned_network_thread_->SetName("pc_network_thread", nullptr);
+    owned_network_thread_->SetPlacement(dependencies.thread_placement);
     owned_network_thread_->Start();
     network_thread_ = owned_network_thread_.get();
   }
@@ -91,6 +95,7 @@ PeerConnectionFactory::PeerConnectionFactory(
   if (!worker_thread_) {
     owned_worker_thread_ = rtc::Thread::Create();
     owned_worker_thread_->SetName("pc_worker_thread", nullptr);
+    owned_worker_thread_->SetPlacement(dependencies.thread_placement);
     owned_worker_thread_->Start();
     worker_thread_ = owned_worker_thread_.get();
   }
@@ -121,6 +126,7 @@ PeerConnectionFactory::~PeerConnectionFactory() {
 
 bool PeerConnectionFactory::Initialize() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
+  const int64_t start_time_ms = rtc::TimeMillis();
   rtc::InitRandom(rtc::Time32());
 
   default_network_manager_.reset(new rtc::BasicNetworkManager());
@@ -143,11 +149,31 @@ bool PeerConnectionFactory::Initialize() {
     return false;
   }
 
+  // Most of this is the initialization of the media engine on the worker
+  // thread.
+  const int64_t initialize_time_ms = rtc::TimeMillis() - start_time_ms;
+  RTC_LOG(LS_INFO) << "PeerConnectionFactory initialized in "
+                   << initialize_time_ms << " ms.";
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.PeerConnectionFactory.InitializeTimeMs",
+                             initialize_time_ms);
   return true;
 }
 
 void PeerConnectionFactory::SetOptions(const Options& options) {
   options_ = options;
+  if (options_.certificate_pool_size <= 0) {
+    certificate_pool_ = nullptr;
+  } else if (!certificate_pool_ ||
+             certificate_pool_->size() !=
+                 static_cast<size_t>(options_.certificate_pool_size) ||
+             certificate_pool_->max_age_ms() !=
+                 options_.certificate_pool_max_age_ms) {
+    certificate_pool_ = rtc::RTCCertificatePool::Create(
+        options_.certificate_pool_size, options_.certificate_pool_max_age_ms);
+    // Have a certificate of the default key type ready for the first
+    // PeerConnection.
+    certificate_pool_->Prefill(rtc::KeyParams());
+  }
 }
 
 RtpCapabilities PeerConnectionFactory::GetRtpSenderCapabilities(
@@ -248,8 +274,8 @@ PeerConnectionFactory::CreatePeerConnection(
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
-        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
-                                                       network_thread_);
+        std::make_unique<rtc::RTCCertificateGenerator>(
+            signaling_thread_, network_thread_, certificate_pool_);
   }
   if (!dependencies.allocator) {
     rtc::PacketSocketFactory* packet_socket_factory;
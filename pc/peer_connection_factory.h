@@ -115,6 +115,8 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<rtc::Thread> owned_worker_thread_;
   const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
   Options options_;
+  // Set if |options_| enable certificate pooling.
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_;
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
   std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
   std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
@@ -256,6 +256,19 @@ TEST_F(ProxyTest, WorkerMethod2) {
   EXPECT_EQ("Method2", fake_proxy_->Method2(arg1, arg2));
 }
 
+TEST_F(ProxyTest, CountsBlockingCalls) {
+  EXPECT_CALL(*fake_, Method0()).WillOnce(Return("Method0"));
+  EXPECT_CALL(*fake_, Method1(_)).WillOnce(Return("Method1"));
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    rtc::Thread::ScopedCountBlockingCalls counter(nullptr);
+    // On the signaling thread, only the call to the worker thread blocks.
+    fake_proxy_->Method0();
+    fake_proxy_->Method1("arg1");
+    EXPECT_EQ(1u, counter.GetBlockingCallCount());
+    EXPECT_EQ(1u, counter.GetCouldBeBlockingCallCount());
+  });
+}
+
 // Interface for testing OWNED_PROXY_MAP.
 class FooInterface {
  public:
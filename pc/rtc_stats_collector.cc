@@ -998,12 +998,15 @@ void RTCStatsCollector::GetStatsReportInternal(
     // Prepare |transport_names_| for use in
     // |ProducePartialResultsOnNetworkThread|.
     transport_names_ = PrepareTransportNames_s();
+    requested_stats_types_ = stats_type_filter_;
 
     // Prepare |call_stats_| here since GetCallStats() will hop to the worker
-    // thread.
+    // thread. It is only used for the candidate pair stats.
     // TODO(holmer): To avoid the hop we could move BWE and BWE stats to the
     // network thread, where it more naturally belongs.
-    call_stats_ = pc_->GetCallStats();
+    call_stats_ = ShouldProduceStats(RTCIceCandidatePairStats::kType)
+                      ? pc_->GetCallStats()
+                      : Call::Stats();
 
     // Don't touch |network_report_| on the signaling thread until
     // ProducePartialResultsOnNetworkThread() has signaled the
@@ -1022,6 +1025,13 @@ void RTCStatsCollector::ClearCachedStatsReport() {
   cached_report_ = nullptr;
 }
 
+void RTCStatsCollector::SetStatsTypeFilter(
+    std::set<std::string> stats_types) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  stats_type_filter_ = std::move(stats_types);
+  cached_report_ = nullptr;
+}
+
 void RTCStatsCollector::WaitForPendingRequest() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   // If a request is pending, blocks until the |network_report_event_| is
@@ -1049,11 +1059,18 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThreadImpl(
     int64_t timestamp_us,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  ProduceDataChannelStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
-  ProduceMediaSourceStats_s(timestamp_us, partial_report);
-  ProducePeerConnectionStats_s(timestamp_us, partial_report);
+  if (ShouldProduceStats(RTCDataChannelStats::kType))
+    ProduceDataChannelStats_s(timestamp_us, partial_report);
+  if (ShouldProduceStats(RTCMediaStreamStats::kType))
+    ProduceMediaStreamStats_s(timestamp_us, partial_report);
+  if (ShouldProduceStats(RTCMediaStreamTrackStats::kType))
+    ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
+  if (ShouldProduceStats(RTCAudioSourceStats::kType) ||
+      ShouldProduceStats(RTCVideoSourceStats::kType)) {
+    ProduceMediaSourceStats_s(timestamp_us, partial_report);
+  }
+  if (ShouldProduceStats(RTCPeerConnectionStats::kType))
+    ProducePeerConnectionStats_s(timestamp_us, partial_report);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
@@ -1063,8 +1080,16 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
   // |network_report_event_| is reset before this method is invoked.
   network_report_ = RTCStatsReport::Create(timestamp_us);
 
-  std::map<std::string, cricket::TransportStats> transport_stats_by_name =
-      pc_->GetTransportStatsByNames(transport_names_);
+  // Transport stats are only needed for the certificate, candidate and
+  // transport stats, and are expensive to gather.
+  std::map<std::string, cricket::TransportStats> transport_stats_by_name;
+  if (ShouldProduceStats(RTCCertificateStats::kType) ||
+      ShouldProduceStats(RTCIceCandidatePairStats::kType) ||
+      ShouldProduceStats(RTCLocalIceCandidateStats::kType) ||
+      ShouldProduceStats(RTCRemoteIceCandidateStats::kType) ||
+      ShouldProduceStats(RTCTransportStats::kType)) {
+    transport_stats_by_name = pc_->GetTransportStatsByNames(transport_names_);
+  }
   std::map<std::string, CertificateStatsPair> transport_cert_stats =
       PrepareTransportCertificateStats_n(transport_stats_by_name);
 
@@ -1086,14 +1111,28 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThreadImpl(
     const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(network_thread_->IsCurrent());
-  ProduceCertificateStats_n(timestamp_us, transport_cert_stats, partial_report);
-  ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
-  ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
-                                    call_stats_, partial_report);
-  ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
-                          transport_cert_stats, partial_report);
-  ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
-                          partial_report);
+  if (ShouldProduceStats(RTCCertificateStats::kType)) {
+    ProduceCertificateStats_n(timestamp_us, transport_cert_stats,
+                              partial_report);
+  }
+  if (ShouldProduceStats(RTCCodecStats::kType))
+    ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
+  if (ShouldProduceStats(RTCIceCandidatePairStats::kType) ||
+      ShouldProduceStats(RTCLocalIceCandidateStats::kType) ||
+      ShouldProduceStats(RTCRemoteIceCandidateStats::kType)) {
+    ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
+                                      call_stats_, partial_report);
+  }
+  if (ShouldProduceStats(RTCTransportStats::kType)) {
+    ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
+                            transport_cert_stats, partial_report);
+  }
+  if (ShouldProduceStats(RTCInboundRTPStreamStats::kType) ||
+      ShouldProduceStats(RTCOutboundRTPStreamStats::kType) ||
+      ShouldProduceStats(RTCRemoteInboundRtpStreamStats::kType)) {
+    ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
+                            partial_report);
+  }
 }
 
 void RTCStatsCollector::MergeNetworkReport_s() {
@@ -1116,6 +1155,7 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   RTC_DCHECK(partial_report_);
   partial_report_->TakeMembersFrom(network_report_);
   network_report_ = nullptr;
+  ApplyStatsTypeFilter(partial_report_.get());
   --num_pending_partial_reports_;
   // |network_report_| is currently the only partial report collected
   // asynchronously, so |num_pending_partial_reports_| must now be 0 and we are
@@ -1137,6 +1177,25 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   DeliverCachedReport(cached_report_, std::move(requests));
 }
 
+bool RTCStatsCollector::ShouldProduceStats(const char* type) const {
+  return requested_stats_types_.empty() ||
+         requested_stats_types_.find(type) != requested_stats_types_.end();
+}
+
+void RTCStatsCollector::ApplyStatsTypeFilter(RTCStatsReport* report) const {
+  if (requested_stats_types_.empty())
+    return;
+  // Some producers create stats of several types, e.g. candidate pairs and
+  // candidates.
+  std::vector<std::string> ids_to_remove;
+  for (const RTCStats& stats : *report) {
+    if (!ShouldProduceStats(stats.type()))
+      ids_to_remove.push_back(stats.id());
+  }
+  for (const std::string& id : ids_to_remove)
+    report->Take(id);
+}
+
 void RTCStatsCollector::DeliverCachedReport(
     rtc::scoped_refptr<const RTCStatsReport> cached_report,
     std::vector<RTCStatsCollector::RequestInfo> requests) {
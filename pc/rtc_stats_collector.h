@@ -69,6 +69,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
 
+  // Restricts subsequent reports to stats of the given types, e.g.
+  // RTCOutboundRTPStreamStats::kType. Stats of other types are not produced,
+  // so members referencing them (e.g. |codec_id|) may refer to stats that are
+  // not in the report. Collection that is only needed for the excluded types,
+  // such as gathering transport stats on the network thread, is skipped. An
+  // empty set, the default, collects all stats. Clears the cached report.
+  void SetStatsTypeFilter(std::set<std::string> stats_types);
+
   // If there is a |GetStatsReport| requests in-flight, waits until it has been
   // completed. Must be called on the signaling thread.
   void WaitForPendingRequest();
@@ -227,6 +235,11 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
 
   // Slots for signals (sigslot) that are wired up to |pc_|.
   void OnDataChannelCreated(DataChannel* channel);
+  // Whether stats of |type| are to be produced by the current request.
+  bool ShouldProduceStats(const char* type) const;
+  // Removes stats of types that were not requested from |report|.
+  void ApplyStatsTypeFilter(RTCStatsReport* report) const;
+
   // Slots for signals (sigslot) that are wired up to |channel|.
   void OnDataChannelOpened(DataChannel* channel);
   void OnDataChannelClosed(DataChannel* channel);
@@ -260,9 +273,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // set/reset we know there are no pending stats requests in progress.
   std::vector<RtpTransceiverStatsInfo> transceiver_stats_infos_;
   std::set<std::string> transport_names_;
+  std::set<std::string> requested_stats_types_;
 
   Call::Stats call_stats_;
 
+  // The types set with |SetStatsTypeFilter|. Copied to
+  // |requested_stats_types_| when a request starts.
+  std::set<std::string> stats_type_filter_;
+
   // A timestamp, in microseconds, that is based on a timer that is
   // monotonically increasing. That is, even if the system clock is modified the
   // difference between the timer and this timestamp is how fresh the cached
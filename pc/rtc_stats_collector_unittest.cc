@@ -1354,6 +1354,25 @@ TEST_F(RTCStatsCollectorTest, CollectRTCIceCandidatePairStats) {
                 ->cast_to<RTCRemoteIceCandidateStats>());
 }
 
+TEST_F(RTCStatsCollectorTest, StatsTypeFilter) {
+  pc_->AddSctpDataChannel(new MockDataChannel(0, "MockDataChannel0",
+                                              DataChannelInterface::kConnecting,
+                                              "udp", 1, 2, 3, 4));
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  EXPECT_TRUE(report->Get("RTCPeerConnection"));
+  EXPECT_EQ(1u, report->GetStatsOfType<RTCDataChannelStats>().size());
+
+  stats_->stats_collector()->SetStatsTypeFilter({RTCDataChannelStats::kType});
+  report = stats_->GetStatsReport();
+  EXPECT_FALSE(report->Get("RTCPeerConnection"));
+  EXPECT_EQ(1u, report->GetStatsOfType<RTCDataChannelStats>().size());
+  EXPECT_EQ(1u, report->size());
+
+  stats_->stats_collector()->SetStatsTypeFilter({});
+  report = stats_->GetStatsReport();
+  EXPECT_TRUE(report->Get("RTCPeerConnection"));
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCPeerConnectionStats) {
   {
     rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
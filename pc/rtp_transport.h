@@ -16,6 +16,7 @@
 #include "call/rtp_demuxer.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "pc/rtp_transport_internal.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
 namespace rtc {
@@ -126,6 +127,9 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  // Recycles the storage of received packets once they've been consumed.
+  rtc::CopyOnWriteBufferPool receive_buffer_pool_;
 };
 
 }  // namespace webrtc
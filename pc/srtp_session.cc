@@ -10,6 +10,8 @@
 
 #include "pc/srtp_session.h"
 
+#include <atomic>
+
 #include "absl/base/attributes.h"
 #include "media/base/rtp_utils.h"
 #include "pc/external_hmac.h"
@@ -363,15 +365,25 @@ bool SrtpSession::UpdateKey(int type,
   return DoSetKey(type, cs, key, len, extension_ids);
 }
 
-ABSL_CONST_INIT int g_libsrtp_usage_count = 0;
+// Only changed from or to zero while holding |g_libsrtp_lock|, so that
+// sessions created while libsrtp is already initialized need not take it.
+ABSL_CONST_INIT std::atomic<int> g_libsrtp_usage_count(0);
 ABSL_CONST_INIT rtc::GlobalLock g_libsrtp_lock;
 
 // static
 bool SrtpSession::IncrementLibsrtpUsageCountAndMaybeInit() {
+  int usage_count = g_libsrtp_usage_count.load();
+  while (usage_count > 0) {
+    if (g_libsrtp_usage_count.compare_exchange_weak(usage_count,
+                                                    usage_count + 1)) {
+      return true;
+    }
+  }
+
   rtc::GlobalLockScope ls(&g_libsrtp_lock);
 
-  RTC_DCHECK_GE(g_libsrtp_usage_count, 0);
-  if (g_libsrtp_usage_count == 0) {
+  RTC_DCHECK_GE(g_libsrtp_usage_count.load(), 0);
+  if (g_libsrtp_usage_count.load() == 0) {
     int err;
     err = srtp_init();
     if (err != srtp_err_status_ok) {
@@ -397,9 +409,17 @@ bool SrtpSession::IncrementLibsrtpUsageCountAndMaybeInit() {
 
 // static
 void SrtpSession::DecrementLibsrtpUsageCountAndMaybeDeinit() {
+  int usage_count = g_libsrtp_usage_count.load();
+  while (usage_count > 1) {
+    if (g_libsrtp_usage_count.compare_exchange_weak(usage_count,
+                                                    usage_count - 1)) {
+      return;
+    }
+  }
+
   rtc::GlobalLockScope ls(&g_libsrtp_lock);
 
-  RTC_DCHECK_GE(g_libsrtp_usage_count, 1);
+  RTC_DCHECK_GE(g_libsrtp_usage_count.load(), 1);
   if (--g_libsrtp_usage_count == 0) {
     int err = srtp_shutdown();
     if (err) {
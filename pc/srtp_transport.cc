@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,6 +34,15 @@
 
 namespace webrtc {
 
+namespace {
+
+// Upper bound on the number of received packets waiting to be delivered
+// while parallel unprotection is enabled. Packets arriving beyond it are
+// dropped, since the workers are not keeping up anyway.
+constexpr size_t kMaxPendingPackets = 1024;
+
+}  // namespace
+
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled)
     : RtpTransport(rtcp_mux_enabled) {}
 
@@ -206,25 +216,15 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
         << "Inactive SRTP transport received an RTP packet. Drop it.";
     return;
   }
+  if (!unprotect_workers_.empty()) {
+    UnprotectRtpInParallel(std::move(packet), packet_time_us);
+    return;
+  }
   TRACE_EVENT0("webrtc", "SRTP Decode");
   char* data = packet.data<char>();
   int len = rtc::checked_cast<int>(packet.size());
   if (!UnprotectRtp(data, len, &len)) {
-    int seq_num = -1;
-    uint32_t ssrc = 0;
-    cricket::GetRtpSeqNum(data, len, &seq_num);
-    cricket::GetRtpSsrc(data, len, &ssrc);
-
-    // Limit the error logging to avoid excessive logs when there are lots of
-    // bad packets.
-    const int kFailureLogThrottleCount = 100;
-    if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
-      RTC_LOG(LS_ERROR) << "Failed to unprotect RTP packet: size=" << len
-                        << ", seqnum=" << seq_num << ", SSRC=" << ssrc
-                        << ", previous failure count: "
-                        << decryption_failure_count_;
-    }
-    ++decryption_failure_count_;
+    LogRtpUnprotectFailure(data, len);
     return;
   }
   packet.SetSize(len);
@@ -249,9 +249,166 @@ void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
     return;
   }
   packet.SetSize(len);
+  if (!pending_packets_.empty()) {
+    PendingPacket pending;
+    pending.rtcp = true;
+    pending.done = true;
+    pending.packet = std::move(packet);
+    pending.packet_time_us = packet_time_us;
+    pending_packets_.push_back(std::move(pending));
+    return;
+  }
   SignalRtcpPacketReceived(&packet, packet_time_us);
 }
 
+void SrtpTransport::LogRtpUnprotectFailure(const char* data, size_t len) {
+  int seq_num = -1;
+  uint32_t ssrc = 0;
+  cricket::GetRtpSeqNum(data, len, &seq_num);
+  cricket::GetRtpSsrc(data, len, &ssrc);
+
+  // Limit the error logging to avoid excessive logs when there are lots of
+  // bad packets.
+  const int kFailureLogThrottleCount = 100;
+  if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
+    RTC_LOG(LS_ERROR) << "Failed to unprotect RTP packet: size=" << len
+                      << ", seqnum=" << seq_num << ", SSRC=" << ssrc
+                      << ", previous failure count: "
+                      << decryption_failure_count_;
+  }
+  ++decryption_failure_count_;
+}
+
+void SrtpTransport::EnableParallelUnprotect(
+    TaskQueueFactory* task_queue_factory,
+    int num_workers) {
+  RTC_DCHECK(task_queue_factory);
+  RTC_DCHECK_GT(num_workers, 0);
+  RTC_DCHECK(!recv_session_);
+  RTC_DCHECK(unprotect_workers_.empty());
+  network_thread_ = rtc::Thread::Current();
+  RTC_DCHECK(network_thread_);
+  for (int i = 0; i < num_workers; ++i) {
+    auto worker = std::make_unique<UnprotectWorker>();
+    worker->queue =
+        std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
+            "SrtpUnprotect", TaskQueueFactory::Priority::HIGH));
+    unprotect_workers_.push_back(std::move(worker));
+  }
+}
+
+void SrtpTransport::UnprotectRtpInParallel(rtc::CopyOnWriteBuffer packet,
+                                           int64_t packet_time_us) {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  if (pending_packets_.size() >= kMaxPendingPackets) {
+    RTC_LOG(LS_WARNING) << "Too many RTP packets waiting to be unprotected. "
+                           "Drop it.";
+    return;
+  }
+  uint32_t ssrc = 0;
+  cricket::GetRtpSsrc(packet.cdata(), packet.size(), &ssrc);
+  UnprotectWorker* worker =
+      unprotect_workers_[ssrc % unprotect_workers_.size()].get();
+
+  const uint64_t generation = unprotect_generation_;
+  const uint64_t index = first_pending_index_ + pending_packets_.size();
+  PendingPacket pending;
+  pending.packet_time_us = packet_time_us;
+  pending_packets_.push_back(std::move(pending));
+
+  worker->queue->PostTask([this, worker, generation, index,
+                           packet = std::move(packet)]() mutable {
+    TRACE_EVENT0("webrtc", "SRTP Decode");
+    int len = rtc::checked_cast<int>(packet.size());
+    bool unprotected =
+        worker->session &&
+        worker->session->UnprotectRtp(packet.data<char>(), len, &len);
+    if (unprotected) {
+      packet.SetSize(len);
+    }
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, network_thread_,
+        [this, generation, index, unprotected,
+         packet = std::move(packet)]() mutable {
+          OnRtpPacketUnprotected(generation, index, unprotected,
+                                 std::move(packet));
+        });
+  });
+}
+
+void SrtpTransport::OnRtpPacketUnprotected(uint64_t generation,
+                                           uint64_t index,
+                                           bool unprotected,
+                                           rtc::CopyOnWriteBuffer packet) {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  if (generation != unprotect_generation_) {
+    return;
+  }
+  RTC_DCHECK_GE(index, first_pending_index_);
+  RTC_DCHECK_LT(index - first_pending_index_, pending_packets_.size());
+  PendingPacket& pending = pending_packets_[index - first_pending_index_];
+  pending.done = true;
+  pending.unprotected = unprotected;
+  pending.packet = std::move(packet);
+  DeliverPendingPackets();
+}
+
+void SrtpTransport::DeliverPendingPackets() {
+  while (!pending_packets_.empty() && pending_packets_.front().done) {
+    PendingPacket pending = std::move(pending_packets_.front());
+    pending_packets_.pop_front();
+    ++first_pending_index_;
+    if (pending.rtcp) {
+      SignalRtcpPacketReceived(&pending.packet, pending.packet_time_us);
+    } else if (pending.unprotected) {
+      DemuxPacket(std::move(pending.packet), pending.packet_time_us);
+    } else {
+      LogRtpUnprotectFailure(pending.packet.cdata<char>(),
+                             pending.packet.size());
+    }
+  }
+}
+
+void SrtpTransport::SetUnprotectWorkerKeys(
+    int cs,
+    const uint8_t* key,
+    int key_len,
+    const std::vector<int>& extension_ids) {
+  // The keys are applied on the worker queues, so packets posted before this
+  // call are still unprotected with the previous keys, as they would be when
+  // unprotecting on the network thread.
+  for (auto& worker_ptr : unprotect_workers_) {
+    UnprotectWorker* worker = worker_ptr.get();
+    worker->queue->PostTask(
+        [worker, cs, key_copy = rtc::ZeroOnFreeBuffer<uint8_t>(key, key_len),
+         extension_ids]() {
+          bool ret;
+          if (!worker->session) {
+            worker->session = std::make_unique<cricket::SrtpSession>();
+            ret = worker->session->SetRecv(cs, key_copy.data(),
+                                           key_copy.size(), extension_ids);
+          } else {
+            ret = worker->session->UpdateRecv(cs, key_copy.data(),
+                                              key_copy.size(), extension_ids);
+          }
+          if (!ret) {
+            RTC_LOG(LS_ERROR) << "Failed to set SRTP keys on unprotect worker.";
+            worker->session = nullptr;
+          }
+        });
+  }
+}
+
+void SrtpTransport::ResetUnprotectWorkers() {
+  ++unprotect_generation_;
+  first_pending_index_ += pending_packets_.size();
+  pending_packets_.clear();
+  for (auto& worker_ptr : unprotect_workers_) {
+    UnprotectWorker* worker = worker_ptr.get();
+    worker->queue->PostTask([worker]() { worker->session = nullptr; });
+  }
+}
+
 void SrtpTransport::OnNetworkRouteChanged(
     absl::optional<rtc::NetworkRoute> network_route) {
   // Only append the SRTP overhead when there is a selected network route.
@@ -307,6 +464,11 @@ bool SrtpTransport::SetRtpParams(int send_cs,
     return false;
   }
 
+  if (!unprotect_workers_.empty()) {
+    SetUnprotectWorkerKeys(recv_cs, recv_key, recv_key_len,
+                           recv_extension_ids);
+  }
+
   RTC_LOG(LS_INFO) << "SRTP " << (new_sessions ? "activated" : "updated")
                    << " with negotiated parameters: send cipher_suite "
                    << send_cs << " recv cipher_suite " << recv_cs;
@@ -361,6 +523,9 @@ void SrtpTransport::ResetParams() {
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
   recv_rtcp_session_ = nullptr;
+  if (!unprotect_workers_.empty()) {
+    ResetUnprotectWorkers();
+  }
   MaybeUpdateWritableState();
   RTC_LOG(LS_INFO) << "The params in SRTP transport are reset.";
 }
@@ -14,6 +14,7 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,13 +22,17 @@
 #include "absl/types/optional.h"
 #include "api/crypto_params.h"
 #include "api/rtc_error.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport.h"
 #include "pc/srtp_session.h"
+#include "rtc_base/async_invoker.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network_route.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread.h"
 
 namespace webrtc {
 
@@ -84,6 +89,18 @@ class SrtpTransport : public RtpTransport {
 
   void ResetParams();
 
+  // Enables unprotecting incoming RTP packets on |num_workers| task queues
+  // created by |task_queue_factory|. Packets are assigned to a worker by SSRC,
+  // so each stream is handled by a single SRTP session that keeps its own
+  // replay window, and are delivered on the calling (network) thread in the
+  // order they were received. This method is only valid before the RTP params
+  // have been set.
+  void EnableParallelUnprotect(TaskQueueFactory* task_queue_factory,
+                               int num_workers);
+  bool IsParallelUnprotectEnabled() const {
+    return !unprotect_workers_.empty();
+  }
+
   // If external auth is enabled, SRTP will write a dummy auth tag that then
   // later must get replaced before the packet is sent out. Only supported for
   // non-GCM cipher suites and can be checked through "IsExternalAuthActive"
@@ -143,6 +160,22 @@ class SrtpTransport : public RtpTransport {
 
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Posts |packet| to the worker owning its SSRC and queues a slot for it so
+  // that it is delivered in order once unprotected.
+  void UnprotectRtpInParallel(rtc::CopyOnWriteBuffer packet,
+                              int64_t packet_time_us);
+  void OnRtpPacketUnprotected(uint64_t generation,
+                              uint64_t index,
+                              bool unprotected,
+                              rtc::CopyOnWriteBuffer packet);
+  void DeliverPendingPackets();
+  void SetUnprotectWorkerKeys(int cs,
+                              const uint8_t* key,
+                              int key_len,
+                              const std::vector<int>& extension_ids);
+  void ResetUnprotectWorkers();
+  void LogRtpUnprotectFailure(const char* data, size_t len);
+
   bool MaybeSetKeyParams();
   bool ParseKeyParams(const std::string& key_params, uint8_t* key, size_t len);
 
@@ -167,6 +200,36 @@ class SrtpTransport : public RtpTransport {
   int rtp_abs_sendtime_extn_id_ = -1;
 
   int decryption_failure_count_ = 0;
+
+  // A received packet waiting to be delivered. RTCP packets are unprotected
+  // on the network thread but are queued behind RTP packets still in flight
+  // to preserve the arrival order.
+  struct PendingPacket {
+    bool rtcp = false;
+    bool done = false;
+    bool unprotected = false;
+    rtc::CopyOnWriteBuffer packet;
+    int64_t packet_time_us = -1;
+  };
+
+  // |session| is only accessed on |queue|. The queue is declared last so
+  // that it is stopped before the session is destroyed.
+  struct UnprotectWorker {
+    std::unique_ptr<cricket::SrtpSession> session;
+    std::unique_ptr<rtc::TaskQueue> queue;
+  };
+
+  rtc::Thread* network_thread_ = nullptr;
+  std::deque<PendingPacket> pending_packets_;
+  // Index of the packet at the front of |pending_packets_|.
+  uint64_t first_pending_index_ = 0;
+  // Incremented when the receive keys are reset so that results from packets
+  // that were in flight at the time are discarded.
+  uint64_t unprotect_generation_ = 0;
+  rtc::AsyncInvoker invoker_;
+  // Declared after |invoker_| so the workers are stopped before the invoker
+  // they post results through is destroyed.
+  std::vector<std::unique_ptr<UnprotectWorker>> unprotect_workers_;
 };
 
 }  // namespace webrtc
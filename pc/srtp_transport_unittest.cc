@@ -12,10 +12,13 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
+#include "api/task_queue/default_task_queue_factory.h"
 #include "call/rtp_demuxer.h"
 #include "media/base/fake_rtp.h"
 #include "p2p/base/dtls_transport_internal.h"
@@ -25,6 +28,7 @@
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/gunit.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "test/gtest.h"
@@ -43,6 +47,22 @@ static const uint8_t kTestKeyGcm256_1[] =
 static const uint8_t kTestKeyGcm256_2[] =
     "rqponmlkjihgfedcbaZYXWVUTSRQPONMLKJIHGFEDCBA";
 static const int kTestKeyGcm256Len = 44;  // 256 bits key + 96 bits salt.
+static const int kTimeoutMs = 5000;
+
+// Records the SSRC and sequence number of every received RTP packet.
+class RecordingRtpSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    received_.emplace_back(packet.Ssrc(), packet.SequenceNumber());
+  }
+
+  const std::vector<std::pair<uint32_t, uint16_t>>& received() const {
+    return received_;
+  }
+
+ private:
+  std::vector<std::pair<uint32_t, uint16_t>> received_;
+};
 
 class SrtpTransportTest : public ::testing::Test, public sigslot::has_slots<> {
  protected:
@@ -416,4 +436,52 @@ TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
       rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen - 1, extension_ids));
 }
 
+TEST_F(SrtpTransportTest, ParallelUnprotectPreservesArrivalOrder) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  RecordingRtpSink sink;
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types = {0x00};
+  srtp_transport2_->UnregisterRtpDemuxerSink(&rtp_sink2_);
+  srtp_transport2_->RegisterRtpDemuxerSink(demuxer_criteria, &sink);
+  srtp_transport2_->EnableParallelUnprotect(task_queue_factory.get(),
+                                            /*num_workers=*/4);
+  EXPECT_TRUE(srtp_transport2_->IsParallelUnprotectEnabled());
+
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  // Interleave packets from several SSRCs so that they are spread over the
+  // workers, and send the last one twice to exercise the replay protection.
+  const int kNumPackets = 100;
+  const uint32_t kNumSsrcs = 7;
+  std::vector<std::pair<uint32_t, uint16_t>> expected;
+  size_t packet_size = sizeof(kPcmuFrame) +
+                       rtc::rtp_auth_tag_len(rtc::CS_AES_CM_128_HMAC_SHA1_80);
+  rtc::PacketOptions options;
+  for (int i = 0; i <= kNumPackets; ++i) {
+    int n = std::min(i, kNumPackets - 1);
+    uint32_t ssrc = 1 + n % kNumSsrcs;
+    uint16_t seq_num = static_cast<uint16_t>(n / kNumSsrcs);
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  packet_size);
+    rtc::SetBE16(packet.data() + 2, seq_num);
+    rtc::SetBE32(packet.data() + 8, ssrc);
+    ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+    if (i < kNumPackets) {
+      expected.emplace_back(ssrc, seq_num);
+    }
+  }
+
+  EXPECT_EQ_WAIT(expected.size(), sink.received().size(), kTimeoutMs);
+  EXPECT_EQ(expected, sink.received());
+  srtp_transport2_->UnregisterRtpDemuxerSink(&sink);
+}
+
 }  // namespace webrtc
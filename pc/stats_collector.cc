@@ -10,6 +10,7 @@
 
 #include "pc/stats_collector.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <utility>
@@ -18,6 +19,7 @@
 #include "pc/channel.h"
 #include "pc/peer_connection.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/third_party/base64/base64.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -29,6 +31,22 @@ namespace {
 // in bytes sent or received.
 constexpr char kUseStandardBytesStats[] = "WebRTC-UseStandardBytesStats";
 
+// Field trial which sets the minimum time between two gatherings of stats,
+// e.g. "WebRTC-LegacyStatsMinGatherPeriod/period_ms:1000/". Polls that come
+// sooner get the reports of the last gathering, without querying the channels
+// and transports on the worker and network threads again.
+constexpr char kMinGatherStatsPeriodFieldTrial[] =
+    "WebRTC-LegacyStatsMinGatherPeriod";
+constexpr int kDefaultMinGatherStatsPeriodMs = 50;
+
+double GetMinGatherStatsPeriodMs() {
+  FieldTrialParameter<int> period_ms("period_ms",
+                                     kDefaultMinGatherStatsPeriodMs);
+  ParseFieldTrial({&period_ms},
+                  field_trial::FindFullName(kMinGatherStatsPeriodFieldTrial));
+  return std::max(period_ms.Get(), 0);
+}
+
 // The following is the enum RTCStatsIceCandidateType from
 // http://w3c.github.io/webrtc-stats/#rtcstatsicecandidatetype-enum such that
 // our stats report for ice candidate type could conform to that.
@@ -500,7 +518,8 @@ StatsCollector::StatsCollector(PeerConnectionInternal* pc)
     : pc_(pc),
       stats_gathering_started_(0),
       use_standard_bytes_stats_(
-          webrtc::field_trial::IsEnabled(kUseStandardBytesStats)) {
+          webrtc::field_trial::IsEnabled(kUseStandardBytesStats)),
+      min_gather_stats_period_ms_(GetMinGatherStatsPeriodMs()) {
   RTC_DCHECK(pc_);
 }
 
@@ -615,11 +634,10 @@ void StatsCollector::UpdateStats(
     PeerConnectionInterface::StatsOutputLevel level) {
   RTC_DCHECK(pc_->signaling_thread()->IsCurrent());
   double time_now = GetTimeNow();
-  // Calls to UpdateStats() that occur less than kMinGatherStatsPeriod number of
-  // ms apart will be ignored.
-  const double kMinGatherStatsPeriod = 50;
+  // Calls to UpdateStats() that occur less than |min_gather_stats_period_ms_|
+  // apart will be ignored.
   if (stats_gathering_started_ != 0 &&
-      stats_gathering_started_ + kMinGatherStatsPeriod > time_now) {
+      stats_gathering_started_ + min_gather_stats_period_ms_ > time_now) {
     return;
   }
   stats_gathering_started_ = time_now;
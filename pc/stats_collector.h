@@ -90,8 +90,7 @@ class StatsCollector {
   bool IsValidTrack(const std::string& track_id);
 
   // Method used by the unittest to force a update of stats since UpdateStats()
-  // that occur less than kMinGatherStatsPeriod number of ms apart will be
-  // ignored.
+  // that occur less than the minimum gather period apart will be ignored.
   void ClearUpdateStatsCacheForTest();
 
   bool UseStandardBytesStats() const { return use_standard_bytes_stats_; }
@@ -146,6 +145,7 @@ class StatsCollector {
   PeerConnectionInternal* const pc_;
   double stats_gathering_started_;
   const bool use_standard_bytes_stats_;
+  const double min_gather_stats_period_ms_;
 
   // TODO(tommi): We appear to be holding on to raw pointers to reference
   // counted objects?  We should be using scoped_refptr here.
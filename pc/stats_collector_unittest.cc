@@ -1900,4 +1900,69 @@ TEST_P(StatsCollectorTrackTest, VerifyVideoReceiveSsrcStatsNew) {
 
 INSTANTIATE_TEST_SUITE_P(HasStream, StatsCollectorTrackTest, ::testing::Bool());
 
+TEST(StatsReportTest, UpdatesUnsharedValuesInPlace) {
+  StatsReport report(StatsReport::NewTypedId(
+      StatsReport::kStatsReportTypeSsrc, "1234"));
+  report.AddInt64(StatsReport::kStatsValueNameBytesSent, 100);
+  report.AddString(StatsReport::kStatsValueNameTrackId,
+                   std::string("track1"));
+  const StatsReport::Value* bytes_sent =
+      report.FindValue(StatsReport::kStatsValueNameBytesSent);
+  const StatsReport::Value* track_id =
+      report.FindValue(StatsReport::kStatsValueNameTrackId);
+
+  report.AddInt64(StatsReport::kStatsValueNameBytesSent, 200);
+  report.AddString(StatsReport::kStatsValueNameTrackId,
+                   std::string("track2"));
+  EXPECT_EQ(bytes_sent,
+            report.FindValue(StatsReport::kStatsValueNameBytesSent));
+  EXPECT_EQ(track_id, report.FindValue(StatsReport::kStatsValueNameTrackId));
+  EXPECT_EQ(200, bytes_sent->int64_val());
+  EXPECT_EQ("track2", track_id->string_val());
+
+  // A value of another type replaces the value.
+  report.AddInt(StatsReport::kStatsValueNameBytesSent, 300);
+  EXPECT_EQ(StatsReport::Value::kInt,
+            report.FindValue(StatsReport::kStatsValueNameBytesSent)->type());
+  EXPECT_EQ(300,
+            report.FindValue(StatsReport::kStatsValueNameBytesSent)->int_val());
+}
+
+TEST(StatsReportTest, DoesNotChangeValuesOfCopies) {
+  StatsReport report(StatsReport::NewTypedId(
+      StatsReport::kStatsReportTypeSsrc, "1234"));
+  report.AddInt64(StatsReport::kStatsValueNameBytesSent, 100);
+  const StatsReport::Values copy = report.values();
+
+  report.AddInt64(StatsReport::kStatsValueNameBytesSent, 200);
+  EXPECT_EQ(100, copy.at(StatsReport::kStatsValueNameBytesSent)->int64_val());
+  EXPECT_EQ(200, report.FindValue(StatsReport::kStatsValueNameBytesSent)
+                     ->int64_val());
+}
+
+TEST(StatsReportTest, ReplacedReportReusesValues) {
+  StatsCollection reports;
+  StatsReport::Id id(
+      StatsReport::NewTypedId(StatsReport::kStatsReportTypeSession, "1"));
+  StatsReport* report = reports.ReplaceOrAddNew(id);
+  report->set_timestamp(1000.0);
+  report->AddInt64(StatsReport::kStatsValueNameBytesSent, 100);
+  report->AddString(StatsReport::kStatsValueNameTrackId, "track1");
+  const StatsReport::Value* bytes_sent =
+      report->FindValue(StatsReport::kStatsValueNameBytesSent);
+
+  EXPECT_EQ(report, reports.ReplaceOrAddNew(id));
+  EXPECT_TRUE(report->empty());
+  EXPECT_EQ(0.0, report->timestamp());
+  EXPECT_EQ(1u, reports.size());
+
+  // Only the values that are set again are reported.
+  report->AddInt64(StatsReport::kStatsValueNameBytesSent, 200);
+  EXPECT_EQ(bytes_sent,
+            report->FindValue(StatsReport::kStatsValueNameBytesSent));
+  EXPECT_EQ(200, bytes_sent->int64_val());
+  EXPECT_FALSE(report->FindValue(StatsReport::kStatsValueNameTrackId));
+  EXPECT_EQ(1u, report->values().size());
+}
+
 }  // namespace webrtc
@@ -25,6 +25,7 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
 #include "api/candidate.h"
 #include "api/crypto_params.h"
 #include "api/jsep_ice_candidate.h"
@@ -492,7 +493,8 @@ static bool GetLine(const std::string& message,
   if (line_end > 0 && (message.at(line_end - 1) == kReturnChar)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
+  // Reuses the buffer of |line|, which is typically large enough already.
+  line->assign(message, line_begin, line_end - line_begin);
   const char* cline = line->c_str();
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
@@ -599,9 +601,16 @@ static bool GetLineWithType(const std::string& message,
   return true;
 }
 
-static bool HasAttribute(const std::string& line,
-                         const std::string& attribute) {
-  if (line.compare(kLinePrefixLength, attribute.size(), attribute) == 0) {
+// Returns what follows "<type>=" in |line|, without copying it.
+static absl::string_view LineContent(const std::string& line) {
+  return absl::string_view(line).substr(kLinePrefixLength);
+}
+
+// |attribute| is a string_view, since this is called with string literals for
+// each attribute that a line is compared against.
+static bool HasAttribute(const std::string& line, absl::string_view attribute) {
+  if (line.compare(kLinePrefixLength, attribute.size(), attribute.data(),
+                   attribute.size()) == 0) {
     // Make sure that the match is not only a partial match. If length of
     // strings doesn't match, the next character of the line must be ':' or ' '.
     // This function is also used for media descriptions (e.g., "m=audio 9..."),
@@ -1262,10 +1271,10 @@ bool ParseSctpPort(const std::string& line,
   // a=sctp-port
   std::vector<std::string> fields;
   const size_t expected_min_fields = 2;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterColonChar, &fields);
   if (fields.size() < expected_min_fields) {
     fields.resize(0);
-    rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+    rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   }
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -1283,7 +1292,7 @@ bool ParseSctpMaxMessageSize(const std::string& line,
   // a=max-message-size:199999
   std::vector<std::string> fields;
   const size_t expected_min_fields = 2;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterColonChar, &fields);
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
   }
@@ -1299,7 +1308,7 @@ bool ParseExtmap(const std::string& line,
   // RFC 5285
   // a=extmap:<value>["/"<direction>] <URI> <extensionattributes>
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -2197,7 +2206,7 @@ bool ParseSessionDescription(const std::string& message,
                                  error);
   }
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_fields = 6;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2359,7 +2368,7 @@ bool ParseGroupAttribute(const std::string& line,
   // RFC 5888 and draft-holmberg-mmusic-sdp-bundle-negotiation-00
   // a=group:BUNDLE video voice
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   std::string semantics;
   if (!GetValue(fields[0], kAttributeGroup, &semantics, error)) {
     return false;
@@ -2383,7 +2392,7 @@ static bool ParseFingerprintAttribute(
   }
 
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_fields = 2;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2416,7 +2425,7 @@ static bool ParseDtlsSetup(const std::string& line,
   // setup-attr           =  "a=setup:" role
   // role                 =  "active" / "passive" / "actpass" / "holdconn"
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterColonChar, &fields);
   const size_t expected_fields = 2;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2440,7 +2449,7 @@ static bool ParseMsidAttribute(const std::string& line,
   std::string field1;
   std::string new_stream_id;
   std::string new_track_id;
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
+  if (!rtc::tokenize_first(LineContent(line),
                            kSdpDelimiterSpaceChar, &field1, &new_track_id)) {
     const size_t expected_fields = 2;
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2724,7 +2733,7 @@ bool ParseMediaDescription(
     ++mline_index;
 
     std::vector<std::string> fields;
-    rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+    rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
 
     const size_t expected_min_fields = 4;
     if (fields.size() < expected_min_fields) {
@@ -2948,22 +2957,9 @@ T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
 // Updates or creates a new codec entry in the audio description.
 template <class T, class U>
 void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-  for (U& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
-  }
-  desc->set_codecs(codecs);
+  // Replaced in place, since copying all codecs for every attribute line
+  // makes parsing quadratic in the number of codecs.
+  static_cast<T*>(content_desc)->AddOrReplaceCodec(codec);
 }
 
 // Adds or updates existing codec corresponding to |payload_type| according
@@ -3498,7 +3494,7 @@ bool ParseSsrcAttribute(const std::string& line,
   // a=ssrc:<ssrc-id> <attribute>
   // a=ssrc:<ssrc-id> <attribute>:<value>
   std::string field1, field2;
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
+  if (!rtc::tokenize_first(LineContent(line),
                            kSdpDelimiterSpaceChar, &field1, &field2)) {
     const size_t expected_fields = 2;
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -3576,7 +3572,7 @@ bool ParseSsrcGroupAttribute(const std::string& line,
   // RFC 5576
   // a=ssrc-group:<semantics> <ssrc-id> ...
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -3601,7 +3597,7 @@ bool ParseCryptoAttribute(const std::string& line,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   // RFC 4568
   // a=crypto:<tag> <crypto-suite> <key-params> [<session-params>]
   const size_t expected_min_fields = 3;
@@ -3667,7 +3663,7 @@ bool ParseRtpmapAttribute(const std::string& line,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(LineContent(line), kSdpDelimiterSpaceChar, &fields);
   // RFC 4566
   // a=rtpmap:<payload type> <encoding name>/<clock rate>[/<encodingparameters>]
   const size_t expected_min_fields = 2;
@@ -3761,7 +3757,7 @@ bool ParseFmtpAttributes(const std::string& line,
   // a=fmtp:<format> <format specific parameters>
   // At least two fields, whereas the second one is any of the optional
   // parameters.
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
+  if (!rtc::tokenize_first(LineContent(line),
                            kSdpDelimiterSpaceChar, &line_payload,
                            &line_params)) {
     ParseFailedExpectMinFieldNum(line, 2, error);
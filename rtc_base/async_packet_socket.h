@@ -81,6 +81,14 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
                      const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // Starts holding back packets passed to SendTo so that they can be written
+  // to the network with fewer system calls once FlushSendBatch() is called.
+  // Calls may be nested; the packets are sent when the outermost batch is
+  // flushed. Sockets that don't support batching send packets immediately,
+  // which is what the default implementation does.
+  virtual void StartSendBatch() {}
+  virtual void FlushSendBatch() {}
+
   // Close the socket.
   virtual int Close() = 0;
 
@@ -315,21 +315,27 @@ int AsyncTCPSocket::Send(const void* pv,
 void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
+  // Packets are read in place, and what is left of the last one is moved to
+  // the start of |data| once, when all complete packets have been read.
+  size_t processed_len = 0;
   while (true) {
-    if (*len < kPacketLenSize)
-      return;
+    const size_t remaining_len = *len - processed_len;
+    if (remaining_len < kPacketLenSize)
+      break;
 
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
+    PacketLength pkt_len = rtc::GetBE16(data + processed_len);
+    if (remaining_len < kPacketLenSize + pkt_len)
+      break;
 
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     TimeMicros());
+    SignalReadPacket(this, data + processed_len + kPacketLenSize, pkt_len,
+                     remote_addr, TimeMicros());
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+    processed_len += kPacketLenSize + pkt_len;
+  }
+
+  *len -= processed_len;
+  if (processed_len > 0 && *len > 0) {
+    memmove(data, data + processed_len, *len);
   }
 }
 
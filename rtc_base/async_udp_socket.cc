@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
 
 #include "rtc_base/checks.h"
@@ -23,6 +24,8 @@
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Queued packets are flushed early once this many are waiting.
+static const size_t kMaxPendingPackets = 64;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(AsyncSocket* socket,
                                        const SocketAddress& bind_address) {
@@ -46,6 +49,7 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
 AsyncUDPSocket::AsyncUDPSocket(AsyncSocket* socket) : socket_(socket) {
   size_ = BUF_SIZE;
   buf_ = new char[size_];
+  SetRecvBatchSize(1);
 
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
@@ -67,6 +71,8 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  // Preserve ordering with packets queued by SendTo.
+  SendPendingPackets();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -82,12 +88,69 @@ int AsyncUDPSocket::SendTo(const void* pv,
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
+  if (send_batch_depth_ > 0) {
+    if (num_pending_packets_ == pending_packets_.size())
+      pending_packets_.emplace_back();
+    PendingPacket& pending = pending_packets_[num_pending_packets_++];
+    pending.data.SetData(static_cast<const uint8_t*>(pv), cb);
+    pending.address = addr;
+    pending.sent_packet = sent_packet;
+    if (num_pending_packets_ >= kMaxPendingPackets)
+      SendPendingPackets();
+    // Datagrams may be dropped at any time, so report success for now and
+    // leave errors to the flush.
+    return static_cast<int>(cb);
+  }
   int ret = socket_->SendTo(pv, cb, addr);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+void AsyncUDPSocket::StartSendBatch() {
+  ++send_batch_depth_;
+}
+
+void AsyncUDPSocket::FlushSendBatch() {
+  RTC_DCHECK_GT(send_batch_depth_, 0);
+  if (send_batch_depth_ > 0 && --send_batch_depth_ == 0)
+    SendPendingPackets();
+}
+
+void AsyncUDPSocket::SendPendingPackets() {
+  if (num_pending_packets_ == 0)
+    return;
+  outgoing_datagrams_.resize(num_pending_packets_);
+  for (size_t i = 0; i < num_pending_packets_; ++i) {
+    outgoing_datagrams_[i].data = pending_packets_[i].data.data();
+    outgoing_datagrams_[i].size = pending_packets_[i].data.size();
+    outgoing_datagrams_[i].address = pending_packets_[i].address;
+  }
+  size_t num_sent = 0;
+  while (num_sent < num_pending_packets_) {
+    int sent = socket_->SendToBatch(&outgoing_datagrams_[num_sent],
+                                    num_pending_packets_ - num_sent);
+    if (sent <= 0)
+      break;
+    num_sent += static_cast<size_t>(sent);
+  }
+  if (num_sent < num_pending_packets_) {
+    RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket dropped "
+                        << num_pending_packets_ - num_sent
+                        << " batched packets, error " << socket_->GetError();
+  }
+  // Like SendTo, signal every packet, including the ones that failed.
+  size_t num_pending = num_pending_packets_;
+  num_pending_packets_ = 0;
+  int64_t now_ms = TimeMillis();
+  for (size_t i = 0; i < num_pending; ++i) {
+    rtc::SentPacket sent_packet = pending_packets_[i].sent_packet;
+    sent_packet.send_time_ms = now_ms;
+    SignalSentPacket(this, sent_packet);
+  }
+}
+
 int AsyncUDPSocket::Close() {
+  num_pending_packets_ = 0;
   return socket_->Close();
 }
 
@@ -111,13 +174,26 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetRecvBatchSize(size_t batch_size) {
+  RTC_DCHECK_GE(batch_size, 1);
+  batch_size = std::max<size_t>(batch_size, 1);
+  batch_buffers_.resize(batch_size - 1);
+  batch_.resize(batch_size);
+  batch_[0].buffer = buf_;
+  batch_[0].capacity = size_;
+  for (size_t i = 1; i < batch_size; ++i) {
+    if (!batch_buffers_[i - 1])
+      batch_buffers_[i - 1].reset(new char[size_]);
+    batch_[i].buffer = batch_buffers_[i - 1].get();
+    batch_[i].capacity = size_;
+  }
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
-  SocketAddress remote_addr;
-  int64_t timestamp;
-  int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
-  if (len < 0) {
+  int count = socket_->RecvFromBatch(batch_.data(), batch_.size());
+  if (count < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
     // When doing ICE, this kind of thing will often happen.
@@ -130,8 +206,18 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
 
   // TODO: Make sure that we got all of the packet.
   // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(this, buf_, static_cast<size_t>(len), remote_addr,
-                   (timestamp > -1 ? timestamp : TimeMicros()));
+  int64_t now_us = -1;
+  for (int i = 0; i < count; ++i) {
+    const ReceivedDatagram& datagram = batch_[i];
+    int64_t timestamp = datagram.timestamp;
+    if (timestamp < 0) {
+      if (now_us < 0)
+        now_us = TimeMicros();
+      timestamp = now_us;
+    }
+    SignalReadPacket(this, static_cast<const char*>(datagram.buffer),
+                     datagram.length, datagram.address, timestamp);
+  }
 }
 
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
@@ -14,9 +14,11 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/async_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -48,6 +50,8 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  void StartSendBatch() override;
+  void FlushSendBatch() override;
   int Close() override;
 
   State GetState() const override;
@@ -56,7 +60,24 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Sets the maximum number of datagrams read from the underlying socket per
+  // read event. Each datagram is still delivered through SignalReadPacket.
+  // Values above 1 let sockets that support it (see Socket::RecvFromBatch)
+  // drain the receive queue with fewer system calls, at the cost of one
+  // receive buffer per batch slot. The default is 1.
+  void SetRecvBatchSize(size_t batch_size);
+  size_t recv_batch_size() const { return batch_.size(); }
+
  private:
+  struct PendingPacket {
+    Buffer data;
+    SocketAddress address;
+    SentPacket sent_packet;
+  };
+
+  // Writes all packets queued while batching to the underlying socket.
+  void SendPendingPackets();
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
@@ -65,6 +86,16 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Receive slots used by OnReadEvent. The first slot always points at |buf_|.
+  std::vector<ReceivedDatagram> batch_;
+  std::vector<std::unique_ptr<char[]>> batch_buffers_;
+  // Nesting depth of StartSendBatch() calls.
+  int send_batch_depth_ = 0;
+  // The first |num_pending_packets_| entries are waiting to be sent. Entries
+  // are reused between batches so that their buffers keep their capacity.
+  std::vector<PendingPacket> pending_packets_;
+  size_t num_pending_packets_ = 0;
+  std::vector<OutgoingDatagram> outgoing_datagrams_;
 };
 
 }  // namespace rtc
@@ -47,6 +47,19 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
   RTC_DCHECK(IsConsistent());
 }
 
+CopyOnWriteBuffer::CopyOnWriteBuffer(
+    scoped_refptr<RefCountedObject<Buffer>> buffer)
+    : buffer_(std::move(buffer)),
+      offset_(0),
+      size_(buffer_ ? buffer_->size() : 0) {
+  if (buffer_ && buffer_->capacity() == 0) {
+    buffer_ = nullptr;
+    size_ = 0;
+  }
+  RTC_DCHECK(!buffer_ || buffer_->HasOneRef());
+  RTC_DCHECK(IsConsistent());
+}
+
 CopyOnWriteBuffer::~CopyOnWriteBuffer() = default;
 
 bool CopyOnWriteBuffer::operator==(const CopyOnWriteBuffer& buf) const {
@@ -113,7 +126,11 @@ void CopyOnWriteBuffer::Clear() {
 }
 
 void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
-  if (buffer_->HasOneRef() && new_capacity <= capacity()) {
+  if (buffer_->HasOneRef()) {
+    // Grow unshared storage in place, which reallocates only the data and
+    // keeps pooled storage with its pool.
+    buffer_->EnsureCapacity(offset_ + new_capacity);
+    RTC_DCHECK(IsConsistent());
     return;
   }
 
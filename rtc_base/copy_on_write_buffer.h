@@ -62,6 +62,11 @@ class RTC_EXPORT CopyOnWriteBuffer {
     }
   }
 
+  // Construct a buffer that takes over an existing, unshared |buffer|. This
+  // lets buffer pools hand out storage whose memory is recycled when the last
+  // reference is dropped.
+  explicit CopyOnWriteBuffer(scoped_refptr<RefCountedObject<Buffer>> buffer);
+
   // Construct a buffer from the contents of an array.
   template <typename T,
             size_t N,
@@ -208,7 +213,10 @@ class RTC_EXPORT CopyOnWriteBuffer {
       return;
     }
 
-    UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
+    // Unshared storage is grown by Buffer::AppendData, with headroom for
+    // further appends.
+    if (!buffer_->HasOneRef())
+      UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
 
     buffer_->SetSize(offset_ +
                      size_);  // Remove data to the right of the slice.
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Shared between the pool and every buffer it hands out, so that buffers may
+// outlive the pool.
+class CopyOnWriteBufferPool::FreeList : public RefCountInterface {
+ public:
+  explicit FreeList(size_t max_size) : max_size_(max_size) {}
+
+  // Takes ownership of |buffer| if there is room and the pool is still
+  // alive. Returns false if the caller should delete it instead.
+  bool Push(PooledBuffer* buffer) {
+    CritScope cs(&crit_);
+    if (closed_ || buffers_.size() >= max_size_)
+      return false;
+    buffers_.push_back(buffer);
+    return true;
+  }
+
+  PooledBuffer* Pop() {
+    CritScope cs(&crit_);
+    if (buffers_.empty())
+      return nullptr;
+    PooledBuffer* buffer = buffers_.back();
+    buffers_.pop_back();
+    return buffer;
+  }
+
+  size_t size() const {
+    CritScope cs(&crit_);
+    return buffers_.size();
+  }
+
+  // Stops accepting buffers and deletes the ones waiting for reuse.
+  void Close();
+
+ private:
+  const size_t max_size_;
+  CriticalSection crit_;
+  bool closed_ RTC_GUARDED_BY(crit_) = false;
+  std::vector<PooledBuffer*> buffers_ RTC_GUARDED_BY(crit_);
+};
+
+class CopyOnWriteBufferPool::PooledBuffer : public RefCountedObject<Buffer> {
+ public:
+  PooledBuffer(size_t capacity, scoped_refptr<FreeList> free_list)
+      : RefCountedObject<Buffer>(0, capacity),
+        free_list_(std::move(free_list)) {}
+
+  RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == RefCountReleaseStatus::kDroppedLastRef) {
+      PooledBuffer* self = const_cast<PooledBuffer*>(this);
+      if (!free_list_->Push(self))
+        delete self;
+    }
+    return status;
+  }
+
+ private:
+  friend class FreeList;
+  ~PooledBuffer() override = default;
+
+  const scoped_refptr<FreeList> free_list_;
+};
+
+void CopyOnWriteBufferPool::FreeList::Close() {
+  std::vector<PooledBuffer*> buffers;
+  {
+    CritScope cs(&crit_);
+    closed_ = true;
+    buffers.swap(buffers_);
+  }
+  for (PooledBuffer* buffer : buffers)
+    delete buffer;
+}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool()
+    : CopyOnWriteBufferPool(kDefaultBufferCapacity, kDefaultMaxFreeBuffers) {}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(size_t buffer_capacity,
+                                             size_t max_free_buffers)
+    : buffer_capacity_(buffer_capacity),
+      free_list_(new RefCountedObject<FreeList>(max_free_buffers)) {
+  RTC_DCHECK_GT(buffer_capacity_, 0);
+}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() {
+  free_list_->Close();
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::CreateBuffer(const uint8_t* data,
+                                                      size_t size) {
+  scoped_refptr<RefCountedObject<Buffer>> buffer = free_list_->Pop();
+  if (!buffer)
+    buffer = new PooledBuffer(buffer_capacity_, free_list_);
+  buffer->SetData(data, size);
+  return CopyOnWriteBuffer(std::move(buffer));
+}
+
+size_t CopyOnWriteBufferPool::free_buffers() const {
+  return free_list_->size();
+}
+
+}  // namespace rtc
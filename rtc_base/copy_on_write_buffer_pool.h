@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+#define RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace rtc {
+
+// Pool of packet-sized buffers for the receive path. Buffers returned by
+// CreateBuffer are ordinary, unshared CopyOnWriteBuffers, so they can be
+// modified in place (e.g. by SRTP) and handed on to RtpPacketReceived without
+// a copy. When the last reference to the storage is dropped, on any thread,
+// the storage is put on the pool's free list instead of being deleted, so a
+// steady stream of packets doesn't touch the allocator.
+// The pool itself should be used from a single thread. Storage that is
+// released after the pool has been destroyed is simply deleted.
+// Storage is allocated and first written by the thread that uses the pool, so
+// with that thread placed on a NUMA node (see ThreadPlacement) the pooled
+// storage stays in the memory of the node, wherever it is released.
+class RTC_EXPORT CopyOnWriteBufferPool {
+ public:
+  static constexpr size_t kDefaultBufferCapacity = 2048;
+  static constexpr size_t kDefaultMaxFreeBuffers = 256;
+
+  CopyOnWriteBufferPool();
+  CopyOnWriteBufferPool(size_t buffer_capacity, size_t max_free_buffers);
+  ~CopyOnWriteBufferPool();
+
+  // Returns a buffer containing a copy of |data|. Uses recycled storage when
+  // available; storage grown for an oversized packet keeps its capacity.
+  CopyOnWriteBuffer CreateBuffer(const uint8_t* data, size_t size);
+  CopyOnWriteBuffer CreateBuffer(const char* data, size_t size) {
+    return CreateBuffer(reinterpret_cast<const uint8_t*>(data), size);
+  }
+
+  // Number of buffers currently waiting for reuse.
+  size_t free_buffers() const;
+
+ private:
+  class FreeList;
+  class PooledBuffer;
+
+  const size_t buffer_capacity_;
+  const scoped_refptr<FreeList> free_list_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace rtc {
+
+namespace {
+
+const uint8_t kTestData[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+
+}  // namespace
+
+TEST(CopyOnWriteBufferPoolTest, CreatesBufferWithData) {
+  CopyOnWriteBufferPool pool;
+  CopyOnWriteBuffer buffer = pool.CreateBuffer(kTestData, sizeof(kTestData));
+  EXPECT_EQ(CopyOnWriteBuffer(kTestData), buffer);
+  EXPECT_GE(buffer.capacity(), CopyOnWriteBufferPool::kDefaultBufferCapacity);
+}
+
+TEST(CopyOnWriteBufferPoolTest, RecyclesStorage) {
+  CopyOnWriteBufferPool pool;
+  const uint8_t* storage;
+  {
+    CopyOnWriteBuffer buffer = pool.CreateBuffer(kTestData, sizeof(kTestData));
+    storage = buffer.cdata();
+    EXPECT_EQ(0u, pool.free_buffers());
+  }
+  EXPECT_EQ(1u, pool.free_buffers());
+  CopyOnWriteBuffer buffer = pool.CreateBuffer(kTestData, 4);
+  EXPECT_EQ(storage, buffer.cdata());
+  EXPECT_EQ(4u, buffer.size());
+  EXPECT_EQ(0u, pool.free_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, BufferIsWritableWithoutCopy) {
+  CopyOnWriteBufferPool pool;
+  CopyOnWriteBuffer buffer = pool.CreateBuffer(kTestData, sizeof(kTestData));
+  const uint8_t* storage = buffer.cdata();
+  buffer.data()[0] = 0xff;
+  EXPECT_EQ(storage, buffer.cdata());
+}
+
+TEST(CopyOnWriteBufferPoolTest, StorageIsReturnedOnlyWhenAllCopiesAreGone) {
+  CopyOnWriteBufferPool pool;
+  CopyOnWriteBuffer copy;
+  {
+    CopyOnWriteBuffer buffer = pool.CreateBuffer(kTestData, sizeof(kTestData));
+    copy = buffer;
+  }
+  EXPECT_EQ(0u, pool.free_buffers());
+  copy.Clear();
+  EXPECT_EQ(0u, pool.free_buffers());
+  copy = CopyOnWriteBuffer();
+  EXPECT_EQ(1u, pool.free_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, LimitsNumberOfFreeBuffers) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/64, /*max_free_buffers=*/2);
+  {
+    CopyOnWriteBuffer buffer1 = pool.CreateBuffer(kTestData, 1);
+    CopyOnWriteBuffer buffer2 = pool.CreateBuffer(kTestData, 1);
+    CopyOnWriteBuffer buffer3 = pool.CreateBuffer(kTestData, 1);
+  }
+  EXPECT_EQ(2u, pool.free_buffers());
+}
+
+TEST(CopyOnWriteBufferPoolTest, BufferMayOutlivePool) {
+  auto pool = std::make_unique<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, sizeof(kTestData));
+  pool.reset();
+  EXPECT_EQ(CopyOnWriteBuffer(kTestData), buffer);
+}
+
+}  // namespace rtc
@@ -119,6 +119,27 @@ TEST(CopyOnWriteBufferTest, TestAppendData) {
   EXPECT_EQ(buf2, CopyOnWriteBuffer(exp));
 }
 
+TEST(CopyOnWriteBufferTest, AppendDataToUnsharedBufferLeavesHeadroom) {
+  CopyOnWriteBuffer buf(kTestData, 10, 10);
+
+  buf.AppendData(kTestData, 1);
+
+  EXPECT_EQ(11u, buf.size());
+  EXPECT_GE(buf.capacity(), 15u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 10));
+}
+
+TEST(CopyOnWriteBufferTest, GrowingUnsharedSliceKeepsContent) {
+  CopyOnWriteBuffer buf(kTestData, 10, 10);
+  buf = buf.Slice(2, 4);
+
+  buf.SetSize(16);
+
+  EXPECT_EQ(16u, buf.size());
+  EXPECT_GE(buf.capacity(), 16u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData + 2, 4));
+}
+
 TEST(CopyOnWriteBufferTest, SetEmptyData) {
   CopyOnWriteBuffer buf(10);
 
@@ -14,6 +14,7 @@
 
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/lock_profiler.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/system/unused.h"
 
@@ -209,9 +210,34 @@ bool CriticalSection::CurrentThreadIsOwner() const {
 #endif
 }
 
+#if defined(WEBRTC_LOCK_PROFILING)
+void CriticalSection::EnterFrom(const char* function,
+                                const char* file,
+                                int line) const RTC_NO_THREAD_SAFETY_ANALYSIS {
+  if (!TryEnter()) {
+    const int64_t start_time_us = LockProfilerTimeMicros();
+    Enter();
+    // Attributed to the last holder, which released the lock to us.
+    RecordLockContention(holder_function_, holder_file_, holder_line_,
+                         LockProfilerTimeMicros() - start_time_us);
+  }
+  holder_function_ = function;
+  holder_file_ = file;
+  holder_line_ = line;
+}
+
+CritScope::CritScope(const CriticalSection* cs,
+                     const char* function,
+                     const char* file,
+                     int line)
+    : cs_(cs) {
+  cs_->EnterFrom(function, file, line);
+}
+#else
 CritScope::CritScope(const CriticalSection* cs) : cs_(cs) {
   cs_->Enter();
 }
+#endif
 CritScope::~CritScope() {
   cs_->Leave();
 }
@@ -54,10 +54,24 @@ class RTC_LOCKABLE CriticalSection {
   bool TryEnter() const RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true);
   void Leave() const RTC_UNLOCK_FUNCTION();
 
+#if defined(WEBRTC_LOCK_PROFILING)
+  // Enter() that records the wait when the lock is contended, see
+  // rtc_base/lock_profiler.h, and then records the caller as the holder.
+  void EnterFrom(const char* function, const char* file, int line) const
+      RTC_EXCLUSIVE_LOCK_FUNCTION();
+#endif
+
  private:
   // Use only for RTC_DCHECKing.
   bool CurrentThreadIsOwner() const;
 
+#if defined(WEBRTC_LOCK_PROFILING)
+  // The CritScope that took the lock last. Only accessed with the lock held.
+  mutable const char* holder_function_ = "";
+  mutable const char* holder_file_ = "";
+  mutable int holder_line_ = 0;
+#endif
+
 #if defined(WEBRTC_WIN)
   mutable CRITICAL_SECTION crit_;
 #elif defined(WEBRTC_POSIX)
@@ -86,7 +100,15 @@ class RTC_LOCKABLE CriticalSection {
 // CritScope, for serializing execution through a scope.
 class RTC_SCOPED_LOCKABLE CritScope {
  public:
+#if defined(WEBRTC_LOCK_PROFILING)
+  explicit CritScope(const CriticalSection* cs,
+                     const char* function = __builtin_FUNCTION(),
+                     const char* file = __builtin_FILE(),
+                     int line = __builtin_LINE())
+      RTC_EXCLUSIVE_LOCK_FUNCTION(cs);
+#else
   explicit CritScope(const CriticalSection* cs) RTC_EXCLUSIVE_LOCK_FUNCTION(cs);
+#endif
   ~CritScope() RTC_UNLOCK_FUNCTION();
 
  private:
@@ -13,8 +13,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -25,6 +27,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/location.h"
+#include "rtc_base/lock_profiler.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/message_queue.h"
 #include "rtc_base/platform_thread.h"
@@ -314,6 +317,48 @@ TEST(CriticalSectionTest, Basic) {
   EXPECT_EQ(0, runner.shared_value());
 }
 
+struct ContendedLock {
+  CriticalSection lock;
+  Event waiter_started;
+};
+
+void TakeContendedLock(void* param) {
+  ContendedLock* contended = static_cast<ContendedLock*>(param);
+  contended->waiter_started.Set();
+  CritScope cs(&contended->lock);
+}
+
+TEST(CriticalSectionTest, LockProfilingRecordsWaitForHolder) {
+  ResetLockContention();
+  ContendedLock contended;
+  PlatformThread waiter(&TakeContendedLock, &contended, "Waiter");
+  {
+    CritScope cs(&contended.lock);
+    waiter.Start();
+    contended.waiter_started.Wait(Event::kForever);
+    Thread::SleepMs(50);
+  }
+  waiter.Stop();
+
+  std::vector<LockContention> contention = GetLockContention();
+  if (!IsLockProfilingEnabled()) {
+    EXPECT_TRUE(contention.empty());
+    return;
+  }
+  ASSERT_FALSE(contention.empty());
+  // Other threads of the test binary may contend on locks of their own.
+  auto it = std::find_if(contention.begin(), contention.end(),
+                         [](const LockContention& holder) {
+                           return holder.holder.find(
+                                      "critical_section_unittest.cc") !=
+                                  std::string::npos;
+                         });
+  ASSERT_NE(it, contention.end());
+  EXPECT_EQ(it->contentions, 1);
+  EXPECT_GT(it->wait_time_us, 0);
+  EXPECT_EQ(it->wait_time_us, it->max_wait_time_us);
+}
+
 class PerfTestData {
  public:
   PerfTestData(int expected_count, Event* event)
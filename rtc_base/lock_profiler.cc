@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/lock_profiler.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "rtc_base/critical_section.h"
+
+namespace rtc {
+namespace {
+
+// Call sites are identified by the addresses of their string literals, so
+// that recording does not need to compare or copy strings.
+using HolderKey = std::tuple<const char*, const char*, int>;
+
+struct HolderStats {
+  int64_t contentions = 0;
+  int64_t wait_time_us = 0;
+  int64_t max_wait_time_us = 0;
+};
+
+// CriticalSection can not be used here, since it is what is being profiled.
+GlobalLock g_contention_lock;
+std::map<HolderKey, HolderStats>* g_contention = nullptr;
+
+}  // namespace
+
+bool IsLockProfilingEnabled() {
+#if defined(WEBRTC_LOCK_PROFILING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::vector<LockContention> GetLockContention() {
+  std::vector<LockContention> result;
+  {
+    GlobalLockScope lock(&g_contention_lock);
+    if (!g_contention)
+      return result;
+    for (const auto& entry : *g_contention) {
+      LockContention contention;
+      contention.holder = std::string(std::get<0>(entry.first)) + "@" +
+                          std::get<1>(entry.first) + ":" +
+                          std::to_string(std::get<2>(entry.first));
+      contention.contentions = entry.second.contentions;
+      contention.wait_time_us = entry.second.wait_time_us;
+      contention.max_wait_time_us = entry.second.max_wait_time_us;
+      result.push_back(std::move(contention));
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const LockContention& a, const LockContention& b) {
+              return a.wait_time_us > b.wait_time_us;
+            });
+  return result;
+}
+
+void ResetLockContention() {
+  GlobalLockScope lock(&g_contention_lock);
+  if (g_contention)
+    g_contention->clear();
+}
+
+void RecordLockContention(const char* function,
+                          const char* file,
+                          int line,
+                          int64_t wait_time_us) {
+  GlobalLockScope lock(&g_contention_lock);
+  // Leaked on purpose, locks may be taken during static destruction.
+  if (!g_contention)
+    g_contention = new std::map<HolderKey, HolderStats>();
+  HolderStats& stats = (*g_contention)[HolderKey(function, file, line)];
+  ++stats.contentions;
+  stats.wait_time_us += wait_time_us;
+  stats.max_wait_time_us = std::max(stats.max_wait_time_us, wait_time_us);
+}
+
+int64_t LockProfilerTimeMicros() {
+#if defined(WEBRTC_WIN)
+  static const LARGE_INTEGER frequency = [] {
+    LARGE_INTEGER value;
+    QueryPerformanceFrequency(&value);
+    return value;
+  }();
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  return now.QuadPart * 1000000 / frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+}  // namespace rtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_LOCK_PROFILER_H_
+#define RTC_BASE_LOCK_PROFILER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+// Contention on the CriticalSections that were held by one call site.
+struct LockContention {
+  // The CritScope that held the lock when it was waited for, formatted as
+  // "function@file:line".
+  std::string holder;
+  // Number of times the lock could not be taken right away.
+  int64_t contentions = 0;
+  // Total and longest time spent waiting for the lock.
+  int64_t wait_time_us = 0;
+  int64_t max_wait_time_us = 0;
+};
+
+// Lock profiling records, for every CriticalSection taken through a
+// CritScope, how often and for how long threads waited for it and which
+// CritScope was holding it. It costs a TryEnter() per lock, so it is only
+// compiled in with the GN arg rtc_enable_lock_profiling = true, which defines
+// WEBRTC_LOCK_PROFILING. It needs a compiler that has __builtin_FILE().
+bool IsLockProfilingEnabled();
+
+// Returns the contention recorded since the start of the process or the last
+// call to ResetLockContention(), longest total wait time first. Always empty
+// when lock profiling is not enabled.
+std::vector<LockContention> GetLockContention();
+void ResetLockContention();
+
+// Used by CriticalSection to record that a thread waited |wait_time_us| for a
+// lock that was held by the CritScope at |function|, |file| and |line|, which
+// must be string literals.
+void RecordLockContention(const char* function,
+                          const char* file,
+                          int line,
+                          int64_t wait_time_us);
+// Monotonic time used for measuring the wait time.
+int64_t LockProfilerTimeMicros();
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_LOCK_PROFILER_H_
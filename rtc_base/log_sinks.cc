@@ -17,6 +17,7 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/strings/string_builder.h"
 
 namespace rtc {
 
@@ -73,4 +74,143 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+AsyncFileRotatingLogSink::AsyncFileRotatingLogSink(
+    const std::string& log_dir_path,
+    const std::string& log_prefix,
+    size_t max_log_size,
+    size_t num_log_files,
+    size_t max_buffered_bytes)
+    : AsyncFileRotatingLogSink(new FileRotatingStream(log_dir_path,
+                                                      log_prefix,
+                                                      max_log_size,
+                                                      num_log_files),
+                               max_buffered_bytes) {}
+
+AsyncFileRotatingLogSink::AsyncFileRotatingLogSink(FileRotatingStream* stream,
+                                                   size_t max_buffered_bytes)
+    : stream_(stream),
+      max_buffered_bytes_(max_buffered_bytes),
+      thread_(&AsyncFileRotatingLogSink::WriterThread,
+              this,
+              "AsyncLogWriter",
+              kLowPriority) {
+  RTC_DCHECK(stream);
+  RTC_DCHECK_GT(max_buffered_bytes, 0);
+}
+
+AsyncFileRotatingLogSink::~AsyncFileRotatingLogSink() {
+  if (!thread_.IsRunning())
+    return;
+  {
+    CritScope cs(&crit_);
+    stopping_ = true;
+  }
+  wake_up_.Set();
+  thread_.Stop();
+}
+
+void AsyncFileRotatingLogSink::OnLogMessage(const std::string& message) {
+  Append({message});
+}
+
+void AsyncFileRotatingLogSink::OnLogMessage(const std::string& message,
+                                            LoggingSeverity sev,
+                                            const char* tag) {
+  Append({tag, ": ", message});
+}
+
+bool AsyncFileRotatingLogSink::Init() {
+  RTC_DCHECK(!thread_.IsRunning());
+  if (!stream_->Open())
+    return false;
+  {
+    CritScope cs(&crit_);
+    started_ = true;
+  }
+  thread_.Start();
+  return true;
+}
+
+void AsyncFileRotatingLogSink::Flush() {
+  wake_up_.Set();
+  while (true) {
+    {
+      CritScope cs(&crit_);
+      if (!started_ ||
+          (buffer_.empty() && num_dropped_messages_ == 0 && !writing_)) {
+        return;
+      }
+    }
+    written_.Wait(Event::kForever);
+  }
+}
+
+void AsyncFileRotatingLogSink::Append(
+    std::initializer_list<absl::string_view> parts) {
+  size_t size = 0;
+  for (absl::string_view part : parts)
+    size += part.size();
+
+  bool wake_up;
+  {
+    CritScope cs(&crit_);
+    if (!started_) {
+      std::fprintf(stderr, "Init() must be called before adding this sink.\n");
+      return;
+    }
+    // The writer thread takes the whole buffer at once, so it only needs to
+    // be woken up for the first message, or the first dropped one.
+    wake_up = buffer_.empty() && num_dropped_messages_ == 0;
+    if (buffer_.size() + size > max_buffered_bytes_) {
+      ++num_dropped_messages_;
+    } else {
+      for (absl::string_view part : parts)
+        buffer_.append(part.data(), part.size());
+    }
+  }
+  if (wake_up)
+    wake_up_.Set();
+}
+
+// static
+void AsyncFileRotatingLogSink::WriterThread(void* obj) {
+  static_cast<AsyncFileRotatingLogSink*>(obj)->WriteMessages();
+}
+
+void AsyncFileRotatingLogSink::WriteMessages() {
+  std::string messages;
+  bool stopping = false;
+  while (!stopping) {
+    wake_up_.Wait(Event::kForever);
+    size_t num_dropped_messages;
+    {
+      CritScope cs(&crit_);
+      // Swapping keeps the capacity of both buffers, so that appending
+      // doesn't allocate once the buffers have grown.
+      messages.swap(buffer_);
+      buffer_.clear();
+      num_dropped_messages = num_dropped_messages_;
+      num_dropped_messages_ = 0;
+      stopping = stopping_;
+      writing_ = true;
+    }
+    if (!messages.empty()) {
+      stream_->WriteAll(messages.data(), messages.size(), nullptr, nullptr);
+    }
+    if (num_dropped_messages > 0) {
+      char line[64];
+      SimpleStringBuilder sb(line);
+      sb << "Dropped " << num_dropped_messages
+         << " log messages, the log buffer was full.\n";
+      stream_->WriteAll(sb.str(), sb.size(), nullptr, nullptr);
+    }
+    stream_->Flush();
+    {
+      CritScope cs(&crit_);
+      writing_ = false;
+    }
+    written_.Set();
+  }
+}
+
 }  // namespace rtc
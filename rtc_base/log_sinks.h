@@ -13,12 +13,19 @@
 
 #include <stddef.h>
 
+#include <initializer_list>
 #include <memory>
 #include <string>
 
+#include "absl/strings/string_view.h"
+
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "rtc_base/file_rotating_stream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
 
@@ -68,6 +75,65 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
   RTC_DISALLOW_COPY_AND_ASSIGN(CallSessionFileRotatingLogSink);
 };
 
+// Log sink that uses a FileRotatingStream to write to disk, like
+// FileRotatingLogSink, but from a background thread. Messages are appended to
+// a buffer of at most |max_buffered_bytes|, so logging never blocks on disk
+// writes; messages that don't fit are dropped, and the number of dropped
+// messages is written to the log once there is room again.
+// Init() must be called before adding this sink, and the sink must be removed
+// before it's destroyed.
+class AsyncFileRotatingLogSink : public LogSink {
+ public:
+  // |num_log_files| must be greater than 1 and |max_log_size| must be greater
+  // than 0.
+  AsyncFileRotatingLogSink(const std::string& log_dir_path,
+                           const std::string& log_prefix,
+                           size_t max_log_size,
+                           size_t num_log_files,
+                           size_t max_buffered_bytes);
+  // Writes the remaining buffered messages and stops the writer thread.
+  ~AsyncFileRotatingLogSink() override;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity sev,
+                    const char* tag) override;
+
+  // Deletes any existing files in the directory, creates a new log file and
+  // starts the writer thread.
+  bool Init();
+
+  // Blocks until all messages logged so far are written to disk.
+  void Flush();
+
+ protected:
+  AsyncFileRotatingLogSink(FileRotatingStream* stream,
+                           size_t max_buffered_bytes);
+
+ private:
+  static void WriterThread(void* obj);
+  void WriteMessages();
+  // Appends the concatenation of |parts| if it fits.
+  void Append(std::initializer_list<absl::string_view> parts);
+
+  const std::unique_ptr<FileRotatingStream> stream_;
+  const size_t max_buffered_bytes_;
+  rtc::CriticalSection crit_;
+  bool started_ RTC_GUARDED_BY(crit_) = false;
+  bool stopping_ RTC_GUARDED_BY(crit_) = false;
+  // True while the writer thread writes messages it took from |buffer_|.
+  bool writing_ RTC_GUARDED_BY(crit_) = false;
+  std::string buffer_ RTC_GUARDED_BY(crit_);
+  size_t num_dropped_messages_ RTC_GUARDED_BY(crit_) = 0;
+  // Signaled when |buffer_| becomes non-empty, or when stopping.
+  rtc::Event wake_up_;
+  // Signaled when a write is done.
+  rtc::Event written_;
+  rtc::PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncFileRotatingLogSink);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOG_SINKS_H_
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/log_sinks.h"
+
+#include <memory>
+#include <string>
+
+#include "rtc_base/file_rotating_stream.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace rtc {
+
+namespace {
+
+const char kFilePrefix[] = "AsyncFileRotatingLogSinkTest";
+const size_t kMaxFileSize = 1024;
+const size_t kNumLogFiles = 3;
+
+}  // namespace
+
+class AsyncFileRotatingLogSinkTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_path_ = webrtc::test::OutputPath();
+    dir_path_.append("test_async_log_sink");
+    dir_path_.append(webrtc::test::kPathDelimiter);
+    ASSERT_TRUE(webrtc::test::CreateDir(dir_path_));
+  }
+
+  void TearDown() override {
+    sink_.reset();
+    FileRotatingStream stream(dir_path_, kFilePrefix, kMaxFileSize,
+                              kNumLogFiles);
+    for (size_t i = 0; i < stream.GetNumFiles(); ++i) {
+      // Ignore return value, not all files are expected to exist.
+      webrtc::test::RemoveFile(stream.GetFilePath(i));
+    }
+    EXPECT_TRUE(webrtc::test::RemoveDir(dir_path_));
+  }
+
+  void CreateSink(size_t max_buffered_bytes) {
+    sink_.reset(new AsyncFileRotatingLogSink(
+        dir_path_, kFilePrefix, kMaxFileSize, kNumLogFiles,
+        max_buffered_bytes));
+    ASSERT_TRUE(sink_->Init());
+  }
+
+  std::string ReadLog() const {
+    FileRotatingStreamReader reader(dir_path_, kFilePrefix);
+    std::string contents(reader.GetSize(), '\0');
+    contents.resize(reader.ReadAll(&contents[0], contents.size()));
+    return contents;
+  }
+
+  std::string dir_path_;
+  std::unique_ptr<AsyncFileRotatingLogSink> sink_;
+};
+
+TEST_F(AsyncFileRotatingLogSinkTest, WritesMessagesInOrder) {
+  CreateSink(1024);
+  sink_->OnLogMessage("first\n");
+  sink_->OnLogMessage("second\n", LS_INFO, "tag");
+  sink_->Flush();
+  EXPECT_EQ("first\ntag: second\n", ReadLog());
+
+  sink_->OnLogMessage("third\n");
+  sink_->Flush();
+  EXPECT_EQ("first\ntag: second\nthird\n", ReadLog());
+}
+
+TEST_F(AsyncFileRotatingLogSinkTest, WritesBufferedMessagesOnDestruction) {
+  CreateSink(1024);
+  sink_->OnLogMessage("message\n");
+  sink_.reset();
+  EXPECT_EQ("message\n", ReadLog());
+}
+
+TEST_F(AsyncFileRotatingLogSinkTest, ReportsDroppedMessages) {
+  CreateSink(8);
+  sink_->OnLogMessage("too long to be buffered\n");
+  sink_->Flush();
+  EXPECT_EQ("Dropped 1 log messages, the log buffer was full.\n", ReadLog());
+}
+
+}  // namespace rtc
@@ -39,6 +39,15 @@ MessageDigest* MessageDigestFactory::Create(const std::string& alg) {
   return digest;
 }
 
+std::unique_ptr<HmacContext> HmacContext::Create(const std::string& alg,
+                                                 const void* key,
+                                                 size_t key_len) {
+  auto hmac = std::make_unique<OpenSSLHmacContext>(alg, key, key_len);
+  if (hmac->Size() == 0)  // invalid algorithm
+    return nullptr;
+  return hmac;
+}
+
 bool IsFips180DigestAlgorithm(const std::string& alg) {
   // These are the FIPS 180 algorithms.  According to RFC 4572 Section 5,
   // "Self-signed certificates (for which legacy certificates are not a
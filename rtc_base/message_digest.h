@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <string>
 
 namespace rtc {
@@ -45,6 +46,25 @@ class MessageDigestFactory {
   static MessageDigest* Create(const std::string& alg);
 };
 
+// A class for computing RFC 2104 HMACs with a fixed key. Unlike ComputeHmac,
+// the key is set up only once, so each HMAC only hashes its input.
+class HmacContext {
+ public:
+  // Returns nullptr if there is no digest with the name |alg|.
+  static std::unique_ptr<HmacContext> Create(const std::string& alg,
+                                             const void* key,
+                                             size_t key_len);
+  virtual ~HmacContext() {}
+  // Returns the HMAC output size (e.g. 20 bytes for SHA-1).
+  virtual size_t Size() const = 0;
+  // Updates the HMAC with |len| bytes from |buf|.
+  virtual void Update(const void* buf, size_t len) = 0;
+  // Outputs the HMAC to |buf| with length |len|, and resets the context for
+  // the next HMAC with the same key. Returns the number of bytes written, i.e.
+  // Size(), or 0 if |len| was too small.
+  virtual size_t Finish(void* buf, size_t len) = 0;
+};
+
 // A whitelist of approved digest algorithms from RFC 4572 (FIPS 180).
 bool IsFips180DigestAlgorithm(const std::string& alg);
 
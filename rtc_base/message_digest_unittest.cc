@@ -146,6 +146,36 @@ TEST(MessageDigestTest, TestSha1Hmac) {
                         input.size(), output, sizeof(output) - 1));
 }
 
+TEST(MessageDigestTest, TestSha1HmacContext) {
+  std::string key(80, '\xaa');
+  std::unique_ptr<HmacContext> hmac =
+      HmacContext::Create(DIGEST_SHA_1, key.c_str(), key.size());
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ(20U, hmac->Size());
+
+  // The context can be reused for several inputs, and an input can be passed
+  // in several parts.
+  std::string input("Test Using Larger Than Block-Size Key - Hash Key First");
+  char output[20];
+  for (int i = 0; i < 2; ++i) {
+    hmac->Update(input.c_str(), 10);
+    hmac->Update(input.c_str() + 10, input.size() - 10);
+    EXPECT_EQ(sizeof(output), hmac->Finish(output, sizeof(output)));
+    EXPECT_EQ("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+              hex_encode(output, sizeof(output)));
+  }
+  std::string other_input(
+      "Test Using Larger Than Block-Size Key and Larger Than One Block-Size "
+      "Data");
+  hmac->Update(other_input.c_str(), other_input.size());
+  EXPECT_EQ(sizeof(output), hmac->Finish(output, sizeof(output)));
+  EXPECT_EQ("e8e99d0f45237d786d6bbaa7965c7808bbff1a91",
+            hex_encode(output, sizeof(output)));
+  EXPECT_EQ(0U, hmac->Finish(output, sizeof(output) - 1));
+
+  EXPECT_FALSE(HmacContext::Create("sha-9000", key.c_str(), key.size()));
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
@@ -9,6 +9,9 @@
  */
 #include "rtc_base/message_queue.h"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -25,6 +28,11 @@ namespace {
 
 const int kMaxMsgLatency = 150;                // 150 ms
 const int kSlowDispatchLoggingThreshold = 50;  // 50 ms
+// The most list nodes that are kept for reuse by a message queue.
+const size_t kMaxFreeMessages = 128;
+// Delays and execution times up to this are kept in an array by the dispatch
+// statistics, longer ones in a map.
+const uint32_t kDispatchStatsLongTailBoundaryMs = 100;
 
 class RTC_SCOPED_LOCKABLE MarkProcessingCritScope {
  public:
@@ -279,8 +287,9 @@ bool MessageQueue::Get(Message* pmsg, int cmsWait, bool process_io) {
               cmsDelayNext = TimeDiff(dmsgq_.top().msTrigger_, msCurrent);
               break;
             }
-            msgq_.push_back(dmsgq_.top().msg_);
+            PushMessage(dmsgq_.top().msg_);
             dmsgq_.pop();
+            PopClearedDelayedMessages();
           }
         }
         // Pull a message off the message queue, if available.
@@ -288,7 +297,7 @@ bool MessageQueue::Get(Message* pmsg, int cmsWait, bool process_io) {
           break;
         } else {
           *pmsg = msgq_.front();
-          msgq_.pop_front();
+          RemoveMessage(msgq_.begin());
         }
       }  // crit_ is released here.
 
@@ -359,17 +368,20 @@ void MessageQueue::Post(const Location& posted_from,
   // Add the message to the end of the queue
   // Signal for the multiplexer to return
 
+  Message msg;
+  msg.posted_from = posted_from;
+  msg.phandler = phandler;
+  msg.message_id = id;
+  msg.pdata = pdata;
+  if (time_sensitive) {
+    msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
+  }
+  if (DispatchStatsEnabled()) {
+    msg.queued_time_ms = TimeMillis();
+  }
   {
     CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
-    if (time_sensitive) {
-      msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
-    }
-    msgq_.push_back(msg);
+    PushMessage(msg);
   }
   WakeUpSocketServer();
 }
@@ -417,13 +429,17 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
   // Add to the priority queue. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
+  Message msg;
+  msg.posted_from = posted_from;
+  msg.phandler = phandler;
+  msg.message_id = id;
+  msg.pdata = pdata;
+  if (DispatchStatsEnabled()) {
+    // Queue delay of a delayed message counts from when it is due.
+    msg.queued_time_ms = tstamp;
+  }
   {
     CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
     DelayedMessage dmsg(cmsDelay, tstamp, dmsgq_next_num_, msg);
     dmsgq_.push(dmsg);
     // If this message queue processes 1 message every millisecond for 50 days,
@@ -481,29 +497,56 @@ void MessageQueue::ClearInternal(MessageHandler* phandler,
       } else {
         delete it->pdata;
       }
-      it = msgq_.erase(it);
+      it = RemoveMessage(it);
     } else {
       ++it;
     }
   }
 
-  // Remove from priority queue. Not directly iterable, so use this approach
+  // Remove from priority queue. Not directly iterable, so the removed
+  // messages are marked as cleared instead, which keeps the heap valid, and
+  // popped once they reach the top. This keeps clearing, which is done e.g.
+  // whenever a StunRequest is destroyed, linear in the number of delayed
+  // messages, without rebuilding the heap.
 
-  PriorityQueue::container_type::iterator new_end = dmsgq_.container().begin();
-  for (PriorityQueue::container_type::iterator it = new_end;
-       it != dmsgq_.container().end(); ++it) {
-    if (it->msg_.Match(phandler, id)) {
-      if (removed) {
-        removed->push_back(it->msg_);
-      } else {
-        delete it->msg_.pdata;
-      }
+  for (DelayedMessage& dmsg : dmsgq_.container()) {
+    if (dmsg.cleared_ || !dmsg.msg_.Match(phandler, id)) {
+      continue;
+    }
+    if (removed) {
+      removed->push_back(dmsg.msg_);
     } else {
-      *new_end++ = *it;
+      delete dmsg.msg_.pdata;
     }
+    dmsg.msg_.pdata = nullptr;
+    dmsg.cleared_ = true;
+    ++dmsgq_cleared_count_;
+  }
+  PopClearedDelayedMessages();
+}
+
+void MessageQueue::PopClearedDelayedMessages() {
+  while (!dmsgq_.empty() && dmsgq_.top().cleared_) {
+    dmsgq_.pop();
+    --dmsgq_cleared_count_;
+  }
+}
+
+void MessageQueue::PushMessage(const Message& msg) {
+  if (free_messages_.empty()) {
+    msgq_.push_back(msg);
+    return;
   }
-  dmsgq_.container().erase(new_end, dmsgq_.container().end());
-  dmsgq_.reheap();
+  msgq_.splice(msgq_.end(), free_messages_, free_messages_.begin());
+  msgq_.back() = msg;
+}
+
+MessageList::iterator MessageQueue::RemoveMessage(MessageList::iterator it) {
+  if (free_messages_.size() >= kMaxFreeMessages)
+    return msgq_.erase(it);
+  MessageList::iterator next = std::next(it);
+  free_messages_.splice(free_messages_.end(), msgq_, it);
+  return next;
 }
 
 void MessageQueue::Dispatch(Message* pmsg) {
@@ -514,6 +557,9 @@ void MessageQueue::Dispatch(Message* pmsg) {
   pmsg->phandler->OnMessage(pmsg);
   int64_t end_time = TimeMillis();
   int64_t diff = TimeDiff(end_time, start_time);
+  if (DispatchStatsEnabled()) {
+    UpdateDispatchStats(*pmsg, start_time, diff);
+  }
   if (diff >= kSlowDispatchLoggingThreshold) {
     RTC_LOG(LS_INFO) << "Message took " << diff
                      << "ms to dispatch. Posted from: "
@@ -521,4 +567,53 @@ void MessageQueue::Dispatch(Message* pmsg) {
   }
 }
 
+void MessageQueue::EnableDispatchStats() {
+  {
+    CritScope cs(&dispatch_stats_crit_);
+    if (!queue_delay_ms_) {
+      queue_delay_ms_ = std::make_unique<HistogramPercentileCounter>(
+          kDispatchStatsLongTailBoundaryMs);
+      execution_time_ms_ = std::make_unique<HistogramPercentileCounter>(
+          kDispatchStatsLongTailBoundaryMs);
+    }
+  }
+  AtomicOps::ReleaseStore(&dispatch_stats_enabled_, 1);
+}
+
+MessageQueue::DispatchStats MessageQueue::GetDispatchStats() const {
+  DispatchStats stats;
+  CritScope cs(&dispatch_stats_crit_);
+  if (!queue_delay_ms_)
+    return stats;
+  stats.dispatched_messages = dispatched_messages_;
+  stats.queue_delay_p50_ms = queue_delay_ms_->GetPercentile(0.5f);
+  stats.queue_delay_p99_ms = queue_delay_ms_->GetPercentile(0.99f);
+  stats.execution_time_p50_ms = execution_time_ms_->GetPercentile(0.5f);
+  stats.execution_time_p99_ms = execution_time_ms_->GetPercentile(0.99f);
+  stats.longest_execution_time_ms = std::max<int64_t>(
+      longest_execution_time_ms_, 0);
+  stats.longest_execution_posted_from = longest_execution_posted_from_;
+  return stats;
+}
+
+bool MessageQueue::DispatchStatsEnabled() const {
+  return AtomicOps::AcquireLoad(&dispatch_stats_enabled_) != 0;
+}
+
+void MessageQueue::UpdateDispatchStats(const Message& msg,
+                                       int64_t dispatch_time_ms,
+                                       int64_t execution_time_ms) {
+  CritScope cs(&dispatch_stats_crit_);
+  ++dispatched_messages_;
+  if (msg.queued_time_ms >= 0) {
+    queue_delay_ms_->Add(static_cast<uint32_t>(
+        std::max<int64_t>(dispatch_time_ms - msg.queued_time_ms, 0)));
+  }
+  execution_time_ms_->Add(static_cast<uint32_t>(execution_time_ms));
+  if (execution_time_ms > longest_execution_time_ms_) {
+    longest_execution_time_ms_ = execution_time_ms;
+    longest_execution_posted_from_ = msg.posted_from;
+  }
+}
+
 }  // namespace rtc
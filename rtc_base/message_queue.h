@@ -19,11 +19,13 @@
 #include <queue>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/location.h"
 #include "rtc_base/message_handler.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -153,7 +155,11 @@ const uint32_t MQID_DISPOSE = static_cast<uint32_t>(-2);
 
 struct Message {
   Message()
-      : phandler(nullptr), message_id(0), pdata(nullptr), ts_sensitive(0) {}
+      : phandler(nullptr),
+        message_id(0),
+        pdata(nullptr),
+        ts_sensitive(0),
+        queued_time_ms(-1) {}
   inline bool Match(MessageHandler* handler, uint32_t id) const {
     return (handler == nullptr || handler == phandler) &&
            (id == MQID_ANY || id == message_id);
@@ -163,6 +169,9 @@ struct Message {
   uint32_t message_id;
   MessageData* pdata;
   int64_t ts_sensitive;
+  // When the message was posted, or when a delayed message was due, if the
+  // queue collects dispatch statistics; -1 otherwise.
+  int64_t queued_time_ms;
 };
 
 typedef std::list<Message> MessageList;
@@ -187,6 +196,9 @@ class DelayedMessage {
   int64_t msTrigger_;
   uint32_t num_;
   Message msg_;
+  // Set when the message is cleared while in the priority queue; it's then
+  // dropped when it reaches the top instead of being dispatched.
+  bool cleared_ = false;
 };
 
 class RTC_EXPORT MessageQueue {
@@ -261,10 +273,31 @@ class RTC_EXPORT MessageQueue {
   // Amount of time until the next message can be retrieved
   virtual int GetDelay();
 
+  // Statistics of the messages dispatched by this queue since
+  // EnableDispatchStats() was called. The queue delay of a message is the time
+  // from when it was posted, or when a delayed message was due, until it was
+  // dispatched; sent messages have none.
+  struct DispatchStats {
+    int64_t dispatched_messages = 0;
+    absl::optional<uint32_t> queue_delay_p50_ms;
+    absl::optional<uint32_t> queue_delay_p99_ms;
+    absl::optional<uint32_t> execution_time_p50_ms;
+    absl::optional<uint32_t> execution_time_p99_ms;
+    int64_t longest_execution_time_ms = 0;
+    // Where the message that took the longest to dispatch was posted from.
+    Location longest_execution_posted_from;
+  };
+  // Starts collecting dispatch statistics. Disabled by default, since it
+  // reads the clock for every posted message. May be called on any thread.
+  void EnableDispatchStats();
+  // May be called on any thread.
+  DispatchStats GetDispatchStats() const;
+
   bool empty() const { return size() == 0u; }
   size_t size() const {
     CritScope cs(&crit_);  // msgq_.size() is not thread safe.
-    return msgq_.size() + dmsgq_.size() + (fPeekKeep_ ? 1u : 0u);
+    return msgq_.size() + dmsgq_.size() - dmsgq_cleared_count_ +
+           (fPeekKeep_ ? 1u : 0u);
   }
 
   // Internally posts a message which causes the doomed object to be deleted
@@ -309,11 +342,30 @@ class RTC_EXPORT MessageQueue {
 
   void WakeUpSocketServer();
 
+  // Pops the delayed messages at the top of |dmsgq_| that were cleared, so
+  // that the top, if any, is a message to be dispatched.
+  void PopClearedDelayedMessages() RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+
+  // Appends |msg| to |msgq_|, reusing a list node of |free_messages_| if
+  // there is one.
+  void PushMessage(const Message& msg) RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+  // Removes |it| from |msgq_|, keeping its list node in |free_messages_| for
+  // reuse, and returns the iterator to the next message.
+  MessageList::iterator RemoveMessage(MessageList::iterator it)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+
+  bool DispatchStatsEnabled() const;
+
   bool fPeekKeep_;
   Message msgPeek_;
   MessageList msgq_ RTC_GUARDED_BY(crit_);
+  // List nodes of dispatched messages, moved back into |msgq_| when messages
+  // are posted, so that posting does not allocate once the queue is warm.
+  MessageList free_messages_ RTC_GUARDED_BY(crit_);
   PriorityQueue dmsgq_ RTC_GUARDED_BY(crit_);
   uint32_t dmsgq_next_num_ RTC_GUARDED_BY(crit_);
+  // The number of messages in |dmsgq_| that are cleared.
+  size_t dmsgq_cleared_count_ RTC_GUARDED_BY(crit_) = 0;
   CriticalSection crit_;
   bool fInitialized_;
   bool fDestroyed_;
@@ -321,6 +373,23 @@ class RTC_EXPORT MessageQueue {
  private:
   volatile int stop_;
 
+  void UpdateDispatchStats(const Message& msg,
+                           int64_t dispatch_time_ms,
+                           int64_t execution_time_ms);
+
+  volatile int dispatch_stats_enabled_ = 0;
+  CriticalSection dispatch_stats_crit_;
+  int64_t dispatched_messages_ RTC_GUARDED_BY(dispatch_stats_crit_) = 0;
+  // Created by EnableDispatchStats(), to not add them to every queue.
+  std::unique_ptr<HistogramPercentileCounter> queue_delay_ms_
+      RTC_GUARDED_BY(dispatch_stats_crit_);
+  std::unique_ptr<HistogramPercentileCounter> execution_time_ms_
+      RTC_GUARDED_BY(dispatch_stats_crit_);
+  int64_t longest_execution_time_ms_ RTC_GUARDED_BY(dispatch_stats_crit_) =
+      -1;
+  Location longest_execution_posted_from_
+      RTC_GUARDED_BY(dispatch_stats_crit_);
+
   // The SocketServer might not be owned by MessageQueue.
   SocketServer* const ss_;
   // Used if SocketServer ownership lies with |this|.
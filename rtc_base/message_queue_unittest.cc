@@ -121,9 +121,103 @@ TEST_F(MessageQueueTest, DiposeHandlerWithPostedMessagePending) {
   EXPECT_TRUE(deleted);
 }
 
+TEST_F(MessageQueueTest, ClearedDelayedMessagesAreNotProcessed) {
+  NullSocketServer nullss;
+  MessageQueue q(&nullss, true);
+  int64_t now = TimeMillis();
+  q.PostAt(RTC_FROM_HERE, now - 2, nullptr, 0);
+  q.PostAt(RTC_FROM_HERE, now - 1, nullptr, 1);
+  q.PostAt(RTC_FROM_HERE, now, nullptr, 2);
+  q.PostAt(RTC_FROM_HERE, now + 100000, nullptr, 3);
+  EXPECT_EQ(4u, q.size());
+
+  // Clear the first message, which is at the top of the queue, and one in the
+  // middle of it.
+  MessageList removed;
+  q.Clear(nullptr, 0, &removed);
+  q.Clear(nullptr, 2, &removed);
+  EXPECT_EQ(2u, removed.size());
+  EXPECT_EQ(2u, q.size());
+
+  Message msg;
+  EXPECT_TRUE(q.Get(&msg, 0));
+  EXPECT_EQ(1u, msg.message_id);
+  EXPECT_FALSE(q.Get(&msg, 0));
+  EXPECT_EQ(1u, q.size());
+
+  q.Clear(nullptr, 3);
+  EXPECT_TRUE(q.empty());
+  EXPECT_FALSE(q.Get(&msg, 0));
+}
+
+TEST_F(MessageQueueTest, ReusesListNodesOfDispatchedMessages) {
+  Post(RTC_FROM_HERE, nullptr, 0);
+  Post(RTC_FROM_HERE, nullptr, 1);
+  Post(RTC_FROM_HERE, nullptr, 2);
+  Message msg;
+  EXPECT_TRUE(Get(&msg, 0));
+  EXPECT_TRUE(Get(&msg, 0));
+  {
+    CritScope cs(&crit_);
+    EXPECT_EQ(2u, free_messages_.size());
+  }
+
+  // Posting takes the free nodes, and messages are still dispatched in order
+  // and cleared as before.
+  Post(RTC_FROM_HERE, nullptr, 3);
+  Post(RTC_FROM_HERE, nullptr, 4);
+  Post(RTC_FROM_HERE, nullptr, 5);
+  {
+    CritScope cs(&crit_);
+    EXPECT_TRUE(free_messages_.empty());
+  }
+  Clear(nullptr, 4);
+  EXPECT_EQ(3u, size());
+  for (uint32_t id : {2u, 3u, 5u}) {
+    EXPECT_TRUE(Get(&msg, 0));
+    EXPECT_EQ(id, msg.message_id);
+  }
+  EXPECT_FALSE(Get(&msg, 0));
+  CritScope cs(&crit_);
+  EXPECT_EQ(4u, free_messages_.size());
+}
+
 // Ensure that ProcessAllMessageQueues does its essential function; process
 // all messages (both delayed and non delayed) up until the current time, on
 // all registered message queues.
+class SleepingMessageHandler : public MessageHandler {
+ public:
+  void OnMessage(Message* msg) override { Thread::SleepMs(msg->message_id); }
+};
+
+TEST_F(MessageQueueTest, CollectsDispatchStatsWhenEnabled) {
+  SleepingMessageHandler handler;
+  Message msg;
+  Post(RTC_FROM_HERE, &handler, 0);
+  ASSERT_TRUE(Get(&msg, 0));
+  Dispatch(&msg);
+  EXPECT_EQ(0, GetDispatchStats().dispatched_messages);
+  EXPECT_FALSE(GetDispatchStats().execution_time_p50_ms);
+
+  EnableDispatchStats();
+  const Location slow_location = RTC_FROM_HERE;
+  Post(RTC_FROM_HERE, &handler, 0);
+  Post(slow_location, &handler, 20);
+  Post(RTC_FROM_HERE, &handler, 0);
+  while (Get(&msg, 0))
+    Dispatch(&msg);
+
+  DispatchStats stats = GetDispatchStats();
+  EXPECT_EQ(3, stats.dispatched_messages);
+  ASSERT_TRUE(stats.queue_delay_p99_ms);
+  EXPECT_GE(*stats.queue_delay_p99_ms, 20u);
+  ASSERT_TRUE(stats.execution_time_p99_ms);
+  EXPECT_GE(*stats.execution_time_p99_ms, 20u);
+  EXPECT_GE(stats.longest_execution_time_ms, 20);
+  EXPECT_STREQ(slow_location.file_and_line(),
+               stats.longest_execution_posted_from.file_and_line());
+}
+
 TEST(MessageQueueManager, ProcessAllMessageQueues) {
   Event entered_process_all_message_queues(true, false);
   auto a = Thread::CreateWithSocketServer();
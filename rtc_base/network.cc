@@ -33,6 +33,7 @@
 #include <stdio.h>
 
 #include <memory>
+#include <set>
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
@@ -401,11 +402,12 @@ void NetworkManagerBase::MergeNetworkList(const NetworkList& new_networks,
   if (*changed) {
     networks_ = merged_list;
     // Reset the active states of all networks.
+    const std::set<const Network*> active_networks(networks_.begin(),
+                                                   networks_.end());
     for (const auto& kv : networks_map_) {
       Network* network = kv.second;
       // If |network| is in the newly generated |networks_|, it is active.
-      bool found = absl::c_linear_search(networks_, network);
-      network->set_active(found);
+      network->set_active(active_networks.count(network) > 0);
     }
     absl::c_sort(networks_, SortNetworks);
     // Now network interfaces are sorted, we should set the preference value
@@ -481,6 +483,8 @@ BasicNetworkManager::~BasicNetworkManager() {}
 
 void BasicNetworkManager::OnNetworksChanged() {
   RTC_LOG(LS_INFO) << "Network change was observed";
+  // The network monitor may also have changed the adapter types.
+  interfaces_fingerprint_ = absl::nullopt;
   UpdateNetworksOnce();
 }
 
@@ -494,6 +498,35 @@ bool BasicNetworkManager::CreateNetworks(bool include_ignored,
 }
 
 #elif defined(WEBRTC_POSIX)
+namespace {
+// FNV-1a over everything in |interfaces| that ConvertIfAddrs looks at.
+uint64_t InterfacesFingerprint(const struct ifaddrs* interfaces) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  auto add = [&hash](const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3ull;
+    }
+  };
+  for (const struct ifaddrs* cursor = interfaces; cursor != nullptr;
+       cursor = cursor->ifa_next) {
+    add(cursor->ifa_name, strlen(cursor->ifa_name) + 1);
+    add(&cursor->ifa_flags, sizeof(cursor->ifa_flags));
+    for (const sockaddr* address : {cursor->ifa_addr, cursor->ifa_netmask}) {
+      if (address && address->sa_family == AF_INET) {
+        add(address, sizeof(sockaddr_in));
+      } else if (address && address->sa_family == AF_INET6) {
+        add(address, sizeof(sockaddr_in6));
+      } else {
+        add("", 1);
+      }
+    }
+  }
+  return hash;
+}
+}  // namespace
+
 void BasicNetworkManager::ConvertIfAddrs(struct ifaddrs* interfaces,
                                          IfAddrsConverter* ifaddrs_converter,
                                          bool include_ignored,
@@ -602,6 +635,34 @@ bool BasicNetworkManager::CreateNetworks(bool include_ignored,
   return true;
 }
 
+bool BasicNetworkManager::CreateNetworksIfChanged(NetworkList* networks,
+                                                  bool* unchanged) {
+  *unchanged = false;
+  struct ifaddrs* interfaces;
+  int error = getifaddrs(&interfaces);
+  if (error != 0) {
+    RTC_LOG_ERR(LERROR) << "getifaddrs failed to gather interface data: "
+                        << error;
+    return false;
+  }
+
+  // Converting and merging the interfaces is what takes time with many of
+  // them; skip it when they are the same as last time. Whether a network is on
+  // a default route is not in the interfaces, so that is always checked.
+  const uint64_t fingerprint = InterfacesFingerprint(interfaces);
+  if (!ignore_non_default_routes_ && interfaces_fingerprint_ == fingerprint) {
+    *unchanged = true;
+  } else {
+    std::unique_ptr<IfAddrsConverter> ifaddrs_converter(
+        CreateIfAddrsConverter());
+    ConvertIfAddrs(interfaces, ifaddrs_converter.get(), false, networks);
+    interfaces_fingerprint_ = fingerprint;
+  }
+
+  freeifaddrs(interfaces);
+  return true;
+}
+
 #elif defined(WEBRTC_WIN)
 
 unsigned int GetPrefix(PIP_ADAPTER_PREFIX prefixlist,
@@ -858,6 +919,7 @@ void BasicNetworkManager::StopUpdating() {
   if (!start_count_) {
     thread_->Clear(this);
     sent_first_update_ = false;
+    interfaces_fingerprint_ = absl::nullopt;
     StopNetworkMonitor();
   }
 }
@@ -926,6 +988,14 @@ IPAddress BasicNetworkManager::QueryDefaultLocalAddress(int family) const {
   return socket->GetLocalAddress().ipaddr();
 }
 
+#if !defined(WEBRTC_POSIX) || defined(__native_client__)
+bool BasicNetworkManager::CreateNetworksIfChanged(NetworkList* networks,
+                                                  bool* unchanged) {
+  *unchanged = false;
+  return CreateNetworks(false, networks);
+}
+#endif
+
 void BasicNetworkManager::UpdateNetworksOnce() {
   if (!start_count_)
     return;
@@ -933,12 +1003,14 @@ void BasicNetworkManager::UpdateNetworksOnce() {
   RTC_DCHECK(Thread::Current() == thread_);
 
   NetworkList list;
-  if (!CreateNetworks(false, &list)) {
+  bool unchanged;
+  if (!CreateNetworksIfChanged(&list, &unchanged)) {
     SignalError();
   } else {
-    bool changed;
+    bool changed = false;
     NetworkManager::Stats stats;
-    MergeNetworkList(list, &changed, &stats);
+    if (!unchanged)
+      MergeNetworkList(list, &changed, &stats);
     set_default_local_addresses(QueryDefaultLocalAddress(AF_INET),
                                 QueryDefaultLocalAddress(AF_INET6));
     if (changed || !sent_first_update_) {
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/mdns_responder_interface.h"
 #include "rtc_base/message_handler.h"
@@ -282,12 +283,19 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
   // Only updates the networks; does not reschedule the next update.
   void UpdateNetworksOnce();
 
+  // Same as CreateNetworks(false, networks), except that it sets |*unchanged|
+  // instead when the interfaces are the same as in the previous call.
+  bool CreateNetworksIfChanged(NetworkList* networks, bool* unchanged);
+
   Thread* thread_;
   bool sent_first_update_;
   int start_count_;
   std::vector<std::string> network_ignore_list_;
   bool ignore_non_default_routes_;
   std::unique_ptr<NetworkMonitorInterface> network_monitor_;
+  // Fingerprint of the interfaces that the networks were last created from,
+  // unset when they need to be created anyway.
+  absl::optional<uint64_t> interfaces_fingerprint_;
 };
 
 // Represents a Unix-type network interface, with a name and single address.
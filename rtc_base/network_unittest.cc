@@ -18,6 +18,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/net_helpers.h"
 #include "rtc_base/network_monitor.h"
+#include "rtc_base/string_encode.h"
 #if defined(WEBRTC_POSIX)
 #include <net/if.h>
 #include <sys/types.h>
@@ -141,6 +142,12 @@ class NetworkTest : public ::testing::Test, public sigslot::has_slots<> {
                                    include_ignored, networks);
   }
 
+  static bool CreateNetworksIfChanged(BasicNetworkManager& network_manager,
+                                      NetworkManager::NetworkList* networks,
+                                      bool* unchanged) {
+    return network_manager.CreateNetworksIfChanged(networks, unchanged);
+  }
+
   struct sockaddr_in6* CreateIpv6Addr(const std::string& ip_string,
                                       uint32_t scope_id) {
     struct sockaddr_in6* ipv6_addr =
@@ -355,6 +362,52 @@ TEST_F(NetworkTest, TestUpdateNetworks) {
   EXPECT_TRUE(callback_called_);
 }
 
+#if defined(WEBRTC_POSIX)
+// Verify that the networks are only created again when the interfaces change.
+TEST_F(NetworkTest, TestCreateNetworksIfChangedSkipsSameInterfaces) {
+  BasicNetworkManager manager;
+  NetworkManager::NetworkList list;
+  bool unchanged;
+  ASSERT_TRUE(CreateNetworksIfChanged(manager, &list, &unchanged));
+  EXPECT_FALSE(unchanged);
+  for (Network* network : list)
+    delete network;
+  list.clear();
+
+  ASSERT_TRUE(CreateNetworksIfChanged(manager, &list, &unchanged));
+  EXPECT_TRUE(unchanged);
+  EXPECT_TRUE(list.empty());
+}
+#endif  // defined(WEBRTC_POSIX)
+
+// Verify that networks that are left out of a merge are no longer active.
+TEST_F(NetworkTest, TestMergeNetworkListDeactivatesRemovedNetworks) {
+  const int kNumNetworks = 100;
+  BasicNetworkManager manager;
+  NetworkManager::NetworkList list;
+  for (int i = 0; i < kNumNetworks; ++i) {
+    Network* network = new Network("test_eth" + rtc::ToString(i), "Test",
+                                   IPAddress(0x0a000000U + (i << 8)), 24);
+    network->AddIP(IPAddress(0x0a000001U + (i << 8)));
+    list.push_back(network);
+  }
+  NetworkManager::NetworkList all_networks = list;
+  bool changed;
+  MergeNetworkList(manager, list, &changed);
+  EXPECT_TRUE(changed);
+
+  // Every other network goes away.
+  list.clear();
+  for (int i = 0; i < kNumNetworks; i += 2)
+    list.push_back(new Network(*all_networks[i]));
+  MergeNetworkList(manager, list, &changed);
+  EXPECT_TRUE(changed);
+  for (int i = 0; i < kNumNetworks; ++i)
+    EXPECT_EQ(i % 2 == 0, all_networks[i]->active()) << i;
+  manager.GetNetworks(&list);
+  EXPECT_EQ(static_cast<size_t>(kNumNetworks / 2), list.size());
+}
+
 // Verify that MergeNetworkList() merges network lists properly.
 TEST_F(NetworkTest, TestBasicMergeNetworkList) {
   Network ipv4_network1("test_eth0", "Test Network Adapter 1",
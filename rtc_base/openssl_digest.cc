@@ -10,6 +10,8 @@
 
 #include "rtc_base/openssl_digest.h"
 
+#include <openssl/hmac.h>
+
 #include "rtc_base/checks.h"  // RTC_DCHECK, RTC_CHECK
 #include "rtc_base/openssl.h"
 
@@ -55,6 +57,47 @@ size_t OpenSSLDigest::Finish(void* buf, size_t len) {
   return md_len;
 }
 
+OpenSSLHmacContext::OpenSSLHmacContext(const std::string& algorithm,
+                                       const void* key,
+                                       size_t key_len) {
+  ctx_ = HMAC_CTX_new();
+  RTC_CHECK(ctx_ != nullptr);
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md_) ||
+      !HMAC_Init_ex(ctx_, key, key_len, md_, nullptr)) {
+    md_ = nullptr;
+  }
+}
+
+OpenSSLHmacContext::~OpenSSLHmacContext() {
+  HMAC_CTX_free(ctx_);
+}
+
+size_t OpenSSLHmacContext::Size() const {
+  if (!md_) {
+    return 0;
+  }
+  return EVP_MD_size(md_);
+}
+
+void OpenSSLHmacContext::Update(const void* buf, size_t len) {
+  if (!md_) {
+    return;
+  }
+  HMAC_Update(ctx_, static_cast<const unsigned char*>(buf), len);
+}
+
+size_t OpenSSLHmacContext::Finish(void* buf, size_t len) {
+  if (!md_ || len < Size()) {
+    return 0;
+  }
+  unsigned int md_len;
+  HMAC_Final(ctx_, static_cast<unsigned char*>(buf), &md_len);
+  // Keeps the precomputed key state; prepares for future Update()s.
+  HMAC_Init_ex(ctx_, nullptr, 0, nullptr, nullptr);
+  RTC_DCHECK(md_len == Size());
+  return md_len;
+}
+
 bool OpenSSLDigest::GetDigestEVP(const std::string& algorithm,
                                  const EVP_MD** mdp) {
   const EVP_MD* md;
@@ -45,6 +45,24 @@ class OpenSSLDigest final : public MessageDigest {
   const EVP_MD* md_;
 };
 
+// An implementation of the HMAC context class that uses OpenSSL.
+class OpenSSLHmacContext final : public HmacContext {
+ public:
+  // Creates an OpenSSLHmacContext with |algorithm| as the hash algorithm,
+  // keyed with |key_len| bytes of |key|.
+  OpenSSLHmacContext(const std::string& algorithm,
+                     const void* key,
+                     size_t key_len);
+  ~OpenSSLHmacContext() override;
+  size_t Size() const override;
+  void Update(const void* buf, size_t len) override;
+  size_t Finish(void* buf, size_t len) override;
+
+ private:
+  HMAC_CTX* ctx_ = nullptr;
+  const EVP_MD* md_ = nullptr;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_OPENSSL_DIGEST_H_
@@ -21,12 +21,17 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <atomic>
+#include <list>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
@@ -34,7 +39,9 @@
 #include "rtc_base/openssl_identity.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/string_encode.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 
 #if (OPENSSL_VERSION_NUMBER < 0x10100000L)
@@ -145,6 +152,96 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+// Set by EnableDtlsSessionResumption.
+std::atomic<bool> g_dtls_session_resumption_enabled(false);
+
+// Sessions are only resumed by streams with this context.
+const unsigned char kDtlsSessionIdContext[] = "WebRTC DTLS";
+
+// Number of client sessions kept by DtlsSessionCache.
+constexpr size_t kMaxCachedDtlsSessions = 1000;
+
+// Size of the key name, HMAC key and AES key passed to
+// SSL_CTX_set_tlsext_ticket_keys.
+#ifdef OPENSSL_IS_BORINGSSL
+constexpr size_t kTicketKeysSize = 48;
+#else
+constexpr size_t kTicketKeysSize = 80;
+#endif
+
+// Caches client sessions of DTLS connections for resumption. Unlike
+// OpenSSLSessionCache, which is owned by an OpenSSLAdapterFactory and keyed by
+// hostname, there is a single instance that is shared by the streams of all
+// threads, and sessions are keyed by certificate digests. The least recently
+// used session is evicted when the cache is full.
+//
+// The instance also holds the session ticket keys of servers, so that a
+// ticket issued by any stream can be decrypted by any other stream.
+class DtlsSessionCache {
+ public:
+  static DtlsSessionCache* Instance() {
+    static DtlsSessionCache* const instance = new DtlsSessionCache();
+    return instance;
+  }
+
+  // Returns the session cached for |key| with a new reference, or nullptr.
+  SSL_SESSION* Lookup(const std::string& key) {
+    CritScope lock(&crit_);
+    auto it = sessions_by_key_.find(key);
+    if (it == sessions_by_key_.end()) {
+      return nullptr;
+    }
+    sessions_.splice(sessions_.begin(), sessions_, it->second);
+    SSL_SESSION_up_ref(it->second->second);
+    return it->second->second;
+  }
+
+  // Takes over a reference to |session| and replaces any session cached for
+  // |key|.
+  void Add(const std::string& key, SSL_SESSION* session) {
+    CritScope lock(&crit_);
+    RemoveLocked(key);
+    if (sessions_.size() >= kMaxCachedDtlsSessions) {
+      RemoveLocked(sessions_.back().first);
+    }
+    sessions_.emplace_front(key, session);
+    sessions_by_key_[key] = sessions_.begin();
+  }
+
+  void Remove(const std::string& key) {
+    CritScope lock(&crit_);
+    RemoveLocked(key);
+  }
+
+  // Constant after construction, so accessed without locking.
+  uint8_t* ticket_keys() { return ticket_keys_; }
+
+ private:
+  using SessionList = std::list<std::pair<std::string, SSL_SESSION*>>;
+
+  DtlsSessionCache() {
+    RTC_CHECK(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)));
+  }
+
+  void RemoveLocked(const std::string& key)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_) {
+    auto it = sessions_by_key_.find(key);
+    if (it == sessions_by_key_.end()) {
+      return;
+    }
+    SSL_SESSION_free(it->second->second);
+    sessions_.erase(it->second);
+    sessions_by_key_.erase(it);
+  }
+
+  CriticalSection crit_;
+  // Most recently used first; holds a reference to each session.
+  SessionList sessions_ RTC_GUARDED_BY(crit_);
+  std::map<std::string, SessionList::iterator> sessions_by_key_
+      RTC_GUARDED_BY(crit_);
+  uint8_t ticket_keys_[kTicketKeysSize];
+};
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -469,6 +566,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+bool OpenSSLStreamAdapter::IsResumedSession() {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   // Don't allow StartSSL to be called twice.
   if (state_ != SSL_NONE) {
@@ -811,6 +912,22 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  if (ssl_mode_ == SSL_MODE_DTLS && role_ == SSL_CLIENT &&
+      g_dtls_session_resumption_enabled) {
+    // If the peer digest isn't known yet, the key is empty and the session is
+    // neither resumed nor cached.
+    session_cache_key_ = SessionCacheKey();
+    SSL_SESSION* session =
+        session_cache_key_.empty()
+            ? nullptr
+            : DtlsSessionCache::Instance()->Lookup(session_cache_key_);
+    if (session) {
+      RTC_LOG(LS_INFO) << "Offering cached DTLS session for resumption.";
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
   // Do the connect
   return ContinueSSL();
 }
@@ -828,6 +945,10 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_LOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) && !VerifyResumedSession()) {
+        SignalSSLHandshakeError(SSLHandshakeError::UNKNOWN);
+        return -1;
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
@@ -982,6 +1103,23 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     return nullptr;
   }
 
+  if (ssl_mode_ == SSL_MODE_DTLS && g_dtls_session_resumption_enabled) {
+    SSL_CTX_set_session_id_context(ctx, kDtlsSessionIdContext,
+                                   sizeof(kDtlsSessionIdContext));
+    if (role_ == SSL_CLIENT) {
+      // |ctx| only lives as long as this stream, so sessions are stored in
+      // DtlsSessionCache instead.
+      SSL_CTX_set_session_cache_mode(
+          ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+      SSL_CTX_sess_set_new_cb(ctx, NewSessionCallback);
+    } else if (!SSL_CTX_set_tlsext_ticket_keys(
+                   ctx, DtlsSessionCache::Instance()->ticket_keys(),
+                   kTicketKeysSize)) {
+      SSL_CTX_free(ctx);
+      return nullptr;
+    }
+  }
+
 #if !defined(NDEBUG)
   SSL_CTX_set_info_callback(ctx, OpenSSLAdapter::SSLInfoCallback);
 #endif
@@ -1092,6 +1230,55 @@ int OpenSSLStreamAdapter::SSLVerifyCallback(X509_STORE_CTX* store, void* arg) {
   return 1;
 }
 
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  // The local certificate is part of the key, since the server verifies the
+  // certificate of a resumed session against the digest it was given.
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_length)) {
+    return std::string();
+  }
+  return hex_encode(reinterpret_cast<const char*>(digest), digest_length) +
+         " " + peer_certificate_digest_algorithm_ + " " +
+         hex_encode(peer_certificate_digest_value_.data<char>(),
+                    peer_certificate_digest_value_.size());
+}
+
+bool OpenSSLStreamAdapter::VerifyResumedSession() {
+  RTC_LOG(LS_INFO) << "Resumed DTLS session.";
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    RTC_LOG(LS_WARNING) << "Resumed session has no peer certificate.";
+    return !GetClientAuthEnabled();
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+  X509_free(cert);
+
+  if (HasPeerCertificateDigest() && !VerifyPeerCertificate()) {
+    if (!session_cache_key_.empty()) {
+      DtlsSessionCache::Instance()->Remove(session_cache_key_);
+    }
+    return false;
+  }
+  return true;
+}
+
+int OpenSSLStreamAdapter::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  if (stream->session_cache_key_.empty()) {
+    return 0;
+  }
+  // Returning 1 transfers the reference to |session| to the cache.
+  DtlsSessionCache::Instance()->Add(stream->session_cache_key_, session);
+  return 1;
+}
+
 bool OpenSSLStreamAdapter::IsBoringSsl() {
 #ifdef OPENSSL_IS_BORINGSSL
   return true;
@@ -1175,6 +1362,10 @@ bool OpenSSLStreamAdapter::IsAcceptableCipher(const std::string& cipher,
   return false;
 }
 
+void OpenSSLStreamAdapter::EnableDtlsSessionResumption(bool enable) {
+  g_dtls_session_resumption_enabled = enable;
+}
+
 void OpenSSLStreamAdapter::EnableTimeCallbackForTesting() {
 #ifdef OPENSSL_IS_BORINGSSL
   g_use_time_callback_for_testing = true;
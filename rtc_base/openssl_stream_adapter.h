@@ -26,6 +26,10 @@
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
 namespace rtc {
 
 // This class was written with OpenSSLAdapter (a socket adapter) as a
@@ -112,12 +116,16 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   bool IsTlsConnected() override;
 
+  bool IsResumedSession() override;
+
   // Capabilities interfaces.
   static bool IsBoringSsl();
 
   static bool IsAcceptableCipher(int cipher, KeyType key_type);
   static bool IsAcceptableCipher(const std::string& cipher, KeyType key_type);
 
+  static void EnableDtlsSessionResumption(bool enable);
+
   // Use our timeutils.h source of timing in BoringSSL, allowing us to test
   // using a fake clock.
   static void EnableTimeCallbackForTesting();
@@ -175,6 +183,17 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // SSL_CTX_set_cert_verify_callback.
   static int SSLVerifyCallback(X509_STORE_CTX* store, void* arg);
 
+  // Returns the key that the session of this stream is cached under, or an
+  // empty string if the local certificate or the peer digest is unknown.
+  std::string SessionCacheKey() const;
+  // Takes the peer certificate from a resumed session, for which the
+  // verification callback isn't called, and verifies it if the digest is
+  // known.
+  bool VerifyResumedSession();
+  // Stores a new client session in the session cache. See
+  // SSL_CTX_sess_set_new_cb.
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
+
   bool WaitingToVerifyPeerCertificate() const {
     return GetClientAuthEnabled() && !peer_certificate_verified_;
   }
@@ -204,6 +223,8 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // The digest of the certificate that the peer must present.
   Buffer peer_certificate_digest_value_;
   std::string peer_certificate_digest_algorithm_;
+  // Set by a client with session resumption enabled, see SessionCacheKey.
+  std::string session_cache_key_;
 
   // The DtlsSrtp ciphers
   std::string srtp_ciphers_;
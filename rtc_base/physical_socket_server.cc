@@ -53,6 +53,7 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+#include <netinet/udp.h>
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -70,6 +71,17 @@ typedef void* SockOptArg;
 
 #endif  // WEBRTC_POSIX
 
+#if defined(WEBRTC_LINUX)
+// Upper bound on the number of datagrams read by a single recvmmsg call. The
+// per-call bookkeeping lives on the stack, so keep this modest.
+static const size_t kMaxRecvBatchSize = 64;
+// Upper bound on the number of datagrams passed to a single sendmmsg call.
+static const size_t kMaxSendBatchSize = 64;
+// The kernel refuses GSO sends of more than 64 segments or 64 KB in total.
+static const size_t kMaxGsoSegments = 64;
+static const size_t kMaxGsoBytes = 65000;
+#endif
+
 #if defined(WEBRTC_POSIX) && !defined(WEBRTC_MAC) && !defined(__native_client__)
 
 int64_t GetSocketRecvTimestamp(int socket) {
@@ -360,6 +372,120 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::SendToBatch(const OutgoingDatagram* datagrams,
+                                size_t count) {
+  if (!udp_ || count <= 1)
+    return Socket::SendToBatch(datagrams, count);
+
+  // UDP GSO lets the kernel split one large buffer into equally sized
+  // datagrams (only the last one may be shorter), so it applies when every
+  // datagram goes to the same destination with the same size.
+  size_t segment_size = datagrams[0].size;
+  bool can_segment = gso_supported_ && segment_size > 0 &&
+                     count <= kMaxGsoSegments &&
+                     segment_size * count <= kMaxGsoBytes;
+  for (size_t i = 1; can_segment && i < count; ++i) {
+    can_segment = datagrams[i].address == datagrams[0].address &&
+                  (datagrams[i].size == segment_size ||
+                   (i == count - 1 && datagrams[i].size < segment_size &&
+                    datagrams[i].size > 0));
+  }
+  if (can_segment) {
+    int sent = SendWithSegmentation(datagrams, count);
+    if (sent >= 0 || gso_supported_)
+      return sent;
+    // GSO is unavailable on this socket; fall through to sendmmsg.
+  }
+
+  count = std::min(count, kMaxSendBatchSize);
+  struct mmsghdr msgs[kMaxSendBatchSize];
+  struct iovec iovs[kMaxSendBatchSize];
+  sockaddr_storage addrs[kMaxSendBatchSize];
+  memset(msgs, 0, sizeof(msgs[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iovs[i].iov_len = datagrams[i].size;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(
+        datagrams[i].address.ToSockAddrStorage(&addrs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int sent = ::sendmmsg(s_, msgs, static_cast<unsigned int>(count),
+#if !defined(WEBRTC_ANDROID)
+                        // Suppress SIGPIPE. See above for explanation.
+                        MSG_NOSIGNAL
+#else
+                        0
+#endif
+  );
+  UpdateLastError();
+  MaybeRemapSendError();
+  if ((sent >= 0 && sent < static_cast<int>(count)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+}
+
+int PhysicalSocket::SendWithSegmentation(const OutgoingDatagram* datagrams,
+                                         size_t count) {
+  struct iovec iovs[kMaxGsoSegments];
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iovs[i].iov_len = datagrams[i].size;
+  }
+  sockaddr_storage addr;
+  union {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr align;
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = &addr;
+  msg.msg_namelen =
+      static_cast<socklen_t>(datagrams[0].address.ToSockAddrStorage(&addr));
+  msg.msg_iov = iovs;
+  msg.msg_iovlen = count;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t segment_size = static_cast<uint16_t>(datagrams[0].size);
+  memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  int sent = ::sendmsg(s_, &msg,
+#if !defined(WEBRTC_ANDROID)
+                       MSG_NOSIGNAL
+#else
+                       0
+#endif
+  );
+  UpdateLastError();
+  if (sent < 0) {
+    int error = GetError();
+    if (error == EINVAL || error == EIO || error == ENOPROTOOPT ||
+        error == EOPNOTSUPP) {
+      // Old kernels and devices without checksum offload reject GSO.
+      RTC_LOG(LS_INFO) << "UDP GSO unavailable, error " << error
+                       << "; using sendmmsg.";
+      gso_supported_ = false;
+      return sent;
+    }
+    MaybeRemapSendError();
+    if (IsBlockingError(GetError()))
+      EnableEvents(DE_WRITE);
+    return sent;
+  }
+  return static_cast<int>(count);
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -415,6 +541,72 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+  if (!udp_ || count <= 1)
+    return Socket::RecvFromBatch(datagrams, count);
+  count = std::min(count, kMaxRecvBatchSize);
+
+  if (!recv_timestamps_enabled_) {
+    // SIOCGSTAMP only reports the time of the last datagram, so ask the
+    // kernel to attach a timestamp to each of them instead.
+    int value = 1;
+    if (::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value)) ==
+        0) {
+      recv_timestamps_enabled_ = true;
+    } else {
+      RTC_LOG_E(LS_WARNING, EN, errno) << "setsockopt(SO_TIMESTAMP) failed";
+    }
+  }
+
+  struct mmsghdr msgs[kMaxRecvBatchSize];
+  struct iovec iovs[kMaxRecvBatchSize];
+  sockaddr_storage addrs[kMaxRecvBatchSize];
+  union {
+    char buf[CMSG_SPACE(sizeof(struct timeval))];
+    struct cmsghdr align;
+  } control[kMaxRecvBatchSize];
+  memset(msgs, 0, sizeof(msgs[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = datagrams[i].buffer;
+    iovs[i].iov_len = datagrams[i].capacity;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control[i].buf;
+    msgs[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+  }
+
+  int received = ::recvmmsg(s_, msgs, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  for (int i = 0; i < received; ++i) {
+    ReceivedDatagram& datagram = datagrams[i];
+    datagram.length = msgs[i].msg_len;
+    SocketAddressFromSockAddrStorage(addrs[i], &datagram.address);
+    datagram.timestamp = -1;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+         cmsg != nullptr; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET &&
+          cmsg->cmsg_type == SCM_TIMESTAMP) {
+        struct timeval tv;
+        memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        datagram.timestamp =
+            rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+            static_cast<int64_t>(tv.tv_usec);
+      }
+    }
+  }
+  // Like RecvFrom, always keep listening for more UDP data, even on error.
+  EnableEvents(DE_READ);
+  if (received < 0 && !IsBlockingError(GetError())) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << GetError();
+  }
+  return received;
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -556,6 +748,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
     case OPT_DSCP:
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
     default:
@@ -158,12 +158,22 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+#if defined(WEBRTC_LINUX)
+  // Coalesces the datagrams into a single UDP GSO send when they share a
+  // destination and segment size, and otherwise uses sendmmsg.
+  int SendToBatch(const OutgoingDatagram* datagrams, size_t count) override;
+#endif
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+#if defined(WEBRTC_LINUX)
+  // Uses recvmmsg to drain several datagrams per call, with per-datagram
+  // receive timestamps taken from SO_TIMESTAMP control messages.
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
+#endif
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -215,6 +225,13 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
  private:
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_LINUX)
+  int SendWithSegmentation(const OutgoingDatagram* datagrams, size_t count);
+
+  bool recv_timestamps_enabled_ = false;
+  // Cleared the first time the kernel rejects a UDP_SEGMENT send.
+  bool gso_supported_ = true;
+#endif
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
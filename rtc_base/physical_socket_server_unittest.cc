@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
@@ -461,6 +462,77 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, RecvFromBatchDrainsQueuedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> socket(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  EXPECT_EQ(3, socket->SendTo("foo", 3, address));
+  EXPECT_EQ(4, socket->SendTo("barz", 4, address));
+  EXPECT_EQ(1, socket->SendTo("q", 1, address));
+
+  char buffers[4][16];
+  ReceivedDatagram datagrams[4];
+  for (size_t i = 0; i < arraysize(datagrams); ++i) {
+    datagrams[i].buffer = buffers[i];
+    datagrams[i].capacity = sizeof(buffers[i]);
+  }
+  ASSERT_EQ(3, socket->RecvFromBatch(datagrams, arraysize(datagrams)));
+  EXPECT_EQ(3u, datagrams[0].length);
+  EXPECT_EQ(0, memcmp(buffers[0], "foo", 3));
+  EXPECT_EQ(4u, datagrams[1].length);
+  EXPECT_EQ(0, memcmp(buffers[1], "barz", 4));
+  EXPECT_EQ(1u, datagrams[2].length);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(address, datagrams[i].address);
+    // Each datagram carries its own receive timestamp.
+    EXPECT_GT(datagrams[i].timestamp, -1);
+    if (i > 0) {
+      EXPECT_GE(datagrams[i].timestamp, datagrams[i - 1].timestamp);
+    }
+  }
+
+  // The queue is now empty.
+  EXPECT_EQ(-1, socket->RecvFromBatch(datagrams, arraysize(datagrams)));
+  EXPECT_TRUE(socket->IsBlocking());
+}
+
+TEST_F(PhysicalSocketTest, SendToBatchPreservesDatagramBoundaries) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> socket(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  // Equally sized datagrams to one destination are eligible for UDP GSO,
+  // the rest go through sendmmsg. Both must arrive as separate datagrams.
+  const char* kPayloads[] = {"aaaa", "bbbb", "cc", "e", "dddddd"};
+  OutgoingDatagram outgoing[arraysize(kPayloads)];
+  for (size_t i = 0; i < arraysize(kPayloads); ++i) {
+    outgoing[i].data = kPayloads[i];
+    outgoing[i].size = strlen(kPayloads[i]);
+    outgoing[i].address = address;
+  }
+  EXPECT_EQ(3, socket->SendToBatch(outgoing, 3));
+  EXPECT_EQ(2, socket->SendToBatch(&outgoing[3], 2));
+
+  char buffers[arraysize(kPayloads)][16];
+  ReceivedDatagram datagrams[arraysize(kPayloads)];
+  for (size_t i = 0; i < arraysize(datagrams); ++i) {
+    datagrams[i].buffer = buffers[i];
+    datagrams[i].capacity = sizeof(buffers[i]);
+  }
+  ASSERT_EQ(5, socket->RecvFromBatch(datagrams, arraysize(datagrams)));
+  for (size_t i = 0; i < arraysize(kPayloads); ++i) {
+    ASSERT_EQ(strlen(kPayloads[i]), datagrams[i].length);
+    EXPECT_EQ(0, memcmp(buffers[i], kPayloads[i], datagrams[i].length));
+  }
+}
+#endif
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
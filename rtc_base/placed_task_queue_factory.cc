@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/placed_task_queue_factory.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+namespace {
+
+class PlacedTaskQueueFactory : public TaskQueueFactory {
+ public:
+  PlacedTaskQueueFactory(std::unique_ptr<TaskQueueFactory> factory,
+                         const rtc::ThreadPlacement& placement)
+      : factory_(std::move(factory)), placement_(placement) {
+    RTC_DCHECK(factory_);
+  }
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+        factory_->CreateTaskQueue(name, priority);
+    if (placement_.IsSet()) {
+      task_queue->PostTask(ToQueuedTask([placement = placement_] {
+        if (!rtc::ApplyThreadPlacement(placement)) {
+          RTC_LOG(LS_WARNING) << "Failed to apply task queue placement.";
+        }
+      }));
+    }
+    return task_queue;
+  }
+
+ private:
+  const std::unique_ptr<TaskQueueFactory> factory_;
+  const rtc::ThreadPlacement placement_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreatePlacedTaskQueueFactory(
+    std::unique_ptr<TaskQueueFactory> factory,
+    const rtc::ThreadPlacement& placement) {
+  return std::make_unique<PlacedTaskQueueFactory>(std::move(factory),
+                                                  placement);
+}
+
+}  // namespace webrtc
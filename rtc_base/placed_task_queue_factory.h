@@ -0,0 +1,32 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_PLACED_TASK_QUEUE_FACTORY_H_
+#define RTC_BASE_PLACED_TASK_QUEUE_FACTORY_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "rtc_base/thread_placement.h"
+
+namespace webrtc {
+
+// Creates task queues with |factory| and applies |placement| to their threads,
+// e.g. to keep the pacer and encoder queues of a PeerConnectionFactory on the
+// NUMA node of its network and worker threads. The placement is applied by the
+// first task of each queue, so |factory| must run every task queue on a thread
+// of its own, as the default task queue factories do.
+std::unique_ptr<TaskQueueFactory> CreatePlacedTaskQueueFactory(
+    std::unique_ptr<TaskQueueFactory> factory,
+    const rtc::ThreadPlacement& placement);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_PLACED_TASK_QUEUE_FACTORY_H_
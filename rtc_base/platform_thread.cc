@@ -52,6 +52,12 @@ PlatformThread::~PlatformThread() {
 #endif  // defined(WEBRTC_WIN)
 }
 
+void PlatformThread::SetPlacement(const ThreadPlacement& placement) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK(!IsRunning());
+  placement_ = placement;
+}
+
 #if defined(WEBRTC_WIN)
 DWORD WINAPI PlatformThread::StartThread(void* param) {
   // The GetLastError() function only returns valid results when it is called
@@ -127,6 +133,7 @@ void PlatformThread::Run() {
   RTC_DCHECK(spawned_thread_checker_.IsCurrent());
   rtc::SetCurrentThreadName(name_.c_str());
   SetPriority(priority_);
+  ApplyThreadPlacement(placement_);
   run_function_(obj_);
 }
 
@@ -20,6 +20,7 @@
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/thread_checker.h"
+#include "rtc_base/thread_placement.h"
 
 namespace rtc {
 
@@ -55,6 +56,10 @@ class PlatformThread {
 
   const std::string& name() const { return name_; }
 
+  // Sets where the thread runs, see ThreadPlacement. Must be called before
+  // Start(); the spawned thread applies it before running the run function.
+  void SetPlacement(const ThreadPlacement& placement);
+
   // Spawns a thread and tries to set thread priority according to the priority
   // from when CreateThread was called.
   void Start();
@@ -84,6 +89,7 @@ class PlatformThread {
   // TODO(pbos): Make sure call sites use string literals and update to a const
   // char* instead of a std::string.
   const std::string name_;
+  ThreadPlacement placement_;
   rtc::ThreadChecker thread_checker_;
   rtc::ThreadChecker spawned_thread_checker_;
 #if defined(WEBRTC_WIN)
@@ -16,28 +16,50 @@
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+// A window that ends in the middle of a bucket may also start in the middle of
+// one, so that it can touch one bucket more than it covers.
+uint32_t NumBuckets(int64_t max_window_size_ms, int64_t bucket_size_ms) {
+  return static_cast<uint32_t>((max_window_size_ms + 2 * bucket_size_ms - 2) /
+                               bucket_size_ms);
+}
+}  // namespace
 
 RateStatistics::RateStatistics(int64_t window_size_ms, float scale)
-    : buckets_(new Bucket[window_size_ms]()),
+    : RateStatistics(window_size_ms, scale, 1) {}
+
+RateStatistics::RateStatistics(int64_t window_size_ms,
+                               float scale,
+                               int64_t bucket_size_ms)
+    : buckets_(new Bucket[NumBuckets(window_size_ms, bucket_size_ms)]()),
       accumulated_count_(0),
       num_samples_(0),
       oldest_time_(-window_size_ms),
+      oldest_bucket_time_(-window_size_ms),
       oldest_index_(0),
+      bucket_size_ms_(bucket_size_ms),
+      num_buckets_(NumBuckets(window_size_ms, bucket_size_ms)),
       scale_(scale),
       max_window_size_ms_(window_size_ms),
-      current_window_size_ms_(max_window_size_ms_) {}
+      current_window_size_ms_(max_window_size_ms_) {
+  RTC_DCHECK_GT(bucket_size_ms, 0);
+  RTC_DCHECK_LE(bucket_size_ms, window_size_ms);
+}
 
 RateStatistics::RateStatistics(const RateStatistics& other)
     : accumulated_count_(other.accumulated_count_),
       num_samples_(other.num_samples_),
       oldest_time_(other.oldest_time_),
+      oldest_bucket_time_(other.oldest_bucket_time_),
       oldest_index_(other.oldest_index_),
+      bucket_size_ms_(other.bucket_size_ms_),
+      num_buckets_(other.num_buckets_),
       scale_(other.scale_),
       max_window_size_ms_(other.max_window_size_ms_),
       current_window_size_ms_(other.current_window_size_ms_) {
-  buckets_ = std::make_unique<Bucket[]>(other.max_window_size_ms_);
-  std::copy(other.buckets_.get(),
-            other.buckets_.get() + other.max_window_size_ms_, buckets_.get());
+  buckets_ = std::make_unique<Bucket[]>(other.num_buckets_);
+  std::copy(other.buckets_.get(), other.buckets_.get() + other.num_buckets_,
+            buckets_.get());
 }
 
 RateStatistics::RateStatistics(RateStatistics&& other) = default;
@@ -48,9 +70,10 @@ void RateStatistics::Reset() {
   accumulated_count_ = 0;
   num_samples_ = 0;
   oldest_time_ = -max_window_size_ms_;
+  oldest_bucket_time_ = -max_window_size_ms_;
   oldest_index_ = 0;
   current_window_size_ms_ = max_window_size_ms_;
-  for (int64_t i = 0; i < max_window_size_ms_; i++)
+  for (uint32_t i = 0; i < num_buckets_; i++)
     buckets_[i] = Bucket();
 }
 
@@ -63,14 +86,17 @@ void RateStatistics::Update(size_t count, int64_t now_ms) {
   EraseOld(now_ms);
 
   // First ever sample, reset window to start now.
-  if (!IsInitialized())
+  if (!IsInitialized()) {
     oldest_time_ = now_ms;
+    oldest_bucket_time_ = now_ms;
+  }
 
-  uint32_t now_offset = static_cast<uint32_t>(now_ms - oldest_time_);
-  RTC_DCHECK_LT(now_offset, max_window_size_ms_);
+  uint32_t now_offset =
+      static_cast<uint32_t>((now_ms - oldest_bucket_time_) / bucket_size_ms_);
+  RTC_DCHECK_LT(now_offset, num_buckets_);
   uint32_t index = oldest_index_ + now_offset;
-  if (index >= max_window_size_ms_)
-    index -= max_window_size_ms_;
+  if (index >= num_buckets_)
+    index -= num_buckets_;
   buckets_[index].sum += count;
   ++buckets_[index].samples;
   accumulated_count_ += count;
@@ -90,8 +116,15 @@ absl::optional<uint32_t> RateStatistics::Rate(int64_t now_ms) const {
     return absl::nullopt;
   }
 
+  // Leave out the part of the oldest bucket that is before the window.
+  float count = accumulated_count_;
+  if (oldest_time_ > oldest_bucket_time_) {
+    count -= static_cast<float>(buckets_[oldest_index_].sum) *
+             (oldest_time_ - oldest_bucket_time_) / bucket_size_ms_;
+  }
+
   float scale = scale_ / active_window_size;
-  return static_cast<uint32_t>(accumulated_count_ * scale + 0.5f);
+  return static_cast<uint32_t>(count * scale + 0.5f);
 }
 
 void RateStatistics::EraseOld(int64_t now_ms) {
@@ -105,19 +138,23 @@ void RateStatistics::EraseOld(int64_t now_ms) {
   if (new_oldest_time <= oldest_time_)
     return;
 
-  // Loop over buckets and remove too old data points.
-  while (num_samples_ > 0 && oldest_time_ < new_oldest_time) {
+  // Loop over buckets and remove the ones that are entirely too old.
+  while (num_samples_ > 0 &&
+         oldest_bucket_time_ + bucket_size_ms_ <= new_oldest_time) {
     const Bucket& oldest_bucket = buckets_[oldest_index_];
     RTC_DCHECK_GE(accumulated_count_, oldest_bucket.sum);
     RTC_DCHECK_GE(num_samples_, oldest_bucket.samples);
     accumulated_count_ -= oldest_bucket.sum;
     num_samples_ -= oldest_bucket.samples;
     buckets_[oldest_index_] = Bucket();
-    if (++oldest_index_ >= max_window_size_ms_)
+    if (++oldest_index_ >= num_buckets_)
       oldest_index_ = 0;
-    ++oldest_time_;
+    oldest_bucket_time_ += bucket_size_ms_;
   }
   oldest_time_ = new_oldest_time;
+  // With all buckets empty, start the next one at the window.
+  if (num_samples_ == 0)
+    oldest_bucket_time_ = oldest_time_;
 }
 
 bool RateStatistics::SetWindowSize(int64_t window_size_ms, int64_t now_ms) {
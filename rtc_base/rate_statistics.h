@@ -31,6 +31,16 @@ class RateStatistics {
   //         ex: kBpsScale (8000) for bits/s if count represents bytes.
   RateStatistics(int64_t max_window_size_ms, float scale);
 
+  // Same as above, but counts are kept in buckets of bucket_size_ms instead
+  // of one per millisecond, which uses max_window_size_ms / bucket_size_ms
+  // times less memory. The part of the oldest bucket that is outside of the
+  // window is estimated assuming that its counts were evenly spread over it,
+  // hence the estimated rate is off by at most the counts of one bucket, i.e.
+  // by bucket_size_ms / window size relative to a constant rate.
+  RateStatistics(int64_t max_window_size_ms,
+                 float scale,
+                 int64_t bucket_size_ms);
+
   RateStatistics(const RateStatistics& other);
 
   RateStatistics(RateStatistics&& other);
@@ -60,7 +70,7 @@ class RateStatistics {
   bool IsInitialized() const;
 
   // Counters are kept in buckets (circular buffer), with one bucket
-  // per millisecond.
+  // per |bucket_size_ms_|.
   struct Bucket {
     size_t sum;      // Sum of all samples in this bucket.
     size_t samples;  // Number of samples in this bucket.
@@ -76,9 +86,15 @@ class RateStatistics {
   // Oldest time recorded in buckets.
   int64_t oldest_time_;
 
+  // Start time of the oldest bucket, at most |oldest_time_|.
+  int64_t oldest_bucket_time_;
+
   // Bucket index of oldest counter recorded in buckets.
   uint32_t oldest_index_;
 
+  const int64_t bucket_size_ms_;
+  const uint32_t num_buckets_;
+
   // To convert counts/ms to desired units
   const float scale_;
 
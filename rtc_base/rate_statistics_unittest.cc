@@ -278,4 +278,59 @@ TEST_F(RateStatisticsTest, HandlesQuietPeriods) {
   EXPECT_TRUE(static_cast<bool>(bitrate));
   EXPECT_EQ(0u, *bitrate);
 }
+
+TEST(RateStatisticsBucketsTest, EstimatesWithinOneBucketOfExactRate) {
+  const int64_t kBucketSizeMs = 20;
+  RateStatistics exact_stats(kWindowMs, 8000);
+  RateStatistics coarse_stats(kWindowMs, 8000, kBucketSizeMs);
+  // Packets of varying size every 7 ms.
+  int64_t now_ms = 0;
+  for (int i = 0; i < 1000; ++i, now_ms += 7) {
+    const size_t packet_size = 500 + (i % 5) * 250;
+    exact_stats.Update(packet_size, now_ms);
+    coarse_stats.Update(packet_size, now_ms);
+    absl::optional<uint32_t> exact_rate = exact_stats.Rate(now_ms);
+    absl::optional<uint32_t> coarse_rate = coarse_stats.Rate(now_ms);
+    ASSERT_EQ(static_cast<bool>(exact_rate), static_cast<bool>(coarse_rate));
+    if (exact_rate && now_ms > kWindowMs) {
+      // At most three packets of the largest size in a bucket.
+      const uint32_t kMaxErrorBps = 3 * 1500 * 8000 / kWindowMs;
+      EXPECT_NEAR(*exact_rate, *coarse_rate, kMaxErrorBps);
+    }
+  }
+}
+
+TEST(RateStatisticsBucketsTest, ExpiresOldBuckets) {
+  const int64_t kBucketSizeMs = 50;
+  RateStatistics stats(kWindowMs, 8000, kBucketSizeMs);
+  int64_t now_ms = 0;
+  stats.Update(1000, now_ms);
+  now_ms += kWindowMs - 1;
+  stats.Update(1000, now_ms);
+  EXPECT_EQ(2000 * 8000u / kWindowMs, stats.Rate(now_ms));
+
+  // The first bucket falls out of the window.
+  now_ms += kBucketSizeMs;
+  EXPECT_EQ(1000 * 8000u / kWindowMs, stats.Rate(now_ms));
+
+  // So does the last one, which leaves no data.
+  now_ms += kWindowMs;
+  EXPECT_FALSE(stats.Rate(now_ms));
+
+  // A long quiet period followed by new data.
+  now_ms += 10 * kWindowMs;
+  stats.Update(1000, now_ms);
+  stats.Update(1000, now_ms + 1);
+  EXPECT_EQ(2000 * 8000u / kWindowMs, stats.Rate(now_ms + 1));
+}
+
+TEST(RateStatisticsBucketsTest, CopiesBuckets) {
+  RateStatistics stats(kWindowMs, 8000, 25);
+  stats.Update(1000, 0);
+  stats.Update(1000, 99);
+  RateStatistics copy(stats);
+  EXPECT_EQ(stats.Rate(99), copy.Rate(99));
+  copy.Update(1000, 199);
+  EXPECT_EQ(3000 * 8000u / 200, copy.Rate(199));
+}
 }  // namespace
@@ -18,10 +18,13 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/location.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/message_queue.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
@@ -34,8 +37,25 @@ const uint64_t kYearInSeconds = 365 * 24 * 60 * 60;
 enum {
   MSG_GENERATE,
   MSG_GENERATE_DONE,
+  MSG_REFILL_POOL,
+  MSG_ROTATE_POOL,
 };
 
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  switch (a.type()) {
+    case KT_RSA:
+      return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+             a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+    case KT_ECDSA:
+      return a.ec_curve() == b.ec_curve();
+    default:
+      return true;
+  }
+}
+
 // Helper class for generating certificates asynchronously; a single task
 // instance is responsible for a single asynchronous certificate generation
 // request. We are using a separate helper class so that a generation request
@@ -60,6 +80,12 @@ class RTCCertificateGenerationTask : public RefCountInterface,
   }
   ~RTCCertificateGenerationTask() override {}
 
+  // Sets a certificate that was generated in advance, to be passed to the
+  // callback on |MSG_GENERATE_DONE| without posting |MSG_GENERATE|.
+  void set_certificate(const scoped_refptr<RTCCertificate>& certificate) {
+    certificate_ = certificate;
+  }
+
   // Handles |MSG_GENERATE| and its follow-up |MSG_GENERATE_DONE|.
   void OnMessage(Message* msg) override {
     switch (msg->message_id) {
@@ -134,9 +160,197 @@ scoped_refptr<RTCCertificate> RTCCertificateGenerator::GenerateCertificate(
   return RTCCertificate::Create(std::move(identity_sptr));
 }
 
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    size_t size,
+    int64_t max_age_ms) {
+  return new RefCountedObject<RTCCertificatePool>(size, max_age_ms);
+}
+
+RTCCertificatePool::Pool::Pool(const KeyParams& key_params)
+    : key_params(key_params) {}
+RTCCertificatePool::Pool::Pool(Pool&&) = default;
+RTCCertificatePool::Pool::~Pool() = default;
+
+RTCCertificatePool::RTCCertificatePool(size_t size, int64_t max_age_ms)
+    : size_(size), max_age_ms_(max_age_ms), thread_(Thread::Create()) {
+  RTC_DCHECK_GT(size_, 0);
+  RTC_DCHECK_GT(max_age_ms_, 0);
+  thread_->SetName("RTCCertificatePool", this);
+  thread_->Start();
+}
+
+RTCCertificatePool::~RTCCertificatePool() {
+  // Waits for a certificate that is being generated. Pending messages are
+  // dropped.
+  thread_->Stop();
+}
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params) {
+  if (!key_params.IsValid()) {
+    return nullptr;
+  }
+  CritScope lock(&crit_);
+  size_t index = GetPoolIndex(key_params);
+  Pool* pool = &pools_[index];
+  RemoveExpiredCertificates(pool, TimeMillis());
+  scoped_refptr<RTCCertificate> certificate;
+  if (!pool->certificates.empty()) {
+    certificate = std::move(pool->certificates.front().second);
+    pool->certificates.pop_front();
+  }
+  MaybeRefill(index);
+  return certificate;
+}
+
+void RTCCertificatePool::Prefill(const KeyParams& key_params) {
+  if (!key_params.IsValid()) {
+    return;
+  }
+  CritScope lock(&crit_);
+  MaybeRefill(GetPoolIndex(key_params));
+}
+
+size_t RTCCertificatePool::num_certificates(const KeyParams& key_params) {
+  CritScope lock(&crit_);
+  for (Pool& pool : pools_) {
+    if (SameKeyParams(pool.key_params, key_params)) {
+      RemoveExpiredCertificates(&pool, TimeMillis());
+      return pool.certificates.size();
+    }
+  }
+  return 0;
+}
+
+size_t RTCCertificatePool::GetPoolIndex(const KeyParams& key_params) {
+  for (size_t i = 0; i < pools_.size(); ++i) {
+    if (SameKeyParams(pools_[i].key_params, key_params)) {
+      return i;
+    }
+  }
+  pools_.emplace_back(key_params);
+  return pools_.size() - 1;
+}
+
+void RTCCertificatePool::RemoveExpiredCertificates(Pool* pool,
+                                                   int64_t now_ms) {
+  while (!pool->certificates.empty() &&
+         now_ms - pool->certificates.front().first >= max_age_ms_) {
+    pool->certificates.pop_front();
+  }
+}
+
+void RTCCertificatePool::MaybeRefill(size_t index) {
+  Pool* pool = &pools_[index];
+  if (pool->refilling || pool->certificates.size() >= size_) {
+    return;
+  }
+  pool->refilling = true;
+  thread_->Post(RTC_FROM_HERE, this, MSG_REFILL_POOL,
+                new TypedMessageData<size_t>(index));
+}
+
+void RTCCertificatePool::OnMessage(Message* msg) {
+  RTC_DCHECK(thread_->IsCurrent());
+  switch (msg->message_id) {
+    case MSG_REFILL_POOL: {
+      std::unique_ptr<TypedMessageData<size_t>> data(
+          static_cast<TypedMessageData<size_t>*>(msg->pdata));
+      Refill(data->data());
+      break;
+    }
+    case MSG_ROTATE_POOL: {
+      std::vector<size_t> indices;
+      {
+        CritScope lock(&crit_);
+        int64_t now_ms = TimeMillis();
+        for (size_t i = 0; i < pools_.size(); ++i) {
+          RemoveExpiredCertificates(&pools_[i], now_ms);
+          if (!pools_[i].refilling && pools_[i].certificates.size() < size_) {
+            pools_[i].refilling = true;
+            indices.push_back(i);
+          }
+        }
+      }
+      for (size_t index : indices) {
+        Refill(index);
+      }
+      break;
+    }
+    default:
+      RTC_NOTREACHED();
+  }
+  ScheduleRotation();
+}
+
+void RTCCertificatePool::Refill(size_t index) {
+  KeyParams key_params;
+  {
+    CritScope lock(&crit_);
+    key_params = pools_[index].key_params;
+  }
+  while (true) {
+    {
+      CritScope lock(&crit_);
+      // Expired certificates are replaced by MSG_ROTATE_POOL, so that a
+      // short |max_age_ms_| can't keep this loop going.
+      Pool* pool = &pools_[index];
+      if (pool->certificates.size() >= size_) {
+        pool->refilling = false;
+        return;
+      }
+    }
+    // Generated without holding the lock, so that Take() doesn't wait for it.
+    scoped_refptr<RTCCertificate> certificate =
+        RTCCertificateGenerator::GenerateCertificate(key_params,
+                                                     absl::nullopt);
+    CritScope lock(&crit_);
+    if (!certificate) {
+      RTC_LOG(LS_WARNING) << "Failed to generate a pooled certificate.";
+      pools_[index].refilling = false;
+      return;
+    }
+    pools_[index].certificates.emplace_back(TimeMillis(),
+                                            std::move(certificate));
+  }
+}
+
+void RTCCertificatePool::ScheduleRotation() {
+  RTC_DCHECK(thread_->IsCurrent());
+  absl::optional<int64_t> next_expiration_ms;
+  {
+    CritScope lock(&crit_);
+    for (const Pool& pool : pools_) {
+      if (pool.certificates.empty()) {
+        continue;
+      }
+      int64_t expiration_ms = pool.certificates.front().first + max_age_ms_;
+      if (!next_expiration_ms || expiration_ms < *next_expiration_ms) {
+        next_expiration_ms = expiration_ms;
+      }
+    }
+  }
+  thread_->Clear(this, MSG_ROTATE_POOL);
+  if (!next_expiration_ms) {
+    return;
+  }
+  int64_t delay_ms = std::max<int64_t>(*next_expiration_ms - TimeMillis(), 0);
+  thread_->PostDelayed(RTC_FROM_HERE, saturated_cast<int>(delay_ms), this,
+                       MSG_ROTATE_POOL);
+}
+
 RTCCertificateGenerator::RTCCertificateGenerator(Thread* signaling_thread,
                                                  Thread* worker_thread)
-    : signaling_thread_(signaling_thread), worker_thread_(worker_thread) {
+    : RTCCertificateGenerator(signaling_thread, worker_thread, nullptr) {}
+
+RTCCertificateGenerator::RTCCertificateGenerator(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    scoped_refptr<RTCCertificatePool> pool)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      pool_(std::move(pool)) {
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
 }
@@ -156,6 +370,17 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
           new RefCountedObject<RTCCertificateGenerationTask>(
               signaling_thread_, worker_thread_, key_params, expires_ms,
               callback));
+  if (pool_ && !expires_ms) {
+    scoped_refptr<RTCCertificate> certificate = pool_->Take(key_params);
+    if (certificate) {
+      // The callback is invoked asynchronously, as for a generated
+      // certificate.
+      msg_data->data()->set_certificate(certificate);
+      signaling_thread_->Post(RTC_FROM_HERE, msg_data->data().get(),
+                              MSG_GENERATE_DONE, msg_data);
+      return;
+    }
+  }
   worker_thread_->Post(RTC_FROM_HERE, msg_data->data().get(), MSG_GENERATE,
                        msg_data);
 }
@@ -13,13 +13,21 @@
 
 #include <stdint.h>
 
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/message_handler.h"
 #include "rtc_base/ref_count.h"
 #include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
 
@@ -50,6 +58,68 @@ class RTCCertificateGeneratorInterface {
       const scoped_refptr<RTCCertificateGeneratorCallback>& callback) = 0;
 };
 
+// Keeps certificates with the default expiration time pre-generated, so that
+// they can be handed out without waiting for key generation. Up to |size|
+// certificates are kept for each KeyParams that has been requested, and they
+// are generated on a background thread owned by the pool. Each certificate is
+// handed out at most once. Certificates that have been pooled for
+// |max_age_ms| are replaced by new ones.
+class RTC_EXPORT RTCCertificatePool : public RefCountInterface,
+                                      public MessageHandler {
+ public:
+  static scoped_refptr<RTCCertificatePool> Create(size_t size,
+                                                  int64_t max_age_ms);
+
+  // Returns a pooled certificate for |key_params|, or null if there is none
+  // (yet). Either way, the pool for |key_params| is refilled in the
+  // background. Can be called on any thread.
+  scoped_refptr<RTCCertificate> Take(const KeyParams& key_params);
+  // Starts filling the pool for |key_params| without taking a certificate.
+  void Prefill(const KeyParams& key_params);
+  // Returns the number of certificates that are ready for |key_params|.
+  size_t num_certificates(const KeyParams& key_params);
+
+  size_t size() const { return size_; }
+  int64_t max_age_ms() const { return max_age_ms_; }
+
+ protected:
+  RTCCertificatePool(size_t size, int64_t max_age_ms);
+  ~RTCCertificatePool() override;
+
+ private:
+  struct Pool {
+    explicit Pool(const KeyParams& key_params);
+    Pool(Pool&&);
+    ~Pool();
+
+    KeyParams key_params;
+    // Oldest first, with the time they were generated at.
+    std::deque<std::pair<int64_t, scoped_refptr<RTCCertificate>>>
+        certificates;
+    bool refilling = false;
+  };
+
+  // Returns the index of the pool for |key_params| in |pools_|, and adds one
+  // if there is none.
+  size_t GetPoolIndex(const KeyParams& key_params)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void RemoveExpiredCertificates(Pool* pool, int64_t now_ms)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Starts refilling the pool at |index| if it isn't already.
+  void MaybeRefill(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Refills pools and replaces expired certificates, on |thread_|.
+  void OnMessage(Message* msg) override;
+  void Refill(size_t index);
+  void ScheduleRotation();
+
+  const size_t size_;
+  const int64_t max_age_ms_;
+  std::unique_ptr<Thread> thread_;
+  CriticalSection crit_;
+  std::vector<Pool> pools_ RTC_GUARDED_BY(crit_);
+};
+
 // Standard implementation of |RTCCertificateGeneratorInterface|.
 // The static function |GenerateCertificate| generates a certificate on the
 // current thread. The |RTCCertificateGenerator| instance generates certificates
@@ -67,6 +137,11 @@ class RTC_EXPORT RTCCertificateGenerator
       const absl::optional<uint64_t>& expires_ms);
 
   RTCCertificateGenerator(Thread* signaling_thread, Thread* worker_thread);
+  // Certificates with the default expiration time are taken from |pool| when
+  // it has one ready, and generated on the worker thread otherwise.
+  RTCCertificateGenerator(Thread* signaling_thread,
+                          Thread* worker_thread,
+                          scoped_refptr<RTCCertificatePool> pool);
   ~RTCCertificateGenerator() override {}
 
   // |RTCCertificateGeneratorInterface| overrides.
@@ -82,6 +157,7 @@ class RTC_EXPORT RTCCertificateGenerator
  private:
   Thread* const signaling_thread_;
   Thread* const worker_thread_;
+  const scoped_refptr<RTCCertificatePool> pool_;
 };
 
 }  // namespace rtc
@@ -141,4 +141,42 @@ TEST_F(RTCCertificateGeneratorTest, GenerateWithInvalidParamsShouldFail) {
   EXPECT_FALSE(fixture_->certificate());
 }
 
+TEST_F(RTCCertificateGeneratorTest, PoolHandsOutEachCertificateOnce) {
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(2, 60 * 1000);
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA()));
+  EXPECT_EQ_WAIT(2u, pool->num_certificates(KeyParams::ECDSA()),
+                 kGenerationTimeoutMs);
+  EXPECT_EQ(0u, pool->num_certificates(KeyParams::RSA()));
+
+  scoped_refptr<RTCCertificate> cert_a = pool->Take(KeyParams::ECDSA());
+  scoped_refptr<RTCCertificate> cert_b = pool->Take(KeyParams::ECDSA());
+  ASSERT_TRUE(cert_a);
+  ASSERT_TRUE(cert_b);
+  EXPECT_NE(cert_a->ToPEM().certificate(), cert_b->ToPEM().certificate());
+  // The pool is refilled in the background.
+  EXPECT_EQ_WAIT(2u, pool->num_certificates(KeyParams::ECDSA()),
+                 kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificateGeneratorTest, GenerateAsyncTakesPooledCertificate) {
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(1, 60 * 1000);
+  pool->Prefill(KeyParams::ECDSA());
+  EXPECT_EQ_WAIT(1u, pool->num_certificates(KeyParams::ECDSA()),
+                 kGenerationTimeoutMs);
+
+  // The worker thread isn't started, so the certificate can only come from
+  // the pool.
+  std::unique_ptr<Thread> worker_thread = Thread::Create();
+  RTCCertificateGenerator generator(Thread::Current(), worker_thread.get(),
+                                    pool);
+  generator.GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt,
+                                     fixture_);
+  // The callback is still invoked asynchronously.
+  EXPECT_FALSE(fixture_->GenerateAsyncCompleted());
+  EXPECT_TRUE_WAIT(fixture_->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE(fixture_->certificate());
+}
+
 }  // namespace rtc
@@ -350,6 +350,80 @@ TEST(SigslotTest, CallDisconnectAllWhileSignalFiring) {
   EXPECT_EQ(0, receiver2.signal_count());
 }
 
+// Disconnects the receiver that was connected before it while the signal is
+// firing.
+class PreviousDisconnector : public sigslot::has_slots<> {
+ public:
+  explicit PreviousDisconnector(SigslotReceiver<>* previous)
+      : previous_(previous) {}
+
+  void Connect(sigslot::signal<>* signal) {
+    signal->connect(this, &PreviousDisconnector::Disconnect);
+  }
+
+ private:
+  void Disconnect() { previous_->Disconnect(); }
+
+  SigslotReceiver<>* previous_;
+};
+
+// Test that disconnecting a slot that already received the signal while it is
+// firing does not skip the slots after it.
+TEST(SigslotTest, DisconnectPreviousSlotWhileFiring) {
+  sigslot::signal<> signal;
+  SigslotReceiver<> receiver1;
+  SigslotReceiver<> receiver2;
+  PreviousDisconnector disconnector(&receiver1);
+
+  receiver1.Connect(&signal);
+  disconnector.Connect(&signal);
+  receiver2.Connect(&signal);
+  signal();
+  EXPECT_EQ(1, receiver1.signal_count());
+  EXPECT_EQ(1, receiver2.signal_count());
+
+  signal();
+  EXPECT_EQ(1, receiver1.signal_count());
+  EXPECT_EQ(2, receiver2.signal_count());
+}
+
+// Connects a receiver while the signal is firing.
+class Connector : public sigslot::has_slots<> {
+ public:
+  explicit Connector(SigslotReceiver<>* receiver) : receiver_(receiver) {}
+
+  void Connect(sigslot::signal<>* signal) {
+    signal_ = signal;
+    signal->connect(this, &Connector::ConnectReceiver);
+  }
+
+ private:
+  void ConnectReceiver() {
+    if (!connected_)
+      receiver_->Connect(signal_);
+    connected_ = true;
+  }
+
+  sigslot::signal<>* signal_;
+  SigslotReceiver<>* receiver_;
+  bool connected_ = false;
+};
+
+// Test that a slot connected while the signal is firing receives the signal,
+// as the slots are called in the order they were connected.
+TEST(SigslotTest, ConnectWhileFiring) {
+  sigslot::signal<> signal;
+  SigslotReceiver<> receiver1;
+  SigslotReceiver<> receiver2;
+  Connector connector(&receiver2);
+
+  receiver1.Connect(&signal);
+  connector.Connect(&signal);
+  signal();
+  EXPECT_EQ(1, receiver1.signal_count());
+  EXPECT_EQ(1, receiver2.signal_count());
+}
+
 // Basic test that a sigslot repeater works.
 TEST(SigslotRepeaterTest, RepeatsSignalsAfterRepeatCalled) {
   sigslot::signal<> signal;
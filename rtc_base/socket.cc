@@ -10,4 +10,27 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::SendToBatch(const OutgoingDatagram* datagrams, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int sent =
+        SendTo(datagrams[i].data, datagrams[i].size, datagrams[i].address);
+    if (sent < 0)
+      return i == 0 ? sent : static_cast<int>(i);
+  }
+  return static_cast<int>(count);
+}
+
+int Socket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+  if (count == 0)
+    return 0;
+  int received = RecvFrom(datagrams[0].buffer, datagrams[0].capacity,
+                          &datagrams[0].address, &datagrams[0].timestamp);
+  if (received < 0)
+    return received;
+  datagrams[0].length = static_cast<size_t>(received);
+  return 1;
+}
+
+}  // namespace rtc
@@ -122,6 +122,25 @@ inline bool IsBlockingError(int e) {
   return (e == EWOULDBLOCK) || (e == EAGAIN) || (e == EINPROGRESS);
 }
 
+// A single datagram slot used by Socket::RecvFromBatch. |buffer| and
+// |capacity| are provided by the caller; the remaining fields are filled in
+// for every datagram that was received.
+struct ReceivedDatagram {
+  void* buffer = nullptr;
+  size_t capacity = 0;
+  size_t length = 0;
+  SocketAddress address;
+  // Receive time in microseconds, or -1 if not available.
+  int64_t timestamp = -1;
+};
+
+// A single datagram passed to Socket::SendToBatch.
+struct OutgoingDatagram {
+  const void* data = nullptr;
+  size_t size = 0;
+  SocketAddress address;
+};
+
 // General interface for the socket implementations of various networks.  The
 // methods match those of normal UNIX sockets very closely.
 class Socket {
@@ -140,12 +159,23 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends |count| datagrams, in order. Returns the number of datagrams that
+  // were sent, or SOCKET_ERROR with GetError() set if none could be sent.
+  // The default implementation calls SendTo for each datagram and stops at
+  // the first failure.
+  virtual int SendToBatch(const OutgoingDatagram* datagrams, size_t count);
   // |timestamp| is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Receives up to |count| datagrams into the caller-provided |datagrams|.
+  // Returns the number of datagrams received, or SOCKET_ERROR with GetError()
+  // set. The default implementation receives a single datagram through
+  // RecvFrom; implementations that can drain several datagrams with a single
+  // system call should override it.
+  virtual int RecvFromBatch(ReceivedDatagram* datagrams, size_t count);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -163,6 +193,8 @@ class Socket {
     OPT_NODELAY,               // whether Nagle algorithm is enabled
     OPT_IPV6_V6ONLY,           // Whether the socket is IPv6 only.
     OPT_DSCP,                  // DSCP code
+    OPT_REUSEPORT,             // Allow several sockets to bind to the same
+                               // address and port. Must be set before Bind().
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
@@ -111,6 +111,10 @@ bool SSLStreamAdapter::ExportKeyingMaterial(const std::string& label,
   return false;  // Default is unsupported
 }
 
+bool SSLStreamAdapter::IsResumedSession() {
+  return false;
+}
+
 bool SSLStreamAdapter::SetDtlsSrtpCryptoSuites(
     const std::vector<int>& crypto_suites) {
   return false;
@@ -134,6 +138,10 @@ std::string SSLStreamAdapter::SslCipherSuiteToName(int cipher_suite) {
   return OpenSSLStreamAdapter::SslCipherSuiteToName(cipher_suite);
 }
 
+void SSLStreamAdapter::EnableDtlsSessionResumption(bool enable) {
+  OpenSSLStreamAdapter::EnableDtlsSessionResumption(enable);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Test only settings
 ///////////////////////////////////////////////////////////////////////////////
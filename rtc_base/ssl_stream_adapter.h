@@ -218,6 +218,10 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // SS_OPENING but IsTlsConnected should return true.
   virtual bool IsTlsConnected() = 0;
 
+  // Returns true if the connection was established by resuming a session
+  // rather than by a full handshake. See EnableDtlsSessionResumption.
+  virtual bool IsResumedSession();
+
   // Capabilities testing.
   // Used to have "DTLS supported", "DTLS-SRTP supported" etc. methods, but now
   // that's assumed.
@@ -233,6 +237,14 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // depending on specific SSL implementation.
   static std::string SslCipherSuiteToName(int cipher_suite);
 
+  // Enables resumption of DTLS sessions for streams started after this call.
+  // Clients cache the session of each connection, keyed by the local and the
+  // peer certificate digest, and offer it the next time they connect with the
+  // same certificates, e.g. after an ICE restart. Servers accept sessions of
+  // any stream of the process. The peer certificate is verified against its
+  // digest as for a full handshake. Disabled by default.
+  static void EnableDtlsSessionResumption(bool enable);
+
   ////////////////////////////////////////////////////////////////////////////
   // Testing only member functions
   ////////////////////////////////////////////////////////////////////////////
@@ -372,6 +372,28 @@ class SSLStreamAdapterTestBase : public ::testing::Test,
     server_ssl_->SetIdentity(server_identity_);
   }
 
+  // Recreate the client/server streams with the current identities, to
+  // connect again after a handshake.
+  void ResetStreamsWithSameIdentities() {
+    rtc::SSLIdentity* client_identity = client_identity_->GetReference();
+    rtc::SSLIdentity* server_identity = server_identity_->GetReference();
+    client_ssl_.reset(nullptr);
+    server_ssl_.reset(nullptr);
+    CreateStreams();
+
+    client_ssl_.reset(rtc::SSLStreamAdapter::Create(client_stream_));
+    server_ssl_.reset(rtc::SSLStreamAdapter::Create(server_stream_));
+
+    client_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_identity_ = client_identity;
+    server_identity_ = server_identity;
+    client_ssl_->SetIdentity(client_identity_);
+    server_ssl_->SetIdentity(server_identity_);
+    identities_set_ = false;
+  }
+
   virtual void OnEvent(rtc::StreamInterface* stream, int sig, int err) {
     RTC_LOG(LS_VERBOSE) << "SSLStreamAdapterTestBase::OnEvent sig=" << sig;
 
@@ -1148,6 +1170,34 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSDelayedIdentityWithBogusDigest) {
 }
 
 // Test DTLS-SRTP with all high ciphers
+// Test that a client connecting again with the same certificates resumes its
+// session if session resumption is enabled.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionResumption) {
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+
+  ResetStreamsWithSameIdentities();
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+
+  rtc::SSLStreamAdapter::EnableDtlsSessionResumption(true);
+  ResetStreamsWithSameIdentities();
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+
+  ResetStreamsWithSameIdentities();
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsResumedSession());
+  EXPECT_TRUE(server_ssl_->IsResumedSession());
+  std::unique_ptr<rtc::SSLCertChain> server_chain =
+      client_ssl_->GetPeerSSLCertChain();
+  ASSERT_TRUE(server_chain);
+  EXPECT_EQ(server_identity_->certificate().ToPEMString(),
+            server_chain->Get(0).ToPEMString());
+  TestTransfer(100);
+  rtc::SSLStreamAdapter::EnableDtlsSessionResumption(false);
+}
+
 TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpHigh) {
   std::vector<int> high;
   high.push_back(rtc::SRTP_AES128_CM_SHA1_80);
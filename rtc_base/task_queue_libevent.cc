@@ -22,6 +22,7 @@
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/task_queue/queued_task.h"
@@ -29,7 +30,6 @@
 #include "base/third_party/libevent/event.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
-#include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
@@ -39,7 +39,7 @@
 namespace webrtc {
 namespace {
 constexpr char kQuit = 1;
-constexpr char kRunTask = 2;
+constexpr char kRunTasks = 2;
 
 using Priority = TaskQueueFactory::Priority;
 
@@ -130,7 +130,14 @@ class TaskQueueLibevent final : public TaskQueueBase {
   event wakeup_event_;
   rtc::PlatformThread thread_;
   rtc::CriticalSection pending_lock_;
-  std::list<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(pending_lock_);
+  // Tasks posted since the queue last woke up. The thread is only woken up by
+  // the first of them and runs them all, so a busy queue does not cost a pipe
+  // write and a wake up per task.
+  std::vector<std::unique_ptr<QueuedTask>> pending_
+      RTC_GUARDED_BY(pending_lock_);
+  // The tasks being run, swapped with |pending_| so that the storage of both is
+  // reused. Only accessed on the task queue thread.
+  std::vector<std::unique_ptr<QueuedTask>> running_;
   // Holds a list of events pending timers for cleanup when the loop exits.
   std::list<TimerEvent*> pending_timers_;
 };
@@ -213,19 +220,21 @@ void TaskQueueLibevent::Delete() {
 }
 
 void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
-  QueuedTask* task_id = task.get();  // Only used for comparison.
   {
     rtc::CritScope lock(&pending_lock_);
+    const bool had_pending_tasks = !pending_.empty();
     pending_.push_back(std::move(task));
+    // If there were pending tasks, a wake up is already in the pipe or the
+    // thread has not taken the pending tasks yet, and this task runs with
+    // them.
+    if (had_pending_tasks)
+      return;
   }
-  char message = kRunTask;
-  if (write(wakeup_pipe_in_, &message, sizeof(message)) != sizeof(message)) {
-    RTC_LOG(WARNING) << "Failed to queue task.";
-    rtc::CritScope lock(&pending_lock_);
-    pending_.remove_if([task_id](std::unique_ptr<QueuedTask>& t) {
-      return t.get() == task_id;
-    });
-  }
+  // At most one kRunTasks message is in the pipe at any time, so the write
+  // can not fail because the pipe is full.
+  char message = kRunTasks;
+  RTC_CHECK_EQ(write(wakeup_pipe_in_, &message, sizeof(message)),
+               static_cast<ssize_t>(sizeof(message)));
 }
 
 void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
@@ -270,17 +279,20 @@ void TaskQueueLibevent::OnWakeup(int socket,
       me->is_active_ = false;
       event_base_loopbreak(me->event_base_);
       break;
-    case kRunTask: {
-      std::unique_ptr<QueuedTask> task;
+    case kRunTasks: {
+      RTC_DCHECK(me->running_.empty());
       {
         rtc::CritScope lock(&me->pending_lock_);
-        RTC_DCHECK(!me->pending_.empty());
-        task = std::move(me->pending_.front());
-        me->pending_.pop_front();
+        me->running_.swap(me->pending_);
+      }
+      RTC_DCHECK(!me->running_.empty());
+      for (std::unique_ptr<QueuedTask>& task : me->running_) {
         RTC_DCHECK(task.get());
+        if (!task->Run())
+          task.release();
+        task = nullptr;
       }
-      if (!task->Run())
-        task.release();
+      me->running_.clear();
       break;
     }
     default:
@@ -102,6 +102,11 @@ class TaskQueueStdlib final : public TaskQueueBase {
   // Indicates if the worker thread needs to shutdown now.
   bool thread_should_quit_ RTC_GUARDED_BY(pending_lock_){false};
 
+  // Indicates if the worker thread found nothing to run and waits, or is about
+  // to wait, on flag_notify_. Posting only needs to wake it up then, since a
+  // running thread looks for new tasks before it waits.
+  bool thread_waiting_ RTC_GUARDED_BY(pending_lock_){false};
+
   // Holds the next order to use for the next task to be
   // put into one of the pending queues.
   OrderId thread_posting_order_ RTC_GUARDED_BY(pending_lock_){};
@@ -153,6 +158,9 @@ void TaskQueueStdlib::PostTask(std::unique_ptr<QueuedTask> task) {
 
     pending_queue_.push(std::pair<OrderId, std::unique_ptr<QueuedTask>>(
         order, std::move(task)));
+    if (!thread_waiting_)
+      return;
+    thread_waiting_ = false;
   }
 
   NotifyWake();
@@ -169,6 +177,11 @@ void TaskQueueStdlib::PostDelayedTask(std::unique_ptr<QueuedTask> task,
     rtc::CritScope lock(&pending_lock_);
     delay.order_ = ++thread_posting_order_;
     delayed_queue_[delay] = std::move(task);
+    // A running thread computes its sleep time including this task before it
+    // waits.
+    if (!thread_waiting_)
+      return;
+    thread_waiting_ = false;
   }
 
   NotifyWake();
@@ -180,6 +193,7 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
   auto tick = rtc::TimeMillis();
 
   rtc::CritScope lock(&pending_lock_);
+  thread_waiting_ = false;
 
   if (thread_should_quit_) {
     result.final_task_ = true;
@@ -216,6 +230,7 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     pending_queue_.pop();
   }
 
+  thread_waiting_ = !result.run_task_;
   return result;
 }
 
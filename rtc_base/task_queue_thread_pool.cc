@@ -0,0 +1,445 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Number of tasks a task queue may run before the thread moves on to the next
+// ready task queue, so that a busy task queue does not starve the others.
+constexpr int kMaxTasksPerSlice = 32;
+
+class PooledTaskQueue;
+
+// The threads, the task queues that have tasks to run, and the delayed tasks
+// of all task queues.
+class ThreadPool {
+ public:
+  ThreadPool(int num_threads, int timer_slack_ms);
+  ~ThreadPool();
+
+  // Adds |queue|, which has tasks to run and is not scheduled yet, to the end
+  // of the ready task queues.
+  void Schedule(PooledTaskQueue* queue);
+  void PostDelayedTask(PooledTaskQueue* queue,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds,
+                       TaskQueueBase::DelayPrecision precision);
+  // Removes the delayed tasks of |queue|, which is deleted, and returns them
+  // to be destroyed without holding the lock.
+  std::vector<std::unique_ptr<QueuedTask>> RemoveDelayedTasks(
+      PooledTaskQueue* queue);
+
+ private:
+  struct Worker {
+    ThreadPool* pool = nullptr;
+    rtc::Event wakeup;
+    std::unique_ptr<rtc::PlatformThread> thread;
+  };
+  struct DelayedTaskKey {
+    int64_t run_time_ms;
+    uint64_t order;
+    bool operator<(const DelayedTaskKey& o) const {
+      return std::tie(run_time_ms, order) < std::tie(o.run_time_ms, o.order);
+    }
+  };
+  struct DelayedTask {
+    PooledTaskQueue* queue;
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  static void ThreadMain(void* context);
+  void Run(Worker* worker);
+  void RunSlice(PooledTaskQueue* queue);
+  // Posts the delayed tasks that are due to their task queues. Tasks of
+  // deleted task queues are added to |dropped|.
+  void PostDueDelayedTasks(std::vector<std::unique_ptr<QueuedTask>>* dropped)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void WakeUp(Worker* worker) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void WakeUpIdleWorker() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const int64_t timer_slack_ms_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::CriticalSection lock_;
+  bool stopping_ RTC_GUARDED_BY(lock_) = false;
+  std::deque<PooledTaskQueue*> ready_queues_ RTC_GUARDED_BY(lock_);
+  // Waiting workers, the most recently idle last so that it is woken up first
+  // while its cache is warm.
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(lock_);
+  // The idle worker that waits until the first delayed task is due. The other
+  // idle workers wait until they are woken up.
+  Worker* timer_worker_ RTC_GUARDED_BY(lock_) = nullptr;
+  uint64_t next_delayed_task_order_ RTC_GUARDED_BY(lock_) = 0;
+  std::map<DelayedTaskKey, DelayedTask> delayed_tasks_ RTC_GUARDED_BY(lock_);
+};
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  enum class SliceResult { kIdle, kMoreTasks, kDeleted };
+
+  explicit PooledTaskQueue(ThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+  void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) override;
+
+  // Adds |task| to the pending tasks and returns true if the task queue must
+  // be scheduled. Returns the task in |dropped| if the task queue is deleted.
+  bool AddTask(std::unique_ptr<QueuedTask> task,
+               std::unique_ptr<QueuedTask>* dropped);
+  // Runs up to kMaxTasksPerSlice pending tasks on the calling pool thread.
+  // When deleted, the caller deletes the task queue and then sets
+  // |*delete_done|, if not null, to let Delete() return.
+  SliceResult RunSlice(rtc::Event** delete_done);
+
+ private:
+  // Deleted by the pool when Delete() is called while the task queue is
+  // scheduled.
+  friend class ThreadPool;
+  ~PooledTaskQueue() override = default;
+
+  ThreadPool* const pool_;
+  rtc::CriticalSection lock_;
+  std::deque<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(lock_);
+  // Set while the task queue is in the ready task queues of the pool or runs
+  // on a pool thread. The pool thread then owns the task queue once deleted.
+  bool scheduled_ RTC_GUARDED_BY(lock_) = false;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool deleted_ RTC_GUARDED_BY(lock_) = false;
+  // Set by Delete() when it waits for the running task to finish.
+  rtc::Event* delete_done_ RTC_GUARDED_BY(lock_) = nullptr;
+};
+
+ThreadPool::ThreadPool(int num_threads, int timer_slack_ms)
+    : timer_slack_ms_(timer_slack_ms) {
+  RTC_DCHECK_GT(num_threads, 0);
+  RTC_DCHECK_GE(timer_slack_ms, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->pool = this;
+    worker->thread = std::make_unique<rtc::PlatformThread>(
+        &ThreadPool::ThreadMain, worker.get(),
+        "TaskQueuePool" + std::to_string(i));
+    workers_.push_back(std::move(worker));
+  }
+  for (auto& worker : workers_)
+    worker->thread->Start();
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(ready_queues_.empty()) << "Task queues must be deleted first.";
+    stopping_ = true;
+    for (auto& worker : workers_)
+      worker->wakeup.Set();
+  }
+  for (auto& worker : workers_)
+    worker->thread->Stop();
+}
+
+void ThreadPool::Schedule(PooledTaskQueue* queue) {
+  rtc::CritScope lock(&lock_);
+  ready_queues_.push_back(queue);
+  WakeUpIdleWorker();
+}
+
+void ThreadPool::PostDelayedTask(PooledTaskQueue* queue,
+                                 std::unique_ptr<QueuedTask> task,
+                                 uint32_t milliseconds,
+                                 TaskQueueBase::DelayPrecision precision) {
+  int64_t run_time_ms = rtc::TimeMillis() + milliseconds;
+  if (precision == TaskQueueBase::DelayPrecision::kLow && timer_slack_ms_ > 0) {
+    // Round up to the slack grid, shared by all task queues.
+    run_time_ms += timer_slack_ms_ - 1;
+    run_time_ms -= run_time_ms % timer_slack_ms_;
+  }
+  rtc::CritScope lock(&lock_);
+  const DelayedTaskKey key{run_time_ms, next_delayed_task_order_++};
+  auto it =
+      delayed_tasks_.emplace(key, DelayedTask{queue, std::move(task)}).first;
+  if (it != delayed_tasks_.begin())
+    return;
+  // The task is due before the one the timer worker waits for, if any.
+  if (timer_worker_) {
+    WakeUp(timer_worker_);
+  } else {
+    WakeUpIdleWorker();
+  }
+}
+
+std::vector<std::unique_ptr<QueuedTask>> ThreadPool::RemoveDelayedTasks(
+    PooledTaskQueue* queue) {
+  std::vector<std::unique_ptr<QueuedTask>> removed;
+  rtc::CritScope lock(&lock_);
+  for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+    if (it->second.queue == queue) {
+      removed.push_back(std::move(it->second.task));
+      it = delayed_tasks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+// static
+void ThreadPool::ThreadMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  worker->pool->Run(worker);
+}
+
+void ThreadPool::Run(Worker* worker) {
+  while (true) {
+    PooledTaskQueue* queue = nullptr;
+    int wait_ms = rtc::Event::kForever;
+    std::vector<std::unique_ptr<QueuedTask>> dropped;
+    {
+      rtc::CritScope lock(&lock_);
+      if (stopping_)
+        return;
+      PostDueDelayedTasks(&dropped);
+      if (!ready_queues_.empty()) {
+        queue = ready_queues_.front();
+        ready_queues_.pop_front();
+        // Let an idle worker take the next ready task queue.
+        if (!ready_queues_.empty())
+          WakeUpIdleWorker();
+      } else {
+        if (!timer_worker_ && !delayed_tasks_.empty()) {
+          timer_worker_ = worker;
+          const int64_t run_time_ms =
+              delayed_tasks_.begin()->first.run_time_ms;
+          wait_ms = rtc::saturated_cast<int>(
+              std::max<int64_t>(0, run_time_ms - rtc::TimeMillis()));
+        }
+        idle_workers_.push_back(worker);
+      }
+    }
+    dropped.clear();
+
+    if (queue) {
+      RunSlice(queue);
+      continue;
+    }
+
+    worker->wakeup.Wait(wait_ms);
+    rtc::CritScope lock(&lock_);
+    auto it = std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+    if (it != idle_workers_.end())
+      idle_workers_.erase(it);
+    if (timer_worker_ == worker) {
+      timer_worker_ = nullptr;
+      // This worker may be about to run tasks for a long time, so let an idle
+      // worker wait for the delayed tasks instead.
+      if (!delayed_tasks_.empty())
+        WakeUpIdleWorker();
+    }
+  }
+}
+
+void ThreadPool::RunSlice(PooledTaskQueue* queue) {
+  rtc::Event* delete_done = nullptr;
+  switch (queue->RunSlice(&delete_done)) {
+    case PooledTaskQueue::SliceResult::kIdle:
+      break;
+    case PooledTaskQueue::SliceResult::kMoreTasks:
+      Schedule(queue);
+      break;
+    case PooledTaskQueue::SliceResult::kDeleted:
+      delete queue;
+      if (delete_done)
+        delete_done->Set();
+      break;
+  }
+}
+
+void ThreadPool::PostDueDelayedTasks(
+    std::vector<std::unique_ptr<QueuedTask>>* dropped) {
+  const int64_t now_ms = rtc::TimeMillis();
+  while (!delayed_tasks_.empty() &&
+         delayed_tasks_.begin()->first.run_time_ms <= now_ms) {
+    DelayedTask& delayed = delayed_tasks_.begin()->second;
+    std::unique_ptr<QueuedTask> dropped_task;
+    if (delayed.queue->AddTask(std::move(delayed.task), &dropped_task))
+      ready_queues_.push_back(delayed.queue);
+    if (dropped_task)
+      dropped->push_back(std::move(dropped_task));
+    delayed_tasks_.erase(delayed_tasks_.begin());
+  }
+}
+
+void ThreadPool::WakeUp(Worker* worker) {
+  auto it = std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+  if (it != idle_workers_.end())
+    idle_workers_.erase(it);
+  worker->wakeup.Set();
+}
+
+void ThreadPool::WakeUpIdleWorker() {
+  if (idle_workers_.empty())
+    return;
+  Worker* worker = idle_workers_.back();
+  idle_workers_.pop_back();
+  worker->wakeup.Set();
+}
+
+void PooledTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+  // Destroy the tasks without holding a lock, they may post tasks.
+  pool_->RemoveDelayedTasks(this).clear();
+  std::deque<std::unique_ptr<QueuedTask>> pending;
+  rtc::Event task_done;
+  bool wait_for_task;
+  bool owned_by_pool;
+  {
+    rtc::CritScope lock(&lock_);
+    deleted_ = true;
+    pending.swap(pending_);
+    wait_for_task = running_;
+    if (wait_for_task)
+      delete_done_ = &task_done;
+    owned_by_pool = scheduled_;
+  }
+  // Once deleted and owned by the pool, |this| may be gone already.
+  pending.clear();
+  if (wait_for_task)
+    task_done.Wait(rtc::Event::kForever);
+  if (!owned_by_pool)
+    delete this;
+}
+
+void PooledTaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  std::unique_ptr<QueuedTask> dropped;
+  if (AddTask(std::move(task), &dropped))
+    pool_->Schedule(this);
+}
+
+void PooledTaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  pool_->PostDelayedTask(this, std::move(task), milliseconds,
+                         DelayPrecision::kLow);
+}
+
+void PooledTaskQueue::PostDelayedHighPrecisionTask(
+    std::unique_ptr<QueuedTask> task,
+    uint32_t milliseconds) {
+  pool_->PostDelayedTask(this, std::move(task), milliseconds,
+                         DelayPrecision::kHigh);
+}
+
+bool PooledTaskQueue::AddTask(std::unique_ptr<QueuedTask> task,
+                              std::unique_ptr<QueuedTask>* dropped) {
+  rtc::CritScope lock(&lock_);
+  if (deleted_) {
+    *dropped = std::move(task);
+    return false;
+  }
+  pending_.push_back(std::move(task));
+  if (scheduled_)
+    return false;
+  scheduled_ = true;
+  return true;
+}
+
+PooledTaskQueue::SliceResult PooledTaskQueue::RunSlice(
+    rtc::Event** delete_done) {
+  CurrentTaskQueueSetter set_current(this);
+  for (int i = 0; i < kMaxTasksPerSlice; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      rtc::CritScope lock(&lock_);
+      if (deleted_) {
+        *delete_done = delete_done_;
+        return SliceResult::kDeleted;
+      }
+      if (pending_.empty()) {
+        scheduled_ = false;
+        return SliceResult::kIdle;
+      }
+      task = std::move(pending_.front());
+      pending_.pop_front();
+      running_ = true;
+    }
+    if (!task->Run())
+      task.release();
+    task = nullptr;
+    rtc::CritScope lock(&lock_);
+    running_ = false;
+  }
+  rtc::CritScope lock(&lock_);
+  if (deleted_) {
+    *delete_done = delete_done_;
+    return SliceResult::kDeleted;
+  }
+  if (pending_.empty()) {
+    scheduled_ = false;
+    return SliceResult::kIdle;
+  }
+  return SliceResult::kMoreTasks;
+}
+
+class TaskQueueThreadPoolFactory final : public TaskQueueFactory {
+ public:
+  TaskQueueThreadPoolFactory(int num_threads, int timer_slack_ms)
+      : pool_(num_threads, timer_slack_ms) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new PooledTaskQueue(&pool_));
+  }
+
+ private:
+  mutable ThreadPool pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads) {
+  return CreateTaskQueueThreadPoolFactory(num_threads, /*timer_slack_ms=*/0);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads,
+    int timer_slack_ms) {
+  return std::make_unique<TaskQueueThreadPoolFactory>(num_threads,
+                                                      timer_slack_ms);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,39 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+#define RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates task queues that share a pool of |num_threads| threads instead of
+// owning a thread each. Every task queue still runs its tasks one at a time
+// and in order, but may run them on any of the pool threads. Meant for
+// processes that host many calls, each of which creates several task queues.
+// The priority of the task queues is ignored. The factory must outlive the
+// task queues it creates.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads);
+
+// As above, with delayed tasks of low precision run at the next multiple of
+// |timer_slack_ms| of the clock after they are due, so that tasks of all the
+// task queues that are due close together share one wake up. High precision
+// delayed tasks are run when due.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads,
+    int timer_slack_ms);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using TaskQueuePtr = std::unique_ptr<TaskQueueBase, TaskQueueDeleter>;
+
+std::unique_ptr<TaskQueueFactory> CreateSingleThreadPoolFactory() {
+  return CreateTaskQueueThreadPoolFactory(1);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateFourThreadPoolFactory() {
+  return CreateTaskQueueThreadPoolFactory(4);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreateSingleThreadPoolFactory,
+                                           CreateFourThreadPoolFactory));
+
+TEST(TaskQueueThreadPoolTest, RunsTasksOfManyQueuesInOrderPerQueue) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(2);
+  static constexpr int kQueueCount = 100;
+  static constexpr int kTasksPerQueue = 100;
+  std::vector<TaskQueuePtr> queues;
+  for (int i = 0; i < kQueueCount; ++i) {
+    queues.push_back(factory->CreateTaskQueue(
+        "Queue", TaskQueueFactory::Priority::NORMAL));
+  }
+
+  // Each counter is only accessed by the tasks of its queue.
+  std::vector<int> next_task(kQueueCount, 0);
+  std::vector<int> in_order(kQueueCount, true);
+  std::vector<rtc::Event> done(kQueueCount);
+  for (int q = 0; q < kQueueCount; ++q) {
+    for (int i = 0; i < kTasksPerQueue; ++i) {
+      queues[q]->PostTask(ToQueuedTask([&, q, i] {
+        EXPECT_TRUE(queues[q]->IsCurrent());
+        if (next_task[q]++ != i)
+          in_order[q] = false;
+        if (i == kTasksPerQueue - 1)
+          done[q].Set();
+      }));
+    }
+  }
+  for (int q = 0; q < kQueueCount; ++q) {
+    EXPECT_TRUE(done[q].Wait(10000));
+    EXPECT_TRUE(in_order[q]);
+  }
+}
+
+TEST(TaskQueueThreadPoolTest, DeleteWaitsForRunningTask) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(2);
+  TaskQueuePtr queue =
+      factory->CreateTaskQueue("Queue", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event task_started;
+  rtc::Event continue_task;
+  bool task_finished = false;
+  bool later_task_ran = false;
+  queue->PostTask(ToQueuedTask([&] {
+    task_started.Set();
+    continue_task.Wait(rtc::Event::kForever);
+    task_finished = true;
+  }));
+  queue->PostTask(ToQueuedTask([&] { later_task_ran = true; }));
+  ASSERT_TRUE(task_started.Wait(1000));
+
+  TaskQueuePtr deleter =
+      factory->CreateTaskQueue("Deleter", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event deleted;
+  deleter->PostTask(ToQueuedTask([&] {
+    queue = nullptr;
+    deleted.Set();
+  }));
+  EXPECT_FALSE(deleted.Wait(50));
+  continue_task.Set();
+  ASSERT_TRUE(deleted.Wait(1000));
+  EXPECT_TRUE(task_finished);
+  EXPECT_FALSE(later_task_ran);
+}
+
+TEST(TaskQueueThreadPoolTest, RunsDelayedTaskWhileOtherThreadsAreBusy) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(2);
+  rtc::Event release_busy;
+  rtc::Event delayed_ran;
+  TaskQueuePtr busy =
+      factory->CreateTaskQueue("Busy", TaskQueueFactory::Priority::NORMAL);
+  TaskQueuePtr delayed =
+      factory->CreateTaskQueue("Delayed", TaskQueueFactory::Priority::NORMAL);
+  delayed->PostDelayedTask(ToQueuedTask([&] { delayed_ran.Set(); }), 20);
+  busy->PostTask(
+      ToQueuedTask([&] { release_busy.Wait(rtc::Event::kForever); }));
+  EXPECT_TRUE(delayed_ran.Wait(1000));
+  release_busy.Set();
+}
+
+TEST(TaskQueueThreadPoolTest, CoalescesLowPrecisionDelayedTasks) {
+  static constexpr int kTimerSlackMs = 200;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(2, kTimerSlackMs);
+  TaskQueuePtr first =
+      factory->CreateTaskQueue("First", TaskQueueFactory::Priority::NORMAL);
+  TaskQueuePtr second =
+      factory->CreateTaskQueue("Second", TaskQueueFactory::Priority::NORMAL);
+  // Post early in a slack interval, so that both tasks are due before the
+  // next multiple of the slack.
+  while (rtc::TimeMillis() % kTimerSlackMs > kTimerSlackMs / 4)
+    rtc::Event().Wait(1);
+  const int64_t post_time_ms = rtc::TimeMillis();
+  const int64_t grid_time_ms =
+      post_time_ms - post_time_ms % kTimerSlackMs + kTimerSlackMs;
+  int64_t first_run_time_ms = 0;
+  int64_t second_run_time_ms = 0;
+  rtc::Event first_ran;
+  rtc::Event second_ran;
+  first->PostDelayedTask(ToQueuedTask([&] {
+                           first_run_time_ms = rtc::TimeMillis();
+                           first_ran.Set();
+                         }),
+                         10);
+  second->PostDelayedTask(ToQueuedTask([&] {
+                            second_run_time_ms = rtc::TimeMillis();
+                            second_ran.Set();
+                          }),
+                          50);
+  ASSERT_TRUE(first_ran.Wait(1000));
+  ASSERT_TRUE(second_ran.Wait(1000));
+  EXPECT_GE(first_run_time_ms, grid_time_ms);
+  EXPECT_GE(second_run_time_ms, grid_time_ms);
+}
+
+TEST(TaskQueueThreadPoolTest, RunsHighPrecisionDelayedTaskWhenDue) {
+  static constexpr int kTimerSlackMs = 10000;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(2, kTimerSlackMs);
+  TaskQueuePtr queue =
+      factory->CreateTaskQueue("Queue", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event ran;
+  queue->PostDelayedHighPrecisionTask(ToQueuedTask([&] { ran.Set(); }), 10);
+  EXPECT_TRUE(ran.Wait(1000));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -18,8 +18,10 @@
 namespace webrtc {
 namespace webrtc_repeating_task_impl {
 RepeatingTaskBase::RepeatingTaskBase(TaskQueueBase* task_queue,
+                                     TaskQueueBase::DelayPrecision precision,
                                      TimeDelta first_delay)
     : task_queue_(task_queue),
+      precision_(precision),
       next_run_time_(Timestamp::us(rtc::TimeMicros()) + first_delay) {}
 
 RepeatingTaskBase::~RepeatingTaskBase() = default;
@@ -43,7 +45,8 @@ bool RepeatingTaskBase::Run() {
   delay -= lost_time;
   delay = std::max(delay, TimeDelta::Zero());
 
-  task_queue_->PostDelayedTask(absl::WrapUnique(this), delay.ms());
+  task_queue_->PostDelayedTaskWithPrecision(precision_, absl::WrapUnique(this),
+                                           delay.ms());
 
   // Return false to tell the TaskQueue to not destruct this object since we
   // have taken ownership with absl::WrapUnique.
@@ -29,7 +29,9 @@ class RepeatingTaskHandle;
 namespace webrtc_repeating_task_impl {
 class RepeatingTaskBase : public QueuedTask {
  public:
-  RepeatingTaskBase(TaskQueueBase* task_queue, TimeDelta first_delay);
+  RepeatingTaskBase(TaskQueueBase* task_queue,
+                    TaskQueueBase::DelayPrecision precision,
+                    TimeDelta first_delay);
   ~RepeatingTaskBase() override;
   virtual TimeDelta RunClosure() = 0;
 
@@ -40,6 +42,7 @@ class RepeatingTaskBase : public QueuedTask {
   void Stop() RTC_RUN_ON(task_queue_);
 
   TaskQueueBase* const task_queue_;
+  const TaskQueueBase::DelayPrecision precision_;
   // This is always finite, except for the special case where it's PlusInfinity
   // to signal that the task should stop.
   Timestamp next_run_time_ RTC_GUARDED_BY(task_queue_);
@@ -50,9 +53,10 @@ template <class Closure>
 class RepeatingTaskImpl final : public RepeatingTaskBase {
  public:
   RepeatingTaskImpl(TaskQueueBase* task_queue,
+                    TaskQueueBase::DelayPrecision precision,
                     TimeDelta first_delay,
                     Closure&& closure)
-      : RepeatingTaskBase(task_queue, first_delay),
+      : RepeatingTaskBase(task_queue, precision, first_delay),
         closure_(std::forward<Closure>(closure)) {
     static_assert(
         std::is_same<TimeDelta,
@@ -89,13 +93,19 @@ class RepeatingTaskHandle {
   // TaskQueue is destroyed. Note that this means that trying to stop the
   // repeating task after the TaskQueue is destroyed is an error. However, it's
   // perfectly fine to destroy the handle while the task is running, since the
-  // repeated task is owned by the TaskQueue.
+  // repeated task is owned by the TaskQueue. The task is reposted with
+  // |precision|, high for tasks that must not be run late to share wake ups
+  // with other tasks.
   template <class Closure>
-  static RepeatingTaskHandle Start(TaskQueueBase* task_queue,
-                                   Closure&& closure) {
+  static RepeatingTaskHandle Start(
+      TaskQueueBase* task_queue,
+      Closure&& closure,
+      TaskQueueBase::DelayPrecision precision =
+          TaskQueueBase::DelayPrecision::kLow) {
     auto repeating_task = std::make_unique<
         webrtc_repeating_task_impl::RepeatingTaskImpl<Closure>>(
-        task_queue, TimeDelta::Zero(), std::forward<Closure>(closure));
+        task_queue, precision, TimeDelta::Zero(),
+        std::forward<Closure>(closure));
     auto* repeating_task_ptr = repeating_task.get();
     task_queue->PostTask(std::move(repeating_task));
     return RepeatingTaskHandle(repeating_task_ptr);
@@ -104,14 +114,18 @@ class RepeatingTaskHandle {
   // DelayedStart is equivalent to Start except that the first invocation of the
   // closure will be delayed by the given amount.
   template <class Closure>
-  static RepeatingTaskHandle DelayedStart(TaskQueueBase* task_queue,
-                                          TimeDelta first_delay,
-                                          Closure&& closure) {
+  static RepeatingTaskHandle DelayedStart(
+      TaskQueueBase* task_queue,
+      TimeDelta first_delay,
+      Closure&& closure,
+      TaskQueueBase::DelayPrecision precision =
+          TaskQueueBase::DelayPrecision::kLow) {
     auto repeating_task = std::make_unique<
         webrtc_repeating_task_impl::RepeatingTaskImpl<Closure>>(
-        task_queue, first_delay, std::forward<Closure>(closure));
+        task_queue, precision, first_delay, std::forward<Closure>(closure));
     auto* repeating_task_ptr = repeating_task.get();
-    task_queue->PostDelayedTask(std::move(repeating_task), first_delay.ms());
+    task_queue->PostDelayedTaskWithPrecision(
+        precision, std::move(repeating_task), first_delay.ms());
     return RepeatingTaskHandle(repeating_task_ptr);
   }
 
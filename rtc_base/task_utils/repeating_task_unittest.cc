@@ -60,6 +60,48 @@ class MoveOnlyClosure {
  private:
   MockClosure* mock_;
 };
+
+// Keeps the last delayed task posted to it, and counts the delayed tasks
+// posted with each precision.
+class FakeTaskQueue : public TaskQueueBase {
+ public:
+  void Delete() override {}
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    last_task_ = std::move(task);
+  }
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    ++low_precision_tasks_;
+    last_task_ = std::move(task);
+  }
+  void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) override {
+    ++high_precision_tasks_;
+    last_task_ = std::move(task);
+  }
+
+  // Runs the last posted task as if it was run by this task queue.
+  void RunLastTask() {
+    CurrentTaskQueueSetter set_current(this);
+    std::unique_ptr<QueuedTask> task = std::move(last_task_);
+    if (!task->Run())
+      task.release();
+  }
+
+  template <class Closure>
+  void RunAsCurrent(Closure&& closure) {
+    CurrentTaskQueueSetter set_current(this);
+    closure();
+  }
+
+  int low_precision_tasks() const { return low_precision_tasks_; }
+  int high_precision_tasks() const { return high_precision_tasks_; }
+
+ private:
+  std::unique_ptr<QueuedTask> last_task_;
+  int low_precision_tasks_ = 0;
+  int high_precision_tasks_ = 0;
+};
 }  // namespace
 
 TEST(RepeatingTaskTest, TaskIsStoppedOnStop) {
@@ -195,6 +237,32 @@ TEST(RepeatingTaskTest, StartPeriodicTask) {
   EXPECT_TRUE(done.Wait(kTimeout.ms()));
 }
 
+TEST(RepeatingTaskTest, RepostsWithGivenPrecision) {
+  FakeTaskQueue task_queue;
+  RepeatingTaskHandle handle = RepeatingTaskHandle::DelayedStart(
+      &task_queue, TimeDelta::ms(10), [] { return TimeDelta::ms(10); },
+      TaskQueueBase::DelayPrecision::kHigh);
+  EXPECT_EQ(task_queue.high_precision_tasks(), 1);
+  task_queue.RunLastTask();
+  task_queue.RunLastTask();
+  EXPECT_EQ(task_queue.high_precision_tasks(), 3);
+  EXPECT_EQ(task_queue.low_precision_tasks(), 0);
+  task_queue.RunAsCurrent([&] { handle.Stop(); });
+  // Lets the stopped task delete itself.
+  task_queue.RunLastTask();
+}
+
+TEST(RepeatingTaskTest, RepostsWithLowPrecisionByDefault) {
+  FakeTaskQueue task_queue;
+  RepeatingTaskHandle handle = RepeatingTaskHandle::Start(
+      &task_queue, [] { return TimeDelta::ms(10); });
+  task_queue.RunLastTask();
+  EXPECT_EQ(task_queue.low_precision_tasks(), 1);
+  EXPECT_EQ(task_queue.high_precision_tasks(), 0);
+  task_queue.RunAsCurrent([&] { handle.Stop(); });
+  task_queue.RunLastTask();
+}
+
 TEST(RepeatingTaskTest, Example) {
   class ObjectOnTaskQueue {
    public:
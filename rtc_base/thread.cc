@@ -156,6 +156,44 @@ Thread::ScopedDisallowBlockingCalls::~ScopedDisallowBlockingCalls() {
   thread_->SetAllowBlockingCalls(previous_state_);
 }
 
+Thread::ScopedCountBlockingCalls::ScopedCountBlockingCalls(
+    std::function<void(uint32_t, uint32_t)> result_callback)
+    : thread_(Thread::Current()),
+      base_blocking_call_count_(thread_ ? thread_->blocking_call_count_ : 0),
+      base_could_be_blocking_call_count_(
+          thread_ ? thread_->could_be_blocking_call_count_ : 0),
+      result_callback_(std::move(result_callback)) {}
+
+Thread::ScopedCountBlockingCalls::~ScopedCountBlockingCalls() {
+  RTC_DCHECK(!thread_ || thread_->IsCurrent());
+  if (result_callback_)
+    result_callback_(GetBlockingCallCount(), GetCouldBeBlockingCallCount());
+}
+
+uint32_t Thread::ScopedCountBlockingCalls::GetBlockingCallCount() const {
+  return thread_ ? thread_->blocking_call_count_ - base_blocking_call_count_
+                 : 0;
+}
+
+uint32_t Thread::ScopedCountBlockingCalls::GetCouldBeBlockingCallCount()
+    const {
+  return thread_ ? thread_->could_be_blocking_call_count_ -
+                       base_could_be_blocking_call_count_
+                 : 0;
+}
+
+// static
+void Thread::CountSynchronousCall(const Thread* target) {
+  Thread* current = Thread::Current();
+  if (!current)
+    return;
+  if (current == target) {
+    ++current->could_be_blocking_call_count_;
+  } else {
+    ++current->blocking_call_count_;
+  }
+}
+
 Thread::Thread(SocketServer* ss) : Thread(ss, /*do_init=*/true) {}
 
 Thread::Thread(std::unique_ptr<SocketServer> ss)
@@ -230,6 +268,11 @@ bool Thread::SetName(const std::string& name, const void* obj) {
   return true;
 }
 
+void Thread::SetPlacement(const ThreadPlacement& placement) {
+  RTC_DCHECK(!IsRunning());
+  placement_ = placement;
+}
+
 bool Thread::Start() {
   RTC_DCHECK(!IsRunning());
 
@@ -335,6 +378,10 @@ void* Thread::PreRun(void* pv) {
   Thread* thread = static_cast<Thread*>(pv);
   ThreadManager::Instance()->SetCurrentThread(thread);
   rtc::SetCurrentThreadName(thread->name_.c_str());
+  if (!ApplyThreadPlacement(thread->placement_)) {
+    RTC_LOG(LS_WARNING) << "Failed to apply the placement of thread "
+                        << thread->name_;
+  }
 #if defined(WEBRTC_MAC)
   ScopedAutoReleasePool pool;
 #endif
@@ -369,6 +416,8 @@ void Thread::Send(const Location& posted_from,
   if (IsQuitting())
     return;
 
+  CountSynchronousCall(this);
+
   // Sent messages are sent to the MessageHandler directly, in the context
   // of "thread", like Win32 SendMessage. If in the right context,
   // call the handler directly.
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
@@ -29,6 +30,7 @@
 #include "rtc_base/socket_server.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/thread_placement.h"
 
 #if defined(WEBRTC_WIN)
 #include "rtc_base/win32.h"
@@ -170,6 +172,38 @@ class RTC_EXPORT RTC_LOCKABLE Thread : public MessageQueue {
     const bool previous_state_;
   };
 
+  // Counts the synchronous calls (Invoke, Send and the PeerConnection proxy
+  // calls) made from the current thread for a given scope, e.g. for one API
+  // call, and reports them to |result_callback| when it goes out of scope.
+  // Calls to another thread block; calls to the current thread do not, but
+  // could if the code was run elsewhere, and are counted separately.
+  // Note that this is a single threaded class, and that calls made from a
+  // thread that is not an rtc::Thread are not counted.
+  class ScopedCountBlockingCalls {
+   public:
+    explicit ScopedCountBlockingCalls(
+        std::function<void(uint32_t blocking_calls,
+                           uint32_t could_be_blocking_calls)> result_callback);
+    ScopedCountBlockingCalls(const ScopedCountBlockingCalls&) = delete;
+    ScopedCountBlockingCalls& operator=(const ScopedCountBlockingCalls&) =
+        delete;
+    ~ScopedCountBlockingCalls();
+
+    uint32_t GetBlockingCallCount() const;
+    uint32_t GetCouldBeBlockingCallCount() const;
+
+   private:
+    Thread* const thread_;
+    const uint32_t base_blocking_call_count_;
+    const uint32_t base_could_be_blocking_call_count_;
+    const std::function<void(uint32_t, uint32_t)> result_callback_;
+  };
+
+  // Records a synchronous call from the current thread to |target| for
+  // ScopedCountBlockingCalls. Called by Send(), and by code that makes calls
+  // block in other ways, such as the proxies in api/proxy.h.
+  static void CountSynchronousCall(const Thread* target);
+
   bool IsCurrent() const;
 
   // Sleeps the calling thread for the specified number of milliseconds, during
@@ -182,6 +216,10 @@ class RTC_EXPORT RTC_LOCKABLE Thread : public MessageQueue {
   const std::string& name() const { return name_; }
   bool SetName(const std::string& name, const void* obj);
 
+  // Sets where the thread runs, see ThreadPlacement. Must be called before
+  // Start(); the new thread applies it before processing any message.
+  void SetPlacement(const ThreadPlacement& placement);
+
   // Starts the execution of the thread.
   bool Start();
 
@@ -263,6 +301,31 @@ class RTC_EXPORT RTC_LOCKABLE Thread : public MessageQueue {
              std::forward<FunctorT>(functor)));
   }
 
+  // Non-blocking alternative to Invoke(): posts a task to invoke |functor| on
+  // |this| thread, and then a task to invoke |reply| with the value returned
+  // by |functor|, or without arguments if it returns void, on |reply_thread|.
+  // Both are posted with PostTask() and follow its rules; in particular, if
+  // either thread is quitting, the functor or the reply is dropped.
+  //
+  // Example:
+  // worker_thread->PostTaskAndReply(
+  //     RTC_FROM_HERE, signaling_thread, [this] { return ComputeOnWorker(); },
+  //     [this](int result) { OnComputed(result); });
+  template <class FunctorT, class ReplyT>
+  void PostTaskAndReply(const Location& posted_from,
+                        Thread* reply_thread,
+                        FunctorT&& functor,
+                        ReplyT&& reply) {
+    using ResultT = decltype(functor());
+    PostTask(posted_from,
+             [posted_from, reply_thread,
+              functor = std::forward<FunctorT>(functor),
+              reply = std::forward<ReplyT>(reply)]() mutable {
+               RunAndReply(std::is_void<ResultT>(), posted_from, reply_thread,
+                           &functor, &reply);
+             });
+  }
+
   // From MessageQueue
   bool IsProcessingMessagesForTesting() override;
   void Clear(MessageHandler* phandler,
@@ -358,8 +421,31 @@ class RTC_EXPORT RTC_LOCKABLE Thread : public MessageQueue {
 
   void InvokeInternal(const Location& posted_from, MessageHandler* handler);
 
+  // Helpers of PostTaskAndReply() for functors with and without a result.
+  template <class FunctorT, class ReplyT>
+  static void RunAndReply(std::false_type,
+                          const Location& posted_from,
+                          Thread* reply_thread,
+                          FunctorT* functor,
+                          ReplyT* reply) {
+    reply_thread->PostTask(posted_from, [result = (*functor)(),
+                                         reply = std::move(*reply)]() mutable {
+      reply(std::move(result));
+    });
+  }
+  template <class FunctorT, class ReplyT>
+  static void RunAndReply(std::true_type,
+                          const Location& posted_from,
+                          Thread* reply_thread,
+                          FunctorT* functor,
+                          ReplyT* reply) {
+    (*functor)();
+    reply_thread->PostTask(posted_from, std::move(*reply));
+  }
+
   std::list<_SendMessage> sendlist_;
   std::string name_;
+  ThreadPlacement placement_;
 
   // TODO(tommi): Add thread checks for proper use of control methods.
   // Ideally we should be able to just use PlatformThread.
@@ -380,6 +466,10 @@ class RTC_EXPORT RTC_LOCKABLE Thread : public MessageQueue {
 
   // Only touched from the worker thread itself.
   bool blocking_calls_allowed_ = true;
+  // Synchronous calls made from this thread, see ScopedCountBlockingCalls.
+  // Only touched from the worker thread itself.
+  uint32_t blocking_call_count_ = 0;
+  uint32_t could_be_blocking_call_count_ = 0;
 
   friend class ThreadManager;
 
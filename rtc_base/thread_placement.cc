@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_placement.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <utility>
+
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+
+namespace rtc {
+namespace {
+
+// The number of CPUs that fit in a cpu_set_t of glibc, which is more than
+// any CPU list is expected to name.
+constexpr int kMaxCpus = 1024;
+
+#if defined(WEBRTC_LINUX) && defined(SYS_set_mempolicy)
+// From <numaif.h>, which comes with libnuma rather than the C library.
+constexpr int kMpolPreferred = 1;
+
+void PreferNumaNodeMemory(int node) {
+  constexpr int kBitsPerWord = 8 * sizeof(unsigned long);  // NOLINT
+  if (node < 0 || node >= kBitsPerWord) {
+    return;
+  }
+  unsigned long node_mask = 1ul << node;  // NOLINT
+  // Fails e.g. on kernels without NUMA support, which leaves the default
+  // policy of allocating on the node of the CPU that touches the memory first.
+  syscall(SYS_set_mempolicy, kMpolPreferred, &node_mask, kBitsPerWord);
+}
+#endif
+
+}  // namespace
+
+ThreadPlacement::ThreadPlacement() = default;
+ThreadPlacement::ThreadPlacement(const ThreadPlacement&) = default;
+ThreadPlacement& ThreadPlacement::operator=(const ThreadPlacement&) = default;
+ThreadPlacement::~ThreadPlacement() = default;
+
+bool ApplyThreadPlacement(const ThreadPlacement& placement) {
+  if (!placement.IsSet()) {
+    return true;
+  }
+#if defined(WEBRTC_LINUX)
+  std::vector<int> cpus = placement.cpus;
+  std::sort(cpus.begin(), cpus.end());
+  if (placement.numa_node) {
+    std::vector<int> node_cpus = GetNumaNodeCpus(*placement.numa_node);
+    if (cpus.empty()) {
+      cpus = std::move(node_cpus);
+    } else {
+      std::vector<int> common_cpus;
+      std::set_intersection(cpus.begin(), cpus.end(), node_cpus.begin(),
+                            node_cpus.end(), std::back_inserter(common_cpus));
+      cpus = std::move(common_cpus);
+    }
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  bool has_cpus = false;
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+      has_cpus = true;
+    }
+  }
+  // Fails if none of the CPUs is allowed for the process.
+  if (!has_cpus || sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return false;
+  }
+#if defined(SYS_set_mempolicy)
+  if (placement.numa_node) {
+    PreferNumaNodeMemory(*placement.numa_node);
+  }
+#endif
+  return true;
+#else
+  return false;
+#endif  // defined(WEBRTC_LINUX)
+}
+
+std::vector<int> GetNumaNodeCpus(int node) {
+#if defined(WEBRTC_LINUX)
+  if (node < 0) {
+    return std::vector<int>();
+  }
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    return std::vector<int>();
+  }
+  char cpu_list[4096];
+  size_t size = fread(cpu_list, 1, sizeof(cpu_list), file);
+  fclose(file);
+  return ParseCpuList(absl::string_view(cpu_list, size));
+#else
+  return std::vector<int>();
+#endif  // defined(WEBRTC_LINUX)
+}
+
+std::vector<int> ParseCpuList(absl::string_view cpu_list) {
+  std::vector<int> cpus;
+  // The kernel ends the list with a newline.
+  while (!cpu_list.empty() &&
+         std::isspace(static_cast<unsigned char>(cpu_list.back()))) {
+    cpu_list.remove_suffix(1);
+  }
+  if (cpu_list.empty()) {
+    return cpus;
+  }
+  for (absl::string_view range : absl::StrSplit(cpu_list, ',')) {
+    int first = 0;
+    int last = 0;
+    size_t dash_pos = range.find('-');
+    if (dash_pos == absl::string_view::npos) {
+      if (!absl::SimpleAtoi(range, &first)) {
+        return std::vector<int>();
+      }
+      last = first;
+    } else if (!absl::SimpleAtoi(range.substr(0, dash_pos), &first) ||
+               !absl::SimpleAtoi(range.substr(dash_pos + 1), &last)) {
+      return std::vector<int>();
+    }
+    if (first < 0 || last < first || last >= kMaxCpus) {
+      return std::vector<int>();
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+}  // namespace rtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_THREAD_PLACEMENT_H_
+#define RTC_BASE_THREAD_PLACEMENT_H_
+
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace rtc {
+
+// Where a thread runs and allocates its memory. On servers with several NUMA
+// nodes, keeping the threads that hand packets and frames to each other on the
+// CPUs and memory of one node avoids migrations and remote memory accesses.
+// Only supported on Linux; threads created by a placed thread inherit its
+// placement there.
+struct RTC_EXPORT ThreadPlacement {
+  ThreadPlacement();
+  ThreadPlacement(const ThreadPlacement&);
+  ThreadPlacement& operator=(const ThreadPlacement&);
+  ~ThreadPlacement();
+
+  bool IsSet() const { return !cpus.empty() || numa_node.has_value(); }
+
+  // If not empty, the thread only runs on these CPUs.
+  std::vector<int> cpus;
+  // If set, the thread only runs on the CPUs of this NUMA node, or on the ones
+  // that are also in |cpus| if both are set, and allocates memory from the
+  // node when it can.
+  absl::optional<int> numa_node;
+};
+
+// Applies |placement| to the calling thread. Returns true if it is not set.
+// Returns false, leaving the thread as it was, if it is not supported on this
+// platform or names no CPU that the thread may run on. Memory is preferred
+// from the NUMA node on a best effort basis.
+RTC_EXPORT bool ApplyThreadPlacement(const ThreadPlacement& placement);
+
+// Returns the CPUs of NUMA node |node|, or an empty vector if unknown.
+RTC_EXPORT std::vector<int> GetNumaNodeCpus(int node);
+
+// Parses a CPU list in the format of the kernel, e.g. "0-3,8,10-11\n", into
+// sorted CPU numbers. Returns an empty vector if it is malformed.
+RTC_EXPORT std::vector<int> ParseCpuList(absl::string_view cpu_list);
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_THREAD_PLACEMENT_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/thread_placement.h"
+
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#endif
+
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+#if defined(WEBRTC_LINUX)
+// Returns the CPUs that the calling thread may run on.
+std::vector<int> GetCurrentThreadCpus() {
+  std::vector<int> cpus;
+  cpu_set_t cpu_set;
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set))
+        cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+struct PlacedThreadResult {
+  std::vector<int> cpus;
+};
+
+void RecordCpus(void* obj) {
+  static_cast<PlacedThreadResult*>(obj)->cpus = GetCurrentThreadCpus();
+}
+#endif  // defined(WEBRTC_LINUX)
+
+}  // namespace
+
+TEST(ThreadPlacementTest, ParsesCpuList) {
+  EXPECT_THAT(ParseCpuList("0"), ElementsAre(0));
+  EXPECT_THAT(ParseCpuList("0-3,8,10-11\n"),
+              ElementsAre(0, 1, 2, 3, 8, 10, 11));
+  EXPECT_THAT(ParseCpuList("4-5,0-1,4"), ElementsAre(0, 1, 4, 5));
+  EXPECT_THAT(ParseCpuList(""), IsEmpty());
+  EXPECT_THAT(ParseCpuList("\n"), IsEmpty());
+}
+
+TEST(ThreadPlacementTest, RejectsMalformedCpuList) {
+  EXPECT_THAT(ParseCpuList("a"), IsEmpty());
+  EXPECT_THAT(ParseCpuList("0,"), IsEmpty());
+  EXPECT_THAT(ParseCpuList("3-1"), IsEmpty());
+  EXPECT_THAT(ParseCpuList("-1"), IsEmpty());
+  EXPECT_THAT(ParseCpuList("0-100000"), IsEmpty());
+}
+
+TEST(ThreadPlacementTest, UnsetPlacementIsApplied) {
+  EXPECT_FALSE(ThreadPlacement().IsSet());
+  EXPECT_TRUE(ApplyThreadPlacement(ThreadPlacement()));
+}
+
+#if defined(WEBRTC_LINUX)
+TEST(ThreadPlacementTest, PlacesPlatformThreadOnCpus) {
+  std::vector<int> cpus = GetCurrentThreadCpus();
+  ASSERT_FALSE(cpus.empty());
+  ThreadPlacement placement;
+  placement.cpus = {cpus.back()};
+
+  PlacedThreadResult result;
+  PlatformThread thread(&RecordCpus, &result, "PlacedThread");
+  thread.SetPlacement(placement);
+  thread.Start();
+  thread.Stop();
+  EXPECT_THAT(result.cpus, ElementsAre(cpus.back()));
+  // The placement doesn't leak to the creating thread.
+  EXPECT_EQ(cpus, GetCurrentThreadCpus());
+}
+
+TEST(ThreadPlacementTest, FailsWithoutUsableCpus) {
+  ThreadPlacement placement;
+  placement.cpus = {CPU_SETSIZE};
+  EXPECT_FALSE(ApplyThreadPlacement(placement));
+}
+#endif  // defined(WEBRTC_LINUX)
+
+}  // namespace rtc
@@ -900,5 +900,76 @@ TEST(ThreadPostTaskTest, InvokesInPostedOrder) {
   fourth.Wait(Event::kForever);
 }
 
+TEST(ThreadPostTaskAndReplyTest, RepliesWithResultOnReplyThread) {
+  std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
+  background_thread->Start();
+  std::unique_ptr<rtc::Thread> reply_thread(rtc::Thread::Create());
+  reply_thread->Start();
+
+  Event event;
+  bool replied_on_reply_thread = false;
+  int reply_result = 0;
+  background_thread->PostTaskAndReply(
+      RTC_FROM_HERE, reply_thread.get(),
+      [&] {
+        EXPECT_TRUE(background_thread->IsCurrent());
+        return std::make_unique<int>(42);
+      },
+      [&](std::unique_ptr<int> result) {
+        replied_on_reply_thread = reply_thread->IsCurrent();
+        reply_result = *result;
+        event.Set();
+      });
+  event.Wait(Event::kForever);
+
+  EXPECT_TRUE(replied_on_reply_thread);
+  EXPECT_EQ(42, reply_result);
+}
+
+TEST(ThreadPostTaskAndReplyTest, RepliesAfterVoidFunctor) {
+  std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
+  background_thread->Start();
+  std::unique_ptr<rtc::Thread> reply_thread(rtc::Thread::Create());
+  reply_thread->Start();
+
+  Event event;
+  bool functor_ran = false;
+  bool functor_ran_before_reply = false;
+  background_thread->PostTaskAndReply(
+      RTC_FROM_HERE, reply_thread.get(), [&] { functor_ran = true; },
+      [&] {
+        functor_ran_before_reply = functor_ran;
+        event.Set();
+      });
+  event.Wait(Event::kForever);
+
+  EXPECT_TRUE(functor_ran_before_reply);
+}
+
+TEST(ThreadTest, CountsBlockingCalls) {
+  std::unique_ptr<rtc::Thread> calling_thread(rtc::Thread::Create());
+  calling_thread->Start();
+  std::unique_ptr<rtc::Thread> other_thread(rtc::Thread::Create());
+  other_thread->Start();
+
+  uint32_t blocking_calls = 0;
+  uint32_t could_be_blocking_calls = 0;
+  calling_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    Thread::ScopedCountBlockingCalls counter(
+        [&](uint32_t blocking, uint32_t could_be_blocking) {
+          blocking_calls = blocking;
+          could_be_blocking_calls = could_be_blocking;
+        });
+    other_thread->Invoke<void>(RTC_FROM_HERE, [] {});
+    other_thread->Invoke<void>(RTC_FROM_HERE, [] {});
+    calling_thread->Invoke<void>(RTC_FROM_HERE, [] {});
+    EXPECT_EQ(2u, counter.GetBlockingCallCount());
+    EXPECT_EQ(1u, counter.GetCouldBeBlockingCallCount());
+  });
+
+  EXPECT_EQ(2u, blocking_calls);
+  EXPECT_EQ(1u, could_be_blocking_calls);
+}
+
 }  // namespace
 }  // namespace rtc
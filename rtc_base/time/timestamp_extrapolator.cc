@@ -15,8 +15,7 @@
 namespace webrtc {
 
 TimestampExtrapolator::TimestampExtrapolator(int64_t start_ms)
-    : _rwLock(RWLockWrapper::CreateRWLock()),
-      _startMs(0),
+    : _startMs(0),
       _firstTimestamp(0),
       _wrapArounds(0),
       _prevUnwrappedTimestamp(-1),
@@ -34,12 +33,9 @@ TimestampExtrapolator::TimestampExtrapolator(int64_t start_ms)
   Reset(start_ms);
 }
 
-TimestampExtrapolator::~TimestampExtrapolator() {
-  delete _rwLock;
-}
+TimestampExtrapolator::~TimestampExtrapolator() {}
 
 void TimestampExtrapolator::Reset(int64_t start_ms) {
-  WriteLockScoped wl(*_rwLock);
   _startMs = start_ms;
   _prevMs = _startMs;
   _firstTimestamp = 0;
@@ -58,13 +54,10 @@ void TimestampExtrapolator::Reset(int64_t start_ms) {
 }
 
 void TimestampExtrapolator::Update(int64_t tMs, uint32_t ts90khz) {
-  _rwLock->AcquireLockExclusive();
   if (tMs - _prevMs > 10e3) {
     // Ten seconds without a complete frame.
     // Reset the extrapolator
-    _rwLock->ReleaseLockExclusive();
     Reset(tMs);
-    _rwLock->AcquireLockExclusive();
   } else {
     _prevMs = tMs;
   }
@@ -100,7 +93,6 @@ void TimestampExtrapolator::Update(int64_t tMs, uint32_t ts90khz) {
   if (_prevUnwrappedTimestamp >= 0 &&
       unwrapped_ts90khz < _prevUnwrappedTimestamp) {
     // Drop reordered frames.
-    _rwLock->ReleaseLockExclusive();
     return;
   }
 
@@ -131,11 +123,9 @@ void TimestampExtrapolator::Update(int64_t tMs, uint32_t ts90khz) {
   if (_packetCount < _startUpFilterDelayInPackets) {
     _packetCount++;
   }
-  _rwLock->ReleaseLockExclusive();
 }
 
 int64_t TimestampExtrapolator::ExtrapolateLocalTime(uint32_t timestamp90khz) {
-  ReadLockScoped rl(*_rwLock);
   int64_t localTimeMs = 0;
   CheckForWrapArounds(timestamp90khz);
   double unwrapped_ts90khz =
@@ -13,10 +13,9 @@
 
 #include <stdint.h>
 
-#include "rtc_base/synchronization/rw_lock_wrapper.h"
-
 namespace webrtc {
 
+// Not thread safe; the owner serializes the calls.
 class TimestampExtrapolator {
  public:
   explicit TimestampExtrapolator(int64_t start_ms);
@@ -28,7 +27,6 @@ class TimestampExtrapolator {
  private:
   void CheckForWrapArounds(uint32_t ts90khz);
   bool DelayChangeDetection(double error);
-  RWLockWrapper* _rwLock;
   double _w[2];
   double _pP[2][2];
   int64_t _startMs;
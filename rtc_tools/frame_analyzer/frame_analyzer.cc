@@ -26,6 +26,7 @@
 #include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
 #include "rtc_tools/video_file_reader.h"
 #include "rtc_tools/video_file_writer.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/perf_test.h"
 
 ABSL_FLAG(int32_t, width, -1, "The width of the reference and test files");
@@ -52,6 +53,11 @@ ABSL_FLAG(std::string,
           "",
           "Where to write aligned YUV ref+test output files, if not present, "
           "no files will be written");
+ABSL_FLAG(int32_t,
+          num_threads,
+          0,
+          "The number of threads to analyze the frames on, 0 to use one "
+          "thread per CPU core");
 ABSL_FLAG(std::string,
           chartjson_result_file,
           "",
@@ -147,8 +153,12 @@ int main(int argc, char* argv[]) {
   const rtc::scoped_refptr<webrtc::test::Video> color_adjusted_test_video =
       AdjustColors(color_transformation, test_video);
 
-  results.frames = webrtc::test::RunAnalysis(
-      aligned_reference_video, color_adjusted_test_video, matching_indices);
+  int num_threads = absl::GetFlag(FLAGS_num_threads);
+  if (num_threads <= 0)
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+  results.frames = webrtc::test::RunAnalysis(aligned_reference_video,
+                                             color_adjusted_test_video,
+                                             matching_indices, num_threads);
 
   const std::vector<webrtc::test::Cluster> clusters =
       webrtc::test::CalculateFrameClusters(matching_indices);
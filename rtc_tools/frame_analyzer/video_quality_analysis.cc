@@ -13,9 +13,14 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <memory>
+#include <string>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "test/testsupport/perf_test.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
@@ -53,24 +58,66 @@ double Ssim(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
   return CalculateMetric(&libyuv::I420Ssim, ref_buffer, test_buffer);
 }
 
+namespace {
+
+// Shared by the threads of RunAnalysis(), which take turns picking the next
+// frame to analyze.
+struct AnalysisState {
+  rtc::scoped_refptr<Video> reference_video;
+  rtc::scoped_refptr<Video> test_video;
+  std::vector<AnalysisResult>* results;
+  rtc::CriticalSection crit;
+  size_t next_frame RTC_GUARDED_BY(crit) = 0;
+};
+
+void AnalyzeFrames(void* obj) {
+  AnalysisState* state = static_cast<AnalysisState*>(obj);
+  while (true) {
+    size_t i;
+    {
+      rtc::CritScope lock(&state->crit);
+      if (state->next_frame == state->results->size())
+        return;
+      i = state->next_frame++;
+    }
+    const rtc::scoped_refptr<I420BufferInterface> test_frame =
+        state->test_video->GetFrame(i);
+    const rtc::scoped_refptr<I420BufferInterface> reference_frame =
+        state->reference_video->GetFrame(i);
+
+    // Each thread fills in the results of its own frames.
+    AnalysisResult& result = (*state->results)[i];
+    result.psnr_value = Psnr(reference_frame, test_frame);
+    result.ssim_value = Ssim(reference_frame, test_frame);
+  }
+}
+
+}  // namespace
+
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
-    const rtc::scoped_refptr<I420BufferInterface>& test_frame =
-        test_video->GetFrame(i);
-    const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
-        reference_video->GetFrame(i);
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = test_frame_indices[i];
-    result.psnr_value = Psnr(reference_frame, test_frame);
-    result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads) {
+  RTC_CHECK_GT(num_threads, 0);
+  std::vector<AnalysisResult> results(test_video->number_of_frames());
+  for (size_t i = 0; i < results.size(); ++i)
+    results[i].frame_number = test_frame_indices[i];
+
+  AnalysisState state;
+  state.reference_video = reference_video;
+  state.test_video = test_video;
+  state.results = &results;
+  // The calling thread analyzes frames too.
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 1; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &AnalyzeFrames, &state, "FrameAnalysis" + std::to_string(i)));
+    threads.back()->Start();
   }
+  AnalyzeFrames(&state);
+  for (auto& thread : threads)
+    thread->Stop();
 
   return results;
 }
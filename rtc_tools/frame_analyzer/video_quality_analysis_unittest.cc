@@ -19,6 +19,8 @@
 #include <fstream>
 #include <string>
 
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
+#include "rtc_tools/video_file_reader.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -127,6 +129,38 @@ TEST_F(VideoQualityAnalysisTest,
   VerifyLogOutput(log_filename, expected_out);
 }
 
+TEST_F(VideoQualityAnalysisTest, RunAnalysisOnSeveralThreads) {
+  const rtc::scoped_refptr<Video> reference_video =
+      OpenYuvFile(ResourcePath("foreman_128x96", "yuv"), 128, 96);
+  ASSERT_TRUE(reference_video);
+  // Compare every frame to the one after it.
+  std::vector<size_t> indices;
+  for (size_t i = 1; i < reference_video->number_of_frames(); ++i)
+    indices.push_back(i);
+  const rtc::scoped_refptr<Video> test_video =
+      ReorderVideo(reference_video, indices);
+  indices.pop_back();
+  indices.insert(indices.begin(), 0);
+  const rtc::scoped_refptr<Video> shifted_reference_video =
+      ReorderVideo(reference_video, indices);
+
+  const std::vector<AnalysisResult> expected =
+      RunAnalysis(shifted_reference_video, test_video, indices,
+                  /*num_threads=*/1);
+  const std::vector<AnalysisResult> results =
+      RunAnalysis(shifted_reference_video, test_video, indices,
+                  /*num_threads=*/4);
+
+  ASSERT_EQ(test_video->number_of_frames(), results.size());
+  ASSERT_EQ(expected.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(indices[i]), results[i].frame_number);
+    EXPECT_EQ(expected[i].psnr_value, results[i].psnr_value);
+    EXPECT_EQ(expected[i].ssim_value, results[i].ssim_value);
+    EXPECT_LT(results[i].ssim_value, 1.0);
+  }
+}
+
 TEST_F(VideoQualityAnalysisTest, CalculateFrameClustersOneValue) {
   const std::vector<Cluster> result = CalculateFrameClusters({1});
   EXPECT_EQ(1u, result.size());
@@ -12,7 +12,9 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <numeric>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -20,8 +22,15 @@
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
 #include "rtc_tools/video_file_reader.h"
+#include "system_wrappers/include/cpu_info.h"
 
+ABSL_FLAG(int32_t,
+          num_threads,
+          0,
+          "The number of threads to analyze the frames on, 0 to use one "
+          "thread per CPU core");
 ABSL_FLAG(std::string,
           results_file,
           "results.txt",
@@ -38,22 +47,23 @@ ABSL_FLAG(std::string,
 void CompareFiles(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const char* results_file_name) {
-  FILE* results_file = fopen(results_file_name, "w");
-
+    const char* results_file_name,
+    int num_threads) {
   const size_t num_frames = std::min(reference_video->number_of_frames(),
                                      test_video->number_of_frames());
-  for (size_t i = 0; i < num_frames; ++i) {
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> ref_buffer =
-        reference_video->GetFrame(i);
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> test_buffer =
-        test_video->GetFrame(i);
+  std::vector<size_t> indices(num_frames);
+  std::iota(indices.begin(), indices.end(), 0);
+  // Calculate the PSNR and SSIM of the frames both videos have.
+  const std::vector<webrtc::test::AnalysisResult> results =
+      webrtc::test::RunAnalysis(
+          webrtc::test::ReorderVideo(reference_video, indices),
+          webrtc::test::ReorderVideo(test_video, indices), indices,
+          num_threads);
 
-    // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::Psnr(ref_buffer, test_buffer);
-    double result_ssim = webrtc::test::Ssim(ref_buffer, test_buffer);
-    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i, result_psnr,
-            result_ssim);
+  FILE* results_file = fopen(results_file_name, "w");
+  for (const webrtc::test::AnalysisResult& result : results) {
+    fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n",
+            result.frame_number, result.psnr_value, result.ssim_value);
   }
 
   fclose(results_file);
@@ -102,7 +112,10 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  int num_threads = absl::GetFlag(FLAGS_num_threads);
+  if (num_threads <= 0)
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
   CompareFiles(reference_video, test_video,
-               absl::GetFlag(FLAGS_results_file).c_str());
+               absl::GetFlag(FLAGS_results_file).c_str(), num_threads);
   return 0;
 }
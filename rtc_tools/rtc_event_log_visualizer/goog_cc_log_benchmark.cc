@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_control.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(int,
+          controllers,
+          1,
+          "Number of controllers to replay the log through. Every message is "
+          "delivered to all controllers in turn, as by a host that serves "
+          "many senders in one task.");
+
+ABSL_FLAG(int, iterations, 1, "Number of times to replay the log.");
+
+ABSL_FLAG(
+    std::string,
+    force_fieldtrials,
+    "",
+    "Field trials control experimental feature code which can be forced. "
+    "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enabled/"
+    " will assign the group Enabled to field trial WebRTC-FooFeature. Multiple "
+    "trials are separated by \"/\"");
+
+namespace webrtc {
+namespace {
+
+// The messages a network controller received during a log simulation, which
+// can be delivered again to any controller.
+struct Recording {
+  struct Message {
+    std::function<NetworkControlUpdate(NetworkControllerInterface*)> deliver;
+    bool is_feedback;
+  };
+  NetworkControllerConfig config;
+  std::vector<Message> messages;
+};
+
+class RecordingNetworkController : public NetworkControllerInterface {
+ public:
+  explicit RecordingNetworkController(Recording* recording)
+      : recording_(recording) {}
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    return Record(&NetworkControllerInterface::OnNetworkAvailability, msg);
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    return Record(&NetworkControllerInterface::OnNetworkRouteChange, msg);
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    return Record(&NetworkControllerInterface::OnProcessInterval, msg);
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override {
+    return Record(&NetworkControllerInterface::OnRemoteBitrateReport, msg);
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override {
+    return Record(&NetworkControllerInterface::OnRoundTripTimeUpdate, msg);
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    return Record(&NetworkControllerInterface::OnSentPacket, msg);
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override {
+    return Record(&NetworkControllerInterface::OnReceivedPacket, msg);
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    return Record(&NetworkControllerInterface::OnStreamsConfig, msg);
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    return Record(&NetworkControllerInterface::OnTargetRateConstraints, msg);
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override {
+    return Record(&NetworkControllerInterface::OnTransportLossReport, msg);
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    return Record(&NetworkControllerInterface::OnTransportPacketsFeedback, msg,
+                  /*is_feedback=*/true);
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override {
+    return Record(&NetworkControllerInterface::OnNetworkStateEstimate, msg);
+  }
+
+ private:
+  template <typename T>
+  NetworkControlUpdate Record(
+      NetworkControlUpdate (NetworkControllerInterface::*handler)(T),
+      const T& msg,
+      bool is_feedback = false) {
+    recording_->messages.push_back(
+        {[handler, msg](NetworkControllerInterface* controller) {
+           return (controller->*handler)(msg);
+         },
+         is_feedback});
+    return NetworkControlUpdate();
+  }
+
+  Recording* const recording_;
+};
+
+class RecordingNetworkControllerFactory
+    : public NetworkControllerFactoryInterface {
+ public:
+  explicit RecordingNetworkControllerFactory(Recording* recording)
+      : recording_(recording) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    recording_->config = config;
+    return std::make_unique<RecordingNetworkController>(recording_);
+  }
+  TimeDelta GetProcessInterval() const override {
+    return GoogCcNetworkControllerFactory().GetProcessInterval();
+  }
+
+ private:
+  Recording* const recording_;
+};
+
+struct ReplayResult {
+  int64_t num_feedbacks = 0;
+  int64_t feedback_time_ns = 0;
+  int64_t total_time_ns = 0;
+};
+
+ReplayResult Replay(const Recording& recording, int num_controllers) {
+  RtcEventLogNull event_log;
+  NetworkControllerConfig config = recording.config;
+  config.event_log = &event_log;
+  GoogCcNetworkControllerFactory factory;
+  std::vector<std::unique_ptr<NetworkControllerInterface>> controllers;
+  for (int i = 0; i < num_controllers; ++i)
+    controllers.push_back(factory.Create(config));
+
+  ReplayResult result;
+  for (const Recording::Message& message : recording.messages) {
+    const int64_t start_ns = rtc::TimeNanos();
+    for (const auto& controller : controllers)
+      message.deliver(controller.get());
+    const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+    result.total_time_ns += elapsed_ns;
+    if (message.is_feedback) {
+      result.num_feedbacks += num_controllers;
+      result.feedback_time_ns += elapsed_ns;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Replays the transport feedback in a WebRTC event log through GoogCC "
+      "and reports the time spent per feedback message.\n"
+      "Example usage:\n"
+      "./goog_cc_log_benchmark --controllers=100 <logfile>\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 2) {
+    std::cerr << "Expected one event log file." << std::endl;
+    return 1;
+  }
+
+  // InitFieldTrialsFromString stores the char*, so the char array must outlive
+  // the application.
+  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+
+  webrtc::ParsedRtcEventLog parsed_log(
+      webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::
+          kAttemptWebrtcDefaultConfig);
+  if (!parsed_log.ParseFile(args[1])) {
+    std::cerr << "Could not parse the entire log file." << std::endl;
+    std::cerr << "Only the parsable events will be replayed." << std::endl;
+  }
+
+  // Run the log through the simulation once, so that the replays only measure
+  // the controllers and not the log parsing and feedback adaptation.
+  webrtc::Recording recording;
+  webrtc::LogBasedNetworkControllerSimulation simulation(
+      std::make_unique<webrtc::RecordingNetworkControllerFactory>(&recording),
+      [](const webrtc::NetworkControlUpdate&, webrtc::Timestamp) {});
+  simulation.ProcessEventsInLog(parsed_log);
+
+  const int num_controllers = std::max(1, absl::GetFlag(FLAGS_controllers));
+  webrtc::ReplayResult total;
+  for (int i = 0; i < absl::GetFlag(FLAGS_iterations); ++i) {
+    webrtc::ReplayResult result = webrtc::Replay(recording, num_controllers);
+    total.num_feedbacks += result.num_feedbacks;
+    total.feedback_time_ns += result.feedback_time_ns;
+    total.total_time_ns += result.total_time_ns;
+  }
+  if (total.num_feedbacks == 0) {
+    std::cerr << "No transport feedback in the log." << std::endl;
+    return 1;
+  }
+
+  printf("Controllers: %d\n", num_controllers);
+  printf("Feedback messages: %lld\n",
+         static_cast<long long>(total.num_feedbacks));
+  printf("Time per feedback: %lld ns\n",
+         static_cast<long long>(total.feedback_time_ns / total.num_feedbacks));
+  printf("Total time per feedback, including other messages: %lld ns\n",
+         static_cast<long long>(total.total_time_ns / total.num_feedbacks));
+  return 0;
+}
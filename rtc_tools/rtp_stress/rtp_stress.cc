@@ -0,0 +1,548 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/types/optional.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/include/module_common_types_public.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "p2p/base/packet_transport_internal.h"
+#include "pc/rtp_transport.h"
+#include "pc/srtp_transport.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/samples_stats_counter.h"
+#include "rtc_base/random.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+
+ABSL_FLAG(int, num_streams, 4, "Number of sent video streams.");
+ABSL_FLAG(int,
+          simulcast_layers,
+          1,
+          "Number of simulcast layers, each with an SSRC of its own, per "
+          "stream. Each layer sends four times the packets of the one below.");
+ABSL_FLAG(std::string,
+          packet_rates,
+          "1000,10000,50000,100000",
+          "Comma separated total RTP packet rates, in packets per second, to "
+          "run one after the other.");
+ABSL_FLAG(int, duration_s, 5, "Seconds to send at each packet rate.");
+ABSL_FLAG(int, payload_size, 1000, "RTP payload size in bytes.");
+ABSL_FLAG(double,
+          loss_percent,
+          0.0,
+          "Percentage of RTP packets the sender drops, leaving gaps in the "
+          "sequence numbers.");
+ABSL_FLAG(double,
+          reorder_percent,
+          0.0,
+          "Percentage of RTP packets the sender sends after the next one.");
+ABSL_FLAG(int,
+          rtcp_interval_ms,
+          1000,
+          "Interval between the sender reports sent for every SSRC.");
+ABSL_FLAG(bool, srtp, false, "Protect the packets with SRTP.");
+ABSL_FLAG(int,
+          srtp_unprotect_workers,
+          0,
+          "If positive, the receiver unprotects SRTP packets on this many task "
+          "queues instead of the network thread.");
+ABSL_FLAG(int,
+          receive_buffer_bytes,
+          0,
+          "If positive, the receive buffer size of the receiver socket.");
+ABSL_FLAG(double,
+          saturation_drop_percent,
+          1.0,
+          "Percentage of packets lost on the way to the receiver from which "
+          "the receiver is deemed saturated.");
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kPayloadType = 96;
+constexpr size_t kMaxPacketSize = 1500;
+constexpr int kDrainTimeMs = 500;
+constexpr uint32_t kFirstSsrc = 1000;
+
+// Sends and receives the packets of an RtpTransport over a UDP socket.
+class UdpPacketTransport : public rtc::PacketTransportInternal {
+ public:
+  explicit UdpPacketTransport(std::unique_ptr<rtc::AsyncPacketSocket> socket)
+      : socket_(std::move(socket)) {
+    socket_->SignalReadPacket.connect(this, &UdpPacketTransport::OnReadPacket);
+  }
+
+  rtc::SocketAddress local_address() const {
+    return socket_->GetLocalAddress();
+  }
+  void set_remote_address(const rtc::SocketAddress& address) {
+    remote_address_ = address;
+  }
+
+  const std::string& transport_name() const override { return name_; }
+  bool writable() const override { return true; }
+  bool receiving() const override { return true; }
+  int SendPacket(const char* data,
+                 size_t len,
+                 const rtc::PacketOptions& options,
+                 int flags) override {
+    return socket_->SendTo(data, len, remote_address_, options);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return socket_->SetOption(opt, value);
+  }
+  int GetError() override { return socket_->GetError(); }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t len,
+                    const rtc::SocketAddress& remote_address,
+                    const int64_t& packet_time_us) {
+    SignalReadPacket(this, data, len, packet_time_us, 0);
+  }
+
+  const std::string name_ = "udp";
+  const std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  rtc::SocketAddress remote_address_;
+};
+
+std::unique_ptr<RtpTransport> CreateRtpTransport(bool srtp) {
+  if (!srtp)
+    return std::make_unique<RtpTransport>(/*rtcp_mux_enabled=*/true);
+  return std::make_unique<SrtpTransport>(/*rtcp_mux_enabled=*/true);
+}
+
+void SetSrtpKeys(RtpTransport* transport) {
+  static const uint8_t kKey[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ1234";
+  static constexpr int kKeyLen = 30;
+  RTC_CHECK(static_cast<SrtpTransport*>(transport)->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kKey, kKeyLen, {},
+      rtc::SRTP_AES128_CM_SHA1_80, kKey, kKeyLen, {}));
+}
+
+// What the receiver saw during one packet rate step. Only accessed on the
+// receiver network thread.
+struct ReceiveStats {
+  int64_t packets = 0;
+  int64_t reordered = 0;
+  int64_t rtcp_packets = 0;
+  SamplesStatsCounter latency_ms;
+};
+
+// Receives the packets of one SSRC. The sender puts its send time in the
+// first bytes of the payload, which gives the one way latency since both run
+// in this process.
+class ReceiveStream : public RtpPacketSinkInterface {
+ public:
+  explicit ReceiveStream(ReceiveStats* stats) : stats_(stats) {}
+
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    const int64_t now_us = rtc::TimeMicros();
+    ++stats_->packets;
+    const int64_t sequence_number =
+        unwrapper_.Unwrap(packet.SequenceNumber());
+    if (sequence_number < highest_sequence_number_)
+      ++stats_->reordered;
+    else
+      highest_sequence_number_ = sequence_number;
+    if (packet.payload_size() >= sizeof(int64_t)) {
+      const int64_t send_time_us =
+          ByteReader<int64_t>::ReadBigEndian(packet.payload().data());
+      stats_->latency_ms.AddSample((now_us - send_time_us) / 1000.0);
+    }
+  }
+
+ private:
+  ReceiveStats* const stats_;
+  SequenceNumberUnwrapper unwrapper_;
+  int64_t highest_sequence_number_ = -1;
+};
+
+class Receiver : public sigslot::has_slots<> {
+ public:
+  Receiver(rtc::Thread* network_thread,
+           TaskQueueFactory* task_queue_factory,
+           const std::vector<uint32_t>& ssrcs) {
+    RTC_DCHECK(network_thread->IsCurrent());
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(rtc::AsyncUDPSocket::Create(
+        network_thread->socketserver(),
+        rtc::SocketAddress("127.0.0.1", 0)));
+    RTC_CHECK(socket);
+    packet_transport_ = std::make_unique<UdpPacketTransport>(std::move(socket));
+    if (absl::GetFlag(FLAGS_receive_buffer_bytes) > 0) {
+      packet_transport_->SetOption(rtc::Socket::OPT_RCVBUF,
+                                   absl::GetFlag(FLAGS_receive_buffer_bytes));
+    }
+    transport_ = CreateRtpTransport(absl::GetFlag(FLAGS_srtp));
+    if (absl::GetFlag(FLAGS_srtp)) {
+      if (absl::GetFlag(FLAGS_srtp_unprotect_workers) > 0) {
+        static_cast<SrtpTransport*>(transport_.get())
+            ->EnableParallelUnprotect(
+                task_queue_factory,
+                absl::GetFlag(FLAGS_srtp_unprotect_workers));
+      }
+      SetSrtpKeys(transport_.get());
+    }
+    transport_->SetRtpPacketTransport(packet_transport_.get());
+    transport_->SignalRtcpPacketReceived.connect(this,
+                                                 &Receiver::OnRtcpPacket);
+    for (uint32_t ssrc : ssrcs) {
+      streams_.push_back(std::make_unique<ReceiveStream>(&stats_));
+      RtpDemuxerCriteria criteria;
+      criteria.ssrcs.insert(ssrc);
+      RTC_CHECK(
+          transport_->RegisterRtpDemuxerSink(criteria, streams_.back().get()));
+    }
+  }
+
+  ~Receiver() override {
+    for (const auto& stream : streams_)
+      transport_->UnregisterRtpDemuxerSink(stream.get());
+  }
+
+  rtc::SocketAddress address() const {
+    return packet_transport_->local_address();
+  }
+
+  // Returns the stats since the previous call.
+  ReceiveStats TakeStats() {
+    ReceiveStats stats = std::move(stats_);
+    stats_ = ReceiveStats();
+    return stats;
+  }
+
+ private:
+  void OnRtcpPacket(rtc::CopyOnWriteBuffer* packet, int64_t packet_time_us) {
+    ++stats_.rtcp_packets;
+  }
+
+  std::unique_ptr<UdpPacketTransport> packet_transport_;
+  std::unique_ptr<RtpTransport> transport_;
+  ReceiveStats stats_;
+  std::vector<std::unique_ptr<ReceiveStream>> streams_;
+};
+
+// What the sender did during one packet rate step.
+struct SendStats {
+  int64_t packets = 0;
+  int64_t dropped_by_sender = 0;
+  int64_t send_errors = 0;
+  int64_t elapsed_us = 0;
+};
+
+struct SendStream {
+  uint32_t ssrc;
+  int weight;
+  int credit = 0;
+  uint16_t sequence_number = 0;
+  int64_t packets = 0;
+  int64_t octets = 0;
+};
+
+class Sender {
+ public:
+  Sender(rtc::Thread* network_thread, const std::vector<SendStream>& streams)
+      : streams_(streams), random_(0x5eed) {
+    RTC_DCHECK(network_thread->IsCurrent());
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(rtc::AsyncUDPSocket::Create(
+        network_thread->socketserver(),
+        rtc::SocketAddress("127.0.0.1", 0)));
+    RTC_CHECK(socket);
+    packet_transport_ = std::make_unique<UdpPacketTransport>(std::move(socket));
+    transport_ = CreateRtpTransport(absl::GetFlag(FLAGS_srtp));
+    if (absl::GetFlag(FLAGS_srtp))
+      SetSrtpKeys(transport_.get());
+    transport_->SetRtpPacketTransport(packet_transport_.get());
+    for (const SendStream& stream : streams_)
+      total_weight_ += stream.weight;
+  }
+
+  void set_remote_address(const rtc::SocketAddress& address) {
+    packet_transport_->set_remote_address(address);
+  }
+
+  // Sends RTP packets at |packet_rate| for |duration_ms|, blocking the
+  // calling thread, with sender reports every --rtcp_interval_ms.
+  SendStats Send(int packet_rate, int64_t duration_ms) {
+    const double loss_probability = absl::GetFlag(FLAGS_loss_percent) / 100;
+    const double reorder_probability =
+        absl::GetFlag(FLAGS_reorder_percent) / 100;
+    const int64_t rtcp_interval_us =
+        absl::GetFlag(FLAGS_rtcp_interval_ms) * rtc::kNumMicrosecsPerMillisec;
+    SendStats stats;
+    const int64_t start_us = rtc::TimeMicros();
+    const int64_t end_us =
+        start_us + duration_ms * rtc::kNumMicrosecsPerMillisec;
+    int64_t next_rtcp_us = start_us;
+    absl::optional<rtc::CopyOnWriteBuffer> held_packet;
+    for (int64_t packet_index = 0;; ++packet_index) {
+      const int64_t send_time_us =
+          start_us + packet_index * rtc::kNumMicrosecsPerSec / packet_rate;
+      if (send_time_us >= end_us)
+        break;
+      int64_t now_us = rtc::TimeMicros();
+      // Sleep when ahead of time, and catch up without pausing when late.
+      while (now_us < send_time_us) {
+        const int64_t wait_us = send_time_us - now_us;
+        if (wait_us >= 2 * rtc::kNumMicrosecsPerMillisec)
+          rtc::Thread::SleepMs(wait_us / rtc::kNumMicrosecsPerMillisec - 1);
+        now_us = rtc::TimeMicros();
+      }
+      if (now_us >= next_rtcp_us) {
+        SendSenderReports(&stats);
+        next_rtcp_us += rtcp_interval_us;
+      }
+
+      SendStream* stream = NextStream();
+      rtc::CopyOnWriteBuffer packet = CreatePacket(stream, now_us);
+      if (random_.Rand<double>() < loss_probability) {
+        ++stats.dropped_by_sender;
+        continue;
+      }
+      if (!held_packet && random_.Rand<double>() < reorder_probability) {
+        held_packet = std::move(packet);
+        continue;
+      }
+      SendRtp(&packet, &stats);
+      if (held_packet) {
+        SendRtp(&*held_packet, &stats);
+        held_packet = absl::nullopt;
+      }
+    }
+    if (held_packet)
+      SendRtp(&*held_packet, &stats);
+    stats.elapsed_us = rtc::TimeMicros() - start_us;
+    return stats;
+  }
+
+ private:
+  // Picks streams in proportion to their weight, spread out evenly.
+  SendStream* NextStream() {
+    SendStream* next = nullptr;
+    for (SendStream& stream : streams_) {
+      stream.credit += stream.weight;
+      if (!next || stream.credit > next->credit)
+        next = &stream;
+    }
+    next->credit -= total_weight_;
+    return next;
+  }
+
+  rtc::CopyOnWriteBuffer CreatePacket(SendStream* stream, int64_t now_us) {
+    RtpPacketToSend packet(nullptr, kMaxPacketSize);
+    packet.SetPayloadType(kPayloadType);
+    packet.SetSequenceNumber(stream->sequence_number++);
+    packet.SetTimestamp(static_cast<uint32_t>(now_us * 90 / 1000));
+    packet.SetSsrc(stream->ssrc);
+    const size_t payload_size = std::max<size_t>(
+        absl::GetFlag(FLAGS_payload_size), sizeof(int64_t));
+    uint8_t* payload = packet.AllocatePayload(payload_size);
+    RTC_CHECK(payload);
+    memset(payload, 0, payload_size);
+    ByteWriter<int64_t>::WriteBigEndian(payload, now_us);
+    ++stream->packets;
+    stream->octets += payload_size;
+    return packet.Buffer();
+  }
+
+  void SendRtp(rtc::CopyOnWriteBuffer* packet, SendStats* stats) {
+    if (transport_->SendRtpPacket(packet, rtc::PacketOptions(), 0))
+      ++stats->packets;
+    else
+      ++stats->send_errors;
+  }
+
+  void SendSenderReports(SendStats* stats) {
+    const NtpTime ntp = Clock::GetRealTimeClock()->CurrentNtpTime();
+    for (const SendStream& stream : streams_) {
+      rtcp::SenderReport report;
+      report.SetSenderSsrc(stream.ssrc);
+      report.SetNtp(ntp);
+      report.SetPacketCount(stream.packets);
+      report.SetOctetCount(stream.octets);
+      rtc::Buffer built = report.Build();
+      rtc::CopyOnWriteBuffer packet(built.data(), built.size(),
+                                    kMaxPacketSize);
+      if (!transport_->SendRtcpPacket(&packet, rtc::PacketOptions(), 0))
+        ++stats->send_errors;
+    }
+  }
+
+  std::vector<SendStream> streams_;
+  int total_weight_ = 0;
+  Random random_;
+  std::unique_ptr<UdpPacketTransport> packet_transport_;
+  std::unique_ptr<RtpTransport> transport_;
+};
+
+std::vector<int> ParsePacketRates(const std::string& flag) {
+  std::vector<std::string> fields;
+  rtc::split(flag, ',', &fields);
+  std::vector<int> rates;
+  for (const std::string& field : fields) {
+    absl::optional<int> rate = rtc::StringToNumber<int>(field);
+    if (!rate || *rate <= 0) {
+      fprintf(stderr, "Invalid packet rate: %s\n", field.c_str());
+      exit(EXIT_FAILURE);
+    }
+    rates.push_back(*rate);
+  }
+  return rates;
+}
+
+int64_t GetCpuTimeNanos(rtc::Thread* thread) {
+  return thread->Invoke<int64_t>(RTC_FROM_HERE,
+                                 [] { return rtc::GetThreadCpuTimeNanos(); });
+}
+
+int Run() {
+  const std::vector<int> packet_rates =
+      ParsePacketRates(absl::GetFlag(FLAGS_packet_rates));
+  std::vector<SendStream> streams;
+  std::vector<uint32_t> ssrcs;
+  for (int i = 0; i < absl::GetFlag(FLAGS_num_streams); ++i) {
+    int weight = 1;
+    for (int layer = 0; layer < absl::GetFlag(FLAGS_simulcast_layers);
+         ++layer) {
+      SendStream stream;
+      stream.ssrc = kFirstSsrc + static_cast<uint32_t>(ssrcs.size());
+      stream.weight = weight;
+      streams.push_back(stream);
+      ssrcs.push_back(stream.ssrc);
+      weight *= 4;
+    }
+  }
+  if (streams.empty()) {
+    fprintf(stderr, "--num_streams and --simulcast_layers must be positive.\n");
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  std::unique_ptr<rtc::Thread> receive_thread =
+      rtc::Thread::CreateWithSocketServer();
+  receive_thread->SetName("receive_network", nullptr);
+  receive_thread->Start();
+  std::unique_ptr<rtc::Thread> send_thread =
+      rtc::Thread::CreateWithSocketServer();
+  send_thread->SetName("send_network", nullptr);
+  send_thread->Start();
+
+  std::unique_ptr<Receiver> receiver;
+  receive_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    receiver = std::make_unique<Receiver>(receive_thread.get(),
+                                          task_queue_factory.get(), ssrcs);
+  });
+  std::unique_ptr<Sender> sender;
+  send_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    sender = std::make_unique<Sender>(send_thread.get(), streams);
+    sender->set_remote_address(receiver->address());
+  });
+
+  printf("%10s %10s %10s %8s %10s %10s %8s %8s %8s %8s %8s\n", "target_pps",
+         "sent_pps", "recv_pps", "lost_%", "reordered", "rtcp_recv",
+         "lat_p50", "lat_p95", "lat_p99", "lat_max", "rx_cpu_%");
+  absl::optional<int> saturated_rate;
+  for (int packet_rate : packet_rates) {
+    const int64_t duration_ms =
+        absl::GetFlag(FLAGS_duration_s) * rtc::kNumMillisecsPerSec;
+    const int64_t start_cpu_ns = GetCpuTimeNanos(receive_thread.get());
+    const int64_t start_us = rtc::TimeMicros();
+    SendStats send_stats = send_thread->Invoke<SendStats>(
+        RTC_FROM_HERE, [&] { return sender->Send(packet_rate, duration_ms); });
+    // Leave the receiver time to handle what is still in flight.
+    rtc::Thread::SleepMs(kDrainTimeMs);
+    const int64_t receive_elapsed_us = rtc::TimeMicros() - start_us;
+    const int64_t receive_cpu_ns =
+        GetCpuTimeNanos(receive_thread.get()) - start_cpu_ns;
+    ReceiveStats receive_stats = receive_thread->Invoke<ReceiveStats>(
+        RTC_FROM_HERE, [&] { return receiver->TakeStats(); });
+
+    const double elapsed_s =
+        static_cast<double>(send_stats.elapsed_us) / rtc::kNumMicrosecsPerSec;
+    const int64_t lost = send_stats.packets - receive_stats.packets;
+    const double lost_percent =
+        send_stats.packets > 0 ? 100.0 * lost / send_stats.packets : 0.0;
+    SamplesStatsCounter& latency_ms = receive_stats.latency_ms;
+    const bool has_latency = !latency_ms.IsEmpty();
+    printf(
+        "%10d %10.0f %10.0f %8.2f %10" PRId64 " %10" PRId64
+        " %8.2f %8.2f %8.2f %8.2f %8.1f\n",
+        packet_rate, send_stats.packets / elapsed_s,
+        receive_stats.packets / elapsed_s, lost_percent,
+        receive_stats.reordered, receive_stats.rtcp_packets,
+        has_latency ? latency_ms.GetPercentile(0.5) : 0.0,
+        has_latency ? latency_ms.GetPercentile(0.95) : 0.0,
+        has_latency ? latency_ms.GetPercentile(0.99) : 0.0,
+        has_latency ? latency_ms.GetMax() : 0.0,
+        100.0 * receive_cpu_ns /
+            (receive_elapsed_us * rtc::kNumNanosecsPerMicrosec));
+    if (send_stats.send_errors > 0) {
+      printf("  %" PRId64 " packets could not be sent\n",
+             send_stats.send_errors);
+    }
+    if (!saturated_rate &&
+        lost_percent > absl::GetFlag(FLAGS_saturation_drop_percent)) {
+      saturated_rate = packet_rate;
+    }
+  }
+  if (saturated_rate) {
+    printf("Receiver saturated at %d packets per second.\n", *saturated_rate);
+  } else {
+    printf("Receiver kept up with all packet rates.\n");
+  }
+
+  send_thread->Invoke<void>(RTC_FROM_HERE, [&] { sender = nullptr; });
+  receive_thread->Invoke<void>(RTC_FROM_HERE, [&] { receiver = nullptr; });
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Sends synthetic RTP and RTCP traffic over UDP on the loopback "
+      "interface to an RtpTransport, or an SrtpTransport with --srtp, at "
+      "increasing packet rates, and reports how the receiver keeps up.\n"
+      "Example usage:\n"
+      "./rtp_stress --num_streams=8 --simulcast_layers=3 --srtp\n"
+      "             --packet_rates=20000,50000,100000 --loss_percent=1\n");
+  absl::ParseCommandLine(argc, argv);
+  rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  return webrtc::Run();
+}
@@ -18,10 +18,12 @@
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_to_number.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -54,8 +56,10 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
-    fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    // Only one frame is read at a time, since the file position is shared.
+    rtc::CritScope lock(&file_crit_);
+    fsetpos(file_, &frame_positions_[frame_index]);
 
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
@@ -73,7 +77,8 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  rtc::CriticalSection file_crit_;
+  FILE* const file_ RTC_PT_GUARDED_BY(file_crit_);
 };
 
 }  // namespace
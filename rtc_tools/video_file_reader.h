@@ -23,8 +23,10 @@
 namespace webrtc {
 namespace test {
 
-// Iterable class representing a sequence of I420 buffers. This class is not
-// thread safe because it is expected to be backed by a file.
+// Iterable class representing a sequence of I420 buffers. The frames are read
+// from the file when requested, so a video is never loaded into memory as a
+// whole. GetFrame() may be called from several threads at once, which allows
+// frames to be analyzed in parallel.
 class Video : public rtc::RefCountInterface {
  public:
   class Iterator {
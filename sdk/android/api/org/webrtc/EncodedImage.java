@@ -58,13 +58,13 @@ public class EncodedImage implements RefCounted {
   public final boolean completeFrame;
   public final @Nullable Integer qp;
 
-  // TODO(bugs.webrtc.org/9378): Use retain and release from jni code.
   @Override
   public void retain() {
     refCountDelegate.retain();
   }
 
   @Override
+  @CalledByNative
   public void release() {
     refCountDelegate.release();
   }
@@ -81,6 +81,13 @@ public class EncodedImage implements RefCounted {
     }
   }
 
+  // Creates a release callback that drops a reference to the native buffer wrapped by the
+  // ByteBuffer of an image created by native code.
+  @CalledByNative
+  private static Runnable createNativeReleaseCallback(long nativeEncodedImageBuffer) {
+    return () -> JniCommon.nativeReleaseRef(nativeEncodedImageBuffer);
+  }
+
   @CalledByNative
   private EncodedImage(ByteBuffer buffer, boolean supportsRetain,
       @Nullable Runnable releaseCallback, int encodedWidth, int encodedHeight, long captureTimeNs,
@@ -36,7 +36,7 @@ AAudioPlayer::~AAudioPlayer() {
   RTC_LOG(INFO) << "dtor";
   RTC_DCHECK_RUN_ON(&main_thread_checker_);
   Terminate();
-  RTC_LOG(INFO) << "#detected underruns: " << underrun_count_;
+  RTC_LOG(INFO) << "#detected underruns: " << underrun_count_.load();
 }
 
 int AAudioPlayer::Init() {
@@ -148,6 +148,10 @@ absl::optional<uint32_t> AAudioPlayer::MinSpeakerVolume() const {
   return absl::nullopt;
 }
 
+int AAudioPlayer::GetPlayoutUnderrunCount() {
+  return underrun_count_;
+}
+
 void AAudioPlayer::OnErrorCallback(aaudio_result_t error) {
   RTC_LOG(LS_ERROR) << "OnErrorCallback: " << AAudio_convertResultToText(error);
   // TODO(henrika): investigate if we can use a thread checker here. Initial
@@ -12,6 +12,7 @@
 #define SDK_ANDROID_SRC_JNI_AUDIO_DEVICE_AAUDIO_PLAYER_H_
 
 #include <aaudio/AAudio.h>
+#include <atomic>
 #include <memory>
 
 #include "absl/types/optional.h"
@@ -77,6 +78,10 @@ class AAudioPlayer final : public AudioOutput,
   absl::optional<uint32_t> MaxSpeakerVolume() const override;
   absl::optional<uint32_t> MinSpeakerVolume() const override;
 
+  // Returns the number of underruns reported by AAudio for the current stream.
+  // Each of them has made the output buffer grow by one burst.
+  int GetPlayoutUnderrunCount() override;
+
  protected:
   // AAudioObserverInterface implementation.
 
@@ -127,8 +132,9 @@ class AAudioPlayer final : public AudioOutput,
   // second callback and also cache non-utilized audio.
   std::unique_ptr<FineAudioBuffer> fine_audio_buffer_;
 
-  // Counts number of detected underrun events reported by AAudio.
-  int32_t underrun_count_ = 0;
+  // Counts number of detected underrun events reported by AAudio. Written on
+  // the real-time thread and read through GetPlayoutUnderrunCount().
+  std::atomic<int32_t> underrun_count_{0};
 
   // True only for the first data callback in each audio session.
   bool first_data_callback_ = true;
@@ -62,11 +62,18 @@ ScopedJavaLocalRef<jobject> NativeToJavaEncodedImage(
   ScopedJavaLocalRef<jobject> qp;
   if (image.qp_ != -1)
     qp = NativeToJavaInteger(jni, image.qp_);
-  // TODO(bugs.webrtc.org/9378): Keep a reference to the C++ EncodedImage data,
-  // and use the releaseCallback to manage lifetime.
+  // The Java image keeps a reference to the native data it wraps, so that a
+  // decoder can retain it instead of copying it.
+  ScopedJavaLocalRef<jobject> release_callback;
+  rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data =
+      image.GetEncodedData();
+  if (encoded_data) {
+    rtc::RefCountInterface* ref = encoded_data.release();
+    release_callback = Java_EncodedImage_createNativeReleaseCallback(
+        jni, jlongFromPointer(ref));
+  }
   return Java_EncodedImage_Constructor(
-      jni, buffer, /*supportsRetain=*/true,
-      /*releaseCallback=*/ScopedJavaGlobalRef<jobject>(nullptr),
+      jni, buffer, /*supportsRetain=*/true, release_callback,
       static_cast<int>(image._encodedWidth),
       static_cast<int>(image._encodedHeight),
       image.capture_time_ms_ * rtc::kNumNanosecsPerMillisec, frame_type,
@@ -115,6 +122,11 @@ EncodedImage JavaToNativeEncodedImage(JNIEnv* env,
   return frame;
 }
 
+void ReleaseJavaEncodedImage(JNIEnv* env,
+                             const JavaRef<jobject>& j_encoded_image) {
+  Java_EncodedImage_release(env, j_encoded_image);
+}
+
 int64_t GetJavaEncodedImageCaptureTimeNs(
     JNIEnv* env,
     const JavaRef<jobject>& j_encoded_image) {
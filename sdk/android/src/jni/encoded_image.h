@@ -35,6 +35,10 @@ ScopedJavaLocalRef<jobjectArray> NativeToJavaFrameTypeArray(
 EncodedImage JavaToNativeEncodedImage(JNIEnv* env,
                                       const JavaRef<jobject>& j_encoded_image);
 
+// Drops the reference that NativeToJavaEncodedImage returns the image with.
+void ReleaseJavaEncodedImage(JNIEnv* env,
+                             const JavaRef<jobject>& j_encoded_image);
+
 int64_t GetJavaEncodedImageCaptureTimeNs(
     JNIEnv* jni,
     const JavaRef<jobject>& j_encoded_image);
@@ -119,6 +119,8 @@ int32_t VideoDecoderWrapper::Decode(
   ScopedJavaLocalRef<jobject> decode_info;
   ScopedJavaLocalRef<jobject> ret =
       Java_VideoDecoder_decode(env, decoder_, jinput_image, decode_info);
+  // The decoder retains the image if it uses the data after decode() returns.
+  ReleaseJavaEncodedImage(env, jinput_image);
   return HandleReturnCode(env, ret, "decode");
 }
 
@@ -30,6 +30,31 @@
 namespace webrtc {
 namespace jni {
 
+namespace {
+
+// Crops the center of the native |frame| to the aspect ratio of |width| x
+// |height| and scales it to that size through VideoFrame.Buffer.cropAndScale(),
+// so that texture frames are sampled on the GPU instead of converted to I420.
+rtc::scoped_refptr<AndroidVideoBuffer> CropAndScaleToSize(
+    JNIEnv* jni,
+    const VideoFrame& frame,
+    int width,
+    int height) {
+  int crop_width = frame.width();
+  int crop_height = frame.height();
+  if (crop_width * height > crop_height * width) {
+    crop_width = crop_height * width / height;
+  } else {
+    crop_height = crop_width * height / width;
+  }
+  return static_cast<AndroidVideoBuffer*>(frame.video_frame_buffer().get())
+      ->CropAndScale(jni, (frame.width() - crop_width) / 2,
+                     (frame.height() - crop_height) / 2, crop_width,
+                     crop_height, width, height);
+}
+
+}  // namespace
+
 VideoEncoderWrapper::VideoEncoderWrapper(JNIEnv* jni,
                                          const JavaRef<jobject>& j_encoder)
     : encoder_(jni, j_encoder), int_array_class_(GetClass(jni, "[I")) {
@@ -147,7 +172,22 @@ int32_t VideoEncoderWrapper::Encode(
   info.timestamp_rtp = frame.timestamp();
   frame_extra_infos_.push_back(info);
 
-  ScopedJavaLocalRef<jobject> j_frame = NativeToJavaVideoFrame(jni, frame);
+  // Lower simulcast layers are given the full native frame, and the encoder
+  // would otherwise reset itself to the frame size. Scale it down here rather
+  // than having the frame converted and scaled on the CPU.
+  VideoFrame scaled_frame(frame);
+  if (frame.video_frame_buffer()->type() == VideoFrameBuffer::Type::kNative &&
+      codec_settings_.width > 0 && codec_settings_.height > 0 &&
+      frame.width() >= codec_settings_.width &&
+      frame.height() >= codec_settings_.height &&
+      (frame.width() != codec_settings_.width ||
+       frame.height() != codec_settings_.height)) {
+    scaled_frame.set_video_frame_buffer(CropAndScaleToSize(
+        jni, frame, codec_settings_.width, codec_settings_.height));
+  }
+
+  ScopedJavaLocalRef<jobject> j_frame =
+      NativeToJavaVideoFrame(jni, scaled_frame);
   ScopedJavaLocalRef<jobject> ret =
       Java_VideoEncoder_encode(jni, encoder_, j_frame, encode_info);
   ReleaseJavaVideoFrame(jni, j_frame);
@@ -19,6 +19,7 @@
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 #include "sdk/android/generated_video_jni/VideoFrame_jni.h"
 #include "sdk/android/src/jni/jni_helpers.h"
 #include "sdk/android/src/jni/wrapped_native_i420_buffer.h"
@@ -143,6 +144,13 @@ AndroidVideoBuffer::AndroidVideoBuffer(
       j_video_frame_buffer_(jni, j_video_frame_buffer) {}
 
 AndroidVideoBuffer::~AndroidVideoBuffer() {
+  {
+    rtc::CritScope lock(&i420_crit_);
+    if (to_i420_calls_ > 0) {
+      RTC_HISTOGRAM_COUNTS_100("WebRTC.Video.AndroidVideoBuffer.ToI420Calls",
+                               to_i420_calls_);
+    }
+  }
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   Java_Buffer_release(jni, j_video_frame_buffer_);
 }
@@ -178,13 +186,22 @@ int AndroidVideoBuffer::height() const {
 }
 
 rtc::scoped_refptr<I420BufferInterface> AndroidVideoBuffer::ToI420() {
+  // Held during the conversion, so that concurrent callers wait for it rather
+  // than converting again.
+  rtc::CritScope lock(&i420_crit_);
+  ++to_i420_calls_;
+  if (i420_buffer_)
+    return i420_buffer_;
+
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   ScopedJavaLocalRef<jobject> j_i420_buffer =
       Java_Buffer_toI420(jni, j_video_frame_buffer_);
 
   // We don't need to retain the buffer because toI420 returns a new object that
   // we are assumed to take the ownership of.
-  return AndroidVideoI420Buffer::Adopt(jni, width_, height_, j_i420_buffer);
+  i420_buffer_ =
+      AndroidVideoI420Buffer::Adopt(jni, width_, height_, j_i420_buffer);
+  return i420_buffer_;
 }
 
 VideoFrame JavaToNativeFrame(JNIEnv* jni,
@@ -17,6 +17,8 @@
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "rtc_base/callback.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 #include "sdk/android/src/jni/jni_helpers.h"
 
 namespace webrtc {
@@ -60,12 +62,19 @@ class AndroidVideoBuffer : public VideoFrameBuffer {
   int width() const override;
   int height() const override;
 
+  // Converts on the first call only, so that the sinks of a frame that all
+  // need I420 share one readback of the texture.
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
 
   const int width_;
   const int height_;
   // Holds a VideoFrame.Buffer.
   const ScopedJavaGlobalRef<jobject> j_video_frame_buffer_;
+
+  rtc::CriticalSection i420_crit_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_
+      RTC_GUARDED_BY(i420_crit_);
+  int to_i420_calls_ RTC_GUARDED_BY(i420_crit_) = 0;
 };
 
 VideoFrame JavaToNativeFrame(JNIEnv* jni,
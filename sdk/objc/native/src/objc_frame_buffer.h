@@ -14,6 +14,8 @@
 #import <CoreVideo/CoreVideo.h>
 
 #include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 @protocol RTCVideoFrameBuffer;
 
@@ -29,6 +31,8 @@ class ObjCFrameBuffer : public VideoFrameBuffer {
   int width() const override;
   int height() const override;
 
+  // Converts on the first call only, so that the sinks of a frame that all
+  // need I420 share one conversion of the pixel buffer.
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
 
   id<RTCVideoFrameBuffer> wrapped_frame_buffer() const;
@@ -37,6 +41,10 @@ class ObjCFrameBuffer : public VideoFrameBuffer {
   id<RTCVideoFrameBuffer> frame_buffer_;
   int width_;
   int height_;
+
+  rtc::CriticalSection i420_crit_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_ RTC_GUARDED_BY(i420_crit_);
+  int to_i420_calls_ RTC_GUARDED_BY(i420_crit_) = 0;
 };
 
 id<RTCVideoFrameBuffer> ToObjCVideoFrameBuffer(
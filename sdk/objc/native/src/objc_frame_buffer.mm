@@ -13,6 +13,8 @@
 #import "base/RTCVideoFrameBuffer.h"
 #import "sdk/objc/api/video_frame_buffer/RTCNativeI420Buffer+Private.h"
 
+#include "system_wrappers/include/metrics.h"
+
 namespace webrtc {
 
 namespace {
@@ -51,7 +53,12 @@ class ObjCI420FrameBuffer : public I420BufferInterface {
 ObjCFrameBuffer::ObjCFrameBuffer(id<RTCVideoFrameBuffer> frame_buffer)
     : frame_buffer_(frame_buffer), width_(frame_buffer.width), height_(frame_buffer.height) {}
 
-ObjCFrameBuffer::~ObjCFrameBuffer() {}
+ObjCFrameBuffer::~ObjCFrameBuffer() {
+  rtc::CritScope lock(&i420_crit_);
+  if (to_i420_calls_ > 0) {
+    RTC_HISTOGRAM_COUNTS_100("WebRTC.Video.ObjCFrameBuffer.ToI420Calls", to_i420_calls_);
+  }
+}
 
 VideoFrameBuffer::Type ObjCFrameBuffer::type() const {
   return Type::kNative;
@@ -66,10 +73,14 @@ int ObjCFrameBuffer::height() const {
 }
 
 rtc::scoped_refptr<I420BufferInterface> ObjCFrameBuffer::ToI420() {
-  rtc::scoped_refptr<I420BufferInterface> buffer =
-      new rtc::RefCountedObject<ObjCI420FrameBuffer>([frame_buffer_ toI420]);
-
-  return buffer;
+  // Held during the conversion, so that concurrent callers wait for it rather
+  // than converting again.
+  rtc::CritScope lock(&i420_crit_);
+  ++to_i420_calls_;
+  if (!i420_buffer_) {
+    i420_buffer_ = new rtc::RefCountedObject<ObjCI420FrameBuffer>([frame_buffer_ toI420]);
+  }
+  return i420_buffer_;
 }
 
 id<RTCVideoFrameBuffer> ObjCFrameBuffer::wrapped_frame_buffer() const {
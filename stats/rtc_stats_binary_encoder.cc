@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary_encoder.h"
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+void AppendVarInt(uint64_t value, std::string* output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+void AppendZigZag(int64_t value, std::string* output) {
+  AppendVarInt((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               output);
+}
+
+void AppendString(const std::string& value, std::string* output) {
+  AppendVarInt(value.size(), output);
+  output->append(value);
+}
+
+void AppendDouble(double value, std::string* output) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    output->push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+void AppendValue(bool value, std::string* output) {
+  output->push_back(value ? 1 : 0);
+}
+void AppendValue(int32_t value, std::string* output) {
+  AppendZigZag(value, output);
+}
+void AppendValue(uint32_t value, std::string* output) {
+  AppendVarInt(value, output);
+}
+void AppendValue(int64_t value, std::string* output) {
+  AppendZigZag(value, output);
+}
+void AppendValue(uint64_t value, std::string* output) {
+  AppendVarInt(value, output);
+}
+void AppendValue(double value, std::string* output) {
+  AppendDouble(value, output);
+}
+void AppendValue(const std::string& value, std::string* output) {
+  AppendString(value, output);
+}
+
+template <typename T>
+void AppendMember(const RTCStatsMemberInterface& member, std::string* output) {
+  AppendValue(*member.cast_to<RTCStatsMember<T>>(), output);
+}
+
+template <typename T>
+void AppendSequenceMember(const RTCStatsMemberInterface& member,
+                          std::string* output) {
+  const std::vector<T>& values =
+      *member.cast_to<RTCStatsMember<std::vector<T>>>();
+  AppendVarInt(values.size(), output);
+  for (const T& value : values)
+    AppendValue(value, output);
+}
+
+void AppendMemberValue(const RTCStatsMemberInterface& member,
+                       std::string* output) {
+  switch (member.type()) {
+    case RTCStatsMemberInterface::kBool:
+      AppendMember<bool>(member, output);
+      break;
+    case RTCStatsMemberInterface::kInt32:
+      AppendMember<int32_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kUint32:
+      AppendMember<uint32_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kInt64:
+      AppendMember<int64_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kUint64:
+      AppendMember<uint64_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kDouble:
+      AppendMember<double>(member, output);
+      break;
+    case RTCStatsMemberInterface::kString:
+      AppendMember<std::string>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceBool:
+      AppendSequenceMember<bool>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceInt32:
+      AppendSequenceMember<int32_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint32:
+      AppendSequenceMember<uint32_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceInt64:
+      AppendSequenceMember<int64_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint64:
+      AppendSequenceMember<uint64_t>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceDouble:
+      AppendSequenceMember<double>(member, output);
+      break;
+    case RTCStatsMemberInterface::kSequenceString:
+      AppendSequenceMember<std::string>(member, output);
+      break;
+  }
+}
+
+// The stats of one type in a report, with their members.
+struct StatsGroup {
+  size_t schema_index;
+  std::vector<const RTCStats*> stats;
+  std::vector<std::vector<const RTCStatsMemberInterface*>> members;
+};
+
+}  // namespace
+
+const uint64_t RTCStatsBinaryEncoder::kFormatVersion;
+
+RTCStatsBinaryEncoder::RTCStatsBinaryEncoder() = default;
+
+RTCStatsBinaryEncoder::~RTCStatsBinaryEncoder() = default;
+
+std::string RTCStatsBinaryEncoder::Encode(const RTCStatsReport& report) {
+  std::string output;
+  AppendVarInt(kFormatVersion, &output);
+  AppendZigZag(report.timestamp_us(), &output);
+
+  // Group the stats by type, emitting the schemas of new types on the way.
+  std::string schemas;
+  size_t num_new_schemas = 0;
+  std::vector<StatsGroup> groups;
+  std::map<size_t, size_t> group_by_schema_index;
+  for (const RTCStats& stats : report) {
+    std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+    auto schema_it = schema_indices_.find(stats.type());
+    if (schema_it == schema_indices_.end()) {
+      schema_it = schema_indices_
+                      .insert(std::make_pair(std::string(stats.type()),
+                                             schema_indices_.size()))
+                      .first;
+      ++num_new_schemas;
+      AppendString(schema_it->first, &schemas);
+      AppendVarInt(members.size(), &schemas);
+      for (const RTCStatsMemberInterface* member : members) {
+        AppendString(member->name(), &schemas);
+        schemas.push_back(static_cast<char>(member->type()));
+      }
+    }
+    auto group_it =
+        group_by_schema_index.insert(std::make_pair(schema_it->second,
+                                                    groups.size()))
+            .first;
+    if (group_it->second == groups.size()) {
+      groups.emplace_back();
+      groups.back().schema_index = schema_it->second;
+    }
+    StatsGroup& group = groups[group_it->second];
+    RTC_DCHECK(group.members.empty() ||
+               group.members.front().size() == members.size());
+    group.stats.push_back(&stats);
+    group.members.push_back(std::move(members));
+  }
+  AppendVarInt(num_new_schemas, &output);
+  output.append(schemas);
+
+  AppendVarInt(groups.size(), &output);
+  for (const StatsGroup& group : groups) {
+    AppendVarInt(group.schema_index, &output);
+    AppendVarInt(group.stats.size(), &output);
+    for (const RTCStats* stats : group.stats)
+      AppendString(stats->id(), &output);
+    for (const RTCStats* stats : group.stats)
+      AppendZigZag(stats->timestamp_us() - report.timestamp_us(), &output);
+
+    size_t num_members = group.members.front().size();
+    for (size_t i = 0; i < num_members; ++i) {
+      size_t bitmap_offset = output.size();
+      output.append((group.stats.size() + 7) / 8, '\0');
+      for (size_t j = 0; j < group.stats.size(); ++j) {
+        const RTCStatsMemberInterface* member = group.members[j][i];
+        if (!member->is_defined())
+          continue;
+        output[bitmap_offset + j / 8] |= static_cast<char>(1 << (j % 8));
+        AppendMemberValue(*member, &output);
+      }
+    }
+  }
+  return output;
+}
+
+void RTCStatsBinaryEncoder::Reset() {
+  schema_indices_.clear();
+}
+
+}  // namespace webrtc
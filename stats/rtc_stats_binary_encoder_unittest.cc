@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary_encoder.h"
+
+#include <memory>
+#include <string>
+
+#include "api/stats/rtc_stats.h"
+#include "api/stats/rtc_stats_report.h"
+#include "stats/test/rtc_test_stats.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+class RTCBinaryTestStats : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCBinaryTestStats(const std::string& id, int64_t timestamp_us)
+      : RTCStats(id, timestamp_us), integer("integer") {}
+
+  RTCStatsMember<int32_t> integer;
+};
+
+WEBRTC_RTCSTATS_IMPL(RTCBinaryTestStats, RTCStats, "binary", &integer)
+
+namespace {
+
+rtc::scoped_refptr<RTCStatsReport> CreateReport() {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  std::unique_ptr<RTCBinaryTestStats> a(new RTCBinaryTestStats("a", 1000));
+  a->integer = -3;
+  report->AddStats(std::move(a));
+  report->AddStats(
+      std::unique_ptr<RTCStats>(new RTCBinaryTestStats("b", 1001)));
+  return report;
+}
+
+}  // namespace
+
+TEST(RTCStatsBinaryEncoderTest, EncodesSchemaOnce) {
+  // Version 1 and zigzag encoded timestamp 1000.
+  const std::string kHeader("\x01\xd0\x0f", 3);
+  // One new schema, "binary", with the int32 member "integer".
+  const std::string kSchema =
+      std::string("\x01\x06"
+                  "binary"
+                  "\x01\x07"
+                  "integer") +
+      static_cast<char>(RTCStatsMemberInterface::kInt32);
+  // One group of schema 0 with the stats "a" and "b", with timestamps 0 and
+  // +1 relative to the report, of which only "a" has |integer| defined (-3).
+  const std::string kGroup(
+      "\x01\x00\x02"
+      "\x01"
+      "a"
+      "\x01"
+      "b"
+      "\x00\x02"
+      "\x01\x05",
+      11);
+
+  RTCStatsBinaryEncoder encoder;
+  rtc::scoped_refptr<RTCStatsReport> report = CreateReport();
+  EXPECT_EQ(kHeader + kSchema + kGroup, encoder.Encode(*report));
+  // The schema is only emitted once.
+  EXPECT_EQ(kHeader + std::string("\x00", 1) + kGroup,
+            encoder.Encode(*report));
+
+  encoder.Reset();
+  EXPECT_EQ(kHeader + kSchema + kGroup, encoder.Encode(*report));
+}
+
+TEST(RTCStatsBinaryEncoderTest, EncodesAllMemberTypes) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(0);
+  std::unique_ptr<RTCTestStats> stats(new RTCTestStats("test", 0));
+  stats->m_bool = true;
+  stats->m_int32 = 1;
+  stats->m_uint32 = 2;
+  stats->m_int64 = 3;
+  stats->m_uint64 = 4;
+  stats->m_double = 5.0;
+  stats->m_string = "six";
+  stats->m_sequence_bool = std::vector<bool>{true, false};
+  stats->m_sequence_int32 = std::vector<int32_t>{7};
+  stats->m_sequence_uint32 = std::vector<uint32_t>{8};
+  stats->m_sequence_int64 = std::vector<int64_t>{9};
+  stats->m_sequence_uint64 = std::vector<uint64_t>{10};
+  stats->m_sequence_double = std::vector<double>{11.0};
+  stats->m_sequence_string = std::vector<std::string>{"twelve"};
+  report->AddStats(std::move(stats));
+
+  RTCStatsBinaryEncoder encoder;
+  std::string with_schema = encoder.Encode(*report);
+  std::string without_schema = encoder.Encode(*report);
+  EXPECT_LT(without_schema.size(), with_schema.size());
+  // The values are smaller than the JSON representation even with the schema.
+  EXPECT_LT(with_schema.size(), report->ToJson().size());
+}
+
+}  // namespace webrtc
@@ -73,6 +73,17 @@ rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::Copy() const {
   return copy;
 }
 
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::CopyChangedSince(
+    const RTCStatsReport& previous) const {
+  rtc::scoped_refptr<RTCStatsReport> copy = Create(timestamp_us_);
+  for (const auto& it : stats_) {
+    const RTCStats* previous_stats = previous.Get(it.first);
+    if (!previous_stats || *previous_stats != *it.second)
+      copy->AddStats(it.second->copy());
+  }
+  return copy;
+}
+
 void RTCStatsReport::AddStats(std::unique_ptr<const RTCStats> stats) {
   auto result =
       stats_.insert(std::make_pair(std::string(stats->id()), std::move(stats)));
@@ -139,4 +139,35 @@ TEST(RTCStatsReport, TakeMembersFrom) {
   EXPECT_EQ(i, static_cast<int64_t>(6));
 }
 
+TEST(RTCStatsReport, CopyChangedSince) {
+  rtc::scoped_refptr<RTCStatsReport> previous = RTCStatsReport::Create(1337);
+  std::unique_ptr<RTCTestStats1> a(new RTCTestStats1("A", 1));
+  a->integer = 1;
+  previous->AddStats(std::move(a));
+  std::unique_ptr<RTCTestStats1> b(new RTCTestStats1("B", 1));
+  b->integer = 2;
+  previous->AddStats(std::move(b));
+
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1338);
+  // Unchanged, only the timestamp differs.
+  a.reset(new RTCTestStats1("A", 2));
+  a->integer = 1;
+  report->AddStats(std::move(a));
+  b.reset(new RTCTestStats1("B", 2));
+  b->integer = 3;
+  report->AddStats(std::move(b));
+  report->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats2("C", 2)));
+
+  rtc::scoped_refptr<RTCStatsReport> changed =
+      report->CopyChangedSince(*previous);
+  EXPECT_EQ(changed->timestamp_us(), 1338u);
+  EXPECT_EQ(changed->size(), 2u);
+  EXPECT_FALSE(changed->Get("A"));
+  ASSERT_TRUE(changed->GetAs<RTCTestStats1>("B"));
+  EXPECT_EQ(*changed->GetAs<RTCTestStats1>("B")->integer, 3);
+  EXPECT_TRUE(changed->Get("C"));
+  // The report itself is left untouched.
+  EXPECT_EQ(report->size(), 3u);
+}
+
 }  // namespace webrtc
@@ -17,8 +17,9 @@
 extern "C" {
 #endif
 
-// List of features in x86.
-typedef enum { kSSE2, kSSE3 } CPUFeature;
+// List of features in x86. kAVX2 is only reported when FMA is supported too
+// and the OS saves the AVX registers on context switches.
+typedef enum { kSSE2, kSSE3, kAVX2 } CPUFeature;
 
 // List of features in ARM.
 enum {
@@ -79,7 +79,8 @@ inline bool IsDisabled(const char* name) {
 // Optionally initialize field trial from a string.
 // This method can be called at most once before any other call into webrtc.
 // E.g. before the peer connection factory is constructed.
-// Note: trials_string must never be destroyed.
+// Note: trials_string must never be destroyed. It is parsed here, so later
+// changes to its contents are not seen by FindFullName().
 void InitFieldTrialsFromString(const char* trials_string);
 
 const char* GetFieldTrialString();
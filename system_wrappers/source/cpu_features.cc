@@ -25,26 +25,42 @@ int GetCPUInfoNoASM(CPUFeature feature) {
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #ifndef _MSC_VER
-// Intrinsic for "cpuid".
+// Intrinsic for "cpuid" with a sub-leaf index in ecx.
 #if defined(__pic__) && defined(__i386__)
-static inline void __cpuid(int cpu_info[4], int info_type) {
+static inline void __cpuidex(int cpu_info[4], int info_type, int info_index) {
   __asm__ volatile(
       "mov %%ebx, %%edi\n"
       "cpuid\n"
       "xchg %%edi, %%ebx\n"
       : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
         "=d"(cpu_info[3])
-      : "a"(info_type));
+      : "a"(info_type), "c"(info_index));
 }
 #else
-static inline void __cpuid(int cpu_info[4], int info_type) {
+static inline void __cpuidex(int cpu_info[4], int info_type, int info_index) {
   __asm__ volatile("cpuid\n"
                    : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
                      "=d"(cpu_info[3])
-                   : "a"(info_type));
+                   : "a"(info_type), "c"(info_index));
 }
 #endif
+
+// Intrinsic for "cpuid".
+static inline void __cpuid(int cpu_info[4], int info_type) {
+  __cpuidex(cpu_info, info_type, 0);
+}
 #endif  // _MSC_VER
+
+// Returns the value of the extended control register |xcr|.
+static inline uint64_t xgetbv(uint32_t xcr) {
+#if defined(_MSC_VER)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
 #endif  // WEBRTC_ARCH_X86_FAMILY
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -58,6 +74,23 @@ static int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kAVX2) {
+    // AVX and FMA must be supported by the CPU, and the OS must have enabled
+    // XSAVE and the saving of the XMM and YMM registers. See
+    // https://software.intel.com/en-us/blogs/2011/04/14/is-avx-enabled
+    const bool avx_enabled = (cpu_info[2] & 0x10000000) != 0 /* AVX */ &&
+                             (cpu_info[2] & 0x00001000) != 0 /* FMA */ &&
+                             (cpu_info[2] & 0x08000000) != 0 /* OSXSAVE */ &&
+                             (xgetbv(0) & 0x6) == 0x6;
+    if (!avx_enabled)
+      return 0;
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 0);
+    if (cpu_info7[0] < 7)
+      return 0;
+    __cpuidex(cpu_info7, 7, 0);
+    return 0 != (cpu_info7[1] & 0x00000020);
+  }
   return 0;
 }
 #else
@@ -11,8 +11,11 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
@@ -67,38 +70,52 @@ bool FieldTrialsStringIsValid(const absl::string_view trials) {
 
   return true;
 }
-}  // namespace
-
-std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
 
+using FieldTrialMap = std::map<std::string, std::string, std::less<>>;
+
+// |trials_init_string| parsed into group names by trial name, so that lookups,
+// which are made in the constructors of many per-stream objects, don't scan
+// the string again. Replaced maps are kept, since lookups may race with
+// InitFieldTrialsFromString() in tests.
+std::atomic<const FieldTrialMap*> field_trial_map(nullptr);
+std::vector<std::unique_ptr<const FieldTrialMap>>* replaced_field_trial_maps =
+    nullptr;
+
+// Parses the name/value pairs up to the first malformed one. The first of
+// duplicate names wins.
+std::unique_ptr<const FieldTrialMap> ParseFieldTrials(
+    const absl::string_view trials) {
+  auto field_trials = std::make_unique<FieldTrialMap>();
   size_t next_item = 0;
-  while (next_item < trials_string.length()) {
+  while (next_item < trials.length()) {
     // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
+    size_t field_name_end = trials.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials.npos || field_name_end == next_item)
       break;
     size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
+        trials.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials.npos ||
         field_value_end == field_name_end + 1)
       break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
+    absl::string_view field_name =
+        trials.substr(next_item, field_name_end - next_item);
+    absl::string_view field_value = trials.substr(
+        field_name_end + 1, field_value_end - field_name_end - 1);
     next_item = field_value_end + 1;
 
-    if (name == field_name)
-      return field_value;
+    field_trials->emplace(std::string(field_name), std::string(field_value));
   }
-  return std::string();
+  return field_trials;
+}
+}  // namespace
+
+std::string FindFullName(const std::string& name) {
+  const FieldTrialMap* field_trials =
+      field_trial_map.load(std::memory_order_acquire);
+  if (!field_trials)
+    return std::string();
+  auto it = field_trials->find(name);
+  return it == field_trials->end() ? std::string() : it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -110,6 +127,17 @@ void InitFieldTrialsFromString(const char* trials_string) {
     RTC_DCHECK(FieldTrialsStringIsValid(trials_string))
         << "Invalid field trials string:" << trials_string;
   };
+  std::unique_ptr<const FieldTrialMap> field_trials =
+      trials_string ? ParseFieldTrials(trials_string) : nullptr;
+  const FieldTrialMap* replaced_field_trials = field_trial_map.exchange(
+      field_trials.release(), std::memory_order_acq_rel);
+  if (replaced_field_trials) {
+    if (!replaced_field_trial_maps) {
+      replaced_field_trial_maps =
+          new std::vector<std::unique_ptr<const FieldTrialMap>>();
+    }
+    replaced_field_trial_maps->emplace_back(replaced_field_trials);
+  }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
 }
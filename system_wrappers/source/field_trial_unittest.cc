@@ -10,6 +10,7 @@
 #include "system_wrappers/include/field_trial.h"
 
 #include "rtc_base/checks.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -49,5 +50,22 @@ TEST(FieldTrialValidationTest, RejectsBadInputs) {
 #endif  // GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID)
         // && !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+TEST(FieldTrialTest, FindsGroupNames) {
+  {
+    test::ScopedFieldTrials field_trials("Audio/Enabled/Video/Disabled100/");
+    EXPECT_EQ("Enabled", FindFullName("Audio"));
+    EXPECT_EQ("Disabled100", FindFullName("Video"));
+    EXPECT_EQ("", FindFullName("Aud"));
+    EXPECT_EQ("", FindFullName("Data"));
+    EXPECT_TRUE(IsEnabled("Audio"));
+    EXPECT_TRUE(IsDisabled("Video"));
+  }
+  test::ScopedFieldTrials field_trials("Video/Enabled/");
+  EXPECT_EQ("", FindFullName("Audio"));
+  EXPECT_EQ("Enabled", FindFullName("Video"));
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 }  // namespace field_trial
 }  // namespace webrtc
@@ -31,7 +31,7 @@ EmulatedIpPacket::EmulatedIpPacket(const rtc::SocketAddress& from,
                                    Timestamp arrival_time)
     : from(from),
       to(to),
-      data(data),
+      data(std::move(data)),
       ip_header_size((to.family() == AF_INET) ? kIPv4HeaderSize
                                               : kIPv6HeaderSize),
       arrival_time(arrival_time) {
@@ -39,54 +39,75 @@ EmulatedIpPacket::EmulatedIpPacket(const rtc::SocketAddress& from,
 }
 
 void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
-  task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
-    RTC_DCHECK_RUN_ON(task_queue_);
+  bool post_task;
+  {
+    rtc::CritScope crit(&lock_);
+    post_task = pending_packets_.empty();
+    pending_packets_.push_back(std::move(packet));
+  }
+  // Packets received before the task has run are enqueued by the same task,
+  // so that a burst of packets costs a single task.
+  if (post_task) {
+    task_queue_->PostTask([this]() {
+      RTC_DCHECK_RUN_ON(task_queue_);
+      EnqueuePendingPackets();
+    });
+  }
+}
 
+void LinkEmulation::EnqueuePendingPackets() {
+  std::vector<EmulatedIpPacket> packets;
+  {
+    rtc::CritScope crit(&lock_);
+    packets.swap(pending_packets_);
+  }
+  for (EmulatedIpPacket& packet : packets) {
     uint64_t packet_id = next_packet_id_++;
     bool sent = network_behavior_->EnqueuePacket(PacketInFlightInfo(
         packet.ip_packet_size(), packet.arrival_time.us(), packet_id));
     if (sent) {
       packets_.emplace_back(StoredPacket{packet_id, std::move(packet), false});
     }
-    if (process_task_.Running())
-      return;
-    absl::optional<int64_t> next_time_us =
-        network_behavior_->NextDeliveryTimeUs();
-    if (!next_time_us)
-      return;
-    Timestamp current_time = clock_->CurrentTime();
-    process_task_ = RepeatingTaskHandle::DelayedStart(
-        task_queue_->Get(),
-        std::max(TimeDelta::Zero(),
-                 Timestamp::us(*next_time_us) - current_time),
-        [this]() {
-          RTC_DCHECK_RUN_ON(task_queue_);
-          Timestamp current_time = clock_->CurrentTime();
-          Process(current_time);
-          absl::optional<int64_t> next_time_us =
-              network_behavior_->NextDeliveryTimeUs();
-          if (!next_time_us) {
-            process_task_.Stop();
-            return TimeDelta::Zero();  // This is ignored.
-          }
-          RTC_DCHECK_GE(*next_time_us, current_time.us());
-          return Timestamp::us(*next_time_us) - current_time;
-        });
-  });
+  }
+  if (process_task_.Running())
+    return;
+  absl::optional<int64_t> next_time_us =
+      network_behavior_->NextDeliveryTimeUs();
+  if (!next_time_us)
+    return;
+  Timestamp current_time = clock_->CurrentTime();
+  process_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_->Get(),
+      std::max(TimeDelta::Zero(),
+               Timestamp::us(*next_time_us) - current_time),
+      [this]() {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        Timestamp current_time = clock_->CurrentTime();
+        Process(current_time);
+        absl::optional<int64_t> next_time_us =
+            network_behavior_->NextDeliveryTimeUs();
+        if (!next_time_us) {
+          process_task_.Stop();
+          return TimeDelta::Zero();  // This is ignored.
+        }
+        RTC_DCHECK_GE(*next_time_us, current_time.us());
+        return Timestamp::us(*next_time_us) - current_time;
+      });
 }
 
 void LinkEmulation::Process(Timestamp at_time) {
   std::vector<PacketDeliveryInfo> delivery_infos =
       network_behavior_->DequeueDeliverablePackets(at_time.us());
   for (PacketDeliveryInfo& delivery_info : delivery_infos) {
-    StoredPacket* packet = nullptr;
-    for (auto& stored_packet : packets_) {
-      if (stored_packet.id == delivery_info.packet_id) {
-        packet = &stored_packet;
-        break;
-      }
-    }
-    RTC_CHECK(packet);
+    // Packets are stored in the order of their ids, which may differ from the
+    // order of delivery when the behavior reorders them.
+    auto it = std::lower_bound(packets_.begin(), packets_.end(),
+                               delivery_info.packet_id,
+                               [](const StoredPacket& packet, uint64_t id) {
+                                 return packet.id < id;
+                               });
+    RTC_CHECK(it != packets_.end() && it->id == delivery_info.packet_id);
+    StoredPacket* packet = &*it;
     RTC_DCHECK(!packet->removed);
     packet->removed = true;
 
@@ -95,9 +116,9 @@ void LinkEmulation::Process(Timestamp at_time) {
           Timestamp::us(delivery_info.receive_time_us);
       receiver_->OnPacketReceived(std::move(packet->packet));
     }
-    while (!packets_.empty() && packets_.front().removed) {
-      packets_.pop_front();
-    }
+  }
+  while (!packets_.empty() && packets_.front().removed) {
+    packets_.pop_front();
   }
 }
 
@@ -213,18 +234,34 @@ void EmulatedEndpoint::SendPacket(const rtc::SocketAddress& from,
   RTC_CHECK(from.ipaddr() == peer_local_addr_);
   EmulatedIpPacket packet(from, to, std::move(packet_data),
                           clock_->CurrentTime());
-  task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
+  bool post_task;
+  {
+    rtc::CritScope crit(&send_lock_);
+    post_task = pending_packets_.empty();
+    pending_packets_.push_back(std::move(packet));
+  }
+  if (!post_task)
+    return;
+  task_queue_->PostTask([this]() {
     RTC_DCHECK_RUN_ON(task_queue_);
-    Timestamp current_time = clock_->CurrentTime();
-    if (stats_.first_packet_sent_time.IsInfinite()) {
-      stats_.first_packet_sent_time = current_time;
-      stats_.first_sent_packet_size = DataSize::bytes(packet.ip_packet_size());
+    std::vector<EmulatedIpPacket> packets;
+    {
+      rtc::CritScope crit(&send_lock_);
+      packets.swap(pending_packets_);
     }
-    stats_.last_packet_sent_time = current_time;
-    stats_.packets_sent++;
-    stats_.bytes_sent += DataSize::bytes(packet.ip_packet_size());
+    Timestamp current_time = clock_->CurrentTime();
+    for (EmulatedIpPacket& packet : packets) {
+      if (stats_.first_packet_sent_time.IsInfinite()) {
+        stats_.first_packet_sent_time = current_time;
+        stats_.first_sent_packet_size =
+            DataSize::bytes(packet.ip_packet_size());
+      }
+      stats_.last_packet_sent_time = current_time;
+      stats_.packets_sent++;
+      stats_.bytes_sent += DataSize::bytes(packet.ip_packet_size());
 
-    router_.OnPacketReceived(std::move(packet));
+      router_.OnPacketReceived(std::move(packet));
+    }
   });
 }
 
@@ -24,6 +24,7 @@
 #include "api/test/simulated_network.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/network.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/task_queue_for_test.h"
@@ -88,10 +89,14 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
     EmulatedIpPacket packet;
     bool removed;
   };
+  void EnqueuePendingPackets() RTC_RUN_ON(task_queue_);
   void Process(Timestamp at_time) RTC_RUN_ON(task_queue_);
 
   Clock* const clock_;
   rtc::TaskQueue* const task_queue_;
+  rtc::CriticalSection lock_;
+  // Packets received but not yet handed to |network_behavior_|.
+  std::vector<EmulatedIpPacket> pending_packets_ RTC_GUARDED_BY(lock_);
   const std::unique_ptr<NetworkBehaviorInterface> network_behavior_
       RTC_GUARDED_BY(task_queue_);
   EmulatedNetworkReceiverInterface* const receiver_;
@@ -227,6 +232,10 @@ class EmulatedEndpoint : public EmulatedNetworkReceiverInterface {
   std::map<uint16_t, EmulatedNetworkReceiverInterface*> port_to_receiver_
       RTC_GUARDED_BY(receiver_lock_);
 
+  rtc::CriticalSection send_lock_;
+  // Packets sent but not yet routed, routed in one task on |task_queue_|.
+  std::vector<EmulatedIpPacket> pending_packets_ RTC_GUARDED_BY(send_lock_);
+
   EmulatedNetworkStats stats_ RTC_GUARDED_BY(task_queue_);
 };
 
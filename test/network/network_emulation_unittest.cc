@@ -19,10 +19,12 @@
 #include "call/simulated_network.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/sleep.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/network/network_emulation_manager.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace test {
@@ -69,6 +71,22 @@ class SocketReader : public sigslot::has_slots<> {
   int received_count_ RTC_GUARDED_BY(lock_) = 0;
 };
 
+class CountingReceiver : public EmulatedNetworkReceiverInterface {
+ public:
+  void OnPacketReceived(EmulatedIpPacket packet) override {
+    if (++packets_count_ == expected_count_)
+      done_.Set();
+  }
+
+  rtc::Event* done() { return &done_; }
+  void SetExpectedCount(int count) { expected_count_ = count; }
+
+ private:
+  std::atomic<int> packets_count_{0};
+  std::atomic<int> expected_count_{0};
+  rtc::Event done_;
+};
+
 class MockReceiver : public EmulatedNetworkReceiverInterface {
  public:
   MOCK_METHOD1(OnPacketReceived, void(EmulatedIpPacket packet));
@@ -376,5 +394,40 @@ TEST_F(NetworkEmulationManagerThreeNodesRoutingTest,
   SendPacketsAndValidateDelivery();
 }
 
+// Sends a burst of full sized packets over two nodes and reports how many
+// packets per second the emulation delivers, as a benchmark of the emulation
+// itself.
+TEST(NetworkEmulationManagerTest, ReportsEmulatedPacketsPerSecond) {
+  constexpr int kNumPackets = 100000;
+  constexpr size_t kPacketSize = 1200;
+  CountingReceiver receiver;
+  receiver.SetExpectedCount(kNumPackets);
+  NetworkEmulationManagerImpl network_manager;
+  EmulatedEndpoint* alice =
+      network_manager.CreateEndpoint(EmulatedEndpointConfig());
+  EmulatedEndpoint* bob =
+      network_manager.CreateEndpoint(EmulatedEndpointConfig());
+  network_manager.CreateRoute(
+      alice,
+      {CreateEmulatedNodeWithDefaultBuiltInConfig(&network_manager),
+       CreateEmulatedNodeWithDefaultBuiltInConfig(&network_manager)},
+      bob);
+  uint16_t port = bob->BindReceiver(0, &receiver).value();
+
+  rtc::SocketAddress from(alice->GetPeerLocalAddress(), 80);
+  rtc::SocketAddress to(bob->GetPeerLocalAddress(), port);
+  rtc::CopyOnWriteBuffer data(kPacketSize);
+  const int64_t start_time_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumPackets; ++i) {
+    alice->SendPacket(from, to, data);
+  }
+  ASSERT_TRUE(receiver.done()->Wait(60000));
+  const int64_t elapsed_us = rtc::TimeMicros() - start_time_us;
+  PrintResult("emulated_packets_per_second", "", "two_nodes",
+              kNumPackets * static_cast<double>(rtc::kNumMicrosecsPerSec) /
+                  elapsed_us,
+              "packets/s", false, ImproveDirection::kBiggerIsBetter);
+}
+
 }  // namespace test
 }  // namespace webrtc
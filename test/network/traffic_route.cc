@@ -91,8 +91,8 @@ void TrafficRoute::SendPacket(size_t packet_size, uint16_t dest_port) {
   std::fill_n(data.data<uint8_t>(), data.size(), 0);
   receiver_->OnPacketReceived(EmulatedIpPacket(
       /*from=*/rtc::SocketAddress(),
-      rtc::SocketAddress(endpoint_->GetPeerLocalAddress(), dest_port), data,
-      clock_->CurrentTime()));
+      rtc::SocketAddress(endpoint_->GetPeerLocalAddress(), dest_port),
+      std::move(data), clock_->CurrentTime()));
 }
 
 }  // namespace test
@@ -17,6 +17,7 @@
 #include "api/units/time_delta.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 
 namespace webrtc {
 namespace webrtc_pc_e2e {
@@ -62,10 +63,27 @@ double RateCounter::GetEventsPerSecond() const {
          (event_last_time_ - event_first_time_).us() * kMicrosPerSecond;
 }
 
+namespace {
+
+DefaultVideoQualityAnalyzerOptions OptionsWithHeavyMetrics(
+    bool heavy_metrics_computation_enabled) {
+  DefaultVideoQualityAnalyzerOptions options;
+  options.heavy_metrics_computation_enabled = heavy_metrics_computation_enabled;
+  return options;
+}
+
+}  // namespace
+
 DefaultVideoQualityAnalyzer::DefaultVideoQualityAnalyzer(
     bool heavy_metrics_computation_enabled)
-    : heavy_metrics_computation_enabled_(heavy_metrics_computation_enabled),
-      clock_(Clock::GetRealTimeClock()) {}
+    : DefaultVideoQualityAnalyzer(
+          OptionsWithHeavyMetrics(heavy_metrics_computation_enabled)) {}
+
+DefaultVideoQualityAnalyzer::DefaultVideoQualityAnalyzer(
+    DefaultVideoQualityAnalyzerOptions options)
+    : options_(options), clock_(Clock::GetRealTimeClock()) {
+  RTC_CHECK_GT(options_.heavy_metrics_sampling_rate, 0);
+}
 DefaultVideoQualityAnalyzer::~DefaultVideoQualityAnalyzer() {
   Stop();
 }
@@ -93,6 +111,7 @@ void DefaultVideoQualityAnalyzer::Start(std::string test_case_name,
 uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
     const std::string& stream_label,
     const webrtc::VideoFrame& frame) {
+  const int64_t start_time_us = rtc::TimeMicros();
   // |next_frame_id| is atomic, so we needn't lock here.
   uint16_t frame_id = next_frame_id_++;
   Timestamp start_time = Timestamp::MinusInfinity();
@@ -121,27 +140,33 @@ uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
     StreamState* state = &stream_states_[stream_label];
     state->frame_ids.push_back(frame_id);
     // Update frames in flight info.
-    auto it = captured_frames_in_flight_.find(frame_id);
-    if (it != captured_frames_in_flight_.end()) {
+    auto stats_it = frame_stats_.find(frame_id);
+    if (stats_it != frame_stats_.end()) {
       // We overflow uint16_t and hit previous frame id and this frame is still
       // in flight. It means that this stream wasn't rendered for long time and
       // we need to process existing frame as dropped.
-      auto stats_it = frame_stats_.find(frame_id);
-      RTC_DCHECK(stats_it != frame_stats_.end());
-
-      RTC_DCHECK(frame_id == state->frame_ids.front());
-      state->frame_ids.pop_front();
+      StreamState* prev_state = &stream_states_[stats_it->second.stream_label];
+      RTC_DCHECK(frame_id == prev_state->frame_ids.front());
+      prev_state->frame_ids.pop_front();
       frame_counters_.dropped++;
-      stream_frame_counters_[stream_label].dropped++;
-      AddComparison(it->second, absl::nullopt, true, stats_it->second);
-
-      captured_frames_in_flight_.erase(it);
+      stream_frame_counters_[stats_it->second.stream_label].dropped++;
+      AddComparison(TakeCapturedFrame(frame_id), absl::nullopt, true,
+                    stats_it->second);
       frame_stats_.erase(stats_it);
     }
-    captured_frames_in_flight_.insert(
-        std::pair<uint16_t, VideoFrame>(frame_id, frame));
-    // Set frame id on local copy of the frame
-    captured_frames_in_flight_.at(frame_id).set_id(frame_id);
+    // Content of the frame is only needed to compute heavy metrics.
+    if (options_.heavy_metrics_computation_enabled &&
+        state->captured_frames_count++ % options_.heavy_metrics_sampling_rate ==
+            0) {
+      if (captured_frames_in_flight_.size() <
+          options_.max_stored_frames_in_flight) {
+        auto it = captured_frames_in_flight_.emplace(frame_id, frame).first;
+        // Set frame id on local copy of the frame
+        it->second.set_id(frame_id);
+      } else {
+        captured_frames_not_stored_++;
+      }
+    }
     frame_stats_.insert(std::pair<uint16_t, FrameStats>(
         frame_id, FrameStats(stream_label, /*captured_time=*/Now())));
 
@@ -151,12 +176,14 @@ uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
       it->second.erase(frame_id);
     }
     stream_to_frame_id_history_[stream_label].insert(frame_id);
+    media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
   }
   return frame_id;
 }
 
 void DefaultVideoQualityAnalyzer::OnFramePreEncode(
     const webrtc::VideoFrame& frame) {
+  const int64_t start_time_us = rtc::TimeMicros();
   rtc::CritScope crit(&lock_);
   auto it = frame_stats_.find(frame.id());
   RTC_DCHECK(it != frame_stats_.end())
@@ -164,11 +191,13 @@ void DefaultVideoQualityAnalyzer::OnFramePreEncode(
   frame_counters_.pre_encoded++;
   stream_frame_counters_[it->second.stream_label].pre_encoded++;
   it->second.pre_encode_time = Now();
+  media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
 }
 
 void DefaultVideoQualityAnalyzer::OnFrameEncoded(
     uint16_t frame_id,
     const webrtc::EncodedImage& encoded_image) {
+  const int64_t start_time_us = rtc::TimeMicros();
   rtc::CritScope crit(&lock_);
   auto it = frame_stats_.find(frame_id);
   RTC_DCHECK(it != frame_stats_.end());
@@ -180,6 +209,7 @@ void DefaultVideoQualityAnalyzer::OnFrameEncoded(
     stream_frame_counters_[it->second.stream_label].encoded++;
   }
   it->second.encoded_time = Now();
+  media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
 }
 
 void DefaultVideoQualityAnalyzer::OnFrameDropped(
@@ -190,6 +220,7 @@ void DefaultVideoQualityAnalyzer::OnFrameDropped(
 void DefaultVideoQualityAnalyzer::OnFramePreDecode(
     uint16_t frame_id,
     const webrtc::EncodedImage& input_image) {
+  const int64_t start_time_us = rtc::TimeMicros();
   rtc::CritScope crit(&lock_);
   auto it = frame_stats_.find(frame_id);
   RTC_DCHECK(it != frame_stats_.end());
@@ -209,22 +240,26 @@ void DefaultVideoQualityAnalyzer::OnFramePreDecode(
                        })
           ->receive_time_ms();
   it->second.received_time = Timestamp::ms(last_receive_time);
+  media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
 }
 
 void DefaultVideoQualityAnalyzer::OnFrameDecoded(
     const webrtc::VideoFrame& frame,
     absl::optional<int32_t> decode_time_ms,
     absl::optional<uint8_t> qp) {
+  const int64_t start_time_us = rtc::TimeMicros();
   rtc::CritScope crit(&lock_);
   auto it = frame_stats_.find(frame.id());
   RTC_DCHECK(it != frame_stats_.end());
   frame_counters_.decoded++;
   stream_frame_counters_[it->second.stream_label].decoded++;
   it->second.decode_end_time = Now();
+  media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
 }
 
 void DefaultVideoQualityAnalyzer::OnFrameRendered(
     const webrtc::VideoFrame& frame) {
+  const int64_t start_time_us = rtc::TimeMicros();
   rtc::CritScope crit(&lock_);
   auto stats_it = frame_stats_.find(frame.id());
   RTC_DCHECK(stats_it != frame_stats_.end());
@@ -238,11 +273,6 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
   frame_stats->rendered_frame_width = frame.width();
   frame_stats->rendered_frame_height = frame.height();
 
-  // Find corresponding captured frame.
-  auto frame_it = captured_frames_in_flight_.find(frame.id());
-  RTC_DCHECK(frame_it != captured_frames_in_flight_.end());
-  const VideoFrame& captured_frame = frame_it->second;
-
   // After we received frame here we need to check if there are any dropped
   // frames between this one and last one, that was rendered for this video
   // stream.
@@ -265,14 +295,11 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
 
     auto dropped_frame_stats_it = frame_stats_.find(dropped_frame_id);
     RTC_DCHECK(dropped_frame_stats_it != frame_stats_.end());
-    auto dropped_frame_it = captured_frames_in_flight_.find(dropped_frame_id);
-    RTC_CHECK(dropped_frame_it != captured_frames_in_flight_.end());
 
-    AddComparison(dropped_frame_it->second, absl::nullopt, true,
+    AddComparison(TakeCapturedFrame(dropped_frame_id), absl::nullopt, true,
                   dropped_frame_stats_it->second);
 
     frame_stats_.erase(dropped_frame_stats_it);
-    captured_frames_in_flight_.erase(dropped_frame_it);
   }
   RTC_DCHECK(!state->frame_ids.empty());
   state->frame_ids.pop_front();
@@ -287,10 +314,18 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
     stream_stats_[stream_label].skipped_between_rendered.AddSample(
         dropped_count);
   }
-  AddComparison(captured_frame, frame, false, *frame_stats);
+  // The rendered frame is only needed, if there is captured frame to compare
+  // it with.
+  absl::optional<VideoFrame> captured_frame = TakeCapturedFrame(frame.id());
+  absl::optional<VideoFrame> rendered_frame;
+  if (captured_frame) {
+    rendered_frame = frame;
+  }
+  AddComparison(std::move(captured_frame), std::move(rendered_frame), false,
+                *frame_stats);
 
-  captured_frames_in_flight_.erase(frame_it);
   frame_stats_.erase(stats_it);
+  media_path_time_us_.AddSample(rtc::TimeMicros() - start_time_us);
 }
 
 void DefaultVideoQualityAnalyzer::OnEncoderError(
@@ -391,8 +426,12 @@ std::map<std::string, StreamStats> DefaultVideoQualityAnalyzer::GetStats()
 }
 
 AnalyzerStats DefaultVideoQualityAnalyzer::GetAnalyzerStats() const {
-  rtc::CritScope crit(&comparison_lock_);
-  return analyzer_stats_;
+  rtc::CritScope crit1(&lock_);
+  rtc::CritScope crit2(&comparison_lock_);
+  AnalyzerStats stats = analyzer_stats_;
+  stats.captured_frames_not_stored = captured_frames_not_stored_;
+  stats.media_path_time_us = media_path_time_us_;
+  return stats;
 }
 
 // TODO(bugs.webrtc.org/10430): Migrate to the new GetStats as soon as
@@ -448,6 +487,17 @@ DefaultVideoQualityAnalyzer::GetVideoBweStats() const {
   return video_bwe_stats_;
 }
 
+absl::optional<VideoFrame> DefaultVideoQualityAnalyzer::TakeCapturedFrame(
+    uint16_t frame_id) {
+  auto it = captured_frames_in_flight_.find(frame_id);
+  if (it == captured_frames_in_flight_.end()) {
+    return absl::nullopt;
+  }
+  absl::optional<VideoFrame> frame = std::move(it->second);
+  captured_frames_in_flight_.erase(it);
+  return frame;
+}
+
 void DefaultVideoQualityAnalyzer::AddComparison(
     absl::optional<VideoFrame> captured,
     absl::optional<VideoFrame> rendered,
@@ -477,7 +527,7 @@ void DefaultVideoQualityAnalyzer::ProcessComparisons() {
     {
       rtc::CritScope crit(&comparison_lock_);
       if (!comparisons_.empty()) {
-        comparison = comparisons_.front();
+        comparison = std::move(comparisons_.front());
         comparisons_.pop_front();
         if (!comparisons_.empty()) {
           comparison_available_event_.Set();
@@ -509,10 +559,12 @@ void DefaultVideoQualityAnalyzer::ProcessComparison(
   // Perform expensive psnr and ssim calculations while not holding lock.
   double psnr = -1.0;
   double ssim = -1.0;
-  if (heavy_metrics_computation_enabled_ && comparison.captured &&
-      !comparison.dropped) {
+  int64_t heavy_metrics_time_us = -1;
+  if (comparison.captured && comparison.rendered) {
+    const int64_t start_time_us = rtc::TimeMicros();
     psnr = I420PSNR(&*comparison.captured, &*comparison.rendered);
     ssim = I420SSIM(&*comparison.captured, &*comparison.rendered);
+    heavy_metrics_time_us = rtc::TimeMicros() - start_time_us;
   }
 
   const FrameStats& frame_stats = comparison.frame_stats;
@@ -522,9 +574,12 @@ void DefaultVideoQualityAnalyzer::ProcessComparison(
   RTC_CHECK(stats_it != stream_stats_.end());
   StreamStats* stats = &stats_it->second;
   analyzer_stats_.comparisons_done++;
-  if (!comparison.captured) {
+  if (comparison.overloaded) {
     analyzer_stats_.overloaded_comparisons_done++;
   }
+  if (heavy_metrics_time_us >= 0) {
+    analyzer_stats_.heavy_metrics_time_us.AddSample(heavy_metrics_time_us);
+  }
   if (psnr > 0) {
     stats->psnr.AddSample(psnr);
   }
@@ -607,6 +662,14 @@ void DefaultVideoQualityAnalyzer::ReportResults() {
   RTC_LOG(INFO) << "comparisons_done=" << analyzer_stats_.comparisons_done;
   RTC_LOG(INFO) << "overloaded_comparisons_done="
                 << analyzer_stats_.overloaded_comparisons_done;
+  RTC_LOG(INFO) << "captured_frames_not_stored=" << captured_frames_not_stored_;
+  // The cost of the analyzer itself is reported separately from the metrics
+  // of the streams, so that it can be told apart from the cost of the call.
+  ReportResult("analyzer_media_path_time", test_label_, media_path_time_us_,
+               "us", webrtc::test::ImproveDirection::kSmallerIsBetter);
+  ReportResult("analyzer_heavy_metrics_time", test_label_,
+               analyzer_stats_.heavy_metrics_time_us, "us",
+               webrtc::test::ImproveDirection::kSmallerIsBetter);
 }
 
 void DefaultVideoQualityAnalyzer::ReportVideoBweResults(
@@ -714,6 +777,7 @@ DefaultVideoQualityAnalyzer::FrameComparison::FrameComparison(
     : captured(std::move(captured)),
       rendered(std::move(rendered)),
       dropped(dropped),
+      overloaded(false),
       frame_stats(std::move(frame_stats)) {}
 
 DefaultVideoQualityAnalyzer::FrameComparison::FrameComparison(
@@ -722,6 +786,7 @@ DefaultVideoQualityAnalyzer::FrameComparison::FrameComparison(
     : captured(absl::nullopt),
       rendered(absl::nullopt),
       dropped(dropped),
+      overloaded(true),
       frame_stats(std::move(frame_stats)) {}
 
 }  // namespace webrtc_pc_e2e
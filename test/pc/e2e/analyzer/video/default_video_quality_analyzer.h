@@ -113,6 +113,17 @@ struct AnalyzerStats {
   // comparison doesn't include metrics, that require heavy computations like
   // SSIM and PSNR.
   int64_t overloaded_comparisons_done = 0;
+  // Amount of captured frames, that were sampled for heavy metrics, but whose
+  // content wasn't kept until rendering, because there already were
+  // |max_stored_frames_in_flight| frames kept.
+  int64_t captured_frames_not_stored = 0;
+  // Time spent in the analyzer callbacks, that are called on the media path,
+  // in microseconds. It is the overhead added by the analyzer to the pipeline
+  // it measures.
+  SamplesStatsCounter media_path_time_us;
+  // Time spent by the worker threads to compute PSNR and SSIM of one frame, in
+  // microseconds.
+  SamplesStatsCounter heavy_metrics_time_us;
 };
 
 struct VideoBweStats {
@@ -123,10 +134,25 @@ struct VideoBweStats {
   SamplesStatsCounter target_encode_bitrate;
 };
 
+struct DefaultVideoQualityAnalyzerOptions {
+  // If false, PSNR and SSIM aren't computed and captured frames aren't kept
+  // until rendering.
+  bool heavy_metrics_computation_enabled = true;
+  // PSNR and SSIM are computed for one in every |heavy_metrics_sampling_rate|
+  // captured frames of each stream. Content of the other frames isn't kept.
+  int heavy_metrics_sampling_rate = 1;
+  // Max amount of captured frames, which content is kept until they are
+  // rendered or deemed dropped, over all streams. Frames captured above this
+  // limit are analyzed without PSNR and SSIM.
+  size_t max_stored_frames_in_flight = 300;
+};
+
 class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
  public:
   explicit DefaultVideoQualityAnalyzer(
       bool heavy_metrics_computation_enabled = true);
+  explicit DefaultVideoQualityAnalyzer(
+      DefaultVideoQualityAnalyzerOptions options);
   ~DefaultVideoQualityAnalyzer() override;
 
   void Start(std::string test_case_name, int max_threads_count) override;
@@ -194,6 +220,8 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   //   2. Overloaded - in this case both |captured| and |rendered| are omitted
   //      because there were too many comparisons in the queue. |dropped| can be
   //      true or false showing was frame dropped or not.
+  // In normal comparisons |captured| and |rendered| are omitted too, if the
+  // frame wasn't sampled for heavy metrics or its content wasn't kept.
   struct FrameComparison {
     FrameComparison(absl::optional<VideoFrame> captured,
                     absl::optional<VideoFrame> rendered,
@@ -209,6 +237,7 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
     // wasn't rendered on remote peer side. If |dropped| is true, |rendered|
     // will be |absl::nullopt|.
     bool dropped;
+    bool overloaded;
     FrameStats frame_stats;
   };
 
@@ -227,10 +256,16 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
     // frame with the one from |captured_frames_in_flight_| with id frame_id3.
     std::deque<uint16_t> frame_ids;
     absl::optional<Timestamp> last_rendered_frame_time = absl::nullopt;
+    // Used to sample the frames of the stream for heavy metrics.
+    int64_t captured_frames_count = 0;
   };
 
   enum State { kNew, kActive, kStopped };
 
+  // Removes the captured frame with |frame_id| from the frames in flight and
+  // returns it, if its content was kept.
+  absl::optional<VideoFrame> TakeCapturedFrame(uint16_t frame_id)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void AddComparison(absl::optional<VideoFrame> captured,
                      absl::optional<VideoFrame> rendered,
                      bool dropped,
@@ -256,7 +291,7 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   std::string GetTestCaseName(const std::string& stream_label) const;
   Timestamp Now();
 
-  const bool heavy_metrics_computation_enabled_;
+  const DefaultVideoQualityAnalyzerOptions options_;
   webrtc::Clock* const clock_;
   std::atomic<uint16_t> next_frame_id_{0};
 
@@ -266,9 +301,12 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   State state_ RTC_GUARDED_BY(lock_) = State::kNew;
   Timestamp start_time_ RTC_GUARDED_BY(lock_) = Timestamp::MinusInfinity();
   // Frames that were captured by all streams and still aren't rendered by any
-  // stream or deemed dropped.
+  // stream or deemed dropped. Only frames sampled for heavy metrics are kept,
+  // up to |options_.max_stored_frames_in_flight|.
   std::map<uint16_t, VideoFrame> captured_frames_in_flight_
       RTC_GUARDED_BY(lock_);
+  int64_t captured_frames_not_stored_ RTC_GUARDED_BY(lock_) = 0;
+  SamplesStatsCounter media_path_time_us_ RTC_GUARDED_BY(lock_);
   // Global frames count for all video streams.
   FrameCounters frame_counters_ RTC_GUARDED_BY(lock_);
   // Frame counters per each stream.
@@ -114,6 +114,7 @@ class PeerScenarioClient {
     return peer_connection_.get();
   }
   rtc::Thread* thread() { return signaling_thread_; }
+  rtc::Thread* worker_thread() { return worker_thread_.get(); }
   Clock* clock() { return Clock::GetRealTimeClock(); }
 
   // Returns the endpoint created from the EmulatedEndpointConfig with the same
@@ -0,0 +1,215 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/test/network_emulation_manager.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/numerics/samples_stats_counter.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/peer_scenario/peer_scenario.h"
+#include "test/testsupport/perf_test.h"
+#include "test/testsupport/profiling_results.h"
+
+ABSL_FLAG(int,
+          load_test_pairs,
+          0,
+          "If set, runs the load test with this many caller and callee pairs "
+          "instead of the predefined sizes.");
+ABSL_FLAG(int,
+          load_test_video_tracks,
+          4,
+          "Number of video tracks sent by each caller when --load_test_pairs "
+          "is set.");
+ABSL_FLAG(int,
+          load_test_duration_s,
+          10,
+          "Seconds to run the load test for after the calls are connected.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+struct LoadConfig {
+  int pairs;
+  int video_tracks;
+};
+
+class StatsCallback : public RTCStatsCollectorCallback {
+ public:
+  explicit StatsCallback(std::function<void(const RTCStatsReport&)> handler)
+      : handler_(std::move(handler)) {}
+
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const RTCStatsReport>& report) override {
+    handler_(*report);
+  }
+
+ private:
+  const std::function<void(const RTCStatsReport&)> handler_;
+};
+
+// Fetches the stats of every client and waits for all of them.
+void ForEachReport(PeerScenario* s,
+                   const std::vector<PeerScenarioClient*>& clients,
+                   std::function<void(const RTCStatsReport&)> handler) {
+  size_t pending = clients.size();
+  rtc::Event done;
+  for (PeerScenarioClient* client : clients) {
+    client->pc()->GetStats(new rtc::RefCountedObject<StatsCallback>(
+        [&](const RTCStatsReport& report) {
+          handler(report);
+          if (--pending == 0)
+            done.Set();
+        }));
+  }
+  RTC_CHECK(s->WaitAndProcess(&done));
+}
+
+int64_t GetCpuTimeNanos(rtc::Thread* thread) {
+  return thread->Invoke<int64_t>(RTC_FROM_HERE,
+                                 [] { return rtc::GetThreadCpuTimeNanos(); });
+}
+
+}  // namespace
+
+// Runs many calls in one process, each with several bundled video tracks and
+// an audio track, and reports what they cost as perf results: process CPU time
+// per packet sent, the utilization of the signaling and worker threads, the
+// resident memory per PeerConnection, the distribution of round trip times and
+// the allocations and lock contention while the calls are running.
+// The numbers are meant to be compared between builds on the same machine.
+class PeerScenarioLoadTest : public ::testing::TestWithParam<LoadConfig> {};
+
+TEST_P(PeerScenarioLoadTest, ReportsCostPerPeerConnection) {
+  LoadConfig config = GetParam();
+  if (absl::GetFlag(FLAGS_load_test_pairs) > 0) {
+    config.pairs = absl::GetFlag(FLAGS_load_test_pairs);
+    config.video_tracks = absl::GetFlag(FLAGS_load_test_video_tracks);
+  }
+  const TimeDelta duration =
+      TimeDelta::seconds(absl::GetFlag(FLAGS_load_test_duration_s));
+
+  PeerScenario s(*::testing::UnitTest::GetInstance()->current_test_info());
+  const int64_t start_memory_bytes = rtc::GetProcessResidentSizeBytes();
+
+  PeerScenarioClient::Config client_config;
+  client_config.rtc_config.bundle_policy =
+      PeerConnectionInterface::kBundlePolicyMaxBundle;
+  client_config.rtc_config.rtcp_mux_policy =
+      PeerConnectionInterface::kRtcpMuxPolicyRequire;
+  std::vector<PeerScenarioClient*> clients;
+  for (int i = 0; i < config.pairs; ++i) {
+    auto* caller = s.CreateClient(client_config);
+    auto* callee = s.CreateClient(client_config);
+    caller->CreateAudio("AUDIO", cricket::AudioOptions());
+    for (int j = 0; j < config.video_tracks; ++j) {
+      caller->CreateVideo("VIDEO_" + rtc::ToString(j),
+                          PeerScenarioClient::VideoSendTrackConfig());
+    }
+    auto link_builder = s.net()->NodeBuilder().delay_ms(20).capacity_kbps(
+        2000 * config.video_tracks);
+    s.SimpleConnection(caller, callee, {link_builder.Build().node},
+                       {link_builder.Build().node});
+    clients.push_back(caller);
+    clients.push_back(callee);
+  }
+  const int64_t connected_memory_bytes = rtc::GetProcessResidentSizeBytes();
+
+  std::vector<rtc::Thread*> worker_threads;
+  std::vector<int64_t> start_worker_cpu_ns;
+  for (PeerScenarioClient* client : clients) {
+    worker_threads.push_back(client->worker_thread());
+    start_worker_cpu_ns.push_back(GetCpuTimeNanos(client->worker_thread()));
+  }
+  const int64_t start_time_ns = rtc::TimeNanos();
+  const int64_t start_cpu_ns = rtc::GetProcessCpuTimeNanos();
+  const int64_t start_signaling_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  ProfilingResultsCollector profiling;
+
+  SamplesStatsCounter round_trip_time_ms;
+  for (TimeDelta elapsed = TimeDelta::Zero(); elapsed < duration;
+       elapsed += TimeDelta::seconds(1)) {
+    s.ProcessMessages(TimeDelta::seconds(1));
+    ForEachReport(&s, clients, [&](const RTCStatsReport& report) {
+      for (const auto* pair :
+           report.GetStatsOfType<RTCIceCandidatePairStats>()) {
+        if (pair->nominated.is_defined() && *pair->nominated &&
+            pair->current_round_trip_time.is_defined()) {
+          round_trip_time_ms.AddSample(*pair->current_round_trip_time * 1000);
+        }
+      }
+    });
+  }
+
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_time_ns;
+  const int64_t cpu_ns = rtc::GetProcessCpuTimeNanos() - start_cpu_ns;
+  const int64_t signaling_cpu_ns =
+      rtc::GetThreadCpuTimeNanos() - start_signaling_cpu_ns;
+  int64_t worker_cpu_ns = 0;
+  for (size_t i = 0; i < worker_threads.size(); ++i) {
+    worker_cpu_ns +=
+        GetCpuTimeNanos(worker_threads[i]) - start_worker_cpu_ns[i];
+  }
+
+  int64_t packets_sent = 0;
+  ForEachReport(&s, clients, [&](const RTCStatsReport& report) {
+    for (const auto* outbound :
+         report.GetStatsOfType<RTCOutboundRTPStreamStats>()) {
+      if (outbound->packets_sent.is_defined())
+        packets_sent += *outbound->packets_sent;
+    }
+  });
+  ASSERT_GT(packets_sent, 0);
+
+  rtc::StringBuilder trace;
+  trace << config.pairs << "_pairs_" << config.video_tracks << "_tracks";
+  const int num_pcs = static_cast<int>(clients.size());
+  PrintResult("cpu_per_packet", "", trace.str(),
+              static_cast<double>(cpu_ns) / rtc::kNumNanosecsPerMicrosec /
+                  packets_sent,
+              "us", false, ImproveDirection::kSmallerIsBetter);
+  PrintResult("signaling_thread_utilization", "", trace.str(),
+              100.0 * signaling_cpu_ns / elapsed_ns, "%", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult("worker_thread_utilization", "", trace.str(),
+              100.0 * worker_cpu_ns / elapsed_ns / num_pcs, "%", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult("memory_per_pc", "", trace.str(),
+              static_cast<double>(connected_memory_bytes - start_memory_bytes) /
+                  1024 / num_pcs,
+              "KB", false, ImproveDirection::kSmallerIsBetter);
+  if (!round_trip_time_ms.IsEmpty()) {
+    PrintResult("round_trip_time", "", trace.str(), round_trip_time_ms, "ms",
+                false, ImproveDirection::kSmallerIsBetter);
+    PrintResult("round_trip_time_p95", "", trace.str(),
+                round_trip_time_ms.GetPercentile(0.95), "ms", false,
+                ImproveDirection::kSmallerIsBetter);
+  }
+  profiling.PrintResults(trace.str());
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes,
+                         PeerScenarioLoadTest,
+                         ::testing::Values(LoadConfig{1, 1},
+                                           LoadConfig{4, 4},
+                                           LoadConfig{16, 4}));
+
+}  // namespace test
+}  // namespace webrtc
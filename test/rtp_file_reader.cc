@@ -11,11 +11,20 @@
 #include "test/rtp_file_reader.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "modules/rtp_rtcp/source/rtp_utility.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
@@ -37,46 +46,170 @@ static uint16_t kPacketHeaderSize = 8;
     }                                       \
   } while (0)
 
-bool ReadUint32(uint32_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 4; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
+// The contents of a dump, memory mapped where supported so that large captures
+// are neither read up front nor with a system call per field.
+class FileData {
+ public:
+  static std::unique_ptr<FileData> Open(const std::string& filename) {
+    std::unique_ptr<FileData> file_data(new FileData());
+#if defined(WEBRTC_POSIX)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return nullptr;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      return nullptr;
+    }
+    file_data->size_ = static_cast<size_t>(file_stat.st_size);
+    // Empty files can't be mapped, and need no data.
+    if (file_data->size_ > 0) {
+      void* mapping =
+          mmap(nullptr, file_data->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+      }
+      // The dump is read front to back.
+      madvise(mapping, file_data->size_, MADV_SEQUENTIAL);
+      file_data->mapping_ = mapping;
+      file_data->data_ = static_cast<const uint8_t*>(mapping);
+    }
+    close(fd);
+#else
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == nullptr)
+      return nullptr;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      file_data->buffer_.insert(file_data->buffer_.end(), buffer,
+                                buffer + read);
+    }
+    fclose(file);
+    file_data->data_ = file_data->buffer_.data();
+    file_data->size_ = file_data->buffer_.size();
+#endif
+    return file_data;
+  }
+
+  static std::unique_ptr<FileData> Copy(const uint8_t* data, size_t size) {
+    std::unique_ptr<FileData> file_data(new FileData());
+    file_data->buffer_.assign(data, data + size);
+    file_data->data_ = file_data->buffer_.data();
+    file_data->size_ = size;
+    return file_data;
+  }
+
+  ~FileData() {
+#if defined(WEBRTC_POSIX)
+    if (mapping_)
+      munmap(mapping_, size_);
+#endif
+  }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  FileData() = default;
+
+  void* mapping_ = nullptr;
+  std::vector<uint8_t> buffer_;
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(FileData);
+};
+
+// Reads from FileData like from a FILE*: reads past the end fail, leave the
+// position at the end and set the end-of-file flag, which seeking clears.
+class FileReader {
+ public:
+  explicit FileReader(std::unique_ptr<FileData> file_data)
+      : file_data_(std::move(file_data)) {}
+
+  // Points at the next |count| bytes, which are skipped, or returns null.
+  const uint8_t* Consume(size_t count) {
+    const size_t size = file_data_->size();
+    if (pos_ > size || count > size - pos_) {
+      pos_ = size;
+      eof_ = true;
+      return nullptr;
+    }
+    const uint8_t* data = file_data_->data() + pos_;
+    pos_ += count;
+    return data;
+  }
+
+  bool Read(void* out, size_t count) {
+    const uint8_t* data = Consume(count);
+    if (data == nullptr)
       return false;
-    *out |= tmp;
+    memcpy(out, data, count);
+    return true;
+  }
+
+  // Reads a line of at most |max_length| bytes, including the newline, like
+  // fgets() with a buffer one byte larger.
+  bool ReadLine(char* out, size_t max_length) {
+    size_t length = 0;
+    while (length < max_length) {
+      const uint8_t* c = Consume(1);
+      if (c == nullptr)
+        break;
+      out[length++] = static_cast<char>(*c);
+      if (*c == '\n')
+        break;
+    }
+    out[length] = '\0';
+    return length > 0;
+  }
+
+  size_t pos() const { return pos_; }
+  // Like fseek(), the position may be past the end.
+  void Seek(size_t pos) {
+    pos_ = pos;
+    eof_ = false;
   }
+  void Skip(size_t count) { Seek(pos_ + count); }
+  bool eof() const { return eof_; }
+
+ private:
+  const std::unique_ptr<FileData> file_data_;
+  size_t pos_ = 0;
+  bool eof_ = false;
+};
+
+bool ReadUint32(uint32_t* out, FileReader* file) {
+  const uint8_t* data = file->Consume(4);
+  if (data == nullptr)
+    return false;
+  *out = (static_cast<uint32_t>(data[0]) << 24) |
+         (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | data[3];
   return true;
 }
 
-bool ReadUint16(uint16_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 2; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
-      return false;
-    *out |= tmp;
-  }
+bool ReadUint16(uint16_t* out, FileReader* file) {
+  const uint8_t* data = file->Consume(2);
+  if (data == nullptr)
+    return false;
+  *out = static_cast<uint16_t>((data[0] << 8) | data[1]);
   return true;
 }
 
 class RtpFileReaderImpl : public RtpFileReader {
  public:
-  virtual bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) = 0;
+  virtual bool Init(std::unique_ptr<FileData> file_data,
+                    const std::set<uint32_t>& ssrc_filter) = 0;
 };
 
 class InterleavedRtpFileReader : public RtpFileReaderImpl {
  public:
-  ~InterleavedRtpFileReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
-    }
-  }
-
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    file_ = file;
+  bool Init(std::unique_ptr<FileData> file_data,
+            const std::set<uint32_t>& ssrc_filter) override {
+    file_ = std::make_unique<FileReader>(std::move(file_data));
     return true;
   }
 
@@ -84,14 +217,14 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
     assert(file_ != nullptr);
     packet->length = RtpPacket::kMaxPacketBufferSize;
     uint32_t len = 0;
-    TRY(ReadUint32(&len, file_));
+    TRY(ReadUint32(&len, file_.get()));
     if (packet->length < len) {
       FATAL() << "Packet is too large to fit: " << len << " bytes vs "
               << packet->length
               << " bytes allocated. Consider increasing the buffer "
                  "size";
     }
-    if (fread(packet->data, 1, len, file_) != len)
+    if (!file_->Read(packet->data, len))
       return false;
 
     packet->length = len;
@@ -102,7 +235,7 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
   }
 
  private:
-  FILE* file_ = nullptr;
+  std::unique_ptr<FileReader> file_;
   int64_t time_ms_ = 0;
 };
 
@@ -110,19 +243,14 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
 // http://www.cs.columbia.edu/irt/software/rtptools/
 class RtpDumpReader : public RtpFileReaderImpl {
  public:
-  RtpDumpReader() : file_(nullptr) {}
-  ~RtpDumpReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
-    }
-  }
+  RtpDumpReader() = default;
 
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    file_ = file;
+  bool Init(std::unique_ptr<FileData> file_data,
+            const std::set<uint32_t>& ssrc_filter) override {
+    file_ = std::make_unique<FileReader>(std::move(file_data));
 
     char firstline[kFirstLineLength + 1] = {0};
-    if (fgets(firstline, kFirstLineLength, file_) == nullptr) {
+    if (!file_->ReadLine(firstline, kFirstLineLength - 1)) {
       RTC_LOG(LS_INFO) << "Can't read from file";
       return false;
     }
@@ -146,11 +274,11 @@ class RtpDumpReader : public RtpFileReaderImpl {
     uint32_t source;
     uint16_t port;
     uint16_t padding;
-    TRY(ReadUint32(&start_sec, file_));
-    TRY(ReadUint32(&start_usec, file_));
-    TRY(ReadUint32(&source, file_));
-    TRY(ReadUint16(&port, file_));
-    TRY(ReadUint16(&padding, file_));
+    TRY(ReadUint32(&start_sec, file_.get()));
+    TRY(ReadUint32(&start_usec, file_.get()));
+    TRY(ReadUint32(&source, file_.get()));
+    TRY(ReadUint16(&port, file_.get()));
+    TRY(ReadUint16(&padding, file_.get()));
 
     return true;
   }
@@ -162,9 +290,9 @@ class RtpDumpReader : public RtpFileReaderImpl {
     uint16_t len;
     uint16_t plen;
     uint32_t offset;
-    TRY(ReadUint16(&len, file_));
-    TRY(ReadUint16(&plen, file_));
-    TRY(ReadUint32(&offset, file_));
+    TRY(ReadUint16(&len, file_.get()));
+    TRY(ReadUint16(&plen, file_.get()));
+    TRY(ReadUint32(&offset, file_.get()));
 
     // Use 'len' here because a 'plen' of 0 specifies rtcp.
     len -= kPacketHeaderSize;
@@ -175,7 +303,7 @@ class RtpDumpReader : public RtpFileReaderImpl {
                            "size";
       return false;
     }
-    if (fread(rtp_data, 1, len, file_) != len) {
+    if (!file_->Read(rtp_data, len)) {
       return false;
     }
 
@@ -186,7 +314,7 @@ class RtpDumpReader : public RtpFileReaderImpl {
   }
 
  private:
-  FILE* file_;
+  std::unique_ptr<FileReader> file_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpDumpReader);
 };
@@ -233,32 +361,27 @@ const uint32_t kPcapBOMNoSwapOrder = 0xa1b2c3d4UL;
 class PcapReader : public RtpFileReaderImpl {
  public:
   PcapReader()
-      : file_(nullptr),
-        swap_pcap_byte_order_(false),
+      : swap_pcap_byte_order_(false),
 #ifdef WEBRTC_ARCH_BIG_ENDIAN
         swap_network_byte_order_(false),
 #else
         swap_network_byte_order_(true),
 #endif
-        read_buffer_(),
         packets_by_ssrc_(),
         packets_(),
         next_packet_it_() {
   }
 
-  ~PcapReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
-    }
-  }
-
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    return Initialize(file, ssrc_filter) == kResultSuccess;
+  bool Init(std::unique_ptr<FileData> file_data,
+            const std::set<uint32_t>& ssrc_filter) override {
+    return Initialize(std::move(file_data), ssrc_filter) == kResultSuccess;
   }
 
-  int Initialize(FILE* file, const std::set<uint32_t>& ssrc_filter) {
-    file_ = file;
+  // Indexes the RTP and RTCP packets of the file. This takes no copies, since
+  // the headers are parsed where they are mapped.
+  int Initialize(std::unique_ptr<FileData> file_data,
+                 const std::set<uint32_t>& ssrc_filter) {
+    file_ = std::make_unique<FileReader>(std::move(file_data));
 
     if (ReadGlobalHeader() < 0) {
       return kResultFail;
@@ -266,9 +389,9 @@ class PcapReader : public RtpFileReaderImpl {
 
     int total_packet_count = 0;
     uint32_t stream_start_ms = 0;
-    int32_t next_packet_pos = ftell(file_);
+    size_t next_packet_pos = file_->pos();
     for (;;) {
-      TRY_PCAP(fseek(file_, next_packet_pos, SEEK_SET));
+      file_->Seek(next_packet_pos);
       int result = ReadPacket(&next_packet_pos, stream_start_ms,
                               ++total_packet_count, ssrc_filter);
       if (result == kResultFail) {
@@ -281,7 +404,7 @@ class PcapReader : public RtpFileReaderImpl {
       }
     }
 
-    if (feof(file_) == 0) {
+    if (!file_->eof()) {
       printf("Failed reading file!\n");
       return kResultFail;
     }
@@ -338,7 +461,7 @@ class PcapReader : public RtpFileReaderImpl {
     if (*length < next_packet_it_->payload_length) {
       return -1;
     }
-    TRY_PCAP(fseek(file_, next_packet_it_->pos_in_file, SEEK_SET));
+    file_->Seek(next_packet_it_->pos_in_file);
     TRY_PCAP(Read(data, next_packet_it_->payload_length));
     *length = next_packet_it_->payload_length;
     *time_ms = next_packet_it_->time_offset_ms;
@@ -357,7 +480,7 @@ class PcapReader : public RtpFileReaderImpl {
     uint16_t source_port;
     uint16_t dest_port;
     RTPHeader rtp_header;
-    int32_t pos_in_file;  // Byte offset of payload from start of file.
+    size_t pos_in_file;  // Byte offset of payload from start of file.
     uint32_t payload_length;
   };
 
@@ -403,7 +526,7 @@ class PcapReader : public RtpFileReaderImpl {
     return kResultSuccess;
   }
 
-  int ReadPacket(int32_t* next_packet_pos,
+  int ReadPacket(size_t* next_packet_pos,
                  uint32_t stream_start_ms,
                  uint32_t number,
                  const std::set<uint32_t>& ssrc_filter) {
@@ -418,21 +541,23 @@ class PcapReader : public RtpFileReaderImpl {
     TRY_PCAP(Read(&incl_len, false));
     TRY_PCAP(Read(&orig_len, false));
 
-    *next_packet_pos = ftell(file_) + incl_len;
+    *next_packet_pos = file_->pos() + incl_len;
 
     RtpPacketMarker marker = {0};
     marker.packet_number = number;
     marker.time_offset_ms = CalcTimeDelta(ts_sec, ts_usec, stream_start_ms);
     TRY_PCAP(ReadPacketHeader(&marker));
-    marker.pos_in_file = ftell(file_);
+    marker.pos_in_file = file_->pos();
 
-    if (marker.payload_length > sizeof(read_buffer_)) {
+    if (marker.payload_length > kMaxReadBufferSize) {
       printf("Packet too large!\n");
       return kResultFail;
     }
-    TRY_PCAP(Read(read_buffer_, marker.payload_length));
+    const uint8_t* payload = file_->Consume(marker.payload_length);
+    if (payload == nullptr)
+      return kResultFail;
 
-    RtpUtility::RtpHeaderParser rtp_parser(read_buffer_, marker.payload_length);
+    RtpUtility::RtpHeaderParser rtp_parser(payload, marker.payload_length);
     if (rtp_parser.RTCP()) {
       rtp_parser.ParseRtcp(&marker.rtp_header);
       packets_.push_back(marker);
@@ -456,7 +581,7 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int ReadPacketHeader(RtpPacketMarker* marker) {
-    int32_t file_pos = ftell(file_);
+    size_t file_pos = file_->pos();
 
     // Check for BSD null/loopback frame header. The header is just 4 bytes in
     // native byte order, so we check for both versions as we don't care about
@@ -472,11 +597,11 @@ class PcapReader : public RtpFileReaderImpl {
       }
     }
 
-    TRY_PCAP(fseek(file_, file_pos, SEEK_SET));
+    file_->Seek(file_pos);
 
     // Check for Ethernet II, IP frame header.
     uint16_t type;
-    TRY_PCAP(Skip(kEthernetIIHeaderMacSkip));  // Source+destination MAC.
+    file_->Skip(kEthernetIIHeaderMacSkip);  // Source+destination MAC.
     TRY_PCAP(Read(&type, true));
     if (type == kEthertypeIp) {
       int result = ReadXxpIpHeader(marker);
@@ -533,7 +658,7 @@ class PcapReader : public RtpFileReaderImpl {
     // Skip remaining fields of IP header.
     uint16_t header_length = (version & 0x0f00) >> (8 - 2);
     assert(header_length >= kMinIpHeaderLength);
-    TRY_PCAP(Skip(header_length - kMinIpHeaderLength));
+    file_->Skip(static_cast<uint32_t>(header_length - kMinIpHeaderLength));
 
     protocol = protocol & 0x00ff;
     if (protocol == kProtocolTcp) {
@@ -557,7 +682,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(uint32_t* out, bool expect_network_order) {
     uint32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
+    if (!file_->Read(&tmp, sizeof(uint32_t))) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -571,7 +696,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(uint16_t* out, bool expect_network_order) {
     uint16_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint16_t), file_) != sizeof(uint16_t)) {
+    if (!file_->Read(&tmp, sizeof(uint16_t))) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -583,7 +708,7 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int Read(uint8_t* out, uint32_t count) {
-    if (fread(out, 1, count, file_) != count) {
+    if (!file_->Read(out, count)) {
       return kResultFail;
     }
     return kResultSuccess;
@@ -591,7 +716,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(int32_t* out, bool expect_network_order) {
     int32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
+    if (!file_->Read(&tmp, sizeof(uint32_t))) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -603,17 +728,9 @@ class PcapReader : public RtpFileReaderImpl {
     return kResultSuccess;
   }
 
-  int Skip(uint32_t length) {
-    if (fseek(file_, length, SEEK_CUR) != 0) {
-      return kResultFail;
-    }
-    return kResultSuccess;
-  }
-
-  FILE* file_;
+  std::unique_ptr<FileReader> file_;
   bool swap_pcap_byte_order_;
   const bool swap_network_byte_order_;
-  uint8_t read_buffer_[kMaxReadBufferSize];
 
   SsrcMap packets_by_ssrc_;
   std::vector<RtpPacketMarker> packets_;
@@ -643,20 +760,7 @@ RtpFileReader* RtpFileReader::Create(FileFormat format,
                                      size_t size,
                                      const std::set<uint32_t>& ssrc_filter) {
   std::unique_ptr<RtpFileReaderImpl> reader(CreateReaderForFormat(format));
-
-  FILE* file = tmpfile();
-  if (file == nullptr) {
-    printf("ERROR: Can't open file from memory buffer\n");
-    return nullptr;
-  }
-
-  if (fwrite(reinterpret_cast<const void*>(data), sizeof(uint8_t), size,
-             file) != size) {
-    return nullptr;
-  }
-  rewind(file);
-
-  if (!reader->Init(file, ssrc_filter)) {
+  if (!reader->Init(FileData::Copy(data, size), ssrc_filter)) {
     return nullptr;
   }
   return reader.release();
@@ -665,18 +769,17 @@ RtpFileReader* RtpFileReader::Create(FileFormat format,
 RtpFileReader* RtpFileReader::Create(FileFormat format,
                                      const std::string& filename,
                                      const std::set<uint32_t>& ssrc_filter) {
-  RtpFileReaderImpl* reader = CreateReaderForFormat(format);
-  FILE* file = fopen(filename.c_str(), "rb");
-  if (file == nullptr) {
+  std::unique_ptr<FileData> file_data = FileData::Open(filename);
+  if (file_data == nullptr) {
     printf("ERROR: Can't open file: %s\n", filename.c_str());
     return nullptr;
   }
 
-  if (!reader->Init(file, ssrc_filter)) {
-    delete reader;
+  std::unique_ptr<RtpFileReaderImpl> reader(CreateReaderForFormat(format));
+  if (!reader->Init(std::move(file_data), ssrc_filter)) {
     return nullptr;
   }
-  return reader;
+  return reader.release();
 }
 
 RtpFileReader* RtpFileReader::Create(FileFormat format,
@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <memory>
+#include <string>
+
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+#include "test/scenario/stats_collection.h"
+#include "test/testsupport/perf_test.h"
+#include "test/testsupport/profiling_results.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+using ::testing::Combine;
+using ::testing::tuple;
+using ::testing::Values;
+
+constexpr TimeDelta kRunTime = TimeDelta::Seconds<60>();
+constexpr DataRate kMaxVideoRate = DataRate::KilobitsPerSec<10000>();
+
+enum class Controller { kGoogCc, kBbr, kPcc };
+
+struct Network {
+  const char* name;
+  DataRate bandwidth;
+  TimeDelta delay;
+  double loss_rate;
+};
+
+const char* ControllerName(Controller controller) {
+  switch (controller) {
+    case Controller::kGoogCc:
+      return "goog_cc";
+    case Controller::kBbr:
+      return "bbr";
+    case Controller::kPcc:
+      return "pcc";
+  }
+  return "";
+}
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFactory(
+    Controller controller) {
+  switch (controller) {
+    case Controller::kGoogCc:
+      // Uses the default controller of the call.
+      return nullptr;
+    case Controller::kBbr:
+      return std::make_unique<BbrNetworkControllerFactory>();
+    case Controller::kPcc:
+      return std::make_unique<PccNetworkControllerFactory>();
+  }
+  return nullptr;
+}
+
+std::string FieldTrials(Controller controller) {
+  // The pacer settings used with BBR in bbr_performance.cc.
+  if (controller == Controller::kBbr) {
+    return "WebRTC-Pacer-DrainQueue/Disabled/"
+           "WebRTC-Pacer-PadInSilence/Enabled/"
+           "WebRTC-Pacer-BlockAudio/Disabled/"
+           "WebRTC-Audio-SendSideBwe/Enabled/"
+           "WebRTC-SendSideBwe-WithOverhead/Enabled/";
+  }
+  return "";
+}
+}  // namespace
+
+// Runs the same one way call over an emulated network with each of the
+// network controllers, and reports the rate achieved, the delay it costs and
+// the CPU time, allocations and lock contention as perf results, so that
+// controllers can be compared per network.
+class ControllerComparisonTest
+    : public ::testing::Test,
+      public ::testing::WithParamInterface<tuple<Controller, Network>> {
+ protected:
+  ControllerComparisonTest()
+      : controller_(::testing::get<0>(GetParam())),
+        network_(::testing::get<1>(GetParam())),
+        field_trials_(FieldTrials(controller_)) {}
+
+  const Controller controller_;
+  const Network network_;
+
+ private:
+  ScopedFieldTrials field_trials_;
+};
+
+TEST_P(ControllerComparisonTest, ReportsRateAndDelay) {
+  std::unique_ptr<NetworkControllerFactoryInterface> factory =
+      CreateFactory(controller_);
+  VideoQualityAnalyzer analyzer;
+  CallStatsCollectors stats;
+  int64_t cpu_time_ns;
+  ProfilingResultsCollector profiling;
+  {
+    Scenario s;
+    CallClientConfig call_config;
+    call_config.transport.cc_factory = factory.get();
+    call_config.transport.rates.min_rate = DataRate::kbps(30);
+    call_config.transport.rates.max_rate = kMaxVideoRate;
+    auto* caller = s.CreateClient("caller", call_config);
+    auto* callee = s.CreateClient("callee", call_config);
+
+    NetworkSimulationConfig net_conf;
+    net_conf.bandwidth = network_.bandwidth;
+    net_conf.delay = network_.delay;
+    net_conf.loss_rate = network_.loss_rate;
+    NetworkSimulationConfig return_conf;
+    return_conf.delay = network_.delay;
+    auto route =
+        s.CreateRoutes(caller, {s.CreateSimulationNode(net_conf)}, callee,
+                       {s.CreateSimulationNode(return_conf)});
+
+    VideoStreamConfig video_config;
+    video_config.encoder.fake.max_rate = kMaxVideoRate;
+    video_config.hooks.frame_pair_handlers = {analyzer.Handler()};
+    auto* video = s.CreateVideoStream(route->forward(), video_config);
+    s.Every(TimeDelta::seconds(1), [&] {
+      stats.call.AddStats(caller->GetStats());
+      stats.video_send.AddStats(video->send()->GetStats(), s.Now());
+    });
+
+    const int64_t start_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+    s.RunFor(kRunTime);
+    cpu_time_ns = rtc::GetProcessCpuTimeNanos() - start_cpu_time_ns;
+  }
+
+  const std::string trace =
+      std::string(network_.name) + "_" + ControllerName(controller_);
+  PrintResult("target_rate", "", trace,
+              stats.call.stats().target_rate.Mean().kbps<double>(), "kbps",
+              false, ImproveDirection::kBiggerIsBetter);
+  PrintResult("media_rate", "", trace,
+              stats.video_send.stats().media_bitrate.Mean().kbps<double>(),
+              "kbps", false, ImproveDirection::kBiggerIsBetter);
+  PrintResult("pacer_delay", "", trace,
+              stats.call.stats().pacer_delay.Mean().ms<double>(), "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+  PrintResult("round_trip_time", "", trace,
+              stats.call.stats().round_trip_time.Mean().ms<double>(), "ms",
+              false, ImproveDirection::kSmallerIsBetter);
+  if (!analyzer.stats().end_to_end_delay.IsEmpty()) {
+    PrintResult("end_to_end_delay_p95", "", trace,
+                analyzer.stats().end_to_end_delay.Quantile(0.95).ms<double>(),
+                "ms", false, ImproveDirection::kSmallerIsBetter);
+  }
+  PrintResult("cpu_time", "", trace,
+              static_cast<double>(cpu_time_ns) / rtc::kNumNanosecsPerMillisec,
+              "ms", false, ImproveDirection::kSmallerIsBetter);
+  profiling.PrintResults(trace);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Controllers,
+    ControllerComparisonTest,
+    Combine(Values(Controller::kGoogCc, Controller::kBbr, Controller::kPcc),
+            Values(Network{"low_bdp", DataRate::kbps(800), TimeDelta::ms(20),
+                           0},
+                   Network{"high_bdp", DataRate::kbps(8000),
+                           TimeDelta::ms(150), 0},
+                   Network{"lossy", DataRate::kbps(2000), TimeDelta::ms(50),
+                           0.02})));
+
+}  // namespace test
+}  // namespace webrtc
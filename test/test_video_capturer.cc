@@ -74,6 +74,7 @@ void TestVideoCapturer::UpdateVideoAdapter() {
   rtc::VideoSinkWants wants = broadcaster_.wants();
   video_adapter_.OnResolutionFramerateRequest(
       wants.target_pixel_count, wants.max_pixel_count, wants.max_framerate_fps);
+  OnSinkWantsChanged(wants);
 }
 
 VideoFrame TestVideoCapturer::MaybePreprocess(const VideoFrame& frame) {
@@ -45,6 +45,11 @@ class TestVideoCapturer : public rtc::VideoSourceInterface<VideoFrame> {
  protected:
   void OnFrame(const VideoFrame& frame);
   rtc::VideoSinkWants GetSinkWants();
+  // Called with the combined wants of the sinks when they change, after the
+  // video adapter is updated. Capturers that can change the size or rate of
+  // their source override this, so that less is captured only to be scaled
+  // down or dropped.
+  virtual void OnSinkWantsChanged(const rtc::VideoSinkWants& wants) {}
 
  private:
   void UpdateVideoAdapter();
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/allocation_counter.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+std::atomic<int64_t> g_new_count(0);
+
+void* CountedAlloc(size_t size) {
+  g_new_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (!ptr)
+    abort();
+  return ptr;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return CountedAlloc(size);
+}
+
+void* operator new[](size_t size) {
+  return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+namespace webrtc {
+namespace test {
+
+AllocationCounter::AllocationCounter()
+    : initial_new_count_(g_new_count.load(std::memory_order_relaxed)) {}
+
+int64_t AllocationCounter::new_count() const {
+  return g_new_count.load(std::memory_order_relaxed) - initial_new_count_;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,36 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_TESTSUPPORT_ALLOCATION_COUNTER_H_
+#define TEST_TESTSUPPORT_ALLOCATION_COUNTER_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+namespace test {
+
+// Counts the heap allocations made through the global operator new, by all
+// threads, after the counter was created. Linking this in replaces the global
+// operator new and delete of the binary with versions that count the calls and
+// forward to malloc and free, so it is meant for perf tests only.
+class AllocationCounter {
+ public:
+  AllocationCounter();
+
+  int64_t new_count() const;
+
+ private:
+  const int64_t initial_new_count_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_TESTSUPPORT_ALLOCATION_COUNTER_H_
@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/profiling_results.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "rtc_base/lock_profiler.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+ProfilingResultsCollector::ProfilingResultsCollector() {
+  rtc::ResetLockContention();
+}
+
+void ProfilingResultsCollector::PrintResults(const std::string& trace,
+                                             size_t max_holders) const {
+  PrintResult("allocations", "", trace,
+              static_cast<double>(allocations_.new_count()), "count", false,
+              ImproveDirection::kSmallerIsBetter);
+  if (!rtc::IsLockProfilingEnabled())
+    return;
+
+  const std::vector<rtc::LockContention> contention = rtc::GetLockContention();
+  int64_t contentions = 0;
+  int64_t wait_time_us = 0;
+  for (const rtc::LockContention& holder : contention) {
+    contentions += holder.contentions;
+    wait_time_us += holder.wait_time_us;
+  }
+  PrintResult("lock_contentions", "", trace, static_cast<double>(contentions),
+              "count", false, ImproveDirection::kSmallerIsBetter);
+  PrintResult("lock_wait_time", "", trace, wait_time_us / 1000.0, "ms", false,
+              ImproveDirection::kSmallerIsBetter);
+
+  // The holders are source locations, which do not make good perf result
+  // names, so they are only printed for finding the cause of a regression.
+  printf("Lock contention of %s, by holder:\n", trace.c_str());
+  for (size_t i = 0; i < contention.size() && i < max_holders; ++i) {
+    printf("  %10.3f ms %8" PRId64 " contentions %10.3f ms max  %s\n",
+           contention[i].wait_time_us / 1000.0, contention[i].contentions,
+           contention[i].max_wait_time_us / 1000.0,
+           contention[i].holder.c_str());
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
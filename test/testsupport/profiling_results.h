@@ -0,0 +1,44 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_TESTSUPPORT_PROFILING_RESULTS_H_
+#define TEST_TESTSUPPORT_PROFILING_RESULTS_H_
+
+#include <string>
+
+#include "test/testsupport/allocation_counter.h"
+
+namespace webrtc {
+namespace test {
+
+// Measures the heap allocations and the lock contention from its creation
+// until PrintResults() is called, and prints them as perf results next to the
+// other results of a perf test. Lock contention is only measured in builds
+// with rtc_enable_lock_profiling = true, see rtc_base/lock_profiler.h, and
+// the recorded contention is reset on creation, so only one collector should
+// be used at a time.
+class ProfilingResultsCollector {
+ public:
+  ProfilingResultsCollector();
+
+  // Prints the number of allocations and, if lock profiling is enabled, the
+  // number of lock contentions and the time spent waiting for locks, in total
+  // and for the |max_holders| holders that caused the longest wait. All
+  // results use |trace| to be listed with the results of the test.
+  void PrintResults(const std::string& trace, size_t max_holders = 5) const;
+
+ private:
+  const AllocationCounter allocations_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_TESTSUPPORT_PROFILING_RESULTS_H_
@@ -37,9 +37,20 @@ namespace sim_time_impl {
 class SimulatedSequenceRunner : public ProcessThread, public TaskQueueBase {
  public:
   SimulatedSequenceRunner(SimulatedTimeControllerImpl* handler,
+                          int64_t id,
                           absl::string_view queue_name)
-      : handler_(handler), name_(queue_name) {}
-  ~SimulatedSequenceRunner() override { handler_->Unregister(this); }
+      : handler_(handler), id_(id), name_(queue_name) {}
+  ~SimulatedSequenceRunner() override {
+    {
+      rtc::CritScope lock(&lock_);
+      SetNextRunTime(Timestamp::PlusInfinity());
+    }
+    handler_->Unregister(this);
+  }
+
+  // The order in which runners were created, used to run ready runners in a
+  // deterministic order.
+  int64_t id() const { return id_; }
 
   // Provides next run time.
   Timestamp GetNextRunTime() const;
@@ -71,9 +82,13 @@ class SimulatedSequenceRunner : public ProcessThread, public TaskQueueBase {
   void RunReadyTasks(Timestamp at_time) RTC_LOCKS_EXCLUDED(lock_);
   void RunReadyModules(Timestamp at_time) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void UpdateNextRunTime() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Sets |next_run_time_| and tells |handler_| if it changed.
+  void SetNextRunTime(Timestamp next_run_time)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   Timestamp GetNextTime(Module* module, Timestamp at_time);
 
   SimulatedTimeControllerImpl* const handler_;
+  const int64_t id_;
   const std::string name_;
 
   rtc::CriticalSection lock_;
@@ -162,21 +177,28 @@ void SimulatedSequenceRunner::RunReadyModules(Timestamp at_time) {
 
 void SimulatedSequenceRunner::UpdateNextRunTime() {
   if (!ready_tasks_.empty() || !ready_modules_.empty()) {
-    next_run_time_ = Timestamp::MinusInfinity();
+    SetNextRunTime(Timestamp::MinusInfinity());
   } else {
-    next_run_time_ = Timestamp::PlusInfinity();
+    Timestamp next_run_time = Timestamp::PlusInfinity();
     if (!delayed_tasks_.empty())
-      next_run_time_ = std::min(next_run_time_, delayed_tasks_.begin()->first);
+      next_run_time = std::min(next_run_time, delayed_tasks_.begin()->first);
     if (!delayed_modules_.empty())
-      next_run_time_ =
-          std::min(next_run_time_, delayed_modules_.begin()->first);
+      next_run_time = std::min(next_run_time, delayed_modules_.begin()->first);
+    SetNextRunTime(next_run_time);
   }
 }
 
+void SimulatedSequenceRunner::SetNextRunTime(Timestamp next_run_time) {
+  if (next_run_time == next_run_time_)
+    return;
+  handler_->OnNextRunTimeChanged(this, id_, next_run_time_, next_run_time);
+  next_run_time_ = next_run_time;
+}
+
 void SimulatedSequenceRunner::PostTask(std::unique_ptr<QueuedTask> task) {
   rtc::CritScope lock(&lock_);
   ready_tasks_.emplace_back(std::move(task));
-  next_run_time_ = Timestamp::MinusInfinity();
+  SetNextRunTime(Timestamp::MinusInfinity());
 }
 
 void SimulatedSequenceRunner::PostDelayedTask(std::unique_ptr<QueuedTask> task,
@@ -184,7 +206,7 @@ void SimulatedSequenceRunner::PostDelayedTask(std::unique_ptr<QueuedTask> task,
   rtc::CritScope lock(&lock_);
   Timestamp target_time = GetCurrentTime() + TimeDelta::ms(milliseconds);
   delayed_tasks_[target_time].push_back(std::move(task));
-  next_run_time_ = std::min(next_run_time_, target_time);
+  SetNextRunTime(std::min(next_run_time_, target_time));
 }
 
 void SimulatedSequenceRunner::Start() {
@@ -242,7 +264,7 @@ void SimulatedSequenceRunner::WakeUp(Module* module) {
   }
   Timestamp next_time = GetNextTime(module, GetCurrentTime());
   delayed_modules_[next_time].push_back(module);
-  next_run_time_ = std::min(next_run_time_, next_time);
+  SetNextRunTime(std::min(next_run_time_, next_time));
 }
 
 void SimulatedSequenceRunner::RegisterModule(Module* module,
@@ -254,7 +276,7 @@ void SimulatedSequenceRunner::RegisterModule(Module* module,
   } else {
     Timestamp next_time = GetNextTime(module, GetCurrentTime());
     delayed_modules_[next_time].push_back(module);
-    next_run_time_ = std::min(next_run_time_, next_time);
+    SetNextRunTime(std::min(next_run_time_, next_time));
   }
 }
 
@@ -296,9 +318,10 @@ SimulatedTimeControllerImpl::CreateTaskQueue(
     TaskQueueFactory::Priority priority) const {
   // TODO(srte): Remove the const cast when the interface is made mutable.
   auto mutable_this = const_cast<SimulatedTimeControllerImpl*>(this);
-  auto task_queue = std::unique_ptr<SimulatedSequenceRunner, TaskQueueDeleter>(
-      new SimulatedSequenceRunner(mutable_this, name));
   rtc::CritScope lock(&mutable_this->lock_);
+  auto task_queue = std::unique_ptr<SimulatedSequenceRunner, TaskQueueDeleter>(
+      new SimulatedSequenceRunner(mutable_this,
+                                  mutable_this->next_runner_id_++, name));
   mutable_this->runners_.push_back(task_queue.get());
   return task_queue;
 }
@@ -306,8 +329,8 @@ SimulatedTimeControllerImpl::CreateTaskQueue(
 std::unique_ptr<ProcessThread> SimulatedTimeControllerImpl::CreateProcessThread(
     const char* thread_name) {
   rtc::CritScope lock(&lock_);
-  auto process_thread =
-      std::make_unique<SimulatedSequenceRunner>(this, thread_name);
+  auto process_thread = std::make_unique<SimulatedSequenceRunner>(
+      this, next_runner_id_++, thread_name);
   runners_.push_back(process_thread.get());
   return process_thread;
 }
@@ -343,15 +366,26 @@ void SimulatedTimeControllerImpl::RunReadyRunners() {
 
   // We repeat until we have no ready left to handle tasks posted by ready
   // runners.
+  std::vector<SimulatedSequenceRunner*> ready;
   while (true) {
-    for (auto* runner : runners_) {
-      if (yielded_.find(runner) == yielded_.end() &&
-          runner->GetNextRunTime() <= current_time) {
-        ready_runners_.push_back(runner);
+    {
+      rtc::CritScope run_times_lock(&run_times_lock_);
+      for (const RunTimeKey& key : run_times_) {
+        if (current_time < std::get<0>(key))
+          break;
+        if (yielded_.find(std::get<2>(key)) == yielded_.end())
+          ready.push_back(std::get<2>(key));
       }
     }
-    if (ready_runners_.empty())
+    if (ready.empty())
       return;
+    // Run in the order the runners were created, as when all were visited.
+    std::sort(ready.begin(), ready.end(),
+              [](SimulatedSequenceRunner* a, SimulatedSequenceRunner* b) {
+                return a->id() < b->id();
+              });
+    ready_runners_.assign(ready.begin(), ready.end());
+    ready.clear();
     while (!ready_runners_.empty()) {
       auto* runner = ready_runners_.front();
       ready_runners_.pop_front();
@@ -371,15 +405,10 @@ Timestamp SimulatedTimeControllerImpl::CurrentTime() const {
 
 Timestamp SimulatedTimeControllerImpl::NextRunTime() const {
   Timestamp current_time = CurrentTime();
-  Timestamp next_time = Timestamp::PlusInfinity();
-  rtc::CritScope lock(&lock_);
-  for (auto* runner : runners_) {
-    Timestamp next_run_time = runner->GetNextRunTime();
-    if (next_run_time <= current_time)
-      return current_time;
-    next_time = std::min(next_time, next_run_time);
-  }
-  return next_time;
+  rtc::CritScope lock(&run_times_lock_);
+  if (run_times_.empty())
+    return Timestamp::PlusInfinity();
+  return std::max(current_time, std::get<0>(*run_times_.begin()));
 }
 
 void SimulatedTimeControllerImpl::AdvanceTime(Timestamp target_time) {
@@ -395,6 +424,18 @@ void SimulatedTimeControllerImpl::Unregister(SimulatedSequenceRunner* runner) {
   RemoveByValue(ready_runners_, runner);
 }
 
+void SimulatedTimeControllerImpl::OnNextRunTimeChanged(
+    SimulatedSequenceRunner* runner,
+    int64_t runner_id,
+    Timestamp previous,
+    Timestamp next) {
+  rtc::CritScope lock(&run_times_lock_);
+  if (!previous.IsPlusInfinity())
+    run_times_.erase(RunTimeKey(previous, runner_id, runner));
+  if (!next.IsPlusInfinity())
+    run_times_.insert(RunTimeKey(next, runner_id, runner));
+}
+
 }  // namespace sim_time_impl
 
 GlobalSimulatedTimeController::GlobalSimulatedTimeController(
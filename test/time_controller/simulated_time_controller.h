@@ -12,6 +12,8 @@
 
 #include <list>
 #include <memory>
+#include <set>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -58,6 +60,12 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
   void AdvanceTime(Timestamp target_time);
   // Removes |runner| from |runners_|.
   void Unregister(SimulatedSequenceRunner* runner);
+  // Called by |runner| when its next run time changes from |previous| to
+  // |next|, with the lock of the runner held.
+  void OnNextRunTimeChanged(SimulatedSequenceRunner* runner,
+                            int64_t runner_id,
+                            Timestamp previous,
+                            Timestamp next);
 
  private:
   const rtc::PlatformThreadId thread_id_;
@@ -73,6 +81,15 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
 
   // Task queues on which YieldExecution has been called.
   std::unordered_set<TaskQueueBase*> yielded_ RTC_GUARDED_BY(thread_checker_);
+
+  // The runners with anything to run, ordered by their next run time and then
+  // by the order in which they were created, so that finding the ready
+  // runners and the next time to advance to doesn't visit the idle ones.
+  // Never held while calling into a runner.
+  using RunTimeKey = std::tuple<Timestamp, int64_t, SimulatedSequenceRunner*>;
+  rtc::CriticalSection run_times_lock_;
+  std::set<RunTimeKey> run_times_ RTC_GUARDED_BY(run_times_lock_);
+  int64_t next_runner_id_ RTC_GUARDED_BY(lock_) = 0;
 };
 }  // namespace sim_time_impl
 
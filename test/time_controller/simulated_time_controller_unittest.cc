@@ -12,6 +12,8 @@
 
 #include <atomic>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "rtc_base/task_queue.h"
 #include "rtc_base/task_utils/repeating_task.h"
@@ -76,6 +78,32 @@ TEST(SimulatedTimeControllerTest, TaskCanStopItself) {
   time_simulation.Sleep(TimeDelta::ms(10));
   EXPECT_EQ(counter.load(), 1);
 }
+TEST(SimulatedTimeControllerTest, RunsDelayedTasksOfManyQueuesInOrder) {
+  GlobalSimulatedTimeController time_simulation(kStartTime);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> task_queues;
+  for (int i = 0; i < 100; ++i) {
+    task_queues.push_back(std::make_unique<rtc::TaskQueue>(
+        time_simulation.GetTaskQueueFactory()->CreateTaskQueue(
+            "TestQueue", TaskQueueFactory::Priority::NORMAL)));
+  }
+  std::vector<std::pair<int64_t, int>> runs;
+  // Post in reverse order, with the due times interleaved between the queues.
+  for (int i = 99; i >= 0; --i) {
+    task_queues[i]->PostDelayedTask(
+        [&, i] { runs.emplace_back(rtc::TimeMillis(), i); }, 10 * (i % 3));
+  }
+  time_simulation.Sleep(TimeDelta::ms(100));
+
+  ASSERT_EQ(runs.size(), 100u);
+  for (size_t i = 1; i < runs.size(); ++i) {
+    // Ordered by due time, and by the order the queues were created in.
+    EXPECT_LE(runs[i - 1].first, runs[i].first);
+    if (runs[i - 1].first == runs[i].first)
+      EXPECT_LT(runs[i - 1].second, runs[i].second);
+  }
+  EXPECT_EQ(runs.back().first, kStartTime.ms() + 20);
+}
+
 TEST(SimulatedTimeControllerTest, Example) {
   class ObjectOnTaskQueue {
    public:
@@ -12,6 +12,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include "modules/video_capture/video_capture_factory.h"
@@ -27,14 +29,13 @@ bool VcmCapturer::Init(size_t width,
                        size_t height,
                        size_t target_fps,
                        size_t capture_device_index) {
-  std::unique_ptr<VideoCaptureModule::DeviceInfo> device_info(
-      VideoCaptureFactory::CreateDeviceInfo());
+  device_info_.reset(VideoCaptureFactory::CreateDeviceInfo());
 
   char device_name[256];
   char unique_name[256];
-  if (device_info->GetDeviceName(static_cast<uint32_t>(capture_device_index),
-                                 device_name, sizeof(device_name), unique_name,
-                                 sizeof(unique_name)) != 0) {
+  if (device_info_->GetDeviceName(static_cast<uint32_t>(capture_device_index),
+                                  device_name, sizeof(device_name), unique_name,
+                                  sizeof(unique_name)) != 0) {
     Destroy();
     return false;
   }
@@ -45,12 +46,16 @@ bool VcmCapturer::Init(size_t width,
   }
   vcm_->RegisterCaptureDataCallback(this);
 
-  device_info->GetCapability(vcm_->CurrentDeviceName(), 0, capability_);
+  rtc::CritScope lock(&lock_);
+  device_info_->GetCapability(vcm_->CurrentDeviceName(), 0, capability_);
 
   capability_.width = static_cast<int32_t>(width);
   capability_.height = static_cast<int32_t>(height);
   capability_.maxFPS = static_cast<int32_t>(target_fps);
   capability_.videoType = VideoType::kI420;
+  max_capability_ = capability_;
+  device_info_->GetBestMatchedCapability(vcm_->CurrentDeviceName(),
+                                         capability_, matched_capability_);
 
   if (vcm_->StartCapture(capability_) != 0) {
     Destroy();
@@ -77,6 +82,7 @@ VcmCapturer* VcmCapturer::Create(size_t width,
 }
 
 void VcmCapturer::Destroy() {
+  rtc::CritScope lock(&lock_);
   if (!vcm_)
     return;
 
@@ -94,5 +100,45 @@ void VcmCapturer::OnFrame(const VideoFrame& frame) {
   TestVideoCapturer::OnFrame(frame);
 }
 
+void VcmCapturer::OnSinkWantsChanged(const rtc::VideoSinkWants& wants) {
+  rtc::CritScope lock(&lock_);
+  if (!vcm_)
+    return;
+
+  VideoCaptureCapability requested = max_capability_;
+  const int max_pixels = max_capability_.width * max_capability_.height;
+  int pixels = std::min(max_pixels, wants.max_pixel_count);
+  if (wants.target_pixel_count)
+    pixels = std::min(pixels, *wants.target_pixel_count);
+  if (pixels < max_pixels) {
+    const double scale = std::sqrt(static_cast<double>(pixels) / max_pixels);
+    requested.width = static_cast<int32_t>(max_capability_.width * scale);
+    requested.height = static_cast<int32_t>(max_capability_.height * scale);
+  }
+  requested.maxFPS = std::min(max_capability_.maxFPS,
+                              static_cast<int32_t>(wants.max_framerate_fps));
+
+  // Restarting the device drops frames, so only do it when the wants move to
+  // another device mode. The video adapter scales the rest of the way.
+  VideoCaptureCapability matched;
+  if (device_info_->GetBestMatchedCapability(vcm_->CurrentDeviceName(),
+                                             requested, matched) < 0 ||
+      matched == matched_capability_) {
+    return;
+  }
+
+  vcm_->StopCapture();
+  if (vcm_->StartCapture(requested) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to restart capture at " << requested.width
+                        << "x" << requested.height << "@" << requested.maxFPS
+                        << ", keeping " << capability_.width << "x"
+                        << capability_.height << "@" << capability_.maxFPS;
+    vcm_->StartCapture(capability_);
+    return;
+  }
+  capability_ = requested;
+  matched_capability_ = matched;
+}
+
 }  // namespace test
 }  // namespace webrtc
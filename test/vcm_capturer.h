@@ -15,6 +15,7 @@
 
 #include "api/scoped_refptr.h"
 #include "modules/video_capture/video_capture.h"
+#include "rtc_base/critical_section.h"
 #include "test/test_video_capturer.h"
 
 namespace webrtc {
@@ -31,6 +32,11 @@ class VcmCapturer : public TestVideoCapturer,
 
   void OnFrame(const VideoFrame& frame) override;
 
+ protected:
+  // Restarts the capture in a smaller or slower device mode when the sinks
+  // ask for less than the configured resolution or frame rate.
+  void OnSinkWantsChanged(const rtc::VideoSinkWants& wants) override;
+
  private:
   VcmCapturer();
   bool Init(size_t width,
@@ -39,8 +45,14 @@ class VcmCapturer : public TestVideoCapturer,
             size_t capture_device_index);
   void Destroy();
 
+  rtc::CriticalSection lock_;
+  std::unique_ptr<VideoCaptureModule::DeviceInfo> device_info_;
   rtc::scoped_refptr<VideoCaptureModule> vcm_;
-  VideoCaptureCapability capability_;
+  // The capability given to Create(), which is never exceeded.
+  VideoCaptureCapability max_capability_;
+  VideoCaptureCapability capability_ RTC_GUARDED_BY(lock_);
+  // The device mode that |capability_| is matched to.
+  VideoCaptureCapability matched_capability_ RTC_GUARDED_BY(lock_);
 };
 
 }  // namespace test
@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <deque>
+#include <map>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+class DecodeThreadPool::PooledTaskQueue : public TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(DecodeThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override {
+    RTC_DCHECK(!IsCurrent());
+    pool_->DeleteTaskQueue(this);
+  }
+
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    pool_->PostTask(this, std::move(task), 0);
+  }
+
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    pool_->PostTask(this, std::move(task), milliseconds);
+  }
+
+  void RunTask(std::unique_ptr<QueuedTask> task) {
+    CurrentTaskQueueSetter set_current(this);
+    if (!task->Run())
+      task.release();
+  }
+
+  DecodeThreadPool* const pool_;
+  // The members below are guarded by |pool_->crit_|.
+  int64_t priority_ = 0;
+  // The value of |pool_->num_tasks_started_| when the last task started.
+  uint64_t last_task_started_ = 0;
+  bool running_ = false;
+  bool deleted_ = false;
+  std::deque<std::unique_ptr<QueuedTask>> ready_tasks_;
+  // Keyed on the time to run; equal keys keep the order they were posted in.
+  std::multimap<int64_t, std::unique_ptr<QueuedTask>> delayed_tasks_;
+  // Signaled by the worker when a running task has finished after Delete().
+  rtc::Event task_finished_;
+
+ private:
+  ~PooledTaskQueue() override = default;
+  friend class DecodeThreadPool;
+};
+
+DecodeThreadPool::DecodeThreadPool(int num_threads,
+                                   const std::string& thread_name) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(std::make_unique<rtc::PlatformThread>(
+        &DecodeThreadPool::RunWorker, this,
+        thread_name + std::to_string(i), rtc::kHighPriority));
+    threads_.back()->Start();
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(task_queues_.empty());
+    stopping_ = true;
+  }
+  wake_up_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateTaskQueue() {
+  PooledTaskQueue* task_queue = new PooledTaskQueue(this);
+  rtc::CritScope lock(&crit_);
+  task_queues_.push_back(task_queue);
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(task_queue);
+}
+
+void DecodeThreadPool::SetPriority(TaskQueueBase* task_queue,
+                                   int64_t priority) {
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(absl::c_linear_search(task_queues_, task_queue));
+  static_cast<PooledTaskQueue*>(task_queue)->priority_ = priority;
+}
+
+void DecodeThreadPool::RunWorker(void* obj) {
+  static_cast<DecodeThreadPool*>(obj)->ProcessTasks();
+}
+
+void DecodeThreadPool::ProcessTasks() {
+  while (true) {
+    PooledTaskQueue* task_queue = nullptr;
+    std::unique_ptr<QueuedTask> task;
+    int wait_ms = rtc::Event::kForever;
+    bool more_tasks_ready = false;
+    {
+      rtc::CritScope lock(&crit_);
+      if (stopping_)
+        break;
+      const int64_t now_ms = rtc::TimeMillis();
+      for (PooledTaskQueue* candidate : task_queues_) {
+        auto& delayed_tasks = candidate->delayed_tasks_;
+        while (!delayed_tasks.empty() &&
+               delayed_tasks.begin()->first <= now_ms) {
+          candidate->ready_tasks_.push_back(
+              std::move(delayed_tasks.begin()->second));
+          delayed_tasks.erase(delayed_tasks.begin());
+        }
+        if (!delayed_tasks.empty()) {
+          const int64_t delay_ms = delayed_tasks.begin()->first - now_ms;
+          if (wait_ms == rtc::Event::kForever || delay_ms < wait_ms)
+            wait_ms = static_cast<int>(delay_ms);
+        }
+        if (candidate->running_ || candidate->ready_tasks_.empty())
+          continue;
+        if (!task_queue || candidate->priority_ > task_queue->priority_ ||
+            (candidate->priority_ == task_queue->priority_ &&
+             candidate->last_task_started_ < task_queue->last_task_started_)) {
+          more_tasks_ready |= task_queue != nullptr;
+          task_queue = candidate;
+        } else {
+          more_tasks_ready = true;
+        }
+      }
+      if (task_queue) {
+        task = std::move(task_queue->ready_tasks_.front());
+        task_queue->ready_tasks_.pop_front();
+        task_queue->running_ = true;
+        task_queue->last_task_started_ = ++num_tasks_started_;
+      }
+    }
+
+    if (!task) {
+      wake_up_.Wait(wait_ms);
+      continue;
+    }
+    // Let another thread pick up the tasks of the other queues.
+    if (more_tasks_ready)
+      wake_up_.Set();
+    task_queue->RunTask(std::move(task));
+
+    rtc::CritScope lock(&crit_);
+    task_queue->running_ = false;
+    if (task_queue->deleted_) {
+      task_queue->task_finished_.Set();
+    } else if (!task_queue->ready_tasks_.empty()) {
+      wake_up_.Set();
+    }
+  }
+  // Pass the stop signal on to the next thread.
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::PostTask(PooledTaskQueue* task_queue,
+                                std::unique_ptr<QueuedTask> task,
+                                uint32_t delay_ms) {
+  {
+    rtc::CritScope lock(&crit_);
+    // Tasks posted by a running task after Delete() are dropped, outside of
+    // the lock.
+    if (task_queue->deleted_)
+      return;
+    if (delay_ms == 0) {
+      task_queue->ready_tasks_.push_back(std::move(task));
+    } else {
+      task_queue->delayed_tasks_.emplace(rtc::TimeMillis() + delay_ms,
+                                         std::move(task));
+    }
+  }
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::DeleteTaskQueue(PooledTaskQueue* task_queue) {
+  bool running;
+  {
+    rtc::CritScope lock(&crit_);
+    task_queues_.erase(absl::c_find(task_queues_, task_queue));
+    task_queue->deleted_ = true;
+    running = task_queue->running_;
+  }
+  if (running)
+    task_queue->task_finished_.Wait(rtc::Event::kForever);
+  // The pending tasks are destroyed with the queue.
+  delete task_queue;
+}
+
+}  // namespace webrtc
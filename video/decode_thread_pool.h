@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the decode queues of many receive streams on a fixed number of
+// threads, instead of on one thread per stream. The task queues created by
+// CreateTaskQueue() behave like any other task queue: their tasks run in
+// order and never on two threads at once. When the tasks of several queues
+// are ready, the queue with the highest priority runs first, and queues of
+// equal priority take turns. Besides decoding, it also runs the render
+// queues of the receive streams, on a pool of its own.
+class DecodeThreadPool {
+ public:
+  // The threads are named |thread_name| followed by their index.
+  explicit DecodeThreadPool(int num_threads,
+                            const std::string& thread_name = "DecodeThread");
+  // All task queues must have been deleted.
+  ~DecodeThreadPool();
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue();
+
+  // Sets the priority of a task queue created by this pool, e.g. to the
+  // number of pixels the stream decodes. The initial priority is 0.
+  void SetPriority(TaskQueueBase* task_queue, int64_t priority);
+
+ private:
+  class PooledTaskQueue;
+
+  static void RunWorker(void* obj);
+  void ProcessTasks();
+
+  void PostTask(PooledTaskQueue* task_queue,
+                std::unique_ptr<QueuedTask> task,
+                uint32_t delay_ms);
+  void DeleteTaskQueue(PooledTaskQueue* task_queue);
+
+  rtc::CriticalSection crit_;
+  // Signaled when there may be a task to run, or when stopping.
+  rtc::Event wake_up_;
+  bool stopping_ RTC_GUARDED_BY(crit_) = false;
+  // Counts the tasks started, for taking turns between task queues.
+  uint64_t num_tasks_started_ RTC_GUARDED_BY(crit_) = 0;
+  std::vector<PooledTaskQueue*> task_queues_ RTC_GUARDED_BY(crit_);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWaitMs = 5000;
+
+TEST(DecodeThreadPoolTest, RunsTasksOfEachQueueInOrder) {
+  constexpr int kNumQueues = 8;
+  constexpr int kNumTasks = 100;
+  DecodeThreadPool pool(/*num_threads=*/3);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> queues;
+  std::vector<std::vector<int>> results(kNumQueues);
+  std::atomic<int> num_running[kNumQueues] = {};
+  std::atomic<bool> overlapped{false};
+  rtc::Event done;
+  std::atomic<int> num_done{0};
+  for (int i = 0; i < kNumQueues; ++i)
+    queues.push_back(std::make_unique<rtc::TaskQueue>(pool.CreateTaskQueue()));
+  for (int task = 0; task < kNumTasks; ++task) {
+    for (int i = 0; i < kNumQueues; ++i) {
+      queues[i]->PostTask([&, i, task] {
+        EXPECT_TRUE(queues[i]->IsCurrent());
+        // Tasks of one queue must never run at the same time.
+        if (++num_running[i] > 1)
+          overlapped = true;
+        results[i].push_back(task);
+        --num_running[i];
+        if (task == kNumTasks - 1 && ++num_done == kNumQueues)
+          done.Set();
+      });
+    }
+  }
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_FALSE(overlapped);
+  for (const std::vector<int>& result : results) {
+    ASSERT_EQ(static_cast<size_t>(kNumTasks), result.size());
+    for (int task = 0; task < kNumTasks; ++task)
+      EXPECT_EQ(task, result[task]);
+  }
+}
+
+TEST(DecodeThreadPoolTest, RunsHigherPriorityQueueFirst) {
+  DecodeThreadPool pool(/*num_threads=*/1);
+  rtc::TaskQueue low(pool.CreateTaskQueue());
+  rtc::TaskQueue high(pool.CreateTaskQueue());
+  pool.SetPriority(high.Get(), 640 * 360);
+  pool.SetPriority(low.Get(), 320 * 180);
+
+  // Keep the only thread busy while both queues get a task.
+  rtc::Event blocked;
+  rtc::Event unblock;
+  low.PostTask([&] {
+    blocked.Set();
+    unblock.Wait(kWaitMs);
+  });
+  ASSERT_TRUE(blocked.Wait(kWaitMs));
+  rtc::CriticalSection crit;
+  std::vector<int> order;
+  rtc::Event done;
+  low.PostTask([&] {
+    rtc::CritScope lock(&crit);
+    order.push_back(0);
+    done.Set();
+  });
+  high.PostTask([&] {
+    rtc::CritScope lock(&crit);
+    order.push_back(1);
+  });
+  unblock.Set();
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  rtc::CritScope lock(&crit);
+  EXPECT_EQ(std::vector<int>({1, 0}), order);
+}
+
+TEST(DecodeThreadPoolTest, RunsDelayedTasks) {
+  constexpr uint32_t kDelayMs = 50;
+  DecodeThreadPool pool(/*num_threads=*/2);
+  rtc::TaskQueue queue(pool.CreateTaskQueue());
+  rtc::Event done;
+  const int64_t start_ms = rtc::TimeMillis();
+  int64_t run_ms = 0;
+  queue.PostDelayedTask(
+      [&] {
+        run_ms = rtc::TimeMillis();
+        done.Set();
+      },
+      kDelayMs);
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_GE(run_ms - start_ms, kDelayMs);
+}
+
+TEST(DecodeThreadPoolTest, DeleteWaitsForRunningTaskAndDropsPendingTasks) {
+  DecodeThreadPool pool(/*num_threads=*/2);
+  auto queue = std::make_unique<rtc::TaskQueue>(pool.CreateTaskQueue());
+  rtc::Event started;
+  std::atomic<bool> finished{false};
+  std::atomic<bool> pending_task_ran{false};
+  queue->PostTask([&] {
+    started.Set();
+    SleepMs(50);
+    finished = true;
+  });
+  queue->PostTask([&] { pending_task_ran = true; });
+  queue->PostDelayedTask([&] { pending_task_ran = true; }, 10);
+  ASSERT_TRUE(started.Wait(kWaitMs));
+  queue.reset();
+  EXPECT_TRUE(finished);
+  SleepMs(50);
+  EXPECT_FALSE(pending_task_ran);
+}
+
+}  // namespace
+}  // namespace webrtc
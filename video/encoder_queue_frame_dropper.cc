@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoder_queue_frame_dropper.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+constexpr size_t kEncodeDurationWindowSize = 30;
+constexpr size_t kMinEncodeDurations = 5;
+constexpr float kEncodeDurationPercentile = 0.9f;
+}  // namespace
+
+EncoderQueueFrameDropper::EncoderQueueFrameDropper(int max_latency_ms)
+    : max_latency_us_(max_latency_ms * rtc::kNumMicrosecsPerMillisec),
+      encode_duration_filter_(kEncodeDurationPercentile) {
+  RTC_DCHECK_GT(max_latency_ms, 0);
+}
+
+EncoderQueueFrameDropper::~EncoderQueueFrameDropper() = default;
+
+bool EncoderQueueFrameDropper::DropFrame(int64_t queue_time_us) {
+  ++stats_.num_frames;
+  bool drop = false;
+  if (!last_frame_dropped_ &&
+      encode_durations_us_.size() >= kMinEncodeDurations) {
+    const int64_t encode_duration_us =
+        encode_duration_filter_.GetPercentileValue();
+    drop = encode_duration_us < max_latency_us_ &&
+           queue_time_us + encode_duration_us > max_latency_us_;
+  }
+  last_frame_dropped_ = drop;
+  if (drop) {
+    ++stats_.num_dropped_frames;
+  } else {
+    queue_time_ms_.Add(
+        static_cast<int>(queue_time_us / rtc::kNumMicrosecsPerMillisec));
+  }
+  return drop;
+}
+
+void EncoderQueueFrameDropper::OnFrameEncoded(int64_t encode_duration_us) {
+  encode_durations_us_.push_back(encode_duration_us);
+  encode_duration_filter_.Insert(encode_duration_us);
+  if (encode_durations_us_.size() > kEncodeDurationWindowSize) {
+    encode_duration_filter_.Erase(encode_durations_us_.front());
+    encode_durations_us_.pop_front();
+  }
+}
+
+EncoderQueueFrameDropper::Stats EncoderQueueFrameDropper::GetAndResetStats() {
+  Stats stats = stats_;
+  stats.avg_queue_time_ms = queue_time_ms_.Avg(1);
+  stats.max_queue_time_ms = queue_time_ms_.Max();
+  stats_ = Stats();
+  queue_time_ms_.Reset();
+  return stats;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ENCODER_QUEUE_FRAME_DROPPER_H_
+#define VIDEO_ENCODER_QUEUE_FRAME_DROPPER_H_
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "absl/types/optional.h"
+#include "rtc_base/numerics/percentile_filter.h"
+#include "rtc_base/numerics/sample_counter.h"
+
+namespace webrtc {
+
+// Decides which frames to drop when they reach the head of the encoder queue,
+// before they are converted, scaled or encoded, so that the time from posting
+// a frame to the queue until it has been encoded stays below a target. The
+// encode time of a frame is predicted as the 90th percentile of the recent
+// encode times. A frame is never dropped right after another dropped frame,
+// and not at all while the encode time alone is above the target, since
+// dropping frames can then not bring the latency down.
+class EncoderQueueFrameDropper {
+ public:
+  struct Stats {
+    int num_frames = 0;
+    int num_dropped_frames = 0;
+    // Time spent in the encoder queue by the frames passed to the encoder.
+    absl::optional<int> avg_queue_time_ms;
+    absl::optional<int> max_queue_time_ms;
+  };
+
+  explicit EncoderQueueFrameDropper(int max_latency_ms);
+  ~EncoderQueueFrameDropper();
+
+  // Returns true if a frame that has waited |queue_time_us| in the encoder
+  // queue should be dropped.
+  bool DropFrame(int64_t queue_time_us);
+
+  void OnFrameEncoded(int64_t encode_duration_us);
+
+  // Returns the stats since the previous call.
+  Stats GetAndResetStats();
+
+ private:
+  const int64_t max_latency_us_;
+  std::deque<int64_t> encode_durations_us_;
+  PercentileFilter<int64_t> encode_duration_filter_;
+  bool last_frame_dropped_ = false;
+  Stats stats_;
+  rtc::SampleCounter queue_time_ms_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ENCODER_QUEUE_FRAME_DROPPER_H_
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoder_queue_frame_dropper.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kMaxLatencyMs = 100;
+constexpr int64_t kEncodeDurationUs = 20000;
+
+void EncodeFrames(EncoderQueueFrameDropper* dropper,
+                  int num_frames,
+                  int64_t encode_duration_us) {
+  for (int i = 0; i < num_frames; ++i)
+    dropper->OnFrameEncoded(encode_duration_us);
+}
+
+TEST(EncoderQueueFrameDropperTest, DoesNotDropBeforeEnoughEncodeDurations) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 4, kEncodeDurationUs);
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/200000));
+}
+
+TEST(EncoderQueueFrameDropperTest, DropsFrameThatWouldBeEncodedTooLate) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 10, kEncodeDurationUs);
+  // 70 ms + 20 ms is within the target, 90 ms + 20 ms is not.
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/70000));
+  EXPECT_TRUE(dropper.DropFrame(/*queue_time_us=*/90000));
+}
+
+TEST(EncoderQueueFrameDropperTest, NeverDropsTwoFramesInARow) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 10, kEncodeDurationUs);
+  EXPECT_TRUE(dropper.DropFrame(/*queue_time_us=*/90000));
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/90000));
+  EXPECT_TRUE(dropper.DropFrame(/*queue_time_us=*/90000));
+}
+
+TEST(EncoderQueueFrameDropperTest, DoesNotDropWhenEncodeTimeExceedsTarget) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 10, /*encode_duration_us=*/150000);
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/50000));
+}
+
+TEST(EncoderQueueFrameDropperTest, PredictsFromRecentEncodeDurations) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 30, /*encode_duration_us=*/60000);
+  EXPECT_TRUE(dropper.DropFrame(/*queue_time_us=*/50000));
+  // The slow encodes are pushed out of the window.
+  EncodeFrames(&dropper, 30, /*encode_duration_us=*/5000);
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/50000));
+}
+
+TEST(EncoderQueueFrameDropperTest, ReportsAndResetsStats) {
+  EncoderQueueFrameDropper dropper(kMaxLatencyMs);
+  EncodeFrames(&dropper, 10, kEncodeDurationUs);
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/10000));
+  EXPECT_FALSE(dropper.DropFrame(/*queue_time_us=*/30000));
+  EXPECT_TRUE(dropper.DropFrame(/*queue_time_us=*/95000));
+
+  EncoderQueueFrameDropper::Stats stats = dropper.GetAndResetStats();
+  EXPECT_EQ(3, stats.num_frames);
+  EXPECT_EQ(1, stats.num_dropped_frames);
+  EXPECT_EQ(20, stats.avg_queue_time_ms);
+  EXPECT_EQ(30, stats.max_queue_time_ms);
+
+  stats = dropper.GetAndResetStats();
+  EXPECT_EQ(0, stats.num_frames);
+  EXPECT_EQ(0, stats.num_dropped_frames);
+  EXPECT_FALSE(stats.avg_queue_time_ms);
+  EXPECT_FALSE(stats.max_queue_time_ms);
+}
+
+}  // namespace
+}  // namespace webrtc
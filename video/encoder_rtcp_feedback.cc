@@ -21,13 +21,16 @@ namespace {
 constexpr int kMinKeyframeSendIntervalMs = 300;
 }  // namespace
 
-EncoderRtcpFeedback::EncoderRtcpFeedback(Clock* clock,
-                                         const std::vector<uint32_t>& ssrcs,
-                                         VideoStreamEncoderInterface* encoder)
+EncoderRtcpFeedback::EncoderRtcpFeedback(
+    Clock* clock,
+    const std::vector<uint32_t>& ssrcs,
+    VideoStreamEncoderInterface* encoder,
+    VideoSendStream::KeyFrameRequestObserver* key_frame_request_observer)
     : clock_(clock),
       ssrcs_(ssrcs),
       rtp_video_sender_(nullptr),
       video_stream_encoder_(encoder),
+      key_frame_request_observer_(key_frame_request_observer),
       time_last_intra_request_ms_(-1),
       min_keyframe_send_interval_ms_(
           KeyframeIntervalSettings::ParseFromFieldTrials()
@@ -65,6 +68,8 @@ void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
 
   // Always produce key frame for all streams.
   video_stream_encoder_->SendKeyFrame();
+  if (key_frame_request_observer_)
+    key_frame_request_observer_->OnKeyFrameRequested();
 }
 
 void EncoderRtcpFeedback::OnKeyFrameRequested(uint64_t channel_id) {
@@ -75,6 +80,8 @@ void EncoderRtcpFeedback::OnKeyFrameRequested(uint64_t channel_id) {
   }
 
   video_stream_encoder_->SendKeyFrame();
+  if (key_frame_request_observer_)
+    key_frame_request_observer_->OnKeyFrameRequested();
 }
 
 void EncoderRtcpFeedback::OnReceivedLossNotification(
@@ -15,6 +15,7 @@
 #include "api/transport/media/media_transport_interface.h"
 #include "api/video/video_stream_encoder_interface.h"
 #include "call/rtp_video_sender_interface.h"
+#include "call/video_send_stream.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/critical_section.h"
 #include "system_wrappers/include/clock.h"
@@ -31,9 +32,13 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
                             public RtcpLossNotificationObserver,
                             public MediaTransportKeyFrameRequestCallback {
  public:
-  EncoderRtcpFeedback(Clock* clock,
-                      const std::vector<uint32_t>& ssrcs,
-                      VideoStreamEncoderInterface* encoder);
+  // |key_frame_request_observer| is optional, and notified of the key frame
+  // requests passed on to |encoder|.
+  EncoderRtcpFeedback(
+      Clock* clock,
+      const std::vector<uint32_t>& ssrcs,
+      VideoStreamEncoderInterface* encoder,
+      VideoSendStream::KeyFrameRequestObserver* key_frame_request_observer);
   ~EncoderRtcpFeedback() override = default;
 
   void SetRtpVideoSender(const RtpVideoSenderInterface* rtp_video_sender);
@@ -56,6 +61,7 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
   const std::vector<uint32_t> ssrcs_;
   const RtpVideoSenderInterface* rtp_video_sender_;
   VideoStreamEncoderInterface* const video_stream_encoder_;
+  VideoSendStream::KeyFrameRequestObserver* const key_frame_request_observer_;
 
   rtc::CriticalSection crit_;
   int64_t time_last_intra_request_ms_ RTC_GUARDED_BY(crit_);
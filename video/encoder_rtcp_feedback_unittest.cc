@@ -26,7 +26,8 @@ class VieKeyRequestTest : public ::testing::Test {
         encoder_rtcp_feedback_(
             &simulated_clock_,
             std::vector<uint32_t>(1, VieKeyRequestTest::kSsrc),
-            &encoder_) {}
+            &encoder_,
+            /*key_frame_request_observer=*/nullptr) {}
 
  protected:
   const uint32_t kSsrc = 1234;
@@ -60,4 +61,23 @@ TEST_F(VieKeyRequestTest, TriggerRequestFromMediaTransport) {
   encoder_rtcp_feedback_.OnKeyFrameRequested(kSsrc);
 }
 
+class MockKeyFrameRequestObserver
+    : public VideoSendStream::KeyFrameRequestObserver {
+ public:
+  MOCK_METHOD0(OnKeyFrameRequested, void());
+};
+
+TEST(EncoderRtcpFeedbackTest, NotifiesKeyFrameRequestObserver) {
+  constexpr uint32_t kSsrc = 1234;
+  SimulatedClock clock(123456789);
+  ::testing::NiceMock<MockVideoStreamEncoder> encoder;
+  MockKeyFrameRequestObserver observer;
+  EncoderRtcpFeedback encoder_rtcp_feedback(
+      &clock, std::vector<uint32_t>(1, kSsrc), &encoder, &observer);
+
+  EXPECT_CALL(observer, OnKeyFrameRequested()).Times(2);
+  encoder_rtcp_feedback.OnReceivedIntraFrameRequest(kSsrc);
+  encoder_rtcp_feedback.OnKeyFrameRequested(kSsrc);
+}
+
 }  // namespace webrtc
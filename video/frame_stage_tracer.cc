@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_stage_tracer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+constexpr char kFrameStageTracingFieldTrial[] = "WebRTC-VideoFrameStageTracing";
+constexpr int kMinRequiredSamples = 200;
+constexpr uint32_t kLongTailBoundaryMs = 1000;
+constexpr float kTailPercentile = 0.99f;
+
+// Names of the time spent before each stage, nullptr for the stages that
+// start a pipeline.
+constexpr const char* kStageNames[] = {
+    nullptr,             // kCaptured
+    "CaptureToEncoder",  // kEncoderQueued
+    "EncoderQueue",      // kEncoderDequeued
+    "PreEncode",         // kEncodeStarted
+    "Encode",            // kEncoded
+    nullptr,             // kFirstPacketReceived
+    "FrameReception",    // kLastPacketReceived
+    "FrameAssembly",     // kFrameCompleted
+    "JitterBuffer",      // kDecodeQueued
+    "DecodeQueue",       // kDecodeStarted
+    "Decode",            // kDecoded
+    "RenderSmoothing",   // kRendered
+};
+static_assert(sizeof(kStageNames) / sizeof(kStageNames[0]) ==
+                  FrameStageTracer::kNumStages,
+              "Every stage needs a name.");
+}  // namespace
+
+constexpr size_t FrameStageTracer::kNumStages;
+constexpr size_t FrameStageTracer::kMaxFramesInFlight;
+constexpr size_t FrameStageTracer::kMaxRecentFrames;
+
+std::unique_ptr<FrameStageTracer> FrameStageTracer::CreateIfEnabled(
+    Clock* clock,
+    Stage last_stage) {
+  if (!field_trial::IsEnabled(kFrameStageTracingFieldTrial))
+    return nullptr;
+  return std::make_unique<FrameStageTracer>(clock, last_stage);
+}
+
+FrameStageTracer::FrameStageTracer(Clock* clock, Stage last_stage)
+    : clock_(clock),
+      last_stage_(last_stage),
+      stage_ms_percentiles_(
+          kNumStages,
+          rtc::HistogramPercentileCounter(kLongTailBoundaryMs)) {
+  RTC_DCHECK(last_stage != Stage::kNumStages);
+}
+
+FrameStageTracer::~FrameStageTracer() {
+  rtc::CritScope lock(&crit_);
+  UpdateHistograms();
+}
+
+void FrameStageTracer::OnStage(uint32_t rtp_timestamp, Stage stage) {
+  OnStage(rtp_timestamp, stage, clock_->TimeInMicroseconds());
+}
+
+void FrameStageTracer::OnStage(uint32_t rtp_timestamp,
+                               Stage stage,
+                               int64_t time_us) {
+  rtc::CritScope lock(&crit_);
+  // Stages are mostly reported for the latest frames.
+  auto it = frames_in_flight_.rbegin();
+  while (it != frames_in_flight_.rend() && it->rtp_timestamp != rtp_timestamp)
+    ++it;
+  if (it == frames_in_flight_.rend()) {
+    // E.g. a later simulcast stream of a frame that is already complete.
+    if (stage == last_stage_)
+      return;
+    if (frames_in_flight_.size() == kMaxFramesInFlight)
+      frames_in_flight_.pop_front();
+    frames_in_flight_.emplace_back();
+    frames_in_flight_.back().rtp_timestamp = rtp_timestamp;
+    it = frames_in_flight_.rbegin();
+  }
+
+  absl::optional<int64_t>& stage_time_us =
+      it->stage_time_us[static_cast<size_t>(stage)];
+  if (!stage_time_us)
+    stage_time_us = time_us;
+
+  if (stage == last_stage_) {
+    OnFrameComplete(*it);
+    frames_in_flight_.erase(std::next(it).base());
+  }
+}
+
+std::vector<FrameStageTracer::FrameTrace> FrameStageTracer::GetRecentFrames()
+    const {
+  rtc::CritScope lock(&crit_);
+  return std::vector<FrameTrace>(recent_frames_.begin(), recent_frames_.end());
+}
+
+void FrameStageTracer::OnFrameComplete(const FrameTrace& frame) {
+  absl::optional<int64_t> previous_time_us;
+  for (size_t stage = 0; stage < kNumStages; ++stage) {
+    const absl::optional<int64_t>& time_us = frame.stage_time_us[stage];
+    if (!time_us)
+      continue;
+    if (previous_time_us && kStageNames[stage]) {
+      const int64_t stage_ms = std::max<int64_t>(
+          0, (*time_us - *previous_time_us) / rtc::kNumMicrosecsPerMillisec);
+      stage_ms_counters_[stage].Add(static_cast<int>(stage_ms));
+      stage_ms_percentiles_[stage].Add(static_cast<uint32_t>(stage_ms));
+    }
+    previous_time_us = time_us;
+  }
+
+  if (recent_frames_.size() == kMaxRecentFrames)
+    recent_frames_.pop_front();
+  recent_frames_.push_back(frame);
+}
+
+void FrameStageTracer::UpdateHistograms() {
+  for (size_t stage = 0; stage < kNumStages; ++stage) {
+    if (!kStageNames[stage] ||
+        stage_ms_counters_[stage].NumSamples() < kMinRequiredSamples) {
+      continue;
+    }
+    const std::string name =
+        std::string("WebRTC.Video.FrameStage.") + kStageNames[stage];
+    absl::optional<int> avg_ms =
+        stage_ms_counters_[stage].Avg(kMinRequiredSamples);
+    absl::optional<uint32_t> tail_ms =
+        stage_ms_percentiles_[stage].GetPercentile(kTailPercentile);
+    if (avg_ms)
+      RTC_HISTOGRAM_COUNTS_SPARSE_10000(name + "InMs", *avg_ms);
+    if (tail_ms)
+      RTC_HISTOGRAM_COUNTS_SPARSE_10000(name + "99PercentileInMs", *tail_ms);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAME_STAGE_TRACER_H_
+#define VIDEO_FRAME_STAGE_TRACER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+#include "rtc_base/numerics/sample_counter.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Records when each frame of a stream passes the stages of the send or the
+// receive pipeline, keyed on its RTP timestamp, and reports the time spent
+// before each stage as histograms when destroyed. The most recent complete
+// frame traces are kept for inspection. Stages may be reported from any
+// thread. Enabled with the field trial "WebRTC-VideoFrameStageTracing".
+class FrameStageTracer {
+ public:
+  // The stages of the pipelines, in order. The histogram of a stage holds the
+  // time from the previous stage the frame was seen at.
+  enum class Stage {
+    // Send side.
+    kCaptured,
+    kEncoderQueued,    // CaptureToEncoder: source and adaptation.
+    kEncoderDequeued,  // EncoderQueue.
+    kEncodeStarted,    // PreEncode: drop decisions, scaling, conversion.
+    kEncoded,          // Encode.
+    // Receive side.
+    kFirstPacketReceived,
+    kLastPacketReceived,  // FrameReception.
+    kFrameCompleted,      // FrameAssembly: packet buffer, reference finding.
+    kDecodeQueued,        // JitterBuffer.
+    kDecodeStarted,       // DecodeQueue.
+    kDecoded,             // Decode.
+    kRendered,            // RenderSmoothing.
+    kNumStages
+  };
+  static constexpr size_t kNumStages = static_cast<size_t>(Stage::kNumStages);
+
+  struct FrameTrace {
+    uint32_t rtp_timestamp = 0;
+    // When the frame first reached each stage, in microseconds.
+    std::array<absl::optional<int64_t>, kNumStages> stage_time_us;
+  };
+
+  static constexpr size_t kMaxFramesInFlight = 64;
+  static constexpr size_t kMaxRecentFrames = 32;
+
+  // Returns nullptr unless enabled by field trial.
+  static std::unique_ptr<FrameStageTracer> CreateIfEnabled(Clock* clock,
+                                                           Stage last_stage);
+
+  // A frame is complete, and its stage times are added to the histograms,
+  // when it reaches |last_stage|.
+  FrameStageTracer(Clock* clock, Stage last_stage);
+  ~FrameStageTracer();
+
+  // Records that the frame reached |stage| now, or at |time_us| on the same
+  // clock. Only the first time a frame reaches a stage is kept, e.g. for the
+  // first of several spatial layers or simulcast streams.
+  void OnStage(uint32_t rtp_timestamp, Stage stage);
+  void OnStage(uint32_t rtp_timestamp, Stage stage, int64_t time_us);
+
+  // The most recent complete frames, oldest first.
+  std::vector<FrameTrace> GetRecentFrames() const;
+
+ private:
+  void OnFrameComplete(const FrameTrace& frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void UpdateHistograms() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  const Stage last_stage_;
+  rtc::CriticalSection crit_;
+  // Frames that have not reached |last_stage_| yet, oldest first. The oldest
+  // frames are forgotten, e.g. when dropped along the way.
+  std::deque<FrameTrace> frames_in_flight_ RTC_GUARDED_BY(crit_);
+  std::deque<FrameTrace> recent_frames_ RTC_GUARDED_BY(crit_);
+  std::array<rtc::SampleCounter, kNumStages> stage_ms_counters_
+      RTC_GUARDED_BY(crit_);
+  std::vector<rtc::HistogramPercentileCounter> stage_ms_percentiles_
+      RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAME_STAGE_TRACER_H_
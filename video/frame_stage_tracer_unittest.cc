@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_stage_tracer.h"
+
+#include <vector>
+
+#include "system_wrappers/include/metrics.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Stage = FrameStageTracer::Stage;
+
+constexpr uint32_t kRtpTimestamp = 90000;
+constexpr int kFrameIntervalMs = 33;
+
+class FrameStageTracerTest : public ::testing::Test {
+ protected:
+  FrameStageTracerTest() : clock_(1234567) {}
+
+  // Sends a frame through the encoder, spending |encode_ms| in the encoder.
+  void EncodeFrame(FrameStageTracer* tracer,
+                   uint32_t rtp_timestamp,
+                   int encode_ms) {
+    tracer->OnStage(rtp_timestamp, Stage::kCaptured);
+    clock_.AdvanceTimeMilliseconds(1);
+    tracer->OnStage(rtp_timestamp, Stage::kEncoderQueued);
+    clock_.AdvanceTimeMilliseconds(2);
+    tracer->OnStage(rtp_timestamp, Stage::kEncoderDequeued);
+    tracer->OnStage(rtp_timestamp, Stage::kEncodeStarted);
+    clock_.AdvanceTimeMilliseconds(encode_ms);
+    tracer->OnStage(rtp_timestamp, Stage::kEncoded);
+  }
+
+  SimulatedClock clock_;
+};
+
+TEST_F(FrameStageTracerTest, DisabledByDefault) {
+  EXPECT_FALSE(FrameStageTracer::CreateIfEnabled(&clock_, Stage::kEncoded));
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VideoFrameStageTracing/Enabled/");
+  EXPECT_TRUE(FrameStageTracer::CreateIfEnabled(&clock_, Stage::kEncoded));
+}
+
+TEST_F(FrameStageTracerTest, KeepsTraceOfCompleteFrames) {
+  FrameStageTracer tracer(&clock_, Stage::kEncoded);
+  const int64_t start_us = clock_.TimeInMicroseconds();
+  EncodeFrame(&tracer, kRtpTimestamp, /*encode_ms=*/10);
+
+  std::vector<FrameStageTracer::FrameTrace> frames = tracer.GetRecentFrames();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(kRtpTimestamp, frames[0].rtp_timestamp);
+  const auto& stage_time_us = frames[0].stage_time_us;
+  EXPECT_EQ(start_us, stage_time_us[static_cast<size_t>(Stage::kCaptured)]);
+  EXPECT_EQ(start_us + 3000,
+            stage_time_us[static_cast<size_t>(Stage::kEncodeStarted)]);
+  EXPECT_EQ(start_us + 13000,
+            stage_time_us[static_cast<size_t>(Stage::kEncoded)]);
+  EXPECT_FALSE(stage_time_us[static_cast<size_t>(Stage::kDecoded)]);
+}
+
+TEST_F(FrameStageTracerTest, KeepsFirstTimeOfStage) {
+  FrameStageTracer tracer(&clock_, Stage::kRendered);
+  tracer.OnStage(kRtpTimestamp, Stage::kFrameCompleted, 1000);
+  tracer.OnStage(kRtpTimestamp, Stage::kFrameCompleted, 2000);
+  tracer.OnStage(kRtpTimestamp, Stage::kRendered, 3000);
+
+  std::vector<FrameStageTracer::FrameTrace> frames = tracer.GetRecentFrames();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(1000, frames[0].stage_time_us[static_cast<size_t>(
+                      Stage::kFrameCompleted)]);
+}
+
+TEST_F(FrameStageTracerTest, IgnoresLastStageOfUnknownFrame) {
+  FrameStageTracer tracer(&clock_, Stage::kEncoded);
+  EncodeFrame(&tracer, kRtpTimestamp, /*encode_ms=*/10);
+  // E.g. the second simulcast stream of the same frame.
+  tracer.OnStage(kRtpTimestamp, Stage::kEncoded);
+  EXPECT_EQ(1u, tracer.GetRecentFrames().size());
+}
+
+TEST_F(FrameStageTracerTest, ForgetsOldestFramesInFlight) {
+  FrameStageTracer tracer(&clock_, Stage::kEncoded);
+  for (uint32_t i = 0; i <= FrameStageTracer::kMaxFramesInFlight; ++i)
+    tracer.OnStage(kRtpTimestamp + i, Stage::kCaptured);
+  tracer.OnStage(kRtpTimestamp, Stage::kEncoded);
+  tracer.OnStage(kRtpTimestamp + 1, Stage::kEncoded);
+
+  std::vector<FrameStageTracer::FrameTrace> frames = tracer.GetRecentFrames();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(kRtpTimestamp + 1, frames[0].rtp_timestamp);
+}
+
+TEST_F(FrameStageTracerTest, KeepsMostRecentFrames) {
+  FrameStageTracer tracer(&clock_, Stage::kEncoded);
+  for (uint32_t i = 0; i < FrameStageTracer::kMaxRecentFrames + 1; ++i)
+    EncodeFrame(&tracer, kRtpTimestamp + i, /*encode_ms=*/10);
+
+  std::vector<FrameStageTracer::FrameTrace> frames = tracer.GetRecentFrames();
+  ASSERT_EQ(FrameStageTracer::kMaxRecentFrames, frames.size());
+  EXPECT_EQ(kRtpTimestamp + 1, frames.front().rtp_timestamp);
+  EXPECT_EQ(kRtpTimestamp + FrameStageTracer::kMaxRecentFrames,
+            frames.back().rtp_timestamp);
+}
+
+TEST_F(FrameStageTracerTest, ReportsStageHistograms) {
+  metrics::Reset();
+  {
+    FrameStageTracer tracer(&clock_, Stage::kEncoded);
+    for (int i = 0; i < 200; ++i) {
+      // Every 50th frame takes 50 ms to encode.
+      EncodeFrame(&tracer, kRtpTimestamp + i * 3000, i % 50 ? 10 : 50);
+      clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+    }
+  }
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.FrameStage.CaptureToEncoderInMs", 1));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.FrameStage.EncoderQueueInMs",
+                                  2));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.FrameStage.PreEncodeInMs", 0));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.FrameStage.EncodeInMs", 10));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.FrameStage.Encode99PercentileInMs", 50));
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Video.FrameStage.DecodeInMs"));
+}
+
+TEST_F(FrameStageTracerTest, NoHistogramsForFewFrames) {
+  metrics::Reset();
+  {
+    FrameStageTracer tracer(&clock_, Stage::kEncoded);
+    for (int i = 0; i < 199; ++i)
+      EncodeFrame(&tracer, kRtpTimestamp + i * 3000, /*encode_ms=*/10);
+  }
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Video.FrameStage.EncodeInMs"));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -546,10 +546,8 @@ void ReceiveStatisticsProxy::QualitySample() {
 
 void ReceiveStatisticsProxy::UpdateFramerate(int64_t now_ms) const {
   int64_t old_frames_ms = now_ms - kRateStatisticsWindowSizeMs;
-  while (!frame_window_.empty() &&
-         frame_window_.begin()->first < old_frames_ms) {
-    frame_window_.erase(frame_window_.begin());
-  }
+  while (!frame_window_.empty() && frame_window_.front() < old_frames_ms)
+    frame_window_.pop_front();
 
   size_t framerate =
       (frame_window_.size() * 1000 + 500) / kRateStatisticsWindowSizeMs;
@@ -856,7 +854,8 @@ void ReceiveStatisticsProxy::OnCompleteFrame(bool is_keyframe,
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
-  frame_window_.insert(std::make_pair(now_ms, size_bytes));
+  if (frame_window_.empty() || frame_window_.back() < now_ms)
+    frame_window_.push_back(now_ms);
   UpdateFramerate(now_ms);
 }
 
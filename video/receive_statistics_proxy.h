@@ -11,6 +11,7 @@
 #ifndef VIDEO_RECEIVE_STATISTICS_PROXY_H_
 #define VIDEO_RECEIVE_STATISTICS_PROXY_H_
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -174,7 +175,9 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   MaxCounter freq_offset_counter_ RTC_GUARDED_BY(crit_);
   QpCounters qp_counters_ RTC_GUARDED_BY(decode_thread_);
   int64_t avg_rtt_ms_ RTC_GUARDED_BY(crit_);
-  mutable std::map<int64_t, size_t> frame_window_ RTC_GUARDED_BY(&crit_);
+  // Arrival times of the complete frames of the last second, oldest first, at
+  // most one per millisecond.
+  mutable std::deque<int64_t> frame_window_ RTC_GUARDED_BY(&crit_);
   VideoContentType last_content_type_ RTC_GUARDED_BY(&crit_);
   VideoCodecType last_codec_type_ RTC_GUARDED_BY(&crit_);
   absl::optional<int64_t> first_frame_received_time_ms_ RTC_GUARDED_BY(&crit_);
@@ -301,7 +301,9 @@ void RtpVideoStreamReceiver::AddReceiveCodec(
   if (!raw_payload) {
     video_type = video_codec.codecType;
   }
-  payload_type_map_.emplace(video_codec.plType, video_type);
+  payload_type_map_.emplace(
+      video_codec.plType,
+      absl::WrapUnique(RtpDepacketizer::Create(video_type)));
   pt_codec_params_.emplace(video_codec.plType, codec_params);
 }
 
@@ -680,13 +682,8 @@ void RtpVideoStreamReceiver::ReceivePacket(const RtpPacketReceived& packet) {
   if (type_it == payload_type_map_.end()) {
     return;
   }
-  auto depacketizer =
-      absl::WrapUnique(RtpDepacketizer::Create(type_it->second));
-
-  if (!depacketizer) {
-    RTC_LOG(LS_ERROR) << "Failed to create depacketizer.";
-    return;
-  }
+  RtpDepacketizer* const depacketizer = type_it->second.get();
+  RTC_DCHECK(depacketizer);
   RtpDepacketizer::ParsedPayload parsed_payload;
   if (!depacketizer->Parse(&parsed_payload, packet.payload().data(),
                            packet.payload().size())) {
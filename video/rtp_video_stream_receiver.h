@@ -30,6 +30,7 @@
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/video_coding/h264_sps_pps_tracker.h"
 #include "modules/video_coding/loss_notification_controller.h"
 #ifdef OWT_ENABLE_H265
@@ -289,8 +290,9 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
       RTC_GUARDED_BY(last_seq_num_cs_);
   video_coding::H264SpsPpsTracker tracker_;
 
-  // Maps payload type to codec type, for packetization.
-  std::map<uint8_t, absl::optional<VideoCodecType>> payload_type_map_;
+  // Maps payload type to the depacketizer for its codec, which is created
+  // once and used for all packets with that payload type.
+  std::map<uint8_t, std::unique_ptr<RtpDepacketizer>> payload_type_map_;
 
 
 #ifdef OWT_ENABLE_H265
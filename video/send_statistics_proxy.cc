@@ -157,11 +157,34 @@ SendStatisticsProxy::SendStatisticsProxy(
       bw_limited_layers_(false),
       uma_container_(
           new UmaSamplesContainer(GetUmaPrefix(content_type_), stats_, clock)) {
+  // The SSRCs are known up front, so that the substreams can be looked up
+  // without allocating or taking |crit_| on the RTP side.
+  const bool has_flexfec = rtp_config_.flexfec.payload_type != -1;
+  auto add_substream = [&](uint32_t ssrc) {
+    if (absl::c_any_of(rtp_substreams_, [ssrc](const RtpSubstream& substream) {
+          return substream.ssrc == ssrc;
+        })) {
+      return;
+    }
+    rtp_substreams_.emplace_back(ssrc);
+    rtp_substreams_.back().stats.is_rtx =
+        absl::c_linear_search(rtp_config_.rtx.ssrcs, ssrc);
+    rtp_substreams_.back().stats.is_flexfec =
+        has_flexfec && ssrc == rtp_config_.flexfec.ssrc;
+  };
+  for (uint32_t ssrc : rtp_config_.ssrcs)
+    add_substream(ssrc);
+  for (uint32_t ssrc : rtp_config_.rtx.ssrcs)
+    add_substream(ssrc);
+  if (has_flexfec)
+    add_substream(rtp_config_.flexfec.ssrc);
+  encoded_substreams_.resize(rtp_config_.ssrcs.size());
 }
 
 SendStatisticsProxy::~SendStatisticsProxy() {
   rtc::CritScope lock(&crit_);
-  uma_container_->UpdateHistograms(rtp_config_, stats_);
+  rtc::CritScope rtp_lock(&rtp_crit_);
+  uma_container_->UpdateHistograms(rtp_config_, StatsWithSubstreams());
 
   int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
   RTC_HISTOGRAM_COUNTS_100000("WebRTC.Video.SendStreamLifetimeInSeconds",
@@ -182,6 +205,9 @@ SendStatisticsProxy::UmaSamplesContainer::UmaSamplesContainer(
       input_frame_rate_tracker_(100, 10u),
       input_fps_counter_(clock, nullptr, true),
       sent_fps_counter_(clock, nullptr, true),
+      start_stats_(stats),
+      num_streams_(0),
+      num_pixels_highest_stream_(0),
       total_byte_counter_(clock, nullptr, true),
       media_byte_counter_(clock, nullptr, true),
       rtx_byte_counter_(clock, nullptr, true),
@@ -189,10 +215,7 @@ SendStatisticsProxy::UmaSamplesContainer::UmaSamplesContainer(
       retransmit_byte_counter_(clock, nullptr, true),
       fec_byte_counter_(clock, nullptr, true),
       first_rtcp_stats_time_ms_(-1),
-      first_rtp_stats_time_ms_(-1),
-      start_stats_(stats),
-      num_streams_(0),
-      num_pixels_highest_stream_(0) {
+      first_rtp_stats_time_ms_(-1) {
   InitializeBitrateCounters(stats);
   static_assert(
       kMaxEncodedFrameTimestampDiff < std::numeric_limits<uint32_t>::max() / 2,
@@ -677,9 +700,11 @@ void SendStatisticsProxy::OnEncoderReconfigured(
   rtc::CritScope lock(&crit_);
 
   if (content_type_ != config.content_type) {
-    uma_container_->UpdateHistograms(rtp_config_, stats_);
+    rtc::CritScope rtp_lock(&rtp_crit_);
+    VideoSendStream::Stats stats = StatsWithSubstreams();
+    uma_container_->UpdateHistograms(rtp_config_, stats);
     uma_container_.reset(new UmaSamplesContainer(
-        GetUmaPrefix(config.content_type), stats_, clock_));
+        GetUmaPrefix(config.content_type), stats, clock_));
     content_type_ = config.content_type;
   }
   uma_container_->encoded_frames_.clear();
@@ -710,6 +735,7 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
     uma_container_->input_fps_counter_.ProcessAndPauseForDuration(kMinMs);
     uma_container_->sent_fps_counter_.ProcessAndPauseForDuration(kMinMs);
     // Pause bitrate stats.
+    rtc::CritScope rtp_lock(&rtp_crit_);
     uma_container_->total_byte_counter_.ProcessAndPauseForDuration(kMinMs);
     uma_container_->media_byte_counter_.ProcessAndPauseForDuration(kMinMs);
     uma_container_->rtx_byte_counter_.ProcessAndPauseForDuration(kMinMs);
@@ -727,6 +753,7 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
       uma_container_->quality_adapt_timer_.Start(now_ms);
     // Stop pause explicitly for stats that may be zero/not updated for some
     // time.
+    rtc::CritScope rtp_lock(&rtp_crit_);
     uma_container_->rtx_byte_counter_.ProcessAndStopPause();
     uma_container_->padding_byte_counter_.ProcessAndStopPause();
     uma_container_->retransmit_byte_counter_.ProcessAndStopPause();
@@ -735,66 +762,100 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
 }
 
 VideoSendStream::Stats SendStatisticsProxy::GetStats() {
-  rtc::CritScope lock(&crit_);
-  PurgeOldStats();
-  stats_.input_frame_rate =
-      round(uma_container_->input_frame_rate_tracker_.ComputeRate());
-  stats_.content_type =
-      content_type_ == VideoEncoderConfig::ContentType::kRealtimeVideo
-          ? VideoContentType::UNSPECIFIED
-          : VideoContentType::SCREENSHARE;
-  stats_.encode_frame_rate = round(encoded_frame_rate_tracker_.ComputeRate());
-  stats_.media_bitrate_bps = media_byte_rate_tracker_.ComputeRate() * 8;
-  stats_.quality_limitation_durations_ms =
-      quality_limitation_reason_tracker_.DurationsMs();
-  return stats_;
+  VideoSendStream::Stats stats;
+  std::vector<EncodedSubstream> encoded_substreams;
+  {
+    rtc::CritScope lock(&crit_);
+    PurgeOldStats();
+    stats_.input_frame_rate =
+        round(uma_container_->input_frame_rate_tracker_.ComputeRate());
+    stats_.content_type =
+        content_type_ == VideoEncoderConfig::ContentType::kRealtimeVideo
+            ? VideoContentType::UNSPECIFIED
+            : VideoContentType::SCREENSHARE;
+    stats_.encode_frame_rate = round(encoded_frame_rate_tracker_.ComputeRate());
+    stats_.media_bitrate_bps = media_byte_rate_tracker_.ComputeRate() * 8;
+    stats_.quality_limitation_durations_ms =
+        quality_limitation_reason_tracker_.DurationsMs();
+    stats = stats_;
+    encoded_substreams = encoded_substreams_;
+  }
+  // Taken only after |crit_| is released, so that the encoder and the RTP
+  // modules do not wait for each other behind a reader.
+  rtc::CritScope lock(&rtp_crit_);
+  AddSubstreams(encoded_substreams, &stats);
+  return stats;
 }
 
 void SendStatisticsProxy::PurgeOldStats() {
   int64_t old_stats_ms = clock_->TimeInMilliseconds() - kStatsTimeoutMs;
-  for (std::map<uint32_t, VideoSendStream::StreamStats>::iterator it =
-           stats_.substreams.begin();
-       it != stats_.substreams.end(); ++it) {
-    uint32_t ssrc = it->first;
-    if (update_times_[ssrc].resolution_update_ms <= old_stats_ms) {
-      it->second.width = 0;
-      it->second.height = 0;
+  for (EncodedSubstream& substream : encoded_substreams_) {
+    if (substream.resolution_update_ms <= old_stats_ms) {
+      substream.width = 0;
+      substream.height = 0;
     }
   }
 }
 
-VideoSendStream::StreamStats* SendStatisticsProxy::GetStatsEntry(
+VideoSendStream::StreamStats* SendStatisticsProxy::GetRtpStatsEntry(
     uint32_t ssrc) {
-  std::map<uint32_t, VideoSendStream::StreamStats>::iterator it =
-      stats_.substreams.find(ssrc);
-  if (it != stats_.substreams.end())
-    return &it->second;
-
-  bool is_media = absl::c_linear_search(rtp_config_.ssrcs, ssrc);
-  bool is_flexfec = rtp_config_.flexfec.payload_type != -1 &&
-                    ssrc == rtp_config_.flexfec.ssrc;
-  bool is_rtx = absl::c_linear_search(rtp_config_.rtx.ssrcs, ssrc);
-  if (!is_media && !is_flexfec && !is_rtx)
-    return nullptr;
-
-  // Insert new entry and return ptr.
-  VideoSendStream::StreamStats* entry = &stats_.substreams[ssrc];
-  entry->is_rtx = is_rtx;
-  entry->is_flexfec = is_flexfec;
-
-  return entry;
+  for (RtpSubstream& substream : rtp_substreams_) {
+    if (substream.ssrc == ssrc) {
+      substream.reported = true;
+      return &substream.stats;
+    }
+  }
+  return nullptr;
+}
+
+void SendStatisticsProxy::AddSubstreams(
+    const std::vector<EncodedSubstream>& encoded_substreams,
+    VideoSendStream::Stats* stats) const {
+  for (size_t i = 0; i < rtp_substreams_.size(); ++i) {
+    const RtpSubstream& substream = rtp_substreams_[i];
+    // The media SSRCs come first, in the order of |encoded_substreams|.
+    const EncodedSubstream* encoded_substream =
+        i < encoded_substreams.size() && rtp_config_.ssrcs[i] == substream.ssrc
+            ? &encoded_substreams[i]
+            : nullptr;
+    if (!substream.reported &&
+        !(encoded_substream && encoded_substream->reported)) {
+      continue;
+    }
+    VideoSendStream::StreamStats& substream_stats =
+        stats->substreams[substream.ssrc];
+    substream_stats = substream.stats;
+    if (encoded_substream) {
+      substream_stats.width = encoded_substream->width;
+      substream_stats.height = encoded_substream->height;
+    }
+  }
+}
+
+VideoSendStream::Stats SendStatisticsProxy::StatsWithSubstreams() const {
+  VideoSendStream::Stats stats = stats_;
+  AddSubstreams(encoded_substreams_, &stats);
+  return stats;
 }
 
 void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  {
+    rtc::CritScope lock(&crit_);
+    for (size_t i = 0; i < encoded_substreams_.size(); ++i) {
+      if (rtp_config_.ssrcs[i] == ssrc) {
+        encoded_substreams_[i].reported = true;
+        encoded_substreams_[i].width = 0;
+        encoded_substreams_[i].height = 0;
+      }
+    }
+  }
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
 
   stats->total_bitrate_bps = 0;
   stats->retransmit_bitrate_bps = 0;
-  stats->height = 0;
-  stats->width = 0;
 }
 
 void SendStatisticsProxy::OnSetEncoderTargetRate(uint32_t bitrate_bps) {
@@ -938,11 +999,8 @@ void SendStatisticsProxy::OnSendEncodedImage(
                       << ").";
     return;
   }
-  uint32_t ssrc = rtp_config_.ssrcs[simulcast_idx];
-
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
-    return;
+  EncodedSubstream* substream = &encoded_substreams_[simulcast_idx];
+  substream->reported = true;
 
   // Report resolution of top spatial layer in case of VP9 SVC.
   bool is_svc_low_spatial_layer =
@@ -950,10 +1008,10 @@ void SendStatisticsProxy::OnSendEncodedImage(
           ? !codec_info->codecSpecific.VP9.end_of_picture
           : false;
 
-  if (!stats->width || !stats->height || !is_svc_low_spatial_layer) {
-    stats->width = encoded_image._encodedWidth;
-    stats->height = encoded_image._encodedHeight;
-    update_times_[ssrc].resolution_update_ms = clock_->TimeInMilliseconds();
+  if (!substream->width || !substream->height || !is_svc_low_spatial_layer) {
+    substream->width = encoded_image._encodedWidth;
+    substream->height = encoded_image._encodedHeight;
+    substream->resolution_update_ms = clock_->TimeInMilliseconds();
   }
 
   uma_container_->key_frame_counter_.Add(encoded_image._frameType ==
@@ -1212,8 +1270,8 @@ void SendStatisticsProxy::SetAdaptTimer(const AdaptationSteps& counts,
 void SendStatisticsProxy::RtcpPacketTypesCounterUpdated(
     uint32_t ssrc,
     const RtcpPacketTypeCounter& packet_counter) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
 
@@ -1224,8 +1282,8 @@ void SendStatisticsProxy::RtcpPacketTypesCounterUpdated(
 
 void SendStatisticsProxy::StatisticsUpdated(const RtcpStatistics& statistics,
                                             uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
 
@@ -1235,9 +1293,9 @@ void SendStatisticsProxy::StatisticsUpdated(const RtcpStatistics& statistics,
 
 void SendStatisticsProxy::OnReportBlockDataUpdated(
     ReportBlockData report_block_data) {
-  rtc::CritScope lock(&crit_);
+  rtc::CritScope lock(&rtp_crit_);
   VideoSendStream::StreamStats* stats =
-      GetStatsEntry(report_block_data.report_block().source_ssrc);
+      GetRtpStatsEntry(report_block_data.report_block().source_ssrc);
   if (!stats)
     return;
   stats->report_block_data = std::move(report_block_data);
@@ -1246,44 +1304,56 @@ void SendStatisticsProxy::OnReportBlockDataUpdated(
 void SendStatisticsProxy::DataCountersUpdated(
     const StreamDataCounters& counters,
     uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  RTC_DCHECK(stats) << "DataCountersUpdated reported for unknown ssrc " << ssrc;
+  absl::optional<int64_t> first_rtp_stats_time_ms;
+  {
+    rtc::CritScope lock(&rtp_crit_);
+    VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
+    RTC_DCHECK(stats) << "DataCountersUpdated reported for unknown ssrc "
+                      << ssrc;
+
+    if (stats->is_flexfec) {
+      // The same counters are reported for both the media ssrc and flexfec
+      // ssrc. Bitrate stats are summed for all SSRCs. Use fec stats from media
+      // update.
+      return;
+    }
 
-  if (stats->is_flexfec) {
-    // The same counters are reported for both the media ssrc and flexfec ssrc.
-    // Bitrate stats are summed for all SSRCs. Use fec stats from media update.
-    return;
-  }
+    stats->rtp_stats = counters;
+    if (uma_container_->first_rtp_stats_time_ms_ == -1) {
+      first_rtp_stats_time_ms = clock_->TimeInMilliseconds();
+      uma_container_->first_rtp_stats_time_ms_ = *first_rtp_stats_time_ms;
+    }
 
-  stats->rtp_stats = counters;
-  if (uma_container_->first_rtp_stats_time_ms_ == -1) {
-    int64_t now_ms = clock_->TimeInMilliseconds();
-    uma_container_->first_rtp_stats_time_ms_ = now_ms;
-    uma_container_->cpu_adapt_timer_.Restart(now_ms);
-    uma_container_->quality_adapt_timer_.Restart(now_ms);
+    uma_container_->total_byte_counter_.Set(counters.transmitted.TotalBytes(),
+                                            ssrc);
+    uma_container_->padding_byte_counter_.Set(
+        counters.transmitted.padding_bytes, ssrc);
+    uma_container_->retransmit_byte_counter_.Set(
+        counters.retransmitted.TotalBytes(), ssrc);
+    uma_container_->fec_byte_counter_.Set(counters.fec.TotalBytes(), ssrc);
+    if (stats->is_rtx) {
+      uma_container_->rtx_byte_counter_.Set(counters.transmitted.TotalBytes(),
+                                            ssrc);
+    } else {
+      uma_container_->media_byte_counter_.Set(counters.MediaPayloadBytes(),
+                                              ssrc);
+    }
   }
 
-  uma_container_->total_byte_counter_.Set(counters.transmitted.TotalBytes(),
-                                          ssrc);
-  uma_container_->padding_byte_counter_.Set(counters.transmitted.padding_bytes,
-                                            ssrc);
-  uma_container_->retransmit_byte_counter_.Set(
-      counters.retransmitted.TotalBytes(), ssrc);
-  uma_container_->fec_byte_counter_.Set(counters.fec.TotalBytes(), ssrc);
-  if (stats->is_rtx) {
-    uma_container_->rtx_byte_counter_.Set(counters.transmitted.TotalBytes(),
-                                          ssrc);
-  } else {
-    uma_container_->media_byte_counter_.Set(counters.MediaPayloadBytes(), ssrc);
+  // The adaptation stats start with the first packet. This happens once, so
+  // taking |crit_| here is not a source of contention.
+  if (first_rtp_stats_time_ms) {
+    rtc::CritScope lock(&crit_);
+    uma_container_->cpu_adapt_timer_.Restart(*first_rtp_stats_time_ms);
+    uma_container_->quality_adapt_timer_.Restart(*first_rtp_stats_time_ms);
   }
 }
 
 void SendStatisticsProxy::Notify(uint32_t total_bitrate_bps,
                                  uint32_t retransmit_bitrate_bps,
                                  uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
 
@@ -1293,8 +1363,8 @@ void SendStatisticsProxy::Notify(uint32_t total_bitrate_bps,
 
 void SendStatisticsProxy::FrameCountUpdated(const FrameCounts& frame_counts,
                                             uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
 
@@ -1305,8 +1375,8 @@ void SendStatisticsProxy::SendSideDelayUpdated(int avg_delay_ms,
                                                int max_delay_ms,
                                                uint64_t total_delay_ms,
                                                uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+  rtc::CritScope lock(&rtp_crit_);
+  VideoSendStream::StreamStats* stats = GetRtpStatsEntry(ssrc);
   if (!stats)
     return;
   stats->avg_delay_ms = avg_delay_ms;
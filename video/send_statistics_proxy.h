@@ -153,10 +153,21 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     int64_t sum;
     int64_t num_samples;
   };
-  struct StatsUpdateTimes {
-    StatsUpdateTimes() : resolution_update_ms(0), bitrate_update_ms(0) {}
-    int64_t resolution_update_ms;
-    int64_t bitrate_update_ms;
+  // The stats of a substream, as reported by the RTP and RTCP modules. The
+  // resolution is kept in EncodedSubstream instead.
+  struct RtpSubstream {
+    explicit RtpSubstream(uint32_t ssrc) : ssrc(ssrc) {}
+    const uint32_t ssrc;
+    // Set once the substream has been reported and should be in the stats.
+    bool reported = false;
+    VideoSendStream::StreamStats stats;
+  };
+  // The resolution of a media substream, as sent by the encoder.
+  struct EncodedSubstream {
+    bool reported = false;
+    int width = 0;
+    int height = 0;
+    int64_t resolution_update_ms = 0;
   };
   struct TargetRateUpdates {
     TargetRateUpdates()
@@ -218,8 +229,17 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   typedef std::map<uint32_t, Frame, TimestampOlderThan> EncodedFrameMap;
 
   void PurgeOldStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
-  VideoSendStream::StreamStats* GetStatsEntry(uint32_t ssrc)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns the RTP stats of |ssrc|, marked as reported, or null if |ssrc| is
+  // not one of the configured SSRCs.
+  VideoSendStream::StreamStats* GetRtpStatsEntry(uint32_t ssrc)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtp_crit_);
+  // Adds the substreams that have been reported to |stats|.
+  void AddSubstreams(const std::vector<EncodedSubstream>& encoded_substreams,
+                     VideoSendStream::Stats* stats) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtp_crit_);
+  // |stats_| with all substreams, for the UMA samples.
+  VideoSendStream::Stats StatsWithSubstreams() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_, rtp_crit_);
 
   void SetAdaptTimer(const AdaptationSteps& counts, StatsTimer* timer)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -242,11 +262,21 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   const RtpConfig rtp_config_;
   const absl::optional<int> fallback_max_pixels_;
   const absl::optional<int> fallback_max_pixels_disabled_;
+  // |crit_| guards the state updated by the encoder and the adaptation, and
+  // |rtp_crit_| the per-SSRC state updated by the RTP and RTCP modules for
+  // every packet, so that the two do not contend with each other. Both are
+  // needed only to report UMA samples, in that order.
   rtc::CriticalSection crit_;
+  rtc::CriticalSection rtp_crit_;
   VideoEncoderConfig::ContentType content_type_ RTC_GUARDED_BY(crit_);
   const int64_t start_ms_;
+  // Does not hold the substreams, which are in |rtp_substreams_| and
+  // |encoded_substreams_|, and added to a copy by GetStats().
   VideoSendStream::Stats stats_ RTC_GUARDED_BY(crit_);
-  std::map<uint32_t, StatsUpdateTimes> update_times_ RTC_GUARDED_BY(crit_);
+  // One per configured SSRC, in the order of media, RTX and FlexFEC SSRCs.
+  std::vector<RtpSubstream> rtp_substreams_ RTC_GUARDED_BY(rtp_crit_);
+  // One per media SSRC, indexed like |rtp_config_.ssrcs|.
+  std::vector<EncodedSubstream> encoded_substreams_ RTC_GUARDED_BY(crit_);
   rtc::ExpFilter encode_time_ RTC_GUARDED_BY(crit_);
   int quality_downscales_ RTC_GUARDED_BY(crit_);
   int cpu_downscales_ RTC_GUARDED_BY(crit_);
@@ -307,19 +337,9 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     BoolSampleCounter cpu_limited_frame_counter_;
     BoolSampleCounter bw_limited_frame_counter_;
     SampleCounter bw_resolutions_disabled_counter_;
-    SampleCounter delay_counter_;
-    SampleCounter max_delay_counter_;
     rtc::RateTracker input_frame_rate_tracker_;
     RateCounter input_fps_counter_;
     RateCounter sent_fps_counter_;
-    RateAccCounter total_byte_counter_;
-    RateAccCounter media_byte_counter_;
-    RateAccCounter rtx_byte_counter_;
-    RateAccCounter padding_byte_counter_;
-    RateAccCounter retransmit_byte_counter_;
-    RateAccCounter fec_byte_counter_;
-    int64_t first_rtcp_stats_time_ms_;
-    int64_t first_rtp_stats_time_ms_;
     StatsTimer cpu_adapt_timer_;
     StatsTimer quality_adapt_timer_;
     BoolSampleCounter paused_time_counter_;
@@ -327,7 +347,6 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     BoolSampleCounter fallback_active_counter_;
     FallbackEncoderInfo fallback_info_;
     FallbackEncoderInfoDisabled fallback_info_disabled_;
-    ReportBlockStats report_block_stats_;
     const VideoSendStream::Stats start_stats_;
     size_t num_streams_;  // Number of configured streams to encoder.
     size_t num_pixels_highest_stream_;
@@ -336,9 +355,25 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
 
     std::map<int, QpCounters>
         qp_counters_;  // QP counters mapped by spatial idx.
+
+    // Updated by the RTP and RTCP modules, with |rtp_crit_| held. All other
+    // members are used with |crit_| held.
+    SampleCounter delay_counter_;
+    SampleCounter max_delay_counter_;
+    RateAccCounter total_byte_counter_;
+    RateAccCounter media_byte_counter_;
+    RateAccCounter rtx_byte_counter_;
+    RateAccCounter padding_byte_counter_;
+    RateAccCounter retransmit_byte_counter_;
+    RateAccCounter fec_byte_counter_;
+    int64_t first_rtcp_stats_time_ms_;
+    int64_t first_rtp_stats_time_ms_;
+    ReportBlockStats report_block_stats_;
   };
 
-  std::unique_ptr<UmaSamplesContainer> uma_container_ RTC_GUARDED_BY(crit_);
+  // Only replaced with both |crit_| and |rtp_crit_| held and can be used with
+  // either of them held, see the members of UmaSamplesContainer.
+  std::unique_ptr<UmaSamplesContainer> uma_container_;
 };
 
 }  // namespace webrtc
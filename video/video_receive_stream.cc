@@ -169,6 +169,15 @@ class EncodedFrameForMediaTransport : public video_coding::EncodedFrame {
 // timestamps wraparound to affect FrameBuffer.
 constexpr int kInactiveStreamThresholdMs = 600000;  //  10 minutes.
 
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateDecodeQueue(
+    TaskQueueFactory* task_queue_factory,
+    DecodeThreadPool* decode_thread_pool) {
+  if (decode_thread_pool)
+    return decode_thread_pool->CreateTaskQueue();
+  return task_queue_factory->CreateTaskQueue("DecodingQueue",
+                                             TaskQueueFactory::Priority::HIGH);
+}
+
 }  // namespace
 
 namespace internal {
@@ -182,8 +191,12 @@ VideoReceiveStream::VideoReceiveStream(
     ProcessThread* process_thread,
     CallStats* call_stats,
     Clock* clock,
-    VCMTiming* timing)
+    VCMTiming* timing,
+    DecodeThreadPool* decode_thread_pool,
+    DecodeThreadPool* render_thread_pool)
     : task_queue_factory_(task_queue_factory),
+      decode_thread_pool_(decode_thread_pool),
+      render_thread_pool_(render_thread_pool),
       transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
@@ -192,6 +205,8 @@ VideoReceiveStream::VideoReceiveStream(
       call_stats_(call_stats),
       source_tracker_(clock_),
       stats_proxy_(&config_, clock_),
+      frame_stage_tracer_(FrameStageTracer::CreateIfEnabled(
+          clock_, FrameStageTracer::Stage::kRendered)),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock_)),
       timing_(timing),
       video_receiver_(clock_, timing_.get()),
@@ -214,9 +229,8 @@ VideoReceiveStream::VideoReceiveStream(
       max_wait_for_frame_ms_(KeyframeIntervalSettings::ParseFromFieldTrials()
                                  .MaxWaitForFrameMs()
                                  .value_or(kMaxWaitForFrameMs)),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_queue_(CreateDecodeQueue(task_queue_factory_,
+                                      decode_thread_pool_)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream: " << config_.ToString();
 
   RTC_DCHECK(config_.renderer);
@@ -271,7 +285,9 @@ VideoReceiveStream::VideoReceiveStream(
     VideoReceiveStream::Config config,
     ProcessThread* process_thread,
     CallStats* call_stats,
-    Clock* clock)
+    Clock* clock,
+    DecodeThreadPool* decode_thread_pool,
+    DecodeThreadPool* render_thread_pool)
     : VideoReceiveStream(task_queue_factory,
                          receiver_controller,
                          num_cpu_cores,
@@ -280,7 +296,9 @@ VideoReceiveStream::VideoReceiveStream(
                          process_thread,
                          call_stats,
                          clock,
-                         new VCMTiming(clock)) {}
+                         new VCMTiming(clock),
+                         decode_thread_pool,
+                         render_thread_pool) {}
 
 VideoReceiveStream::~VideoReceiveStream() {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
@@ -327,8 +345,14 @@ void VideoReceiveStream::Start() {
   transport_adapter_.Enable();
   rtc::VideoSinkInterface<VideoFrame>* renderer = nullptr;
   if (config_.enable_prerenderer_smoothing) {
-    incoming_video_stream_.reset(new IncomingVideoStream(
-        task_queue_factory_, config_.render_delay_ms, this));
+    if (render_thread_pool_) {
+      incoming_video_stream_.reset(
+          new IncomingVideoStream(render_thread_pool_->CreateTaskQueue(),
+                                  config_.render_delay_ms, this));
+    } else {
+      incoming_video_stream_.reset(new IncomingVideoStream(
+          task_queue_factory_, config_.render_delay_ms, this));
+    }
     renderer = incoming_video_stream_.get();
   } else {
     renderer = this;
@@ -381,7 +405,8 @@ void VideoReceiveStream::Start() {
 
   RTC_DCHECK(renderer != nullptr);
   video_stream_decoder_.reset(
-      new VideoStreamDecoder(&video_receiver_, &stats_proxy_, renderer));
+      new VideoStreamDecoder(&video_receiver_, &stats_proxy_, renderer,
+                             frame_stage_tracer_.get()));
 
   // Make sure we register as a stats observer *after* we've prepared the
   // |video_stream_decoder_|.
@@ -522,6 +547,18 @@ void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
   source_tracker_.OnFrameDelivered(video_frame.packet_infos());
 
   config_.renderer->OnFrame(video_frame);
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(video_frame.timestamp(),
+                                 FrameStageTracer::Stage::kRendered);
+  }
+
+  // Larger streams get their frames decoded first when the shared decode
+  // threads are busy.
+  const int64_t priority = video_frame.width() * video_frame.height();
+  if (decode_thread_pool_ && priority != decode_priority_) {
+    decode_priority_ = priority;
+    decode_thread_pool_->SetPriority(decode_queue_.Get(), priority);
+  }
 
   // TODO(tommi): OnRenderFrame grabs a lock too.
   stats_proxy_.OnRenderedFrame(video_frame);
@@ -532,6 +569,15 @@ void VideoReceiveStream::SetFrameDecryptor(
   rtp_video_stream_receiver_.SetFrameDecryptor(std::move(frame_decryptor));
 }
 
+void VideoReceiveStream::SetEncodedFrameSink(EncodedFrameSink* sink) {
+  rtc::CritScope lock(&encoded_frame_sink_lock_);
+  encoded_frame_sink_ = sink;
+}
+
+void VideoReceiveStream::GenerateKeyFrame() {
+  RequestKeyFrame();
+}
+
 void VideoReceiveStream::SendNack(const std::vector<uint16_t>& sequence_numbers,
                                   bool buffering_allowed) {
   RTC_DCHECK(buffering_allowed);
@@ -570,11 +616,38 @@ void VideoReceiveStream::OnCompleteFrame(
     UpdatePlayoutDelays();
   }
 
+  if (frame_stage_tracer_)
+    TraceCompleteFrame(*frame);
+
   int64_t last_continuous_pid = frame_buffer_->InsertFrame(std::move(frame));
   if (last_continuous_pid != -1)
     rtp_video_stream_receiver_.FrameContinuous(last_continuous_pid);
 }
 
+void VideoReceiveStream::TraceCompleteFrame(
+    const video_coding::EncodedFrame& frame) {
+  const uint32_t rtp_timestamp = frame.Timestamp();
+  const RtpPacketInfos& packet_infos = frame.PacketInfos();
+  if (!packet_infos.empty()) {
+    int64_t first_receive_time_ms = packet_infos.begin()->receive_time_ms();
+    for (const RtpPacketInfo& packet_info : packet_infos) {
+      first_receive_time_ms =
+          std::min(first_receive_time_ms, packet_info.receive_time_ms());
+    }
+    frame_stage_tracer_->OnStage(
+        rtp_timestamp, FrameStageTracer::Stage::kFirstPacketReceived,
+        first_receive_time_ms * rtc::kNumMicrosecsPerMillisec);
+  }
+  // Frames from a media transport have no receive time.
+  if (frame.ReceivedTime() > 0) {
+    frame_stage_tracer_->OnStage(
+        rtp_timestamp, FrameStageTracer::Stage::kLastPacketReceived,
+        frame.ReceivedTime() * rtc::kNumMicrosecsPerMillisec);
+  }
+  frame_stage_tracer_->OnStage(rtp_timestamp,
+                               FrameStageTracer::Stage::kFrameCompleted);
+}
+
 void VideoReceiveStream::OnData(uint64_t channel_id,
                                 MediaTransportEncodedVideoFrame frame) {
   OnCompleteFrame(
@@ -633,6 +706,10 @@ void VideoReceiveStream::StartNextDecode() {
       [this](std::unique_ptr<EncodedFrame> frame, ReturnReason res) {
         RTC_DCHECK_EQ(frame == nullptr, res == ReturnReason::kTimeout);
         RTC_DCHECK_EQ(frame != nullptr, res == ReturnReason::kFrameFound);
+        if (frame && frame_stage_tracer_) {
+          frame_stage_tracer_->OnStage(frame->Timestamp(),
+                                       FrameStageTracer::Stage::kDecodeQueued);
+        }
         decode_queue_.PostTask([this, frame = std::move(frame)]() mutable {
           RTC_DCHECK_RUN_ON(&decode_queue_);
           if (decoder_stopped_)
@@ -650,6 +727,10 @@ void VideoReceiveStream::StartNextDecode() {
 void VideoReceiveStream::HandleEncodedFrame(
     std::unique_ptr<EncodedFrame> frame) {
   int64_t now_ms = clock_->TimeInMilliseconds();
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(frame->Timestamp(),
+                                 FrameStageTracer::Stage::kDecodeStarted);
+  }
 
   // Current OnPreDecode only cares about QP for VP8.
   int qp = -1;
@@ -660,6 +741,14 @@ void VideoReceiveStream::HandleEncodedFrame(
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
+  {
+    rtc::CritScope lock(&encoded_frame_sink_lock_);
+    if (encoded_frame_sink_) {
+      encoded_frame_sink_->OnEncodedFrame(frame->EncodedImage(),
+                                          *frame->CodecSpecific());
+    }
+  }
+
   int decode_result = video_receiver_.Decode(frame.get());
   if (decode_result == WEBRTC_VIDEO_CODEC_OK ||
       decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME) {
@@ -26,6 +26,8 @@
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
+#include "video/decode_thread_pool.h"
+#include "video/frame_stage_tracer.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer.h"
 #include "video/rtp_video_stream_receiver.h"
@@ -61,7 +63,9 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                      ProcessThread* process_thread,
                      CallStats* call_stats,
                      Clock* clock,
-                     VCMTiming* timing);
+                     VCMTiming* timing,
+                     DecodeThreadPool* decode_thread_pool,
+                     DecodeThreadPool* render_thread_pool);
   VideoReceiveStream(TaskQueueFactory* task_queue_factory,
                      RtpStreamReceiverControllerInterface* receiver_controller,
                      int num_cpu_cores,
@@ -69,7 +73,9 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                      VideoReceiveStream::Config config,
                      ProcessThread* process_thread,
                      CallStats* call_stats,
-                     Clock* clock);
+                     Clock* clock,
+                     DecodeThreadPool* decode_thread_pool,
+                     DecodeThreadPool* render_thread_pool);
   ~VideoReceiveStream() override;
 
   const Config& config() const { return config_; }
@@ -96,6 +102,8 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
   void SetFrameDecryptor(
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor) override;
+  void SetEncodedFrameSink(EncodedFrameSink* sink) override;
+  void GenerateKeyFrame() override;
 
   // Implements rtc::VideoSinkInterface<VideoFrame>.
   void OnFrame(const VideoFrame& video_frame) override;
@@ -135,6 +143,8 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   int64_t GetWaitMs() const;
   void StartNextDecode() RTC_RUN_ON(decode_queue_);
   void HandleEncodedFrame(std::unique_ptr<video_coding::EncodedFrame> frame);
+  // Records the receive stages of a frame that has become complete.
+  void TraceCompleteFrame(const video_coding::EncodedFrame& frame);
   void HandleFrameBufferTimeout();
 
   void UpdatePlayoutDelays() const
@@ -148,6 +158,13 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   SequenceChecker network_sequence_checker_;
 
   TaskQueueFactory* const task_queue_factory_;
+  // If set, |decode_queue_| runs on this pool, shared with other streams.
+  DecodeThreadPool* const decode_thread_pool_;
+  // The resolution of the last rendered frame, which is the priority of
+  // |decode_queue_| in |decode_thread_pool_|. Only accessed in OnFrame().
+  int64_t decode_priority_ = 0;
+  // If set, the render queue of |incoming_video_stream_| runs on this pool.
+  DecodeThreadPool* const render_thread_pool_;
 
   TransportAdapter transport_adapter_;
   const VideoReceiveStream::Config config_;
@@ -162,6 +179,8 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
   SourceTracker source_tracker_;
   ReceiveStatisticsProxy stats_proxy_;
+  // Only set if enabled by field trial. Thread safe.
+  const std::unique_ptr<FrameStageTracer> frame_stage_tracer_;
   // Shared by media and rtx stream receivers, since the latter has no RtpRtcp
   // module of its own.
   const std::unique_ptr<ReceiveStatistics> rtp_receive_statistics_;
@@ -198,6 +217,10 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   const int max_wait_for_keyframe_ms_;
   const int max_wait_for_frame_ms_;
 
+  rtc::CriticalSection encoded_frame_sink_lock_;
+  EncodedFrameSink* encoded_frame_sink_
+      RTC_GUARDED_BY(encoded_frame_sink_lock_) = nullptr;
+
   rtc::CriticalSection playout_delay_lock_;
 
   // All of them tries to change current min_playout_delay on |timing_| but
@@ -68,6 +68,13 @@ class MockVideoDecoder : public VideoDecoder {
   const char* ImplementationName() const { return "MockVideoDecoder"; }
 };
 
+class MockEncodedFrameSink : public VideoReceiveStream::EncodedFrameSink {
+ public:
+  MOCK_METHOD2(OnEncodedFrame,
+               void(const EncodedImage& encoded_image,
+                    const CodecSpecificInfo& codec_specific_info));
+};
+
 class FrameObjectFake : public video_coding::EncodedFrame {
  public:
   void SetPayloadType(uint8_t payload_type) { _payloadType = payload_type; }
@@ -118,7 +125,8 @@ class VideoReceiveStreamTest : public ::testing::Test {
         std::make_unique<webrtc::internal::VideoReceiveStream>(
             task_queue_factory_.get(), &rtp_stream_receiver_controller_,
             kDefaultNumCpuCores, &packet_router_, config_.Copy(),
-            process_thread_.get(), &call_stats_, clock_, timing_);
+            process_thread_.get(), &call_stats_, clock_, timing_,
+            /*decode_thread_pool=*/nullptr, /*render_thread_pool=*/nullptr);
   }
 
  protected:
@@ -254,7 +262,8 @@ class VideoReceiveStreamTestWithFakeDecoder : public ::testing::Test {
     video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream(
         task_queue_factory_.get(), &rtp_stream_receiver_controller_,
         kDefaultNumCpuCores, &packet_router_, config_.Copy(),
-        process_thread_.get(), &call_stats_, clock_, timing_));
+        process_thread_.get(), &call_stats_, clock_, timing_,
+        /*decode_thread_pool=*/nullptr, /*render_thread_pool=*/nullptr));
   }
 
  protected:
@@ -313,6 +322,27 @@ TEST_F(VideoReceiveStreamTestWithFakeDecoder, PassesPacketInfos) {
   EXPECT_THAT(fake_renderer_.packet_infos(), ElementsAreArray(packet_infos));
 }
 
+TEST_F(VideoReceiveStreamTestWithFakeDecoder, PassesEncodedFramesToSink) {
+  constexpr uint32_t kRtpTimestamp = 12345;
+  auto test_frame = std::make_unique<FrameObjectFake>();
+  test_frame->SetPayloadType(99);
+  test_frame->id.picture_id = 0;
+  test_frame->SetTimestamp(kRtpTimestamp);
+
+  MockEncodedFrameSink sink;
+  EXPECT_CALL(sink, OnEncodedFrame(_, _))
+      .WillOnce(Invoke([&](const EncodedImage& encoded_image,
+                           const CodecSpecificInfo& codec_specific_info) {
+        EXPECT_EQ(kRtpTimestamp, encoded_image.Timestamp());
+      }));
+  video_receive_stream_->SetEncodedFrameSink(&sink);
+  video_receive_stream_->Start();
+  video_receive_stream_->OnCompleteFrame(std::move(test_frame));
+  // The frame is passed to the sink before it's decoded and rendered.
+  EXPECT_TRUE(fake_renderer_.WaitForRenderedFrame(kDefaultTimeOutMs));
+  video_receive_stream_->SetEncodedFrameSink(nullptr);
+}
+
 TEST_F(VideoReceiveStreamTestWithFakeDecoder, RenderedFrameUpdatesGetSources) {
   constexpr uint32_t kSsrc = 1111;
   constexpr uint32_t kCsrc = 9001;
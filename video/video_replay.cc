@@ -8,11 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include <fstream>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -23,7 +25,14 @@
 #include "call/call.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "media/engine/internal_decoder_factory.h"
+#include "modules/rtp_rtcp/include/receive_statistics.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/utility/include/process_thread.h"
+#include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/numerics/samples_stats_counter.h"
 #include "rtc_base/string_to_number.h"
 #include "rtc_base/strings/json.h"
 #include "rtc_base/time_utils.h"
@@ -42,6 +51,7 @@
 #include "test/test_video_capturer.h"
 #include "test/testsupport/frame_writer.h"
 #include "test/video_renderer.h"
+#include "video/rtp_video_stream_receiver.h"
 
 // Flag for payload type.
 ABSL_FLAG(int,
@@ -114,6 +124,13 @@ ABSL_FLAG(std::string,
 // Flag for video codec.
 ABSL_FLAG(std::string, codec, "VP8", "Video codec");
 
+ABSL_FLAG(bool,
+          fast_forward,
+          false,
+          "Replays the packets as fast as possible and decodes every complete "
+          "frame right away, without pacing, NACK or jitter buffer waits, then "
+          "prints the decode throughput. Uses the configuration from flags.");
+
 namespace {
 
 static bool ValidatePayloadType(int32_t payload_type) {
@@ -188,6 +205,10 @@ static std::string DecoderBitstreamFilename() {
   return absl::GetFlag(FLAGS_decoder_bitstream_filename);
 }
 
+static bool FastForward() {
+  return absl::GetFlag(FLAGS_fast_forward);
+}
+
 static std::string Codec() {
   return absl::GetFlag(FLAGS_codec);
 }
@@ -254,6 +275,97 @@ class DecoderBitstreamFileWriter : public test::FakeDecoder {
   FILE* file_;
 };
 
+// Decodes the complete frames of a RtpVideoStreamReceiver as soon as they are
+// assembled, and measures the time from Decode() until the decoded frame is
+// delivered, which also covers decoders that deliver asynchronously.
+class FrameDecodeMeter : public video_coding::OnCompleteFrameCallback,
+                         public DecodedImageCallback {
+ public:
+  explicit FrameDecodeMeter(std::unique_ptr<VideoDecoder> decoder)
+      : decoder_(std::move(decoder)) {
+    decoder_->RegisterDecodeCompleteCallback(this);
+  }
+  ~FrameDecodeMeter() override { decoder_->Release(); }
+
+  bool InitDecode(const VideoCodec& codec) {
+    return decoder_->InitDecode(&codec, /*number_of_cores=*/1) ==
+           WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // Decodes the frames completed since the last call, and returns their ids
+  // so that the receiver can release the packets they were assembled from.
+  std::vector<int64_t> DecodePendingFrames() {
+    std::vector<int64_t> decoded_picture_ids;
+    for (auto& frame : pending_frames_) {
+      if (!has_decoded_keyframe_ &&
+          frame->FrameType() != VideoFrameType::kVideoFrameKey) {
+        ++frames_skipped_;
+        continue;
+      }
+      decode_start_time_us_[frame->Timestamp()] = rtc::TimeMicros();
+      if (decoder_->Decode(frame->EncodedImage(), /*missing_frames=*/false,
+                           /*render_time_ms=*/0) != WEBRTC_VIDEO_CODEC_OK) {
+        decode_start_time_us_.erase(frame->Timestamp());
+        ++decode_errors_;
+        continue;
+      }
+      has_decoded_keyframe_ = true;
+      decoded_picture_ids.push_back(frame->id.picture_id);
+    }
+    pending_frames_.clear();
+    return decoded_picture_ids;
+  }
+
+  void PrintStats(int64_t elapsed_us) {
+    printf("frames_decoded: %d\n", frames_decoded_);
+    printf("frames_skipped_before_keyframe: %d\n", frames_skipped_);
+    printf("decode_errors: %d\n", decode_errors_);
+    if (decode_latency_ms_.IsEmpty())
+      return;
+    printf("replay_fps: %.1f\n",
+           frames_decoded_ * static_cast<double>(rtc::kNumMicrosecsPerSec) /
+               elapsed_us);
+    printf("max_decode_fps: %.1f\n",
+           1000.0 / decode_latency_ms_.GetAverage());
+    printf("decode_latency_ms: mean %.2f, p50 %.2f, p95 %.2f, p99 %.2f, "
+           "max %.2f\n",
+           decode_latency_ms_.GetAverage(),
+           decode_latency_ms_.GetPercentile(0.5),
+           decode_latency_ms_.GetPercentile(0.95),
+           decode_latency_ms_.GetPercentile(0.99),
+           decode_latency_ms_.GetMax());
+  }
+
+ private:
+  void OnCompleteFrame(
+      std::unique_ptr<video_coding::EncodedFrame> frame) override {
+    // Decoded later, since the receiver must not be called back into from
+    // this callback.
+    pending_frames_.push_back(std::move(frame));
+  }
+
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    auto it = decode_start_time_us_.find(decoded_image.timestamp());
+    if (it != decode_start_time_us_.end()) {
+      decode_latency_ms_.AddSample(
+          static_cast<double>(rtc::TimeMicros() - it->second) /
+          rtc::kNumMicrosecsPerMillisec);
+      decode_start_time_us_.erase(decode_start_time_us_.begin(), ++it);
+    }
+    ++frames_decoded_;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  const std::unique_ptr<VideoDecoder> decoder_;
+  std::vector<std::unique_ptr<video_coding::EncodedFrame>> pending_frames_;
+  std::map<uint32_t, int64_t> decode_start_time_us_;
+  bool has_decoded_keyframe_ = false;
+  int frames_decoded_ = 0;
+  int frames_skipped_ = 0;
+  int decode_errors_ = 0;
+  SamplesStatsCounter decode_latency_ms_;
+};
+
 // The RtpReplayer is responsible for parsing the configuration provided by the
 // user, setting up the windows, recieve streams and decoders and then replaying
 // the provided RTP dump.
@@ -294,6 +406,89 @@ class RtpReplayer final {
     }
   }
 
+  // Replays a rtp dump configured from flags as fast as possible. The packets
+  // go straight into a RtpVideoStreamReceiver without NACK, and every complete
+  // frame is decoded right away instead of waiting in the frame buffer for its
+  // render time.
+  static void ReplayFastForward(const std::string& rtp_dump_path) {
+    std::unique_ptr<test::RtpFileReader> rtp_reader =
+        CreateRtpReader(rtp_dump_path);
+    if (rtp_reader == nullptr) {
+      return;
+    }
+    test::NullTransport transport;
+    VideoReceiveStream::Config receive_config(&transport);
+    receive_config.rtp.remote_ssrc = Ssrc();
+    receive_config.rtp.local_ssrc = kReceiverLocalSsrc;
+    receive_config.rtp.ulpfec_payload_type = UlpfecPayloadType();
+    receive_config.rtp.red_payload_type = RedPayloadType();
+    if (TransmissionOffsetId() != -1) {
+      receive_config.rtp.extensions.push_back(RtpExtension(
+          RtpExtension::kTimestampOffsetUri, TransmissionOffsetId()));
+    }
+    if (AbsSendTimeId() != -1) {
+      receive_config.rtp.extensions.push_back(
+          RtpExtension(RtpExtension::kAbsSendTimeUri, AbsSendTimeId()));
+    }
+
+    VideoReceiveStream::Decoder decoder =
+        test::CreateMatchingDecoder(MediaPayloadType(), Codec());
+    InternalDecoderFactory decoder_factory;
+    FrameDecodeMeter meter(
+        decoder_factory.CreateVideoDecoder(decoder.video_format));
+    VideoCodec codec;
+    codec.plType = decoder.payload_type;
+    codec.codecType = PayloadStringToCodecType(decoder.video_format.name);
+    codec.width = 320;
+    codec.height = 180;
+    if (!meter.InitDecode(codec)) {
+      fprintf(stderr, "Unable to initialize the %s decoder\n",
+              Codec().c_str());
+      return;
+    }
+
+    Clock* clock = Clock::GetRealTimeClock();
+    std::unique_ptr<ReceiveStatistics> receive_statistics =
+        ReceiveStatistics::Create(clock);
+    std::unique_ptr<ProcessThread> process_thread =
+        ProcessThread::Create("FastForwardProcess");
+    RtpVideoStreamReceiver receiver(
+        clock, &transport, /*rtt_stats=*/nullptr, /*packet_router=*/nullptr,
+        &receive_config, receive_statistics.get(),
+        /*receive_stats_proxy=*/nullptr, process_thread.get(),
+        /*nack_sender=*/nullptr, /*keyframe_request_sender=*/nullptr, &meter,
+        /*frame_decryptor=*/nullptr);
+    receiver.AddReceiveCodec(codec, decoder.video_format.parameters,
+                             /*raw_payload=*/false);
+    receiver.StartReceive();
+
+    RtpHeaderExtensionMap extensions(receive_config.rtp.extensions);
+    int num_packets = 0;
+    const int64_t start_memory_bytes = rtc::GetProcessResidentSizeBytes();
+    const int64_t start_time_us = rtc::TimeMicros();
+    test::RtpPacket packet;
+    while (rtp_reader->NextPacket(&packet)) {
+      RtpPacketReceived parsed_packet(&extensions);
+      if (!parsed_packet.Parse(packet.data, packet.length) ||
+          parsed_packet.Ssrc() != Ssrc()) {
+        continue;
+      }
+      parsed_packet.set_arrival_time_ms(clock->TimeInMilliseconds());
+      parsed_packet.set_payload_type_frequency(kVideoPayloadTypeFrequency);
+      ++num_packets;
+      receiver.OnRtpPacket(parsed_packet);
+      for (int64_t picture_id : meter.DecodePendingFrames())
+        receiver.FrameDecoded(picture_id);
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_time_us;
+    receiver.StopReceive();
+
+    printf("num_packets: %d\n", num_packets);
+    meter.PrintStats(elapsed_us);
+    printf("memory_growth_kb: %" PRId64 "\n",
+           (rtc::GetProcessResidentSizeBytes() - start_memory_bytes) / 1024);
+  }
+
  private:
   // Holds all the shared memory structures required for a recieve stream. This
   // structure is used to prevent members being deallocated before the replay
@@ -495,6 +690,10 @@ class RtpReplayer final {
 };  // class RtpReplayer
 
 void RtpReplay() {
+  if (FastForward()) {
+    RtpReplayer::ReplayFastForward(InputFile());
+    return;
+  }
   RtpReplayer::Replay(ConfigFile(), InputFile());
 }
 
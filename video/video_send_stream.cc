@@ -14,9 +14,12 @@
 #include "api/array_view.h"
 #include "api/video/video_stream_encoder_create.h"
 #include "api/video/video_stream_encoder_settings.h"
+#include "common_video/h264/h264_common.h"
+#include "modules/include/module_common_types.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
+#include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/task_utils/to_queued_task.h"
@@ -186,6 +189,28 @@ VideoSendStream::Stats VideoSendStream::GetStats() {
   return stats_proxy_.GetStats();
 }
 
+void VideoSendStream::SendEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info) {
+  // The H.264 packetizer needs the NAL units, which the encoder would have
+  // provided. Received frames have start codes, so they can be found again.
+  RTPFragmentationHeader fragmentation;
+  if (codec_specific_info.codecType == kVideoCodecH264) {
+    std::vector<H264::NaluIndex> nalu_indices =
+        H264::FindNaluIndices(encoded_image.data(), encoded_image.size());
+    fragmentation.VerifyAndAllocateFragmentationHeader(nalu_indices.size());
+    for (size_t i = 0; i < nalu_indices.size(); ++i) {
+      fragmentation.fragmentationOffset[i] =
+          nalu_indices[i].payload_start_offset;
+      fragmentation.fragmentationLength[i] = nalu_indices[i].payload_size;
+    }
+  }
+  stats_proxy_.OnSendEncodedImage(encoded_image, &codec_specific_info);
+  send_stream_->SendEncodedImage(
+      encoded_image, codec_specific_info,
+      fragmentation.Size() > 0 ? &fragmentation : nullptr);
+}
+
 absl::optional<float> VideoSendStream::GetPacingFactorOverride() const {
   return send_stream_->configured_pacing_factor_;
 }
@@ -201,7 +201,10 @@ VideoSendStreamImpl::VideoSendStreamImpl(
       encoder_bitrate_priority_(initial_encoder_bitrate_priority),
       has_packet_feedback_(false),
       video_stream_encoder_(video_stream_encoder),
-      encoder_feedback_(clock, config_->rtp.ssrcs, video_stream_encoder),
+      encoder_feedback_(clock,
+                        config_->rtp.ssrcs,
+                        video_stream_encoder,
+                        config_->key_frame_request_observer),
       bandwidth_observer_(transport->GetBandwidthObserver()),
       rtp_video_sender_(transport_->CreateRtpVideoSender(
           suspended_ssrcs,
@@ -555,6 +558,21 @@ void VideoSendStreamImpl::OnEncoderConfigurationChanged(
   }
 }
 
+void VideoSendStreamImpl::OnSuperframeStarted() {
+  rtp_video_sender_->OnSuperframeStarted();
+}
+
+void VideoSendStreamImpl::OnSuperframeEnded() {
+  rtp_video_sender_->OnSuperframeEnded();
+}
+
+void VideoSendStreamImpl::SendEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info,
+    const RTPFragmentationHeader* fragmentation) {
+  OnEncodedImage(encoded_image, &codec_specific_info, fragmentation);
+}
+
 EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info,
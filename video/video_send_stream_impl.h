@@ -104,6 +104,12 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   void Start();
   void Stop();
 
+  // Sends a frame that wasn't encoded by |video_stream_encoder|, see
+  // VideoSendStream::SendEncodedImage(). May be called on any thread.
+  void SendEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo& codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation);
+
   // TODO(holmer): Move these to RtpTransportControllerSend.
   std::map<uint32_t, RtpState> GetRtpStates() const;
 
@@ -119,6 +125,8 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
       std::vector<VideoStream> streams,
       VideoEncoderConfig::ContentType content_type,
       int min_transmit_bitrate_bps) override;
+  void OnSuperframeStarted() override;
+  void OnSuperframeEnded() override;
 
   // Implements EncodedImageCallback. The implementation routes encoded frames
   // to the |payload_router_| and |config.pre_encode_callback| if set.
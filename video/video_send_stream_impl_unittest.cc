@@ -67,6 +67,8 @@ class MockRtpVideoSender : public RtpVideoSenderInterface {
   MOCK_CONST_METHOD0(GetRtpPayloadStates,
                      std::map<uint32_t, RtpPayloadState>());
   MOCK_METHOD2(DeliverRtcp, void(const uint8_t*, size_t));
+  MOCK_METHOD0(OnSuperframeStarted, void());
+  MOCK_METHOD0(OnSuperframeEnded, void());
   MOCK_METHOD1(OnBitrateAllocationUpdated, void(const VideoBitrateAllocation&));
   MOCK_METHOD3(OnEncodedImage,
                EncodedImageCallback::Result(const EncodedImage&,
@@ -12,6 +12,7 @@
 
 #include "modules/video_coding/video_receiver2.h"
 #include "rtc_base/checks.h"
+#include "video/frame_stage_tracer.h"
 #include "video/receive_statistics_proxy.h"
 
 namespace webrtc {
@@ -19,10 +20,12 @@ namespace webrtc {
 VideoStreamDecoder::VideoStreamDecoder(
     VideoReceiver2* video_receiver,
     ReceiveStatisticsProxy* receive_statistics_proxy,
-    rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream)
+    rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream,
+    FrameStageTracer* frame_stage_tracer)
     : video_receiver_(video_receiver),
       receive_stats_callback_(receive_statistics_proxy),
-      incoming_video_stream_(incoming_video_stream) {
+      incoming_video_stream_(incoming_video_stream),
+      frame_stage_tracer_(frame_stage_tracer) {
   RTC_DCHECK(video_receiver_);
 
   video_receiver_->RegisterReceiveCallback(this);
@@ -47,6 +50,10 @@ int32_t VideoStreamDecoder::FrameToRender(VideoFrame& video_frame,
                                           VideoContentType content_type) {
   receive_stats_callback_->OnDecodedFrame(video_frame, qp, decode_time_ms,
                                           content_type);
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(video_frame.timestamp(),
+                                 FrameStageTracer::Stage::kDecoded);
+  }
   incoming_video_stream_->OnFrame(video_frame);
   return 0;
 }
@@ -25,15 +25,18 @@
 
 namespace webrtc {
 
+class FrameStageTracer;
 class ReceiveStatisticsProxy;
 class VideoReceiver2;
 
 class VideoStreamDecoder : public VCMReceiveCallback {
  public:
+  // |frame_stage_tracer| may be null.
   VideoStreamDecoder(
       VideoReceiver2* video_receiver,
       ReceiveStatisticsProxy* receive_statistics_proxy,
-      rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream);
+      rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream,
+      FrameStageTracer* frame_stage_tracer);
   ~VideoStreamDecoder() override;
 
   // Implements VCMReceiveCallback.
@@ -56,6 +59,7 @@ class VideoStreamDecoder : public VCMReceiveCallback {
 
   ReceiveStatisticsProxy* const receive_stats_callback_;
   rtc::VideoSinkInterface<VideoFrame>* const incoming_video_stream_;
+  FrameStageTracer* const frame_stage_tracer_;
 };
 
 }  // namespace webrtc
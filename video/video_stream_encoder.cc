@@ -23,12 +23,15 @@
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/codecs/vp9/svc_rate_allocator.h"
 #include "modules/video_coding/include/video_codec_initializer.h"
 #include "modules/video_coding/utility/default_video_bitrate_allocator.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/alr_experiment.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/quality_scaling_experiment.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/location.h"
@@ -52,6 +55,12 @@ const int64_t kPendingFrameTimeoutMs = 1000;
 
 const char kInitialFramedropFieldTrial[] = "WebRTC-InitialFramedrop";
 constexpr char kFrameDropperFieldTrial[] = "WebRTC-FrameDropper";
+constexpr char kEncoderQueueFrameDropperFieldTrial[] =
+    "WebRTC-EncoderQueueFrameDropper";
+constexpr char kSkipStaticScreenshareFramesFieldTrial[] =
+    "WebRTC-Video-SkipStaticScreenshareFrames";
+constexpr char kReinitializeEncoderInPlaceFieldTrial[] =
+    "WebRTC-Video-ReinitializeEncoderInPlace";
 
 // The maximum number of frames to drop at beginning of stream
 // to try and achieve desired bitrate.
@@ -72,6 +81,28 @@ uint32_t abs_diff(uint32_t a, uint32_t b) {
   return (a < b) ? b - a : a - b;
 }
 
+// Returns nullptr unless a positive "max_latency_ms" is configured in the
+// field trial.
+std::unique_ptr<EncoderQueueFrameDropper> CreateEncoderQueueFrameDropper() {
+  FieldTrialOptional<int> max_latency_ms("max_latency_ms");
+  ParseFieldTrial({&max_latency_ms}, field_trial::FindFullName(
+                                         kEncoderQueueFrameDropperFieldTrial));
+  if (!max_latency_ms || *max_latency_ms <= 0)
+    return nullptr;
+  return std::make_unique<EncoderQueueFrameDropper>(*max_latency_ms);
+}
+
+// Returns nullopt unless a positive "max_skip_ms" is configured in the field
+// trial.
+absl::optional<int64_t> ParseStaticFrameMaxSkipMs() {
+  FieldTrialOptional<int> max_skip_ms("max_skip_ms");
+  ParseFieldTrial({&max_skip_ms}, field_trial::FindFullName(
+                                      kSkipStaticScreenshareFramesFieldTrial));
+  if (!max_skip_ms || *max_skip_ms <= 0)
+    return absl::nullopt;
+  return *max_skip_ms;
+}
+
 bool IsResolutionScalingEnabled(DegradationPreference degradation_preference) {
   return degradation_preference == DegradationPreference::MAINTAIN_FRAMERATE ||
          degradation_preference == DegradationPreference::BALANCED;
@@ -499,6 +530,8 @@ VideoStreamEncoder::VideoStreamEncoder(
       overuse_detector_(std::move(overuse_detector)),
       encoder_stats_observer_(encoder_stats_observer),
       encoder_initialized_(false),
+      reinitialize_encoder_in_place_(
+          field_trial::IsEnabled(kReinitializeEncoderInPlaceFieldTrial)),
       max_framerate_(-1),
       pending_encoder_reconfiguration_(false),
       pending_encoder_creation_(false),
@@ -521,6 +554,11 @@ VideoStreamEncoder::VideoStreamEncoder(
       last_frame_log_ms_(clock_->TimeInMilliseconds()),
       captured_frame_count_(0),
       dropped_frame_count_(0),
+      encoder_queue_frame_dropper_(CreateEncoderQueueFrameDropper()),
+      static_frame_max_skip_ms_(ParseStaticFrameMaxSkipMs()),
+      last_encoded_frame_ms_(-1),
+      frame_stage_tracer_(FrameStageTracer::CreateIfEnabled(
+          clock_, FrameStageTracer::Stage::kEncoded)),
       pending_frame_post_time_us_(0),
       accumulated_update_rect_{0, 0, 0, 0},
       bitrate_observer_(nullptr),
@@ -892,7 +930,14 @@ void VideoStreamEncoder::ReconfigureEncoder() {
   // encoder_->InitEncode().
   bool success = true;
   if (encoder_reset_required) {
-    ReleaseEncoder();
+    // InitEncode() may be called on an initialized encoder, but some external
+    // encoders don't handle that, so by default the encoder is released first.
+    // Built-in encoders release their state in InitEncode() as needed, and
+    // LibvpxVp8Encoder applies a change of resolution without recreating the
+    // libvpx encoder.
+    if (!reinitialize_encoder_in_place_) {
+      ReleaseEncoder();
+    }
     const size_t max_data_payload_length = max_data_payload_length_ > 0
                                                ? max_data_payload_length_
                                                : kDefaultPayloadSize;
@@ -1107,19 +1152,37 @@ void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
   int64_t post_time_us = rtc::TimeMicros();
   ++posted_frames_waiting_for_encode_;
 
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(incoming_frame.timestamp(),
+                                 FrameStageTracer::Stage::kCaptured,
+                                 incoming_frame.timestamp_us());
+    frame_stage_tracer_->OnStage(incoming_frame.timestamp(),
+                                 FrameStageTracer::Stage::kEncoderQueued,
+                                 current_time_us);
+  }
+
   encoder_queue_.PostTask(
       [this, incoming_frame, post_time_us, log_stats]() {
         RTC_DCHECK_RUN_ON(&encoder_queue_);
+        if (frame_stage_tracer_) {
+          frame_stage_tracer_->OnStage(
+              incoming_frame.timestamp(),
+              FrameStageTracer::Stage::kEncoderDequeued);
+        }
         encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
                                                  incoming_frame.height());
         ++captured_frame_count_;
         const int posted_frames_waiting_for_encode =
             posted_frames_waiting_for_encode_.fetch_sub(1);
         RTC_DCHECK_GT(posted_frames_waiting_for_encode, 0);
-        if (posted_frames_waiting_for_encode == 1) {
+        if (posted_frames_waiting_for_encode == 1 &&
+            !(encoder_queue_frame_dropper_ &&
+              encoder_queue_frame_dropper_->DropFrame(rtc::TimeMicros() -
+                                                      post_time_us))) {
           MaybeEncodeVideoFrame(incoming_frame, post_time_us);
         } else {
-          // There is a newer frame in flight. Do not encode this frame.
+          // There is a newer frame in flight, or this frame would be encoded
+          // too late. Do not encode this frame.
           RTC_LOG(LS_VERBOSE)
               << "Incoming frame dropped due to that the encoder is blocked.";
           ++dropped_frame_count_;
@@ -1135,6 +1198,17 @@ void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
                            << kFrameLogIntervalMs;
           captured_frame_count_ = 0;
           dropped_frame_count_ = 0;
+          if (encoder_queue_frame_dropper_) {
+            const EncoderQueueFrameDropper::Stats stats =
+                encoder_queue_frame_dropper_->GetAndResetStats();
+            RTC_LOG(LS_INFO)
+                << "Encoder queue: frames " << stats.num_frames
+                << ", dropped for latency " << stats.num_dropped_frames
+                << ", avg queue time ms "
+                << stats.avg_queue_time_ms.value_or(-1)
+                << ", max queue time ms "
+                << stats.max_queue_time_ms.value_or(-1);
+          }
         }
       });
 }
@@ -1380,6 +1454,11 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
 
   pending_frame_.reset();
 
+  if (SkipStaticFrame(video_frame, now_ms)) {
+    RTC_LOG(LS_VERBOSE) << "Skipping screenshare frame without updates.";
+    return;
+  }
+
   frame_dropper_.Leak(framerate_fps);
   // Frame dropping is enabled iff frame dropping is not force-disabled, and
   // rate controller is not trusted.
@@ -1401,9 +1480,30 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
     return;
   }
 
+  last_encoded_frame_ms_ = now_ms;
   EncodeVideoFrame(video_frame, time_when_posted_us);
 }
 
+bool VideoStreamEncoder::SkipStaticFrame(const VideoFrame& frame,
+                                         int64_t now_ms) const {
+  if (!static_frame_max_skip_ms_ ||
+      encoder_config_.content_type !=
+          VideoEncoderConfig::ContentType::kScreen ||
+      last_encoded_frame_ms_ < 0 ||
+      now_ms - last_encoded_frame_ms_ >= *static_frame_max_skip_ms_) {
+    return false;
+  }
+  // Updates of frames dropped since the last encoded frame must still be sent.
+  if (!frame.update_rect().IsEmpty() || !accumulated_update_rect_.IsEmpty())
+    return false;
+  // A requested key frame is not delayed.
+  for (VideoFrameType frame_type : next_frame_types_) {
+    if (frame_type == VideoFrameType::kVideoFrameKey)
+      return false;
+  }
+  return true;
+}
+
 void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
                                           int64_t time_when_posted_us) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -1442,15 +1542,18 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
   const VideoFrameBuffer::Type buffer_type =
       out_frame.video_frame_buffer()->type();
+  // Hardware encoders may take e.g. NV12 as is, see |preferred_pixel_formats|.
   const bool is_buffer_type_supported =
       buffer_type == VideoFrameBuffer::Type::kI420 ||
       (buffer_type == VideoFrameBuffer::Type::kNative &&
-       info.supports_native_handle);
+       info.supports_native_handle) ||
+      (buffer_type != VideoFrameBuffer::Type::kNative &&
+       absl::c_linear_search(info.preferred_pixel_formats, buffer_type));
 
   if (!is_buffer_type_supported) {
     // This module only supports software encoding.
-    rtc::scoped_refptr<I420BufferInterface> converted_buffer(
-        out_frame.video_frame_buffer()->ToI420());
+    rtc::scoped_refptr<I420BufferInterface> converted_buffer(ConvertToI420(
+        out_frame.video_frame_buffer(), I420BufferPool::Shared()));
 
     if (!converted_buffer) {
       RTC_LOG(LS_ERROR) << "Frame conversion failed, dropping frame.";
@@ -1483,22 +1586,34 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
     }
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
-    rtc::scoped_refptr<I420Buffer> cropped_buffer =
-        I420Buffer::Create(cropped_width, cropped_height);
+    rtc::scoped_refptr<I420BufferInterface> cropped_buffer;
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
     if (crop_width_ < 4 && crop_height_ < 4) {
-      cropped_buffer->CropAndScaleFrom(*i420_buffer, crop_width_ / 2,
-                                       crop_height_ / 2, cropped_width,
-                                       cropped_height);
+      rtc::scoped_refptr<I420Buffer> buffer =
+          I420BufferPool::Shared()->CreateBuffer(cropped_width, cropped_height);
+      buffer->CropAndScaleFrom(*i420_buffer, crop_width_ / 2, crop_height_ / 2,
+                               cropped_width, cropped_height);
+      cropped_buffer = buffer;
       update_rect.offset_x -= crop_width_ / 2;
       update_rect.offset_y -= crop_height_ / 2;
       update_rect.Intersect(
           VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
 
     } else {
-      cropped_buffer->ScaleFrom(*i420_buffer);
+      // Reuse the scaling done by other consumers of the frame, if any.
+      if (video_frame.scaled_buffer_cache()) {
+        cropped_buffer = video_frame.scaled_buffer_cache()->GetScaledI420(
+            cropped_width, cropped_height);
+      }
+      if (!cropped_buffer) {
+        rtc::scoped_refptr<I420Buffer> buffer =
+            I420BufferPool::Shared()->CreateBuffer(cropped_width,
+                                                   cropped_height);
+        buffer->ScaleFrom(*i420_buffer);
+        cropped_buffer = buffer;
+      }
       if (!update_rect.IsEmpty()) {
         // Since we can't reason about pixels after scaling, we invalidate whole
         // picture, if anything changed.
@@ -1544,8 +1659,14 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
                out_frame.timestamp());
 
   frame_encode_metadata_writer_.OnEncodeStarted(out_frame);
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(out_frame.timestamp(),
+                                 FrameStageTracer::Stage::kEncodeStarted);
+  }
 
+  sink_->OnSuperframeStarted();
   const int32_t encode_status = encoder_->Encode(out_frame, &next_frame_types_);
+  sink_->OnSuperframeEnded();
   was_encode_called_since_last_initialization_ = true;
 
   if (encode_status < 0) {
@@ -1629,6 +1750,10 @@ EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
     const RTPFragmentationHeader* fragmentation) {
   TRACE_EVENT_INSTANT1("webrtc", "VCMEncodedFrameCallback::Encoded",
                        "timestamp", encoded_image.Timestamp());
+  if (frame_stage_tracer_) {
+    frame_stage_tracer_->OnStage(encoded_image.Timestamp(),
+                                 FrameStageTracer::Stage::kEncoded);
+  }
   const size_t spatial_idx = encoded_image.SpatialIndex().value_or(0);
   EncodedImage image_copy(encoded_image);
 
@@ -2208,6 +2333,9 @@ void VideoStreamEncoder::RunPostEncode(EncodedImage encoded_image,
     }
   }
 
+  if (encoder_queue_frame_dropper_ && encode_duration_us)
+    encoder_queue_frame_dropper_->OnFrameEncoded(*encode_duration_us);
+
   overuse_detector_->FrameSent(
       encoded_image.Timestamp(), time_sent_us,
       encoded_image.capture_time_ms_ * rtc::kNumMicrosecsPerMillisec,
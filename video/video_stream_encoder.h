@@ -40,6 +40,8 @@
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
 #include "video/encoder_bitrate_adjuster.h"
+#include "video/encoder_queue_frame_dropper.h"
+#include "video/frame_stage_tracer.h"
 #include "video/frame_encode_metadata_writer.h"
 #include "video/overuse_frame_detector.h"
 
@@ -158,6 +160,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // Indicates wether frame should be dropped because the pixel count is too
   // large for the current bitrate configuration.
   bool DropDueToSize(uint32_t pixel_count) const RTC_RUN_ON(&encoder_queue_);
+  // Indicates whether a screenshare frame should be skipped because nothing
+  // changed since the last encoded frame.
+  bool SkipStaticFrame(const VideoFrame& frame, int64_t now_ms) const
+      RTC_RUN_ON(&encoder_queue_);
 
   // Implements EncodedImageCallback.
   EncodedImageCallback::Result OnEncodedImage(
@@ -261,6 +267,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   std::unique_ptr<VideoEncoder> encoder_ RTC_GUARDED_BY(&encoder_queue_)
       RTC_PT_GUARDED_BY(&encoder_queue_);
   bool encoder_initialized_;
+  // If set, an initialized encoder is reconfigured by calling InitEncode()
+  // without releasing it first, so that encoders that support it can apply
+  // the change in place. Enabled by field trial.
+  const bool reinitialize_encoder_in_place_;
   std::unique_ptr<VideoBitrateAllocator> rate_allocator_
       RTC_GUARDED_BY(&encoder_queue_) RTC_PT_GUARDED_BY(&encoder_queue_);
   // The maximum frame rate of the current codec configuration, as determined
@@ -331,6 +341,16 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   int64_t last_frame_log_ms_ RTC_GUARDED_BY(incoming_frame_race_checker_);
   int captured_frame_count_ RTC_GUARDED_BY(&encoder_queue_);
   int dropped_frame_count_ RTC_GUARDED_BY(&encoder_queue_);
+  // Drops frames that have waited too long in the encoder queue. Only set if
+  // enabled by field trial.
+  const std::unique_ptr<EncoderQueueFrameDropper> encoder_queue_frame_dropper_
+      RTC_PT_GUARDED_BY(&encoder_queue_);
+  // Screenshare frames with an empty update rect are skipped for up to this
+  // long after the last encoded frame. Only set if enabled by field trial.
+  const absl::optional<int64_t> static_frame_max_skip_ms_;
+  int64_t last_encoded_frame_ms_ RTC_GUARDED_BY(&encoder_queue_);
+  // Only set if enabled by field trial. Thread safe.
+  const std::unique_ptr<FrameStageTracer> frame_stage_tracer_;
   absl::optional<VideoFrame> pending_frame_ RTC_GUARDED_BY(&encoder_queue_);
   int64_t pending_frame_post_time_us_ RTC_GUARDED_BY(&encoder_queue_);
 
@@ -20,6 +20,7 @@
 #include "api/test/mock_fec_controller_override.h"
 #include "api/video/builtin_video_bitrate_allocator_factory.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
@@ -472,6 +473,20 @@ class VideoStreamEncoderTest : public ::testing::Test {
     return frame;
   }
 
+  VideoFrame CreateNV12Frame(int64_t ntp_time_ms) const {
+    rtc::scoped_refptr<NV12Buffer> buffer =
+        NV12Buffer::Create(codec_width_, codec_height_);
+    buffer->InitializeData();
+    VideoFrame frame = VideoFrame::Builder()
+                           .set_video_frame_buffer(buffer)
+                           .set_timestamp_rtp(99)
+                           .set_timestamp_ms(99)
+                           .set_rotation(kVideoRotation_0)
+                           .build();
+    frame.set_ntp_time_ms(ntp_time_ms);
+    return frame;
+  }
+
   VideoFrame CreateFrameWithUpdatedPixel(int64_t ntp_time_ms,
                                          rtc::Event* destruction_event,
                                          int offset_x) const {
@@ -696,6 +711,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
       }
 
       info.resolution_bitrate_limits = resolution_bitrate_limits_;
+      info.preferred_pixel_formats = preferred_pixel_formats_;
       return info;
     }
 
@@ -737,11 +753,27 @@ class VideoStreamEncoderTest : public ::testing::Test {
       resolution_bitrate_limits_ = thresholds;
     }
 
+    void SetPreferredPixelFormats(
+        decltype(EncoderInfo::preferred_pixel_formats) pixel_formats) {
+      rtc::CritScope lock(&local_crit_sect_);
+      preferred_pixel_formats_ = std::move(pixel_formats);
+    }
+
+    absl::optional<VideoFrameBuffer::Type> GetLastInputPixelFormat() const {
+      rtc::CritScope lock(&local_crit_sect_);
+      return last_input_pixel_format_;
+    }
+
     void ForceInitEncodeFailure(bool force_failure) {
       rtc::CritScope lock(&local_crit_sect_);
       force_init_encode_failed_ = force_failure;
     }
 
+    void AllowInitEncodeWithoutRelease(bool allow) {
+      rtc::CritScope lock(&local_crit_sect_);
+      allow_init_encode_without_release_ = allow;
+    }
+
     void SimulateOvershoot(double rate_factor) {
       rtc::CritScope lock(&local_crit_sect_);
       rate_factor_ = rate_factor;
@@ -808,6 +840,11 @@ class VideoStreamEncoderTest : public ::testing::Test {
       return num_set_rates_;
     }
 
+    int GetNumReleases() const {
+      rtc::CritScope lock(&local_crit_sect_);
+      return num_releases_;
+    }
+
    private:
     int32_t Encode(const VideoFrame& input_image,
                    const std::vector<VideoFrameType>* frame_types) override {
@@ -829,6 +866,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
         ntp_time_ms_ = input_image.ntp_time_ms();
         last_input_width_ = input_image.width();
         last_input_height_ = input_image.height();
+        last_input_pixel_format_ = input_image.video_frame_buffer()->type();
         block_encode = block_next_encode_;
         block_next_encode_ = false;
         last_update_rect_ = input_image.update_rect();
@@ -845,7 +883,9 @@ class VideoStreamEncoderTest : public ::testing::Test {
       int res = FakeEncoder::InitEncode(config, settings);
 
       rtc::CritScope lock(&local_crit_sect_);
-      EXPECT_EQ(initialized_, EncoderState::kUninitialized);
+      if (!allow_init_encode_without_release_) {
+        EXPECT_EQ(initialized_, EncoderState::kUninitialized);
+      }
 
       ++num_encoder_initializations_;
 
@@ -869,6 +909,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
       rtc::CritScope lock(&local_crit_sect_);
       EXPECT_NE(initialized_, EncoderState::kUninitialized);
       initialized_ = EncoderState::kUninitialized;
+      ++num_releases_;
       return FakeEncoder::Release();
     }
 
@@ -908,12 +949,18 @@ class VideoStreamEncoderTest : public ::testing::Test {
     int last_input_height_ RTC_GUARDED_BY(local_crit_sect_) = 0;
     bool quality_scaling_ RTC_GUARDED_BY(local_crit_sect_) = true;
     bool is_hardware_accelerated_ RTC_GUARDED_BY(local_crit_sect_) = false;
+    decltype(EncoderInfo::preferred_pixel_formats) preferred_pixel_formats_
+        RTC_GUARDED_BY(local_crit_sect_) = {VideoFrameBuffer::Type::kI420};
+    absl::optional<VideoFrameBuffer::Type> last_input_pixel_format_
+        RTC_GUARDED_BY(local_crit_sect_);
     std::unique_ptr<Vp8FrameBufferController> frame_buffer_controller_
         RTC_GUARDED_BY(local_crit_sect_);
     absl::optional<bool>
         temporal_layers_supported_[kMaxSpatialLayers] RTC_GUARDED_BY(
             local_crit_sect_);
     bool force_init_encode_failed_ RTC_GUARDED_BY(local_crit_sect_) = false;
+    bool allow_init_encode_without_release_ RTC_GUARDED_BY(local_crit_sect_) =
+        false;
     double rate_factor_ RTC_GUARDED_BY(local_crit_sect_) = 1.0;
     uint32_t last_framerate_ RTC_GUARDED_BY(local_crit_sect_) = 0;
     absl::optional<VideoEncoder::RateControlParameters>
@@ -929,6 +976,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
     std::vector<ResolutionBitrateLimits> resolution_bitrate_limits_
         RTC_GUARDED_BY(local_crit_sect_);
     int num_set_rates_ RTC_GUARDED_BY(local_crit_sect_) = 0;
+    int num_releases_ RTC_GUARDED_BY(local_crit_sect_) = 0;
   };
 
   class TestSink : public VideoStreamEncoder::EncoderSink {
@@ -1267,6 +1315,32 @@ TEST_F(VideoStreamEncoderTest, DropFrameWithFailedI420ConversionWithCrop) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, ConvertsNV12FrameIfEncoderDoesNotPreferNV12) {
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateNV12Frame(1));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420,
+            fake_encoder_.GetLastInputPixelFormat());
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, PassesNV12FrameToEncoderPreferringNV12) {
+  fake_encoder_.SetPreferredPixelFormats(
+      {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateNV12Frame(1));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12,
+            fake_encoder_.GetLastInputPixelFormat());
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest,
        ConfigureEncoderTriggersOnEncoderConfigurationChanged) {
   video_stream_encoder_->OnBitrateUpdated(
@@ -1322,6 +1396,35 @@ TEST_F(VideoStreamEncoderTest, FrameResolutionChangeReconfigureEncoder) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest,
+       FrameResolutionChangeReinitializesEncoderInPlaceWhenEnabled) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-ReinitializeEncoderInPlace/Enabled/");
+  // Reset encoder for field trials to take effect.
+  ConfigureEncoder(video_encoder_config_.Copy());
+  fake_encoder_.AllowInitEncodeWithoutRelease(true);
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  const int num_initializations = fake_encoder_.GetNumEncoderInitializations();
+  const int num_releases = fake_encoder_.GetNumReleases();
+
+  codec_width_ /= 2;
+  codec_height_ /= 2;
+  video_source_.IncomingCapturedFrame(CreateFrame(2, nullptr));
+  WaitForEncodedFrame(2);
+  EXPECT_EQ(codec_width_, fake_encoder_.codec_config().width);
+  EXPECT_EQ(codec_height_, fake_encoder_.codec_config().height);
+  EXPECT_EQ(num_initializations + 1,
+            fake_encoder_.GetNumEncoderInitializations());
+  EXPECT_EQ(num_releases, fake_encoder_.GetNumReleases());
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest,
        EncoderInstanceDestroyedBeforeAnotherInstanceCreated) {
   video_stream_encoder_->OnBitrateUpdated(
@@ -4655,6 +4758,59 @@ TEST_F(VideoStreamEncoderTest, AccumulatesUpdateRectOnDroppedFrames) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, SkipsStaticScreenshareFramesWhenEnabled) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-SkipStaticScreenshareFrames/max_skip_ms:1000/");
+  ResetEncoder("VP8", 1, 1, 1, /*screenshare=*/true);
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  auto create_static_frame = [this](int64_t ntp_time_ms) {
+    VideoFrame frame = CreateFrame(ntp_time_ms, nullptr);
+    frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+    return frame;
+  };
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  // Nothing changed, so the frame is not encoded.
+  video_source_.IncomingCapturedFrame(create_static_frame(2));
+  ExpectDroppedFrame();
+  // A changed frame is encoded.
+  video_source_.IncomingCapturedFrame(
+      CreateFrameWithUpdatedPixel(3, nullptr, 0));
+  WaitForEncodedFrame(3);
+  // A key frame request is not delayed.
+  video_stream_encoder_->SendKeyFrame();
+  video_source_.IncomingCapturedFrame(create_static_frame(4));
+  WaitForEncodedFrame(4);
+  // Static frames are still encoded once in a while.
+  fake_clock_.AdvanceTime(TimeDelta::ms(1000));
+  video_source_.IncomingCapturedFrame(create_static_frame(5));
+  WaitForEncodedFrame(5);
+
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, EncodesStaticFramesOfRealtimeVideo) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-SkipStaticScreenshareFrames/max_skip_ms:1000/");
+  ResetEncoder("VP8", 1, 1, 1, /*screenshare=*/false);
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  VideoFrame frame = CreateFrame(2, nullptr);
+  frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+  video_source_.IncomingCapturedFrame(frame);
+  WaitForEncodedFrame(2);
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, SetsFrameTypes) {
   video_stream_encoder_->OnBitrateUpdated(
       DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),